@@ -35,6 +35,7 @@
 #include "NativeHandleTraits.h"
 #include "Aftermath.h"
 #include "PythonHelpers.h"
+#include "ReadbackService.h"
 #include "Core/Macros.h"
 #include "Core/Error.h"
 #include "Core/ObjectPython.h"
@@ -664,6 +665,9 @@ Device::Device(const Desc& desc) : mDesc(desc)
     // TODO: Do we need to flush here or should RenderContext::create() bind the descriptor heaps automatically without flush? See #749.
     mpRenderContext->submit(); // This will bind the descriptor heaps.
 
+    mpReadbackService = std::make_unique<ReadbackService>(ref<Device>(this));
+    mpReadbackService->breakStrongReferenceToDevice();
+
     this->decRef(false);
 
     logInfo(
@@ -679,6 +683,7 @@ Device::~Device()
 {
     mpRenderContext->submit(true);
 
+    mpReadbackService.reset();
     mpProfiler.reset();
 
     // Release all the bound resources. Need to do that before deleting the RenderContext
@@ -1140,6 +1145,9 @@ gfx::ITransientResourceHeap* Device::getCurrentTransientResourceHeap()
 
 void Device::endFrame()
 {
+    // Submit readback copies recorded during the frame.
+    mpReadbackService->flush(mpRenderContext.get());
+
     mpRenderContext->submit();
 
     // Wait on past frames.
@@ -1158,6 +1166,9 @@ void Device::endFrame()
 
     // Release resources from past frames.
     executeDeferredReleases();
+
+    // Invoke callbacks of completed readbacks.
+    mpReadbackService->update();
 }
 
 NativeHandle Device::getNativeHandle(uint32_t index) const
@@ -63,6 +63,7 @@ class D3D12DescriptorPool;
 class PipelineCreationAPIDispatcher;
 class ProgramManager;
 class Profiler;
+class ReadbackService;
 class AftermathContext;
 
 namespace cuda_utils
@@ -487,6 +488,9 @@ public:
 
     Profiler* getProfiler() const { return mpProfiler.get(); }
 
+    /// Get the service for asynchronous readback of GPU data.
+    ReadbackService* getReadbackService() const { return mpReadbackService.get(); }
+
     /**
      * Get the default render-context.
      * The default render-context is managed completely by the device. The user should just queue commands into it, the device will take
@@ -513,7 +517,7 @@ public:
     /**
      * End a frame.
      * This closes the current command buffer, switches to a new heap for transient resources and opens a new command buffer.
-     * This also executes deferred releases of resources from past frames.
+     * This also executes deferred releases of resources from past frames and retires completed readback requests.
      */
     void endFrame();
 
@@ -697,6 +701,7 @@ private:
 
     std::unique_ptr<ProgramManager> mpProgramManager;
     std::unique_ptr<Profiler> mpProfiler;
+    std::unique_ptr<ReadbackService> mpReadbackService;
 
 #if FALCOR_HAS_CUDA
     /// CUDA device sharing the same adapter as the graphics device.
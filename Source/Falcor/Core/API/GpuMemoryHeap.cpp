@@ -62,16 +62,15 @@ void GpuMemoryHeap::allocateNewPage()
     {
         mpActivePage = std::move(mAvailablePages.front());
         mAvailablePages.pop();
-        mpActivePage->allocationsCount = 0;
-        mpActivePage->currentOffset = 0;
+        FALCOR_ASSERT(mpActivePage->ranges.isEmpty());
     }
     else
     {
         mpActivePage = std::make_unique<PageData>();
         initBasePageData((*mpActivePage), mPageSize);
+        mpActivePage->ranges = RangeAllocator(mPageSize);
     }
 
-    mpActivePage->currentOffset = 0;
     mCurrentPageId++;
 }
 
@@ -85,21 +84,22 @@ GpuMemoryHeap::Allocation GpuMemoryHeap::allocate(size_t size, size_t alignment)
     }
     else
     {
-        // Calculate the start
-        size_t currentOffset = align_to(alignment, mpActivePage->currentOffset);
-        if (currentOffset + size > mPageSize)
+        // Allocate from the active page, ranges released in the page are reused.
+        // Switch to a new page if the active page is full.
+        RangeAllocator::Allocation range = mpActivePage->ranges.allocate(std::max<size_t>(size, 1), alignment);
+        if (!range.isValid())
         {
-            currentOffset = 0;
             allocateNewPage();
+            range = mpActivePage->ranges.allocate(std::max<size_t>(size, 1), alignment);
+            FALCOR_CHECK(range.isValid(), "Failed to allocate {} bytes with alignment {} from GPU memory heap.", size, alignment);
         }
 
         data.pageID = mCurrentPageId;
         data.size = size;
-        data.offset = currentOffset;
-        data.pData = mpActivePage->pData + currentOffset;
+        data.offset = range.offset;
+        data.pData = mpActivePage->pData + range.offset;
         data.gfxBufferResource = mpActivePage->gfxBufferResource;
-        mpActivePage->currentOffset = currentOffset + size;
-        mpActivePage->allocationsCount++;
+        data.range = range;
     }
 
     data.fenceValue = mpFence->getSignaledValue();
@@ -115,38 +115,45 @@ GpuMemoryHeap::Allocation GpuMemoryHeap::allocate(size_t size, ResourceBindFlags
 void GpuMemoryHeap::release(Allocation& data)
 {
     FALCOR_ASSERT(data.gfxBufferResource);
-    mDeferredReleases.push(data);
+    if (data.pageID == Allocation::kMegaPageId)
+    {
+        mDeferredReleases.push(data);
+    }
+    else if (data.pageID == mCurrentPageId)
+    {
+        mpActivePage->ranges.releaseDeferred(data.range, data.fenceValue);
+    }
+    else
+    {
+        auto it = mUsedPages.find(data.pageID);
+        FALCOR_ASSERT(it != mUsedPages.end());
+        it->second->ranges.releaseDeferred(data.range, data.fenceValue);
+    }
 }
 
 void GpuMemoryHeap::executeDeferredReleases()
 {
     uint64_t currentValue = mpFence->getCurrentValue();
+
+    // Popping a mega-page will release the resource.
     while (mDeferredReleases.size() && mDeferredReleases.top().fenceValue < currentValue)
+        mDeferredReleases.pop();
+
+    mpActivePage->ranges.executeDeferredReleases(currentValue);
+
+    // Recycle pages that have no allocations left.
+    for (auto it = mUsedPages.begin(); it != mUsedPages.end();)
     {
-        const Allocation& data = mDeferredReleases.top();
-        if (data.pageID == mCurrentPageId)
+        it->second->ranges.executeDeferredReleases(currentValue);
+        if (it->second->ranges.isEmpty())
         {
-            mpActivePage->allocationsCount--;
-            if (mpActivePage->allocationsCount == 0)
-            {
-                mpActivePage->currentOffset = 0;
-            }
+            mAvailablePages.push(std::move(it->second));
+            it = mUsedPages.erase(it);
         }
         else
         {
-            if (data.pageID != Allocation::kMegaPageId)
-            {
-                auto& pData = mUsedPages[data.pageID];
-                pData->allocationsCount--;
-                if (pData->allocationsCount == 0)
-                {
-                    mAvailablePages.push(std::move(pData));
-                    mUsedPages.erase(data.pageID);
-                }
-            }
-            // else it's a mega-page. Popping it will release the resource
+            ++it;
         }
-        mDeferredReleases.pop();
     }
 }
 
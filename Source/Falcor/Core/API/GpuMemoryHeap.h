@@ -33,6 +33,7 @@
 #include "Fence.h"
 #include "Core/Macros.h"
 #include "Core/Object.h"
+#include "Utils/RangeAllocator.h"
 #include <queue>
 #include <unordered_map>
 
@@ -56,6 +57,7 @@ public:
     {
         uint64_t pageID = 0;
         uint64_t fenceValue = 0;
+        RangeAllocator::Allocation range; ///< Range in the page. Invalid for mega-pages.
 
         static constexpr uint64_t kMegaPageId = -1;
         bool operator<(const Allocation& other) const { return fenceValue > other.fenceValue; }
@@ -85,8 +87,7 @@ private:
 
     struct PageData : public BaseData
     {
-        uint32_t allocationsCount = 0;
-        size_t currentOffset = 0;
+        RangeAllocator ranges;
 
         using UniquePtr = std::unique_ptr<PageData>;
     };
@@ -98,6 +99,7 @@ private:
     size_t mCurrentPageId = 0;
     PageData::UniquePtr mpActivePage;
 
+    /// Deferred releases of mega-pages. Releases in regular pages are deferred by the page's range allocator.
     std::priority_queue<Allocation> mDeferredReleases;
     std::unordered_map<size_t, PageData::UniquePtr> mUsedPages;
     std::queue<PageData::UniquePtr> mAvailablePages;
@@ -0,0 +1,163 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ReadbackService.h"
+#include "Device.h"
+#include "RenderContext.h"
+#include "Core/Error.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+
+namespace Falcor
+{
+ReadbackService::ReadbackService(ref<Device> pDevice, uint64_t capacity) : mpDevice(pDevice), mRing(0)
+{
+    FALCOR_CHECK(capacity > 0, "'capacity' must be larger than zero.");
+    mpFence = mpDevice->createFence();
+    createStagingBuffer(capacity);
+}
+
+ReadbackService::~ReadbackService()
+{
+    // Pending requests are dropped without invoking their callbacks.
+    if (mpStagingBuffer)
+        mpStagingBuffer->unmap();
+}
+
+ReadbackService::Ticket ReadbackService::readBuffer(
+    RenderContext* pRenderContext,
+    const Buffer* pBuffer,
+    uint64_t offset,
+    uint64_t size,
+    Callback callback,
+    const void* pOwner
+)
+{
+    FALCOR_CHECK(pRenderContext, "'pRenderContext' must not be null.");
+    FALCOR_CHECK(pBuffer, "'pBuffer' must not be null.");
+    FALCOR_CHECK(offset < pBuffer->getSize(), "'offset' ({}) is out of bounds (buffer size {}).", offset, pBuffer->getSize());
+    if (size == 0)
+        size = pBuffer->getSize() - offset;
+    FALCOR_CHECK(offset + size <= pBuffer->getSize(), "Readback range is out of bounds (offset {}, size {}, buffer size {}).", offset, size, pBuffer->getSize());
+
+    // Grow the staging buffer if the request is larger than the ring. This waits for all pending requests.
+    if (size > mRing.getCapacity())
+    {
+        while (!mRing.isEmpty())
+        {
+            flush(pRenderContext);
+            waitForFenceValue(mpFence->getSignaledValue());
+        }
+        createStagingBuffer(std::max(mRing.getCapacity() * 2, align_to(kAlignment, size)));
+    }
+
+    // The copy is covered by the next fence signal. If the ring is full, wait for the oldest request to complete.
+    ReadbackRing::Request request = mRing.push(size, kAlignment, mpFence->getSignaledValue() + 1, callback, pOwner);
+    while (!request.isValid())
+    {
+        waitForFenceValue(mRing.getOldestFenceValue());
+        mStallCount++;
+        request = mRing.push(size, kAlignment, mpFence->getSignaledValue() + 1, callback, pOwner);
+    }
+
+    pRenderContext->copyBufferRegion(mpStagingBuffer.get(), request.offset, pBuffer, offset, size);
+    mFlushPending = true;
+
+    return request.ticket;
+}
+
+void ReadbackService::wait(Ticket ticket)
+{
+    if (ticket == kInvalidTicket || mRing.isRetired(ticket))
+        return;
+
+    waitForFenceValue(mRing.getFenceValue(ticket));
+    mWaitCount++;
+}
+
+void ReadbackService::flush(RenderContext* pRenderContext)
+{
+    if (!mFlushPending)
+        return;
+
+    pRenderContext->submit(false);
+    pRenderContext->signal(mpFence.get());
+    mFlushPending = false;
+}
+
+void ReadbackService::update()
+{
+    if (mRing.isEmpty())
+        return;
+
+    mRing.retire(mpFence->getCurrentValue(), mpStagingData);
+}
+
+void ReadbackService::endFrame(RenderContext* pRenderContext)
+{
+    flush(pRenderContext);
+    update();
+}
+
+ReadbackService::Stats ReadbackService::getStats() const
+{
+    Stats stats;
+    stats.ring = mRing.getStats();
+    stats.stallCount = mStallCount;
+    stats.waitCount = mWaitCount;
+    return stats;
+}
+
+void ReadbackService::breakStrongReferenceToDevice()
+{
+    mpDevice.breakStrongReference();
+    mpFence->breakStrongReferenceToDevice();
+}
+
+void ReadbackService::createStagingBuffer(uint64_t capacity)
+{
+    FALCOR_ASSERT(mRing.isEmpty());
+
+    if (mpStagingBuffer)
+        mpStagingBuffer->unmap();
+
+    mpStagingBuffer = mpDevice->createBuffer(capacity, ResourceBindFlags::None, MemoryType::ReadBack);
+    mpStagingBuffer->breakStrongReferenceToDevice();
+    mpStagingData = mpStagingBuffer->map();
+    mRing.resize(capacity);
+}
+
+void ReadbackService::waitForFenceValue(uint64_t fenceValue)
+{
+    // Make sure the fence value is going to be signaled.
+    if (fenceValue > mpFence->getSignaledValue())
+        flush(mpDevice->getRenderContext());
+
+    mpFence->wait(fenceValue);
+    update();
+}
+} // namespace Falcor
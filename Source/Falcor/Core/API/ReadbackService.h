@@ -0,0 +1,188 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "fwd.h"
+#include "Buffer.h"
+#include "Fence.h"
+#include "Core/Macros.h"
+#include "Core/Object.h"
+#include "Utils/ReadbackRing.h"
+#include <cstring>
+#include <functional>
+
+namespace Falcor
+{
+class RenderContext;
+
+/**
+ * Asynchronous readback of GPU data to the CPU.
+ *
+ * Data is copied into a staging buffer in readback memory, which is used as a ring buffer
+ * sized to hold the readbacks of several frames in flight. Each request returns a ticket
+ * and the request's callback is invoked with the data once the GPU has completed the copy.
+ * The copies are covered by a single fence signal per frame.
+ *
+ * Completed requests are retired without blocking in update(), which the device calls once
+ * per frame in Device::endFrame(). The data therefore typically arrives a few frames after
+ * the request. Use wait() only if the data is needed right away, e.g. for scripting or at load time.
+ *
+ * The device owns a single instance, see Device::getReadbackService().
+ */
+class FALCOR_API ReadbackService
+{
+public:
+    using Ticket = ReadbackRing::Ticket;
+    using Callback = ReadbackRing::Callback;
+    static constexpr Ticket kInvalidTicket = ReadbackRing::kInvalidTicket;
+
+    /// Default size of the staging ring buffer in bytes.
+    static constexpr uint64_t kDefaultCapacity = 4 * 1024 * 1024;
+
+    struct Stats
+    {
+        ReadbackRing::Stats ring; ///< Stats of the staging ring buffer.
+        uint64_t stallCount = 0;  ///< Number of times a request had to wait for the GPU because the ring was full.
+        uint64_t waitCount = 0;   ///< Number of calls to wait() that blocked.
+    };
+
+    /**
+     * Constructor. Do not use directly, use Device::getReadbackService() instead.
+     * @param[in] pDevice GPU device.
+     * @param[in] capacity Initial size of the staging ring buffer in bytes. The ring grows if a larger request is made.
+     */
+    ReadbackService(ref<Device> pDevice, uint64_t capacity = kDefaultCapacity);
+    ~ReadbackService();
+
+    /**
+     * Request a readback of a buffer region.
+     * The copy is recorded on the render context. The callback is invoked from update() or wait() once the data is available.
+     * @param[in] pRenderContext Render context to record the copy on.
+     * @param[in] pBuffer Buffer to read from.
+     * @param[in] offset Byte offset into the buffer.
+     * @param[in] size Number of bytes to read. If zero, the buffer is read until the end.
+     * @param[in] callback Callback invoked with the data.
+     * @param[in] pOwner Owner of the request (optional). Owners need to call cancel(pOwner) before they are destroyed.
+     * @return Ticket of the request.
+     */
+    Ticket readBuffer(
+        RenderContext* pRenderContext,
+        const Buffer* pBuffer,
+        uint64_t offset,
+        uint64_t size,
+        Callback callback,
+        const void* pOwner = nullptr
+    );
+
+    /**
+     * Request a readback of a single value from a buffer, see readBuffer().
+     */
+    template<typename T>
+    Ticket readValue(
+        RenderContext* pRenderContext,
+        const Buffer* pBuffer,
+        uint64_t offset,
+        std::function<void(const T&)> callback,
+        const void* pOwner = nullptr
+    )
+    {
+        return readBuffer(
+            pRenderContext,
+            pBuffer,
+            offset,
+            sizeof(T),
+            [callback = std::move(callback)](const void* pData, size_t size)
+            {
+                T value;
+                std::memcpy(&value, pData, sizeof(T));
+                callback(value);
+            },
+            pOwner
+        );
+    }
+
+    /// Returns true if the request has completed and its callback has been invoked.
+    bool isReady(Ticket ticket) const { return mRing.isRetired(ticket); }
+
+    /**
+     * Block until a request has completed and its callback has been invoked.
+     * This submits pending work if the request has not been submitted yet.
+     * @param[in] ticket Ticket of the request.
+     */
+    void wait(Ticket ticket);
+
+    /**
+     * Cancel a request. Its callback will not be invoked.
+     * @param[in] ticket Ticket of the request. Completed requests are ignored.
+     */
+    void cancel(Ticket ticket) { mRing.cancel(ticket); }
+
+    /**
+     * Cancel all pending requests of an owner. Their callbacks will not be invoked.
+     * @param[in] pOwner Owner passed to readBuffer().
+     */
+    void cancel(const void* pOwner) { mRing.cancel(pOwner); }
+
+    /**
+     * Submit the recorded copies and signal the fence covering them.
+     * This is a no-op if there are no new requests.
+     * @param[in] pRenderContext Render context the copies were recorded on.
+     */
+    void flush(RenderContext* pRenderContext);
+
+    /**
+     * Invoke the callbacks of all completed requests. Does not block.
+     */
+    void update();
+
+    /**
+     * Called by the device at the end of each frame. Flushes new requests and retires completed ones.
+     */
+    void endFrame(RenderContext* pRenderContext);
+
+    Stats getStats() const;
+
+    void breakStrongReferenceToDevice();
+
+private:
+    void createStagingBuffer(uint64_t capacity);
+    void waitForFenceValue(uint64_t fenceValue);
+
+    /// Alignment of the ranges in the staging buffer.
+    static constexpr uint64_t kAlignment = 16;
+
+    BreakableReference<Device> mpDevice;
+    ref<Fence> mpFence;
+    ref<Buffer> mpStagingBuffer;
+    const void* mpStagingData = nullptr;
+    ReadbackRing mRing;
+
+    bool mFlushPending = false; ///< True if requests have been made since the fence was last signaled.
+    uint64_t mStallCount = 0;
+    uint64_t mWaitCount = 0;
+};
+} // namespace Falcor
@@ -27,11 +27,275 @@
  **************************************************************************/
 #include "AssetResolver.h"
 #include "Core/Platform/OS.h"
+#include "Utils/NumericRange.h"
 #include "Utils/Scripting/ScriptBindings.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <execution>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Falcor
 {
 
+namespace
+{
+/// Convert a relative path to an index key.
+std::string toIndexKey(const std::filesystem::path& relativePath)
+{
+    std::string key = relativePath.lexically_normal().generic_string();
+    while (!key.empty() && key.back() == '/')
+        key.pop_back();
+    if (key.empty())
+        key = ".";
+#if FALCOR_WINDOWS
+    // Paths are case-insensitive on Windows.
+    std::transform(key.begin(), key.end(), key.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+#endif
+    return key;
+}
+} // namespace
+
+/**
+ * Snapshot of all files and directories in a set of search paths.
+ */
+class AssetResolver::Index
+{
+public:
+    explicit Index(const std::vector<std::filesystem::path>& searchPaths)
+    {
+        for (const auto& searchPath : searchPaths)
+        {
+            std::error_code err;
+            if (!std::filesystem::is_directory(searchPath, err))
+                continue;
+            std::filesystem::path normalized = searchPath.lexically_normal();
+            if (std::any_of(mRoots.begin(), mRoots.end(), [&](const Root& root) { return root.path == normalized; }))
+                continue;
+            Root& root = mRoots.emplace_back();
+            root.path = normalized;
+            root.canonicalPath = std::filesystem::canonical(searchPath, err);
+            if (err)
+                root.canonicalPath = normalized;
+        }
+
+        // Scan the top level of each search path, then the subdirectories in parallel.
+        struct Task
+        {
+            size_t rootIndex;
+            std::filesystem::path directory;
+            std::vector<Entry> entries;
+        };
+        std::vector<Task> tasks;
+
+        for (size_t i = 0; i < mRoots.size(); ++i)
+        {
+            Root& root = mRoots[i];
+            addEntry(root, Entry{".", true, false, false});
+
+            std::error_code err;
+            for (std::filesystem::directory_iterator it(root.path, err), end; !err && it != end; it.increment(err))
+            {
+                Entry entry = makeEntry(*it, root.path);
+                addEntry(root, entry);
+                if (entry.isDirectory && !entry.isSymlink)
+                    tasks.push_back({i, it->path(), {}});
+            }
+        }
+
+        auto range = NumericRange<size_t>(0, tasks.size());
+        std::for_each(
+            std::execution::par,
+            range.begin(),
+            range.end(),
+            [&](size_t t)
+            {
+                Task& task = tasks[t];
+                const auto options = std::filesystem::directory_options::skip_permission_denied;
+                std::error_code err;
+                for (std::filesystem::recursive_directory_iterator it(task.directory, options, err), end; !err && it != end;
+                     it.increment(err))
+                    task.entries.push_back(makeEntry(*it, mRoots[task.rootIndex].path));
+            }
+        );
+
+        for (const Task& task : tasks)
+        {
+            for (const Entry& entry : task.entries)
+                addEntry(mRoots[task.rootIndex], entry);
+        }
+    }
+
+    /**
+     * Resolve an absolute path.
+     * @return The canonical path if it exists, an empty path if it does not exist, or std::nullopt if the path is not indexed.
+     */
+    std::optional<std::filesystem::path> resolvePath(const std::filesystem::path& path) const
+    {
+        std::string key;
+        const Root* pRoot = findRoot(path, key);
+        if (!pRoot)
+        {
+            mFallbackCount++;
+            return std::nullopt;
+        }
+
+        // Symbolic links and the contents of linked directories are resolved using the file system.
+        auto it = pRoot->entries.find(key);
+        if (pRoot->symlinks.count(key) || (it == pRoot->entries.end() && isBelowSymlink(*pRoot, key)))
+        {
+            mFallbackCount++;
+            return std::nullopt;
+        }
+
+        if (it == pRoot->entries.end())
+        {
+            mMissCount++;
+            return std::filesystem::path();
+        }
+
+        mHitCount++;
+        return key == "." ? pRoot->canonicalPath : pRoot->canonicalPath / it->second;
+    }
+
+    /**
+     * Find the files in an absolute directory path matching a regular expression.
+     * @return The list of matching files, or std::nullopt if the directory is not indexed.
+     */
+    std::optional<std::vector<std::filesystem::path>> globFiles(
+        const std::filesystem::path& path,
+        const std::regex& regex,
+        bool firstMatchOnly
+    ) const
+    {
+        std::string key;
+        const Root* pRoot = findRoot(path, key);
+        if (!pRoot)
+        {
+            mFallbackCount++;
+            return std::nullopt;
+        }
+
+        if (pRoot->symlinks.count(key) || isBelowSymlink(*pRoot, key))
+        {
+            mFallbackCount++;
+            return std::nullopt;
+        }
+
+        std::vector<std::filesystem::path> result;
+        auto it = pRoot->directories.find(key);
+        if (it != pRoot->directories.end())
+        {
+            for (const auto& filename : it->second)
+            {
+                if (std::regex_match(filename.string(), regex))
+                {
+                    result.push_back(path / filename);
+                    if (firstMatchOnly)
+                        break;
+                }
+            }
+        }
+
+        (result.empty() ? mMissCount : mHitCount)++;
+        return result;
+    }
+
+    AssetIndexStats getStats() const
+    {
+        AssetIndexStats stats;
+        for (const Root& root : mRoots)
+        {
+            stats.fileCount += root.fileCount;
+            stats.directoryCount += root.directories.size();
+        }
+        stats.hitCount = mHitCount;
+        stats.missCount = mMissCount;
+        stats.fallbackCount = mFallbackCount;
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        std::filesystem::path relativePath;
+        bool isDirectory;
+        bool isRegularFile;
+        bool isSymlink;
+    };
+
+    struct Root
+    {
+        std::filesystem::path path;
+        std::filesystem::path canonicalPath;
+        /// All files and directories, mapping keys to relative paths.
+        std::unordered_map<std::string, std::filesystem::path> entries;
+        /// All directories, mapping keys to the names of the regular files they contain.
+        std::unordered_map<std::string, std::vector<std::filesystem::path>> directories;
+        /// Keys of all symbolic links. The contents of linked directories are not indexed.
+        std::unordered_set<std::string> symlinks;
+        size_t fileCount = 0;
+    };
+
+    static Entry makeEntry(const std::filesystem::directory_entry& entry, const std::filesystem::path& rootPath)
+    {
+        std::error_code err;
+        return Entry{
+            entry.path().lexically_relative(rootPath), entry.is_directory(err), entry.is_regular_file(err), entry.is_symlink(err)};
+    }
+
+    static void addEntry(Root& root, const Entry& entry)
+    {
+        std::string key = toIndexKey(entry.relativePath);
+        root.entries.emplace(key, entry.relativePath);
+        if (entry.isSymlink)
+            root.symlinks.insert(key);
+        if (entry.isDirectory)
+        {
+            if (!entry.isSymlink)
+                root.directories[key];
+        }
+        else if (entry.isRegularFile)
+        {
+            root.directories[toIndexKey(entry.relativePath.parent_path())].push_back(entry.relativePath.filename());
+            root.fileCount++;
+        }
+    }
+
+    static bool isBelowSymlink(const Root& root, const std::string& key)
+    {
+        if (root.symlinks.empty())
+            return false;
+        for (size_t pos = key.find('/'); pos != std::string::npos; pos = key.find('/', pos + 1))
+        {
+            if (root.symlinks.count(key.substr(0, pos)))
+                return true;
+        }
+        return false;
+    }
+
+    const Root* findRoot(const std::filesystem::path& path, std::string& key) const
+    {
+        std::filesystem::path normalized = path.lexically_normal();
+        for (const Root& root : mRoots)
+        {
+            std::filesystem::path relative = normalized.lexically_relative(root.path);
+            if (relative.empty() || *relative.begin() == "..")
+                continue;
+            key = toIndexKey(relative);
+            return &root;
+        }
+        return nullptr;
+    }
+
+    std::vector<Root> mRoots;
+    mutable std::atomic<uint64_t> mHitCount{0};
+    mutable std::atomic<uint64_t> mMissCount{0};
+    mutable std::atomic<uint64_t> mFallbackCount{0};
+};
+
 AssetResolver::AssetResolver()
 {
     mSearchContexts.resize(size_t(AssetCategory::Count));
@@ -42,17 +306,17 @@ std::filesystem::path AssetResolver::resolvePath(const std::filesystem::path& pa
     FALCOR_CHECK(category < AssetCategory::Count, "Invalid asset category.");
 
     // If this is an existing absolute path, or a relative path to the working directory, return it.
-    std::filesystem::path absolute = std::filesystem::absolute(path);
-    if (std::filesystem::exists(absolute))
-        return std::filesystem::canonical(absolute);
+    std::filesystem::path resolved = resolveAbsolutePath(std::filesystem::absolute(path), mpIndex.get());
+    if (!resolved.empty())
+        return resolved;
 
     // Otherwise, try to resolve using search paths.
     // First try resolving for the specified asset category.
-    std::filesystem::path resolved = mSearchContexts[size_t(category)].resolvePath(path);
+    resolved = mSearchContexts[size_t(category)].resolvePath(path, mpIndex.get());
 
     // If not resolved, try resolving for the Any asset category.
     if (category != AssetCategory::Any && resolved.empty())
-        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePath(path);
+        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePath(path, mpIndex.get());
 
     if (resolved.empty())
         logWarning("Failed to resolve path '{}' for asset type '{}'.", path, category);
@@ -67,26 +331,33 @@ std::vector<std::filesystem::path> AssetResolver::resolvePathPattern(
     AssetCategory category
 ) const
 {
-    FALCOR_CHECK(category < AssetCategory::Count, "Invalid asset category.");
+    return resolvePathPattern(path, std::regex(pattern), firstMatchOnly, category);
+}
 
-    std::regex regex(pattern);
+std::vector<std::filesystem::path> AssetResolver::resolvePathPattern(
+    const std::filesystem::path& path,
+    const std::regex& regex,
+    bool firstMatchOnly,
+    AssetCategory category
+) const
+{
+    FALCOR_CHECK(category < AssetCategory::Count, "Invalid asset category.");
 
     // If this is an existing absolute path, or a relative path to the working directory, search it.
-    std::filesystem::path absolute = std::filesystem::absolute(path);
-    std::vector<std::filesystem::path> resolved = globFilesInDirectory(absolute, regex, firstMatchOnly);
+    std::vector<std::filesystem::path> resolved = globFiles(std::filesystem::absolute(path), regex, firstMatchOnly, mpIndex.get());
     if (!resolved.empty())
         return resolved;
 
     // Otherwise, try to resolve using search paths.
     // First try resolving for the specified asset category.
-    resolved = mSearchContexts[size_t(category)].resolvePathPattern(path, regex, firstMatchOnly);
+    resolved = mSearchContexts[size_t(category)].resolvePathPattern(path, regex, firstMatchOnly, mpIndex.get());
 
     // If not resolved, try resolving for the Any asset category.
     if (category != AssetCategory::Any && resolved.empty())
-        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePathPattern(path, regex, firstMatchOnly);
+        resolved = mSearchContexts[size_t(AssetCategory::Any)].resolvePathPattern(path, regex, firstMatchOnly, mpIndex.get());
 
     if (resolved.empty())
-        logWarning("Failed to resolve path pattern '{}/{}' for asset type '{}'.", path, pattern, category);
+        logWarning("Failed to resolve path pattern in '{}' for asset type '{}'.", path, category);
 
     return resolved;
 }
@@ -98,19 +369,67 @@ void AssetResolver::addSearchPath(const std::filesystem::path& path, SearchPathP
     mSearchContexts[size_t(category)].addSearchPath(path, priority);
 }
 
+void AssetResolver::buildIndex()
+{
+    std::vector<std::filesystem::path> searchPaths;
+    for (const auto& searchContext : mSearchContexts)
+        searchPaths.insert(searchPaths.end(), searchContext.searchPaths.begin(), searchContext.searchPaths.end());
+    mpIndex = std::make_shared<Index>(searchPaths);
+}
+
+void AssetResolver::invalidateIndex()
+{
+    mpIndex.reset();
+}
+
+AssetIndexStats AssetResolver::getIndexStats() const
+{
+    return mpIndex ? mpIndex->getStats() : AssetIndexStats();
+}
+
+std::filesystem::path AssetResolver::resolveAbsolutePath(const std::filesystem::path& path, const Index* pIndex)
+{
+    if (pIndex)
+    {
+        if (auto resolved = pIndex->resolvePath(path))
+            return *resolved;
+    }
+
+    if (std::filesystem::exists(path))
+        return std::filesystem::canonical(path);
+
+    return {};
+}
+
+std::vector<std::filesystem::path> AssetResolver::globFiles(
+    const std::filesystem::path& path,
+    const std::regex& regex,
+    bool firstMatchOnly,
+    const Index* pIndex
+)
+{
+    if (pIndex)
+    {
+        if (auto resolved = pIndex->globFiles(path, regex, firstMatchOnly))
+            return *resolved;
+    }
+
+    return globFilesInDirectory(path, regex, firstMatchOnly);
+}
+
 AssetResolver& AssetResolver::getDefaultResolver()
 {
     static AssetResolver defaultResolver;
     return defaultResolver;
 }
 
-std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::filesystem::path& path) const
+std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::filesystem::path& path, const Index* pIndex) const
 {
     for (const auto& searchPath : searchPaths)
     {
-        std::filesystem::path absolutePath = searchPath / path;
-        if (std::filesystem::exists(absolutePath))
-            return std::filesystem::canonical(absolutePath);
+        std::filesystem::path resolved = resolveAbsolutePath(searchPath / path, pIndex);
+        if (!resolved.empty())
+            return resolved;
     }
 
     return {};
@@ -119,13 +438,13 @@ std::filesystem::path AssetResolver::SearchContext::resolvePath(const std::files
 std::vector<std::filesystem::path> AssetResolver::SearchContext::resolvePathPattern(
     const std::filesystem::path& path,
     const std::regex& regex,
-    bool firstMatchOnly
+    bool firstMatchOnly,
+    const Index* pIndex
 ) const
 {
     for (const auto& searchPath : searchPaths)
     {
-        std::filesystem::path absolutePath = searchPath / path;
-        std::vector<std::filesystem::path> resolved = globFilesInDirectory(absolutePath, regex, firstMatchOnly);
+        std::vector<std::filesystem::path> resolved = globFiles(searchPath / path, regex, firstMatchOnly, pIndex);
         if (!resolved.empty())
             return resolved;
     }
@@ -161,7 +480,9 @@ FALCOR_SCRIPT_BINDING(AssetResolver)
     assetResolver.def("resolve_path", &AssetResolver::resolvePath, "path"_a, "category"_a = AssetCategory::Any);
     assetResolver.def(
         "resolve_path_pattern",
-        &AssetResolver::resolvePathPattern,
+        pybind11::overload_cast<const std::filesystem::path&, const std::string&, bool, AssetCategory>(
+            &AssetResolver::resolvePathPattern, pybind11::const_
+        ),
         "path"_a,
         "pattern"_a,
         "first_match_only"_a = false,
@@ -176,6 +497,24 @@ FALCOR_SCRIPT_BINDING(AssetResolver)
         "category"_a = AssetCategory::Any
     );
 
+    assetResolver.def("build_index", &AssetResolver::buildIndex);
+    assetResolver.def("invalidate_index", &AssetResolver::invalidateIndex);
+    assetResolver.def_property_readonly("has_index", &AssetResolver::hasIndex);
+    assetResolver.def_property_readonly(
+        "index_stats",
+        [](const AssetResolver& self)
+        {
+            AssetIndexStats stats = self.getIndexStats();
+            pybind11::dict d;
+            d["file_count"] = stats.fileCount;
+            d["directory_count"] = stats.directoryCount;
+            d["hit_count"] = stats.hitCount;
+            d["miss_count"] = stats.missCount;
+            d["fallback_count"] = stats.fallbackCount;
+            return d;
+        }
+    );
+
     assetResolver.def_property_readonly_static("default_resolver", [](pybind11::object) { return AssetResolver::getDefaultResolver(); });
 }
 
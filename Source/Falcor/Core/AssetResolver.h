@@ -29,7 +29,9 @@
 
 #include "Macros.h"
 #include "Enum.h"
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <regex>
 #include <string>
 #include <vector>
@@ -72,6 +74,16 @@ FALCOR_ENUM_INFO(
 );
 FALCOR_ENUM_REGISTER(SearchPathPriority);
 
+/// Statistics of the asset index, see AssetResolver::buildIndex().
+struct AssetIndexStats
+{
+    size_t fileCount = 0;       ///< Number of indexed files.
+    size_t directoryCount = 0;  ///< Number of indexed directories.
+    uint64_t hitCount = 0;      ///< Number of lookups answered by the index with a match.
+    uint64_t missCount = 0;     ///< Number of lookups answered by the index without a match.
+    uint64_t fallbackCount = 0; ///< Number of lookups outside the indexed search paths, answered by the file system.
+};
+
 /**
  * @brief Class for resolving paths to asset files.
  *
@@ -84,6 +96,11 @@ FALCOR_ENUM_REGISTER(SearchPathPriority);
  * search paths. When resolving a path, the resolver will first try to resolve the path
  * for the specified category, and if that fails, it will try to resolve it for the \c AssetCategory::Any category.
  * If no asset category is specified, the \c AssetCategory::Any category is used by default.
+ *
+ * Optionally, the search paths can be indexed with buildIndex(). Lookups in indexed search paths are then
+ * answered from memory instead of querying the file system, which is much faster for large scenes on
+ * network file systems. The index is a snapshot and needs to be rebuilt or invalidated explicitly when
+ * files change. Search paths added after building the index are resolved using the file system.
  */
 class FALCOR_API AssetResolver
 {
@@ -122,6 +139,17 @@ public:
         AssetCategory category = AssetCategory::Any
     ) const;
 
+    /**
+     * Resolve \c <path>/<regex> to a list of existing absolute file paths.
+     * Same as above, but takes a precompiled regular expression to avoid compiling it for every lookup.
+     */
+    std::vector<std::filesystem::path> resolvePathPattern(
+        const std::filesystem::path& path,
+        const std::regex& regex,
+        bool firstMatchOnly = false,
+        AssetCategory category = AssetCategory::Any
+    ) const;
+
     /**
      * Add a search path to the resolver.
      * The path needs to be absolute and exist.
@@ -137,26 +165,55 @@ public:
         AssetCategory category = AssetCategory::Any
     );
 
+    /**
+     * Build an index of all files and directories in the search paths of all asset categories.
+     * The search paths are scanned in parallel. Replaces any previous index and resets the statistics.
+     * Symbolic links to directories are not followed.
+     */
+    void buildIndex();
+
+    /// Drop the index, all paths are resolved using the file system again.
+    void invalidateIndex();
+
+    /// Return true if the search paths are indexed.
+    bool hasIndex() const { return mpIndex != nullptr; }
+
+    /// Return the index statistics. Returns zero counts if there is no index.
+    AssetIndexStats getIndexStats() const;
+
     /// Return the global default asset resolver.
     static AssetResolver& getDefaultResolver();
 
 private:
+    class Index;
+
     struct SearchContext
     {
         /// List of search paths. Resolving is done by searching these paths in order.
         std::vector<std::filesystem::path> searchPaths;
 
-        std::filesystem::path resolvePath(const std::filesystem::path& path) const;
+        std::filesystem::path resolvePath(const std::filesystem::path& path, const Index* pIndex) const;
 
         std::vector<std::filesystem::path> resolvePathPattern(
             const std::filesystem::path& path,
             const std::regex& regex,
-            bool firstMatchOnly
+            bool firstMatchOnly,
+            const Index* pIndex
         ) const;
 
         void addSearchPath(const std::filesystem::path& path, SearchPathPriority priority);
     };
 
+    static std::filesystem::path resolveAbsolutePath(const std::filesystem::path& path, const Index* pIndex);
+    static std::vector<std::filesystem::path> globFiles(
+        const std::filesystem::path& path,
+        const std::regex& regex,
+        bool firstMatchOnly,
+        const Index* pIndex
+    );
+
     std::vector<SearchContext> mSearchContexts;
+    /// Index of the search paths, shared between copies of the resolver. Immutable except for the statistics.
+    std::shared_ptr<Index> mpIndex;
 };
 } // namespace Falcor
@@ -0,0 +1,232 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ShaderBindingLayout.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <cctype>
+
+namespace Falcor
+{
+namespace
+{
+/// Returns the element type of a constant buffer or parameter block, or the type itself for all other types.
+const ReflectionType* dereferenceType(const ReflectionType* pType)
+{
+    if (auto pResourceType = pType->asResourceType())
+    {
+        if (pResourceType->getType() == ReflectionResourceType::Type::ConstantBuffer)
+            return pResourceType->getParameterBlockReflector()->getElementType().get();
+    }
+    return pType;
+}
+} // namespace
+
+ShaderBindingLayout::Handle ShaderBindingLayout::add(std::string_view path)
+{
+    return addPath(path, 0);
+}
+
+ShaderVar ShaderBindingLayout::get(const ShaderVar& var, Handle handle)
+{
+    ShaderVar result = find(var, handle);
+    FALCOR_CHECK(result.isValid(), "No member named '{}' found.", mPaths[handle.mIndex].path);
+    return result;
+}
+
+ShaderVar ShaderBindingLayout::find(const ShaderVar& var, Handle handle)
+{
+    const Path& path = resolve(var, handle);
+    if (!path.found)
+        return ShaderVar();
+
+    ShaderVar result = var;
+    for (const Op& op : path.ops)
+    {
+        if (auto pOffset = std::get_if<TypedShaderVarOffset>(&op))
+            result = result[*pOffset];
+        else
+            result = result[std::get<size_t>(op)];
+    }
+    return result;
+}
+
+const std::string& ShaderBindingLayout::getPath(Handle handle) const
+{
+    FALCOR_CHECK(handle.mIndex < mPaths.size(), "Invalid handle.");
+    return mPaths[handle.mIndex].path;
+}
+
+ShaderBindingLayout::Handle ShaderBindingLayout::addPath(std::string_view pathStr, size_t structSize)
+{
+    Path path;
+    path.path = pathStr;
+    path.structSize = structSize;
+
+    // Parse path elements of the form `name`, `.name` and `[index]`.
+    size_t pos = 0;
+    while (pos < pathStr.size())
+    {
+        if (pathStr[pos] == '[')
+        {
+            size_t end = pathStr.find(']', pos);
+            FALCOR_CHECK(end != std::string_view::npos && end > pos + 1, "Invalid array index in shader variable path '{}'.", pathStr);
+            std::string_view digits = pathStr.substr(pos + 1, end - pos - 1);
+            FALCOR_CHECK(
+                std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit((unsigned char)c); }),
+                "Invalid array index in shader variable path '{}'.",
+                pathStr
+            );
+            path.elements.emplace_back(size_t(std::stoull(std::string(digits))));
+            pos = end + 1;
+        }
+        else
+        {
+            if (pathStr[pos] == '.' && !path.elements.empty())
+                pos++;
+            size_t end = pathStr.find_first_of(".[", pos);
+            if (end == std::string_view::npos)
+                end = pathStr.size();
+            FALCOR_CHECK(end > pos, "Empty member name in shader variable path '{}'.", pathStr);
+            path.elements.emplace_back(std::string(pathStr.substr(pos, end - pos)));
+            pos = end;
+        }
+    }
+
+    mPaths.push_back(std::move(path));
+    return Handle(uint32_t(mPaths.size() - 1));
+}
+
+size_t ShaderBindingLayout::getStructSize(Handle handle) const
+{
+    FALCOR_CHECK(handle.mIndex < mPaths.size(), "Invalid handle.");
+    return mPaths[handle.mIndex].structSize;
+}
+
+const ShaderBindingLayout::Path& ShaderBindingLayout::resolve(const ShaderVar& var, Handle handle)
+{
+    FALCOR_CHECK(var.isValid(), "Cannot lookup on invalid ShaderVar.");
+    FALCOR_CHECK(handle.mIndex < mPaths.size(), "Invalid handle.");
+
+    // Invalidate all paths if used with a different type, i.e. vars of a different program version.
+    if (var.getType() != mpResolvedType.get())
+    {
+        mpResolvedType = ref<const ReflectionType>(var.getType());
+        for (auto& path : mPaths)
+            path.resolved = false;
+        mResolveCount++;
+    }
+
+    Path& path = mPaths[handle.mIndex];
+    if (!path.resolved)
+    {
+        path.found = resolvePath(var.getType(), path);
+        path.resolved = true;
+    }
+    return path;
+}
+
+bool ShaderBindingLayout::resolvePath(const ReflectionType* pType, Path& path)
+{
+    path.ops.clear();
+
+    // Consecutive member lookups are merged into a single offset.
+    // Constant buffers and array indices end a run of member lookups, they are applied using `ShaderVar` at runtime.
+    ShaderVarOffset runOffset = ShaderVarOffset::kZero;
+    const ReflectionType* pRunType = nullptr;
+    auto flush = [&]()
+    {
+        if (pRunType)
+            path.ops.emplace_back(TypedShaderVarOffset(pRunType, runOffset));
+        runOffset = ShaderVarOffset::kZero;
+        pRunType = nullptr;
+    };
+
+    const ReflectionType* pCurrentType = pType;
+    for (const Element& element : path.elements)
+    {
+        const ReflectionType* pDerefType = dereferenceType(pCurrentType);
+        if (pDerefType != pCurrentType)
+            flush();
+
+        if (auto pName = std::get_if<std::string>(&element))
+        {
+            auto pStructType = pDerefType->asStructType();
+            if (!pStructType)
+                return false;
+            int32_t memberIndex = pStructType->getMemberIndex(*pName);
+            if (memberIndex == ReflectionStructType::kInvalidMemberIndex)
+                return false;
+            const auto& pMember = pStructType->getMember(memberIndex);
+            runOffset = runOffset + pMember->getBindLocation();
+            pRunType = pMember->getType();
+            pCurrentType = pRunType;
+        }
+        else
+        {
+            size_t index = std::get<size_t>(element);
+            flush();
+            if (auto pArrayType = pDerefType->asArrayType())
+            {
+                uint32_t elementCount = pArrayType->getElementCount();
+                if (elementCount && index >= elementCount)
+                    return false;
+                pCurrentType = pArrayType->getElementType();
+            }
+            else if (auto pStructType = pDerefType->asStructType())
+            {
+                if (index >= pStructType->getMemberCount())
+                    return false;
+                pCurrentType = pStructType->getMember(index)->getType();
+            }
+            else
+            {
+                return false;
+            }
+            path.ops.emplace_back(index);
+        }
+    }
+    flush();
+
+    if (path.structSize > 0)
+    {
+        // Constant buffers may be padded to 16 bytes.
+        const ReflectionType* pDerefType = dereferenceType(pCurrentType);
+        size_t shaderSize = pDerefType->getByteSize();
+        bool isConstantBuffer = pDerefType != pCurrentType;
+        FALCOR_CHECK(
+            shaderSize == path.structSize || (isConstantBuffer && shaderSize == align_to<size_t>(16, path.structSize)),
+            "Size of host struct ({} bytes) does not match the size of shader variable '{}' ({} bytes).",
+            path.structSize,
+            path.path,
+            shaderSize
+        );
+    }
+
+    return true;
+}
+} // namespace Falcor
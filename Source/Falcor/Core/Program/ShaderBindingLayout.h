@@ -0,0 +1,171 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "ShaderVar.h"
+#include "ProgramReflection.h"
+#include "Core/Macros.h"
+#include "Core/Error.h"
+#include "Core/Object.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Precompiled paths to shader variables.
+ *
+ * Looking up a shader variable by name, e.g. `var["PerFrameCB"]["gFrameDim"]`, performs
+ * a string lookup per path element. A `ShaderBindingLayout` resolves such paths once into
+ * offsets, which makes binding parameters every frame a matter of adding offsets:
+ *
+ * // At setup:
+ * mFrameDimHandle = mBindings.add("PerFrameCB.gFrameDim");
+ * mParamsHandle = mBindings.addStruct<MyParams>("gParams");
+ *
+ * // Every frame:
+ * auto var = mpVars->getRootVar();
+ * mBindings.get(var, mFrameDimHandle) = mFrameDim;
+ * mBindings.setStruct(var, mParamsHandle, mParams);
+ *
+ * Paths consist of member names separated by `.` and array indices in brackets, e.g. `gLights[2].color`.
+ * Constant buffers and parameter blocks are dereferenced implicitly, as with `ShaderVar::operator[]`.
+ *
+ * The resolved offsets are cached for the type of the shader variable the paths are applied to.
+ * Each program version has its own reflection, so the paths are resolved again automatically
+ * the first time they are used with vars of a different program version (e.g. after changing defines).
+ *
+ * A layout is not thread-safe.
+ */
+class FALCOR_API ShaderBindingLayout
+{
+public:
+    /// Handle to a path in a layout.
+    class Handle
+    {
+    public:
+        Handle() = default;
+        bool isValid() const { return mIndex != kInvalidIndex; }
+
+    private:
+        static constexpr uint32_t kInvalidIndex = uint32_t(-1);
+        explicit Handle(uint32_t index) : mIndex(index) {}
+        uint32_t mIndex = kInvalidIndex;
+        friend class ShaderBindingLayout;
+    };
+
+    /**
+     * Add a path to a shader variable.
+     * @param[in] path Path to the variable, relative to the shader variables the layout is used with.
+     * @return Handle to the path.
+     */
+    Handle add(std::string_view path);
+
+    /**
+     * Add a path to a struct or constant buffer whose layout is mirrored by the host type `T`.
+     * The size of the shader type is validated against `sizeof(T)` when the path is resolved.
+     * Use setStruct() to write the whole struct with a single `setBlob`.
+     * @param[in] path Path to the variable, relative to the shader variables the layout is used with.
+     * @return Handle to the path.
+     */
+    template<typename T>
+    Handle addStruct(std::string_view path)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Mirrored struct must be trivially copyable");
+        return addPath(path, sizeof(T));
+    }
+
+    /**
+     * Get a shader variable by handle. Throws if the variable does not exist in the program.
+     * @param[in] var Shader variable the path is relative to, typically the root variable of a `ProgramVars`.
+     * @param[in] handle Handle to the path.
+     * @return The shader variable.
+     */
+    ShaderVar get(const ShaderVar& var, Handle handle);
+
+    /**
+     * Find a shader variable by handle.
+     * Unlike get(), this does not throw if the variable does not exist in the program.
+     * @param[in] var Shader variable the path is relative to, typically the root variable of a `ProgramVars`.
+     * @param[in] handle Handle to the path.
+     * @return The shader variable, or an invalid shader variable if it does not exist.
+     */
+    ShaderVar find(const ShaderVar& var, Handle handle);
+
+    /**
+     * Write a whole struct added with addStruct().
+     * @param[in] var Shader variable the path is relative to, typically the root variable of a `ProgramVars`.
+     * @param[in] handle Handle to the path.
+     * @param[in] value Value to write.
+     */
+    template<typename T>
+    void setStruct(const ShaderVar& var, Handle handle, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Mirrored struct must be trivially copyable");
+        FALCOR_CHECK(getStructSize(handle) == sizeof(T), "Type does not match the struct type the path was added with.");
+        get(var, handle).setBlob(&value, sizeof(T));
+    }
+
+    /// Get the path of a handle.
+    const std::string& getPath(Handle handle) const;
+
+    /// Get the number of times the paths were resolved. Used for testing.
+    uint32_t getResolveCount() const { return mResolveCount; }
+
+private:
+    /// Path element, either a member name or an array index.
+    using Element = std::variant<std::string, size_t>;
+
+    /// Resolved path operation, either an offset relative to the current variable or an array index.
+    using Op = std::variant<TypedShaderVarOffset, size_t>;
+
+    struct Path
+    {
+        std::string path;
+        std::vector<Element> elements;
+        size_t structSize = 0;
+
+        bool resolved = false; ///< True if the path is resolved for the current type.
+        bool found = false;    ///< True if the path exists in the current type.
+        std::vector<Op> ops;
+    };
+
+    Handle addPath(std::string_view path, size_t structSize);
+    size_t getStructSize(Handle handle) const;
+    const Path& resolve(const ShaderVar& var, Handle handle);
+    static bool resolvePath(const ReflectionType* pType, Path& path);
+
+    std::vector<Path> mPaths;
+    /// Type the paths are currently resolved for. Holding a reference ensures the type is not deallocated and its address reused.
+    ref<const ReflectionType> mpResolvedType;
+    uint32_t mResolveCount = 0;
+};
+} // namespace Falcor
@@ -56,6 +56,7 @@
 #include "Core/API/QueryHeap.h"
 #include "Core/API/RasterizerState.h"
 #include "Core/API/Raytracing.h"
+#include "Core/API/ReadbackService.h"
 #include "Core/API/RenderContext.h"
 #include "Core/API/Resource.h"
 #include "Core/API/GpuMemoryHeap.h"
@@ -75,6 +76,7 @@
 #include "Core/Program/ProgramReflection.h"
 #include "Core/Program/ProgramVars.h"
 #include "Core/Program/ProgramVersion.h"
+#include "Core/Program/ShaderBindingLayout.h"
 
 // Core/State
 #include "Core/State/ComputeState.h"
@@ -99,6 +101,7 @@
 #include "Utils/Logger.h"
 #include "Utils/UI/InputTypes.h"
 #include "Utils/Timing/Profiler.h"
+#include "Utils/Timing/TraceRecorder.h"
 
 #include <fmt/format.h> // TODO C++20: Replace with <format>
 #include <fstd/span.h>  // TODO C++20: Replace with <span>
@@ -56,6 +56,9 @@ ref<RenderGraph> RenderGraph::createFromFile(ref<Device> pDevice, const std::fil
 {
     using namespace pybind11::literals;
 
+    if (hasExtension(path, "fgraph"))
+        return RenderGraphImporter::importBinary(pDevice, path);
+
     ref<RenderGraph> pGraph;
 
     // Setup a temporary scripting context that defines a local variable 'm' that
@@ -94,6 +97,7 @@ void RenderGraph::setScene(const ref<Scene>& pScene)
     for (auto& it : mNodeData)
     {
         it.second.pPass->setScene(mpDevice->getRenderContext(), pScene);
+        mDirtyPasses.insert(it.second.pPass.get());
     }
     mRecompile = true;
 }
@@ -114,7 +118,11 @@ uint32_t RenderGraph::addPass(const ref<RenderPass>& pPass, const std::string& p
     uint32_t passIndex = mpGraph->addNode();
     mNameToIndex[passName] = passIndex;
 
-    pPass->mPassChangedCB = [this]() { mRecompile = true; };
+    pPass->mPassChangedCB = [this, pPass = pPass.get()]()
+    {
+        mRecompile = true;
+        mDirtyPasses.insert(pPass);
+    };
     pPass->mName = passName;
 
     if (mpScene)
@@ -162,7 +170,11 @@ void RenderGraph::updatePass(const std::string& passName, const Properties& prop
     std::string passTypeName = pOldPass->getType();
     auto pPass = RenderPass::create(passTypeName, mpDevice, props);
     pPassIt->second.pPass = pPass;
-    pPass->mPassChangedCB = [this]() { mRecompile = true; };
+    pPass->mPassChangedCB = [this, pPass = pPass.get()]()
+    {
+        mRecompile = true;
+        mDirtyPasses.insert(pPass);
+    };
     pPass->mName = pOldPass->getName();
 
     if (mpScene)
@@ -396,15 +408,73 @@ std::vector<std::string> RenderGraph::getUnmarkedOutputs() const
     return outputs;
 }
 
+RenderGraphPlanner::GraphDesc RenderGraph::createPlannerDesc(const std::vector<uint2>& resolutions, ResourceFormat defaultFormat) const
+{
+    RenderGraphPlanner::GraphDesc desc;
+    desc.name = mName;
+
+    RenderPass::CompileData compileData;
+    compileData.defaultTexDims = mCompilerDeps.defaultResourceProps.dims;
+    compileData.defaultTexFormat = mCompilerDeps.defaultResourceProps.format;
+    if (defaultFormat == ResourceFormat::Unknown)
+        defaultFormat = compileData.defaultTexFormat;
+
+    for (uint32_t i = 0; i < mpGraph->getCurrentNodeId(); i++)
+    {
+        if (!mpGraph->doesNodeExist(i))
+            continue;
+        const auto& node = mNodeData.at(i);
+        RenderGraphPlanner::PassDesc pass{node.name, node.pPass->reflect(compileData)};
+
+        // Passes may size or format their resources based on the default properties, so reflect them for each resolution.
+        for (const auto& resolution : resolutions)
+        {
+            RenderPass::CompileData resolutionData = compileData;
+            resolutionData.defaultTexDims = resolution;
+            resolutionData.defaultTexFormat = defaultFormat;
+            RenderPassReflection reflection = node.pPass->reflect(resolutionData);
+            if (reflection != pass.reflection)
+                pass.reflections.push_back({resolution, defaultFormat, std::move(reflection)});
+        }
+        desc.passes.push_back(std::move(pass));
+    }
+
+    for (uint32_t i = 0; i < mpGraph->getCurrentEdgeId(); i++)
+    {
+        if (!mpGraph->doesEdgeExist(i))
+            continue;
+        const DirectedGraph::Edge* pEdge = mpGraph->getEdge(i);
+        const auto& edgeData = mEdgeData.at(i);
+        std::string src = mNodeData.at(pEdge->getSourceNode()).name;
+        std::string dst = mNodeData.at(pEdge->getDestNode()).name;
+        if (!edgeData.srcField.empty())
+            src += "." + edgeData.srcField;
+        if (!edgeData.dstField.empty())
+            dst += "." + edgeData.dstField;
+        desc.edges.push_back({src, dst});
+    }
+
+    for (size_t i = 0; i < mOutputs.size(); i++)
+        desc.outputs.push_back(getOutputName(i));
+
+    return desc;
+}
+
 bool RenderGraph::compile(RenderContext* pRenderContext, std::string& log)
 {
     if (!mRecompile)
         return true;
-    mpExe = nullptr;
+
+    // Recompile incrementally on top of the previous executable graph, which is released once compilation finishes.
+    RenderGraphCompiler::PreviousCompilation previous;
+    auto pPreviousExe = std::move(mpExe);
+    previous.pExe = pPreviousExe.get();
+    previous.dirtyPasses = std::move(mDirtyPasses);
+    mDirtyPasses.clear();
 
     try
     {
-        mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps);
+        mpExe = RenderGraphCompiler::compile(*this, pRenderContext, mCompilerDeps, previous);
         mRecompile = false;
         return true;
     }
@@ -626,9 +696,15 @@ void RenderGraph::onResize(const Fbo* pTargetFbo)
     if (pColor == nullptr)
         FALCOR_THROW("Can't resize render graph without a frame buffer.");
 
+    // Nothing to do if the size and format are unchanged.
+    uint2 dims = {pTargetFbo->getWidth(), pTargetFbo->getHeight()};
+    auto& props = mCompilerDeps.defaultResourceProps;
+    if (mpExe && all(props.dims == dims) && props.format == pColor->getFormat())
+        return;
+
     // Store the values
-    mCompilerDeps.defaultResourceProps.format = pColor->getFormat();
-    mCompilerDeps.defaultResourceProps.dims = {pTargetFbo->getWidth(), pTargetFbo->getHeight()};
+    props.format = pColor->getFormat();
+    props.dims = dims;
 
     // Invalidate the graph. Render passes might change their reflection based on the resize information
     mRecompile = true;
@@ -728,6 +804,26 @@ FALCOR_SCRIPT_BINDING(RenderGraph)
     renderGraph.def("get_pass", &RenderGraph::getPass, "name"_a);
     renderGraph.def("__getitem__", [](RenderGraph& self, const std::string& name) { return self.getPass(name); });
     renderGraph.def("get_output", pybind11::overload_cast<const std::string&>(&RenderGraph::getOutput), "name"_a);
+    renderGraph.def(
+        "save_binary",
+        [](const ref<RenderGraph>& graph, const std::filesystem::path& path) { RenderGraphExporter::saveBinary(graph, path); },
+        "path"_a
+    );
+    renderGraph.def(
+        "dry_run_report",
+        [](const RenderGraph& graph, std::vector<uint2> resolutions, ResourceFormat defaultFormat)
+        { return RenderGraphPlanner::createReport(graph.createPlannerDesc(resolutions, defaultFormat), resolutions, defaultFormat); },
+        "resolutions"_a,
+        "default_format"_a = ResourceFormat::RGBA8UnormSrgb
+    );
+    renderGraph.def(
+        "save_planner_desc",
+        [](const RenderGraph& graph, const std::filesystem::path& path, std::vector<uint2> resolutions, ResourceFormat defaultFormat)
+        { RenderGraphPlanner::save(graph.createPlannerDesc(resolutions, defaultFormat), path); },
+        "path"_a,
+        "resolutions"_a,
+        "default_format"_a = ResourceFormat::RGBA8UnormSrgb
+    );
 
     // PYTHONDEPRECATED BEGIN
     renderGraph.def(
@@ -29,6 +29,7 @@
 #include "RenderPass.h"
 #include "RenderGraphExe.h"
 #include "RenderGraphCompiler.h"
+#include "RenderGraphPlanner.h"
 #include "Core/Macros.h"
 #include "Core/Object.h"
 #include "Core/API/fwd.h"
@@ -69,6 +70,7 @@ public:
 
     /**
      * Create a render graph from loading a python render graph script.
+     * Files with the '.fgraph' extension are loaded as binary graphs written by RenderGraphExporter::saveBinary().
      * @param[in] pDevice GPU device.
      * @param[in] path Path to the script (absolute or relative to working directory).
      * @return New object, or throws an exception if creation failed.
@@ -297,6 +299,9 @@ public:
 
     /**
      * Compile the graph.
+     * Recompilation is incremental: passes whose compile data didn't change are not compiled again, and resources that would be
+     * created with the same properties are taken over from the previous compilation. Such resources are not cleared and keep
+     * their stale contents, passes must not rely on newly compiled resources being zero-initialized.
      */
     bool compile(RenderContext* pRenderContext, std::string& log);
     bool compile(RenderContext* pRenderContext)
@@ -305,6 +310,23 @@ public:
         return compile(pRenderContext, s);
     }
 
+    /**
+     * Get the statistics of the last compilation. The statistics are zero if the graph is not compiled.
+     */
+    RenderGraphExe::CompileStats getCompileStats() const { return mpExe ? mpExe->getCompileStats() : RenderGraphExe::CompileStats(); }
+
+    /**
+     * Create a device-independent description of the graph for RenderGraphPlanner.
+     * The description contains the reflection of each pass for the current default resource properties,
+     * and the reflections that differ from it for each of the given resolutions.
+     * @param[in] resolutions Default texture dimensions to reflect the passes with.
+     * @param[in] defaultFormat Default texture format to reflect the passes with. Unknown to use the current default format.
+     */
+    RenderGraphPlanner::GraphDesc createPlannerDesc(
+        const std::vector<uint2>& resolutions = {},
+        ResourceFormat defaultFormat = ResourceFormat::Unknown
+    ) const;
+
 private:
     struct EdgeData
     {
@@ -372,6 +394,7 @@ private:
     std::unique_ptr<RenderGraphExe> mpExe;           ///< Helper for allocating resources and executing the graph.
     RenderGraphCompiler::Dependencies mCompilerDeps; ///< Data needed by the graph compiler.
     bool mRecompile = false; ///< Set to true to trigger a recompilation after any graph changes (topology/scene/size/passes/etc.)
+    std::unordered_set<const RenderPass*> mDirtyPasses; ///< Passes that need to be compiled on the next recompilation.
 
     friend class RenderGraphUI;
     friend class RenderGraphExporter;
@@ -40,19 +40,34 @@ bool canAutoResolve(const RenderPassReflection::Field& src, const RenderPassRefl
 {
     return src.getSampleCount() > 1 && dst.getSampleCount() == 1;
 }
+
+bool isSameCompileData(const RenderPass::CompileData& a, const RenderPass::CompileData& b)
+{
+    return all(a.defaultTexDims == b.defaultTexDims) && a.defaultTexFormat == b.defaultTexFormat &&
+           a.connectedResources == b.connectedResources;
+}
 } // namespace
 
-RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies)
-    : mGraph(graph), mpDevice(graph.getDevice()), mDependencies(dependencies)
-{}
+RenderGraphCompiler::RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, const PreviousCompilation& previous)
+    : mGraph(graph), mpDevice(graph.getDevice()), mDependencies(dependencies), mPrevious(previous)
+{
+    // Passes are identified by object. The previous executable graph holds references to its passes,
+    // so a pass that was replaced in the meantime can't alias a new pass at the same address.
+    if (mPrevious.pExe)
+    {
+        for (const auto& p : mPrevious.pExe->mExecutionList)
+            mPreviousCompileData[p.pPass.get()] = &p.compileData;
+    }
+}
 
 std::unique_ptr<RenderGraphExe> RenderGraphCompiler::compile(
     RenderGraph& graph,
     RenderContext* pRenderContext,
-    const Dependencies& dependencies
+    const Dependencies& dependencies,
+    const PreviousCompilation& previous
 )
 {
-    RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies);
+    RenderGraphCompiler c = RenderGraphCompiler(graph, dependencies, previous);
 
     // Register the external resources
     auto pResourcesCache = std::make_unique<ResourceCache>();
@@ -69,10 +84,12 @@ std::unique_ptr<RenderGraphExe> RenderGraphCompiler::compile(
     auto pExe = std::make_unique<RenderGraphExe>();
     pExe->mExecutionList.reserve(c.mExecutionList.size());
 
-    for (auto e : c.mExecutionList)
+    for (const auto& e : c.mExecutionList)
     {
-        pExe->insertPass(e.name, e.pPass);
+        pExe->insertPass(e.name, e.pPass, pResourcesCache->resolvePassSlots(e.name, e.reflector), e.compileData);
     }
+    pExe->mSchedule = c.buildSchedule();
+    pExe->mCompileStats = c.mStats;
     c.restoreCompilationChanges();
     pExe->mpResourceCache = std::move(pResourcesCache);
     return pExe;
@@ -119,6 +136,32 @@ void RenderGraphCompiler::validateGraph() const
         FALCOR_THROW(err);
 }
 
+RenderGraphScheduler::Schedule RenderGraphCompiler::buildSchedule() const
+{
+    std::unordered_map<uint32_t, uint32_t> nodeToPass;
+    for (size_t i = 0; i < mExecutionList.size(); i++)
+        nodeToPass[mExecutionList[i].index] = (uint32_t)i;
+
+    std::vector<RenderGraphScheduler::PassDesc> passes(mExecutionList.size());
+    std::vector<RenderGraphScheduler::Dependency> dependencies;
+    for (size_t i = 0; i < mExecutionList.size(); i++)
+    {
+        passes[i].asyncComputeCapable = mExecutionList[i].pPass->isAsyncComputeCapable();
+
+        // Both data and execution edges order the passes.
+        const DirectedGraph::Node* pNode = mGraph.mpGraph->getNode(mExecutionList[i].index);
+        for (uint32_t e = 0; e < pNode->getIncomingEdgeCount(); e++)
+        {
+            uint32_t srcNode = mGraph.mpGraph->getEdge(pNode->getIncomingEdge(e))->getSourceNode();
+            auto it = nodeToPass.find(srcNode);
+            if (it != nodeToPass.end())
+                dependencies.push_back({it->second, (uint32_t)i});
+        }
+    }
+
+    return RenderGraphScheduler::build(passes, dependencies);
+}
+
 void RenderGraphCompiler::resolveExecutionOrder()
 {
     mExecutionList.clear();
@@ -342,7 +385,10 @@ void RenderGraphCompiler::allocateResources(ref<Device> pDevice, ResourceCache*
         }
     }
 
-    pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps);
+    const ResourceCache* pPreviousCache = mPrevious.pExe ? mPrevious.pExe->mpResourceCache.get() : nullptr;
+    auto allocationStats = pResourceCache->allocateResources(pDevice, mDependencies.defaultResourceProps, pPreviousCache);
+    mStats.allocatedResourceCount = allocationStats.allocatedCount;
+    mStats.reusedResourceCount = allocationStats.reusedCount;
 }
 
 void RenderGraphCompiler::restoreCompilationChanges()
@@ -446,11 +492,25 @@ void RenderGraphCompiler::compilePasses(RenderContext* pRenderContext)
     {
         std::string log;
         bool success = true;
+        mStats.compiledPassCount = 0;
+        mStats.skippedPassCount = 0;
         for (auto& p : mExecutionList)
         {
             try
             {
-                p.pPass->compile(pRenderContext, prepPassCompilationData(p));
+                p.compileData = prepPassCompilationData(p);
+
+                // Skip passes that were compiled with the same data by the previous compilation.
+                auto prevIt = mPreviousCompileData.find(p.pPass.get());
+                if (prevIt != mPreviousCompileData.end() && mPrevious.dirtyPasses.count(p.pPass.get()) == 0 &&
+                    isSameCompileData(*prevIt->second, p.compileData))
+                {
+                    mStats.skippedPassCount++;
+                    continue;
+                }
+
+                p.pPass->compile(pRenderContext, p.compileData);
+                mStats.compiledPassCount++;
             }
             catch (const std::exception& e)
             {
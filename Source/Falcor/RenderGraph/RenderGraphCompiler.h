@@ -30,8 +30,11 @@
 #include "RenderPassReflection.h"
 #include "ResourceCache.h"
 #include "RenderGraphExe.h"
+#include "RenderGraphScheduler.h"
 #include "Core/Macros.h"
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -47,14 +50,39 @@ public:
         ResourceCache::DefaultProperties defaultResourceProps;
         ResourceCache::ResourcesMap externalResources;
     };
-    static std::unique_ptr<RenderGraphExe> compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies);
+
+    /**
+     * Result of a previous compilation of the same graph, used to recompile incrementally.
+     * Passes are only compiled if their compile data changed or if they are marked dirty,
+     * and resources whose properties are unchanged are taken over from the previous compilation.
+     */
+    struct PreviousCompilation
+    {
+        const RenderGraphExe* pExe = nullptr;              ///< Previous executable graph, or nullptr to compile everything.
+        std::unordered_set<const RenderPass*> dirtyPasses; ///< Passes that need to be compiled even if their compile data is unchanged.
+    };
+
+    static std::unique_ptr<RenderGraphExe> compile(
+        RenderGraph& graph,
+        RenderContext* pRenderContext,
+        const Dependencies& dependencies,
+        const PreviousCompilation& previous
+    );
+
+    static std::unique_ptr<RenderGraphExe> compile(RenderGraph& graph, RenderContext* pRenderContext, const Dependencies& dependencies)
+    {
+        return compile(graph, pRenderContext, dependencies, PreviousCompilation());
+    }
 
 private:
-    RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies);
+    RenderGraphCompiler(RenderGraph& graph, const Dependencies& dependencies, const PreviousCompilation& previous);
 
     RenderGraph& mGraph;
     ref<Device> mpDevice;
     const Dependencies& mDependencies;
+    const PreviousCompilation& mPrevious;
+    std::unordered_map<const RenderPass*, const RenderPass::CompileData*> mPreviousCompileData;
+    RenderGraphExe::CompileStats mStats;
 
     struct PassData
     {
@@ -62,6 +90,7 @@ private:
         ref<RenderPass> pPass;
         std::string name;
         RenderPassReflection reflector;
+        RenderPass::CompileData compileData; ///< Data the pass was compiled with.
     };
     std::vector<PassData> mExecutionList;
 
@@ -77,6 +106,7 @@ private:
     bool insertAutoPasses();
     void allocateResources(ref<Device> pDevice, ResourceCache* pResourceCache);
     void validateGraph() const;
+    RenderGraphScheduler::Schedule buildSchedule() const;
     void restoreCompilationChanges();
     RenderPass::CompileData prepPassCompilationData(const PassData& passData);
 };
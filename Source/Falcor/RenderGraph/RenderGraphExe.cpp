@@ -34,11 +34,14 @@ void RenderGraphExe::execute(const Context& ctx)
 {
     FALCOR_PROFILE(ctx.pRenderContext, "RenderGraphExe::execute()");
 
-    for (const auto& pass : mExecutionList)
+    // All passes are recorded on the main render context in submission order.
+    // Queue assignments and recording groups of the schedule are hints for devices with multiple queues.
+    for (uint32_t passIndex : mSchedule.order)
     {
-        FALCOR_PROFILE(ctx.pRenderContext, pass.name);
+        const auto& pass = mExecutionList[passIndex];
+        FALCOR_PROFILE(ctx.pRenderContext, pass.profileNameId);
 
-        RenderData renderData(pass.name, *mpResourceCache, ctx.passesDictionary, ctx.defaultTexDims, ctx.defaultTexFormat);
+        RenderData renderData(pass.name, *mpResourceCache, pass.slots, ctx.passesDictionary, ctx.defaultTexDims, ctx.defaultTexFormat);
         pass.pPass->execute(ctx.pRenderContext, renderData);
     }
 }
@@ -93,9 +96,14 @@ void RenderGraphExe::onHotReload(HotReloadFlags reloaded)
     }
 }
 
-void RenderGraphExe::insertPass(const std::string& name, const ref<RenderPass>& pPass)
+void RenderGraphExe::insertPass(
+    const std::string& name,
+    const ref<RenderPass>& pPass,
+    ResourceCache::PassSlots slots,
+    const RenderPass::CompileData& compileData
+)
 {
-    mExecutionList.push_back(Pass(name, pPass));
+    mExecutionList.push_back(Pass(name, pPass, std::move(slots), compileData));
 }
 
 ref<Resource> RenderGraphExe::getResource(const std::string& name) const
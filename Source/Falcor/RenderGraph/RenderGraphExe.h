@@ -28,12 +28,14 @@
 #pragma once
 #include "RenderPass.h"
 #include "ResourceCache.h"
+#include "RenderGraphScheduler.h"
 #include "Core/Macros.h"
 #include "Core/HotReloadFlags.h"
 #include "Core/API/Formats.h"
 #include "Utils/Math/Vector.h"
 #include "Utils/UI/Gui.h"
 #include "Utils/Dictionary.h"
+#include "Utils/Timing/Profiler.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,6 +48,17 @@ class RenderContext;
 class FALCOR_API RenderGraphExe
 {
 public:
+    /**
+     * Statistics of the compilation that produced the executable graph.
+     */
+    struct CompileStats
+    {
+        uint32_t compiledPassCount = 0;      ///< Number of calls to RenderPass::compile().
+        uint32_t skippedPassCount = 0;       ///< Number of passes that were not compiled as their compile data was unchanged.
+        uint32_t allocatedResourceCount = 0; ///< Number of resources that were created.
+        uint32_t reusedResourceCount = 0;    ///< Number of resources that were taken over from the previous compilation (not cleared).
+    };
+
     struct Context
     {
         RenderContext* pRenderContext;
@@ -94,22 +107,49 @@ public:
      */
     void setInput(const std::string& name, const ref<Resource>& pResource);
 
+    /**
+     * Get the schedule computed by the compiler. Pass indices refer to the passes in compilation order.
+     */
+    const RenderGraphScheduler::Schedule& getSchedule() const { return mSchedule; }
+
+    /**
+     * Get the statistics of the compilation.
+     */
+    const CompileStats& getCompileStats() const { return mCompileStats; }
+
 private:
     friend class RenderGraphCompiler;
 
-    void insertPass(const std::string& name, const ref<RenderPass>& pPass);
+    void insertPass(
+        const std::string& name,
+        const ref<RenderPass>& pPass,
+        ResourceCache::PassSlots slots,
+        const RenderPass::CompileData& compileData
+    );
 
     struct Pass
     {
         std::string name;
         ref<RenderPass> pPass;
+        ResourceCache::PassSlots slots;      ///< Resource slots resolved at compile time.
+        RenderPass::CompileData compileData; ///< Data the pass was compiled with.
+        Profiler::NameId profileNameId;      ///< Interned pass name, so profiling the pass doesn't look up its name every frame.
 
     private:
         friend class RenderGraphExe; // Force RenderGraphCompiler to use insertPass() by hiding this Ctor from it
-        Pass(const std::string& name_, const ref<RenderPass>& pPass_) : name(name_), pPass(pPass_) {}
+        Pass(
+            const std::string& name_,
+            const ref<RenderPass>& pPass_,
+            ResourceCache::PassSlots slots_,
+            const RenderPass::CompileData& compileData_
+        )
+            : name(name_), pPass(pPass_), slots(std::move(slots_)), compileData(compileData_), profileNameId(Profiler::internName(name_))
+        {}
     };
 
     std::vector<Pass> mExecutionList;
+    RenderGraphScheduler::Schedule mSchedule;
+    CompileStats mCompileStats;
     std::unique_ptr<ResourceCache> mpResourceCache;
 };
 } // namespace Falcor
@@ -29,7 +29,9 @@
 #include "RenderGraphIR.h"
 #include "Core/AssetResolver.h"
 #include "Utils/Scripting/Scripting.h"
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 
 namespace Falcor
 {
@@ -51,6 +53,14 @@ void runScriptFile(const std::filesystem::path& path, const std::string& custom)
     std::string script = readFile(resolvedPath) + custom;
     Scripting::runScript(script);
 }
+
+/// Call func for each object stored under consecutive index keys, see RenderGraphExporter::getProperties().
+template<typename Func>
+void forEachIndexed(const Properties& props, Func func)
+{
+    for (uint32_t i = 0; props.has(std::to_string(i)); ++i)
+        func(props.get<Properties>(std::to_string(i)));
+}
 } // namespace
 
 bool loadFailed(std::exception e, const std::filesystem::path& path)
@@ -120,6 +130,44 @@ std::vector<ref<RenderGraph>> RenderGraphImporter::importAllGraphs(const std::fi
     }
 }
 
+ref<RenderGraph> RenderGraphImporter::importBinary(ref<Device> pDevice, std::vector<uint8_t> data)
+{
+    // The nested pass properties stay backed by the binary data until the passes read them.
+    const Properties graph = Properties::fromBinary(std::move(data));
+    ref<RenderGraph> pGraph = RenderGraph::create(pDevice, graph.get<std::string>("name"));
+
+    forEachIndexed(
+        graph.get<Properties>("passes"),
+        [&](const Properties& pass)
+        {
+            const std::string name = pass.get<std::string>("name");
+            const std::string type = pass.get<std::string>("type");
+            if (!pGraph->createPass(name, type, pass.get<Properties>("properties")))
+                FALCOR_THROW("Failed to create render pass '{}' of type '{}'.", name, type);
+        }
+    );
+    forEachIndexed(
+        graph.get<Properties>("edges"),
+        [&](const Properties& edge) { pGraph->addEdge(edge.get<std::string>("src"), edge.get<std::string>("dst")); }
+    );
+    forEachIndexed(
+        graph.get<Properties>("outputs"),
+        [&](const Properties& output)
+        { pGraph->markOutput(output.get<std::string>("name"), static_cast<TextureChannelFlags>(output.get<uint32_t>("mask"))); }
+    );
+
+    return pGraph;
+}
+
+ref<RenderGraph> RenderGraphImporter::importBinary(ref<Device> pDevice, const std::filesystem::path& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        FALCOR_THROW("Failed to open binary render graph '{}'.", path);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return importBinary(pDevice, std::move(data));
+}
+
 std::string RenderGraphExporter::getFuncName(const std::string& graphName)
 {
     return RenderGraphIR::getFuncName(graphName);
@@ -177,4 +225,76 @@ bool RenderGraphExporter::save(const ref<RenderGraph>& pGraph, std::filesystem::
 
     return true;
 }
+Properties RenderGraphExporter::getProperties(const ref<RenderGraph>& pGraph)
+{
+    // Store passes and edges in ID order, so they are created in the same order on import.
+    auto getSortedIds = [](const auto& map)
+    {
+        std::vector<uint32_t> ids;
+        for (const auto& it : map)
+            ids.push_back(it.first);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    const std::vector<uint32_t> nodeIds = getSortedIds(pGraph->mNodeData);
+
+    Properties passes;
+    for (size_t i = 0; i < nodeIds.size(); ++i)
+    {
+        const auto& nodeData = pGraph->mNodeData[nodeIds[i]];
+        Properties pass;
+        pass.set("name", nodeData.name);
+        pass.set("type", nodeData.pPass->getType());
+        pass.set("properties", nodeData.pPass->getProperties());
+        passes.set(std::to_string(i), pass);
+    }
+
+    const std::vector<uint32_t> edgeIds = getSortedIds(pGraph->mEdgeData);
+    Properties edges;
+    for (size_t i = 0; i < edgeIds.size(); ++i)
+    {
+        const auto& edgeData = pGraph->mEdgeData[edgeIds[i]];
+        const auto& srcPass = pGraph->mNodeData[pGraph->mpGraph->getEdge(edgeIds[i])->getSourceNode()].name;
+        const auto& dstPass = pGraph->mNodeData[pGraph->mpGraph->getEdge(edgeIds[i])->getDestNode()].name;
+        Properties edge;
+        edge.set("src", srcPass + (edgeData.srcField.size() ? '.' + edgeData.srcField : edgeData.srcField));
+        edge.set("dst", dstPass + (edgeData.dstField.size() ? '.' + edgeData.dstField : edgeData.dstField));
+        edges.set(std::to_string(i), edge);
+    }
+
+    Properties outputs;
+    uint32_t outputIndex = 0;
+    for (const auto& out : pGraph->mOutputs)
+    {
+        for (auto mask : out.masks)
+        {
+            Properties output;
+            output.set("name", pGraph->mNodeData[out.nodeId].name + '.' + out.field);
+            output.set("mask", static_cast<uint32_t>(mask));
+            outputs.set(std::to_string(outputIndex++), output);
+        }
+    }
+
+    Properties graph;
+    graph.set("name", pGraph->getName());
+    graph.set("passes", passes);
+    graph.set("edges", edges);
+    graph.set("outputs", outputs);
+    return graph;
+}
+
+std::vector<uint8_t> RenderGraphExporter::getBinary(const ref<RenderGraph>& pGraph)
+{
+    return getProperties(pGraph).toBinary();
+}
+
+void RenderGraphExporter::saveBinary(const ref<RenderGraph>& pGraph, const std::filesystem::path& path)
+{
+    std::vector<uint8_t> data = getBinary(pGraph);
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+        FALCOR_THROW("Failed to create binary render graph '{}'.", path);
+    stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
 } // namespace Falcor
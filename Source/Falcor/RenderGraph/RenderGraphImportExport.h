@@ -28,6 +28,7 @@
 #pragma once
 #include "RenderGraph.h"
 #include "Core/Macros.h"
+#include "Utils/Properties.h"
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -51,6 +52,20 @@ public:
      * Import all the graphs found in the script's global namespace
      */
     static std::vector<ref<RenderGraph>> importAllGraphs(const std::filesystem::path& path);
+
+    /**
+     * Import a graph from binary data written by RenderGraphExporter::getBinary().
+     * The pass properties are not decoded upfront, each pass decodes its own properties when it reads them.
+     * @param[in] pDevice GPU device.
+     * @param[in] data Binary graph data.
+     * @return New render-graph object, or throws an exception if the data is invalid or a pass can't be created.
+     */
+    static ref<RenderGraph> importBinary(ref<Device> pDevice, std::vector<uint8_t> data);
+
+    /**
+     * Import a graph from a binary file written by RenderGraphExporter::saveBinary().
+     */
+    static ref<RenderGraph> importBinary(ref<Device> pDevice, const std::filesystem::path& path);
 };
 
 class FALCOR_API RenderGraphExporter
@@ -59,5 +74,17 @@ public:
     static std::string getIR(const ref<RenderGraph>& pGraph);
     static std::string getFuncName(const std::string& graphName);
     static bool save(const ref<RenderGraph>& pGraph, std::filesystem::path path = {});
+
+    /**
+     * Get the graph description as properties. Passes, edges and outputs are stored in nested objects keyed by their index.
+     */
+    static Properties getProperties(const ref<RenderGraph>& pGraph);
+
+    /**
+     * Get the graph description encoded with Properties::toBinary().
+     * Unlike the python IR, this embeds the pass properties without converting them to script code.
+     */
+    static std::vector<uint8_t> getBinary(const ref<RenderGraph>& pGraph);
+    static void saveBinary(const ref<RenderGraph>& pGraph, const std::filesystem::path& path);
 };
 } // namespace Falcor
@@ -0,0 +1,782 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "RenderGraphPlanner.h"
+#include "Core/Error.h"
+#include "Core/Enum.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Scripting/ScriptBindings.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Falcor
+{
+namespace
+{
+using json = nlohmann::ordered_json;
+using Field = RenderPassReflection::Field;
+using GraphDesc = RenderGraphPlanner::GraphDesc;
+using Plan = RenderGraphPlanner::Plan;
+
+constexpr uint32_t kInvalidIndex = uint32_t(-1);
+
+const std::vector<Field::Type> kFieldTypes = {
+    Field::Type::Texture1D,
+    Field::Type::Texture2D,
+    Field::Type::Texture3D,
+    Field::Type::TextureCube,
+    Field::Type::RawBuffer,
+};
+
+/// Split "pass.field" into pass and field names. The field name is empty for "pass".
+/// Same as parseFieldName() in RenderGraph, pass names may contain dots (e.g. "pass.field-ResolvePass").
+std::pair<std::string, std::string> splitName(const std::string& fullName)
+{
+    auto dot = fullName.find_last_of('.');
+    if (dot == std::string::npos)
+        return {fullName, ""};
+    return {fullName.substr(0, dot), fullName.substr(dot + 1)};
+}
+
+/// Graph description with names resolved to pass indices, and the execution order.
+struct ResolvedGraph
+{
+    struct Edge
+    {
+        uint32_t src;
+        uint32_t dst;
+        std::string srcField; ///< Empty for execution edges.
+        std::string dstField; ///< Empty for execution edges.
+    };
+
+    std::vector<Edge> edges;
+    std::vector<std::pair<uint32_t, std::string>> outputs;
+    std::vector<uint32_t> executionOrder;
+    std::vector<std::string> errors;
+
+    bool isGraphOutput(uint32_t pass, const std::string& field) const
+    {
+        return std::find(outputs.begin(), outputs.end(), std::make_pair(pass, field)) != outputs.end();
+    }
+};
+
+ResolvedGraph resolveGraph(const GraphDesc& desc)
+{
+    ResolvedGraph g;
+    const uint32_t passCount = (uint32_t)desc.passes.size();
+
+    std::unordered_map<std::string, uint32_t> passIndices;
+    for (uint32_t i = 0; i < passCount; i++)
+    {
+        if (!passIndices.emplace(desc.passes[i].name, i).second)
+            g.errors.push_back(fmt::format("Pass name '{}' is used more than once.", desc.passes[i].name));
+    }
+    auto findPass = [&](const std::string& name)
+    {
+        auto it = passIndices.find(name);
+        return it != passIndices.end() ? it->second : kInvalidIndex;
+    };
+
+    // Edges.
+    std::unordered_map<std::string, uint32_t> incomingEdgeCount;
+    for (const auto& e : desc.edges)
+    {
+        auto [srcPass, srcField] = splitName(e.src);
+        auto [dstPass, dstField] = splitName(e.dst);
+        uint32_t src = findPass(srcPass);
+        uint32_t dst = findPass(dstPass);
+        if (src == kInvalidIndex || dst == kInvalidIndex)
+        {
+            g.errors.push_back(fmt::format("Edge '{}' -> '{}' refers to a pass that doesn't exist.", e.src, e.dst));
+            continue;
+        }
+        if (src == dst)
+        {
+            g.errors.push_back(fmt::format("Edge '{}' -> '{}' connects a pass to itself.", e.src, e.dst));
+            continue;
+        }
+        if (srcField.empty() != dstField.empty())
+        {
+            g.errors.push_back(fmt::format("Edge '{}' -> '{}' must connect either two fields or two passes.", e.src, e.dst));
+            continue;
+        }
+        if (!srcField.empty())
+        {
+            const Field* pSrc = desc.passes[src].reflection.getField(srcField);
+            const Field* pDst = desc.passes[dst].reflection.getField(dstField);
+            if (!pSrc || !is_set(pSrc->getVisibility(), Field::Visibility::Output))
+                g.errors.push_back(fmt::format("Edge source '{}' is not an output field.", e.src));
+            if (!pDst || !is_set(pDst->getVisibility(), Field::Visibility::Input))
+                g.errors.push_back(fmt::format("Edge destination '{}' is not an input field.", e.dst));
+            if (++incomingEdgeCount[e.dst] == 2)
+                g.errors.push_back(fmt::format("Input field '{}' has more than one incoming edge.", e.dst));
+            if (!pSrc || !pDst)
+                continue;
+        }
+        g.edges.push_back({src, dst, srcField, dstField});
+    }
+
+    // Outputs.
+    for (const auto& name : desc.outputs)
+    {
+        auto [passName, fieldName] = splitName(name);
+        uint32_t pass = findPass(passName);
+        const Field* pField = pass != kInvalidIndex ? desc.passes[pass].reflection.getField(fieldName) : nullptr;
+        if (!pField || !is_set(pField->getVisibility(), Field::Visibility::Output))
+        {
+            g.errors.push_back(fmt::format("Graph output '{}' is not an output field.", name));
+            continue;
+        }
+        if (!g.isGraphOutput(pass, fieldName))
+            g.outputs.emplace_back(pass, fieldName);
+    }
+    if (desc.outputs.empty())
+        g.errors.push_back("Graph must have at least one output.");
+
+    // Passes that contribute to the outputs or are connected by an execution edge.
+    std::vector<std::vector<uint32_t>> predecessors(passCount);
+    std::vector<std::vector<uint32_t>> successors(passCount);
+    std::vector<bool> participating(passCount, false);
+    std::vector<uint32_t> stack;
+    for (const auto& e : g.edges)
+    {
+        predecessors[e.dst].push_back(e.src);
+        successors[e.src].push_back(e.dst);
+        if (e.srcField.empty())
+        {
+            stack.push_back(e.src);
+            stack.push_back(e.dst);
+        }
+    }
+    for (const auto& o : g.outputs)
+        stack.push_back(o.first);
+    while (!stack.empty())
+    {
+        uint32_t pass = stack.back();
+        stack.pop_back();
+        if (participating[pass])
+            continue;
+        participating[pass] = true;
+        for (uint32_t p : predecessors[pass])
+            stack.push_back(p);
+    }
+
+    // Topological sort of all passes, keeping the participating ones. Ties are broken by pass order.
+    std::vector<uint32_t> pendingCount(passCount);
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+    for (uint32_t i = 0; i < passCount; i++)
+    {
+        pendingCount[i] = (uint32_t)predecessors[i].size();
+        if (pendingCount[i] == 0)
+            ready.push(i);
+    }
+    uint32_t sortedCount = 0;
+    while (!ready.empty())
+    {
+        uint32_t pass = ready.top();
+        ready.pop();
+        sortedCount++;
+        if (participating[pass])
+            g.executionOrder.push_back(pass);
+        for (uint32_t s : successors[pass])
+        {
+            if (--pendingCount[s] == 0)
+                ready.push(s);
+        }
+    }
+    if (sortedCount != passCount)
+        g.errors.push_back("Graph contains a cycle.");
+
+    // Required inputs of executed passes must be connected.
+    for (uint32_t pass : g.executionOrder)
+    {
+        const auto& reflection = desc.passes[pass].reflection;
+        for (size_t f = 0; f < reflection.getFieldCount(); f++)
+        {
+            const Field& field = *reflection.getField(f);
+            if (!is_set(field.getVisibility(), Field::Visibility::Input) || is_set(field.getFlags(), Field::Flags::Optional))
+                continue;
+            bool connected = std::any_of(
+                g.edges.begin(), g.edges.end(), [&](const auto& e) { return e.dst == pass && e.dstField == field.getName(); }
+            );
+            if (!connected)
+            {
+                g.errors.push_back(
+                    fmt::format("Input field '{}.{}' is required but not satisfied.", desc.passes[pass].name, field.getName())
+                );
+            }
+        }
+    }
+
+    return g;
+}
+
+/// Same as canAutoResolve() in RenderGraphCompiler.
+bool canAutoResolve(const Field& src, const Field& dst)
+{
+    return src.getSampleCount() > 1 && dst.getSampleCount() == 1;
+}
+
+/// Insert MSAA resolve passes the same way as RenderGraphCompiler::insertAutoPasses(). Returns true if passes were added.
+bool insertResolvePasses(GraphDesc& desc, const ResolvedGraph& g, std::vector<std::string>& generatedPasses)
+{
+    std::unordered_map<std::string, uint32_t> passIndices;
+    for (uint32_t i = 0; i < desc.passes.size(); i++)
+        passIndices.emplace(desc.passes[i].name, i);
+    const std::unordered_set<uint32_t> executed(g.executionOrder.begin(), g.executionOrder.end());
+
+    bool addedPasses = false;
+    for (uint32_t pass : g.executionOrder)
+    {
+        // Copy the reflection, adding passes invalidates references into the pass list.
+        const std::string passName = desc.passes[pass].name;
+        const RenderPassReflection reflection = desc.passes[pass].reflection;
+        for (size_t f = 0; f < reflection.getFieldCount(); f++)
+        {
+            const Field& srcField = *reflection.getField(f);
+            if (!is_set(srcField.getVisibility(), Field::Visibility::Output))
+                continue;
+
+            // Gather the edges from the field to executed passes that need a resolve.
+            const std::string srcFieldName = passName + '.' + srcField.getName();
+            std::vector<size_t> resolvedEdges;
+            for (size_t e = 0; e < desc.edges.size(); e++)
+            {
+                if (desc.edges[e].src != srcFieldName)
+                    continue;
+                auto [dstPassName, dstFieldName] = splitName(desc.edges[e].dst);
+                uint32_t dst = passIndices.at(dstPassName);
+                if (!executed.count(dst))
+                    continue;
+                const Field* pDstField = desc.passes[dst].reflection.getField(dstFieldName);
+                FALCOR_ASSERT(pDstField);
+                if (canAutoResolve(srcField, *pDstField))
+                    resolvedEdges.push_back(e);
+            }
+            if (resolvedEdges.empty())
+                continue;
+
+            // Same reflection as ResolvePass.
+            RenderGraphPlanner::PassDesc resolvePass;
+            resolvePass.name = srcFieldName + "-ResolvePass";
+            resolvePass.reflection.addInput("src", "Multi-sampled texture").format(srcField.getFormat()).texture2D(0, 0, 0);
+            resolvePass.reflection.addOutput("dst", "Destination texture. Must have a single sample")
+                .format(srcField.getFormat())
+                .texture2D(0, 0, 1);
+            for (size_t e : resolvedEdges)
+                desc.edges[e].src = resolvePass.name + ".dst";
+            desc.edges.push_back({srcFieldName, resolvePass.name + ".src"});
+            passIndices.emplace(resolvePass.name, (uint32_t)desc.passes.size());
+            generatedPasses.push_back(resolvePass.name);
+            desc.passes.push_back(std::move(resolvePass));
+            addedPasses = true;
+        }
+    }
+    return addedPasses;
+}
+
+uint32_t getFullMipCount(uint32_t width, uint32_t height, uint32_t depth)
+{
+    uint32_t dim = std::max({width, height, depth});
+    uint32_t mipCount = 1;
+    while (dim >>= 1)
+        mipCount++;
+    return mipCount;
+}
+
+uint64_t estimateSize(const RenderGraphPlanner::ResourceInfo& r)
+{
+    if (r.type == Field::Type::RawBuffer)
+        return r.width;
+
+    const uint32_t blockWidth = getFormatWidthCompressionRatio(r.format);
+    const uint32_t blockHeight = getFormatHeightCompressionRatio(r.format);
+    const uint64_t blockBytes = getFormatBytesPerBlock(r.format);
+
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip < r.mipCount; mip++)
+    {
+        uint64_t w = std::max(1u, r.width >> mip);
+        uint64_t h = std::max(1u, r.height >> mip);
+        uint64_t d = std::max(1u, r.depth >> mip);
+        size += ((w + blockWidth - 1) / blockWidth) * ((h + blockHeight - 1) / blockHeight) * d * blockBytes;
+    }
+    uint64_t faceCount = r.type == Field::Type::TextureCube ? 6 : 1;
+    return size * r.arraySize * faceCount * r.sampleCount;
+}
+
+/// Assign memory slots to resources. Resources with disjoint lifetimes share a slot, persistent resources get their own.
+void assignMemorySlots(RenderGraphPlanner::Plan& plan)
+{
+    struct Slot
+    {
+        uint64_t size;
+        uint32_t lastUse;
+        bool persistent;
+    };
+    std::vector<Slot> slots;
+
+    std::vector<uint32_t> indices(plan.resources.size());
+    for (uint32_t i = 0; i < indices.size(); i++)
+        indices[i] = i;
+    std::stable_sort(
+        indices.begin(),
+        indices.end(),
+        [&](uint32_t a, uint32_t b)
+        {
+            const auto& ra = plan.resources[a];
+            const auto& rb = plan.resources[b];
+            return ra.firstUse != rb.firstUse ? ra.firstUse < rb.firstUse : ra.sizeInBytes > rb.sizeInBytes;
+        }
+    );
+
+    for (uint32_t i : indices)
+    {
+        auto& r = plan.resources[i];
+
+        // Best fit: the smallest free slot that is large enough, otherwise the largest free slot.
+        uint32_t best = kInvalidIndex;
+        if (!r.persistent)
+        {
+            for (uint32_t s = 0; s < slots.size(); s++)
+            {
+                if (slots[s].persistent || slots[s].lastUse >= r.firstUse)
+                    continue;
+                if (best == kInvalidIndex)
+                {
+                    best = s;
+                    continue;
+                }
+                bool fits = slots[s].size >= r.sizeInBytes;
+                bool bestFits = slots[best].size >= r.sizeInBytes;
+                if ((fits && (!bestFits || slots[s].size < slots[best].size)) || (!fits && !bestFits && slots[s].size > slots[best].size))
+                    best = s;
+            }
+        }
+
+        if (best == kInvalidIndex)
+        {
+            best = (uint32_t)slots.size();
+            slots.push_back({0, 0, r.persistent});
+        }
+        slots[best].size = std::max(slots[best].size, r.sizeInBytes);
+        slots[best].lastUse = r.lastUse;
+        r.memorySlot = best;
+    }
+
+    plan.memorySlotCount = (uint32_t)slots.size();
+    plan.aliasedBytes = 0;
+    for (const auto& slot : slots)
+        plan.aliasedBytes += slot.size;
+}
+
+/// Plan a graph for the given default resource properties. Returns the errors if the graph is invalid for these properties.
+std::vector<std::string> buildPlan(const GraphDesc& inputDesc, uint2 resolution, ResourceFormat defaultFormat, Plan& plan)
+{
+    plan.resolution = resolution;
+    plan.defaultFormat = defaultFormat;
+
+    // Use the reflection of each pass for these properties.
+    GraphDesc desc = inputDesc;
+    for (auto& pass : desc.passes)
+    {
+        const RenderPassReflection& reflection = RenderGraphPlanner::getReflection(pass, resolution, defaultFormat);
+        if (&reflection != &pass.reflection)
+        {
+            pass.reflection = reflection;
+        }
+        else if (!pass.reflections.empty())
+        {
+            plan.warnings.push_back(fmt::format(
+                "Pass '{}' was not reflected for {}x{} {}, using its default reflection.",
+                pass.name,
+                resolution.x,
+                resolution.y,
+                to_string(defaultFormat)
+            ));
+        }
+        pass.reflections.clear();
+    }
+
+    ResolvedGraph g = resolveGraph(desc);
+    if (g.errors.empty() && insertResolvePasses(desc, g, plan.generatedPasses))
+        g = resolveGraph(desc);
+    if (!g.errors.empty())
+        return g.errors;
+
+    for (uint32_t pass : g.executionOrder)
+        plan.executionOrder.push_back(desc.passes[pass].name);
+
+    // Register resources the same way as RenderGraphCompiler::allocateResources().
+    std::vector<Field> fields;
+    std::unordered_map<std::string, uint32_t> nameToResource;
+    const uint32_t lastIndex = g.executionOrder.empty() ? 0 : (uint32_t)g.executionOrder.size() - 1;
+    for (uint32_t t = 0; t < g.executionOrder.size(); t++)
+    {
+        uint32_t pass = g.executionOrder[t];
+        const auto& passName = desc.passes[pass].name;
+        const auto& reflection = desc.passes[pass].reflection;
+
+        // Outputs and internal resources.
+        for (size_t f = 0; f < reflection.getFieldCount(); f++)
+        {
+            const Field& field = *reflection.getField(f);
+            if (is_set(field.getVisibility(), Field::Visibility::Input))
+                continue;
+
+            bool graphOutput = g.isGraphOutput(pass, field.getName());
+            bool used = !is_set(field.getFlags(), Field::Flags::Optional) || graphOutput ||
+                        std::any_of(
+                            g.edges.begin(), g.edges.end(), [&](const auto& e) { return e.src == pass && e.srcField == field.getName(); }
+                        );
+            if (!used)
+                continue;
+
+            RenderGraphPlanner::ResourceInfo info;
+            info.name = passName + '.' + field.getName();
+            info.firstUse = t;
+            info.lastUse = graphOutput ? lastIndex : t;
+            info.persistent = graphOutput;
+            nameToResource[info.name] = (uint32_t)plan.resources.size();
+            plan.resources.push_back(std::move(info));
+            fields.push_back(field);
+        }
+
+        // Inputs alias the outputs they are connected to.
+        for (const auto& e : g.edges)
+        {
+            if (e.dst != pass || e.dstField.empty())
+                continue;
+            std::string srcName = desc.passes[e.src].name + '.' + e.srcField;
+            auto it = nameToResource.find(srcName);
+            FALCOR_CHECK(it != nameToResource.end(), "Field named '{}' not found.", srcName);
+            auto& info = plan.resources[it->second];
+            fields[it->second].merge(*reflection.getField(e.dstField));
+            info.lastUse = std::max(info.lastUse, t);
+            info.aliases.push_back(passName + '.' + e.dstField);
+        }
+    }
+
+    // Resolve the resource properties the same way as ResourceCache.
+    for (size_t i = 0; i < plan.resources.size(); i++)
+    {
+        const Field& field = fields[i];
+        auto& r = plan.resources[i];
+        r.type = field.getType();
+        r.width = field.getWidth() ? field.getWidth() : resolution.x;
+        r.persistent = r.persistent || is_set(field.getFlags(), Field::Flags::Persistent);
+        if (r.type == Field::Type::RawBuffer)
+        {
+            r.height = r.depth = r.mipCount = r.arraySize = r.sampleCount = 1;
+        }
+        else
+        {
+            r.height = field.getHeight() ? field.getHeight() : resolution.y;
+            r.depth = field.getDepth() ? field.getDepth() : 1;
+            r.sampleCount = field.getSampleCount() ? field.getSampleCount() : 1;
+            r.arraySize = std::max(1u, field.getArraySize());
+            r.mipCount = field.getMipCount() == Field::kMaxMipLevels ? getFullMipCount(r.width, r.height, r.depth)
+                                                                      : std::max(1u, field.getMipCount());
+            r.format = field.getFormat() == ResourceFormat::Unknown ? defaultFormat : field.getFormat();
+        }
+        r.sizeInBytes = estimateSize(r);
+        plan.totalBytes += r.sizeInBytes;
+    }
+
+    assignMemorySlots(plan);
+    return {};
+}
+
+json reflectionToJson(const RenderPassReflection& reflection)
+{
+    json fields = json::array();
+    for (size_t f = 0; f < reflection.getFieldCount(); f++)
+    {
+        const Field& field = *reflection.getField(f);
+        json jf;
+        jf["name"] = field.getName();
+        jf["desc"] = field.getDesc();
+        jf["visibility"] = (uint32_t)field.getVisibility();
+        jf["flags"] = (uint32_t)field.getFlags();
+        jf["type"] = to_string(field.getType());
+        jf["width"] = field.getWidth();
+        jf["height"] = field.getHeight();
+        jf["depth"] = field.getDepth();
+        jf["sampleCount"] = field.getSampleCount();
+        jf["mipCount"] = field.getMipCount();
+        jf["arraySize"] = field.getArraySize();
+        jf["format"] = to_string(field.getFormat());
+        jf["bindFlags"] = (uint32_t)field.getBindFlags();
+        fields.push_back(std::move(jf));
+    }
+    return fields;
+}
+
+RenderPassReflection reflectionFromJson(const json& fields)
+{
+    RenderPassReflection reflection;
+    for (const auto& jf : fields)
+    {
+        std::string typeName = jf.at("type").get<std::string>();
+        auto typeIt = std::find_if(kFieldTypes.begin(), kFieldTypes.end(), [&](Field::Type t) { return to_string(t) == typeName; });
+        FALCOR_CHECK(typeIt != kFieldTypes.end(), "Unknown field type '{}'.", typeName);
+
+        Field field;
+        field.name(jf.at("name").get<std::string>())
+            .desc(jf.value("desc", ""))
+            .visibility((Field::Visibility)jf.at("visibility").get<uint32_t>())
+            .flags((Field::Flags)jf.value("flags", 0u))
+            .format(stringToEnum<ResourceFormat>(jf.value("format", "Unknown")))
+            .bindFlags((ResourceBindFlags)jf.value("bindFlags", 0u));
+        uint32_t width = jf.value("width", 0u);
+        uint32_t height = jf.value("height", 0u);
+        uint32_t depth = jf.value("depth", 0u);
+        uint32_t sampleCount = jf.value("sampleCount", 1u);
+        uint32_t mipCount = jf.value("mipCount", 1u);
+        uint32_t arraySize = jf.value("arraySize", 1u);
+        switch (*typeIt)
+        {
+        case Field::Type::RawBuffer:
+            field.rawBuffer(width);
+            break;
+        case Field::Type::Texture1D:
+            field.texture1D(width, mipCount, arraySize);
+            break;
+        case Field::Type::Texture2D:
+            field.texture2D(width, height, sampleCount, mipCount, arraySize);
+            break;
+        case Field::Type::Texture3D:
+            field.texture3D(width, height, depth, arraySize);
+            break;
+        case Field::Type::TextureCube:
+            field.textureCube(width, height, mipCount, arraySize);
+            break;
+        }
+        reflection.addField(field);
+    }
+    return reflection;
+}
+
+json planToJson(const RenderGraphPlanner::Plan& plan)
+{
+    json j;
+    j["resolution"] = {plan.resolution.x, plan.resolution.y};
+    j["defaultFormat"] = to_string(plan.defaultFormat);
+    j["executionOrder"] = plan.executionOrder;
+    j["generatedPasses"] = plan.generatedPasses;
+    j["warnings"] = plan.warnings;
+    j["totalBytes"] = plan.totalBytes;
+    j["aliasedBytes"] = plan.aliasedBytes;
+    j["memorySlotCount"] = plan.memorySlotCount;
+    json resources = json::array();
+    for (const auto& r : plan.resources)
+    {
+        json jr;
+        jr["name"] = r.name;
+        jr["aliases"] = r.aliases;
+        jr["type"] = to_string(r.type);
+        jr["width"] = r.width;
+        jr["height"] = r.height;
+        jr["depth"] = r.depth;
+        jr["mipCount"] = r.mipCount;
+        jr["arraySize"] = r.arraySize;
+        jr["sampleCount"] = r.sampleCount;
+        jr["format"] = to_string(r.format);
+        jr["firstUse"] = r.firstUse;
+        jr["lastUse"] = r.lastUse;
+        jr["persistent"] = r.persistent;
+        jr["bytes"] = r.sizeInBytes;
+        jr["memorySlot"] = r.memorySlot;
+        resources.push_back(std::move(jr));
+    }
+    j["resources"] = std::move(resources);
+    return j;
+}
+} // namespace
+
+const RenderPassReflection& RenderGraphPlanner::getReflection(const PassDesc& pass, uint2 resolution, ResourceFormat defaultFormat)
+{
+    for (const auto& r : pass.reflections)
+    {
+        if (all(r.resolution == resolution) && r.defaultFormat == defaultFormat)
+            return r.reflection;
+    }
+    return pass.reflection;
+}
+
+std::vector<std::string> RenderGraphPlanner::validate(const GraphDesc& desc)
+{
+    return resolveGraph(desc).errors;
+}
+
+RenderGraphPlanner::Plan RenderGraphPlanner::plan(const GraphDesc& desc, uint2 resolution, ResourceFormat defaultFormat)
+{
+    Plan plan;
+    std::vector<std::string> errors = buildPlan(desc, resolution, defaultFormat, plan);
+    if (!errors.empty())
+    {
+        std::string msg;
+        for (const auto& e : errors)
+            msg += e + "\n";
+        FALCOR_THROW("Render graph '{}' is invalid:\n{}", desc.name, msg);
+    }
+    return plan;
+}
+
+std::string RenderGraphPlanner::createReport(const GraphDesc& desc, const std::vector<uint2>& resolutions, ResourceFormat defaultFormat)
+{
+    std::vector<std::string> errors = validate(desc);
+
+    // Passes may reflect differently per resolution, so the graph can be invalid for some resolutions only.
+    json plans = json::array();
+    if (errors.empty())
+    {
+        for (const auto& resolution : resolutions)
+        {
+            Plan p;
+            std::vector<std::string> planErrors = buildPlan(desc, resolution, defaultFormat, p);
+            for (const auto& e : planErrors)
+                errors.push_back(fmt::format("{}x{}: {}", resolution.x, resolution.y, e));
+            if (planErrors.empty())
+                plans.push_back(planToJson(p));
+        }
+    }
+
+    json report;
+    report["graph"] = desc.name;
+    report["valid"] = errors.empty();
+    report["errors"] = errors;
+    report["plans"] = std::move(plans);
+    return report.dump(4);
+}
+
+std::string RenderGraphPlanner::serialize(const GraphDesc& desc)
+{
+    json j;
+    j["name"] = desc.name;
+    json passes = json::array();
+    for (const auto& pass : desc.passes)
+    {
+        json jp;
+        jp["name"] = pass.name;
+        jp["fields"] = reflectionToJson(pass.reflection);
+        if (!pass.reflections.empty())
+        {
+            json reflections = json::array();
+            for (const auto& r : pass.reflections)
+            {
+                json jr;
+                jr["resolution"] = {r.resolution.x, r.resolution.y};
+                jr["defaultFormat"] = to_string(r.defaultFormat);
+                jr["fields"] = reflectionToJson(r.reflection);
+                reflections.push_back(std::move(jr));
+            }
+            jp["reflections"] = std::move(reflections);
+        }
+        passes.push_back(std::move(jp));
+    }
+    j["passes"] = std::move(passes);
+    json edges = json::array();
+    for (const auto& e : desc.edges)
+        edges.push_back({{"src", e.src}, {"dst", e.dst}});
+    j["edges"] = std::move(edges);
+    j["outputs"] = desc.outputs;
+    return j.dump(4);
+}
+
+RenderGraphPlanner::GraphDesc RenderGraphPlanner::deserialize(const std::string& text)
+{
+    GraphDesc desc;
+    try
+    {
+        json j = json::parse(text);
+        desc.name = j.value("name", "");
+        for (const auto& jp : j.at("passes"))
+        {
+            PassDesc pass;
+            pass.name = jp.at("name").get<std::string>();
+            pass.reflection = reflectionFromJson(jp.at("fields"));
+            for (const auto& jr : jp.value("reflections", json::array()))
+            {
+                ReflectionDesc r;
+                r.resolution = uint2(jr.at("resolution").at(0).get<uint32_t>(), jr.at("resolution").at(1).get<uint32_t>());
+                r.defaultFormat = stringToEnum<ResourceFormat>(jr.value("defaultFormat", "Unknown"));
+                r.reflection = reflectionFromJson(jr.at("fields"));
+                pass.reflections.push_back(std::move(r));
+            }
+            desc.passes.push_back(std::move(pass));
+        }
+        for (const auto& je : j.value("edges", json::array()))
+            desc.edges.push_back({je.at("src").get<std::string>(), je.at("dst").get<std::string>()});
+        desc.outputs = j.value("outputs", std::vector<std::string>());
+    }
+    catch (const json::exception& e)
+    {
+        FALCOR_THROW("Failed to parse render graph description: {}", e.what());
+    }
+    return desc;
+}
+
+RenderGraphPlanner::GraphDesc RenderGraphPlanner::load(const std::filesystem::path& path)
+{
+    FALCOR_CHECK(std::filesystem::exists(path), "Render graph description '{}' doesn't exist.", path);
+    return deserialize(readFile(path));
+}
+
+void RenderGraphPlanner::save(const GraphDesc& desc, const std::filesystem::path& path)
+{
+    std::ofstream ofs(path);
+    FALCOR_CHECK(ofs.good(), "Failed to open '{}' for writing.", path);
+    ofs << serialize(desc);
+}
+
+FALCOR_SCRIPT_BINDING(RenderGraphPlanner)
+{
+    using namespace pybind11::literals;
+
+    FALCOR_SCRIPT_BINDING_DEPENDENCY(Formats)
+
+    // Works on stored graph descriptions, so no device is needed.
+    pybind11::class_<RenderGraphPlanner> planner(m, "RenderGraphPlanner");
+    planner.def_static(
+        "validate", [](const std::filesystem::path& path) { return RenderGraphPlanner::validate(RenderGraphPlanner::load(path)); }, "path"_a
+    );
+    planner.def_static(
+        "create_report",
+        [](const std::filesystem::path& path, std::vector<uint2> resolutions, ResourceFormat defaultFormat)
+        { return RenderGraphPlanner::createReport(RenderGraphPlanner::load(path), resolutions, defaultFormat); },
+        "path"_a,
+        "resolutions"_a,
+        "default_format"_a = ResourceFormat::RGBA8UnormSrgb
+    );
+}
+} // namespace Falcor
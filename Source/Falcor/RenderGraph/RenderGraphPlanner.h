@@ -0,0 +1,180 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "RenderPassReflection.h"
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include "Utils/Math/Vector.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Device-independent planner for render graphs.
+ *
+ * The planner works on a description of a render graph that only contains the reflection of each pass,
+ * so it can run without a GPU device, for example to check render graphs on CPU-only machines.
+ * It validates the graph, resolves the execution order and computes the resource lifetimes the same
+ * way as RenderGraphCompiler, including the MSAA resolve passes the compiler inserts automatically.
+ * For a given resolution it estimates the memory footprint of the graph resources, both as allocated
+ * by the resource cache and with resources of disjoint lifetimes aliased.
+ *
+ * Render passes can't be created without a device, so graph descriptions are captured from a live graph
+ * with RenderGraph::createPlannerDesc() and stored as JSON. Passes may reflect differently depending on
+ * the default resource properties, so a description holds the reflection for each captured resolution.
+ * A stored description acts as a reflection cache that can be checked in and planned anywhere,
+ * for example with RenderGraphPlanner.create_report() from Python.
+ */
+class FALCOR_API RenderGraphPlanner
+{
+public:
+    /// Reflection of a pass for specific default resource properties.
+    struct ReflectionDesc
+    {
+        uint2 resolution = {};                                  ///< Default texture dimensions the pass was reflected with.
+        ResourceFormat defaultFormat = ResourceFormat::Unknown; ///< Default texture format the pass was reflected with.
+        RenderPassReflection reflection;                        ///< Pass reflection.
+    };
+
+    struct PassDesc
+    {
+        std::string name;                        ///< Pass name.
+        RenderPassReflection reflection;         ///< Pass reflection for the default resource properties of the captured graph.
+        std::vector<ReflectionDesc> reflections; ///< Reflections that differ from 'reflection' for specific resource properties.
+    };
+
+    /// Graph edge. Data edges connect fields ("pass.field"), execution edges connect passes ("pass").
+    struct EdgeDesc
+    {
+        std::string src;
+        std::string dst;
+    };
+
+    struct GraphDesc
+    {
+        std::string name;                 ///< Graph name.
+        std::vector<PassDesc> passes;     ///< Passes of the graph.
+        std::vector<EdgeDesc> edges;      ///< Edges of the graph.
+        std::vector<std::string> outputs; ///< Graph outputs ("pass.field").
+    };
+
+    /// Resource required by the graph.
+    struct ResourceInfo
+    {
+        using Type = RenderPassReflection::Field::Type;
+
+        std::string name;                                ///< Name of the field that creates the resource ("pass.field").
+        std::vector<std::string> aliases;                ///< Other fields bound to the same resource.
+        Type type = Type::Texture2D;                     ///< Resource type.
+        uint32_t width = 0;                              ///< Width in texels, or size in bytes for buffers.
+        uint32_t height = 0;                             ///< Height in texels.
+        uint32_t depth = 0;                              ///< Depth in texels.
+        uint32_t mipCount = 0;                           ///< Number of mip levels.
+        uint32_t arraySize = 0;                          ///< Array size.
+        uint32_t sampleCount = 0;                        ///< Sample count.
+        ResourceFormat format = ResourceFormat::Unknown; ///< Texture format.
+        uint32_t firstUse = 0;                           ///< Execution order index of the first pass using the resource.
+        uint32_t lastUse = 0;                            ///< Execution order index of the last pass using the resource.
+        bool persistent = false;                         ///< True if the resource outlives the graph execution.
+        uint64_t sizeInBytes = 0;                        ///< Estimated size in bytes.
+        uint32_t memorySlot = 0;                         ///< Memory slot of the resource when aliasing resources.
+    };
+
+    /// Plan of the graph for a given resolution.
+    struct Plan
+    {
+        uint2 resolution = {};                                  ///< Default texture dimensions.
+        ResourceFormat defaultFormat = ResourceFormat::Unknown; ///< Default texture format.
+        std::vector<std::string> executionOrder;                ///< Names of the executed passes in order.
+        std::vector<std::string> generatedPasses;               ///< Names of the MSAA resolve passes inserted into the graph.
+        std::vector<std::string> warnings;                      ///< Passes planned with a reflection captured for other properties.
+        std::vector<ResourceInfo> resources;                    ///< Resources in order of creation.
+        uint64_t totalBytes = 0;                                ///< Memory footprint without aliasing.
+        uint64_t aliasedBytes = 0;                              ///< Memory footprint with resources of disjoint lifetimes aliased.
+        uint32_t memorySlotCount = 0;                           ///< Number of memory slots when aliasing.
+    };
+
+    /**
+     * Get the reflection of a pass for the given default resource properties.
+     * Falls back to the pass's default reflection if none was captured for these properties.
+     * @param[in] pass Pass description.
+     * @param[in] resolution Default texture dimensions.
+     * @param[in] defaultFormat Default texture format.
+     * @return The reflection.
+     */
+    static const RenderPassReflection& getReflection(const PassDesc& pass, uint2 resolution, ResourceFormat defaultFormat);
+
+    /**
+     * Validate a graph description.
+     * @param[in] desc Graph description.
+     * @return List of errors. Empty if the graph is valid.
+     */
+    static std::vector<std::string> validate(const GraphDesc& desc);
+
+    /**
+     * Plan a graph. Throws an exception if the graph is invalid.
+     * The passes are planned with their reflection for the given resolution and format, see getReflection().
+     * @param[in] desc Graph description.
+     * @param[in] resolution Default texture dimensions (the swap chain size).
+     * @param[in] defaultFormat Default texture format (the swap chain format).
+     * @return The plan.
+     */
+    static Plan plan(const GraphDesc& desc, uint2 resolution, ResourceFormat defaultFormat);
+
+    /**
+     * Create a JSON report with the validation result and the plans for a list of resolutions.
+     * @param[in] desc Graph description.
+     * @param[in] resolutions Resolutions to plan for.
+     * @param[in] defaultFormat Default texture format.
+     * @return The report as JSON text.
+     */
+    static std::string createReport(const GraphDesc& desc, const std::vector<uint2>& resolutions, ResourceFormat defaultFormat);
+
+    /**
+     * Serialize a graph description to JSON text.
+     */
+    static std::string serialize(const GraphDesc& desc);
+
+    /**
+     * Deserialize a graph description from JSON text. Throws an exception if the JSON is malformed.
+     */
+    static GraphDesc deserialize(const std::string& json);
+
+    /**
+     * Load a graph description from a JSON file. Throws an exception if the file can't be read or is malformed.
+     */
+    static GraphDesc load(const std::filesystem::path& path);
+
+    /**
+     * Save a graph description to a JSON file. Throws an exception if the file can't be written.
+     */
+    static void save(const GraphDesc& desc, const std::filesystem::path& path);
+};
+} // namespace Falcor
@@ -0,0 +1,221 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "RenderGraphScheduler.h"
+#include "Core/Error.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace Falcor
+{
+namespace
+{
+/// Reachability between passes, stored as one bit set per pass.
+class ReachabilitySet
+{
+public:
+    ReachabilitySet(size_t count) : mWordCount((count + 63) / 64), mBits(count * mWordCount, 0) {}
+
+    void set(size_t from, size_t to) { mBits[from * mWordCount + to / 64] |= 1ull << (to % 64); }
+    bool get(size_t from, size_t to) const { return (mBits[from * mWordCount + to / 64] >> (to % 64)) & 1; }
+
+    void merge(size_t dst, size_t src)
+    {
+        for (size_t w = 0; w < mWordCount; w++)
+            mBits[dst * mWordCount + w] |= mBits[src * mWordCount + w];
+    }
+
+private:
+    size_t mWordCount;
+    std::vector<uint64_t> mBits;
+};
+} // namespace
+
+uint32_t RenderGraphScheduler::Schedule::getPassCount(Queue queue) const
+{
+    return (uint32_t)std::count(queues.begin(), queues.end(), queue);
+}
+
+RenderGraphScheduler::Schedule RenderGraphScheduler::build(
+    const std::vector<PassDesc>& passes,
+    const std::vector<Dependency>& dependencies,
+    const Options& options
+)
+{
+    const uint32_t passCount = (uint32_t)passes.size();
+
+    std::vector<std::vector<uint32_t>> predecessors(passCount);
+    std::vector<std::vector<uint32_t>> successors(passCount);
+    for (const auto& d : dependencies)
+    {
+        FALCOR_CHECK(d.src < passCount && d.dst < passCount, "Dependency {} -> {} refers to a pass out of range.", d.src, d.dst);
+        FALCOR_CHECK(d.src != d.dst, "Pass {} depends on itself.", d.src);
+        predecessors[d.dst].push_back(d.src);
+        successors[d.src].push_back(d.dst);
+    }
+    for (uint32_t i = 0; i < passCount; i++)
+    {
+        auto removeDuplicates = [](std::vector<uint32_t>& v)
+        {
+            std::sort(v.begin(), v.end());
+            v.erase(std::unique(v.begin(), v.end()), v.end());
+        };
+        removeDuplicates(predecessors[i]);
+        removeDuplicates(successors[i]);
+    }
+
+    Schedule schedule;
+
+    // Topological sort. Always picking the ready pass with the lowest index keeps the input order if it is already valid.
+    {
+        std::vector<uint32_t> pendingCount(passCount);
+        std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+        for (uint32_t i = 0; i < passCount; i++)
+        {
+            pendingCount[i] = (uint32_t)predecessors[i].size();
+            if (pendingCount[i] == 0)
+                ready.push(i);
+        }
+        schedule.order.reserve(passCount);
+        while (!ready.empty())
+        {
+            uint32_t pass = ready.top();
+            ready.pop();
+            schedule.order.push_back(pass);
+            for (uint32_t s : successors[pass])
+            {
+                if (--pendingCount[s] == 0)
+                    ready.push(s);
+            }
+        }
+        if (schedule.order.size() != passCount)
+            FALCOR_THROW("Render graph dependencies contain a cycle.");
+    }
+
+    std::vector<uint32_t> position(passCount);
+    for (uint32_t i = 0; i < passCount; i++)
+        position[schedule.order[i]] = i;
+
+    // Dependency levels (longest path from a source).
+    schedule.levels.assign(passCount, 0);
+    for (uint32_t pass : schedule.order)
+    {
+        for (uint32_t p : predecessors[pass])
+            schedule.levels[pass] = std::max(schedule.levels[pass], schedule.levels[p] + 1);
+        schedule.levelCount = std::max(schedule.levelCount, schedule.levels[pass] + 1);
+    }
+
+    // Transitive successors of each pass. Two passes are independent if neither reaches the other.
+    ReachabilitySet reachable(passCount);
+    for (auto it = schedule.order.rbegin(); it != schedule.order.rend(); ++it)
+    {
+        for (uint32_t s : successors[*it])
+        {
+            reachable.set(*it, s);
+            reachable.merge(*it, s);
+        }
+    }
+    auto isIndependent = [&](uint32_t a, uint32_t b) { return !reachable.get(a, b) && !reachable.get(b, a); };
+
+    // Queue assignment. Moving a pass to the async compute queue only pays off if there is graphics work to overlap with.
+    schedule.queues.assign(passCount, Queue::Graphics);
+    if (options.enableAsyncCompute)
+    {
+        for (uint32_t i = 0; i < passCount; i++)
+        {
+            if (!passes[i].asyncComputeCapable)
+                continue;
+            for (uint32_t j = 0; j < passCount; j++)
+            {
+                if (!passes[j].asyncComputeCapable && isIndependent(i, j))
+                {
+                    schedule.queues[i] = Queue::AsyncCompute;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Cross-queue synchronization. Queues execute in submission order, so waiting for a pass covers all earlier passes on its queue.
+    // lastWaited[q][r] is the position + 1 of the latest pass on queue r that queue q has waited for.
+    uint32_t lastWaited[kQueueCount][kQueueCount] = {};
+    for (uint32_t pass : schedule.order)
+    {
+        uint32_t q = (uint32_t)schedule.queues[pass];
+        uint32_t latest[kQueueCount] = {};
+        for (uint32_t p : predecessors[pass])
+        {
+            uint32_t r = (uint32_t)schedule.queues[p];
+            if (r != q)
+                latest[r] = std::max(latest[r], position[p] + 1);
+        }
+        for (uint32_t r = 0; r < kQueueCount; r++)
+        {
+            if (latest[r] > lastWaited[q][r])
+            {
+                schedule.syncs.push_back({schedule.order[latest[r] - 1], pass, (Queue)r, (Queue)q});
+                lastWaited[q][r] = latest[r];
+            }
+        }
+    }
+
+    // The graphics queue has to wait for the remaining async work before the graph results are used.
+    for (auto it = schedule.order.rbegin(); it != schedule.order.rend(); ++it)
+    {
+        if (schedule.queues[*it] != Queue::AsyncCompute)
+            continue;
+        const uint32_t g = (uint32_t)Queue::Graphics;
+        const uint32_t a = (uint32_t)Queue::AsyncCompute;
+        if (position[*it] + 1 > lastWaited[g][a])
+            schedule.syncs.push_back({*it, kEndOfGraph, Queue::AsyncCompute, Queue::Graphics});
+        break;
+    }
+
+    // Recording groups. Consecutive passes on a queue share a group as long as they are independent of all passes in it.
+    std::vector<int32_t> openGroup(kQueueCount, -1);
+    for (uint32_t pass : schedule.order)
+    {
+        uint32_t q = (uint32_t)schedule.queues[pass];
+        int32_t groupIndex = openGroup[q];
+        if (options.enableParallelRecording && groupIndex >= 0)
+        {
+            const auto& group = schedule.recordingGroups[groupIndex];
+            bool independent = std::all_of(group.begin(), group.end(), [&](uint32_t other) { return isIndependent(pass, other); });
+            if (independent)
+            {
+                schedule.recordingGroups[groupIndex].push_back(pass);
+                continue;
+            }
+        }
+        openGroup[q] = (int32_t)schedule.recordingGroups.size();
+        schedule.recordingGroups.push_back({pass});
+    }
+
+    return schedule;
+}
+} // namespace Falcor
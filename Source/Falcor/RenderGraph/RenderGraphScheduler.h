@@ -0,0 +1,121 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Computes an execution schedule for the passes of a compiled render graph.
+ *
+ * The input is a DAG of passes, where a dependency means that the destination pass consumes
+ * results of the source pass. The scheduler produces:
+ * - A submission order. The order is a topological order that preserves the input order of
+ *   the passes whenever the dependencies allow it.
+ * - A queue for each pass. Passes that only record compute/copy work are moved to the async
+ *   compute queue if there is graphics work they can overlap with.
+ * - The cross-queue synchronization required by the dependencies. Redundant waits, i.e. waits
+ *   on work that an earlier wait on the same queue already covers, are removed.
+ * - Groups of mutually independent passes on the same queue, whose command lists can be
+ *   recorded in parallel and submitted in order.
+ *
+ * The scheduler knows nothing about render passes or GPU resources, and is used by RenderGraphCompiler.
+ */
+class FALCOR_API RenderGraphScheduler
+{
+public:
+    enum class Queue : uint32_t
+    {
+        Graphics = 0,
+        AsyncCompute = 1,
+    };
+    static constexpr uint32_t kQueueCount = 2;
+
+    /// Pass identifier used for the end of the graph in QueueSync::waitPass.
+    static constexpr uint32_t kEndOfGraph = uint32_t(-1);
+
+    struct PassDesc
+    {
+        bool asyncComputeCapable = false; ///< True if the pass only records compute/copy work and may run on the async compute queue.
+    };
+
+    struct Dependency
+    {
+        uint32_t src; ///< Pass producing the data.
+        uint32_t dst; ///< Pass consuming the data.
+    };
+
+    /// Cross-queue synchronization. The waiting queue waits for the signaling queue before executing waitPass.
+    struct QueueSync
+    {
+        uint32_t signalPass; ///< Pass after which the signaling queue signals.
+        uint32_t waitPass;   ///< Pass before which the waiting queue waits, or kEndOfGraph.
+        Queue signalQueue;   ///< Queue of signalPass.
+        Queue waitQueue;     ///< Queue that waits.
+    };
+
+    struct Options
+    {
+        bool enableAsyncCompute = true;      ///< Allow passes to be moved to the async compute queue.
+        bool enableParallelRecording = true; ///< Group independent passes for parallel command recording.
+    };
+
+    struct Schedule
+    {
+        std::vector<uint32_t> order;                        ///< Passes in submission order.
+        std::vector<Queue> queues;                          ///< Queue of each pass.
+        std::vector<uint32_t> levels;                       ///< Dependency level of each pass. Passes on a level are independent.
+        std::vector<QueueSync> syncs;                       ///< Cross-queue synchronization, in submission order of the waiting pass.
+        std::vector<std::vector<uint32_t>> recordingGroups; ///< Groups of independent passes on the same queue, in submission order.
+        uint32_t levelCount = 0;                            ///< Number of dependency levels.
+
+        /// Get the number of passes scheduled on a queue.
+        uint32_t getPassCount(Queue queue) const;
+    };
+
+    /**
+     * Build a schedule.
+     * Throws an exception if the dependencies are invalid or contain a cycle.
+     * @param[in] passes Description of each pass.
+     * @param[in] dependencies Dependencies between passes.
+     * @param[in] options Scheduling options.
+     * @return The schedule.
+     */
+    static Schedule build(const std::vector<PassDesc>& passes, const std::vector<Dependency>& dependencies, const Options& options);
+
+    /**
+     * Build a schedule with the default options.
+     */
+    static Schedule build(const std::vector<PassDesc>& passes, const std::vector<Dependency>& dependencies)
+    {
+        return build(passes, dependencies, Options());
+    }
+};
+} // namespace Falcor
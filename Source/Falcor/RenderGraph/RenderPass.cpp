@@ -32,15 +32,26 @@ namespace Falcor
 RenderData::RenderData(
     const std::string& passName,
     ResourceCache& resources,
+    const ResourceCache::PassSlots& slots,
     Dictionary& dictionary,
     const uint2& defaultTexDims,
     ResourceFormat defaultTexFormat
 )
-    : mName(passName), mResources(resources), mDictionary(dictionary), mDefaultTexDims(defaultTexDims), mDefaultTexFormat(defaultTexFormat)
+    : mName(passName)
+    , mResources(resources)
+    , mSlots(slots)
+    , mDictionary(dictionary)
+    , mDefaultTexDims(defaultTexDims)
+    , mDefaultTexFormat(defaultTexFormat)
 {}
 
 const ref<Resource>& RenderData::getResource(const std::string_view name) const
 {
+    uint32_t slot = getSlot(name);
+    if (slot != kInvalidSlot)
+        return getResource(slot);
+
+    // Not declared by the pass, fall back to looking up the full name.
     return mResources.getResource(fmt::format("{}.{}", mName, name));
 }
 
@@ -50,6 +61,31 @@ ref<Texture> RenderData::getTexture(const std::string_view name) const
     return pResource ? pResource->asTexture() : nullptr;
 }
 
+uint32_t RenderData::getSlot(const std::string_view name) const
+{
+    // Passes declare a handful of fields, a linear scan is cheaper than hashing the name.
+    for (size_t i = 0; i < mSlots.fieldNames.size(); i++)
+    {
+        if (mSlots.fieldNames[i] == name)
+            return (uint32_t)i;
+    }
+    return kInvalidSlot;
+}
+
+const ref<Resource>& RenderData::getResource(uint32_t slot) const
+{
+    static const ref<Resource> pNull;
+    if (slot >= mSlots.slots.size())
+        return pNull;
+    return mResources.getResource(mSlots.slots[slot]);
+}
+
+ref<Texture> RenderData::getTexture(uint32_t slot) const
+{
+    auto pResource = getResource(slot);
+    return pResource ? pResource->asTexture() : nullptr;
+}
+
 ref<RenderPass> RenderPass::create(std::string_view type, ref<Device> pDevice, const Properties& props, PluginManager& pm)
 {
     // Try to load a plugin of the same name, if render pass class is not registered yet.
@@ -51,6 +51,8 @@ namespace Falcor
 class FALCOR_API RenderData
 {
 public:
+    static constexpr uint32_t kInvalidSlot = uint32_t(-1);
+
     /**
      * Get a resource
      * @param[in] name The name of the pass' resource (i.e. "outputColor"). No need to specify the pass' name
@@ -72,6 +74,28 @@ public:
      */
     ref<Texture> getTexture(const std::string_view name) const;
 
+    /**
+     * Get the slot of a pass' resource. Slots are resolved when the graph is compiled, so resources looked up by
+     * slot skip the name lookup. The slot of a field is its index in the reflection returned by `RenderPass::reflect()`.
+     * @param[in] name The name of the pass' resource (i.e. "outputColor"). No need to specify the pass' name
+     * @return The slot if the pass reflection declares the resource. Otherwise, kInvalidSlot
+     */
+    uint32_t getSlot(const std::string_view name) const;
+
+    /**
+     * Get a resource by slot
+     * @param[in] slot The slot of the resource, see getSlot()
+     * @return If the resource exists, a pointer to the resource. Otherwise, nullptr
+     */
+    const ref<Resource>& getResource(uint32_t slot) const;
+
+    /**
+     * Get a texture by slot
+     * @param[in] slot The slot of the texture, see getSlot()
+     * @return If the texture exists, a pointer to the texture. Otherwise, nullptr
+     */
+    ref<Texture> getTexture(uint32_t slot) const;
+
     /**
      * Get the global dictionary. You can use it to pass data between different passes
      */
@@ -91,6 +115,7 @@ protected:
     RenderData(
         const std::string& passName,
         ResourceCache& resources,
+        const ResourceCache::PassSlots& slots,
         Dictionary& dictionary,
         const uint2& defaultTexDims,
         ResourceFormat defaultTexFormat
@@ -98,6 +123,7 @@ protected:
 
     const std::string& mName;
     ResourceCache& mResources;
+    const ResourceCache::PassSlots& mSlots;
     Dictionary& mDictionary;
     uint2 mDefaultTexDims;
     ResourceFormat mDefaultTexFormat;
@@ -234,6 +260,12 @@ public:
      */
     virtual void onHotReload(HotReloadFlags reloaded) {}
 
+    /**
+     * Returns true if the pass only records compute and copy work in execute().
+     * The render graph may then schedule the pass on an async compute queue to overlap it with independent graphics work.
+     */
+    virtual bool isAsyncComputeCapable() const { return false; }
+
     /**
      * Get the current pass' name as defined in the graph
      */
@@ -27,6 +27,7 @@
  **************************************************************************/
 #pragma once
 #include "Core/Macros.h"
+#include "Utils/Dictionary.h"
 #include <cstdint>
 
 namespace Falcor
@@ -46,17 +47,17 @@ enum class RenderPassRefreshFlags : uint32_t
  * The refresh flags above are passed to RenderPass::execute() via a
  * field with this name in the dictionary.
  */
-static const char kRenderPassRefreshFlags[] = "_refreshFlags";
+inline const Dictionary::Key kRenderPassRefreshFlags{"_refreshFlags"};
 
 /**
  * First available preudorandom number generator dimension.
  */
-static const char kRenderPassPRNGDimension[] = "_prngDimension";
+inline const Dictionary::Key kRenderPassPRNGDimension{"_prngDimension"};
 
 /**
  * Adjust shading normals on primary hits.
  */
-static const char kRenderPassGBufferAdjustShadingNormals[] = "_gbufferAdjustShadingNormals";
+inline const Dictionary::Key kRenderPassGBufferAdjustShadingNormals{"_gbufferAdjustShadingNormals"};
 
 FALCOR_ENUM_CLASS_OPERATORS(RenderPassRefreshFlags);
 } // namespace Falcor
@@ -37,6 +37,8 @@ void ResourceCache::reset()
 {
     mNameToIndex.clear();
     mResourceData.clear();
+    mNameToSlot.clear();
+    mSlots.clear();
 }
 
 const ref<Resource>& ResourceCache::getResource(const std::string& name) const
@@ -56,6 +58,46 @@ const ref<Resource>& ResourceCache::getResource(const std::string& name) const
     return extIt->second;
 }
 
+uint32_t ResourceCache::resolveSlot(const std::string& name)
+{
+    auto [slotIt, inserted] = mNameToSlot.try_emplace(name, (uint32_t)mSlots.size());
+    if (!inserted)
+        return slotIt->second;
+
+    SlotData slot;
+    auto it = mNameToIndex.find(name);
+    slot.dataIndex = it != mNameToIndex.end() ? it->second : kInvalidIndex;
+    auto extIt = mExternalResources.find(name);
+    if (extIt != mExternalResources.end())
+        slot.pExternal = extIt->second;
+    mSlots.push_back(std::move(slot));
+    return slotIt->second;
+}
+
+ResourceCache::PassSlots ResourceCache::resolvePassSlots(const std::string& passName, const RenderPassReflection& reflection)
+{
+    PassSlots passSlots;
+    passSlots.fieldNames.reserve(reflection.getFieldCount());
+    passSlots.slots.reserve(reflection.getFieldCount());
+    for (size_t i = 0; i < reflection.getFieldCount(); i++)
+    {
+        const std::string& fieldName = reflection.getField(i)->getName();
+        passSlots.fieldNames.push_back(fieldName);
+        passSlots.slots.push_back(resolveSlot(passName + '.' + fieldName));
+    }
+    return passSlots;
+}
+
+const ref<Resource>& ResourceCache::getResource(uint32_t slot) const
+{
+    static const ref<Resource> pNull;
+    FALCOR_ASSERT(slot < mSlots.size());
+    const SlotData& data = mSlots[slot];
+    if (data.pExternal)
+        return data.pExternal;
+    return data.dataIndex != kInvalidIndex ? mResourceData[data.dataIndex].pResource : pNull;
+}
+
 const RenderPassReflection::Field& ResourceCache::getResourceReflection(const std::string& name) const
 {
     uint32_t i = mNameToIndex.at(name);
@@ -64,6 +106,10 @@ const RenderPassReflection::Field& ResourceCache::getResourceReflection(const st
 
 void ResourceCache::registerExternalResource(const std::string& name, const ref<Resource>& pResource)
 {
+    auto slotIt = mNameToSlot.find(name);
+    if (slotIt != mNameToSlot.end())
+        mSlots[slotIt->second].pExternal = pResource;
+
     if (pResource)
         mExternalResources[name] = pResource;
     else
@@ -191,14 +237,52 @@ inline ref<Resource> createResourceForPass(
     return pResource;
 }
 
-void ResourceCache::allocateResources(ref<Device> pDevice, const DefaultProperties& params)
+inline bool usesDefaultProperties(const RenderPassReflection::Field& field)
 {
+    if (field.getWidth() == 0)
+        return true;
+    if (field.getType() == RenderPassReflection::Field::Type::RawBuffer)
+        return false;
+    return field.getHeight() == 0 || field.getFormat() == ResourceFormat::Unknown;
+}
+
+ResourceCache::AllocationStats ResourceCache::allocateResources(
+    ref<Device> pDevice,
+    const DefaultProperties& params,
+    const ResourceCache* pPrevious
+)
+{
+    AllocationStats stats;
+    bool sameDefaults = pPrevious && all(pPrevious->mDefaultProperties.dims == params.dims) &&
+                        pPrevious->mDefaultProperties.format == params.format;
+
     for (auto& data : mResourceData)
     {
         if ((data.pResource == nullptr) && (data.field.isValid()))
         {
+            // Take over the resource of the previous compilation if it would be created with the same properties.
+            if (pPrevious)
+            {
+                auto it = pPrevious->mNameToIndex.find(data.name);
+                if (it != pPrevious->mNameToIndex.end())
+                {
+                    const auto& prevData = pPrevious->mResourceData[it->second];
+                    if (prevData.pResource && prevData.name == data.name && prevData.field == data.field &&
+                        prevData.resolveBindFlags == data.resolveBindFlags && (sameDefaults || !usesDefaultProperties(data.field)))
+                    {
+                        data.pResource = prevData.pResource;
+                        stats.reusedCount++;
+                        continue;
+                    }
+                }
+            }
+
             data.pResource = createResourceForPass(pDevice, params, data.field, data.resolveBindFlags, data.name);
+            stats.allocatedCount++;
         }
     }
+
+    mDefaultProperties = params;
+    return stats;
 }
 } // namespace Falcor
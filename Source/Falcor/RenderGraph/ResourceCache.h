@@ -51,6 +51,25 @@ public:
         ResourceFormat format = ResourceFormat::Unknown; ///< Format to use for texture creation
     };
 
+    /**
+     * Statistics of a call to allocateResources().
+     */
+    struct AllocationStats
+    {
+        uint32_t allocatedCount = 0; ///< Number of resources that were created.
+        uint32_t reusedCount = 0;    ///< Number of resources that were taken over from the previous cache.
+    };
+
+    /**
+     * Resource slots of a single pass, resolved once during graph compilation.
+     * Entries are stored in the order of the fields in the pass reflection.
+     */
+    struct PassSlots
+    {
+        std::vector<std::string> fieldNames; ///< Field names without the pass name.
+        std::vector<uint32_t> slots;         ///< Cache slot for each field.
+    };
+
     /**
      * Add/Remove reference to a graph input resource not owned by the cache
      * @param[in] name The resource's name
@@ -78,6 +97,27 @@ public:
      */
     const ref<Resource>& getResource(const std::string& name) const;
 
+    /**
+     * Resolve a resource name to a slot that can be used for fast lookups.
+     * Must be called after all fields have been registered. The slot tracks external resources registered
+     * after the call, and is valid until reset() is called.
+     * @param[in] name String in the format of PassName.FieldName
+     * @return The slot index.
+     */
+    uint32_t resolveSlot(const std::string& name);
+
+    /**
+     * Resolve the slots for all fields of a pass.
+     * @param[in] passName The name of the pass.
+     * @param[in] reflection The reflection of the pass.
+     */
+    PassSlots resolvePassSlots(const std::string& passName, const RenderPassReflection& reflection);
+
+    /**
+     * Get a resource by slot. Includes external resources known by the cache.
+     */
+    const ref<Resource>& getResource(uint32_t slot) const;
+
     /**
      * Get the field-reflection of a resource
      */
@@ -86,8 +126,14 @@ public:
     /**
      * Allocate all resources that need to be created/updated.
      * This includes new resources, resources whose properties have been updated since last allocation call.
+     * @param[in] pDevice GPU device.
+     * @param[in] params Properties to use for fields that don't fully specify their resource.
+     * @param[in] pPrevious Optional. Cache of a previous compilation of the graph. Resources registered under the same name
+     * with the same resolved properties are taken over instead of being recreated. Taken over resources are not cleared,
+     * so they keep the contents written before the recompilation until the passes overwrite them.
+     * @return Allocation statistics.
      */
-    void allocateResources(ref<Device> pDevice, const DefaultProperties& params);
+    AllocationStats allocateResources(ref<Device> pDevice, const DefaultProperties& params, const ResourceCache* pPrevious = nullptr);
 
     /**
      * Clears all registered field/resource properties and allocated resources.
@@ -107,9 +153,20 @@ private:
     // Resources and properties for fields within (and therefore owned by) a render graph
     std::unordered_map<std::string, uint32_t> mNameToIndex;
     std::vector<ResourceData> mResourceData;
+    DefaultProperties mDefaultProperties; // Properties used by the last allocateResources() call
 
     // References to output resources not to be allocated by the render graph
     ResourcesMap mExternalResources;
+
+    // Pre-resolved lookups. A slot refers to an external resource if one is registered, otherwise to an entry in mResourceData.
+    struct SlotData
+    {
+        uint32_t dataIndex;      // Index into mResourceData, or kInvalidIndex if the name is not owned by the cache
+        ref<Resource> pExternal; // External resource registered under the name, if any
+    };
+    static constexpr uint32_t kInvalidIndex = uint32_t(-1);
+    std::unordered_map<std::string, uint32_t> mNameToSlot;
+    std::vector<SlotData> mSlots;
 };
 
 } // namespace Falcor
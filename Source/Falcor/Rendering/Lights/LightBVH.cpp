@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "LightBVH.h"
+#include "LightBVHBuilder.h"
 #include "Core/Error.h"
 #include "Core/API/RenderContext.h"
 #include "Utils/Timing/Profiler.h"
@@ -51,6 +52,7 @@ namespace Falcor
         FALCOR_PROFILE(pRenderContext, "LightBVH::refit()");
 
         FALCOR_ASSERT(mIsValid);
+        FALCOR_CHECK(!mUseCompactNodes, "Compact light BVH nodes can't be refitted on the GPU. Use LightBVHBuilder::update() instead.");
 
         // Update all leaf nodes.
         {
@@ -133,6 +135,9 @@ namespace Falcor
     {
         // Reset all CPU data.
         mNodes.clear();
+        mTriangleIndices.clear();
+        mTriangleBitmasks.clear();
+        mReferenceCosts.clear();
         mNodeIndices.clear();
         mPerDepthRefitEntryInfo.clear();
         mMaxTriangleCountPerLeaf = 0;
@@ -213,7 +218,7 @@ namespace Falcor
         };
         traverseBVH(evalInternal, evalLeaf);
 
-        mBVHStats.byteSize = (uint32_t)(mNodes.size() * sizeof(mNodes[0]));
+        mBVHStats.byteSize = (uint32_t)(mNodes.size() * (mUseCompactNodes ? sizeof(CompactNode) : sizeof(PackedNode)));
     }
 
     void LightBVH::updateNodeIndices()
@@ -269,36 +274,60 @@ namespace Falcor
         mpNodeIndicesBuffer->setBlob(mNodeIndices.data(), 0, mNodeIndices.size() * sizeof(uint32_t));
     }
 
-    void LightBVH::uploadCPUBuffers(const std::vector<uint32_t>& triangleIndices, const std::vector<uint64_t>& triangleBitmasks)
+    void LightBVH::uploadCPUBuffers()
     {
         // Reallocate buffers if size requirements have changed.
         auto var = mLeafUpdater->getRootVar()["CB"]["gLightBVH"];
-        if (!mpBVHNodesBuffer || mpBVHNodesBuffer->getElementCount() < mNodes.size())
+        if (mUseCompactNodes)
         {
-            mpBVHNodesBuffer = mpDevice->createStructuredBuffer(var["nodes"], (uint32_t)mNodes.size(), ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal, nullptr, false);
-            mpBVHNodesBuffer->setName("LightBVH::mpBVHNodesBuffer");
+            // The compact nodes are only used for sampling, so the packed nodes are kept on the CPU only.
+            mpBVHNodesBuffer = nullptr;
+            if (!mpCompactNodesBuffer || mpCompactNodesBuffer->getElementCount() < mNodes.size())
+            {
+                mpCompactNodesBuffer = mpDevice->createStructuredBuffer(sizeof(CompactNode), (uint32_t)mNodes.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
+                mpCompactNodesBuffer->setName("LightBVH::mpCompactNodesBuffer");
+            }
+        }
+        else
+        {
+            mpCompactNodesBuffer = nullptr;
+            if (!mpBVHNodesBuffer || mpBVHNodesBuffer->getElementCount() < mNodes.size())
+            {
+                mpBVHNodesBuffer = mpDevice->createStructuredBuffer(var["nodes"], (uint32_t)mNodes.size(), ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal, nullptr, false);
+                mpBVHNodesBuffer->setName("LightBVH::mpBVHNodesBuffer");
+            }
         }
-        if (!mpTriangleIndicesBuffer || mpTriangleIndicesBuffer->getElementCount() < triangleIndices.size())
+        if (!mpTriangleIndicesBuffer || mpTriangleIndicesBuffer->getElementCount() < mTriangleIndices.size())
         {
-            mpTriangleIndicesBuffer = mpDevice->createStructuredBuffer(var["triangleIndices"], (uint32_t)triangleIndices.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
+            mpTriangleIndicesBuffer = mpDevice->createStructuredBuffer(var["triangleIndices"], (uint32_t)mTriangleIndices.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
             mpTriangleIndicesBuffer->setName("LightBVH::mpTriangleIndicesBuffer");
         }
-        if (!mpTriangleBitmasksBuffer || mpTriangleBitmasksBuffer->getElementCount() < triangleBitmasks.size())
+        if (!mpTriangleBitmasksBuffer || mpTriangleBitmasksBuffer->getElementCount() < mTriangleBitmasks.size())
         {
-            mpTriangleBitmasksBuffer = mpDevice->createStructuredBuffer(var["triangleBitmasks"], (uint32_t)triangleBitmasks.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
+            mpTriangleBitmasksBuffer = mpDevice->createStructuredBuffer(var["triangleBitmasks"], (uint32_t)mTriangleBitmasks.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
             mpTriangleBitmasksBuffer->setName("LightBVH::mpTriangleBitmasksBuffer");
         }
 
         // Update our GPU side buffers.
-        FALCOR_ASSERT(mpBVHNodesBuffer->getElementCount() >= mNodes.size());
-        FALCOR_ASSERT(mpBVHNodesBuffer->getStructSize() == sizeof(mNodes[0]));
-        mpBVHNodesBuffer->setBlob(mNodes.data(), 0, mNodes.size() * sizeof(mNodes[0]));
+        if (mUseCompactNodes)
+        {
+            // The root node is bound separately in full precision, see bindShaderData(). The compact nodes are encoded relative to it.
+            const auto compactData = LightBVHBuilder::encodeCompactNodes(mNodes);
+            FALCOR_ASSERT(compactData.nodes.size() == mNodes.size());
+            mpCompactNodesBuffer->setBlob(compactData.nodes.data(), 0, compactData.nodes.size() * sizeof(CompactNode));
+        }
+        else
+        {
+            FALCOR_ASSERT(mpBVHNodesBuffer->getElementCount() >= mNodes.size());
+            FALCOR_ASSERT(mpBVHNodesBuffer->getStructSize() == sizeof(mNodes[0]));
+            mpBVHNodesBuffer->setBlob(mNodes.data(), 0, mNodes.size() * sizeof(mNodes[0]));
+        }
 
-        FALCOR_ASSERT(mpTriangleIndicesBuffer->getSize() >= triangleIndices.size() * sizeof(triangleIndices[0]));
-        mpTriangleIndicesBuffer->setBlob(triangleIndices.data(), 0, triangleIndices.size() * sizeof(triangleIndices[0]));
+        FALCOR_ASSERT(mpTriangleIndicesBuffer->getSize() >= mTriangleIndices.size() * sizeof(mTriangleIndices[0]));
+        mpTriangleIndicesBuffer->setBlob(mTriangleIndices.data(), 0, mTriangleIndices.size() * sizeof(mTriangleIndices[0]));
 
-        FALCOR_ASSERT(mpTriangleBitmasksBuffer->getSize() >= triangleBitmasks.size() * sizeof(triangleBitmasks[0]));
-        mpTriangleBitmasksBuffer->setBlob(triangleBitmasks.data(), 0, triangleBitmasks.size() * sizeof(triangleBitmasks[0]));
+        FALCOR_ASSERT(mpTriangleBitmasksBuffer->getSize() >= mTriangleBitmasks.size() * sizeof(mTriangleBitmasks[0]));
+        mpTriangleBitmasksBuffer->setBlob(mTriangleBitmasks.data(), 0, mTriangleBitmasks.size() * sizeof(mTriangleBitmasks[0]));
 
         mIsCpuDataValid = true;
     }
@@ -307,6 +336,9 @@ namespace Falcor
     {
         if (!mIsValid || mIsCpuDataValid) return;
 
+        // Compact nodes are only encoded from the CPU-side nodes, which are therefore always valid.
+        FALCOR_ASSERT(!mUseCompactNodes);
+
         // TODO: This is slow because of the flush. We should copy to a staging buffer
         // after the data is updated on the GPU and map the staging buffer here instead.
         FALCOR_ASSERT(mNodes.size() > 0 && mNodes.size() <= mpBVHNodesBuffer->getElementCount());
@@ -319,7 +351,15 @@ namespace Falcor
         if (isValid())
         {
             FALCOR_ASSERT(var.isValid());
-            var["nodes"] = mpBVHNodesBuffer;
+            if (mUseCompactNodes)
+            {
+                var["compactNodes"] = mpCompactNodesBuffer;
+                var["rootNode"].setBlob(mNodes[0]);
+            }
+            else
+            {
+                var["nodes"] = mpBVHNodesBuffer;
+            }
             var["triangleIndices"] = mpTriangleIndicesBuffer;
             var["triangleBitmasks"] = mpTriangleBitmasksBuffer;
         }
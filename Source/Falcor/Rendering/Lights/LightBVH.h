@@ -80,6 +80,7 @@ namespace Falcor
 
         /** Refit all the BVH nodes to the underlying geometry, without changing the hierarchy.
             The BVH needs to have been built before trying to refit it.
+            The refit runs on the GPU and is not available with compact nodes, use LightBVHBuilder::update() instead.
             \param[in] pRenderContext The render context.
         */
         void refit(RenderContext* pRenderContext);
@@ -113,6 +114,11 @@ namespace Falcor
         */
         bool isValid() const { return mIsValid; }
 
+        /** Returns true if the nodes are stored in the compact format on the GPU, see LightBVHBuilder::Options::useCompactNodes.
+            Shaders using the BVH need to be compiled with _USE_COMPACT_BVH_NODES set accordingly.
+        */
+        bool usesCompactNodes() const { return mUseCompactNodes; }
+
         /** Render the UI. This default implementation just shows the stats.
         */
         void renderUI(Gui::Widgets& widget);
@@ -128,7 +134,7 @@ namespace Falcor
         void updateNodeIndices();
         void renderStats(Gui::Widgets& widget, const BVHStats& stats) const;
 
-        void uploadCPUBuffers(const std::vector<uint32_t>& triangleIndices, const std::vector<uint64_t>& triangleBitmasks);
+        void uploadCPUBuffers();
         void syncDataToCPU() const;
 
         /** Invalidate the BVH.
@@ -150,15 +156,20 @@ namespace Falcor
 
         // CPU resources
         mutable std::vector<PackedNode>       mNodes;                   ///< CPU-side copy of packed BVH nodes.
+        std::vector<uint32_t>                 mTriangleIndices;         ///< CPU-side copy of the triangle indices sorted by leaf node.
+        std::vector<uint64_t>                 mTriangleBitmasks;        ///< CPU-side copy of the per triangle bitmasks.
+        std::vector<float>                    mReferenceCosts;          ///< Per node cost at the time the node was built. Used by LightBVHBuilder::update().
         std::vector<uint32_t>                 mNodeIndices;             ///< Array of all node indices sorted by tree depth.
         std::vector<RefitEntryInfo>           mPerDepthRefitEntryInfo;  ///< Array containing for each level the number of internal nodes as well as the corresponding offset into 'mpNodeIndicesBuffer'; the very last entry contains the same data, but for all leaf nodes instead.
         uint32_t                              mMaxTriangleCountPerLeaf = 0; ///< After the BVH is built, this contains the maximum light count per leaf node.
         BVHStats                              mBVHStats;
         bool                                  mIsValid = false;         ///< True when the BVH has been built.
+        bool                                  mUseCompactNodes = false; ///< True if the nodes are uploaded in the compact format. The CPU-side nodes are always packed nodes.
         mutable bool                          mIsCpuDataValid = false;  ///< Indicates whether the CPU-side data matches the GPU buffers.
 
         // GPU resources
-        ref<Buffer>                           mpBVHNodesBuffer;         ///< Buffer holding all BVH nodes.
+        ref<Buffer>                           mpBVHNodesBuffer;         ///< Buffer holding all BVH nodes. Not allocated when using compact nodes.
+        ref<Buffer>                           mpCompactNodesBuffer;     ///< Buffer holding all BVH nodes in the compact format. Only allocated when using compact nodes.
         ref<Buffer>                           mpTriangleIndicesBuffer;  ///< Triangle indices sorted by leaf node. Each leaf node refers to a contiguous array of triangle indices.
         ref<Buffer>                           mpTriangleBitmasksBuffer; ///< Array containing the per triangle bit pattern retracing the tree traversal to reach the triangle: 0=left child, 1=right child.
         ref<Buffer>                           mpNodeIndicesBuffer;      ///< Buffer holding all node indices sorted by tree depth. This is used for BVH refit.
@@ -30,7 +30,10 @@
 #include "Utils/Logger.h"
 #include "Utils/Timing/Profiler.h"
 #include "Utils/Math/MathConstants.slangh"
+#include "Utils/NumericRange.h"
 #include <algorithm>
+#include <execution>
+#include <functional>
 
 namespace
 {
@@ -220,6 +223,9 @@ namespace
 namespace Falcor
 {
     static_assert(sizeof(PackedNode) % 16 == 0, "PackedNode size should be a multiple of 16");
+    static_assert(sizeof(CompactNode) == 16, "CompactNode size should be 16B");
+
+    static std::vector<float> evalNodeCosts(const std::vector<PackedNode>& nodes, const LightBVHBuilder::Options& parameters);
 
     LightBVHBuilder::LightBVHBuilder(const Options& options) : mOptions(options)
     {
@@ -237,27 +243,72 @@ namespace Falcor
         const auto& triangles = bvh.mpLightCollection->getMeshLightTriangles(pRenderContext);
         if (triangles.empty()) return;
 
+        BVHData data;
+        buildData(triangles, data);
+
+        // If there are no non-culled triangles, we're done.
+        if (data.nodes.empty()) return;
+
+        // The BVH is ready, mark it as valid and upload the data.
+        bvh.mNodes = std::move(data.nodes);
+        bvh.mTriangleIndices = std::move(data.triangleIndices);
+        bvh.mTriangleBitmasks = std::move(data.triangleBitmasks);
+        bvh.mReferenceCosts = std::move(data.referenceCosts);
+        bvh.mIsValid = true;
+        bvh.mMaxTriangleCountPerLeaf = mOptions.maxTriangleCountPerLeaf;
+        bvh.mUseCompactNodes = mOptions.useCompactNodes;
+        bvh.uploadCPUBuffers();
+
+        // Computate metadata.
+        bvh.finalize();
+    }
+
+    LightBVHBuilder::QualityStats LightBVHBuilder::update(RenderContext* pRenderContext, LightBVH& bvh)
+    {
+        FALCOR_PROFILE(pRenderContext, "LightBVHBuilder::update()");
+
+        FALCOR_ASSERT(bvh.isValid());
+        const auto& triangles = bvh.mpLightCollection->getMeshLightTriangles(pRenderContext);
+
+        BVHData data{ std::move(bvh.mNodes), std::move(bvh.mTriangleIndices), std::move(bvh.mTriangleBitmasks), std::move(bvh.mReferenceCosts) };
+        QualityStats stats;
+        try
+        {
+            refitData(triangles, data);
+            stats = mOptions.allowPartialRebuild ? rebuildDegradedSubtrees(triangles, data) : evalQuality(data);
+        }
+        catch (...)
+        {
+            bvh.clear();
+            throw;
+        }
+
+        bvh.mNodes = std::move(data.nodes);
+        bvh.mTriangleIndices = std::move(data.triangleIndices);
+        bvh.mTriangleBitmasks = std::move(data.triangleBitmasks);
+        bvh.mReferenceCosts = std::move(data.referenceCosts);
+        bvh.uploadCPUBuffers();
+
+        // The hierarchy has changed, recompute the metadata.
+        if (stats.degradedSubtreeCount > 0) bvh.finalize();
+
+        return stats;
+    }
+
+    void LightBVHBuilder::buildData(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& bvhData)
+    {
+        bvhData = BVHData();
+
         // Create list of triangles that should be included in BVH.
         // For each triangle, precompute data we need for the build.
-        BuildingData data(bvh.mNodes);
+        BuildingData data(bvhData.nodes);
         data.trianglesData.reserve(triangles.size());
 
         for (size_t i = 0; i < triangles.size(); i++)
         {
             if (!mOptions.usePreintegration || triangles[i].flux > 0.f)
             {
-                LightBVHBuilder::TriangleSortData tri;
-                for (uint32_t j = 0; j < 3; j++)
-                {
-                    tri.bounds |= triangles[i].vtx[j].pos;
-                }
-                tri.center = triangles[i].getCenter();
-                tri.coneDirection = triangles[i].normal;
-                tri.cosConeAngle = 1.f; // Single flat emitter => normal bounding cone angle is zero.
-                tri.flux = triangles[i].flux;
-                tri.triangleIndex = static_cast<uint32_t>(i);
-
-                data.trianglesData.push_back(tri);
+                data.trianglesData.push_back(createTriangleSortData(triangles[i], static_cast<uint32_t>(i)));
             }
         }
 
@@ -299,13 +350,9 @@ namespace Falcor
         float cosConeAngle;
         computeLightingConesInternal(0, data, cosConeAngle);
 
-        // The BVH is ready, mark it as valid and upload the data.
-        bvh.mIsValid = true;
-        bvh.mMaxTriangleCountPerLeaf = mOptions.maxTriangleCountPerLeaf;
-        bvh.uploadCPUBuffers(data.triangleIndices, data.triangleBitmasks);
-
-        // Computate metadata.
-        bvh.finalize();
+        bvhData.triangleIndices = std::move(data.triangleIndices);
+        bvhData.triangleBitmasks = std::move(data.triangleBitmasks);
+        bvhData.referenceCosts = evalNodeCosts(bvhData.nodes, mOptions);
     }
 
     bool LightBVHBuilder::renderUI(Gui::Widgets& widget)
@@ -319,6 +366,17 @@ namespace Falcor
         bool optionsChanged = false;
 
         optionsChanged |= widget.checkbox("Allow refitting", options.allowRefitting);
+        if (options.allowRefitting)
+        {
+            optionsChanged |= widget.checkbox("Allow partial rebuild", options.allowPartialRebuild);
+            widget.tooltip("Refit the BVH on the CPU and rebuild the subtrees whose cost has degraded since they were built.");
+            if (options.allowPartialRebuild)
+            {
+                optionsChanged |= widget.var("Rebuild cost threshold", options.rebuildCostThreshold, 1.f, std::numeric_limits<float>::max(), 0.05f);
+            }
+        }
+        optionsChanged |= widget.checkbox("Use compact nodes", options.useCompactNodes);
+        widget.tooltip("Store the nodes in a 16B format quantized relative to their parent. This halves the node memory, but the BVH is refitted on the CPU.");
         optionsChanged |= widget.var("Max triangle count per leaf", options.maxTriangleCountPerLeaf, 1u, kMaxLeafTriangleCount);
         optionsChanged |= widget.dropdown("Split heuristic", options.splitHeuristicSelection);
 
@@ -374,8 +432,13 @@ namespace Falcor
             FALCOR_ASSERT(triangleRange.begin < splitResult.triangleIndex && splitResult.triangleIndex < triangleRange.end);
 
             // Sort the centroids and update the lists accordingly.
-            auto comp = [dim = splitResult.axis](const TriangleSortData& d1, const TriangleSortData& d2) { return d1.bounds.center()[dim] < d2.bounds.center()[dim]; };
-            std::nth_element(std::begin(data.trianglesData) + triangleRange.begin, std::begin(data.trianglesData) + splitResult.triangleIndex, std::begin(data.trianglesData) + triangleRange.end, comp);
+            // Only the indices into the triangle data are moved, the triangle data stays in place.
+            auto& trianglesData = data.trianglesData;
+            auto comp = [&trianglesData, dim = splitResult.axis](uint32_t i1, uint32_t i2)
+            {
+                return trianglesData.boundsMin[i1][dim] + trianglesData.boundsMax[i1][dim] < trianglesData.boundsMin[i2][dim] + trianglesData.boundsMax[i2][dim];
+            };
+            std::nth_element(std::begin(trianglesData.order) + triangleRange.begin, std::begin(trianglesData.order) + splitResult.triangleIndex, std::begin(trianglesData.order) + triangleRange.end, comp);
 
             // Allocate internal node.
             FALCOR_ASSERT(data.nodes.size() < std::numeric_limits<uint32_t>::max());
@@ -428,7 +491,7 @@ namespace Falcor
             {
                 uint32_t globalTriangleIndex = data.trianglesData[triangleIdx].triangleIndex;
                 data.triangleIndices.push_back(globalTriangleIndex);
-                data.triangleBitmasks[globalTriangleIndex] = bitmask;
+                if (!data.triangleBitmasks.empty()) data.triangleBitmasks[globalTriangleIndex] = bitmask;
             }
             FALCOR_ASSERT(data.triangleIndices.size() == node.triangleOffset + node.triangleCount);
 
@@ -879,4 +942,496 @@ namespace Falcor
             FALCOR_THROW("Unsupported SplitHeuristic: {}", static_cast<uint32_t>(heuristic));
         }
     }
+
+    LightBVHBuilder::TriangleSortData LightBVHBuilder::createTriangleSortData(const LightCollection::MeshLightTriangle& triangle, uint32_t triangleIndex)
+    {
+        TriangleSortData tri;
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            tri.bounds |= triangle.vtx[j].pos;
+        }
+        tri.coneDirection = triangle.normal;
+        tri.cosConeAngle = 1.f; // Single flat emitter => normal bounding cone angle is zero.
+        tri.flux = triangle.flux;
+        tri.triangleIndex = triangleIndex;
+        return tri;
+    }
+
+    /** Evaluates the cost of each node according to the split heuristic.
+        The SAOH cost is used for the BinnedSAOH heuristic, the SAH cost otherwise.
+    */
+    static std::vector<float> evalNodeCosts(const std::vector<PackedNode>& nodes, const LightBVHBuilder::Options& parameters)
+    {
+        // The nodes are stored in depth-first order, so iterating backwards visits the children before their parent.
+        std::vector<uint32_t> triangleCounts(nodes.size());
+        std::vector<float> costs(nodes.size());
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            if (nodes[i].isLeaf())
+            {
+                triangleCounts[i] = nodes[i].getLeafNode().triangleCount;
+            }
+            else
+            {
+                triangleCounts[i] = triangleCounts[i + 1] + triangleCounts[nodes[i].getInternalNode().rightChildIdx];
+            }
+
+            SharedNodeAttributes attribs = nodes[i].getNodeAttributes();
+            float3 aabbMin, aabbMax;
+            attribs.getAABB(aabbMin, aabbMax);
+            const AABB bounds(aabbMin, aabbMax);
+            costs[i] = parameters.splitHeuristicSelection == LightBVHBuilder::SplitHeuristic::BinnedSAOH
+                ? evalSAOH(bounds, attribs.flux, attribs.cosConeAngle, parameters)
+                : evalSAH(bounds, triangleCounts[i], parameters);
+        }
+        return costs;
+    }
+
+    namespace
+    {
+        /** Per node data used for finding and rebuilding degraded subtrees.
+        */
+        struct SubtreeInfo
+        {
+            float cost = 0.f;               ///< Current cost of the subtree.
+            float referenceCost = 0.f;      ///< Cost of the subtree at the time its nodes were built.
+            uint32_t triangleOffset = 0;    ///< Offset of the subtree triangles in the triangle index list.
+            uint32_t triangleCount = 0;     ///< Number of triangles in the subtree.
+        };
+
+        struct DegradedSubtree
+        {
+            uint32_t nodeIndex;
+            uint32_t depth;
+        };
+
+        std::vector<SubtreeInfo> computeSubtreeInfo(const std::vector<PackedNode>& nodes, const std::vector<float>& nodeCosts, const std::vector<float>& referenceCosts)
+        {
+            FALCOR_CHECK(referenceCosts.size() == nodes.size(), "BVH data has {} reference costs for {} nodes.", referenceCosts.size(), nodes.size());
+
+            std::vector<SubtreeInfo> info(nodes.size());
+            for (size_t i = nodes.size(); i-- > 0;)
+            {
+                info[i].cost = nodeCosts[i];
+                info[i].referenceCost = referenceCosts[i];
+                if (nodes[i].isLeaf())
+                {
+                    const LeafNode leaf = nodes[i].getLeafNode();
+                    info[i].triangleOffset = leaf.triangleOffset;
+                    info[i].triangleCount = leaf.triangleCount;
+                }
+                else
+                {
+                    // The triangles of the left subtree come first.
+                    const SubtreeInfo& left = info[i + 1];
+                    const SubtreeInfo& right = info[nodes[i].getInternalNode().rightChildIdx];
+                    info[i].cost += left.cost + right.cost;
+                    info[i].referenceCost += left.referenceCost + right.referenceCost;
+                    info[i].triangleOffset = left.triangleOffset;
+                    info[i].triangleCount = left.triangleCount + right.triangleCount;
+                }
+            }
+            return info;
+        }
+
+        bool isDegraded(const SubtreeInfo& subtree, float costThreshold)
+        {
+            return subtree.referenceCost > 0.f && subtree.cost > costThreshold * subtree.referenceCost;
+        }
+
+        /** Returns the subtrees to rebuild, in node order.
+            A subtree whose cost grew by more than the given factor is rebuilt, unless the degradation comes from a single
+            child subtree. In that case, only the child subtree is considered for rebuild, so that degraded subtrees are
+            rebuilt as deep in the tree as possible.
+        */
+        std::vector<DegradedSubtree> findDegradedSubtrees(const std::vector<PackedNode>& nodes, const std::vector<SubtreeInfo>& info, float costThreshold)
+        {
+            std::vector<DegradedSubtree> subtrees;
+            std::vector<DegradedSubtree> stack = { { 0, 0 } };
+            while (!stack.empty())
+            {
+                const DegradedSubtree location = stack.back();
+                stack.pop_back();
+                if (nodes[location.nodeIndex].isLeaf()) continue;
+
+                const uint32_t leftIndex = location.nodeIndex + 1;
+                const uint32_t rightIndex = nodes[location.nodeIndex].getInternalNode().rightChildIdx;
+                if (isDegraded(info[location.nodeIndex], costThreshold))
+                {
+                    const bool isLeftDegraded = isDegraded(info[leftIndex], costThreshold);
+                    const bool isRightDegraded = isDegraded(info[rightIndex], costThreshold);
+                    const uint32_t childIndex = isLeftDegraded ? leftIndex : rightIndex;
+                    if (isLeftDegraded == isRightDegraded || nodes[childIndex].isLeaf())
+                    {
+                        subtrees.push_back(location);
+                    }
+                    else
+                    {
+                        stack.push_back({ childIndex, location.depth + 1 });
+                    }
+                    continue;
+                }
+
+                stack.push_back({ rightIndex, location.depth + 1 });
+                stack.push_back({ leftIndex, location.depth + 1 });
+            }
+            std::sort(subtrees.begin(), subtrees.end(), [](const DegradedSubtree& a, const DegradedSubtree& b) { return a.nodeIndex < b.nodeIndex; });
+            return subtrees;
+        }
+    }
+
+    void LightBVHBuilder::refitData(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& bvhData)
+    {
+        FALCOR_CHECK(!bvhData.nodes.empty(), "BVH needs to be built before it can be refitted.");
+        FALCOR_CHECK(triangles.size() == bvhData.triangleBitmasks.size(), "BVH was built for {} triangles, got {}.", bvhData.triangleBitmasks.size(), triangles.size());
+
+        // Prepare the light data in the same order as the triangle indices, so that each leaf node refers to a contiguous range.
+        BuildingData data(bvhData.nodes);
+        data.trianglesData.reserve(bvhData.triangleIndices.size());
+        for (uint32_t triangleIndex : bvhData.triangleIndices)
+        {
+            data.trianglesData.push_back(createTriangleSortData(triangles[triangleIndex], triangleIndex));
+        }
+
+        refitInternal(0, data);
+
+        float cosConeAngle;
+        computeLightingConesInternal(0, data, cosConeAngle);
+    }
+
+    AABB LightBVHBuilder::refitInternal(const uint32_t nodeIndex, BuildingData& data)
+    {
+        if (data.nodes[nodeIndex].isLeaf())
+        {
+            LeafNode node = data.nodes[nodeIndex].getLeafNode();
+            const Range triangleRange(node.triangleOffset, node.triangleOffset + node.triangleCount);
+
+            AABB nodeBounds;
+            float nodeFlux = 0.f;
+            for (uint32_t dataIndex = triangleRange.begin; dataIndex < triangleRange.end; ++dataIndex)
+            {
+                nodeBounds |= data.trianglesData[dataIndex].bounds;
+                nodeFlux += data.trianglesData[dataIndex].flux;
+            }
+
+            node.attribs.setAABB(nodeBounds.minPoint, nodeBounds.maxPoint);
+            node.attribs.flux = nodeFlux;
+            float cosTheta;
+            node.attribs.coneDirection = computeLightingCone(triangleRange, data, cosTheta);
+            node.attribs.cosConeAngle = cosTheta;
+            data.nodes[nodeIndex].setLeafNode(node);
+            return nodeBounds;
+        }
+        else
+        {
+            InternalNode node = data.nodes[nodeIndex].getInternalNode();
+            const uint32_t leftIndex = nodeIndex + 1;
+            const uint32_t rightIndex = node.rightChildIdx;
+
+            // Use the exact bounds of the children, the packed bounds are rounded up.
+            AABB nodeBounds = refitInternal(leftIndex, data);
+            nodeBounds |= refitInternal(rightIndex, data);
+            float nodeFlux = data.nodes[leftIndex].getNodeAttributes().flux + data.nodes[rightIndex].getNodeAttributes().flux;
+
+            // The lighting cone is updated by computeLightingConesInternal().
+            node.attribs.setAABB(nodeBounds.minPoint, nodeBounds.maxPoint);
+            node.attribs.flux = nodeFlux;
+            data.nodes[nodeIndex].setInternalNode(node);
+            return nodeBounds;
+        }
+    }
+
+    LightBVHBuilder::QualityStats LightBVHBuilder::evalQuality(const BVHData& data) const
+    {
+        QualityStats stats;
+        if (data.nodes.empty()) return stats;
+
+        const auto info = computeSubtreeInfo(data.nodes, evalNodeCosts(data.nodes, mOptions), data.referenceCosts);
+        stats.cost = info[0].cost;
+        stats.referenceCost = info[0].referenceCost;
+        for (const auto& subtree : findDegradedSubtrees(data.nodes, info, mOptions.rebuildCostThreshold))
+        {
+            stats.degradedSubtreeCount++;
+            stats.degradedTriangleCount += info[subtree.nodeIndex].triangleCount;
+        }
+        return stats;
+    }
+
+    LightBVHBuilder::QualityStats LightBVHBuilder::rebuildDegradedSubtrees(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& bvhData)
+    {
+        QualityStats stats;
+        if (bvhData.nodes.empty()) return stats;
+
+        const auto info = computeSubtreeInfo(bvhData.nodes, evalNodeCosts(bvhData.nodes, mOptions), bvhData.referenceCosts);
+        const auto subtrees = findDegradedSubtrees(bvhData.nodes, info, mOptions.rebuildCostThreshold);
+        stats.cost = info[0].cost;
+        stats.referenceCost = info[0].referenceCost;
+        stats.degradedSubtreeCount = (uint32_t)subtrees.size();
+        for (const auto& subtree : subtrees) stats.degradedTriangleCount += info[subtree.nodeIndex].triangleCount;
+
+        if (subtrees.empty()) return stats;
+
+        // Rebuild the subtrees in parallel. Each subtree is built into its own node array with node and triangle offsets relative to the subtree.
+        // The bitmasks are not tracked by the subtree builds, they are recomputed for the whole tree once the subtrees have been spliced.
+        struct SubtreeBuild
+        {
+            std::vector<PackedNode> nodes;
+            std::vector<uint32_t> triangleIndices;
+            std::exception_ptr pException;
+        };
+        std::vector<SubtreeBuild> builds(subtrees.size());
+        const SplitHeuristicFunction splitFunc = getSplitFunction(mOptions.splitHeuristicSelection);
+
+        auto range = NumericRange<size_t>(0, subtrees.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i)
+        {
+            try
+            {
+                const SubtreeInfo& subtree = info[subtrees[i].nodeIndex];
+                BuildingData data(builds[i].nodes);
+                data.trianglesData.reserve(subtree.triangleCount);
+                for (uint32_t j = subtree.triangleOffset; j < subtree.triangleOffset + subtree.triangleCount; j++)
+                {
+                    uint32_t triangleIndex = bvhData.triangleIndices[j];
+                    data.trianglesData.push_back(createTriangleSortData(triangles[triangleIndex], triangleIndex));
+                }
+                data.nodes.reserve(2 * subtree.triangleCount);
+                data.triangleIndices.reserve(subtree.triangleCount);
+
+                buildInternal(mOptions, splitFunc, 0ull, subtrees[i].depth, Range(0, subtree.triangleCount), data);
+                builds[i].triangleIndices = std::move(data.triangleIndices);
+            }
+            catch (...)
+            {
+                builds[i].pException = std::current_exception();
+            }
+        });
+        for (const auto& build : builds)
+        {
+            if (build.pException) std::rethrow_exception(build.pException);
+        }
+
+        // Splice the rebuilt subtrees into a new node array, keeping the depth-first order.
+        // The triangles of a subtree occupy the same range of the triangle index list before and after the rebuild.
+        const uint32_t kNoSubtree = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> subtreeIndices(bvhData.nodes.size(), kNoSubtree);
+        for (uint32_t i = 0; i < subtrees.size(); i++) subtreeIndices[subtrees[i].nodeIndex] = i;
+
+        std::vector<PackedNode> nodes;
+        std::vector<float> referenceCosts;
+        std::vector<bool> isRebuilt;
+        nodes.reserve(bvhData.nodes.size());
+        referenceCosts.reserve(bvhData.nodes.size());
+        isRebuilt.reserve(bvhData.nodes.size());
+
+        std::function<uint32_t(uint32_t)> spliceNode = [&](uint32_t oldIndex)
+        {
+            const uint32_t nodeIndex = (uint32_t)nodes.size();
+            const uint32_t subtreeIndex = subtreeIndices[oldIndex];
+            if (subtreeIndex != kNoSubtree)
+            {
+                SubtreeBuild& build = builds[subtreeIndex];
+                const uint32_t triangleOffset = info[oldIndex].triangleOffset;
+                for (PackedNode packed : build.nodes)
+                {
+                    if (packed.isLeaf())
+                    {
+                        LeafNode leaf = packed.getLeafNode();
+                        leaf.triangleOffset += triangleOffset;
+                        FALCOR_ASSERT(leaf.triangleOffset < kMaxLeafTriangleOffset);
+                        packed.setLeafNode(leaf);
+                    }
+                    else
+                    {
+                        InternalNode node = packed.getInternalNode();
+                        node.rightChildIdx += nodeIndex;
+                        packed.setInternalNode(node);
+                    }
+                    nodes.push_back(packed);
+                    referenceCosts.push_back(0.f);
+                    isRebuilt.push_back(true);
+                }
+                std::copy(build.triangleIndices.begin(), build.triangleIndices.end(), bvhData.triangleIndices.begin() + triangleOffset);
+            }
+            else
+            {
+                nodes.push_back(bvhData.nodes[oldIndex]);
+                referenceCosts.push_back(bvhData.referenceCosts[oldIndex]);
+                isRebuilt.push_back(false);
+                if (!bvhData.nodes[oldIndex].isLeaf())
+                {
+                    InternalNode node = bvhData.nodes[oldIndex].getInternalNode();
+                    const uint32_t leftIndex = spliceNode(oldIndex + 1);
+                    FALCOR_ASSERT(leftIndex == nodeIndex + 1);
+                    node.rightChildIdx = spliceNode(node.rightChildIdx);
+                    nodes[nodeIndex].setInternalNode(node);
+                }
+            }
+            return nodeIndex;
+        };
+        spliceNode(0);
+
+        bvhData.nodes = std::move(nodes);
+        bvhData.referenceCosts = std::move(referenceCosts);
+
+        // Update the bitmasks of all triangles to the new paths.
+        struct NodePath
+        {
+            uint32_t nodeIndex;
+            uint32_t depth;
+            uint64_t bitmask;
+        };
+        std::vector<NodePath> stack = { { 0, 0, 0ull } };
+        while (!stack.empty())
+        {
+            const NodePath path = stack.back();
+            stack.pop_back();
+            if (bvhData.nodes[path.nodeIndex].isLeaf())
+            {
+                const LeafNode leaf = bvhData.nodes[path.nodeIndex].getLeafNode();
+                for (uint32_t j = leaf.triangleOffset; j < leaf.triangleOffset + leaf.triangleCount; j++)
+                {
+                    bvhData.triangleBitmasks[bvhData.triangleIndices[j]] = path.bitmask;
+                }
+            }
+            else
+            {
+                FALCOR_ASSERT(path.depth < kMaxBVHDepth);
+                const uint32_t rightIndex = bvhData.nodes[path.nodeIndex].getInternalNode().rightChildIdx;
+                stack.push_back({ path.nodeIndex + 1, path.depth + 1, path.bitmask | (0ull << path.depth) });
+                stack.push_back({ rightIndex, path.depth + 1, path.bitmask | (1ull << path.depth) });
+            }
+        }
+
+        // Refit the whole tree so that the ancestors of the rebuilt subtrees bound the new subtree roots, including the lighting cones.
+        // The rebuilt nodes are not degraded, so their current cost becomes their reference cost.
+        refitData(triangles, bvhData);
+        const auto nodeCosts = evalNodeCosts(bvhData.nodes, mOptions);
+        for (size_t i = 0; i < bvhData.nodes.size(); i++)
+        {
+            if (isRebuilt[i]) bvhData.referenceCosts[i] = nodeCosts[i];
+        }
+
+        return stats;
+    }
+
+    namespace
+    {
+        /** Quantizes the attributes of a node relative to the decoded attributes of its parent.
+            The quantized values are rounded up, and then adjusted until the decoded attributes bound the input
+            to account for the rounding in the decoding.
+            \param[in] attribs Attributes of the node.
+            \param[in] parent Decoded attributes of the parent node.
+            \param[in,out] node The compact node to update.
+            \return The decoded attributes of the node.
+        */
+        SharedNodeAttributes encodeNodeAttributes(SharedNodeAttributes attribs, const SharedNodeAttributes& parent, CompactNode& node)
+        {
+            const uint32_t kMaxBounds = CompactNode::kMaxQuantizedBounds;
+            const uint32_t kMaxFlux = CompactNode::kMaxQuantizedFlux;
+
+            float3 aabbMin, aabbMax;
+            attribs.getAABB(aabbMin, aabbMax);
+            const float3 parentMin = parent.origin - parent.extent;
+            const float3 scale = parent.extent * (2.f / kMaxBounds);
+
+            uint3 quantizedMin = uint3(0), quantizedMax = uint3(0);
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                if (scale[k] <= 0.f) continue;
+                quantizedMin[k] = (uint32_t)std::clamp(std::floor((aabbMin[k] - parentMin[k]) / scale[k]), 0.f, (float)kMaxBounds);
+                quantizedMax[k] = (uint32_t)std::clamp(std::ceil((aabbMax[k] - parentMin[k]) / scale[k]), 0.f, (float)kMaxBounds);
+            }
+
+            // Widen the cone by the angle between the quantized and the exact cone direction.
+            uint32_t packedConeDirection = 0;
+            float cosConeAngle = kInvalidCosConeAngle;
+            if (attribs.cosConeAngle != kInvalidCosConeAngle)
+            {
+                packedConeDirection = encodeNormal2x8(attribs.coneDirection);
+                float angle = safeACos(attribs.cosConeAngle) + safeACos(dot(decodeNormal2x8(packedConeDirection), attribs.coneDirection));
+                if (angle < float(M_PI)) cosConeAngle = std::cos(angle);
+            }
+            uint32_t packedCosConeAngle = (uint32_t)((cosConeAngle + 1.f) * 32767.f);
+
+            uint32_t quantizedFlux = 0;
+            if (parent.flux > 0.f) quantizedFlux = (uint32_t)std::clamp(std::ceil(attribs.flux / parent.flux * kMaxFlux), 0.f, (float)kMaxFlux);
+
+            SharedNodeAttributes decoded;
+            for (bool adjusted = true; adjusted;)
+            {
+                node.setQuantizedAttributes(quantizedMin, quantizedMax, packedConeDirection, packedCosConeAngle, quantizedFlux);
+                decoded = node.getNodeAttributes(parent);
+                float3 decodedMin, decodedMax;
+                decoded.getAABB(decodedMin, decodedMax);
+
+                adjusted = false;
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    if (decodedMin[k] > aabbMin[k] && quantizedMin[k] > 0) { quantizedMin[k]--; adjusted = true; }
+                    if (decodedMax[k] < aabbMax[k] && quantizedMax[k] < kMaxBounds) { quantizedMax[k]++; adjusted = true; }
+                }
+                if (decoded.cosConeAngle > cosConeAngle && packedCosConeAngle > 0) { packedCosConeAngle--; adjusted = true; }
+                if (decoded.flux < attribs.flux && quantizedFlux < kMaxFlux) { quantizedFlux++; adjusted = true; }
+            }
+            return decoded;
+        }
+    }
+
+    LightBVHBuilder::CompactBVHData LightBVHBuilder::encodeCompactNodes(const std::vector<PackedNode>& nodes)
+    {
+        CompactBVHData data;
+        if (nodes.empty()) return data;
+        FALCOR_CHECK(nodes.size() < std::numeric_limits<uint32_t>::max(), "Too many BVH nodes ({}).", nodes.size());
+
+        data.rootAttribs = nodes[0].getNodeAttributes();
+        data.nodes.resize(nodes.size());
+
+        // The nodes are stored in depth-first order, so the parent of a node is encoded before the node itself.
+        std::vector<SharedNodeAttributes> decoded(nodes.size());
+        std::vector<uint32_t> parentIndices(nodes.size(), 0);
+        for (uint32_t nodeIndex = 0; nodeIndex < nodes.size(); nodeIndex++)
+        {
+            const SharedNodeAttributes& parent = nodeIndex == 0 ? data.rootAttribs : decoded[parentIndices[nodeIndex]];
+            CompactNode& node = data.nodes[nodeIndex];
+            if (nodes[nodeIndex].isLeaf())
+            {
+                const LeafNode leaf = nodes[nodeIndex].getLeafNode();
+                node.setLeafNode(leaf.triangleCount, leaf.triangleOffset);
+            }
+            else
+            {
+                const InternalNode internal = nodes[nodeIndex].getInternalNode();
+                node.setInternalNode(internal.rightChildIdx);
+                parentIndices[nodeIndex + 1] = nodeIndex;
+                parentIndices[internal.rightChildIdx] = nodeIndex;
+            }
+            decoded[nodeIndex] = encodeNodeAttributes(nodes[nodeIndex].getNodeAttributes(), parent, node);
+        }
+
+        return data;
+    }
+
+    std::vector<SharedNodeAttributes> LightBVHBuilder::decodeCompactNodes(const CompactBVHData& data)
+    {
+        std::vector<SharedNodeAttributes> attribs(data.nodes.size());
+        std::vector<uint32_t> parentIndices(data.nodes.size(), 0);
+        for (uint32_t nodeIndex = 0; nodeIndex < data.nodes.size(); nodeIndex++)
+        {
+            const SharedNodeAttributes& parent = nodeIndex == 0 ? data.rootAttribs : attribs[parentIndices[nodeIndex]];
+            const CompactNode& node = data.nodes[nodeIndex];
+            if (node.isLeaf())
+            {
+                attribs[nodeIndex] = node.getLeafNode(parent).attribs;
+            }
+            else
+            {
+                const InternalNode internal = node.getInternalNode(parent);
+                attribs[nodeIndex] = internal.attribs;
+                parentIndices[nodeIndex + 1] = nodeIndex;
+                parentIndices[internal.rightChildIdx] = nodeIndex;
+            }
+        }
+        return attribs;
+    }
 }
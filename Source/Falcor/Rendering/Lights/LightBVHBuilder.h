@@ -76,8 +76,11 @@ namespace Falcor
             bool           useLeafCreationCost = true;                           ///< Set to true to avoid splitting when the cost is higher than the cost of creating a leaf node. Only used when 'createLeavesASAP' is disabled.
             bool           createLeavesASAP = true;                              ///< Rather than creating a leaf only once splitting stops, create it as soon as we can.
             bool           allowRefitting = true;                                ///< Rather than always rebuilding the BVH from scratch, keep the hierarchy but update the bounds and lighting cones.
+            bool           allowPartialRebuild = false;                          ///< When refitting, also rebuild the subtrees whose cost has degraded. The refit is then done on the CPU. Only used when 'allowRefitting' is enabled.
+            float          rebuildCostThreshold = 1.5f;                          ///< Rebuild subtrees whose cost grew by more than this factor since they were built. Only used when 'allowPartialRebuild' is enabled.
             bool           usePreintegration = true;                             ///< Use pre-integration for culling out emissive triangles and use their flux when computing the splits. Only valid when using the BinnedSAOH split heuristic.
             bool           useLightingCones = true;                              ///< Use lighting cones when computing the splits. Only valid when using the BinnedSAOH split heuristic.
+            bool           useCompactNodes = false;                              ///< Store the nodes in the compact 16B format on the GPU (see CompactNode). The nodes are encoded on the CPU, so the BVH is refitted on the CPU as well.
 
             template<typename Archive>
             void serialize(Archive& ar)
@@ -91,11 +94,49 @@ namespace Falcor
                 ar("useLeafCreationCost", useLeafCreationCost);
                 ar("createLeavesASAP", createLeavesASAP);
                 ar("allowRefitting", allowRefitting);
+                ar("allowPartialRebuild", allowPartialRebuild);
+                ar("rebuildCostThreshold", rebuildCostThreshold);
                 ar("usePreintegration", usePreintegration);
                 ar("useLightingCones", useLightingCones);
+                ar("useCompactNodes", useCompactNodes);
             }
         };
 
+        /** CPU-side BVH data. This is what the builder produces and LightBVH uploads to the GPU.
+        */
+        struct BVHData
+        {
+            std::vector<PackedNode> nodes;          ///< BVH nodes in depth-first order.
+            std::vector<uint32_t> triangleIndices;  ///< Triangle indices sorted by leaf node.
+            std::vector<uint64_t> triangleBitmasks; ///< Per triangle bit pattern retracing the tree traversal to reach the triangle. Indexed by global triangle index.
+            std::vector<float> referenceCosts;      ///< Per node cost at the time the node was built. Used for tracking the degradation of refitted nodes.
+        };
+
+        /** BVH nodes in the compact node format, see CompactNode.
+            This halves the node memory compared to PackedNode. The triangle indices and bitmasks are the same as in BVHData.
+        */
+        struct CompactBVHData
+        {
+            SharedNodeAttributes rootAttribs;       ///< Full precision attributes of the root node. The root node is quantized relative to these.
+            std::vector<CompactNode> nodes;         ///< BVH nodes in the same depth-first order as BVHData::nodes.
+        };
+
+        /** BVH quality according to the split heuristic.
+            The cost of a subtree is the sum of the SAH (or SAOH) costs of its nodes. Refitting grows the nodes of
+            animated geometry and increases the cost, which is compared to the cost when the nodes were built.
+        */
+        struct QualityStats
+        {
+            float cost = 0.f;                   ///< Current cost of the BVH.
+            float referenceCost = 0.f;          ///< Cost of the BVH when its nodes were built.
+            uint32_t degradedSubtreeCount = 0;  ///< Number of subtrees whose cost grew by more than Options::rebuildCostThreshold.
+            uint32_t degradedTriangleCount = 0; ///< Number of triangles in the degraded subtrees.
+
+            /** Returns the current cost relative to the build-time cost. Values above one indicate degradation.
+            */
+            float getCostRatio() const { return referenceCost > 0.f ? cost / referenceCost : 1.f; }
+        };
+
         /** Constructor.
             \param[in] options The options to use for building the BVH.
         */
@@ -106,6 +147,55 @@ namespace Falcor
         */
         void build(RenderContext* pRenderContext, LightBVH& bvh);
 
+        /** Update the BVH after the emissive geometry has moved.
+            The BVH is refitted on the CPU. If Options::allowPartialRebuild is enabled, the degraded subtrees are rebuilt, see rebuildDegradedSubtrees().
+            The BVH needs to have been built before trying to update it.
+            \param[in,out] bvh The light BVH to update.
+            \return The quality of the refitted BVH, before the degraded subtrees were rebuilt.
+        */
+        QualityStats update(RenderContext* pRenderContext, LightBVH& bvh);
+
+        /** Build the BVH data on the CPU. This is the device-independent part of build().
+            \param[in] triangles Emissive triangles.
+            \param[out] data The BVH data. The nodes are empty if no triangles are included in the BVH.
+        */
+        void buildData(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& data);
+
+        /** Refit the BVH data to the triangles on the CPU, without changing the hierarchy.
+            \param[in] triangles Emissive triangles. These must be the triangles the BVH was built from, possibly moved.
+            \param[in,out] data The BVH data.
+        */
+        void refitData(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& data);
+
+        /** Evaluate the quality of refitted BVH data.
+            \param[in] data The BVH data.
+            \return The quality stats.
+        */
+        QualityStats evalQuality(const BVHData& data) const;
+
+        /** Rebuild the degraded subtrees of refitted BVH data.
+            The topmost subtrees whose cost grew by more than Options::rebuildCostThreshold are rebuilt in parallel
+            from their triangles and spliced back into the node array. The triangle bitmasks are updated accordingly.
+            \param[in] triangles Emissive triangles, the same as passed to refitData().
+            \param[in,out] data The refitted BVH data.
+            \return The quality of the BVH before the rebuild.
+        */
+        QualityStats rebuildDegradedSubtrees(const std::vector<LightCollection::MeshLightTriangle>& triangles, BVHData& data);
+
+        /** Encode BVH nodes in the compact node format.
+            Each node is quantized relative to the decoded attributes of its parent, so the error doesn't accumulate beyond
+            the rounding to the parent's grid. The decoded bounds, flux and cone angle are equal or larger than the input.
+            \param[in] nodes BVH nodes in depth-first order.
+            \return The compact nodes.
+        */
+        static CompactBVHData encodeCompactNodes(const std::vector<PackedNode>& nodes);
+
+        /** Decode the attributes of all nodes in the compact node format.
+            \param[in] data The compact nodes.
+            \return The decoded attributes per node.
+        */
+        static std::vector<SharedNodeAttributes> decodeCompactNodes(const CompactBVHData& data);
+
         bool renderUI(Gui::Widgets& widget);
 
         const Options& getOptions() const { return mOptions; }
@@ -136,19 +226,67 @@ namespace Falcor
         struct TriangleSortData
         {
             AABB bounds;                                    ///< World-space bounding box for the light source(s).
-            float3 center = {};                             ///< Center point.
             float3 coneDirection = {};                      ///< Light emission normal direction.
             float cosConeAngle = 1.f;                       ///< Cosine normal bounding cone (half) angle.
             float flux = 0.f;                               ///< Precomputed triangle flux (note, this takes doublesidedness into account).
             uint32_t triangleIndex = MeshLightData::kInvalidIndex; ///< Index into global triangle list.
         };
 
+        /** List of triangles to include in the build, stored in SoA layout.
+            The triangle data is written once and stays in place. The build partitions the list of 32-bit indices
+            into the triangle data instead, and operator[] gathers the data of a triangle at a given position.
+            The cone angle is not stored as it is zero for all triangles.
+        */
+        struct TriangleSortDataList
+        {
+            std::vector<float3> boundsMin;                  ///< World-space bounding box min corners.
+            std::vector<float3> boundsMax;                  ///< World-space bounding box max corners.
+            std::vector<float3> coneDirection;              ///< Light emission normal directions.
+            std::vector<float> flux;                        ///< Precomputed triangle fluxes.
+            std::vector<uint32_t> triangleIndex;            ///< Indices into global triangle list.
+            std::vector<uint32_t> order;                    ///< Indices into the triangle data, partitioned by the build.
+
+            size_t size() const { return order.size(); }
+            bool empty() const { return order.empty(); }
+
+            void reserve(size_t count)
+            {
+                boundsMin.reserve(count);
+                boundsMax.reserve(count);
+                coneDirection.reserve(count);
+                flux.reserve(count);
+                triangleIndex.reserve(count);
+                order.reserve(count);
+            }
+
+            void push_back(const TriangleSortData& tri)
+            {
+                order.push_back(static_cast<uint32_t>(order.size()));
+                boundsMin.push_back(tri.bounds.minPoint);
+                boundsMax.push_back(tri.bounds.maxPoint);
+                coneDirection.push_back(tri.coneDirection);
+                flux.push_back(tri.flux);
+                triangleIndex.push_back(tri.triangleIndex);
+            }
+
+            TriangleSortData operator[](size_t position) const
+            {
+                const uint32_t i = order[position];
+                TriangleSortData tri;
+                tri.bounds = AABB(boundsMin[i], boundsMax[i]);
+                tri.coneDirection = coneDirection[i];
+                tri.flux = flux[i];
+                tri.triangleIndex = triangleIndex[i];
+                return tri;
+            }
+        };
+
         struct BuildingData
         {
             std::vector<PackedNode>& nodes;                 ///< BVH nodes generated by the builder.
-            std::vector<TriangleSortData> trianglesData;    ///< Compact list of triangles to include in build.
+            TriangleSortDataList trianglesData;             ///< Compact list of triangles to include in build.
             std::vector<uint32_t> triangleIndices;          ///< Triangle indices sorted by leaf node. Each leaf node refers to a contiguous array of triangle indices.
-            std::vector<uint64_t> triangleBitmasks;         ///< Array containing the per triangle bit pattern retracing the tree traversal to reach the triangle: 0=left child, 1=right child; this array gets filled in during the build process. Indexed by global triangle index.
+            std::vector<uint64_t> triangleBitmasks;         ///< Array containing the per triangle bit pattern retracing the tree traversal to reach the triangle: 0=left child, 1=right child; this array gets filled in during the build process, unless it is empty. Indexed by global triangle index.
             float currentNodeFlux = 0.f;                    ///< Used by computeSAOHSplit() as the leaf creation cost.
 
             BuildingData(std::vector<PackedNode>& bvhNodes) : nodes(bvhNodes) {}
@@ -176,6 +314,13 @@ namespace Falcor
         */
         uint32_t buildInternal(const Options& options, const SplitHeuristicFunction& splitHeuristic, uint64_t bitmask, uint32_t depth, const Range& triangleRange, BuildingData& data);
 
+        /** Recursive refit of the bounds and flux of all nodes. The lighting cones are only updated for leaf nodes.
+            \param[in] nodeIndex Index of the current node.
+            \param[in,out] data Prepared light data, sorted in the same order as the triangle indices of the leaf nodes.
+            \return Bounds of the current node.
+        */
+        AABB refitInternal(const uint32_t nodeIndex, BuildingData& data);
+
         /** Recursive computation of lighting cones for all internal nodes.
             \param[in] nodeIndex Index of the current node.
             \param[in,out] data Updated node data.
@@ -199,6 +344,8 @@ namespace Falcor
 
         static SplitHeuristicFunction getSplitFunction(SplitHeuristic heuristic);
 
+        static TriangleSortData createTriangleSortData(const LightCollection::MeshLightTriangle& triangle, uint32_t triangleIndex);
+
         // Configuration
         Options mOptions;
     };
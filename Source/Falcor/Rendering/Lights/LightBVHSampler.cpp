@@ -56,7 +56,9 @@ namespace Falcor
         }
         else if (needsRefit)
         {
-            mpBVH->refit(pRenderContext);
+            // Compact nodes are encoded on the CPU, so they are refitted on the CPU as well.
+            if (mOptions.buildOptions.allowPartialRebuild || mpBVH->usesCompactNodes()) mpBVHBuilder->update(pRenderContext, *mpBVH);
+            else mpBVH->refit(pRenderContext);
             samplerChanged = true;
         }
 
@@ -76,6 +78,9 @@ namespace Falcor
         defines.add("_ACTUAL_MAX_TRIANGLES_PER_NODE", std::to_string(mOptions.buildOptions.maxTriangleCountPerLeaf));
         defines.add("_SOLID_ANGLE_BOUND_METHOD", std::to_string((uint32_t)mOptions.solidAngleBoundMethod));
 
+        // The node format changes the program vars. It is taken from the BVH, which is only updated on rebuild.
+        defines.add("_USE_COMPACT_BVH_NODES", mpBVH->usesCompactNodes() ? "1" : "0");
+
         return defines;
     }
 
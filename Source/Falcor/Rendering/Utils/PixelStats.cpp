@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "PixelStats.h"
+#include "Core/API/Device.h"
 #include "Core/API/RenderContext.h"
 #include "Utils/Logger.h"
 #include "Utils/Scripting/ScriptBindings.h"
@@ -62,17 +63,19 @@ namespace Falcor
         mpComputeRayCount = ComputePass::create(mpDevice, kComputeRayCountFilename, "main");
     }
 
+    PixelStats::~PixelStats()
+    {
+        mpDevice->getReadbackService()->cancel(this);
+    }
+
     void PixelStats::beginFrame(RenderContext* pRenderContext, const uint2& frameDim)
     {
         // Prepare state.
         FALCOR_ASSERT(!mRunning);
         mRunning = true;
-        mWaitingForData = false;
         mFrameDim = frameDim;
 
-        // Mark previously stored data as invalid. The config may have changed, so this is the safe bet.
-        mStats = Stats();
-        mStatsValid = false;
+        // Mark previously stored per-pixel data as invalid. The stats are kept while enabled, they are updated when new data is read back.
         mStatsBuffersValid = false;
         mRayCountTextureValid = false;
 
@@ -82,7 +85,7 @@ namespace Falcor
             if (!mpParallelReduction)
             {
                 mpParallelReduction = std::make_unique<ParallelReduction>(mpDevice);
-                mpReductionResult = mpDevice->createBuffer((kRayTypeCount + 3) * sizeof(uint4), ResourceBindFlags::None, MemoryType::ReadBack);
+                mpReductionResult = mpDevice->createBuffer((kRayTypeCount + 3) * sizeof(uint4), ResourceBindFlags::None, MemoryType::DeviceLocal);
             }
 
             // Prepare stats buffers.
@@ -105,6 +108,14 @@ namespace Falcor
             pRenderContext->clearUAV(mpStatsPathVertexCount->getUAV().get(), uint4(0, 0, 0, 0));
             pRenderContext->clearUAV(mpStatsVolumeLookupCount->getUAV().get(), uint4(0, 0, 0, 0));
         }
+        else
+        {
+            // Drop stats from pending readbacks.
+            mpDevice->getReadbackService()->cancel(this);
+            mReadbackTicket = ReadbackService::kInvalidTicket;
+            mStats = Stats();
+            mStatsValid = false;
+        }
     }
 
     void PixelStats::endFrame(RenderContext* pRenderContext)
@@ -114,9 +125,6 @@ namespace Falcor
 
         if (mEnabled)
         {
-            // Create fence first time we need it.
-            if (!mpFence) mpFence = mpDevice->createFence();
-
             // Sum of the per-pixel counters. The results are copied to a GPU buffer.
             for (uint32_t i = 0; i < kRayTypeCount; i++)
             {
@@ -126,12 +134,13 @@ namespace Falcor
             mpParallelReduction->execute<uint4>(pRenderContext, mpStatsPathVertexCount, ParallelReduction::Type::Sum, nullptr, mpReductionResult, (kRayTypeCount + 1) * sizeof(uint4));
             mpParallelReduction->execute<uint4>(pRenderContext, mpStatsVolumeLookupCount, ParallelReduction::Type::Sum, nullptr, mpReductionResult, (kRayTypeCount + 2) * sizeof(uint4));
 
-            // Submit command list and insert signal.
-            pRenderContext->submit(false);
-            pRenderContext->signal(mpFence.get());
+            // Read back the results asynchronously.
+            const uint32_t numPixels = mFrameDim.x * mFrameDim.y;
+            mReadbackTicket = mpDevice->getReadbackService()->readBuffer(
+                pRenderContext, mpReductionResult.get(), 0, 0,
+                [this, numPixels](const void* pData, size_t size) { readStats(static_cast<const uint4*>(pData), numPixels); }, this);
 
             mStatsBuffersValid = true;
-            mWaitingForData = true;
         }
     }
 
@@ -162,8 +171,7 @@ namespace Falcor
         widget.checkbox("Ray stats", mEnabled);
         widget.tooltip("Collects ray tracing traversal stats on the GPU.\nNote that this option slows down the performance.");
 
-        // Fetch data and show stats if available.
-        copyStatsToCPU();
+        // Show the latest stats if available.
         if (mStatsValid)
         {
             widget.text("Stats:");
@@ -198,7 +206,8 @@ namespace Falcor
 
     bool PixelStats::getStats(PixelStats::Stats& stats)
     {
-        copyStatsToCPU();
+        FALCOR_ASSERT(!mRunning);
+        mpDevice->getReadbackService()->wait(mReadbackTicket);
         if (!mStatsValid)
         {
             logWarning("PixelStats::getStats() - Stats are not valid. Ignoring.");
@@ -260,43 +269,28 @@ namespace Falcor
         return mStatsBuffersValid ? mpStatsVolumeLookupCount : nullptr;
     }
 
-    void PixelStats::copyStatsToCPU()
+    void PixelStats::readStats(const uint4* result, uint32_t numPixels)
     {
-        FALCOR_ASSERT(!mRunning);
-        if (mWaitingForData)
-        {
-            // Wait for signal.
-            mpFence->wait();
-            mWaitingForData = false;
-
-            if (mEnabled)
-            {
-                // Map the stats buffer.
-                const uint4* result = static_cast<const uint4*>(mpReductionResult->map());
-                FALCOR_ASSERT(result);
-
-                const uint32_t totalPathLength = result[kRayTypeCount].x;
-                const uint32_t totalPathVertices = result[kRayTypeCount + 1].x;
-                const uint32_t totalVolumeLookups = result[kRayTypeCount + 2].x;
-                const uint32_t numPixels = mFrameDim.x * mFrameDim.y;
-                FALCOR_ASSERT(numPixels > 0);
-
-                mStats.visibilityRays = result[(uint32_t)PixelStatsRayType::Visibility].x;
-                mStats.closestHitRays = result[(uint32_t)PixelStatsRayType::ClosestHit].x;
-                mStats.totalRays = mStats.visibilityRays + mStats.closestHitRays;
-                mStats.pathVertices = totalPathVertices;
-                mStats.volumeLookups = totalVolumeLookups;
-                mStats.avgVisibilityRays = (float)mStats.visibilityRays / numPixels;
-                mStats.avgClosestHitRays = (float)mStats.closestHitRays / numPixels;
-                mStats.avgTotalRays = (float)mStats.totalRays / numPixels;
-                mStats.avgPathLength = (float)totalPathLength / numPixels;
-                mStats.avgPathVertices = (float)totalPathVertices / numPixels;
-                mStats.avgVolumeLookups = (float)totalVolumeLookups / numPixels;
-
-                mpReductionResult->unmap();
-                mStatsValid = true;
-            }
-        }
+        FALCOR_ASSERT(result);
+
+        const uint32_t totalPathLength = result[kRayTypeCount].x;
+        const uint32_t totalPathVertices = result[kRayTypeCount + 1].x;
+        const uint32_t totalVolumeLookups = result[kRayTypeCount + 2].x;
+        FALCOR_ASSERT(numPixels > 0);
+
+        mStats.visibilityRays = result[(uint32_t)PixelStatsRayType::Visibility].x;
+        mStats.closestHitRays = result[(uint32_t)PixelStatsRayType::ClosestHit].x;
+        mStats.totalRays = mStats.visibilityRays + mStats.closestHitRays;
+        mStats.pathVertices = totalPathVertices;
+        mStats.volumeLookups = totalVolumeLookups;
+        mStats.avgVisibilityRays = (float)mStats.visibilityRays / numPixels;
+        mStats.avgClosestHitRays = (float)mStats.closestHitRays / numPixels;
+        mStats.avgTotalRays = (float)mStats.totalRays / numPixels;
+        mStats.avgPathLength = (float)totalPathLength / numPixels;
+        mStats.avgPathVertices = (float)totalPathVertices / numPixels;
+        mStats.avgVolumeLookups = (float)totalVolumeLookups / numPixels;
+
+        mStatsValid = true;
     }
 
     FALCOR_SCRIPT_BINDING(PixelStats)
@@ -30,7 +30,7 @@
 #include "Core/Macros.h"
 #include "Core/API/Buffer.h"
 #include "Core/API/Texture.h"
-#include "Core/API/Fence.h"
+#include "Core/API/ReadbackService.h"
 #include "Core/Pass/ComputePass.h"
 #include "Utils/UI/Gui.h"
 #include "Utils/Algorithm/ParallelReduction.h"
@@ -43,6 +43,7 @@ namespace Falcor
         Per-pixel stats are logged in buffers on the GPU, which are immediately ready for consumption
         after end() is called. These stats are summarized in a reduction pass, which are
         available in getStats() or printStats() after async readback to the CPU.
+        The UI shows the latest stats that have been read back, which may lag a few frames behind.
     */
     class FALCOR_API PixelStats
     {
@@ -63,6 +64,7 @@ namespace Falcor
         };
 
         PixelStats(ref<Device> pDevice);
+        ~PixelStats();
 
         void setEnabled(bool enabled) { mEnabled = enabled; }
         bool isEnabled() const { return mEnabled; }
@@ -78,6 +80,7 @@ namespace Falcor
         void renderUI(Gui::Widgets& widget);
 
         /** Fetches the latest stats generated by begin()/end().
+            This waits for the readback of the stats if it has not completed yet.
             \param[out] stats The stats are copied here.
             \return True if stats are available, false otherwise.
         */
@@ -105,7 +108,7 @@ namespace Falcor
         const ref<Texture> getVolumeLookupCountTexture() const;
 
     protected:
-        void copyStatsToCPU();
+        void readStats(const uint4* result, uint32_t numPixels);
         void computeRayCountTexture(RenderContext* pRenderContext);
 
         static const uint32_t kRayTypeCount = (uint32_t)PixelStatsRayType::Count;
@@ -114,8 +117,8 @@ namespace Falcor
 
         // Internal state
         std::unique_ptr<ParallelReduction>  mpParallelReduction;            ///< Helper for parallel reduction on the GPU.
-        ref<Buffer>                         mpReductionResult;              ///< Results buffer for stats readback (CPU mappable).
-        ref<Fence>                          mpFence;                        ///< GPU fence for sychronizing readback.
+        ref<Buffer>                         mpReductionResult;              ///< Results buffer for stats readback.
+        ReadbackService::Ticket             mReadbackTicket = ReadbackService::kInvalidTicket; ///< Ticket of the last stats readback.
 
         // Configuration
         bool                                mEnabled = false;               ///< Enable pixel statistics.
@@ -123,7 +126,6 @@ namespace Falcor
 
         // Runtime data
         bool                                mRunning = false;               ///< True inbetween begin() / end() calls.
-        bool                                mWaitingForData = false;        ///< True if we are waiting for data to become available on the GPU.
         uint2                               mFrameDim = { 0, 0 };           ///< Frame dimensions at last call to begin().
 
         bool                                mStatsValid = false;            ///< True if stats have been read back and are valid.
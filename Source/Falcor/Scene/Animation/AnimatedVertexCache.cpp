@@ -29,7 +29,9 @@
 #include "Animation.h"
 #include "Core/API/RenderContext.h"
 #include "Scene/Scene.h"
+#include "Utils/NumericRange.h"
 #include "Utils/Timing/Profiler.h"
+#include <execution>
 
 namespace Falcor
 {
@@ -39,6 +41,11 @@ namespace Falcor
         const std::string kUpdateCurveAABBsFilename = "Scene/Animation/UpdateCurveAABBs.slang";
         const std::string kUpdateCurvePolyTubeVerticesFilename = "Scene/Animation/UpdateCurvePolyTubeVertices.slang";
 
+        // Number of keyframes per mesh that are resident on the GPU. Two are needed for interpolation,
+        // the remaining slots avoid re-uploading keyframes when scrubbing back and forth.
+        const uint32_t kMeshKeyframeWindowSize = 4;
+        const uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
         InterpolationInfo calculateInterpolation(double time, const std::vector<double>& timeSamples, Animation::Behavior preInfinityBehavior, Animation::Behavior postInfinityBehavior)
         {
             if (!std::isfinite(time))
@@ -100,8 +107,8 @@ namespace Falcor
         : mpDevice(pDevice)
         , mpScene(pScene)
         , mpPrevVertexData(pPrevVertexData)
-        , mCachedCurves(cachedCurves)
-        , mCachedMeshes(cachedMeshes)
+        , mCachedCurves(std::move(cachedCurves))
+        , mCachedMeshes(std::move(cachedMeshes))
     {
         if (mCachedCurves.empty() && mCachedMeshes.empty()) return;
 
@@ -191,6 +198,7 @@ namespace Falcor
         m += mpPrevCurveVertexBuffer ? mpPrevCurveVertexBuffer->getSize() : 0;
         m += mpCurveIndexBuffer ? mpCurveIndexBuffer->getSize() : 0;
         for (size_t i = 0; i < mpMeshVertexBuffers.size(); i++) m += mpMeshVertexBuffers[i] ? mpMeshVertexBuffers[i]->getSize() : 0;
+        for (const auto& store : mMeshKeyframeStores) m += store.getMemoryUsageInBytes();
         m += mpMeshInterpolationBuffer ? mpMeshInterpolationBuffer->getSize() : 0;
         m += mpMeshMetadataBuffer ? mpMeshMetadataBuffer->getSize() : 0;
         return m;
@@ -427,11 +435,36 @@ namespace Falcor
 
     void AnimatedVertexCache::initMeshKeyframes()
     {
-        for (const auto& cache : mCachedMeshes)
+        mMeshKeyframeStores.resize(mCachedMeshes.size());
+        mMeshKeyframeWindows.resize(mCachedMeshes.size());
+
+        // Encode the keyframes of all meshes in parallel and release the original data.
+        auto range = NumericRange<size_t>(0, mCachedMeshes.size());
+        std::for_each(
+            std::execution::par,
+            range.begin(),
+            range.end(),
+            [&](size_t i)
+            {
+                auto& cache = mCachedMeshes[i];
+                mMeshKeyframeStores[i] = VertexCacheKeyframeStore(cache.vertexData, cache.keyframeEncoding);
+                cache.vertexData = {};
+            }
+        );
+
+        for (size_t i = 0; i < mCachedMeshes.size(); i++)
         {
+            const auto& cache = mCachedMeshes[i];
+            const auto& store = mMeshKeyframeStores[i];
             mGlobalMeshAnimationLength = std::max(mGlobalMeshAnimationLength, cache.timeSamples.back());
-            mMeshKeyframeCount += (uint32_t)cache.timeSamples.size();
-            mMaxMeshVertexCount = std::max((uint32_t)cache.vertexData.front().size(), mMaxMeshVertexCount);
+            mMaxMeshVertexCount = std::max(store.getVertexCount(), mMaxMeshVertexCount);
+
+            // Only a window of keyframes around the current time is resident on the GPU.
+            auto& window = mMeshKeyframeWindows[i];
+            window.slotOffset = mMeshKeyframeCount;
+            window.slotKeyframes.assign(std::min(store.getKeyframeCount(), kMeshKeyframeWindowSize), kInvalidIndex);
+            window.slotLastUse.assign(window.slotKeyframes.size(), 0);
+            mMeshKeyframeCount += (uint32_t)window.slotKeyframes.size();
         }
     }
 
@@ -441,28 +474,27 @@ namespace Falcor
         std::vector<PerMeshMetadata> meshMetadata;
         meshMetadata.reserve(mCachedMeshes.size());
 
-        uint32_t keyframeOffset = 0;
-        for (auto& cache : mCachedMeshes)
+        for (size_t i = 0; i < mCachedMeshes.size(); i++)
         {
-            FALCOR_ASSERT(cache.vertexData.front().size() == mpScene->getMesh(cache.meshID).vertexCount);
+            const auto& cache = mCachedMeshes[i];
+            const auto& store = mMeshKeyframeStores[i];
+            const auto& window = mMeshKeyframeWindows[i];
+            FALCOR_ASSERT(store.getVertexCount() == mpScene->getMesh(cache.meshID).vertexCount);
 
             PerMeshMetadata meta;
-            meta.keyframeBufferOffset = keyframeOffset;
-            meta.vertexCount = (uint32_t)cache.vertexData.front().size();
+            meta.keyframeBufferOffset = window.slotOffset;
+            meta.vertexCount = store.getVertexCount();
             meta.sceneVbOffset = mpScene->getMesh(cache.meshID).vbOffset;
             meta.prevVbOffset = mpScene->getMesh(cache.meshID).prevVbOffset;
             meshMetadata.push_back(meta);
 
-            // Create vertex buffer for each keyframe on this mesh
-            for (size_t i = 0; i < cache.vertexData.size(); i++)
+            // Create a vertex buffer for each keyframe slot on this mesh. Keyframes are uploaded on demand.
+            for (size_t j = 0; j < window.slotKeyframes.size(); j++)
             {
-                auto& data = cache.vertexData[i];
-                size_t index = keyframeOffset + i;
-                mpMeshVertexBuffers[index] = mpDevice->createStructuredBuffer(sizeof(PackedStaticVertexData), (uint32_t)data.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, data.data(), false);
+                size_t index = window.slotOffset + j;
+                mpMeshVertexBuffers[index] = mpDevice->createStructuredBuffer(sizeof(PackedStaticVertexData), store.getVertexCount(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
                 mpMeshVertexBuffers[index]->setName("AnimatedVertexCache::mpMeshVertexBuffers[" + std::to_string(index) + "]");
             }
-
-            keyframeOffset += (uint32_t)cache.timeSamples.size();
         }
 
         mpMeshMetadataBuffer = mpDevice->createStructuredBuffer(sizeof(PerMeshMetadata), (uint32_t)meshMetadata.size(), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, meshMetadata.data(), false);
@@ -473,6 +505,60 @@ namespace Falcor
         mpMeshInterpolationBuffer->setName("AnimatedVertexCache::mpMeshInterpolationbuffer");
     }
 
+    uint2 AnimatedVertexCache::makeMeshKeyframesResident(size_t meshIndex, uint2 keyframes)
+    {
+        const auto& store = mMeshKeyframeStores[meshIndex];
+        auto& window = mMeshKeyframeWindows[meshIndex];
+        const uint32_t slotCount = (uint32_t)window.slotKeyframes.size();
+
+        auto findSlot = [&](uint32_t keyframe)
+        {
+            for (uint32_t s = 0; s < slotCount; s++) if (window.slotKeyframes[s] == keyframe) return s;
+            return kInvalidIndex;
+        };
+
+        uint2 slots(findSlot(keyframes.x), findSlot(keyframes.y));
+        for (uint32_t s : { slots.x, slots.y }) if (s != kInvalidIndex) window.slotLastUse[s] = mMeshUpdateCount;
+
+        // Evict the least recently used slots for the missing keyframes.
+        auto allocateSlot = [&](uint32_t keyframe)
+        {
+            uint32_t slot = 0;
+            for (uint32_t s = 1; s < slotCount; s++) if (window.slotLastUse[s] < window.slotLastUse[slot]) slot = s;
+            FALCOR_ASSERT(window.slotLastUse[slot] != mMeshUpdateCount || window.slotKeyframes[slot] == kInvalidIndex);
+            window.slotKeyframes[slot] = keyframe;
+            window.slotLastUse[slot] = mMeshUpdateCount;
+            return slot;
+        };
+
+        bool missingX = slots.x == kInvalidIndex;
+        bool missingY = slots.y == kInvalidIndex && keyframes.y != keyframes.x;
+        if (missingX) slots.x = allocateSlot(keyframes.x);
+        if (missingY) slots.y = allocateSlot(keyframes.y);
+        if (keyframes.y == keyframes.x) slots.y = slots.x;
+
+        // Decode the missing keyframes and upload them. Both bracketing keyframes are decoded in a single pass if needed.
+        auto upload = [&](uint32_t slot, const std::vector<PackedStaticVertexData>& data)
+        {
+            mpMeshVertexBuffers[window.slotOffset + slot]->setBlob(data.data(), 0, store.getVertexCount() * sizeof(PackedStaticVertexData));
+        };
+
+        for (auto& staging : mMeshStagingVertices) staging.resize(store.getVertexCount());
+        if (missingX && missingY)
+        {
+            store.decodeKeyframes(keyframes, mMeshStagingVertices[0], mMeshStagingVertices[1]);
+            upload(slots.x, mMeshStagingVertices[0]);
+            upload(slots.y, mMeshStagingVertices[1]);
+        }
+        else if (missingX || missingY)
+        {
+            store.decodeKeyframe(missingX ? keyframes.x : keyframes.y, mMeshStagingVertices[0]);
+            upload(missingX ? slots.x : slots.y, mMeshStagingVertices[0]);
+        }
+
+        return slots;
+    }
+
     void AnimatedVertexCache::createMeshVertexUpdatePass()
     {
         FALCOR_ASSERT(!mCachedMeshes.empty());
@@ -541,14 +627,21 @@ namespace Falcor
 
         FALCOR_PROFILE(pRenderContext, "update mesh vertices");
 
-        // Update interpolation
-        for (size_t i = 0; i < mMeshInterpolationInfo.size(); i++)
+        // Update interpolation. The keyframe indices passed to the shader refer to the resident keyframe slots of each mesh.
+        // When copying to the previous vertices the keyframes are not accessed.
+        if (!copyPrev)
         {
-            auto postInfinityBehavior = mLoopAnimations ? Animation::Behavior::Cycle : Animation::Behavior::Constant;
-            mMeshInterpolationInfo[i] = calculateInterpolation(t, mCachedMeshes[i].timeSamples, mPreInfinityBehavior, postInfinityBehavior);
-        }
+            mMeshUpdateCount++;
+            for (size_t i = 0; i < mMeshInterpolationInfo.size(); i++)
+            {
+                auto postInfinityBehavior = mLoopAnimations ? Animation::Behavior::Cycle : Animation::Behavior::Constant;
+                InterpolationInfo info = calculateInterpolation(t, mCachedMeshes[i].timeSamples, mPreInfinityBehavior, postInfinityBehavior);
+                info.keyframeIndices = makeMeshKeyframesResident(i, info.keyframeIndices);
+                mMeshInterpolationInfo[i] = info;
+            }
 
-        mpMeshInterpolationBuffer->setBlob(mMeshInterpolationInfo.data(), 0, mpMeshInterpolationBuffer->getSize());
+            mpMeshInterpolationBuffer->setBlob(mMeshInterpolationInfo.data(), 0, mpMeshInterpolationBuffer->getSize());
+        }
 
         auto block = mpMeshVertexUpdatePass->getRootVar()["gMeshVertexUpdater"];
         block["sceneVertexData"] = mpScene->getMeshVao()->getVertexBuffer(Scene::kStaticDataBufferIndex);
@@ -28,6 +28,7 @@
 #pragma once
 #include "Animation.h"
 #include "SharedTypes.slang"
+#include "VertexCacheKeyframeStore.h"
 #include "Core/API/Buffer.h"
 #include "Core/Pass/ComputePass.h"
 #include "Scene/Curves/CurveConfig.h"
@@ -68,6 +69,8 @@ namespace Falcor
 
         // vertexData[i][j] represents at the i-th keyframe, the cache data of the j-th vertex.
         std::vector<std::vector<PackedStaticVertexData>> vertexData;
+
+        VertexCacheKeyframeStore::Encoding keyframeEncoding = VertexCacheKeyframeStore::Encoding::Raw; ///< Encoding of the keyframes in host memory.
     };
 
     class FALCOR_API AnimatedVertexCache
@@ -112,6 +115,13 @@ namespace Falcor
 
         void createMeshVertexUpdatePass();
 
+        /** Make the keyframes of a mesh resident in its GPU keyframe slots, uploading them if needed.
+            \param[in] meshIndex Index into mCachedMeshes.
+            \param[in] keyframes Keyframe indices.
+            \return Slot indices of the keyframes relative to the first slot of the mesh.
+        */
+        uint2 makeMeshKeyframesResident(size_t meshIndex, uint2 keyframes);
+
         void executeMeshVertexUpdatePass(RenderContext* pContext, double t, bool copyPrev = false);
 
         // Interpolate vertex positions.
@@ -166,9 +176,20 @@ namespace Falcor
         // Cached mesh animations
         ref<ComputePass> mpMeshVertexUpdatePass;
 
-        std::vector<CachedMesh> mCachedMeshes;
+        struct MeshKeyframeWindow
+        {
+            uint32_t slotOffset = 0;                ///< Index of the first keyframe slot of the mesh in mpMeshVertexBuffers.
+            std::vector<uint32_t> slotKeyframes;    ///< Keyframe resident in each slot.
+            std::vector<uint64_t> slotLastUse;      ///< Update on which each slot was last used.
+        };
+
+        std::vector<CachedMesh> mCachedMeshes;  ///< Vertex data is moved to mMeshKeyframeStores.
+        std::vector<VertexCacheKeyframeStore> mMeshKeyframeStores;
+        std::vector<MeshKeyframeWindow> mMeshKeyframeWindows;
+        std::vector<PackedStaticVertexData> mMeshStagingVertices[2];
+        uint64_t mMeshUpdateCount = 0;
         std::vector<InterpolationInfo> mMeshInterpolationInfo;
-        uint32_t mMeshKeyframeCount = 0; ///< Total count of all keyframes for all meshes
+        uint32_t mMeshKeyframeCount = 0; ///< Total count of keyframe slots for all meshes
         uint32_t mMaxMeshVertexCount = 0; ///< Greatest vertex count a mesh has
 
         std::vector<ref<Buffer>> mpMeshVertexBuffers;
@@ -112,6 +112,11 @@ namespace Falcor
     {}
 
     float4x4 Animation::animate(double currentTime)
+    {
+        return evaluate(currentTime, mCachedFrameIndex);
+    }
+
+    float4x4 Animation::evaluate(double currentTime, size_t& keyframeHint) const
     {
         // Calculate the sample time.
         double time = currentTime;
@@ -129,7 +134,7 @@ namespace Falcor
         if (isLinearPreInfinity && mKeyframes.size() > 1)
         {
             const auto& k0 = mKeyframes.front();
-            auto k1 = interpolate(mInterpolationMode, k0.time + kEpsilonTime);
+            auto k1 = interpolate(mInterpolationMode, k0.time + kEpsilonTime, keyframeHint);
             double segmentDuration = k1.time - k0.time;
             float t = (float)((time - k0.time) / segmentDuration);
             interpolated = interpolateLinear(k0, k1, t);
@@ -137,14 +142,14 @@ namespace Falcor
         else if (isLinearPostInfinity && mKeyframes.size() > 1)
         {
             const auto& k1 = mKeyframes.back();
-            auto k0 = interpolate(mInterpolationMode, k1.time - kEpsilonTime);
+            auto k0 = interpolate(mInterpolationMode, k1.time - kEpsilonTime, keyframeHint);
             double segmentDuration = k1.time - k0.time;
             float t = (float)((time - k0.time) / segmentDuration);
             interpolated = interpolateLinear(k0, k1, t);
         }
         else
         {
-            interpolated = interpolate(mInterpolationMode, time);
+            interpolated = interpolate(mInterpolationMode, time, keyframeHint);
         }
 
         float4x4 T = math::matrixFromTranslation(interpolated.translation);
@@ -155,23 +160,27 @@ namespace Falcor
         return transform;
     }
 
-    Animation::Keyframe Animation::interpolate(InterpolationMode mode, double time) const
+    Animation::Keyframe Animation::interpolate(InterpolationMode mode, double time, size_t& keyframeHint) const
     {
         FALCOR_ASSERT(!mKeyframes.empty());
 
-        // Validate cached frame index.
-        size_t frameIndex = std::clamp(mCachedFrameIndex, (size_t)0, mKeyframes.size() - 1);
-        if (time < mKeyframes[frameIndex].time) frameIndex = 0;
+        // Find frame index, i.e. the last keyframe at or before the time.
+        // Start from the hint and step forward, which is cheap for increasing times.
+        // Fall back to a binary search if the time is before the hint.
+        size_t frameIndex = std::clamp(keyframeHint, (size_t)0, mKeyframes.size() - 1);
+        if (time < mKeyframes[frameIndex].time)
+        {
+            auto it = std::upper_bound(mKeyframes.begin(), mKeyframes.end(), time, [](double t, const Keyframe& k) { return t < k.time; });
+            frameIndex = it == mKeyframes.begin() ? 0 : (size_t)std::distance(mKeyframes.begin(), it) - 1;
+        }
 
-        // Find frame index.
         while (frameIndex < mKeyframes.size() - 1)
         {
             if (mKeyframes[frameIndex + 1].time > time) break;
             frameIndex++;
         }
 
-        // Cache frame index;
-        mCachedFrameIndex = frameIndex;
+        keyframeHint = frameIndex;
 
         // Compute index of adjacent frame including optional warping.
         auto adjacentFrame = [this] (size_t frame, int32_t offset = 1)
@@ -222,7 +231,7 @@ namespace Falcor
     // the animation does not behave linearly. If the animation behaves linearly, then the
     // current time is returned. This function should not be used if the current time lies
     // within the range of defined keyframe times.
-    double Animation::calcSampleTime(double currentTime)
+    double Animation::calcSampleTime(double currentTime) const
     {
         double modifiedTime = currentTime;
         double firstKeyframeTime = mKeyframes.front().time;
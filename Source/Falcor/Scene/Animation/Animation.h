@@ -149,13 +149,21 @@ namespace Falcor
         */
         float4x4 animate(double currentTime);
 
+        /** Compute the animation without modifying the animation state.
+            This is safe to call concurrently, e.g. to evaluate many times in parallel.
+            \param currentTime The current time in seconds. Handled as in animate().
+            \param[in,out] keyframeHint Index of the keyframe found by the previous call. Speeds up evaluating increasing times.
+            \return Returns the animation's transform matrix for the specified time.
+        */
+        float4x4 evaluate(double currentTime, size_t& keyframeHint) const;
+
         /* Render the UI.
         */
         void renderUI(Gui::Widgets& widget);
 
     private:
-        Keyframe interpolate(InterpolationMode mode, double time) const;
-        double calcSampleTime(double currentTime);
+        Keyframe interpolate(InterpolationMode mode, double time, size_t& keyframeHint) const;
+        double calcSampleTime(double currentTime) const;
 
         std::string mName;
         NodeID mNodeID;
@@ -168,7 +176,7 @@ namespace Falcor
         bool mEnableWarping = false;
 
         std::vector<Keyframe> mKeyframes;
-        mutable size_t mCachedFrameIndex = 0;
+        size_t mCachedFrameIndex = 0;
 
         friend class SceneCache;
     };
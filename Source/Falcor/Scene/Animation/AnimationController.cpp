@@ -28,7 +28,10 @@
 #include "AnimationController.h"
 #include "Core/API/RenderContext.h"
 #include "Utils/Timing/Profiler.h"
+#include "Utils/NumericRange.h"
 #include "Scene/Scene.h"
+#include <algorithm>
+#include <execution>
 #include <fstream>
 
 namespace Falcor
@@ -298,6 +301,62 @@ namespace Falcor
         }
     }
 
+    std::vector<float4x4> AnimationController::evaluateGlobalMatrices(NodeID nodeID, fstd::span<const double> times) const
+    {
+        const auto& sceneGraph = mpScene->mSceneGraph;
+        FALCOR_CHECK(nodeID.get() < sceneGraph.size(), "Invalid scene graph node {}.", nodeID);
+
+        // Collect the chain of nodes from the root to the node, along with their animations.
+        // As in updateLocalMatrices(), the last animation of a node takes precedence.
+        struct ChainNode
+        {
+            NodeID nodeID;
+            const Animation* pAnimation = nullptr;
+        };
+        std::vector<ChainNode> chain;
+        for (NodeID id = nodeID; id != NodeID::Invalid(); id = sceneGraph[id.get()].parent)
+        {
+            chain.push_back({ id });
+        }
+        std::reverse(chain.begin(), chain.end());
+
+        if (mEnabled)
+        {
+            for (const auto& pAnimation : mAnimations)
+            {
+                for (auto& node : chain)
+                {
+                    if (node.nodeID == pAnimation->getNodeID()) node.pAnimation = pAnimation.get();
+                }
+            }
+        }
+
+        std::vector<float4x4> globalMatrices(times.size());
+
+        // Evaluate in chunks of consecutive times so that the keyframe hints are effective for sorted times.
+        const size_t kChunkSize = 64;
+        auto range = NumericRange<size_t>(0, (times.size() + kChunkSize - 1) / kChunkSize);
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t chunk)
+        {
+            std::vector<size_t> keyframeHints(chain.size(), 0);
+            size_t end = std::min(times.size(), (chunk + 1) * kChunkSize);
+            for (size_t i = chunk * kChunkSize; i < end; i++)
+            {
+                double time = mLoopAnimations && mGlobalAnimationLength > 0.0 ? std::fmod(times[i], mGlobalAnimationLength) : times[i];
+                float4x4 globalMatrix = float4x4::identity();
+                for (size_t j = 0; j < chain.size(); j++)
+                {
+                    const auto& node = chain[j];
+                    float4x4 localMatrix = node.pAnimation ? node.pAnimation->evaluate(time, keyframeHints[j]) : sceneGraph[node.nodeID.get()].transform;
+                    globalMatrix = j == 0 ? localMatrix : mul(globalMatrix, localMatrix);
+                }
+                globalMatrices[i] = globalMatrix;
+            }
+        });
+
+        return globalMatrices;
+    }
+
     void AnimationController::updateWorldMatrices(bool updateAll)
     {
         const auto& sceneGraph = mpScene->mSceneGraph;
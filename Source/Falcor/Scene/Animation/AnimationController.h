@@ -33,6 +33,7 @@
 #include "Core/Pass/ComputePass.h"
 #include "Utils/Math/Matrix.h"
 #include "Scene/SceneTypes.slang"
+#include <fstd/span.h>
 #include <memory>
 #include <vector>
 
@@ -124,6 +125,15 @@ namespace Falcor
         */
         const std::vector<float4x4>& getInvTransposeGlobalMatrices() const { return mInvTransposeGlobalMatrices; }
 
+        /** Evaluate the global matrix of a scene graph node at a list of times.
+            This does not change the state of the controller. The times are evaluated in parallel.
+            Global looping and enabling of animations are handled as in animate().
+            \param[in] nodeID Scene graph node.
+            \param[in] times Global times in seconds.
+            \return Object-to-world space transforms of the node, one per time.
+        */
+        std::vector<float4x4> evaluateGlobalMatrices(NodeID nodeID, fstd::span<const double> times) const;
+
         /** Render the UI.
         */
         void renderUI(Gui::Widgets& widget);
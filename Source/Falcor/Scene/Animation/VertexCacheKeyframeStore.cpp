@@ -0,0 +1,300 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "VertexCacheKeyframeStore.h"
+#include "Core/Error.h"
+#include "Utils/Math/VectorMath.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <functional>
+#include <limits>
+
+namespace Falcor
+{
+    namespace
+    {
+        const uint32_t kVerticesPerTask = 4096;
+        const float kQuantizationLevels = 65535.f;
+        const int kMaxDelta = 127;
+
+        size_t alignOffset(size_t offset) { return (offset + 15) & ~size_t(15); }
+
+        template<typename T>
+        T* dataAt(std::vector<uint8_t>& data, size_t offset) { return reinterpret_cast<T*>(data.data() + offset); }
+
+        template<typename T>
+        const T* dataAt(const std::vector<uint8_t>& data, size_t offset) { return reinterpret_cast<const T*>(data.data() + offset); }
+
+        void forEachVertexRange(uint32_t vertexCount, const std::function<void(uint32_t, uint32_t)>& func)
+        {
+            uint32_t taskCount = (vertexCount + kVerticesPerTask - 1) / kVerticesPerTask;
+            if (taskCount <= 1)
+            {
+                func(0, vertexCount);
+                return;
+            }
+
+            auto range = NumericRange<uint32_t>(0, taskCount);
+            std::for_each(
+                std::execution::par,
+                range.begin(),
+                range.end(),
+                [&](uint32_t task)
+                {
+                    uint32_t begin = task * kVerticesPerTask;
+                    func(begin, std::min(begin + kVerticesPerTask, vertexCount));
+                }
+            );
+        }
+    }
+
+    VertexCacheKeyframeStore::VertexCacheKeyframeStore(const std::vector<std::vector<PackedStaticVertexData>>& keyframes, Encoding encoding)
+        : mEncoding(encoding)
+    {
+        if (keyframes.empty()) return;
+
+        mVertexCount = (uint32_t)keyframes.front().size();
+        for (const auto& vertices : keyframes)
+        {
+            FALCOR_CHECK(vertices.size() == mVertexCount, "All keyframes must have the same vertex count.");
+        }
+
+        mTexCrds.resize(mVertexCount);
+        for (uint32_t i = 0; i < mVertexCount; i++) mTexCrds[i] = keyframes.front()[i].texCrd;
+
+        // Compute the bounds over all keyframes for quantization.
+        if (mEncoding != Encoding::Raw)
+        {
+            float3 minPos(std::numeric_limits<float>::infinity());
+            float3 maxPos(-std::numeric_limits<float>::infinity());
+            for (const auto& vertices : keyframes)
+            {
+                for (const auto& v : vertices)
+                {
+                    minPos = min(minPos, v.position);
+                    maxPos = max(maxPos, v.position);
+                }
+            }
+            if (mVertexCount == 0) minPos = maxPos = float3(0.f);
+            mOrigin = minPos;
+            mStep = (maxPos - minPos) / kQuantizationLevels;
+        }
+
+        auto quantize = [&](float3 p)
+        {
+            int3 q(0);
+            for (int c = 0; c < 3; c++)
+            {
+                if (mStep[c] > 0.f) q[c] = (int)std::clamp(std::round((p[c] - mOrigin[c]) / mStep[c]), 0.f, kQuantizationLevels);
+            }
+            return q;
+        };
+
+        // Encode the keyframes one after another into the contiguous buffer.
+        const size_t tangentFrameSize = sizeof(float3) * mVertexCount;
+        std::vector<int3> prevQuantized;
+        std::vector<int3> quantized(mEncoding == Encoding::Raw ? 0 : mVertexCount);
+        uint32_t chainLength = 0;
+
+        mKeyframes.resize(keyframes.size());
+        for (uint32_t k = 0; k < (uint32_t)keyframes.size(); k++)
+        {
+            const auto& vertices = keyframes[k];
+            Keyframe& keyframe = mKeyframes[k];
+            keyframe.baseKeyframe = k;
+
+            size_t positionSize = sizeof(float3) * mVertexCount;
+            if (mEncoding != Encoding::Raw)
+            {
+                for (uint32_t i = 0; i < mVertexCount; i++) quantized[i] = quantize(vertices[i].position);
+
+                if (mEncoding == Encoding::Delta && k > 0 && chainLength < kMaxDeltaChainLength)
+                {
+                    keyframe.isDelta = true;
+                    for (uint32_t i = 0; i < mVertexCount && keyframe.isDelta; i++)
+                    {
+                        int3 d = quantized[i] - prevQuantized[i];
+                        keyframe.isDelta = std::abs(d.x) <= kMaxDelta && std::abs(d.y) <= kMaxDelta && std::abs(d.z) <= kMaxDelta;
+                    }
+                }
+
+                chainLength = keyframe.isDelta ? chainLength + 1 : 0;
+                if (keyframe.isDelta) keyframe.baseKeyframe = mKeyframes[k - 1].baseKeyframe;
+                positionSize = (keyframe.isDelta ? sizeof(int8_t) : sizeof(uint16_t)) * 3 * mVertexCount;
+            }
+
+            keyframe.positionOffset = alignOffset(mData.size());
+            keyframe.tangentFrameOffset = alignOffset(keyframe.positionOffset + positionSize);
+            mData.resize(keyframe.tangentFrameOffset + tangentFrameSize);
+
+            if (mEncoding == Encoding::Raw)
+            {
+                float3* pPositions = dataAt<float3>(mData, keyframe.positionOffset);
+                for (uint32_t i = 0; i < mVertexCount; i++) pPositions[i] = vertices[i].position;
+            }
+            else if (keyframe.isDelta)
+            {
+                int8_t* pDeltas = dataAt<int8_t>(mData, keyframe.positionOffset);
+                for (uint32_t i = 0; i < mVertexCount; i++)
+                {
+                    int3 d = quantized[i] - prevQuantized[i];
+                    for (int c = 0; c < 3; c++) pDeltas[3 * i + c] = (int8_t)d[c];
+                }
+            }
+            else
+            {
+                uint16_t* pPositions = dataAt<uint16_t>(mData, keyframe.positionOffset);
+                for (uint32_t i = 0; i < mVertexCount; i++)
+                {
+                    for (int c = 0; c < 3; c++) pPositions[3 * i + c] = (uint16_t)quantized[i][c];
+                }
+            }
+
+            float3* pTangentFrames = dataAt<float3>(mData, keyframe.tangentFrameOffset);
+            for (uint32_t i = 0; i < mVertexCount; i++) pTangentFrames[i] = vertices[i].packedNormalTangentCurveRadius;
+
+            std::swap(prevQuantized, quantized);
+            if (mEncoding != Encoding::Raw) quantized.resize(mVertexCount);
+        }
+
+        mData.shrink_to_fit();
+    }
+
+    size_t VertexCacheKeyframeStore::getMemoryUsageInBytes() const
+    {
+        return mData.size() + mTexCrds.size() * sizeof(float2) + mKeyframes.size() * sizeof(Keyframe);
+    }
+
+    void VertexCacheKeyframeStore::decodeKeyframe(uint32_t keyframe, fstd::span<PackedStaticVertexData> vertices) const
+    {
+        FALCOR_CHECK(keyframe < getKeyframeCount(), "Keyframe index {} is out of range.", keyframe);
+        FALCOR_CHECK(vertices.size() >= mVertexCount, "Output holds {} vertices, expected {}.", vertices.size(), mVertexCount);
+
+        forEachVertexRange(mVertexCount, [&](uint32_t begin, uint32_t end) { decodeRange(uint2(keyframe), begin, end, vertices.data(), nullptr); });
+    }
+
+    void VertexCacheKeyframeStore::decodeKeyframes(uint2 keyframes, fstd::span<PackedStaticVertexData> vertices0, fstd::span<PackedStaticVertexData> vertices1) const
+    {
+        FALCOR_CHECK(keyframes.x < getKeyframeCount() && keyframes.y < getKeyframeCount(), "Keyframe indices ({}, {}) are out of range.", keyframes.x, keyframes.y);
+        FALCOR_CHECK(vertices0.size() >= mVertexCount && vertices1.size() >= mVertexCount, "Outputs must hold {} vertices.", mVertexCount);
+
+        forEachVertexRange(mVertexCount, [&](uint32_t begin, uint32_t end) { decodeRange(keyframes, begin, end, vertices0.data(), vertices1.data()); });
+    }
+
+    void VertexCacheKeyframeStore::interpolate(fstd::span<const PackedStaticVertexData> vertices0, fstd::span<const PackedStaticVertexData> vertices1, float t, fstd::span<PackedStaticVertexData> result)
+    {
+        FALCOR_CHECK(vertices0.size() == vertices1.size() && result.size() >= vertices0.size(), "Vertex counts do not match.");
+
+        forEachVertexRange((uint32_t)vertices0.size(), [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                StaticVertexData v0 = vertices0[i].unpack();
+                StaticVertexData v1 = vertices1[i].unpack();
+
+                StaticVertexData v = {};
+                v.position = lerp(v0.position, v1.position, t);
+                v.normal = normalize(lerp(v0.normal, v1.normal, t));
+                v.tangent = lerp(v0.tangent, v1.tangent, t);
+                v.tangent = float4(normalize(v.tangent.xyz()), v.tangent.w);
+                v.texCrd = v0.texCrd;
+                result[i].pack(v);
+            }
+        });
+    }
+
+    int3 VertexCacheKeyframeStore::decodeQuantized(uint32_t keyframe, uint32_t vertex) const
+    {
+        uint32_t base = mKeyframes[keyframe].baseKeyframe;
+        const uint16_t* pPositions = dataAt<uint16_t>(mData, mKeyframes[base].positionOffset) + 3 * vertex;
+        int3 q(pPositions[0], pPositions[1], pPositions[2]);
+        for (uint32_t k = base + 1; k <= keyframe; k++) q = applyDelta(q, k, vertex);
+        return q;
+    }
+
+    int3 VertexCacheKeyframeStore::applyDelta(int3 q, uint32_t keyframe, uint32_t vertex) const
+    {
+        FALCOR_ASSERT(mKeyframes[keyframe].isDelta);
+        const int8_t* pDeltas = dataAt<int8_t>(mData, mKeyframes[keyframe].positionOffset) + 3 * vertex;
+        return q + int3(pDeltas[0], pDeltas[1], pDeltas[2]);
+    }
+
+    float3 VertexCacheKeyframeStore::dequantize(int3 q) const
+    {
+        return mOrigin + float3(q) * mStep;
+    }
+
+    void VertexCacheKeyframeStore::decodeVertex(const Keyframe& keyframe, uint32_t vertex, float3 position, PackedStaticVertexData& out) const
+    {
+        out.position = position;
+        out.packedNormalTangentCurveRadius = dataAt<float3>(mData, keyframe.tangentFrameOffset)[vertex];
+        out.texCrd = mTexCrds[vertex];
+    }
+
+    void VertexCacheKeyframeStore::decodeRange(uint2 keyframes, uint32_t begin, uint32_t end, PackedStaticVertexData* pVertices0, PackedStaticVertexData* pVertices1) const
+    {
+        const Keyframe& keyframe0 = mKeyframes[keyframes.x];
+        const Keyframe& keyframe1 = mKeyframes[keyframes.y];
+
+        if (mEncoding == Encoding::Raw)
+        {
+            const float3* pPositions0 = dataAt<float3>(mData, keyframe0.positionOffset);
+            const float3* pPositions1 = dataAt<float3>(mData, keyframe1.positionOffset);
+            for (uint32_t i = begin; i < end; i++)
+            {
+                decodeVertex(keyframe0, i, pPositions0[i], pVertices0[i]);
+                if (pVertices1) decodeVertex(keyframe1, i, pPositions1[i], pVertices1[i]);
+            }
+            return;
+        }
+
+        // The second keyframe continues the delta chain of the first one if it follows it in the same chain.
+        bool continuesChain = keyframes.y > keyframes.x && keyframe1.baseKeyframe == keyframe0.baseKeyframe;
+
+        for (uint32_t i = begin; i < end; i++)
+        {
+            int3 q0 = decodeQuantized(keyframes.x, i);
+            decodeVertex(keyframe0, i, dequantize(q0), pVertices0[i]);
+            if (!pVertices1) continue;
+
+            int3 q1;
+            if (continuesChain)
+            {
+                q1 = q0;
+                for (uint32_t k = keyframes.x + 1; k <= keyframes.y; k++) q1 = applyDelta(q1, k, i);
+            }
+            else
+            {
+                q1 = decodeQuantized(keyframes.y, i);
+            }
+            decodeVertex(keyframe1, i, dequantize(q1), pVertices1[i]);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SharedTypes.slang"
+#include "Core/Macros.h"
+#include "Scene/SceneTypes.slang"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** Compact host-side storage for the keyframes of a cached mesh animation.
+
+        All keyframes of a mesh are stored in a single contiguous buffer, with the positions and the packed
+        normal/tangent data of each keyframe laid out as separate arrays. Texture coordinates are not animated
+        (see UpdateMeshVertices.slang) and are stored only once.
+
+        Positions can optionally be quantized to 16 bits per component relative to the bounds of the whole
+        animation, and delta-encoded against the previous keyframe. With delta encoding, a keyframe is stored
+        as 8-bit deltas if all its vertices moved by at most 127 quantization steps, and as absolute quantized
+        positions otherwise. Deltas are computed on the quantized values, so delta encoding is lossless
+        relative to quantization. Chains of delta keyframes are limited to kMaxDeltaChainLength to bound the
+        decoding cost.
+
+        Decoding is parallelized over vertices and produces PackedStaticVertexData ready for upload.
+    */
+    class FALCOR_API VertexCacheKeyframeStore
+    {
+    public:
+        enum class Encoding
+        {
+            Raw,        ///< Full precision float positions.
+            Quantized,  ///< 16-bit positions relative to the animation bounds.
+            Delta,      ///< 16-bit positions, stored as 8-bit deltas to the previous keyframe where possible.
+        };
+
+        static constexpr uint32_t kMaxDeltaChainLength = 15;
+
+        VertexCacheKeyframeStore() = default;
+
+        /** Encode the keyframes of a mesh.
+            \param[in] keyframes Vertex data per keyframe. All keyframes must have the same vertex count.
+            \param[in] encoding Position encoding.
+        */
+        VertexCacheKeyframeStore(const std::vector<std::vector<PackedStaticVertexData>>& keyframes, Encoding encoding);
+
+        Encoding getEncoding() const { return mEncoding; }
+        uint32_t getKeyframeCount() const { return (uint32_t)mKeyframes.size(); }
+        uint32_t getVertexCount() const { return mVertexCount; }
+
+        /** Returns true if the keyframe is stored as deltas to the previous keyframe.
+        */
+        bool isDeltaKeyframe(uint32_t keyframe) const { return mKeyframes[keyframe].isDelta; }
+
+        /** Returns the size of a quantization step along each axis, or zero for raw positions.
+            Decoded positions are within half a step of the original positions.
+        */
+        float3 getQuantizationStep() const { return mEncoding == Encoding::Raw ? float3(0.f) : mStep; }
+
+        /** Returns the host memory used by the encoded keyframes.
+        */
+        size_t getMemoryUsageInBytes() const;
+
+        /** Decode a keyframe.
+            \param[in] keyframe Keyframe index.
+            \param[out] vertices Decoded vertex data, must hold getVertexCount() elements.
+        */
+        void decodeKeyframe(uint32_t keyframe, fstd::span<PackedStaticVertexData> vertices) const;
+
+        /** Decode the two keyframes bracketing an interpolation in a single pass over the vertices.
+            If the second keyframe is delta-encoded against the first, the delta chain is only walked once.
+            \param[in] keyframes Keyframe indices.
+            \param[out] vertices0 Decoded vertex data of the first keyframe.
+            \param[out] vertices1 Decoded vertex data of the second keyframe.
+        */
+        void decodeKeyframes(uint2 keyframes, fstd::span<PackedStaticVertexData> vertices0, fstd::span<PackedStaticVertexData> vertices1) const;
+
+        /** Interpolate between two decoded keyframes on the CPU.
+            This matches interpolateVertex() in UpdateMeshVertices.slang and is used as a reference for the GPU pass.
+            Texture coordinates are taken from the first keyframe.
+            \param[in] vertices0 Vertex data of the first keyframe.
+            \param[in] vertices1 Vertex data of the second keyframe.
+            \param[in] t Interpolation weight.
+            \param[out] result Interpolated vertex data.
+        */
+        static void interpolate(fstd::span<const PackedStaticVertexData> vertices0, fstd::span<const PackedStaticVertexData> vertices1, float t, fstd::span<PackedStaticVertexData> result);
+
+    private:
+        struct Keyframe
+        {
+            size_t positionOffset = 0;  ///< Byte offset of the positions in mData.
+            size_t tangentFrameOffset = 0; ///< Byte offset of the packed normal/tangent data in mData.
+            uint32_t baseKeyframe = 0;  ///< Closest keyframe at or before this one with absolute positions.
+            bool isDelta = false;
+        };
+
+        int3 decodeQuantized(uint32_t keyframe, uint32_t vertex) const;
+        int3 applyDelta(int3 q, uint32_t keyframe, uint32_t vertex) const;
+        float3 dequantize(int3 q) const;
+        void decodeVertex(const Keyframe& keyframe, uint32_t vertex, float3 position, PackedStaticVertexData& out) const;
+        void decodeRange(uint2 keyframes, uint32_t begin, uint32_t end, PackedStaticVertexData* pVertices0, PackedStaticVertexData* pVertices1) const;
+
+        Encoding mEncoding = Encoding::Raw;
+        uint32_t mVertexCount = 0;
+        float3 mOrigin = float3(0.f);
+        float3 mStep = float3(0.f);
+
+        std::vector<Keyframe> mKeyframes;
+        std::vector<float2> mTexCrds;
+        std::vector<uint8_t> mData;     ///< Encoded keyframes, contiguous.
+    };
+}
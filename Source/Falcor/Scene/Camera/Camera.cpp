@@ -42,6 +42,79 @@ namespace Falcor
         const std::string kPosition = "position";
         const std::string kTarget = "target";
         const std::string kUp = "up";
+
+        /** Compute the derived camera data (matrices, frame size and ray tracing vectors) from the camera parameters.
+            \param[in,out] data Camera data.
+            \param[in] preserveHeight If true, preserve the frame height, otherwise the frame width.
+            \param[in] pViewMat Persistent view matrix, or nullptr to compute it from the position, target and up vector.
+            \param[in] pProjMat Persistent projection matrix, or nullptr to compute it from the lens settings.
+        */
+        void computeCameraData(CameraData& data, bool preserveHeight, const float4x4* pViewMat, const float4x4* pProjMat)
+        {
+            if (preserveHeight)
+            {
+                // Set frame width based on height and aspect ratio
+                data.frameWidth = data.frameHeight * data.aspectRatio;
+            }
+            else
+            {
+                // Set frame height based on width and aspect ratio
+                data.frameHeight = data.frameWidth / data.aspectRatio;
+            }
+
+            // Interpret focal length of 0 as 0 FOV. Technically 0 FOV should be focal length of infinity.
+            const float fovY = data.focalLength == 0.0f ? 0.0f : focalLengthToFovY(data.focalLength, data.frameHeight);
+
+            if (pViewMat)
+            {
+                data.viewMat = *pViewMat;
+            }
+            else
+            {
+                data.viewMat = math::matrixFromLookAt(data.posW, data.target, data.up, math::Handedness::RightHanded);
+            }
+
+            // if camera projection is set to be persistent, don't override it.
+            if (pProjMat)
+            {
+                data.projMat = *pProjMat;
+            }
+            else
+            {
+                if (fovY != 0.f)
+                {
+                    data.projMat = math::perspective(fovY, data.aspectRatio, data.nearZ, data.farZ);
+                }
+                else
+                {
+                    // Take the length of look-at vector as half a viewport size
+                    const float halfLookAtLength = length(data.posW - data.target) * 0.5f;
+                    data.projMat = math::ortho(-halfLookAtLength, halfLookAtLength, -halfLookAtLength, halfLookAtLength, data.nearZ, data.farZ);
+                }
+            }
+
+            // Build jitter matrix
+            // (jitterX and jitterY are expressed as subpixel quantities divided by the screen resolution
+            //  for instance to apply an offset of half pixel along the X axis we set jitterX = 0.5f / Width)
+            float4x4 jitterMat = math::matrixFromTranslation(float3(2.0f * data.jitterX, 2.0f * data.jitterY, 0.0f));
+
+            // Apply jitter matrix to the projection matrix
+            data.viewProjMatNoJitter = mul(data.projMat, data.viewMat);
+            data.projMatNoJitter = data.projMat;
+            data.projMat = mul(jitterMat, data.projMat);
+
+            data.viewProjMat = mul(data.projMat, data.viewMat);
+            data.invViewProj = inverse(data.viewProjMat);
+
+            // Ray tracing related vectors
+            data.cameraW = normalize(data.target - data.posW) * data.focalDistance;
+            data.cameraU = normalize(cross(data.cameraW, data.up));
+            data.cameraV = normalize(cross(data.cameraU, data.cameraW));
+            const float ulen = data.focalDistance * std::tan(fovY * 0.5f) * data.aspectRatio;
+            data.cameraU *= ulen;
+            const float vlen = data.focalDistance * std::tan(fovY * 0.5f);
+            data.cameraV *= vlen;
+        }
     }
 
     static_assert(sizeof(CameraData) % (sizeof(float4)) == 0, "CameraData size should be a multiple of 16");
@@ -53,7 +126,8 @@ namespace Falcor
 
     Camera::Changes Camera::beginFrame(bool firstFrame)
     {
-        if (mJitterPattern.pGenerator)
+        // The jitter of a camera path is drawn from the pattern generator when the path is created.
+        if (mJitterPattern.pGenerator && !mpPath)
         {
             float2 jitter = mJitterPattern.pGenerator->next();
             jitter *= mJitterPattern.scale;
@@ -100,88 +174,73 @@ namespace Falcor
     {
         if (mDirty)
         {
-            if (mPreserveHeight)
-            {
-                // Set frame width based on height and aspect ratio
-                mData.frameWidth = mData.frameHeight * mData.aspectRatio;
-            }
-            else
-            {
-                // Set frame height based on width and aspect ratio
-                mData.frameHeight = mData.frameWidth / mData.aspectRatio;
-            }
-
-            // Interpret focal length of 0 as 0 FOV. Technically 0 FOV should be focal length of infinity.
-            const float fovY = mData.focalLength == 0.0f ? 0.0f : focalLengthToFovY(mData.focalLength, mData.frameHeight);
+            computeCameraData(mData, mPreserveHeight, mEnablePersistentViewMat ? &mPersistentViewMat : nullptr, mEnablePersistentProjMat ? &mPersistentProjMat : nullptr);
+            updateFrustumPlanes();
+            mDirty = false;
+        }
+    }
 
-            if (mEnablePersistentViewMat)
-            {
-                mData.viewMat = mPersistentViewMat;
-            }
-            else
+    void Camera::updateFrustumPlanes() const
+    {
+        // Extract camera space frustum planes from the VP matrix
+        // See: https://fgiesen.wordpress.com/2012/08/31/frustum-planes-from-the-projection-matrix/
+        float4x4 tempMat = transpose(mData.viewProjMat);
+        for (int i = 0; i < 6; i++)
+        {
+            float4 plane = (i & 1) ? tempMat.getCol(i >> 1) : -tempMat.getCol(i >> 1);
+            if(i != 5) // Z range is [0, w]. For the 0 <= z plane we don't need to add w
             {
-                mData.viewMat = math::matrixFromLookAt(mData.posW, mData.target, mData.up, math::Handedness::RightHanded);
+                plane += tempMat.getCol(3);
             }
 
-            // if camera projection is set to be persistent, don't override it.
-            if (mEnablePersistentProjMat)
-            {
-                mData.projMat = mPersistentProjMat;
-            }
-            else
-            {
-                if (fovY != 0.f)
-                {
-                    mData.projMat = math::perspective(fovY, mData.aspectRatio, mData.nearZ, mData.farZ);
-                }
-                else
-                {
-                    // Take the length of look-at vector as half a viewport size
-                    const float halfLookAtLength = length(mData.posW - mData.target) * 0.5f;
-                    mData.projMat = math::ortho(-halfLookAtLength, halfLookAtLength, -halfLookAtLength, halfLookAtLength, mData.nearZ, mData.farZ);
-                }
-            }
-
-            // Build jitter matrix
-            // (jitterX and jitterY are expressed as subpixel quantities divided by the screen resolution
-            //  for instance to apply an offset of half pixel along the X axis we set jitterX = 0.5f / Width)
-            float4x4 jitterMat = math::matrixFromTranslation(float3(2.0f * mData.jitterX, 2.0f * mData.jitterY, 0.0f));
-
-            // Apply jitter matrix to the projection matrix
-            mData.viewProjMatNoJitter = mul(mData.projMat, mData.viewMat);
-            mData.projMatNoJitter = mData.projMat;
-            mData.projMat = mul(jitterMat, mData.projMat);
-
-            mData.viewProjMat = mul(mData.projMat, mData.viewMat);
-            mData.invViewProj = inverse(mData.viewProjMat);
-
-            // Extract camera space frustum planes from the VP matrix
-            // See: https://fgiesen.wordpress.com/2012/08/31/frustum-planes-from-the-projection-matrix/
-            float4x4 tempMat = transpose(mData.viewProjMat);
-            for (int i = 0; i < 6; i++)
-            {
-                float4 plane = (i & 1) ? tempMat.getCol(i >> 1) : -tempMat.getCol(i >> 1);
-                if(i != 5) // Z range is [0, w]. For the 0 <= z plane we don't need to add w
-                {
-                    plane += tempMat.getCol(3);
-                }
+            mFrustumPlanes[i].xyz = plane.xyz();
+            mFrustumPlanes[i].sign = math::sign(mFrustumPlanes[i].xyz);
+            mFrustumPlanes[i].negW = -plane.w;
+        }
+    }
 
-                mFrustumPlanes[i].xyz = plane.xyz();
-                mFrustumPlanes[i].sign = math::sign(mFrustumPlanes[i].xyz);
-                mFrustumPlanes[i].negW = -plane.w;
-            }
+    CameraData Camera::computeData(const float3& posW, const float3& target, const float3& up, const float2& jitter) const
+    {
+        CameraData data = mData;
+        data.posW = posW;
+        data.target = target;
+        data.up = up;
+        data.jitterX = jitter.x;
+        data.jitterY = jitter.y;
+        computeCameraData(data, mPreserveHeight, nullptr, mEnablePersistentProjMat ? &mPersistentProjMat : nullptr);
+
+        data.prevViewMat = data.viewMat;
+        data.prevViewProjMatNoJitter = data.viewProjMatNoJitter;
+        data.prevPosW = data.posW;
+        return data;
+    }
 
-            // Ray tracing related vectors
-            mData.cameraW = normalize(mData.target - mData.posW) * mData.focalDistance;
-            mData.cameraU = normalize(cross(mData.cameraW, mData.up));
-            mData.cameraV = normalize(cross(mData.cameraU, mData.cameraW));
-            const float ulen = mData.focalDistance * std::tan(fovY * 0.5f) * mData.aspectRatio;
-            mData.cameraU *= ulen;
-            const float vlen = mData.focalDistance * std::tan(fovY * 0.5f);
-            mData.cameraV *= vlen;
+    void Camera::setPath(const ref<CameraPath>& pPath)
+    {
+        mpPath = pPath;
+        mPathFrame = 0;
+        if (mpPath) setPathFrame(0);
+        else mDirty = true;
+    }
 
-            mDirty = false;
-        }
+    void Camera::setPathFrame(uint32_t frameIndex)
+    {
+        FALCOR_CHECK(mpPath, "Camera '{}' has no path.", mName);
+        FALCOR_CHECK(frameIndex < mpPath->getFrameCount(), "Frame index {} is out of range for a camera path with {} frames.", frameIndex, mpPath->getFrameCount());
+
+        // Keep the previous frame data, it is set in beginFrame().
+        const float4x4 prevViewMat = mData.prevViewMat;
+        const float4x4 prevViewProjMatNoJitter = mData.prevViewProjMatNoJitter;
+        const float3 prevPosW = mData.prevPosW;
+
+        mData = mpPath->getFrame(frameIndex);
+        mData.prevViewMat = prevViewMat;
+        mData.prevViewProjMatNoJitter = prevViewProjMatNoJitter;
+        mData.prevPosW = prevPosW;
+
+        updateFrustumPlanes();
+        mDirty = false;
+        mPathFrame = frameIndex;
     }
 
     const float4x4 Camera::getViewMatrix() const
@@ -406,6 +465,7 @@ namespace Falcor
         using namespace pybind11::literals;
 
         FALCOR_SCRIPT_BINDING_DEPENDENCY(Animatable)
+        FALCOR_SCRIPT_BINDING_DEPENDENCY(CameraPath)
 
         pybind11::class_<Camera, Animatable, ref<Camera>> camera(m, "Camera");
         camera.def_property("name", &Camera::getName, &Camera::setName);
@@ -422,6 +482,8 @@ namespace Falcor
         camera.def_property(kPosition.c_str(), &Camera::getPosition, &Camera::setPosition);
         camera.def_property(kTarget.c_str(), &Camera::getTarget, &Camera::setTarget);
         camera.def_property(kUp.c_str(), &Camera::getUpVector, &Camera::setUpVector);
+        camera.def_property("path", &Camera::getPath, &Camera::setPath);
+        camera.def_property("pathFrame", &Camera::getPathFrame, &Camera::setPathFrame);
         camera.def(pybind11::init(&Camera::create), "name"_a = "");
     }
 }
@@ -27,6 +27,7 @@
  **************************************************************************/
 #pragma once
 #include "CameraData.slang"
+#include "CameraPath.h"
 #include "Core/Macros.h"
 #include "Utils/Math/Vector.h"
 #include "Utils/Math/Matrix.h"
@@ -140,6 +141,7 @@ namespace Falcor
         const float3& getTarget() const { return mData.target; }
 
         /** Set the camera's world space position.
+            While a path is set, the next call to setPathFrame() overwrites this.
         */
         void setPosition(const float3& posW) { mData.posW = posW; mDirty = true; }
 
@@ -148,6 +150,7 @@ namespace Falcor
         void setUpVector(const float3& up) { mData.up = up; mDirty = true; }
 
         /** Set the camera's world space target position.
+            While a path is set, the next call to setPathFrame() overwrites this.
         */
         void setTarget(const float3& target) { mData.target = target; mDirty = true; }
 
@@ -255,6 +258,36 @@ namespace Falcor
         */
         const CameraData& getData() const { calculateCameraParameters(); return mData; }
 
+        /** Compute the camera data for a viewpoint using the camera's current lens, film, projection and depth settings.
+            The view matrix is always computed from the viewpoint, even if a persistent view matrix is set.
+            This does not modify the camera and is safe to call concurrently.
+            \param[in] posW World-space position.
+            \param[in] target World-space target position.
+            \param[in] up World-space up vector.
+            \param[in] jitter Jitter, see setJitter().
+            \return Camera data. The previous frame data is set to the data of the viewpoint itself.
+        */
+        CameraData computeData(const float3& posW, const float3& target, const float3& up, const float2& jitter) const;
+
+        /** Set a precomputed camera path and select its first frame.
+            While a path is set, the camera data is taken from the selected frame and the pattern generator is not used.
+            \param[in] pPath Camera path, or nullptr to remove the path. The camera keeps the data of the last selected frame.
+        */
+        void setPath(const ref<CameraPath>& pPath);
+
+        /** Get the camera path, or nullptr if no path is set.
+        */
+        const ref<CameraPath>& getPath() const { return mpPath; }
+
+        /** Select a frame of the camera path. This is a constant-time lookup.
+            \param[in] frameIndex Frame index. Must be smaller than the number of frames of the path.
+        */
+        void setPathFrame(uint32_t frameIndex);
+
+        /** Get the selected frame of the camera path.
+        */
+        uint32_t getPathFrame() const { return mPathFrame; }
+
         void updateFromAnimation(const float4x4& transform) override;
 
         /** Render the UI
@@ -299,6 +332,7 @@ namespace Falcor
         bool mPreserveHeight = true;    ///< If true, preserve frame height on change of aspect ratio. Otherwise, preserve width.
 
         void calculateCameraParameters() const;
+        void updateFrustumPlanes() const;
         mutable CameraData mData;
         CameraData mPrevData;
 
@@ -315,8 +349,12 @@ namespace Falcor
             float2 scale;
         } mJitterPattern;
 
+        ref<CameraPath> mpPath;         ///< Precomputed camera path, or nullptr.
+        uint32_t mPathFrame = 0;        ///< Selected frame of the camera path.
+
         void setJitterInternal(float jitterX, float jitterY);
 
+        friend class CameraPath;
         friend class SceneBuilder;
         friend class SceneCache;
     };
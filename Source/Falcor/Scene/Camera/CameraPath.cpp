@@ -0,0 +1,124 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "CameraPath.h"
+#include "Camera.h"
+#include "Utils/NumericRange.h"
+#include "Utils/Scripting/ScriptBindings.h"
+#include <algorithm>
+#include <cmath>
+#include <execution>
+
+namespace Falcor
+{
+    ref<CameraPath> CameraPath::create(const Camera& camera, fstd::span<const Viewpoint> viewpoints)
+    {
+        FALCOR_CHECK(!viewpoints.empty(), "Camera path must have at least one viewpoint.");
+
+        // Draw the jitter sequence up front, the pattern generators are sequential.
+        std::vector<float2> jitters(viewpoints.size(), float2(camera.getJitterX(), camera.getJitterY()));
+        if (const auto& pGenerator = camera.mJitterPattern.pGenerator)
+        {
+            for (auto& jitter : jitters) jitter = pGenerator->next() * camera.mJitterPattern.scale;
+        }
+
+        std::vector<CameraData> frames(viewpoints.size());
+        auto range = NumericRange<size_t>(0, viewpoints.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i)
+        {
+            const auto& viewpoint = viewpoints[i];
+            frames[i] = camera.computeData(viewpoint.position, viewpoint.target, viewpoint.up, jitters[i]);
+        });
+
+        return make_ref<CameraPath>(std::move(frames));
+    }
+
+    ref<CameraPath> CameraPath::createFromTransforms(const Camera& camera, fstd::span<const float4x4> transforms)
+    {
+        std::vector<Viewpoint> viewpoints(transforms.size());
+        for (size_t i = 0; i < transforms.size(); i++)
+        {
+            float3 fwd = -transforms[i].getCol(2).xyz();
+            viewpoints[i].position = transforms[i].getCol(3).xyz();
+            viewpoints[i].target = viewpoints[i].position + fwd;
+            viewpoints[i].up = transforms[i].getCol(1).xyz();
+        }
+        return create(camera, viewpoints);
+    }
+
+    CameraPath::CameraPath(std::vector<CameraData> frames)
+        : mFrames(std::move(frames))
+    {
+        FALCOR_CHECK(!mFrames.empty(), "Camera path must have at least one frame.");
+        FALCOR_CHECK(mFrames.size() <= std::numeric_limits<uint32_t>::max(), "Camera path has too many frames.");
+    }
+
+    void CameraPath::setTiming(double startTime, double frameRate)
+    {
+        FALCOR_CHECK(frameRate > 0.0, "Frame rate must be positive.");
+        mStartTime = startTime;
+        mFrameRate = frameRate;
+    }
+
+    uint32_t CameraPath::getFrameIndex(double time, bool loop) const
+    {
+        FALCOR_CHECK(isTimed(), "Camera path is not timed.");
+        const double frameCount = (double)mFrames.size();
+        double frame = std::round((time - mStartTime) * mFrameRate);
+        if (loop)
+        {
+            // Wrapping the rounded frame is the same as wrapping the time by the path duration frameCount / frameRate.
+            frame = std::fmod(frame, frameCount);
+            if (frame < 0.0) frame += frameCount;
+            return (uint32_t)frame;
+        }
+        return (uint32_t)std::clamp(frame, 0.0, frameCount - 1.0);
+    }
+
+    FALCOR_SCRIPT_BINDING(CameraPath)
+    {
+        using namespace pybind11::literals;
+
+        pybind11::class_<CameraPath, ref<CameraPath>> cameraPath(m, "CameraPath");
+
+        pybind11::class_<CameraPath::Viewpoint> viewpoint(cameraPath, "Viewpoint");
+        viewpoint.def(pybind11::init([](const float3& position, const float3& target, const float3& up) { return CameraPath::Viewpoint{ position, target, up }; }),
+            "position"_a, "target"_a, "up"_a = float3(0.f, 1.f, 0.f));
+        viewpoint.def_readwrite("position", &CameraPath::Viewpoint::position);
+        viewpoint.def_readwrite("target", &CameraPath::Viewpoint::target);
+        viewpoint.def_readwrite("up", &CameraPath::Viewpoint::up);
+
+        cameraPath.def_static("create", [](const ref<Camera>& pCamera, const std::vector<CameraPath::Viewpoint>& viewpoints) { return CameraPath::create(*pCamera, viewpoints); },
+            "camera"_a, "viewpoints"_a);
+        cameraPath.def_property_readonly("frameCount", &CameraPath::getFrameCount);
+        cameraPath.def_property_readonly("timed", &CameraPath::isTimed);
+        cameraPath.def_property_readonly("startTime", &CameraPath::getStartTime);
+        cameraPath.def_property_readonly("frameRate", &CameraPath::getFrameRate);
+        cameraPath.def("setTiming", &CameraPath::setTiming, "startTime"_a, "frameRate"_a);
+        cameraPath.def("getFrameIndex", &CameraPath::getFrameIndex, "time"_a, "loop"_a = false);
+    }
+}
@@ -0,0 +1,121 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "CameraData.slang"
+#include "Core/Macros.h"
+#include "Core/Object.h"
+#include "Utils/Math/Vector.h"
+#include "Utils/Math/Matrix.h"
+#include <fstd/span.h>
+#include <vector>
+
+namespace Falcor
+{
+    class Camera;
+
+    /** Precomputed camera path for batch rendering.
+
+        Holds the camera data for a sequence of frames in a contiguous array. All frames are evaluated up front and
+        in parallel. A camera with a path looks up the data of the selected frame in constant time instead of
+        rebuilding its matrices every frame (see Camera::setPath()).
+
+        The lens, film and projection settings are taken from the camera the path is created for. If the camera has
+        a jitter pattern generator, the jitter sequence is drawn from it when the path is created, in frame order.
+        Otherwise, the camera's current jitter is used for all frames.
+
+        A path can optionally be timed. The scene then selects the frame from the current time.
+    */
+    class FALCOR_API CameraPath : public Object
+    {
+        FALCOR_OBJECT(CameraPath)
+    public:
+        struct Viewpoint
+        {
+            float3 position = float3(0.f, 0.f, 0.f);    ///< World-space position.
+            float3 target = float3(0.f, 0.f, -1.f);     ///< World-space target position.
+            float3 up = float3(0.f, 1.f, 0.f);          ///< World-space up vector.
+        };
+
+        /** Create a path from a list of viewpoints, one frame per viewpoint.
+            \param[in] camera Camera providing the lens, film and jitter settings. Its pattern generator is advanced by the number of frames.
+            \param[in] viewpoints Viewpoints.
+        */
+        static ref<CameraPath> create(const Camera& camera, fstd::span<const Viewpoint> viewpoints);
+
+        /** Create a path from a list of camera transforms, one frame per transform.
+            The transforms are interpreted as in Camera::updateFromAnimation().
+            \param[in] camera Camera providing the lens, film and jitter settings. Its pattern generator is advanced by the number of frames.
+            \param[in] transforms Camera-to-world transforms, e.g. evaluated by AnimationController::evaluateGlobalMatrices().
+        */
+        static ref<CameraPath> createFromTransforms(const Camera& camera, fstd::span<const float4x4> transforms);
+
+        /** Constructor.
+            \param[in] frames Camera data per frame. Must not be empty.
+        */
+        CameraPath(std::vector<CameraData> frames);
+
+        /** Get the number of frames.
+        */
+        uint32_t getFrameCount() const { return (uint32_t)mFrames.size(); }
+
+        /** Get the camera data of a frame.
+        */
+        const CameraData& getFrame(uint32_t frameIndex) const { FALCOR_ASSERT(frameIndex < mFrames.size()); return mFrames[frameIndex]; }
+
+        /** Make the path timed. Frame i is then shown at time startTime + i / frameRate.
+            \param[in] startTime Time of the first frame in seconds.
+            \param[in] frameRate Frames per second. Must be positive.
+        */
+        void setTiming(double startTime, double frameRate);
+
+        /** Returns true if the path is timed.
+        */
+        bool isTimed() const { return mFrameRate > 0.0; }
+
+        /** Get the time of the first frame in seconds.
+        */
+        double getStartTime() const { return mStartTime; }
+
+        /** Get the number of frames per second, or 0 if the path is not timed.
+        */
+        double getFrameRate() const { return mFrameRate; }
+
+        /** Get the frame to show at a given time. The path must be timed.
+            \param[in] time Time in seconds.
+            \param[in] loop If true, the path repeats with a duration of frameCount / frameRate seconds.
+                Otherwise times outside of the path are clamped to the first or last frame.
+            \return Index of the frame closest to the time.
+        */
+        uint32_t getFrameIndex(double time, bool loop = false) const;
+
+    private:
+        std::vector<CameraData> mFrames;
+        double mStartTime = 0.0;
+        double mFrameRate = 0.0;
+    };
+}
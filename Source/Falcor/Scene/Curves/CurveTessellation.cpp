@@ -32,7 +32,10 @@
 #include "Utils/Math/CubicSpline.h"
 #include "Utils/Math/Matrix.h"
 #include "Utils/Math/Quaternion.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
 #include <cmath>
+#include <execution>
 
 namespace Falcor
 {
@@ -98,7 +101,7 @@ namespace Falcor
             return std::max(w, (float)std::numeric_limits<float16_t>::min());
         }
 
-        void optimizeStrandGeometry(CubicSplineCache& splineCache, const CurveArrays& curveArrays, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, uint32_t pointOffset, uint32_t subdivPerSegment, uint32_t keepOneEveryXVerticesPerStrand, float widthScale)
+        void removeDuplicateControlPoints(const CurveArrays& curveArrays, StrandArrays& strandArrays, uint32_t pointOffset)
         {
             strandArrays.controlPoints.clear();
             strandArrays.UVs.clear();
@@ -119,6 +122,11 @@ namespace Falcor
             strandArrays.controlPoints.push_back(curveArrays.controlPoints[pointOffset + strandArrays.vertexCount - 1]);
             strandArrays.widths.push_back(curveArrays.widths[pointOffset + strandArrays.vertexCount - 1]);
             if (curveArrays.UVs) strandArrays.UVs.push_back(curveArrays.UVs[pointOffset + strandArrays.vertexCount - 1]);
+        }
+
+        void optimizeStrandGeometry(CubicSplineCache& splineCache, const CurveArrays& curveArrays, StrandArrays& strandArrays, StrandArrays& optimizedStrandArrays, uint32_t pointOffset, uint32_t subdivPerSegment, uint32_t keepOneEveryXVerticesPerStrand, float widthScale)
+        {
+            removeDuplicateControlPoints(curveArrays, strandArrays, pointOffset);
 
             optimizedStrandArrays.vertexCount = static_cast<uint32_t>(strandArrays.controlPoints.size());
 
@@ -203,7 +211,7 @@ namespace Falcor
             FALCOR_ASSERT_LT(std::abs(length(t) - 1.f), 1e-3f);
         }
 
-        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, uint32_t j)
+        void updateMeshResultBuffers(CurveTessellation::MeshResult& result, const CurveArrays& curveArrays, StrandArrays& optimizedStrandArrays, const float3& fwd, const float3& s, const float3& t, uint32_t pointCountPerCrossSection, uint32_t meshVertexOffset, uint32_t j)
         {
             // Mesh vertices, normals, tangents, and texCrds (if any).
             for (uint32_t k = 0; k < pointCountPerCrossSection; k++)
@@ -211,180 +219,235 @@ namespace Falcor
                 float phi = (float)k / (float)pointCountPerCrossSection * (float)M_PI * 2.f;
                 float3 vNormal = std::cos(phi) * s + std::sin(phi) * t;
 
+                uint32_t vertexIndex = meshVertexOffset + j * pointCountPerCrossSection + k;
                 float curveRadius = 0.5f * optimizedStrandArrays.widths[j];
-                result.vertices.push_back(optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal);
-                result.normals.push_back(vNormal);
-                result.tangents.push_back(float4(fwd.x, fwd.y, fwd.z, 1));
-                result.radii.push_back(curveRadius);
+                result.vertices[vertexIndex] = optimizedStrandArrays.controlPoints[j] + curveRadius * vNormal;
+                result.normals[vertexIndex] = vNormal;
+                result.tangents[vertexIndex] = float4(fwd.x, fwd.y, fwd.z, 1);
+                result.radii[vertexIndex] = curveRadius;
 
                 if (curveArrays.UVs)
                 {
-                    result.texCrds.push_back(optimizedStrandArrays.UVs[j]);
+                    result.texCrds[vertexIndex] = optimizedStrandArrays.UVs[j];
                 }
             }
         }
 
-        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j)
+        void connectFaceVertices(CurveTessellation::MeshResult& result, uint32_t meshVertexOffset, uint32_t faceOffset, uint32_t pointCountPerCrossSection, uint32_t quadCountLimit, uint32_t nextCrossSectionVertexOffset, uint32_t multiplier, uint32_t j)
         {
+            uint32_t face = faceOffset + 2 * j * quadCountLimit;
             for (uint32_t k = 0; k < quadCountLimit; k++)
             {
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-
-                result.faceVertexCounts.push_back(3);
-                result.faceVertexIndices.push_back(meshVertexOffset + multiplier * j * pointCountPerCrossSection + k);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection);
-                result.faceVertexIndices.push_back(meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k);
+                result.faceVertexCounts[face] = 3;
+                result.faceVertexIndices[3 * face + 0] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                result.faceVertexIndices[3 * face + 1] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                result.faceVertexIndices[3 * face + 2] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                face++;
+
+                result.faceVertexCounts[face] = 3;
+                result.faceVertexIndices[3 * face + 0] = meshVertexOffset + multiplier * j * pointCountPerCrossSection + k;
+                result.faceVertexIndices[3 * face + 1] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + (k + nextCrossSectionVertexOffset) % pointCountPerCrossSection;
+                result.faceVertexIndices[3 * face + 2] = meshVertexOffset + (multiplier * j + 1) * pointCountPerCrossSection + k;
+                face++;
             }
         }
-    }
 
-    CurveTessellation::SweptSphereResult CurveTessellation::convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform)
-    {
-        SweptSphereResult result;
-
-        // Only support linear tube segments now.
-        // TODO: Add quadratic or cubic tube segments if necessary.
-        FALCOR_ASSERT(degree == 1);
-        result.degree = degree;
+        /// Number of strands tessellated by each parallel task. Each task owns its scratch buffers.
+        const uint32_t kStrandsPerTask = 64;
 
-        uint32_t pointCounts = 0;
-        uint32_t segCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        /// Input parameters shared by all strands.
+        struct StrandInput
         {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            pointCounts += tmpPointCount;
-            segCounts += tmpPointCount - 1;
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.indices.reserve(segCounts);
-        result.points.reserve(pointCounts);
-        result.radius.reserve(pointCounts);
-        result.texCrds.reserve(pointCounts);
+            uint32_t strandCount;
+            const uint32_t* vertexCountsPerStrand;
+            CurveArrays curveArrays;
+            uint32_t subdivPerSegment;
+            uint32_t keepOneEveryXStrands;
+            uint32_t keepOneEveryXVerticesPerStrand;
+            float widthScale;
+
+            /// Number of strands that are kept.
+            uint32_t getKeptStrandCount() const { return div_round_up(strandCount, keepOneEveryXStrands); }
+        };
+
+        /// Location of a kept strand in the input and output arrays.
+        struct StrandLayout
+        {
+            uint32_t pointOffset;       ///< Offset of the strand's first control point in the input arrays.
+            uint32_t vertexCount;       ///< Number of control points in the input arrays.
+            uint32_t outputPointCount;  ///< Number of tessellated points along the strand.
+            uint32_t outputOffset;      ///< Sum of the tessellated point counts of the preceding strands in the chunk.
+        };
+
+        /// Scratch buffers for tessellating a strand.
+        struct StrandScratch
+        {
+            StrandArrays strandArrays;
+            StrandArrays optimizedStrandArrays;
+            CubicSplineCache splineCache;
+        };
+
+        /** Compute the layout of a chunk of kept strands.
+            \param[in] input Input strands.
+            \param[in] firstKept Index of the first kept strand in the chunk.
+            \param[in] lastKept Index one past the last kept strand in the chunk.
+            \param[in,out] pointOffset Control point offset of the first strand in the chunk. On return, the offset of the next chunk.
+            \param[out] layouts Layout of each strand in the chunk.
+            \return Total number of tessellated points in the chunk.
+        */
+        uint32_t computeStrandLayouts(const StrandInput& input, uint32_t firstKept, uint32_t lastKept, uint32_t& pointOffset, std::vector<StrandLayout>& layouts)
+        {
+            layouts.resize(lastKept - firstKept);
+            for (uint32_t k = firstKept; k < lastKept; k++)
+            {
+                uint32_t i = k * input.keepOneEveryXStrands;
+                layouts[k - firstKept].pointOffset = pointOffset;
+                layouts[k - firstKept].vertexCount = input.vertexCountsPerStrand[i];
+                for (uint32_t j = i; j < std::min(input.strandCount, i + input.keepOneEveryXStrands); j++) pointOffset += input.vertexCountsPerStrand[j];
+            }
 
-        uint32_t pointOffset = 0;
+            // Count the tessellated points of each strand. Tessellation runs over the control points that remain after removing duplicates.
+            auto range = NumericRange<size_t>(0, layouts.size());
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t s)
+            {
+                StrandLayout& layout = layouts[s];
+                const float3* points = input.curveArrays.controlPoints + layout.pointOffset;
+                uint32_t uniqueCount = 1;
+                for (uint32_t j = 0; j < layout.vertexCount - 1; j++)
+                {
+                    if (any(points[j] != points[j + 1])) uniqueCount++;
+                }
+                layout.outputPointCount = div_round_up(input.subdivPerSegment * (uniqueCount - 1), input.keepOneEveryXVerticesPerStrand) + 1;
+            });
 
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
-        CurveArrays curveArrays(controlPoints, widths, UVs);
+            // Exclusive prefix sum over the counts gives each strand its output offset.
+            uint32_t totalPointCount = 0;
+            for (auto& layout : layouts)
+            {
+                layout.outputOffset = totalPointCount;
+                totalPointCount += layout.outputPointCount;
+            }
+            return totalPointCount;
+        }
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        /** Run a function over the strands of a chunk in parallel.
+            \param[in] strandCount Number of strands in the chunk.
+            \param[in] func Function called as func(scratch, strand index).
+        */
+        template<typename Func>
+        void forEachStrand(size_t strandCount, const Func& func)
         {
-            optimizedStrandArrays.controlPoints.clear();
-            optimizedStrandArrays.UVs.clear();
-            optimizedStrandArrays.widths.clear();
-            optimizedStrandArrays.vertexCount = 0;
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
+            auto range = NumericRange<size_t>(0, div_round_up(strandCount, (size_t)kStrandsPerTask));
+            std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t task)
+            {
+                StrandScratch scratch;
+                for (size_t s = task * kStrandsPerTask; s < std::min(strandCount, (task + 1) * kStrandsPerTask); s++) func(scratch, s);
+            });
+        }
 
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+        void tessellateSweptSphereStrand(StrandScratch& scratch, const StrandInput& input, const StrandLayout& layout, uint32_t segmentOffset, const float4x4& xform, CurveTessellation::SweptSphereResult& result)
+        {
+            const uint32_t subdivPerSegment = input.subdivPerSegment;
+            const uint32_t keepOneEveryXVerticesPerStrand = input.keepOneEveryXVerticesPerStrand;
+            const float widthScale = input.widthScale;
+
+            StrandArrays& strandArrays = scratch.strandArrays;
+            strandArrays.vertexCount = layout.vertexCount;
+            removeDuplicateControlPoints(input.curveArrays, strandArrays, layout.pointOffset);
+            const uint32_t vertexCount = (uint32_t)strandArrays.controlPoints.size();
 
-            const CubicSpline<float3>& splinePoints = splineCache.splinePoints.setup(strandArrays.controlPoints.data(), optimizedStrandArrays.vertexCount);
-            const CubicSpline<float>& splineWidths = splineCache.splineWidths.setup(strandArrays.widths.data(), optimizedStrandArrays.vertexCount);
+            const CubicSpline<float3>& splinePoints = scratch.splineCache.splinePoints.setup(strandArrays.controlPoints.data(), vertexCount);
+            const CubicSpline<float>& splineWidths = scratch.splineCache.splineWidths.setup(strandArrays.widths.data(), vertexCount);
 
+            uint32_t pointIndex = layout.outputOffset;
+            uint32_t segmentIndex = segmentOffset;
             uint32_t tmpCount = 0;
-            for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+            for (uint32_t j = 0; j < vertexCount - 1; j++)
             {
                 for (uint32_t k = 0; k < subdivPerSegment; k++)
                 {
                     if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
                     {
                         float t = (float)k / (float)subdivPerSegment;
-                        result.indices.push_back((uint32_t)result.points.size());
+                        result.indices[segmentIndex++] = pointIndex;
 
                         // Pre-transform curve points.
                         float4 sph = transformSphere(xform, float4(splinePoints.interpolate(j, t), sanitizeWidth(splineWidths.interpolate(j, t) * 0.5f * widthScale)));
 
-                        result.points.push_back(sph.xyz());
-                        result.radius.push_back(sph.w);
+                        result.points[pointIndex] = sph.xyz();
+                        result.radius[pointIndex] = sph.w;
+                        pointIndex++;
                     }
                     tmpCount++;
                 }
             }
 
             // Always keep the last vertex.
-            float4 sph = transformSphere(xform, float4(splinePoints.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f), sanitizeWidth(splineWidths.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f) * 0.5f * widthScale)));
-            result.points.push_back(sph.xyz());
-            result.radius.push_back(sph.w);
+            float4 sph = transformSphere(xform, float4(splinePoints.interpolate(vertexCount - 2, 1.f), sanitizeWidth(splineWidths.interpolate(vertexCount - 2, 1.f) * 0.5f * widthScale)));
+            result.points[pointIndex] = sph.xyz();
+            result.radius[pointIndex] = sph.w;
+            pointIndex++;
+            FALCOR_ASSERT(pointIndex == layout.outputOffset + layout.outputPointCount);
 
             // Texture coordinates.
-            if (UVs)
+            if (input.curveArrays.UVs)
             {
-                const CubicSpline<float2>& splineUVs = splineCache.splineUVs.setup(strandArrays.UVs.data(), optimizedStrandArrays.vertexCount);
+                const CubicSpline<float2>& splineUVs = scratch.splineCache.splineUVs.setup(strandArrays.UVs.data(), vertexCount);
+                uint32_t uvIndex = layout.outputOffset;
                 tmpCount = 0;
-                for (uint32_t j = 0; j < optimizedStrandArrays.vertexCount - 1; j++)
+                for (uint32_t j = 0; j < vertexCount - 1; j++)
                 {
                     for (uint32_t k = 0; k < subdivPerSegment; k++)
                     {
                         if (tmpCount % keepOneEveryXVerticesPerStrand == 0)
                         {
                             float t = (float)k / (float)subdivPerSegment;
-                            result.texCrds.push_back(splineUVs.interpolate(j, t));
+                            result.texCrds[uvIndex++] = splineUVs.interpolate(j, t);
                         }
                         tmpCount++;
                     }
                 }
 
                 // Always keep the last vertex.
-                result.texCrds.push_back(splineUVs.interpolate(optimizedStrandArrays.vertexCount - 2, 1.f));
+                result.texCrds[uvIndex] = splineUVs.interpolate(vertexCount - 2, 1.f);
             }
-
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
         }
 
-        return result;
-    }
-
-    CurveTessellation::MeshResult CurveTessellation::convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection)
-    {
-        MeshResult result;
-        uint32_t vertexCounts = 0;
-        uint32_t faceCounts = 0;
-        uint32_t maxVertexCountsPerStrand = 0;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        /** Tessellate a chunk of strands to linear swept spheres.
+            \param[in,out] pointOffset Control point offset of the first strand in the chunk. On return, the offset of the next chunk.
+            \param[out] result Result for the chunk. Indices are relative to the chunk.
+        */
+        void tessellateSweptSphereChunk(const StrandInput& input, uint32_t firstKept, uint32_t lastKept, const float4x4& xform, uint32_t& pointOffset, std::vector<StrandLayout>& layouts, CurveTessellation::SweptSphereResult& result)
         {
-            uint32_t tmpPointCount = div_round_up(subdivPerSegment * (vertexCountsPerStrand[i] - 1), keepOneEveryXVerticesPerStrand) + 1;
-            vertexCounts += pointCountPerCrossSection * tmpPointCount;
-            faceCounts += 2 * pointCountPerCrossSection * (tmpPointCount - 1);
-            maxVertexCountsPerStrand = std::max(maxVertexCountsPerStrand, vertexCountsPerStrand[i]);
-        }
-        result.vertices.reserve(vertexCounts);
-        result.normals.reserve(vertexCounts);
-        result.tangents.reserve(vertexCounts);
-        result.texCrds.reserve(vertexCounts);
-        result.radii.reserve(vertexCounts);
-        result.faceVertexCounts.reserve(faceCounts);
-        result.faceVertexIndices.reserve(faceCounts * 3);
+            const uint32_t pointCount = computeStrandLayouts(input, firstKept, lastKept, pointOffset, layouts);
+            const uint32_t segmentCount = pointCount - (uint32_t)layouts.size();
 
-        uint32_t pointOffset = 0;
-        uint32_t meshVertexOffset = 0;
+            result.indices.resize(segmentCount);
+            result.points.resize(pointCount);
+            result.radius.resize(pointCount);
+            result.texCrds.resize(input.curveArrays.UVs ? pointCount : 0);
 
-        StrandArrays strandArrays;
-        strandArrays.controlPoints.reserve(maxVertexCountsPerStrand);
-        strandArrays.widths.reserve(maxVertexCountsPerStrand);
-        strandArrays.UVs.reserve(maxVertexCountsPerStrand);
-        CurveArrays curveArrays(controlPoints, widths, UVs);
+            // Each strand has one segment less than points.
+            forEachStrand(layouts.size(), [&](StrandScratch& scratch, size_t s)
+            {
+                tessellateSweptSphereStrand(scratch, input, layouts[s], layouts[s].outputOffset - (uint32_t)s, xform, result);
+            });
+        }
 
-        StrandArrays optimizedStrandArrays;
-        CubicSplineCache splineCache;
-        for (uint32_t i = 0; i < strandCount; i += keepOneEveryXStrands)
+        void tessellatePolytubeStrand(StrandScratch& scratch, const StrandInput& input, const StrandLayout& layout, uint32_t faceOffset, uint32_t pointCountPerCrossSection, CurveTessellation::MeshResult& result)
         {
+            StrandArrays& strandArrays = scratch.strandArrays;
+            StrandArrays& optimizedStrandArrays = scratch.optimizedStrandArrays;
             optimizedStrandArrays.controlPoints.clear();
             optimizedStrandArrays.UVs.clear();
             optimizedStrandArrays.widths.clear();
             optimizedStrandArrays.vertexCount = 0;
+            strandArrays.vertexCount = layout.vertexCount;
 
-            strandArrays.vertexCount = vertexCountsPerStrand[i];
-
-            optimizeStrandGeometry(splineCache, curveArrays, strandArrays, optimizedStrandArrays, pointOffset, subdivPerSegment, keepOneEveryXVerticesPerStrand, widthScale);
+            optimizeStrandGeometry(scratch.splineCache, input.curveArrays, strandArrays, optimizedStrandArrays, layout.pointOffset, input.subdivPerSegment, input.keepOneEveryXVerticesPerStrand, input.widthScale);
+            FALCOR_ASSERT(optimizedStrandArrays.controlPoints.size() == layout.outputPointCount);
 
-            for (uint32_t j = i; j < std::min(strandCount, i + keepOneEveryXStrands); j++) pointOffset += vertexCountsPerStrand[j];
+            const uint32_t meshVertexOffset = layout.outputOffset * pointCountPerCrossSection;
 
             // Build the initial frame.
             float3 fwd, s, t;
@@ -399,21 +462,110 @@ namespace Falcor
                 updateCurveFrame(optimizedStrandArrays, fwd, s, t, j);
 
                 // Mesh vertices, normals, tangents, and texCrds (if any).
-                updateMeshResultBuffers(result, curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, j);
+                updateMeshResultBuffers(result, input.curveArrays, optimizedStrandArrays, fwd, s, t, pointCountPerCrossSection, meshVertexOffset, j);
 
                 // Mesh faces.
                 if (j < optimizedStrandArrays.controlPoints.size() - 1)
                 {
                     uint32_t quadCountLimit = pointCountPerCrossSection;
-                    connectFaceVertices(result, meshVertexOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j);
+                    connectFaceVertices(result, meshVertexOffset, faceOffset, pointCountPerCrossSection, quadCountLimit, 1, 1, j);
                 }
             }
+        }
+
+        /** Tessellate a chunk of strands to a triangular mesh.
+            \param[in,out] pointOffset Control point offset of the first strand in the chunk. On return, the offset of the next chunk.
+            \param[out] result Result for the chunk. Face vertex indices are relative to the chunk.
+        */
+        void tessellatePolytubeChunk(const StrandInput& input, uint32_t firstKept, uint32_t lastKept, uint32_t pointCountPerCrossSection, uint32_t& pointOffset, std::vector<StrandLayout>& layouts, CurveTessellation::MeshResult& result)
+        {
+            const uint32_t pointCount = computeStrandLayouts(input, firstKept, lastKept, pointOffset, layouts);
+            const uint32_t vertexCount = pointCountPerCrossSection * pointCount;
+            const uint32_t faceCount = 2 * pointCountPerCrossSection * (pointCount - (uint32_t)layouts.size());
+
+            result.vertices.resize(vertexCount);
+            result.normals.resize(vertexCount);
+            result.tangents.resize(vertexCount);
+            result.texCrds.resize(input.curveArrays.UVs ? vertexCount : 0);
+            result.radii.resize(vertexCount);
+            result.faceVertexCounts.resize(faceCount);
+            result.faceVertexIndices.resize(faceCount * 3);
+
+            // Each strand has two triangles per cross-section point between consecutive cross-sections.
+            forEachStrand(layouts.size(), [&](StrandScratch& scratch, size_t s)
+            {
+                uint32_t faceOffset = 2 * pointCountPerCrossSection * (layouts[s].outputOffset - (uint32_t)s);
+                tessellatePolytubeStrand(scratch, input, layouts[s], faceOffset, pointCountPerCrossSection, result);
+            });
+        }
+    }
+
+    CurveTessellation::SweptSphereResult CurveTessellation::convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform)
+    {
+        SweptSphereResult result;
+
+        // Only support linear tube segments now.
+        // TODO: Add quadratic or cubic tube segments if necessary.
+        FALCOR_ASSERT(degree == 1);
+        result.degree = degree;
+
+        StrandInput input { strandCount, vertexCountsPerStrand, CurveArrays(controlPoints, widths, UVs), subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand, widthScale };
+        uint32_t pointOffset = 0;
+        std::vector<StrandLayout> layouts;
+        tessellateSweptSphereChunk(input, 0, input.getKeptStrandCount(), xform, pointOffset, layouts, result);
 
-            meshVertexOffset += pointCountPerCrossSection * (uint32_t)optimizedStrandArrays.controlPoints.size();
+        return result;
+    }
+
+    void CurveTessellation::convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform, uint32_t strandsPerChunk, const SweptSphereChunkCallback& callback)
+    {
+        FALCOR_ASSERT(degree == 1);
+        FALCOR_CHECK(strandsPerChunk > 0, "'strandsPerChunk' must be greater than zero.");
+
+        // The chunk result is reused, so its memory is only allocated for the largest chunk.
+        SweptSphereResult chunk;
+        chunk.degree = degree;
+
+        StrandInput input { strandCount, vertexCountsPerStrand, CurveArrays(controlPoints, widths, UVs), subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand, widthScale };
+        const uint32_t keptStrandCount = input.getKeptStrandCount();
+        uint32_t pointOffset = 0;
+        std::vector<StrandLayout> layouts;
+        for (uint32_t firstKept = 0; firstKept < keptStrandCount; firstKept += strandsPerChunk)
+        {
+            uint32_t lastKept = std::min(keptStrandCount, firstKept + strandsPerChunk);
+            tessellateSweptSphereChunk(input, firstKept, lastKept, xform, pointOffset, layouts, chunk);
+            callback(chunk);
         }
+    }
+
+    CurveTessellation::MeshResult CurveTessellation::convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection)
+    {
+        MeshResult result;
+
+        StrandInput input { strandCount, vertexCountsPerStrand, CurveArrays(controlPoints, widths, UVs), subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand, widthScale };
+        uint32_t pointOffset = 0;
+        std::vector<StrandLayout> layouts;
+        tessellatePolytubeChunk(input, 0, input.getKeptStrandCount(), pointCountPerCrossSection, pointOffset, layouts, result);
 
         return result;
     }
 
+    void CurveTessellation::convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection, uint32_t strandsPerChunk, const MeshChunkCallback& callback)
+    {
+        FALCOR_CHECK(strandsPerChunk > 0, "'strandsPerChunk' must be greater than zero.");
 
+        // The chunk result is reused, so its memory is only allocated for the largest chunk.
+        MeshResult chunk;
+
+        StrandInput input { strandCount, vertexCountsPerStrand, CurveArrays(controlPoints, widths, UVs), subdivPerSegment, keepOneEveryXStrands, keepOneEveryXVerticesPerStrand, widthScale };
+        const uint32_t keptStrandCount = input.getKeptStrandCount();
+        uint32_t pointOffset = 0;
+        std::vector<StrandLayout> layouts;
+        for (uint32_t firstKept = 0; firstKept < keptStrandCount; firstKept += strandsPerChunk)
+        {
+            uint32_t lastKept = std::min(keptStrandCount, firstKept + strandsPerChunk);
+            tessellatePolytubeChunk(input, firstKept, lastKept, pointCountPerCrossSection, pointOffset, layouts, chunk);
+            callback(chunk);
+        }
+    }
 }
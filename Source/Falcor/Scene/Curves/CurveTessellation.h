@@ -30,10 +30,20 @@
 #include "Utils/Math/Matrix.h"
 #include "Utils/Math/Vector.h"
 #include "Utils/fast_vector.h"
+#include <functional>
 #include <vector>
 
 namespace Falcor
 {
+    /** Curve tessellation on the CPU.
+
+        Strands are tessellated in parallel. A first pass counts the output of each strand, a prefix sum over the counts
+        gives each strand its output offset, and a second pass fills the preallocated output arrays concurrently.
+        The output is identical to tessellating the strands one by one.
+
+        For large grooms, the streaming variants tessellate a chunk of strands at a time and hand each chunk to a callback,
+        so the output for the whole groom is never held in memory at once.
+    */
     class FALCOR_API CurveTessellation
     {
     public:
@@ -64,6 +74,19 @@ namespace Falcor
         */
         static SweptSphereResult convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform);
 
+        /** Callback receiving a chunk of linear swept sphere segments.
+            The chunk is self-contained (indices are relative to the chunk), so it can be added directly as a curve with SceneBuilder::addCurve().
+            The data is only valid during the callback.
+        */
+        using SweptSphereChunkCallback = std::function<void(const SweptSphereResult& chunk)>;
+
+        /** Convert cubic B-splines to linear swept sphere segments, streaming the result in chunks of strands.
+            The parameters are the same as for convertToLinearSweptSphere() above, with the addition of:
+            \param[in] strandsPerChunk Maximum number of output strands per chunk.
+            \param[in] callback Callback called on the calling thread for each chunk, in strand order.
+        */
+        static void convertToLinearSweptSphere(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t degree, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, const float4x4& xform, uint32_t strandsPerChunk, const SweptSphereChunkCallback& callback);
+
         // Tessellated mesh
 
         struct MeshResult
@@ -92,6 +115,18 @@ namespace Falcor
         */
         static MeshResult convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection);
 
+        /** Callback receiving a chunk of tessellated mesh. Face vertex indices are relative to the chunk.
+            The data is only valid during the callback.
+        */
+        using MeshChunkCallback = std::function<void(const MeshResult& chunk)>;
+
+        /** Tessellate cubic B-splines to a triangular mesh, streaming the result in chunks of strands.
+            The parameters are the same as for convertToPolytube() above, with the addition of:
+            \param[in] strandsPerChunk Maximum number of output strands per chunk.
+            \param[in] callback Callback called on the calling thread for each chunk, in strand order.
+        */
+        static void convertToPolytube(uint32_t strandCount, const uint32_t* vertexCountsPerStrand, const float3* controlPoints, const float* widths, const float2* UVs, uint32_t subdivPerSegment, uint32_t keepOneEveryXStrands, uint32_t keepOneEveryXVerticesPerStrand, float widthScale, uint32_t pointCountPerCrossSection, uint32_t strandsPerChunk, const MeshChunkCallback& callback);
+
 
     private:
         CurveTessellation() = default;
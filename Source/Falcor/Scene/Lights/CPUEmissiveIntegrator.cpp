@@ -0,0 +1,289 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AS IS AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "CPUEmissiveIntegrator.h"
+#include "Core/Error.h"
+#include "Utils/Color/ColorHelpers.slang"
+#include "Utils/Math/MathConstants.slangh"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <cmath>
+#include <execution>
+
+namespace Falcor
+{
+    namespace
+    {
+        // Texel indices are clamped to this range so that out-of-range texture coordinates don't overflow.
+        const double kMaxTexelIndex = double(1ll << 40);
+
+        // The clipping functions below are ports of the helpers in Utils/Geometry/GeometryHelpers.slang.
+        // They must be kept in sync so that the CPU and GPU integrators compute the same texel coverage.
+
+        int classifyPointPlane2D(const float2 p, const uint32_t axis, const float sign, const float c, const float planeThickness = 1e-6f)
+        {
+            float d = sign * (p[axis] - c);
+            if (d > planeThickness) return 1;
+            else if (d < -planeThickness) return -1;
+            else return 0;
+        }
+
+        void clipPolygonPlane2D(float2 p[7], uint32_t& n, const uint32_t axis, const float sign, const float c)
+        {
+            if (n <= 1)
+            {
+                n = 0;
+                return;
+            }
+
+            float2 q[7];
+            uint32_t k = 0;
+            bool fullyOnPlane = true;
+
+            float2 p1 = p[n - 1];
+            int d1 = classifyPointPlane2D(p1, axis, sign, c);
+
+            // Iterate over all polygon edges (p1,p2) in order.
+            for (uint32_t i = 0; i < n; i++)
+            {
+                float2 p2 = p[i];
+                int d2 = classifyPointPlane2D(p2, axis, sign, c);
+
+                if (d2 == 0) // p2 lies on the plane
+                {
+                    if (d1 != 0) q[k++] = p2;
+                }
+                else // p2 is on either side
+                {
+                    fullyOnPlane = false;
+
+                    if (d1 == 0) // p1 lies on the plane
+                    {
+                        if (k == 0 || any(q[k - 1] != p1)) q[k++] = p1;
+                    }
+                    else if (d1 != d2) // p1 and p2 are on opposite sides => clip
+                    {
+                        float alpha = (p2[axis] - c) / (p2[axis] - p1[axis]);
+                        q[k++] = lerp(p2, p1, float2(alpha));
+                    }
+
+                    if (d2 > 0) q[k++] = p2;
+                }
+
+                p1 = p2;
+                d1 = d2;
+            }
+
+            if (fullyOnPlane) return;
+
+            n = k;
+            for (uint32_t i = 0; i < k; i++) p[i] = q[i];
+        }
+
+        float computePolygonArea2D(const float2 p[7], const uint32_t n)
+        {
+            if (n < 3) return 0.f;
+
+            float area = 0.f;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                uint32_t j = i + 1 < n ? i + 1 : 0;
+                area += p[i].x * p[j].y - p[i].y * p[j].x;
+            }
+            return 0.5f * area;
+        }
+
+        /** Apply the texture addressing mode to an integer texel coordinate.
+            \return Texel coordinate in [0,size), or -1 if the border color should be used.
+        */
+        int64_t applyAddressMode(int64_t i, uint32_t size, TextureAddressingMode mode)
+        {
+            const int64_t n = size;
+            switch (mode)
+            {
+            case TextureAddressingMode::Wrap:
+                return ((i % n) + n) % n;
+            case TextureAddressingMode::Mirror:
+            {
+                int64_t m = ((i % (2 * n)) + 2 * n) % (2 * n);
+                return m < n ? m : 2 * n - 1 - m;
+            }
+            case TextureAddressingMode::Clamp:
+                return std::clamp<int64_t>(i, 0, n - 1);
+            case TextureAddressingMode::Border:
+                return i < 0 || i >= n ? -1 : i;
+            case TextureAddressingMode::MirrorOnce:
+                return std::min<int64_t>(i < 0 ? -1 - i : i, n - 1);
+            default:
+                FALCOR_UNREACHABLE();
+                return 0;
+            }
+        }
+
+        float3 fetchTexel(const CPUEmissiveIntegrator::Texture& texture, int64_t x, int64_t y)
+        {
+            x = applyAddressMode(x, texture.width, texture.addressModeU);
+            y = applyAddressMode(y, texture.height, texture.addressModeV);
+            if (x < 0 || y < 0) return texture.borderColor.xyz();
+
+            const float* pTexel = texture.texels.data() + 4 * ((size_t)y * texture.width + (size_t)x);
+            return float3(pTexel[0], pTexel[1], pTexel[2]);
+        }
+
+        /** Fetch the texel at a texture coordinate using nearest filtering.
+        */
+        float3 sampleTexel(const CPUEmissiveIntegrator::Texture& texture, float2 uv)
+        {
+            auto toTexel = [](float u, uint32_t size)
+            {
+                double t = std::floor((double)u * size);
+                return std::isnan(t) ? 0 : (int64_t)std::clamp(t, -kMaxTexelIndex, kMaxTexelIndex);
+            };
+            return fetchTexel(texture, toTexel(uv.x, texture.width), toTexel(uv.y, texture.height));
+        }
+    }
+
+    uint32_t CPUEmissiveIntegrator::addTexture(Texture texture)
+    {
+        FALCOR_CHECK(texture.width > 0 && texture.height > 0, "Emissive texture must not be empty.");
+        FALCOR_CHECK(texture.texels.size() == (size_t)texture.width * texture.height * 4, "Emissive texture texel count does not match its dimensions.");
+        mTextures.push_back(std::move(texture));
+        return (uint32_t)mTextures.size() - 1;
+    }
+
+    uint32_t CPUEmissiveIntegrator::addEmitter(const Emitter& emitter)
+    {
+        FALCOR_CHECK(emitter.textureIndex == kInvalidIndex || emitter.textureIndex < mTextures.size(), "Emitter has invalid texture index {}.", emitter.textureIndex);
+        mEmitters.push_back(emitter);
+        return (uint32_t)mEmitters.size() - 1;
+    }
+
+    std::vector<CPUEmissiveIntegrator::Result> CPUEmissiveIntegrator::integrate(fstd::span<const Triangle> triangles) const
+    {
+        for (const auto& triangle : triangles)
+        {
+            FALCOR_CHECK(triangle.emitterIndex < mEmitters.size(), "Triangle has invalid emitter index {}.", triangle.emitterIndex);
+        }
+
+        std::vector<Result> results(triangles.size());
+        auto range = NumericRange<size_t>(0, triangles.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i)
+        {
+            results[i] = integrateTriangle(triangles[i]);
+        });
+        return results;
+    }
+
+    CPUEmissiveIntegrator::Result CPUEmissiveIntegrator::integrateTriangle(const Triangle& triangle) const
+    {
+        FALCOR_ASSERT(triangle.emitterIndex < mEmitters.size());
+        const Emitter& emitter = mEmitters[triangle.emitterIndex];
+
+        float3 averageEmissiveColor = emitter.emissive;
+        if (emitter.textureIndex != kInvalidIndex)
+        {
+            averageEmissiveColor = computeAverageTexel(mTextures[emitter.textureIndex], triangle);
+        }
+        float3 averageRadiance = averageEmissiveColor * emitter.emissiveFactor;
+
+        // We assume diffuse emitters and integrate per side (hemisphere) => the scale factor is pi.
+        Result result;
+        result.flux = luminance(averageRadiance) * triangle.area * (float)M_PI;
+        result.averageRadiance = averageRadiance;
+        return result;
+    }
+
+    float3 CPUEmissiveIntegrator::computeAverageTexel(const Texture& texture, const Triangle& triangle) const
+    {
+        const float2* uv = triangle.texCoords;
+        const float2 uvMin = min(min(uv[0], uv[1]), uv[2]);
+        const float2 uvMax = max(max(uv[0], uv[1]), uv[2]);
+
+        double texelSum[3] = {};
+        double weight = 0.0;
+
+        if (all(isfinite(uvMin)) && all(isfinite(uvMax)))
+        {
+            // Place the triangle in texture space with one unit per texel, offset so that the positions are positive.
+            // This is the same transform as the GPU integrator, so the texel grid and the clipping agree.
+            const float2 uvOffset = floor(uvMin);
+            const float2 dims = float2(texture.width, texture.height);
+            const float2 pos[3] = { (uv[0] - uvOffset) * dims, (uv[1] - uvOffset) * dims, (uv[2] - uvOffset) * dims };
+            const int64_t texelOffsetX = (int64_t)std::clamp((double)uvOffset.x * texture.width, -kMaxTexelIndex, kMaxTexelIndex);
+            const int64_t texelOffsetY = (int64_t)std::clamp((double)uvOffset.y * texture.height, -kMaxTexelIndex, kMaxTexelIndex);
+
+            const float2 posMin = min(min(pos[0], pos[1]), pos[2]);
+            const float2 posMax = max(max(pos[0], pos[1]), pos[2]);
+
+            // Iterate over the rows of texels. The triangle is first clipped to the row, which gives the
+            // range of texels to visit, and then the row polygon is clipped to each texel in the range.
+            // This computes the same coverage as clipping the triangle to each texel directly.
+            for (int64_t y = (int64_t)std::floor(posMin.y); y < (int64_t)std::ceil(posMax.y); y++)
+            {
+                float2 row[7] = { pos[0], pos[1], pos[2] };
+                uint32_t rowCount = 3;
+                clipPolygonPlane2D(row, rowCount, 1, +1.f, (float)y);
+                clipPolygonPlane2D(row, rowCount, 1, -1.f, (float)(y + 1));
+                if (rowCount < 3) continue;
+
+                float rowMin = row[0].x, rowMax = row[0].x;
+                for (uint32_t i = 1; i < rowCount; i++)
+                {
+                    rowMin = std::min(rowMin, row[i].x);
+                    rowMax = std::max(rowMax, row[i].x);
+                }
+
+                for (int64_t x = (int64_t)std::floor(rowMin); x < (int64_t)std::ceil(rowMax); x++)
+                {
+                    float2 p[7];
+                    std::copy(row, row + rowCount, p);
+                    uint32_t n = rowCount;
+                    clipPolygonPlane2D(p, n, 0, +1.f, (float)x);
+                    clipPolygonPlane2D(p, n, 0, -1.f, (float)(x + 1));
+
+                    float w = std::min(std::abs(computePolygonArea2D(p, n)), 1.f); // The area may be negative due to winding.
+                    if (w <= 0.f) continue;
+
+                    float3 color = fetchTexel(texture, texelOffsetX + x, texelOffsetY + y);
+                    for (uint32_t c = 0; c < 3; c++) texelSum[c] += (double)color[c] * w;
+                    weight += w;
+                }
+            }
+        }
+
+        // If the coverage is zero, the triangle is degenerate in texture space (line or point).
+        // In that case, the emission is approximated as the average emission sampled at the three vertices.
+        if (weight > 0.0)
+        {
+            return float3(float(texelSum[0] / weight), float(texelSum[1] / weight), float(texelSum[2] / weight));
+        }
+
+        float3 averageColor = float3(0.f);
+        for (uint32_t i = 0; i < 3; i++) averageColor += sampleTexel(texture, uv[i]);
+        return averageColor / 3.f;
+    }
+}
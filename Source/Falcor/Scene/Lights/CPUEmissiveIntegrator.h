@@ -0,0 +1,127 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AS IS AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Core/API/Sampler.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** CPU implementation of the emissive integrator used by LightCollection.
+
+        Computes the average radiance and flux of emissive triangles with constant or textured emission.
+        The results match the GPU integrator (EmissiveIntegrator.3d.slang and FinalizeIntegration.cs.slang)
+        up to floating-point rounding: each triangle is rasterized in texture space at mip 0, the coverage
+        of every touched texel is computed analytically by clipping the triangle to the texel, and the
+        coverage-weighted average of the nearest-filtered texels is taken as the average emissive color.
+        Triangles that are degenerate in texture space use the average of the texels at the three vertices.
+
+        The integrator does not require a GPU device. The emissive textures are passed in as linear RGBA
+        float texels, typically converted from the decoded image files. Triangles are integrated in parallel.
+    */
+    class FALCOR_API CPUEmissiveIntegrator
+    {
+    public:
+        static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+        /** Emissive texture. Only mip 0 is used.
+        */
+        struct Texture
+        {
+            uint32_t width = 0;                                             ///< Width in texels.
+            uint32_t height = 0;                                            ///< Height in texels.
+            std::vector<float> texels;                                      ///< Linear RGBA texels (width * height * 4 floats), rows tightly packed.
+            TextureAddressingMode addressModeU = TextureAddressingMode::Wrap; ///< Addressing mode in U. Should match the material sampler.
+            TextureAddressingMode addressModeV = TextureAddressingMode::Wrap; ///< Addressing mode in V. Should match the material sampler.
+            float4 borderColor = float4(0.f);                               ///< Border color for TextureAddressingMode::Border.
+        };
+
+        /** Emissive material.
+        */
+        struct Emitter
+        {
+            float3 emissive = float3(0.f);          ///< Constant emissive color. Ignored if the emitter is textured.
+            float emissiveFactor = 1.f;             ///< Multiplication factor for the emissive color.
+            uint32_t textureIndex = kInvalidIndex;  ///< Index of the emissive texture, or kInvalidIndex if not textured.
+        };
+
+        /** Emissive triangle.
+        */
+        struct Triangle
+        {
+            float2 texCoords[3];                    ///< Texture coordinates of the vertices.
+            float area = 0.f;                       ///< Area in world space units.
+            uint32_t emitterIndex = 0;              ///< Index of the emitter.
+        };
+
+        /** Integration result for one triangle. The layout matches EmissiveFlux.
+        */
+        struct Result
+        {
+            float flux = 0.f;                       ///< Flux emitted by the triangle (one-sided).
+            float3 averageRadiance = float3(0.f);   ///< Average radiance emitted over the triangle.
+        };
+
+        /** Add an emissive texture.
+            \param[in] texture Texture. The texel count must match the dimensions.
+            \return Texture index.
+        */
+        uint32_t addTexture(Texture texture);
+
+        /** Add an emitter.
+            \param[in] emitter Emitter. The texture index must be valid or kInvalidIndex.
+            \return Emitter index.
+        */
+        uint32_t addEmitter(const Emitter& emitter);
+
+        /** Get the number of emitters.
+        */
+        uint32_t getEmitterCount() const { return (uint32_t)mEmitters.size(); }
+
+        /** Integrate a list of triangles in parallel.
+            \param[in] triangles Triangles. The emitter indices must be valid.
+            \return Per-triangle results.
+        */
+        std::vector<Result> integrate(fstd::span<const Triangle> triangles) const;
+
+        /** Integrate a single triangle.
+            \param[in] triangle Triangle. The emitter index must be valid.
+            \return Result.
+        */
+        Result integrateTriangle(const Triangle& triangle) const;
+
+    private:
+        float3 computeAverageTexel(const Texture& texture, const Triangle& triangle) const;
+
+        std::vector<Texture> mTextures;
+        std::vector<Emitter> mEmitters;
+    };
+}
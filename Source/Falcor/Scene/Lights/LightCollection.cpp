@@ -50,7 +50,7 @@ namespace Falcor
         const char kFinalizeIntegrationFile[] = "Scene/Lights/FinalizeIntegration.cs.slang";
     }
 
-    LightCollection::LightCollection(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene)
+    LightCollection::LightCollection(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene, Options options)
         : mpDevice(pDevice)
         , mpScene(pScene)
     {
@@ -59,10 +59,6 @@ namespace Falcor
         // Setup the lights.
         setupMeshLights(*mpScene);
 
-        // Create program for integrating emissive textures.
-        // This should be done after lights are setup, so that we know which sampler state etc. to use.
-        initIntegrator(pRenderContext, *mpScene);
-
         // Create programs for building/updating the mesh lights.
         DefineList defines = mpScene->getSceneDefines();
         mpTriangleListBuilder = ComputePass::create(mpDevice, kBuildTriangleListFile, "buildTriangleList", defines);
@@ -72,7 +68,7 @@ namespace Falcor
         mpStagingFence = mpDevice->createFence();
 
         // Now build the mesh light data.
-        build(pRenderContext, *mpScene);
+        build(pRenderContext, *mpScene, std::move(options.meshLightTriangles));
     }
 
     bool LightCollection::update(RenderContext* pRenderContext, UpdateStatus* pUpdateStatus)
@@ -216,7 +212,7 @@ namespace Falcor
         }
     }
 
-    void LightCollection::build(RenderContext* pRenderContext, const Scene& scene)
+    void LightCollection::build(RenderContext* pRenderContext, const Scene& scene, std::vector<MeshLightTriangle> preintegratedTriangles)
     {
         prepareMeshData(scene);
 
@@ -235,18 +231,25 @@ namespace Falcor
             TimeReport timeReport;
 
             // Prepare GPU buffers.
-            prepareTriangleData(pRenderContext, scene);
+            prepareTriangleData();
             timeReport.measure("LightCollection::build preparation");
 
-            // Pre-integrate emissive triangles.
+            // Use the triangles pre-integrated on the CPU if available. These are already synced to the CPU, so no readback is needed.
+            // Otherwise compute triangle data (vertices, uv-coordinates, materialID) and pre-integrate the triangles on the GPU.
             // TODO: We might want to redo this in update() for animated meshes or after scale changes as that affects the flux.
-            integrateEmissive(pRenderContext, scene);
+            mIntegratedOnCPU = uploadPreintegratedTriangles(preintegratedTriangles);
+            if (!mIntegratedOnCPU)
+            {
+                buildTriangleList(pRenderContext, scene);
+                integrateEmissive(pRenderContext, scene);
+
+                mCPUInvalidData = CPUOutOfDateFlags::All;
+                mStagingBufferValid = false;
+            }
 
             timeReport.measure("LightCollection::build integrate emissive");
 
             // Build list of active triangles.
-            mCPUInvalidData = CPUOutOfDateFlags::All;
-            mStagingBufferValid = false;
             mStatsValid = false;
 
             prepareSyncCPUData(pRenderContext);
@@ -257,7 +260,7 @@ namespace Falcor
         }
     }
 
-    void LightCollection::prepareTriangleData(RenderContext* pRenderContext, const Scene& scene)
+    void LightCollection::prepareTriangleData()
     {
         FALCOR_ASSERT(mTriangleCount > 0);
 
@@ -269,9 +272,69 @@ namespace Falcor
         mpFluxData = mpDevice->createStructuredBuffer(mpFinalizeIntegration->getRootVar()["gFluxData"], mTriangleCount, ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal, nullptr, false);
         mpFluxData->setName("LightCollection::mpFluxData");
         if (mpFluxData->getStructSize() != sizeof(EmissiveFlux)) FALCOR_THROW("Struct EmissiveFlux size mismatch between CPU/GPU");
+    }
+
+    bool LightCollection::uploadPreintegratedTriangles(std::vector<MeshLightTriangle>& triangles)
+    {
+        if (triangles.empty()) return false;
+
+        FALCOR_ASSERT(mpTriangleData && mpFluxData);
+        if (triangles.size() != mTriangleCount)
+        {
+            logWarning("LightCollection: Got {} pre-integrated triangles but the scene has {} emissive triangles. Using GPU integrator.", triangles.size(), mTriangleCount);
+            return false;
+        }
+        for (uint32_t lightIdx = 0; lightIdx < mMeshLights.size(); lightIdx++)
+        {
+            const auto& meshLight = mMeshLights[lightIdx];
+            for (uint32_t i = 0; i < meshLight.triangleCount; i++)
+            {
+                if (triangles[meshLight.triangleOffset + i].lightIdx != lightIdx)
+                {
+                    logWarning("LightCollection: Pre-integrated triangles don't match the scene's mesh lights. Using GPU integrator.");
+                    return false;
+                }
+            }
+        }
+
+        // Pack the triangles for the GPU. The CPU copy is taken from the packed data so it matches what a readback would return.
+        std::vector<PackedEmissiveTriangle> triangleData(mTriangleCount);
+        std::vector<EmissiveFlux> fluxData(mTriangleCount);
+        for (uint32_t triIdx = 0; triIdx < mTriangleCount; triIdx++)
+        {
+            auto& meshLightTri = triangles[triIdx];
 
-        // Compute triangle data (vertices, uv-coordinates, materialID) for all mesh lights.
-        buildTriangleList(pRenderContext, scene);
+            EmissiveTriangle tri;
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                tri.posW[j] = meshLightTri.vtx[j].pos;
+                tri.texCoords[j] = meshLightTri.vtx[j].uv;
+            }
+            tri.normal = meshLightTri.normal;
+            tri.area = meshLightTri.area;
+            tri.materialID = mMeshLights[meshLightTri.lightIdx].materialID;
+            tri.lightIdx = meshLightTri.lightIdx;
+            triangleData[triIdx].pack(tri);
+
+            tri = triangleData[triIdx].unpack();
+            meshLightTri.normal = tri.normal;
+            meshLightTri.area = tri.area;
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                meshLightTri.vtx[j].pos = tri.posW[j];
+                meshLightTri.vtx[j].uv = tri.texCoords[j];
+            }
+
+            fluxData[triIdx].flux = meshLightTri.flux;
+            fluxData[triIdx].averageRadiance = meshLightTri.averageRadiance;
+        }
+        mpTriangleData->setBlob(triangleData.data(), 0, triangleData.size() * sizeof(triangleData[0]));
+        mpFluxData->setBlob(fluxData.data(), 0, fluxData.size() * sizeof(fluxData[0]));
+
+        mMeshLightTriangles = std::move(triangles);
+        mCPUInvalidData = CPUOutOfDateFlags::None;
+        mStagingBufferValid = true;
+        return true;
     }
 
     void LightCollection::prepareMeshData(const Scene& scene)
@@ -316,6 +379,10 @@ namespace Falcor
         FALCOR_ASSERT(mTriangleCount > 0);
         FALCOR_ASSERT(mMeshLights.size() > 0);
 
+        // Create program for integrating emissive textures on first use.
+        // This is done after lights are setup, so that we know which sampler state etc. to use.
+        if (!mIntegrator.pProgram) initIntegrator(pRenderContext, scene);
+
         // Prepare program vars.
         {
             mIntegrator.pVars = ProgramVars::create(mpDevice, mIntegrator.pProgram.get());
@@ -610,12 +677,12 @@ namespace Falcor
         if (mStagingBufferValid) return;
 
         // Allocate staging buffer for readback. The data from our different GPU buffers is stored consecutively.
+        // Only the parts flagged in mCPUInvalidData are copied and read back, so reallocating doesn't invalidate the CPU data.
         const size_t stagingSize = mpTriangleData->getSize() + mpFluxData->getSize();
         if (!mpStagingBuffer || mpStagingBuffer->getSize() < stagingSize)
         {
             mpStagingBuffer = mpDevice->createBuffer(stagingSize, ResourceBindFlags::None, MemoryType::ReadBack);
             mpStagingBuffer->setName("LightCollection::mpStagingBuffer");
-            mCPUInvalidData = CPUOutOfDateFlags::All;
         }
 
         // Schedule the copy operations for data that is invalid.
@@ -114,19 +114,32 @@ namespace Falcor
             }
         };
 
+        /** Light collection options.
+        */
+        struct Options
+        {
+            /** Emissive triangles pre-integrated on the CPU (see SceneBuilder::Flags::UseCPUEmissiveIntegration).
+                They are uploaded as is, so neither the GPU integrator nor a readback of the triangle data is needed.
+                The triangles must be ordered and indexed like the scene's mesh lights, otherwise they are ignored.
+                If empty, the triangles are built and integrated on the GPU.
+            */
+            std::vector<MeshLightTriangle> meshLightTriangles;
+        };
+
         /** Creates a light collection for the given scene.
             Note that update() must be called before the collection is ready to use.
             \param[in] pDevice GPU device.
             \param[in] pRenderContext The render context.
             \param[in] pScene The scene.
+            \param[in] options Options.
             \return A pointer to a new light collection object, or throws an exception if creation failed.
         */
-        static ref<LightCollection> create(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene)
+        static ref<LightCollection> create(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene, Options options = Options())
         {
-            return make_ref<LightCollection>(pDevice, pRenderContext, pScene);
+            return make_ref<LightCollection>(pDevice, pRenderContext, pScene, std::move(options));
         }
 
-        LightCollection(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene);
+        LightCollection(ref<Device> pDevice, RenderContext* pRenderContext, Scene* pScene, Options options = Options());
         ~LightCollection() = default;
 
         /** Updates the light collection to the current state of the scene.
@@ -159,6 +172,10 @@ namespace Falcor
         */
         const std::vector<MeshLightTriangle>& getMeshLightTriangles(RenderContext* pRenderContext) const { syncCPUData(pRenderContext); return mMeshLightTriangles; }
 
+        /** Returns true if the emissive triangles were pre-integrated on the CPU and passed in with the options.
+        */
+        bool isIntegratedOnCPU() const { return mIntegratedOnCPU; }
+
         /** Returns a CPU buffer with all mesh lights.
             Note that update() must have been called before for the data to be valid.
         */
@@ -188,8 +205,9 @@ namespace Falcor
     protected:
         void initIntegrator(RenderContext* pRenderContext, const Scene& scene);
         void setupMeshLights(const Scene& scene);
-        void build(RenderContext* pRenderContext, const Scene& scene);
-        void prepareTriangleData(RenderContext* pRenderContext, const Scene& scene);
+        void build(RenderContext* pRenderContext, const Scene& scene, std::vector<MeshLightTriangle> preintegratedTriangles);
+        void prepareTriangleData();
+        bool uploadPreintegratedTriangles(std::vector<MeshLightTriangle>& triangles);
         void prepareMeshData(const Scene& scene);
         void integrateEmissive(RenderContext* pRenderContext, const Scene& scene);
         void computeStats(RenderContext* pRenderContext) const;
@@ -203,6 +221,7 @@ namespace Falcor
         // Internal state
         ref<Device>                             mpDevice;
         Scene*                                  mpScene;                ///< Unowning pointer to scene (scene owns LightCollection).
+        bool                                    mIntegratedOnCPU = false; ///< True if the emissive triangles were pre-integrated on the CPU.
 
         std::vector<MeshLightData>              mMeshLights;            ///< List of all mesh lights.
         uint32_t                                mTriangleCount = 0;     ///< Total number of triangles in all mesh lights (= mMeshLightTriangles.size()). This may include culled triangles.
@@ -28,6 +28,7 @@
 #include "MaterialSystem.h"
 #include "StandardMaterial.h"
 #include "Core/API/Device.h"
+#include "Core/API/ReadbackService.h"
 #include "Utils/Logger.h"
 #include "Utils/StringUtils.h"
 #include "MaterialTypeRegistry.h"
@@ -65,7 +66,6 @@ namespace Falcor
     {
         FALCOR_ASSERT(kMaxSamplerCount <= mpDevice->getLimits().maxShaderVisibleSamplers);
 
-        mpFence = mpDevice->createFence();
         mpTextureManager = std::make_unique<TextureManager>(mpDevice, kMaxTextureCount);
 
         // Create a default texture sampler.
@@ -372,35 +372,54 @@ namespace Falcor
 
         if (textures.empty()) return;
 
-        // Analyze the textures.
-        logInfo("Analyzing {} material textures.", textures.size());
+        // Use the CPU analysis done by the texture manager while decoding, and analyze the remaining textures on the GPU.
+        std::vector<TextureAnalyzer::Result> results(textures.size());
+        std::vector<size_t> gpuIndices;
+        std::vector<ref<Texture>> gpuTextures;
+        for (size_t i = 0; i < textures.size(); i++)
+        {
+            if (auto analysis = mpTextureManager->getTextureAnalysis(textures[i].get()))
+            {
+                results[i] = *analysis;
+            }
+            else
+            {
+                gpuIndices.push_back(i);
+                gpuTextures.push_back(textures[i]);
+            }
+        }
 
-        RenderContext* pRenderContext = mpDevice->getRenderContext();
+        logInfo("Analyzing {} material textures ({} analyzed on the CPU during loading).", textures.size(), textures.size() - gpuTextures.size());
 
-        TextureAnalyzer analyzer(mpDevice);
-        auto pResults = mpDevice->createBuffer(textures.size() * TextureAnalyzer::getResultSize(), ResourceBindFlags::UnorderedAccess);
-        analyzer.analyze(pRenderContext, textures, pResults);
+        if (!gpuTextures.empty())
+        {
+            RenderContext* pRenderContext = mpDevice->getRenderContext();
 
-        // Copy result to staging buffer for readback.
-        // This is mostly to avoid a full flush and the associated perf warning.
-        // We do not have any other useful GPU work, but unrelated GPU tasks can be in flight.
-        auto pResultsStaging = mpDevice->createBuffer(textures.size() * TextureAnalyzer::getResultSize(), ResourceBindFlags::None, MemoryType::ReadBack);
-        pRenderContext->copyResource(pResultsStaging.get(), pResults.get());
-        pRenderContext->submit(false);
-        pRenderContext->signal(mpFence.get());
+            TextureAnalyzer analyzer(mpDevice);
+            auto pResults = mpDevice->createBuffer(gpuTextures.size() * TextureAnalyzer::getResultSize(), ResourceBindFlags::UnorderedAccess);
+            analyzer.analyze(pRenderContext, gpuTextures, pResults);
 
-        // Wait for results to become available. Then optimize the materials.
-        mpFence->wait();
-        const TextureAnalyzer::Result* results = static_cast<const TextureAnalyzer::Result*>(pResultsStaging->map());
-        Material::TextureOptimizationStats stats = {};
+            // Read back the results. The optimization needs them right away, so we wait for the readback to complete.
+            // Going through the readback service avoids a full flush, unrelated GPU tasks can still be in flight.
+            ReadbackService* pReadbackService = mpDevice->getReadbackService();
+            auto ticket = pReadbackService->readBuffer(pRenderContext, pResults.get(), 0, 0,
+                [&](const void* pData, size_t size) {
+                    const TextureAnalyzer::Result* gpuResults = static_cast<const TextureAnalyzer::Result*>(pData);
+                    for (size_t i = 0; i < gpuIndices.size(); i++)
+                    {
+                        results[gpuIndices[i]] = gpuResults[i];
+                    }
+                });
+            pReadbackService->wait(ticket);
+        }
 
+        // Optimize the materials.
+        Material::TextureOptimizationStats stats = {};
         for (size_t i = 0; i < textures.size(); i++)
         {
             materialSlots[i].first->optimizeTexture(materialSlots[i].second, results[i], stats);
         }
 
-        pResultsStaging->unmap();
-
         // Log optimization stats.
         if (size_t totalRemoved = std::accumulate(stats.texturesRemoved.begin(), stats.texturesRemoved.end(), 0ull); totalRemoved > 0)
         {
@@ -281,7 +281,6 @@ namespace Falcor
         Material::UpdateFlags mMaterialUpdates = Material::UpdateFlags::None; ///< Material updates across all materials since last update.
 
         // GPU resources
-        ref<Fence> mpFence;
         ref<ParameterBlock> mpMaterialsBlock;                       ///< Parameter block for binding all material resources.
         ref<Buffer> mpMaterialDataBuffer;                           ///< GPU buffer holding all material data.
         ref<Sampler> mpDefaultTextureSampler;                       ///< Default texture sampler to use for all materials.
@@ -30,8 +30,9 @@
 
 namespace Falcor
 {
-    MaterialTextureLoader::MaterialTextureLoader(TextureManager& textureManager, bool useSrgb)
+    MaterialTextureLoader::MaterialTextureLoader(TextureManager& textureManager, bool useSrgb, bool keepEmissiveTexels)
         : mUseSrgb(useSrgb)
+        , mKeepEmissiveTexels(keepEmissiveTexels)
         , mTextureManager(textureManager)
     {
     }
@@ -51,9 +52,10 @@ namespace Falcor
         }
 
         bool srgb = mUseSrgb && pMaterial->getTextureSlotInfo(slot).srgb;
+        bool keepTexels = mKeepEmissiveTexels && slot == Material::TextureSlot::Emissive;
 
         // Request texture to be loaded.
-        auto handle = mTextureManager.loadTexture(path, true, srgb);
+        auto handle = mTextureManager.loadTexture(path, true, srgb, ResourceBindFlags::ShaderResource, true, nullptr, nullptr, keepTexels);
 
         // Store assignment to material for later.
         mTextureAssignments.emplace_back(TextureAssignment{ pMaterial, slot, handle });
@@ -45,7 +45,12 @@ namespace Falcor
     class MaterialTextureLoader
     {
     public:
-        MaterialTextureLoader(TextureManager& textureManager, bool useSrgb);
+        /** Constructor.
+            \param[in] textureManager Texture manager to load textures with.
+            \param[in] useSrgb Load textures in slots that hold color data as sRGB.
+            \param[in] keepEmissiveTexels Keep the texels of emissive textures on the CPU (see TextureManager::takeTextureTexels()).
+        */
+        MaterialTextureLoader(TextureManager& textureManager, bool useSrgb, bool keepEmissiveTexels = false);
         ~MaterialTextureLoader();
 
         /** Request loading a material texture.
@@ -66,6 +71,7 @@ namespace Falcor
         };
 
         bool mUseSrgb;
+        bool mKeepEmissiveTexels;
         std::vector<TextureAssignment> mTextureAssignments;
         TextureManager& mTextureManager;
     };
@@ -0,0 +1,280 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "MeshGroupPartitioner.h"
+#include "Core/Error.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <limits>
+
+namespace Falcor
+{
+    namespace
+    {
+        // Number of bins per axis for the binned SAH evaluation.
+        const size_t kBinCount = 32;
+
+        // Weight of the overlap term relative to the SAH term.
+        const double kOverlapWeight = 1.0;
+
+        // Minimum fraction of triangles on the smaller side of a split. Splits that are more unbalanced
+        // are only considered if no other split exists. This bounds the depth of the hierarchy.
+        const double kMinSplitFraction = 0.1;
+
+        struct Node
+        {
+            std::vector<uint32_t> items;
+            uint64_t triangleCount = 0;
+            uint32_t children[2] = { 0, 0 }; ///< Child node indices. Both are zero for leaf nodes.
+        };
+
+        struct Bin
+        {
+            AABB bounds;
+            uint64_t triangleCount = 0;
+            size_t itemCount = 0;
+        };
+
+        double overlapArea(const AABB& a, const AABB& b)
+        {
+            AABB overlap = a & b;
+            return overlap.valid() ? overlap.area() : 0.0;
+        }
+
+        /** Split a node at the best binned SAH split plane.
+            \param[in] items All items.
+            \param[in] node Node to split. Must hold at least two items.
+            \param[out] left Items on the left side.
+            \param[out] right Items on the right side.
+        */
+        void splitNode(const std::vector<MeshGroupPartitioner::Item>& items, const Node& node, Node& left, Node& right)
+        {
+            FALCOR_ASSERT(node.items.size() > 1);
+
+            AABB centroidBounds;
+            for (uint32_t i : node.items) centroidBounds.include(items[i].bounds.center());
+            const float3 extent = centroidBounds.extent();
+
+            double bestCost = std::numeric_limits<double>::infinity();
+            bool bestBalanced = false;
+            int bestAxis = -1;
+            size_t bestPlane = 0;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (extent[axis] <= 0.f) continue;
+                const float scale = kBinCount / extent[axis];
+
+                std::array<Bin, kBinCount> bins;
+                for (uint32_t i : node.items)
+                {
+                    const auto& item = items[i];
+                    size_t b = std::min(size_t((item.bounds.center()[axis] - centroidBounds.minPoint[axis]) * scale), kBinCount - 1);
+                    bins[b].bounds.include(item.bounds);
+                    bins[b].triangleCount += item.triangleCount;
+                    bins[b].itemCount++;
+                }
+
+                // Sweep from the right to compute the bounds of all suffixes.
+                std::array<Bin, kBinCount> suffix;
+                suffix[kBinCount - 1] = bins[kBinCount - 1];
+                for (size_t b = kBinCount - 1; b > 0; b--)
+                {
+                    suffix[b - 1] = suffix[b];
+                    suffix[b - 1].bounds.include(bins[b - 1].bounds);
+                    suffix[b - 1].triangleCount += bins[b - 1].triangleCount;
+                    suffix[b - 1].itemCount += bins[b - 1].itemCount;
+                }
+
+                // Sweep from the left and evaluate the split cost at each bin boundary.
+                Bin prefix;
+                for (size_t plane = 1; plane < kBinCount; plane++)
+                {
+                    prefix.bounds.include(bins[plane - 1].bounds);
+                    prefix.triangleCount += bins[plane - 1].triangleCount;
+                    prefix.itemCount += bins[plane - 1].itemCount;
+
+                    const Bin& rest = suffix[plane];
+                    if (prefix.itemCount == 0 || rest.itemCount == 0) continue;
+
+                    double cost = double(prefix.bounds.area()) * prefix.triangleCount + double(rest.bounds.area()) * rest.triangleCount;
+                    cost += kOverlapWeight * overlapArea(prefix.bounds, rest.bounds) * node.triangleCount;
+
+                    // Prefer balanced splits over cost.
+                    bool balanced = std::min(prefix.triangleCount, rest.triangleCount) >= kMinSplitFraction * node.triangleCount;
+                    if ((balanced && !bestBalanced) || (balanced == bestBalanced && cost < bestCost))
+                    {
+                        bestCost = cost;
+                        bestBalanced = balanced;
+                        bestAxis = axis;
+                        bestPlane = plane;
+                    }
+                }
+            }
+
+            left.items.clear();
+            right.items.clear();
+            left.triangleCount = right.triangleCount = 0;
+
+            if (bestAxis >= 0)
+            {
+                const float scale = kBinCount / extent[bestAxis];
+                for (uint32_t i : node.items)
+                {
+                    const auto& item = items[i];
+                    size_t b = std::min(size_t((item.bounds.center()[bestAxis] - centroidBounds.minPoint[bestAxis]) * scale), kBinCount - 1);
+                    Node& side = b < bestPlane ? left : right;
+                    side.items.push_back(i);
+                    side.triangleCount += item.triangleCount;
+                }
+            }
+            else
+            {
+                // All centroids coincide. Fall back on splitting at the median in terms of triangle count.
+                for (uint32_t i : node.items)
+                {
+                    Node& side = (left.triangleCount < node.triangleCount / 2 || left.items.empty()) ? left : right;
+                    side.items.push_back(i);
+                    side.triangleCount += items[i].triangleCount;
+                }
+                if (right.items.empty())
+                {
+                    right.items.push_back(left.items.back());
+                    right.triangleCount = items[left.items.back()].triangleCount;
+                    left.items.pop_back();
+                    left.triangleCount -= right.triangleCount;
+                }
+            }
+
+            FALCOR_ASSERT(!left.items.empty() && !right.items.empty());
+        }
+    }
+
+    std::vector<MeshGroupPartitioner::Group> MeshGroupPartitioner::partition(const std::vector<Item>& items, uint64_t maxTrianglesPerGroup)
+    {
+        if (items.empty()) return {};
+        FALCOR_CHECK(maxTrianglesPerGroup > 0, "'maxTrianglesPerGroup' must be larger than zero.");
+
+        std::vector<Node> nodes(1);
+        Node& root = nodes[0];
+        root.items.resize(items.size());
+        for (uint32_t i = 0; i < (uint32_t)items.size(); i++)
+        {
+            root.items[i] = i;
+            root.triangleCount += items[i].triangleCount;
+        }
+
+        // Build the hierarchy level by level. All nodes on a level are split in parallel.
+        std::vector<uint32_t> level = { 0 };
+        while (!level.empty())
+        {
+            std::vector<Node> children(2 * level.size());
+            std::vector<char> isSplit(level.size(), 0);
+
+            auto range = NumericRange<size_t>(0, level.size());
+            std::for_each(
+                std::execution::par,
+                range.begin(),
+                range.end(),
+                [&](size_t i)
+                {
+                    const Node& node = nodes[level[i]];
+                    if (node.triangleCount <= maxTrianglesPerGroup || node.items.size() <= 1) return;
+                    splitNode(items, node, children[2 * i], children[2 * i + 1]);
+                    isSplit[i] = 1;
+                }
+            );
+
+            std::vector<uint32_t> nextLevel;
+            for (size_t i = 0; i < level.size(); i++)
+            {
+                if (!isSplit[i]) continue;
+                for (uint32_t c = 0; c < 2; c++)
+                {
+                    uint32_t childIndex = (uint32_t)nodes.size();
+                    nodes[level[i]].children[c] = childIndex;
+                    nodes.push_back(std::move(children[2 * i + c]));
+                    nextLevel.push_back(childIndex);
+                }
+                nodes[level[i]].items.clear();
+                nodes[level[i]].items.shrink_to_fit();
+            }
+            level = std::move(nextLevel);
+        }
+
+        // Output the leaves in depth-first order.
+        std::vector<Group> groups;
+        std::vector<uint32_t> stack = { 0 };
+        while (!stack.empty())
+        {
+            Node& node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (node.children[0] == 0)
+            {
+                FALCOR_ASSERT(!node.items.empty());
+                groups.push_back(std::move(node.items));
+            }
+            else
+            {
+                stack.push_back(node.children[1]);
+                stack.push_back(node.children[0]);
+            }
+        }
+
+        return groups;
+    }
+
+    double MeshGroupPartitioner::computeCost(const std::vector<Item>& items, const std::vector<Group>& groups)
+    {
+        std::vector<AABB> groupBounds(groups.size());
+        std::vector<uint64_t> groupTriangleCounts(groups.size(), 0);
+        double cost = 0.0;
+
+        for (size_t g = 0; g < groups.size(); g++)
+        {
+            for (uint32_t i : groups[g])
+            {
+                groupBounds[g].include(items[i].bounds);
+                groupTriangleCounts[g] += items[i].triangleCount;
+            }
+            cost += double(groupBounds[g].area()) * groupTriangleCounts[g];
+        }
+
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            for (size_t j = i + 1; j < groups.size(); j++)
+            {
+                cost += kOverlapWeight * overlapArea(groupBounds[i], groupBounds[j]) * (groupTriangleCounts[i] + groupTriangleCounts[j]);
+            }
+        }
+
+        return cost;
+    }
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Utils/Math/AABB.h"
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+    /** Partitions a set of meshes into groups (BLASes) under a triangle budget.
+
+        The partitioner builds a top-down binned SAH hierarchy over the mesh bounding boxes
+        and stops subdividing when a node fits within the triangle budget. The split cost is the
+        regular SAH cost weighted by triangle count, plus a penalty for the overlap between the
+        two child bounds, as overlapping BLASes are traversed together by rays.
+
+        All nodes on the same level of the hierarchy are split in parallel. Each level is processed
+        in O(N) time and the number of levels is O(log N), as balanced splits are preferred over unbalanced ones.
+        The output is deterministic and ordered by a depth-first traversal of the hierarchy,
+        i.e. spatially nearby groups are adjacent in the list.
+
+        Individual meshes are never split. A mesh that alone exceeds the budget ends up in a group of its own.
+    */
+    class FALCOR_API MeshGroupPartitioner
+    {
+    public:
+        struct Item
+        {
+            AABB bounds;                ///< World-space bounds of the mesh.
+            uint64_t triangleCount = 0; ///< Number of triangles in the mesh.
+        };
+
+        using Group = std::vector<uint32_t>;
+
+        /** Partition items into groups.
+            \param[in] items List of items to partition.
+            \param[in] maxTrianglesPerGroup Target max number of triangles per group.
+            \return List of groups, each holding indices into the item list. Every item is in exactly one group.
+        */
+        static std::vector<Group> partition(const std::vector<Item>& items, uint64_t maxTrianglesPerGroup);
+
+        /** Compute the SAH-style cost of a partitioning.
+            This is the sum over all groups of surface area times triangle count, plus the pairwise overlap area
+            between groups weighted by their triangle counts. It is used to compare partitionings and does not have a meaningful absolute scale.
+            \param[in] items List of items.
+            \param[in] groups Groups of item indices.
+            \return Partition cost.
+        */
+        static double computeCost(const std::vector<Item>& items, const std::vector<Group>& groups);
+    };
+}
@@ -0,0 +1,457 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "MeshSDFBaker.h"
+#include "Core/Error.h"
+#include "Utils/Math/MathConstants.slangh"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <sstream>
+
+namespace Falcor
+{
+    namespace
+    {
+        const uint32_t kMaxLeafTriangleCount = 4;
+        const uint32_t kMaxTraversalDepth = 64;
+        const uint32_t kDenseBrickWidth = 8;
+
+        // Sign rays are not axis-aligned to avoid grazing axis-aligned geometry, which is common in meshes and
+        // aligned with the grid.
+        const float3 kSignRayDirections[3] =
+        {
+            float3(1.0f, 0.31415927f, 0.17320508f),
+            float3(-0.27182818f, 1.0f, 0.14142136f),
+            float3(0.22360680f, -0.16180340f, 1.0f),
+        };
+
+        /** Closest point on a triangle, see Ericson, "Real-Time Collision Detection", section 5.1.5.
+        */
+        float3 closestPointOnTriangle(const float3& p, const float3& a, const float3& b, const float3& c)
+        {
+            float3 ab = b - a;
+            float3 ac = c - a;
+            float3 ap = p - a;
+            float d1 = dot(ab, ap);
+            float d2 = dot(ac, ap);
+            if (d1 <= 0.f && d2 <= 0.f) return a;
+
+            float3 bp = p - b;
+            float d3 = dot(ab, bp);
+            float d4 = dot(ac, bp);
+            if (d3 >= 0.f && d4 <= d3) return b;
+
+            float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) return a + ab * (d1 / (d1 - d3));
+
+            float3 cp = p - c;
+            float d5 = dot(ab, cp);
+            float d6 = dot(ac, cp);
+            if (d6 >= 0.f && d5 <= d6) return c;
+
+            float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) return a + ac * (d2 / (d2 - d6));
+
+            float va = d3 * d6 - d5 * d4;
+            if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+            float denom = 1.f / (va + vb + vc);
+            return a + ab * (vb * denom) + ac * (vc * denom);
+        }
+
+        float distanceSquaredToBox(const float3& p, const float3& minPoint, const float3& maxPoint)
+        {
+            float3 d = max(max(minPoint - p, p - maxPoint), float3(0.f));
+            return dot(d, d);
+        }
+
+        float3 gridToLocal(const uint3& index, uint32_t gridWidth)
+        {
+            return float3(index) / float(gridWidth) - 0.5f;
+        }
+    }
+
+    MeshSDFBaker::MeshSDFBaker(fstd::span<const float3> positions, fstd::span<const uint32_t> indices, const Options& options)
+    {
+        FALCOR_CHECK(indices.size() % 3 == 0, "'indices' size ({}) must be a multiple of 3.", indices.size());
+        FALCOR_CHECK(options.padding >= 0.f && options.padding < 0.5f, "'padding' ({}) must be in [0, 0.5).", options.padding);
+
+        float3 minPoint(std::numeric_limits<float>::infinity());
+        float3 maxPoint(-std::numeric_limits<float>::infinity());
+        mTriangles.reserve(indices.size() / 3);
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            Triangle triangle;
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                uint32_t index = indices[i + j];
+                FALCOR_CHECK(index < positions.size(), "Vertex index {} is out of range.", index);
+                triangle.vertices[j] = positions[index];
+            }
+
+            // Degenerate triangles do not contribute to the surface.
+            float3 n = cross(triangle.vertices[1] - triangle.vertices[0], triangle.vertices[2] - triangle.vertices[0]);
+            if (!(dot(n, n) > 0.f)) continue;
+
+            for (const float3& v : triangle.vertices)
+            {
+                minPoint = min(minPoint, v);
+                maxPoint = max(maxPoint, v);
+            }
+            mTriangles.push_back(triangle);
+        }
+
+        if (mTriangles.empty()) FALCOR_THROW("Cannot bake an SDF grid from a mesh without triangles.");
+
+        // Fit the mesh into the SDF grid local space, keeping the aspect ratio.
+        float3 extent = maxPoint - minPoint;
+        float maxExtent = std::max(std::max(extent.x, extent.y), extent.z);
+        mMeshCenter = 0.5f * (minPoint + maxPoint);
+        mMeshToGridScale = (1.f - 2.f * options.padding) / maxExtent;
+
+        for (Triangle& triangle : mTriangles)
+        {
+            for (float3& v : triangle.vertices) v = (v - mMeshCenter) * mMeshToGridScale;
+        }
+
+        mNodes.reserve(2 * mTriangles.size());
+        mNodes.emplace_back();
+        buildNode(0, 0, (uint32_t)mTriangles.size());
+    }
+
+    MeshSDFBaker MeshSDFBaker::createFromTriangleMesh(const TriangleMesh& mesh, const Options& options)
+    {
+        const auto& vertices = mesh.getVertices();
+        std::vector<float3> positions(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) positions[i] = vertices[i].position;
+
+        const auto& indices = mesh.getIndices();
+        return MeshSDFBaker(positions, fstd::span<const uint32_t>(indices.data(), indices.size()), options);
+    }
+
+    MeshSDFBaker MeshSDFBaker::createFromMesh(const SceneBuilder::Mesh& mesh, const Options& options)
+    {
+        FALCOR_CHECK(mesh.topology == Vao::Topology::TriangleList, "Only triangle lists are supported.");
+
+        // Positions may have any attribute frequency, unroll them into a triangle list.
+        std::vector<float3> positions(size_t(mesh.faceCount) * 3);
+        std::vector<uint32_t> indices(positions.size());
+        for (uint32_t face = 0; face < mesh.faceCount; face++)
+        {
+            for (uint32_t vert = 0; vert < 3; vert++)
+            {
+                uint32_t i = face * 3 + vert;
+                positions[i] = mesh.getPosition(face, vert);
+                indices[i] = i;
+            }
+        }
+
+        return MeshSDFBaker(positions, indices, options);
+    }
+
+    float4x4 MeshSDFBaker::getGridToMeshTransform() const
+    {
+        return mul(math::matrixFromTranslation(mMeshCenter), math::matrixFromScaling(float3(1.f / mMeshToGridScale)));
+    }
+
+    float MeshSDFBaker::evalDistance(const float3& p) const
+    {
+        float distance = evalUnsignedDistance(p, std::numeric_limits<float>::infinity());
+        return isInside(p) ? -distance : distance;
+    }
+
+    std::vector<float> MeshSDFBaker::bakeDense(uint32_t gridWidth) const
+    {
+        FALCOR_CHECK(gridWidth > 0, "'gridWidth' must be larger than zero.");
+
+        const uint32_t gridWidthInValues = gridWidth + 1;
+        const size_t strideY = gridWidthInValues;
+        const size_t strideZ = strideY * gridWidthInValues;
+        std::vector<float> cornerValues(strideZ * gridWidthInValues);
+
+        // Bricks partition the corner values, so they can be evaluated independently.
+        const uint32_t bricksPerAxis = (gridWidthInValues + kDenseBrickWidth - 1) / kDenseBrickWidth;
+        auto range = NumericRange<uint32_t>(0, bricksPerAxis * bricksPerAxis * bricksPerAxis);
+        std::for_each(
+            std::execution::par,
+            range.begin(),
+            range.end(),
+            [&](uint32_t brickID)
+            {
+                uint3 brick(brickID % bricksPerAxis, (brickID / bricksPerAxis) % bricksPerAxis, brickID / (bricksPerAxis * bricksPerAxis));
+                uint3 begin = brick * kDenseBrickWidth;
+                uint3 end = min(begin + kDenseBrickWidth, uint3(gridWidthInValues));
+                float* pDst = cornerValues.data() + begin.x + begin.y * strideY + begin.z * strideZ;
+                evalValues(begin, end, gridWidth, float(M_SQRT3), pDst, strideY, strideZ);
+            }
+        );
+
+        return cornerValues;
+    }
+
+    std::unique_ptr<SparseSDFGridFile> MeshSDFBaker::bakeSparse(uint32_t gridWidth, const SparseSDFGridFileOptions& options) const
+    {
+        auto pStream = std::make_unique<std::stringstream>(std::ios::in | std::ios::out | std::ios::binary);
+        bakeSparse(*pStream, gridWidth, options);
+        return std::make_unique<SparseSDFGridFile>(std::move(pStream));
+    }
+
+    void MeshSDFBaker::bakeSparse(const std::filesystem::path& path, uint32_t gridWidth, const SparseSDFGridFileOptions& options) const
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        if (!stream.is_open()) FALCOR_THROW("Failed to open SDF grid file '{}' for writing.", path);
+        bakeSparse(stream, gridWidth, options);
+    }
+
+    void MeshSDFBaker::bakeSparse(std::ostream& stream, uint32_t gridWidth, const SparseSDFGridFileOptions& options) const
+    {
+        FALCOR_CHECK(gridWidth > 0 && options.brickWidth > 0, "'gridWidth' and 'brickWidth' must be larger than zero.");
+
+        const uint32_t brickWidth = options.brickWidth;
+        const uint32_t bricksPerAxis = (gridWidth + brickWidth - 1) / brickWidth;
+        const uint32_t gridWidthInValues = gridWidth + 1;
+        const size_t strideY = gridWidthInValues;
+        const size_t strideZ = strideY * gridWidthInValues;
+
+        // Values at least half a voxel diagonal away from the surface saturate when quantized.
+        const float narrowBand = 0.5f * float(M_SQRT3) / gridWidth;
+        const float maxDistance = 2.f * narrowBand;
+        const float brickHalfDiagonal = 0.5f * float(M_SQRT3) * brickWidth / gridWidth;
+
+        SparseSDFGridFile::write(
+            stream,
+            gridWidth,
+            [&](uint32_t z, uint32_t count, float* pDst)
+            {
+                // The writer requests one slab of bricks at a time, evaluate its bricks in parallel.
+                auto range = NumericRange<uint32_t>(0, bricksPerAxis * bricksPerAxis);
+                std::for_each(
+                    std::execution::par,
+                    range.begin(),
+                    range.end(),
+                    [&](uint32_t i)
+                    {
+                        uint3 brick(i % bricksPerAxis, i / bricksPerAxis, 0);
+                        uint3 begin(brick.x * brickWidth, brick.y * brickWidth, z);
+                        uint3 end(
+                            brick.x == bricksPerAxis - 1 ? gridWidthInValues : begin.x + brickWidth,
+                            brick.y == bricksPerAxis - 1 ? gridWidthInValues : begin.y + brickWidth,
+                            z + count
+                        );
+                        float* pBrick = pDst + begin.x + begin.y * strideY;
+
+                        // Bricks further away from the surface than the narrow band only need their sign.
+                        float3 center = gridToLocal(begin, gridWidth) + 0.5f * float(brickWidth) / gridWidth;
+                        float cullDistance = brickHalfDiagonal + narrowBand;
+                        if (evalUnsignedDistance(center, cullDistance) >= cullDistance)
+                        {
+                            float value = isInside(center) ? -maxDistance : maxDistance;
+                            for (uint32_t lz = 0; lz < end.z - begin.z; lz++)
+                            {
+                                for (uint32_t ly = 0; ly < end.y - begin.y; ly++)
+                                {
+                                    std::fill_n(pBrick + ly * strideY + lz * strideZ, end.x - begin.x, value);
+                                }
+                            }
+                            return;
+                        }
+
+                        evalValues(begin, end, gridWidth, maxDistance, pBrick, strideY, strideZ);
+                    }
+                );
+            },
+            options
+        );
+    }
+
+    void MeshSDFBaker::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count)
+    {
+        float3 minPoint(std::numeric_limits<float>::infinity());
+        float3 maxPoint(-std::numeric_limits<float>::infinity());
+        float3 minCentroid = minPoint;
+        float3 maxCentroid = maxPoint;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            const Triangle& triangle = mTriangles[i];
+            for (const float3& v : triangle.vertices)
+            {
+                minPoint = min(minPoint, v);
+                maxPoint = max(maxPoint, v);
+            }
+            float3 centroid = triangle.vertices[0] + triangle.vertices[1] + triangle.vertices[2];
+            minCentroid = min(minCentroid, centroid);
+            maxCentroid = max(maxCentroid, centroid);
+        }
+
+        mNodes[nodeIndex].minPoint = minPoint;
+        mNodes[nodeIndex].maxPoint = maxPoint;
+
+        if (count <= kMaxLeafTriangleCount)
+        {
+            mNodes[nodeIndex].index = first;
+            mNodes[nodeIndex].triangleCount = count;
+            return;
+        }
+
+        // Median split along the largest extent of the triangle centroids.
+        float3 extent = maxCentroid - minCentroid;
+        uint32_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+        uint32_t half = count / 2;
+        std::nth_element(
+            mTriangles.begin() + first,
+            mTriangles.begin() + first + half,
+            mTriangles.begin() + first + count,
+            [axis](const Triangle& a, const Triangle& b)
+            {
+                return (a.vertices[0] + a.vertices[1] + a.vertices[2])[axis] < (b.vertices[0] + b.vertices[1] + b.vertices[2])[axis];
+            }
+        );
+
+        uint32_t leftIndex = (uint32_t)mNodes.size();
+        mNodes[nodeIndex].index = leftIndex;
+        mNodes.emplace_back();
+        mNodes.emplace_back();
+        buildNode(leftIndex, first, half);
+        buildNode(leftIndex + 1, first + half, count - half);
+    }
+
+    float MeshSDFBaker::evalUnsignedDistance(const float3& p, float maxDistance) const
+    {
+        float bestDistanceSquared = maxDistance * maxDistance;
+        std::array<uint32_t, kMaxTraversalDepth> stack;
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = mNodes[stack[--stackSize]];
+            if (distanceSquaredToBox(p, node.minPoint, node.maxPoint) >= bestDistanceSquared) continue;
+
+            if (node.triangleCount > 0)
+            {
+                for (uint32_t i = node.index; i < node.index + node.triangleCount; i++)
+                {
+                    const Triangle& triangle = mTriangles[i];
+                    float3 d = p - closestPointOnTriangle(p, triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]);
+                    bestDistanceSquared = std::min(bestDistanceSquared, dot(d, d));
+                }
+                continue;
+            }
+
+            // Visit the closer child first.
+            const Node& left = mNodes[node.index];
+            const Node& right = mNodes[node.index + 1];
+            bool leftFirst = distanceSquaredToBox(p, left.minPoint, left.maxPoint) <= distanceSquaredToBox(p, right.minPoint, right.maxPoint);
+            FALCOR_ASSERT(stackSize + 2 <= kMaxTraversalDepth);
+            stack[stackSize++] = leftFirst ? node.index + 1 : node.index;
+            stack[stackSize++] = leftFirst ? node.index : node.index + 1;
+        }
+
+        return std::min(std::sqrt(bestDistanceSquared), maxDistance);
+    }
+
+    uint32_t MeshSDFBaker::countRayCrossings(const float3& origin, const float3& dir) const
+    {
+        const float3 invDir = 1.f / dir;
+        uint32_t crossingCount = 0;
+        std::array<uint32_t, kMaxTraversalDepth> stack;
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = mNodes[stack[--stackSize]];
+
+            float3 t0 = (node.minPoint - origin) * invDir;
+            float3 t1 = (node.maxPoint - origin) * invDir;
+            float3 tNear = min(t0, t1);
+            float3 tFar = max(t0, t1);
+            float tMin = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.f));
+            float tMax = std::min(std::min(tFar.x, tFar.y), tFar.z);
+            if (tMin > tMax) continue;
+
+            if (node.triangleCount > 0)
+            {
+                // Moeller-Trumbore intersection, counting all hits in front of the origin.
+                for (uint32_t i = node.index; i < node.index + node.triangleCount; i++)
+                {
+                    const Triangle& triangle = mTriangles[i];
+                    float3 e1 = triangle.vertices[1] - triangle.vertices[0];
+                    float3 e2 = triangle.vertices[2] - triangle.vertices[0];
+                    float3 pvec = cross(dir, e2);
+                    float det = dot(e1, pvec);
+                    if (det == 0.f) continue;
+
+                    float invDet = 1.f / det;
+                    float3 s = origin - triangle.vertices[0];
+                    float u = dot(s, pvec) * invDet;
+                    if (u < 0.f || u > 1.f) continue;
+                    float3 q = cross(s, e1);
+                    float v = dot(dir, q) * invDet;
+                    if (v < 0.f || u + v > 1.f) continue;
+                    if (dot(e2, q) * invDet > 0.f) crossingCount++;
+                }
+                continue;
+            }
+
+            FALCOR_ASSERT(stackSize + 2 <= kMaxTraversalDepth);
+            stack[stackSize++] = node.index;
+            stack[stackSize++] = node.index + 1;
+        }
+
+        return crossingCount;
+    }
+
+    bool MeshSDFBaker::isInside(const float3& p) const
+    {
+        uint32_t insideCount = 0;
+        for (const float3& dir : kSignRayDirections) insideCount += countRayCrossings(p, dir) & 1;
+        return insideCount >= 2;
+    }
+
+    void MeshSDFBaker::evalValues(const uint3& begin, const uint3& end, uint32_t gridWidth, float maxDistance, float* pDst, size_t strideY, size_t strideZ) const
+    {
+        for (uint32_t z = begin.z; z < end.z; z++)
+        {
+            for (uint32_t y = begin.y; y < end.y; y++)
+            {
+                float* pRow = pDst + (y - begin.y) * strideY + (z - begin.z) * strideZ;
+                for (uint32_t x = begin.x; x < end.x; x++)
+                {
+                    float3 p = gridToLocal(uint3(x, y, z), gridWidth);
+                    float distance = evalUnsignedDistance(p, maxDistance);
+                    pRow[x - begin.x] = isInside(p) ? -distance : distance;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "SparseSDFGridFile.h"
+#include "Scene/SceneBuilder.h"
+#include "Scene/TriangleMesh.h"
+#include "Core/Macros.h"
+#include "Utils/Math/Matrix.h"
+#include "Utils/Math/Vector.h"
+#include <fstd/span.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Falcor
+{
+    /** Options for baking SDF grids from triangle meshes.
+    */
+    struct MeshSDFBakerOptions
+    {
+        float padding = 0.05f;      ///< Distance between the mesh bounds and the grid bounds, relative to the grid extent.
+    };
+
+    /** CPU baker creating SDF grid values from a triangle mesh.
+
+        The mesh is uniformly scaled and translated to fit the local space of SDF grids, i.e., [-0.5, 0.5]^3.
+        Use getGridToMeshTransform() to place the SDF grid instance on top of the original mesh.
+
+        Distances are found with closest point queries against a BVH built over the mesh triangles.
+        The sign is determined by ray parity: three rays in fixed, non axis-aligned directions are cast and the
+        point is classified as inside if the majority of them cross the surface an odd number of times.
+        This is exact for closed meshes and tolerates small holes and cracks.
+
+        Baking is parallelized over bricks of voxels. Sparse baking culls bricks that lie entirely outside the
+        narrow band around the surface with a single distance query, and only determines their sign.
+        The result can be passed directly to an SDF grid:
+        - Dense: SDFGrid::setValues(baker.bakeDense(gridWidth), gridWidth), supported by all grid types.
+        - Sparse: SDFGrid::setBricks(baker.bakeSparse(gridWidth)), supported by SDFSVS, SDFSBS and SDFSVO.
+    */
+    class FALCOR_API MeshSDFBaker
+    {
+    public:
+        using Options = MeshSDFBakerOptions;
+
+        /** Create a baker from an indexed triangle list.
+            \param[in] positions Vertex positions.
+            \param[in] indices Vertex indices, three per triangle.
+            \param[in] options Options.
+        */
+        MeshSDFBaker(fstd::span<const float3> positions, fstd::span<const uint32_t> indices, const Options& options = {});
+
+        /** Create a baker from a triangle mesh.
+        */
+        static MeshSDFBaker createFromTriangleMesh(const TriangleMesh& mesh, const Options& options = {});
+
+        /** Create a baker from a scene builder triangle mesh.
+        */
+        static MeshSDFBaker createFromMesh(const SceneBuilder::Mesh& mesh, const Options& options = {});
+
+        /** Returns the transform from SDF grid local space to mesh space.
+        */
+        float4x4 getGridToMeshTransform() const;
+
+        /** Returns the number of triangles.
+        */
+        uint32_t getTriangleCount() const { return (uint32_t)mTriangles.size(); }
+
+        /** Evaluate the signed distance at a point.
+            \param[in] p Position in SDF grid local space.
+            \return Signed distance in SDF grid local space, negative inside the mesh.
+        */
+        float evalDistance(const float3& p) const;
+
+        /** Bake dense corner values, clamped to the diagonal of the grid.
+            \param[in] gridWidth The grid width in voxels.
+            \return (gridWidth + 1)^3 corner values, see SDFGrid::setValues().
+        */
+        std::vector<float> bakeDense(uint32_t gridWidth) const;
+
+        /** Bake a narrow band sparse grid into memory.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] options Sparse grid options.
+            \return The sparse grid, see SDFGrid::setBricks().
+        */
+        std::unique_ptr<SparseSDFGridFile> bakeSparse(uint32_t gridWidth, const SparseSDFGridFileOptions& options = {}) const;
+
+        /** Bake a narrow band sparse grid into a .sdfb file.
+            \param[in] path The path of the .sdfb file.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] options Sparse grid options.
+        */
+        void bakeSparse(const std::filesystem::path& path, uint32_t gridWidth, const SparseSDFGridFileOptions& options = {}) const;
+
+    private:
+        struct Triangle
+        {
+            float3 vertices[3];
+        };
+
+        struct Node
+        {
+            float3 minPoint;
+            uint32_t index = 0;             ///< Index of the first triangle for leaves, otherwise index of the left child. The right child follows the left child.
+            float3 maxPoint;
+            uint32_t triangleCount = 0;     ///< Number of triangles for leaves, otherwise zero.
+        };
+
+        void bakeSparse(std::ostream& stream, uint32_t gridWidth, const SparseSDFGridFileOptions& options) const;
+        void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count);
+
+        /** Returns the unsigned distance to the closest triangle, or maxDistance if no triangle is closer.
+        */
+        float evalUnsignedDistance(const float3& p, float maxDistance) const;
+
+        uint32_t countRayCrossings(const float3& origin, const float3& dir) const;
+        bool isInside(const float3& p) const;
+
+        /** Evaluate signed corner values in the range [begin, end) and write them to pDst, which points to the value at begin.
+            Distances are clamped to maxDistance.
+        */
+        void evalValues(const uint3& begin, const uint3& end, uint32_t gridWidth, float maxDistance, float* pDst, size_t strideY, size_t strideZ) const;
+
+        float3 mMeshCenter;
+        float mMeshToGridScale = 1.f;
+        std::vector<Triangle> mTriangles;
+        std::vector<Node> mNodes;
+    };
+}
@@ -31,9 +31,11 @@
 #include "SparseVoxelSet/SDFSVS.h"
 #include "SparseBrickSet/SDFSBS.h"
 #include "SparseVoxelOctree/SDFSVO.h"
+#include "MeshSDFBaker.h"
 #include "Core/Error.h"
 #include "Core/API/Device.h"
 #include "Core/API/RenderContext.h"
+#include "Core/Platform/OS.h"
 #include "Utils/Logger.h"
 #include "Utils/Math/Common.h"
 #include "Utils/Math/Matrix.h"
@@ -81,6 +83,10 @@ namespace Falcor
     namespace
     {
         const std::string kEvaluateSDFPrimitivesShaderName = "Scene/SDFs/EvaluateSDFPrimitives.cs.slang";
+        const std::string kLoadBricksShaderName = "Scene/SDFs/SDFGridLoadBricks.cs.slang";
+
+        // Bricks are streamed to the GPU in batches of at most this many values, bounded by the maximum dispatch size of the scatter pass.
+        const uint32_t kMaxBrickValuesPerBatch = std::min(8u << 20, 65535u * 256u);
 
         const char kPrimitiveShapeTypeJSONKey[] = "shape_type";
         const char kPrimitiveShapeDataJSONKey[] = "shape_data";
@@ -293,12 +299,56 @@ namespace Falcor
         }
 
         mGridWidth = gridWidth;
+        mpBrickFile.reset();
 
         setValuesInternal(cornerValues);
     }
 
+    void SDFGrid::setBricks(std::unique_ptr<SparseSDFGridFile> pBricks)
+    {
+        FALCOR_CHECK(pBricks, "'pBricks' must not be null.");
+
+        Type type = getType();
+        FALCOR_CHECK(type != Type::NormalizedDenseGrid, "Sparse bricks cannot be used with SDFGrid type of {}", getTypeName(type));
+
+        uint32_t gridWidth = pBricks->getGridWidth();
+        if (type != Type::SparseBrickSet)
+        {
+            FALCOR_CHECK(isPowerOf2(gridWidth), "'gridWidth' ({}) must be a power of 2 for SDFGrid type of {}", gridWidth, getTypeName(type));
+        }
+
+        mGridWidth = gridWidth;
+        mpBrickFile = std::move(pBricks);
+
+        mInitializedWithPrimitives = false;
+    }
+
     bool SDFGrid::loadValuesFromFile(const std::filesystem::path& path)
     {
+        if (hasExtension(path, SparseSDFGridFile::kExtension))
+        {
+            Type type = getType();
+            if (type == Type::NormalizedDenseGrid)
+            {
+                logWarning("SDFGrid::loadValuesFromFile() sparse SDF grid file '{}' cannot be used with SDFGrid type of {}!", path, getTypeName(type));
+                return false;
+            }
+
+            std::unique_ptr<SparseSDFGridFile> pFile;
+            try
+            {
+                pFile = std::make_unique<SparseSDFGridFile>(path);
+            }
+            catch (const std::exception& e)
+            {
+                logWarning("SDFGrid::loadValuesFromFile() file '{}' could not be loaded: {}", path, e.what());
+                return false;
+            }
+
+            setBricks(std::move(pFile));
+            return true;
+        }
+
         std::ifstream file(path, std::ios::in | std::ios::binary);
 
         if (file.is_open())
@@ -526,6 +576,25 @@ namespace Falcor
             "path"_a, "gridWidth"_a
         ); // PYTHONDEPRECATED
         sdfGrid.def("generateCheeseValues", &SDFGrid::generateCheeseValues, "gridWidth"_a, "seed"_a);
+        sdfGrid.def_static("convert_dense_file_to_sparse",
+            [](const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, uint32_t brickWidth)
+            {
+                SparseSDFGridFile::Options options;
+                options.brickWidth = brickWidth;
+                SparseSDFGridFile::convertDenseFile(densePath, sparsePath, options);
+            },
+            "dense_path"_a, "sparse_path"_a, "brick_width"_a = 7
+        );
+        sdfGrid.def("bake_from_mesh",
+            [](SDFGrid& self, const ref<TriangleMesh>& pMesh, uint32_t gridWidth)
+            {
+                MeshSDFBaker baker = MeshSDFBaker::createFromTriangleMesh(*pMesh);
+                if (self.getType() == SDFGrid::Type::NormalizedDenseGrid) self.setValues(baker.bakeDense(gridWidth), gridWidth);
+                else self.setBricks(baker.bakeSparse(gridWidth));
+                return baker.getGridToMeshTransform();
+            },
+            "mesh"_a, "grid_width"_a
+        );
         sdfGrid.def_property("name", &SDFGrid::getName, &SDFGrid::setName);
     }
 
@@ -557,6 +626,70 @@ namespace Falcor
         }
     }
 
+    void SDFGrid::createSDFGridTextureFromBricks(RenderContext* pRenderContext)
+    {
+        FALCOR_ASSERT(mpBrickFile && pRenderContext);
+        FALCOR_ASSERT(mpBrickFile->getGridWidth() == mGridWidth);
+
+        uint32_t gridWidthInValues = mGridWidth + 1;
+        if (!mpSDFGridTexture || mpSDFGridTexture->getWidth() != gridWidthInValues || !is_set(mpSDFGridTexture->getBindFlags(), ResourceBindFlags::UnorderedAccess))
+        {
+            mpSDFGridTexture = mpDevice->createTexture3D(gridWidthInValues, gridWidthInValues, gridWidthInValues, ResourceFormat::R8Snorm, 1, nullptr, ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess);
+            mpSDFGridTexture->setName("SDFGrid::SDFGridTexture");
+        }
+
+        ProgramDesc fillDesc;
+        fillDesc.addShaderLibrary(kLoadBricksShaderName).csEntry("fillEmptyBricks");
+        ref<ComputePass> pFillPass = ComputePass::create(mpDevice, fillDesc);
+
+        ProgramDesc scatterDesc;
+        scatterDesc.addShaderLibrary(kLoadBricksShaderName).csEntry("scatterBricks");
+        ref<ComputePass> pScatterPass = ComputePass::create(mpDevice, scatterDesc);
+
+        // Fill the grid with the sign of the bricks that are not stored.
+        const auto& insideMask = mpBrickFile->getInsideMask();
+        ref<Buffer> pInsideMask = mpDevice->createBuffer(insideMask.size() * sizeof(uint32_t), ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, insideMask.data());
+
+        for (const auto& pPass : { pFillPass, pScatterPass })
+        {
+            auto paramBlock = pPass->getRootVar()["gParamBlock"];
+            paramBlock["gridWidth"] = mGridWidth;
+            paramBlock["brickWidth"] = mpBrickFile->getBrickWidth();
+            paramBlock["bricksPerAxis"] = mpBrickFile->getBricksPerAxis();
+            paramBlock["insideMask"] = pInsideMask;
+            paramBlock["sdfGrid"] = mpSDFGridTexture;
+        }
+        pFillPass->execute(pRenderContext, uint3(gridWidthInValues));
+
+        // Stream the stored bricks and scatter them into the grid one batch at a time.
+        ref<Buffer> pBrickIDs;
+        ref<Buffer> pBrickValues;
+        auto scatterParamBlock = pScatterPass->getRootVar()["gParamBlock"];
+        uint32_t maxBricksPerBatch = std::max(1u, kMaxBrickValuesPerBatch / mpBrickFile->getValuesPerBrick());
+
+        mpBrickFile->readBricks(
+            [&](fstd::span<const uint32_t> brickIDs, fstd::span<const int8_t> values)
+            {
+                uint32_t brickCount = (uint32_t)brickIDs.size();
+                if (!pBrickIDs || pBrickIDs->getElementCount() < brickCount)
+                {
+                    pBrickIDs = mpDevice->createStructuredBuffer(sizeof(uint32_t), brickCount, ResourceBindFlags::ShaderResource, MemoryType::DeviceLocal, nullptr, false);
+                    pBrickValues = mpDevice->createBuffer(align_to<size_t>(4, values.size()), ResourceBindFlags::ShaderResource);
+                    scatterParamBlock["brickIDs"] = pBrickIDs;
+                    scatterParamBlock["brickValues"] = pBrickValues;
+                }
+
+                pBrickIDs->setBlob(brickIDs.data(), 0, brickIDs.size() * sizeof(uint32_t));
+                pBrickValues->setBlob(values.data(), 0, values.size());
+                scatterParamBlock["brickCount"] = brickCount;
+                pScatterPass->execute(pRenderContext, (uint32_t)values.size(), 1);
+            },
+            maxBricksPerBatch
+        );
+
+        mpBrickFile.reset();
+    }
+
     void SDFGrid::updatePrimitivesBuffer()
     {
         if (mPrimitives.empty() || mPrimitives.size() <= mPrimitivesExcludedFromBuffer) return;
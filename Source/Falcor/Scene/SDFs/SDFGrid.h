@@ -32,6 +32,7 @@
 #include "Core/API/Texture.h"
 #include "Core/Pass/ComputePass.h"
 #include "Scene/SDFs/SDF3DPrimitiveCommon.slang"
+#include "Scene/SDFs/SparseSDFGridFile.h"
 #include <memory>
 #include <vector>
 #include <utility>
@@ -123,8 +124,17 @@ namespace Falcor
         */
         void setValues(const std::vector<float>& cornerValues, uint32_t gridWidth);
 
+        /** Set the signed distance values of the SDF grid from sparse bricks, e.g., read from a .sdfb file or baked from a mesh (see MeshSDFBaker).
+            The bricks are streamed into the SDF grid texture when the GPU resources are created. Not supported by the normalized dense grid.
+            \param[in] pBricks The sparse bricks.
+        */
+        void setBricks(std::unique_ptr<SparseSDFGridFile> pBricks);
+
         /** Set the signed distance values of the SDF grid from a file.
-            \param[in] path The path of a .sdfg file.
+            Dense .sdfg files are loaded into host memory. Sparse .sdfb files (see SparseSDFGridFile) are kept open and their
+            bricks are streamed into the SDF grid texture when the GPU resources are created. Sparse files are not supported
+            by the normalized dense grid, as they only store distances in the narrow band around the surface.
+            \param[in] path The path of a .sdfg or .sdfb file.
             \return true if the values could be set, otherwise false.
         */
         bool loadValuesFromFile(const std::filesystem::path& path);
@@ -240,6 +250,11 @@ namespace Falcor
 
         void updatePrimitivesBuffer();
 
+        /** Create the SDF grid texture from the bricks of the sparse grid file set by loadValuesFromFile().
+            The file is released afterwards.
+        */
+        void createSDFGridTextureFromBricks(RenderContext* pRenderContext);
+
         ref<Device>             mpDevice;
 
         std::string             mName;
@@ -258,6 +273,7 @@ namespace Falcor
         bool                    mInitializedWithPrimitives = false; ///< True if the grid was initialized with primitives.
 
         ref<Texture>            mpSDFGridTexture;                   ///< A texture on the GPU holding the value representation.
+        std::unique_ptr<SparseSDFGridFile> mpBrickFile;             ///< Sparse grid file to stream into mpSDFGridTexture when resources are created.
         ref<ComputePass>        mpEvaluatePrimitivesPass;
 
         friend class Scene;
@@ -104,7 +104,14 @@ namespace Falcor
         if ((!mPrimitivesDirty || (mPrimitives.empty() && !mHasGridRepresentation)) && !isEmpty) return UpdateFlags::None;
 
         // Update grid texture, if user loads an sdf-file.
-        if (!mSDField.empty())
+        if (mpBrickFile)
+        {
+            createSDFGridTextureFromBricks(pRenderContext);
+            mSDField.clear();
+            mSDFieldUpdated = true;
+            mCurrentBakedPrimitiveCount = 0;
+        }
+        else if (!mSDField.empty())
         {
             createSDFGridTexture(pRenderContext, mSDField);
             mSDField.clear();
@@ -117,7 +124,14 @@ namespace Falcor
         FALCOR_ASSERT(pRenderContext);
 
         // Update grid texture, if user loads an sdf-file.
-        if (!mSDField.empty())
+        if (mpBrickFile)
+        {
+            createSDFGridTextureFromBricks(pRenderContext);
+            mSDField.clear();
+            mSDFieldUpdated = true;
+            mCurrentBakedPrimitiveCount = 0;
+        }
+        else if (!mSDField.empty())
         {
             createSDFGridTexture(pRenderContext, mSDField);
             mSDField.clear();
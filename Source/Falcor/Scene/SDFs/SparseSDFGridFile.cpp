@@ -0,0 +1,379 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "SparseSDFGridFile.h"
+#include "Core/Error.h"
+#include "Utils/Math/MathConstants.slangh"
+#include "Utils/NumericRange.h"
+#include <lz4.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <execution>
+
+namespace Falcor
+{
+    namespace
+    {
+        const uint32_t kMagic = 0x42464453; // "SDFB"
+        const uint32_t kVersion = 1;
+
+        const int8_t kOutsideValue = INT8_MAX;
+        const int8_t kInsideValue = -INT8_MAX;
+
+        enum class BrickState : uint8_t
+        {
+            Stored,
+            Outside,
+            Inside,
+        };
+
+        template<typename T>
+        void writeArray(std::ostream& stream, const std::vector<T>& data)
+        {
+            stream.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+        }
+
+        template<typename T>
+        void readArray(std::istream& stream, std::vector<T>& data, size_t count)
+        {
+            data.resize(count);
+            stream.read(reinterpret_cast<char*>(data.data()), count * sizeof(T));
+        }
+    }
+
+    /** Writes a sparse grid one slab of bricks at a time.
+    */
+    class SparseSDFGridFile::Writer
+    {
+    public:
+        Writer(std::ostream& stream, uint32_t gridWidth, const Options& options)
+            : mStream(stream)
+        {
+            FALCOR_CHECK(gridWidth > 0, "'gridWidth' must be larger than zero.");
+            FALCOR_CHECK(options.brickWidth > 0 && options.bricksPerChunk > 0, "'brickWidth' and 'bricksPerChunk' must be larger than zero.");
+
+            mHeader.magic = kMagic;
+            mHeader.version = kVersion;
+            mHeader.gridWidth = gridWidth;
+            mHeader.brickWidth = options.brickWidth;
+            mHeader.bricksPerAxis = (gridWidth + options.brickWidth - 1) / options.brickWidth;
+            mHeader.bricksPerChunk = options.bricksPerChunk;
+
+            uint64_t totalBrickCount = uint64_t(mHeader.bricksPerAxis) * mHeader.bricksPerAxis * mHeader.bricksPerAxis;
+            FALCOR_CHECK(totalBrickCount <= std::numeric_limits<uint32_t>::max(), "Too many bricks ({}), increase the brick width.", totalBrickCount);
+            mInsideMask.resize((totalBrickCount + 31) / 32, 0);
+
+            mHeaderOffset = mStream.tellp();
+            mStream.write(reinterpret_cast<const char*>(&mHeader), sizeof(Header));
+        }
+
+        void write(const SliceReader& readSlices)
+        {
+            const uint32_t n = mHeader.bricksPerAxis;
+            const uint32_t brickWidth = mHeader.brickWidth;
+            const uint32_t brickWidthInValues = brickWidth + 1;
+            const uint32_t valuesPerBrick = brickWidthInValues * brickWidthInValues * brickWidthInValues;
+            const uint32_t gridWidth = mHeader.gridWidth;
+            const uint32_t gridWidthInValues = gridWidth + 1;
+            const size_t sliceSize = size_t(gridWidthInValues) * gridWidthInValues;
+
+            std::vector<float> slab(brickWidthInValues * sliceSize);
+            std::vector<int8_t> slabBricks(size_t(n) * n * valuesPerBrick);
+            std::vector<BrickState> slabStates(size_t(n) * n);
+
+            for (uint32_t bz = 0; bz < n; bz++)
+            {
+                uint32_t z0 = bz * brickWidth;
+                uint32_t sliceCount = std::min(brickWidthInValues, gridWidthInValues - z0);
+                readSlices(z0, sliceCount, slab.data());
+
+                // Quantize all bricks of the slab and classify them.
+                auto range = NumericRange<uint32_t>(0, n * n);
+                std::for_each(
+                    std::execution::par,
+                    range.begin(),
+                    range.end(),
+                    [&](uint32_t i)
+                    {
+                        uint32_t x0 = (i % n) * brickWidth;
+                        uint32_t y0 = (i / n) * brickWidth;
+                        int8_t* pBrick = slabBricks.data() + size_t(i) * valuesPerBrick;
+                        bool isOutside = true;
+                        bool isInside = true;
+
+                        for (uint32_t z = 0; z < brickWidthInValues; z++)
+                        {
+                            const float* pSlice = slab.data() + std::min(z, sliceCount - 1) * sliceSize;
+                            for (uint32_t y = 0; y < brickWidthInValues; y++)
+                            {
+                                const float* pRow = pSlice + std::min(y0 + y, gridWidth) * size_t(gridWidthInValues);
+                                for (uint32_t x = 0; x < brickWidthInValues; x++)
+                                {
+                                    int8_t value = quantize(pRow[std::min(x0 + x, gridWidth)], gridWidth);
+                                    *pBrick++ = value;
+                                    isOutside = isOutside && value == kOutsideValue;
+                                    isInside = isInside && value == kInsideValue;
+                                }
+                            }
+                        }
+
+                        slabStates[i] = isOutside ? BrickState::Outside : (isInside ? BrickState::Inside : BrickState::Stored);
+                    }
+                );
+
+                std::vector<uint32_t> stored;
+                for (uint32_t i = 0; i < n * n; i++)
+                {
+                    uint32_t brickID = i + n * n * bz;
+                    if (slabStates[i] == BrickState::Stored)
+                    {
+                        stored.push_back(i);
+                        mBrickIDs.push_back(brickID);
+                    }
+                    else if (slabStates[i] == BrickState::Inside)
+                    {
+                        mInsideMask[brickID / 32] |= 1u << (brickID % 32);
+                    }
+                }
+
+                writeChunks(stored, slabBricks, valuesPerBrick);
+            }
+
+            // Write the tables and patch the header.
+            mHeader.brickCount = (uint32_t)mBrickIDs.size();
+            mHeader.chunkCount = (uint32_t)mChunks.size();
+            mHeader.tableOffset = (uint64_t)(mStream.tellp() - mHeaderOffset);
+            writeArray(mStream, mBrickIDs);
+            writeArray(mStream, mInsideMask);
+            writeArray(mStream, mChunks);
+
+            auto endOffset = mStream.tellp();
+            mStream.seekp(mHeaderOffset);
+            mStream.write(reinterpret_cast<const char*>(&mHeader), sizeof(Header));
+            mStream.seekp(endOffset);
+            if (mStream.fail()) FALCOR_THROW("Failed to write sparse SDF grid.");
+        }
+
+    private:
+        void writeChunks(const std::vector<uint32_t>& stored, const std::vector<int8_t>& slabBricks, uint32_t valuesPerBrick)
+        {
+            // Chunks do not span slabs, which allows compressing all chunks of a slab in parallel.
+            uint32_t chunkCount = ((uint32_t)stored.size() + mHeader.bricksPerChunk - 1) / mHeader.bricksPerChunk;
+            std::vector<std::vector<char>> compressed(chunkCount);
+            std::atomic<bool> failed = false;
+
+            auto range = NumericRange<uint32_t>(0, chunkCount);
+            std::for_each(
+                std::execution::par,
+                range.begin(),
+                range.end(),
+                [&](uint32_t c)
+                {
+                    uint32_t first = c * mHeader.bricksPerChunk;
+                    uint32_t count = std::min(mHeader.bricksPerChunk, (uint32_t)stored.size() - first);
+
+                    std::vector<int8_t> values(size_t(count) * valuesPerBrick);
+                    for (uint32_t b = 0; b < count; b++)
+                    {
+                        std::memcpy(values.data() + size_t(b) * valuesPerBrick, slabBricks.data() + size_t(stored[first + b]) * valuesPerBrick, valuesPerBrick);
+                    }
+
+                    int srcSize = (int)values.size();
+                    compressed[c].resize(LZ4_compressBound(srcSize));
+                    int size = LZ4_compress_default(reinterpret_cast<const char*>(values.data()), compressed[c].data(), srcSize, (int)compressed[c].size());
+                    if (size <= 0) failed = true;
+                    compressed[c].resize(std::max(size, 0));
+                }
+            );
+            if (failed) FALCOR_THROW("Failed to compress SDF brick chunks.");
+
+            for (uint32_t c = 0; c < chunkCount; c++)
+            {
+                Chunk chunk;
+                chunk.offset = (uint64_t)(mStream.tellp() - mHeaderOffset);
+                chunk.compressedSize = (uint32_t)compressed[c].size();
+                chunk.brickCount = std::min(mHeader.bricksPerChunk, (uint32_t)stored.size() - c * mHeader.bricksPerChunk);
+                mStream.write(compressed[c].data(), compressed[c].size());
+                mChunks.push_back(chunk);
+            }
+        }
+
+        Header mHeader;
+        std::ostream& mStream;
+        std::ostream::pos_type mHeaderOffset;
+        std::vector<uint32_t> mBrickIDs;
+        std::vector<uint32_t> mInsideMask;
+        std::vector<Chunk> mChunks;
+    };
+
+    int8_t SparseSDFGridFile::quantize(float distance, uint32_t gridWidth)
+    {
+        // Same normalization as the sparse SDF grids, a value of 1 represents half a voxel diagonal.
+        float normalizationFactor = 2.0f * gridWidth / float(M_SQRT3);
+        float normalizedValue = std::clamp(distance * normalizationFactor, -1.0f, 1.0f);
+        float integerScale = normalizedValue * float(INT8_MAX);
+        return integerScale >= 0.0f ? int8_t(integerScale + 0.5f) : int8_t(integerScale - 0.5f);
+    }
+
+    void SparseSDFGridFile::write(const std::filesystem::path& path, fstd::span<const float> cornerValues, uint32_t gridWidth, const Options& options)
+    {
+        size_t sliceSize = size_t(gridWidth + 1) * (gridWidth + 1);
+        FALCOR_CHECK(cornerValues.size() == sliceSize * (gridWidth + 1), "'cornerValues' has {} values, expected {}.", cornerValues.size(), sliceSize * (gridWidth + 1));
+
+        std::ofstream stream(path, std::ios::out | std::ios::binary);
+        if (!stream.is_open()) FALCOR_THROW("Failed to open SDF grid file '{}' for writing.", path);
+        write(stream, gridWidth, [&](uint32_t z, uint32_t count, float* pDst) { std::memcpy(pDst, cornerValues.data() + z * sliceSize, count * sliceSize * sizeof(float)); }, options);
+    }
+
+    void SparseSDFGridFile::write(std::ostream& stream, uint32_t gridWidth, const SliceReader& readSlices, const Options& options)
+    {
+        Writer writer(stream, gridWidth, options);
+        writer.write(readSlices);
+    }
+
+    void SparseSDFGridFile::convertDenseFile(const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, const Options& options)
+    {
+        std::ifstream stream(densePath, std::ios::in | std::ios::binary);
+        if (!stream.is_open()) FALCOR_THROW("Failed to open SDF grid file '{}' for reading.", densePath);
+
+        uint32_t gridWidth = 0;
+        stream.read(reinterpret_cast<char*>(&gridWidth), sizeof(uint32_t));
+        if (!stream.good()) FALCOR_THROW("Failed to read SDF grid file '{}'.", densePath);
+
+        size_t sliceSize = size_t(gridWidth + 1) * (gridWidth + 1);
+        std::ofstream sparseStream(sparsePath, std::ios::out | std::ios::binary);
+        if (!sparseStream.is_open()) FALCOR_THROW("Failed to open SDF grid file '{}' for writing.", sparsePath);
+        write(
+            sparseStream,
+            gridWidth,
+            [&](uint32_t z, uint32_t count, float* pDst)
+            {
+                stream.seekg(sizeof(uint32_t) + z * sliceSize * sizeof(float));
+                stream.read(reinterpret_cast<char*>(pDst), count * sliceSize * sizeof(float));
+                if (!stream.good()) FALCOR_THROW("Failed to read SDF grid file '{}'.", densePath);
+            },
+            options
+        );
+    }
+
+    SparseSDFGridFile::SparseSDFGridFile(const std::filesystem::path& path)
+    {
+        auto pStream = std::make_unique<std::ifstream>(path, std::ios::in | std::ios::binary);
+        if (!pStream->is_open()) FALCOR_THROW("Failed to open SDF grid file '{}' for reading.", path);
+        mpStream = std::move(pStream);
+
+        try
+        {
+            readTables();
+        }
+        catch (const std::exception& e)
+        {
+            FALCOR_THROW("Failed to load sparse SDF grid file '{}': {}", path, e.what());
+        }
+    }
+
+    SparseSDFGridFile::SparseSDFGridFile(std::unique_ptr<std::istream> pStream)
+        : mpStream(std::move(pStream))
+    {
+        FALCOR_CHECK(mpStream, "'pStream' must not be null.");
+        readTables();
+    }
+
+    void SparseSDFGridFile::readTables()
+    {
+        std::istream& stream = *mpStream;
+        mBaseOffset = stream.tellg();
+        stream.read(reinterpret_cast<char*>(&mHeader), sizeof(Header));
+        if (!stream.good() || mHeader.magic != kMagic) FALCOR_THROW("Not a sparse SDF grid.");
+        if (mHeader.version != kVersion) FALCOR_THROW("Unsupported sparse SDF grid version {}.", mHeader.version);
+        if (mHeader.brickWidth == 0 || mHeader.bricksPerAxis != (mHeader.gridWidth + mHeader.brickWidth - 1) / mHeader.brickWidth)
+            FALCOR_THROW("Invalid sparse SDF grid header.");
+
+        uint64_t totalBrickCount = uint64_t(mHeader.bricksPerAxis) * mHeader.bricksPerAxis * mHeader.bricksPerAxis;
+        stream.seekg(mBaseOffset + std::streamoff(mHeader.tableOffset));
+        readArray(stream, mBrickIDs, mHeader.brickCount);
+        readArray(stream, mInsideMask, (totalBrickCount + 31) / 32);
+        readArray(stream, mChunks, mHeader.chunkCount);
+        if (!stream.good()) FALCOR_THROW("Failed to read the sparse SDF grid tables.");
+    }
+
+    void SparseSDFGridFile::readBricks(const BrickCallback& callback, uint32_t maxBricksPerBatch)
+    {
+        const uint32_t valuesPerBrick = getValuesPerBrick();
+        std::vector<char> compressed;
+        std::vector<int8_t> values;
+        std::vector<uint32_t> chunkBrickOffsets;
+
+        uint32_t firstChunk = 0;
+        uint32_t firstBrick = 0;
+        while (firstChunk < mChunks.size())
+        {
+            // Gather chunks for the batch, always at least one.
+            uint32_t endChunk = firstChunk;
+            uint32_t brickCount = 0;
+            chunkBrickOffsets.clear();
+            do
+            {
+                chunkBrickOffsets.push_back(brickCount);
+                brickCount += mChunks[endChunk++].brickCount;
+            } while (endChunk < mChunks.size() && brickCount + mChunks[endChunk].brickCount <= maxBricksPerBatch);
+
+            // Chunks are stored contiguously, read them with a single read.
+            uint64_t batchOffset = mChunks[firstChunk].offset;
+            uint64_t batchSize = mChunks[endChunk - 1].offset + mChunks[endChunk - 1].compressedSize - batchOffset;
+            compressed.resize(batchSize);
+            mpStream->seekg(mBaseOffset + std::streamoff(batchOffset));
+            mpStream->read(compressed.data(), batchSize);
+            if (!mpStream->good()) FALCOR_THROW("Failed to read sparse SDF grid chunks.");
+
+            values.resize(size_t(brickCount) * valuesPerBrick);
+            std::atomic<bool> failed = false;
+            auto range = NumericRange<uint32_t>(firstChunk, endChunk);
+            std::for_each(
+                std::execution::par,
+                range.begin(),
+                range.end(),
+                [&](uint32_t c)
+                {
+                    const Chunk& chunk = mChunks[c];
+                    int expectedSize = int(chunk.brickCount * valuesPerBrick);
+                    int8_t* pDst = values.data() + size_t(chunkBrickOffsets[c - firstChunk]) * valuesPerBrick;
+                    int size = LZ4_decompress_safe(compressed.data() + (chunk.offset - batchOffset), reinterpret_cast<char*>(pDst), (int)chunk.compressedSize, expectedSize);
+                    if (size != expectedSize) failed = true;
+                }
+            );
+            if (failed) FALCOR_THROW("Failed to decompress sparse SDF grid chunks.");
+
+            callback(fstd::span<const uint32_t>(mBrickIDs.data() + firstBrick, brickCount), fstd::span<const int8_t>(values.data(), values.size()));
+
+            firstChunk = endChunk;
+            firstBrick += brickCount;
+        }
+    }
+}
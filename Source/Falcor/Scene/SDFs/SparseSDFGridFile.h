@@ -0,0 +1,182 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <fstd/span.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace Falcor
+{
+    /** Options for writing sparse SDF grid files.
+    */
+    struct SparseSDFGridFileOptions
+    {
+        uint32_t brickWidth = 7;        ///< Width of a brick in voxels.
+        uint32_t bricksPerChunk = 64;   ///< Number of bricks per compressed chunk.
+    };
+
+    /** Brick-sparse file format for SDF grids (.sdfb).
+
+        The grid is divided into bricks of brickWidth^3 voxels, each brick storing its (brickWidth + 1)^3 corner values.
+        Values are quantized to snorm8 in units of half a voxel diagonal, which is the representation used by the
+        sparse SDF grids (SDFSVS, SDFSBS and SDFSVO). Only bricks in the narrow band around the surface are stored,
+        i.e., bricks with at least one value that is not saturated. All other bricks are entirely inside or outside
+        and are represented by one bit each. The conversion is lossless with respect to the snorm8 representation.
+
+        Stored bricks are grouped into chunks that are compressed individually using LZ4. Reading streams the
+        chunks in batches and decompresses each batch in parallel, so the dense grid is never materialized.
+
+        File layout:
+        - Header.
+        - Compressed chunks.
+        - Brick IDs of all stored bricks in ascending order (uint32_t each).
+        - Inside mask with one bit per brick.
+        - Chunk table.
+    */
+    class FALCOR_API SparseSDFGridFile
+    {
+    public:
+        static constexpr char kExtension[] = "sdfb";
+
+        using Options = SparseSDFGridFileOptions;
+
+        /** Callback receiving a batch of bricks.
+            \param[in] brickIDs Linear brick IDs, i.e., x + bricksPerAxis * (y + bricksPerAxis * z).
+            \param[in] values Corner values of the bricks, (brickWidth + 1)^3 values per brick with x being the fastest axis.
+        */
+        using BrickCallback = std::function<void(fstd::span<const uint32_t> brickIDs, fstd::span<const int8_t> values)>;
+
+        /** Callback providing dense corner values for writing, one slab of bricks at a time.
+            \param[in] z The first slice to provide, always a multiple of the brick width.
+            \param[in] count The number of slices to provide, at most brickWidth + 1.
+            \param[out] pDst Destination for count * (gridWidth + 1)^2 corner values with x being the fastest axis.
+        */
+        using SliceReader = std::function<void(uint32_t z, uint32_t count, float* pDst)>;
+
+        /** Quantize a distance to snorm8 in units of half a voxel diagonal.
+        */
+        static int8_t quantize(float distance, uint32_t gridWidth);
+
+        /** Write a dense grid of corner values to a sparse file.
+            \param[in] path The path of the .sdfb file.
+            \param[in] cornerValues The corner values of all voxels, (gridWidth + 1)^3 values.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] options Options.
+        */
+        static void write(const std::filesystem::path& path, fstd::span<const float> cornerValues, uint32_t gridWidth, const Options& options = {});
+
+        /** Write a sparse grid to a stream. The corner values are requested one slab of bricks at a time.
+            \param[in] stream The output stream, must be seekable. Offsets are stored relative to the current position.
+            \param[in] gridWidth The grid width in voxels.
+            \param[in] readSlices Callback providing the corner values.
+            \param[in] options Options.
+        */
+        static void write(std::ostream& stream, uint32_t gridWidth, const SliceReader& readSlices, const Options& options = {});
+
+        /** Convert a dense .sdfg file to a sparse file. The dense file is streamed one slab of bricks at a time.
+            \param[in] densePath The path of the .sdfg file.
+            \param[in] sparsePath The path of the .sdfb file.
+            \param[in] options Options.
+        */
+        static void convertDenseFile(const std::filesystem::path& densePath, const std::filesystem::path& sparsePath, const Options& options = {});
+
+        /** Open a sparse file for reading. Only the header and the tables are read.
+            Throws an exception if the file could not be opened or is invalid.
+            \param[in] path The path of the .sdfb file.
+        */
+        explicit SparseSDFGridFile(const std::filesystem::path& path);
+
+        /** Open a sparse grid for reading from a stream, e.g., one written to memory by write().
+            Throws an exception if the stream is invalid.
+            \param[in] pStream The input stream positioned at the start of the sparse grid, must be seekable.
+        */
+        explicit SparseSDFGridFile(std::unique_ptr<std::istream> pStream);
+
+        uint32_t getGridWidth() const { return mHeader.gridWidth; }
+        uint32_t getBrickWidth() const { return mHeader.brickWidth; }
+        uint32_t getBricksPerAxis() const { return mHeader.bricksPerAxis; }
+        uint32_t getValuesPerBrick() const { return (mHeader.brickWidth + 1) * (mHeader.brickWidth + 1) * (mHeader.brickWidth + 1); }
+
+        /** Returns the number of stored (narrow band) bricks.
+        */
+        uint32_t getBrickCount() const { return mHeader.brickCount; }
+
+        /** Returns the inside mask with one bit per brick, packed into 32-bit words. Only valid for bricks that are not stored.
+        */
+        const std::vector<uint32_t>& getInsideMask() const { return mInsideMask; }
+
+        /** Returns true if a brick that is not stored lies inside the surface.
+        */
+        bool isBrickInside(uint32_t brickID) const { return (mInsideMask[brickID / 32] >> (brickID % 32)) & 1; }
+
+        /** Stream all stored bricks in ascending brick ID order.
+            \param[in] callback Callback invoked for each batch of bricks.
+            \param[in] maxBricksPerBatch Maximum number of bricks per batch. At least one chunk is passed per batch.
+        */
+        void readBricks(const BrickCallback& callback, uint32_t maxBricksPerBatch = 16384);
+
+    private:
+        struct Header
+        {
+            uint32_t magic = 0;
+            uint32_t version = 0;
+            uint32_t gridWidth = 0;
+            uint32_t brickWidth = 0;
+            uint32_t bricksPerAxis = 0;
+            uint32_t brickCount = 0;
+            uint32_t chunkCount = 0;
+            uint32_t bricksPerChunk = 0;
+            uint64_t tableOffset = 0;   ///< Byte offset of the brick IDs, followed by the inside mask and the chunk table.
+        };
+
+        struct Chunk
+        {
+            uint64_t offset = 0;
+            uint32_t compressedSize = 0;
+            uint32_t brickCount = 0;
+        };
+
+        class Writer;
+
+        void readTables();
+
+        Header mHeader;
+        std::unique_ptr<std::istream> mpStream;
+        std::istream::pos_type mBaseOffset;     ///< Stream position of the header, all offsets are relative to it.
+        std::vector<uint32_t> mBrickIDs;
+        std::vector<uint32_t> mInsideMask;
+        std::vector<Chunk> mChunks;
+    };
+}
@@ -98,9 +98,14 @@ namespace Falcor
         }
 
         // Create source grid texture to read from.
-        if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
+        if (mpBrickFile)
         {
-            pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
+            createSDFGridTextureFromBricks(pRenderContext);
+            mValues.clear();
+        }
+        else if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
+        {
+            if (!mValues.empty()) pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
         }
         else
         {
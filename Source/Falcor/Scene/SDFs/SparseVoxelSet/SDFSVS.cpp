@@ -57,9 +57,14 @@ namespace Falcor
             FALCOR_THROW("An SDFSVS instance cannot be created from primitives!");
         }
 
-        if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
+        if (mpBrickFile)
         {
-            pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
+            createSDFGridTextureFromBricks(pRenderContext);
+            mValues.clear();
+        }
+        else if (mpSDFGridTexture && mpSDFGridTexture->getWidth() == mGridWidth + 1)
+        {
+            if (!mValues.empty()) pRenderContext->updateTextureData(mpSDFGridTexture.get(), mValues.data());
         }
         else
         {
@@ -194,6 +194,7 @@ namespace Falcor
         mMeshGroups = std::move(sceneData.meshGroups);
 
         mUseCompressedHitInfo = sceneData.useCompressedHitInfo;
+        mMeshLightTriangles = std::move(sceneData.meshLightTriangles);
         mHas16BitIndices = sceneData.has16BitIndices;
         mHas32BitIndices = sceneData.has32BitIndices;
 
@@ -348,7 +349,9 @@ namespace Falcor
         {
             FALCOR_CHECK(mFinalized, "getLightCollection() called before scene is ready for use");
 
-            mpLightCollection = LightCollection::create(mpDevice, pRenderContext, this);
+            LightCollection::Options options;
+            options.meshLightTriangles = std::exchange(mMeshLightTriangles, {});
+            mpLightCollection = LightCollection::create(mpDevice, pRenderContext, this, std::move(options));
             mpLightCollection->bindShaderData(mpSceneBlock->getRootVar()["lightCollection"]);
 
             mSceneStats.emissiveMemoryInBytes = mpLightCollection->getMemoryUsageInBytes();
@@ -1582,11 +1585,17 @@ namespace Falcor
         return false;
     }
 
-    Scene::UpdateFlags Scene::updateSelectedCamera(bool forceUpdate)
+    Scene::UpdateFlags Scene::updateSelectedCamera(bool forceUpdate, double currentTime)
     {
         auto camera = mCameras[mSelectedCamera];
 
-        if (forceUpdate || (camera->hasAnimation() && camera->isAnimated()))
+        if (const auto& pPath = camera->getPath())
+        {
+            // Cameras with a precomputed path only look up the frame. Untimed paths keep the frame selected by the user.
+            // Timed paths repeat like the animation they were sampled from when animations are looped.
+            if (pPath->isTimed()) camera->setPathFrame(pPath->getFrameIndex(currentTime, mpAnimationController->isLooped()));
+        }
+        else if (forceUpdate || (camera->hasAnimation() && camera->isAnimated()))
         {
             updateAnimatable(*camera, *mpAnimationController, forceUpdate);
         }
@@ -1693,8 +1702,8 @@ namespace Falcor
         // Early out if no volumes have changed.
         if (!forceUpdate && combinedUpdates == GridVolume::UpdateFlags::None) return UpdateFlags::None;
 
-        // Upload grids.
-        if (forceUpdate)
+        // Upload grids. Grids of streamed sequences change their resources when the grid frame changes.
+        if (forceUpdate || is_set(combinedUpdates, GridVolume::UpdateFlags::GridsChanged))
         {
             bindGridVolumes();
         }
@@ -1911,7 +1920,7 @@ namespace Falcor
             pGridVolume->updatePlayback(currentTime);
         }
 
-        mUpdates |= updateSelectedCamera(false);
+        mUpdates |= updateSelectedCamera(false, currentTime);
         mUpdates |= updateLights(false);
         mUpdates |= updateGridVolumes(false);
         mUpdates |= updateEnvMap(false);
@@ -1935,6 +1944,9 @@ namespace Falcor
             buildBlas(pRenderContext);
         }
 
+        // Pre-integrated emissive triangles are out of date once emissive materials change.
+        if (is_set(mUpdates, UpdateFlags::EmissiveMaterialsChanged)) mMeshLightTriangles = {};
+
         // Update light collection
         if (mpLightCollection)
         {
@@ -2443,6 +2455,34 @@ namespace Falcor
         mCurrentViewpoint = index;
     }
 
+    ref<CameraPath> Scene::createViewpointCameraPath()
+    {
+        std::vector<CameraPath::Viewpoint> viewpoints;
+        for (const auto& viewpoint : mViewpoints)
+        {
+            if (viewpoint.index == mSelectedCamera) viewpoints.push_back({ viewpoint.position, viewpoint.target, viewpoint.up });
+        }
+        FALCOR_CHECK(!viewpoints.empty(), "There are no viewpoints for the selected camera.");
+
+        return CameraPath::create(*getCamera(), viewpoints);
+    }
+
+    ref<CameraPath> Scene::createAnimatedCameraPath(double startTime, double frameRate, uint32_t frameCount)
+    {
+        const auto& camera = getCamera();
+        FALCOR_CHECK(camera->hasAnimation() && camera->getNodeID() != NodeID::Invalid(), "Camera '{}' is not animated.", camera->getName());
+        FALCOR_CHECK(frameRate > 0.0, "Frame rate must be positive.");
+        FALCOR_CHECK(frameCount > 0, "Frame count must be positive.");
+
+        std::vector<double> times(frameCount);
+        for (uint32_t i = 0; i < frameCount; i++) times[i] = startTime + i / frameRate;
+
+        auto transforms = mpAnimationController->evaluateGlobalMatrices(camera->getNodeID(), times);
+        auto pPath = CameraPath::createFromTransforms(*camera, transforms);
+        pPath->setTiming(startTime, frameRate);
+        return pPath;
+    }
+
     uint32_t Scene::getGeometryCount() const
     {
         // The BLASes currently hold the geometries in the order: meshes, curves, SDF grids, custom primitives.
@@ -3130,33 +3170,65 @@ namespace Falcor
     void Scene::computeBlasGroups()
     {
         mBlasGroups.clear();
-        uint64_t groupSize = 0;
 
+        // The BLASes are packed into groups to balance the build memory between groups.
+        // The result and scratch buffers are sized for the largest group, so the peak memory usage is
+        // minimized by making the groups as even as possible. We use the longest-processing-time heuristic:
+        // BLASes are visited in order of decreasing size and each is assigned to the currently smallest group.
+        // A new group is only started if the BLAS would make the smallest group exceed the target.
+        auto getBlasSize = [this](uint32_t blasId) { return mBlasData[blasId].resultByteSize + mBlasData[blasId].scratchByteSize; };
+
+        uint64_t totalSize = 0;
+        std::vector<uint32_t> blasOrder(mBlasData.size());
         for (uint32_t blasId = 0; blasId < mBlasData.size(); blasId++)
         {
-            auto& blas = mBlasData[blasId];
-            size_t blasSize = blas.resultByteSize + blas.scratchByteSize;
+            blasOrder[blasId] = blasId;
+            totalSize += getBlasSize(blasId);
+        }
+        std::stable_sort(blasOrder.begin(), blasOrder.end(), [&](uint32_t a, uint32_t b) { return getBlasSize(a) > getBlasSize(b); });
+
+        const size_t targetGroupCount = std::max<size_t>(1, div_round_up(totalSize, (uint64_t)kMaxBLASBuildMemory));
+        std::vector<std::vector<uint32_t>> groups(targetGroupCount);
+        std::vector<uint64_t> groupSizes(targetGroupCount, 0);
+
+        for (uint32_t blasId : blasOrder)
+        {
+            const uint64_t blasSize = getBlasSize(blasId);
+            size_t groupIndex = std::min_element(groupSizes.begin(), groupSizes.end()) - groupSizes.begin();
 
-            // Start new BLAS group on first iteration or if group size would exceed the target.
-            if (groupSize == 0 || groupSize + blasSize > kMaxBLASBuildMemory)
+            if (groupSizes[groupIndex] > 0 && groupSizes[groupIndex] + blasSize > kMaxBLASBuildMemory)
             {
-                mBlasGroups.push_back({});
-                groupSize = 0;
+                groups.emplace_back();
+                groupSizes.push_back(0);
+                groupIndex = groups.size() - 1;
             }
 
-            // Add BLAS to current group.
-            FALCOR_ASSERT(mBlasGroups.size() > 0);
-            auto& group = mBlasGroups.back();
-            group.blasIndices.push_back(blasId);
-            blas.blasGroupIndex = (uint32_t)mBlasGroups.size() - 1;
+            groups[groupIndex].push_back(blasId);
+            groupSizes[groupIndex] += blasSize;
+        }
+
+        // Remove unused groups. Sort BLASes within groups and the groups themselves for a deterministic layout.
+        groups.erase(std::remove_if(groups.begin(), groups.end(), [](const auto& g) { return g.empty(); }), groups.end());
+        for (auto& g : groups) std::sort(g.begin(), g.end());
+        std::sort(groups.begin(), groups.end(), [](const auto& a, const auto& b) { return a.front() < b.front(); });
 
-            // Update data offsets and sizes.
-            blas.resultByteOffset = group.resultByteSize;
-            blas.scratchByteOffset = group.scratchByteSize;
-            group.resultByteSize += blas.resultByteSize;
-            group.scratchByteSize += blas.scratchByteSize;
+        mBlasGroups.resize(groups.size());
+        for (size_t blasGroupIndex = 0; blasGroupIndex < groups.size(); blasGroupIndex++)
+        {
+            auto& group = mBlasGroups[blasGroupIndex];
+            group.blasIndices = std::move(groups[blasGroupIndex]);
 
-            groupSize += blasSize;
+            for (uint32_t blasId : group.blasIndices)
+            {
+                auto& blas = mBlasData[blasId];
+                blas.blasGroupIndex = (uint32_t)blasGroupIndex;
+
+                // Update data offsets and sizes.
+                blas.resultByteOffset = group.resultByteSize;
+                blas.scratchByteOffset = group.scratchByteSize;
+                group.resultByteSize += blas.resultByteSize;
+                group.scratchByteSize += blas.scratchByteSize;
+            }
         }
 
         // Validation that all offsets and sizes are correct.
@@ -4375,6 +4447,8 @@ namespace Falcor
         scene.def(kAddViewpoint.c_str(), pybind11::overload_cast<const float3&, const float3&, const float3&, uint32_t>(&Scene::addViewpoint), "position"_a, "target"_a, "up"_a, "cameraIndex"_a = 0); // add specified viewpoint
         scene.def(kRemoveViewpoint.c_str(), &Scene::removeViewpoint); // remove the selected viewpoint
         scene.def(kSelectViewpoint.c_str(), &Scene::selectViewpoint, "index"_a); // select a viewpoint by index
+        scene.def("createViewpointCameraPath", &Scene::createViewpointCameraPath);
+        scene.def("createAnimatedCameraPath", &Scene::createAnimatedCameraPath, "startTime"_a, "frameRate"_a, "frameCount"_a);
 
         // Meshes
         pybind11::class_<MeshDesc> meshDesc(m, "MeshDesc");
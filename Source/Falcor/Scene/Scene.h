@@ -331,6 +331,7 @@ namespace Falcor
             uint32_t prevVertexCount = 0;                           ///< Number of vertices that the AnimationController needs to allocate to store previous frame vertices.
 
             bool useCompressedHitInfo = false;                      ///< True if scene should used compressed HitInfo (on scenes with triangles meshes only).
+            std::vector<LightCollection::MeshLightTriangle> meshLightTriangles; ///< Emissive triangles pre-integrated on the CPU, or empty to integrate them on the GPU.
             bool has16BitIndices = false;                           ///< True if 16-bit mesh indices are used.
             bool has32BitIndices = false;                           ///< True if 32-bit mesh indices are used.
             uint32_t meshDrawCount = 0;                             ///< Number of meshes to draw.
@@ -636,6 +637,20 @@ namespace Falcor
         */
         bool hasSavedViewpoints() { return mViewpoints.size() > 1; }
 
+        /** Create a precomputed path for the selected camera with one frame per saved viewpoint of that camera.
+            Set the path on the camera with Camera::setPath() and select frames with Camera::setPathFrame().
+        */
+        ref<CameraPath> createViewpointCameraPath();
+
+        /** Create a precomputed path for the selected camera by evaluating its animation at uniformly spaced times.
+            The path is timed, i.e. when set on the camera, update() selects the frame for the current time.
+            If animations are looped, the path repeats after frameCount / frameRate seconds, otherwise it stays on its last frame.
+            \param[in] startTime Time of the first frame in seconds.
+            \param[in] frameRate Frames per second.
+            \param[in] frameCount Number of frames.
+        */
+        ref<CameraPath> createAnimatedCameraPath(double startTime, double frameRate, uint32_t frameCount);
+
         /** Get the set of geometry types used in the scene.
             \return A bit field containing the set of geometry types.
         */
@@ -1216,7 +1231,7 @@ namespace Falcor
         */
         bool updateAnimatable(Animatable& animatable, const AnimationController& controller, bool force = false);
 
-        UpdateFlags updateSelectedCamera(bool forceUpdate);
+        UpdateFlags updateSelectedCamera(bool forceUpdate, double currentTime);
         UpdateFlags updateLights(bool forceUpdate);
         UpdateFlags updateGridVolumes(bool forceUpdate);
         UpdateFlags updateEnvMap(bool forceUpdate);
@@ -1261,6 +1276,7 @@ namespace Falcor
         std::vector<GeometryInstanceData> mGeometryInstanceData;    ///< Geometry instance data (for all types of geometry).
 
         bool mUseCompressedHitInfo = false;                         ///< True if scene should used compressed HitInfo (on scenes with triangles meshes only).
+        std::vector<LightCollection::MeshLightTriangle> mMeshLightTriangles; ///< Emissive triangles pre-integrated by the scene builder. Handed to the light collection when it is first created.
         bool mHas16BitIndices = false;                              ///< True if any meshes use 16-bit indices.
         bool mHas32BitIndices = false;                              ///< True if any meshes use 32-bit indices.
 
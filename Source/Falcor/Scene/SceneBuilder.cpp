@@ -28,6 +28,8 @@
 #include "SceneBuilder.h"
 #include "SceneCache.h"
 #include "Importer.h"
+#include "MeshGroupPartitioner.h"
+#include "Lights/CPUEmissiveIntegrator.h"
 #include "Curves/CurveConfig.h"
 #include "Material/StandardMaterial.h"
 #include "Utils/Logger.h"
@@ -42,6 +44,7 @@
 #include <filesystem>
 #include <cmath>
 #include <execution>
+#include <map>
 
 namespace Falcor
 {
@@ -386,6 +389,15 @@ namespace Falcor
         for (auto& sdfInstanceData : mSceneData.sdfGridInstances) sdfInstanceData.instanceIndex = tlasInstanceIndex++;
 
         mSceneData.useCompressedHitInfo = is_set(mFlags, Flags::UseCompressedHitInfo);
+        if (is_set(mFlags, Flags::UseCPUEmissiveIntegration))
+        {
+            createMeshLightTriangles();
+            timeReport.measure("Integrating emissive triangles");
+        }
+        if (is_set(mFlags, Flags::CompressMeshAnimationCache))
+        {
+            for (auto& cachedMesh : mSceneData.cachedMeshes) cachedMesh.keyframeEncoding = VertexCacheKeyframeStore::Encoding::Delta;
+        }
 
         // Write scene cache if requested.
         if (mWriteSceneCache)
@@ -938,7 +950,7 @@ namespace Falcor
         FALCOR_CHECK(pMaterial != nullptr, "'pMaterial' is missing");
         if (!mpMaterialTextureLoader)
         {
-            mpMaterialTextureLoader.reset(new MaterialTextureLoader(mSceneData.pMaterials->getTextureManager(), !is_set(mFlags, Flags::AssumeLinearSpaceTextures)));
+            mpMaterialTextureLoader.reset(new MaterialTextureLoader(mSceneData.pMaterials->getTextureManager(), !is_set(mFlags, Flags::AssumeLinearSpaceTextures), is_set(mFlags, Flags::UseCPUEmissiveIntegration)));
         }
         std::filesystem::path resolvedPath = mAssetResolver.resolvePath(path);
         mpMaterialTextureLoader->loadTexture(pMaterial, slot, resolvedPath);
@@ -2306,6 +2318,40 @@ namespace Falcor
         return leftList;
     }
 
+    SceneBuilder::MeshGroupList SceneBuilder::splitMeshGroupSAH(MeshGroup& meshGroup) const
+    {
+        // This function partitions a mesh group using a binned SAH hierarchy over the mesh bounds.
+        // The split cost penalizes overlap between the resulting groups, which reduces the number of
+        // BLASes a ray has to traverse. Individual meshes are not split.
+
+        // Early out if splitting is not needed or possible.
+        size_t triangleCount = 0;
+        if (!needsSplit(meshGroup, triangleCount)) return MeshGroupList{ std::move(meshGroup) };
+
+        std::vector<MeshGroupPartitioner::Item> items(meshGroup.meshList.size());
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            const auto& mesh = mMeshes[meshGroup.meshList[i].get()];
+            items[i].bounds = mesh.boundingBox;
+            items[i].triangleCount = mesh.getTriangleCount();
+        }
+
+        auto partition = MeshGroupPartitioner::partition(items, kMaxTrianglesPerBLAS);
+        FALCOR_ASSERT(!partition.empty());
+
+        MeshGroupList groups;
+        groups.reserve(partition.size());
+        for (const auto& indices : partition)
+        {
+            MeshGroup group{ std::vector<MeshID>(), meshGroup.isStatic };
+            group.meshList.reserve(indices.size());
+            for (uint32_t i : indices) group.meshList.push_back(meshGroup.meshList[i]);
+            groups.push_back(std::move(group));
+        }
+
+        return groups;
+    }
+
     void SceneBuilder::optimizeGeometry()
     {
         // This function optimizes the geometry for raytracing performance and memory usage.
@@ -2318,6 +2364,11 @@ namespace Falcor
         //  - Split large mesh groups (BLASes) into multiple smaller ones.
         //  - Split large meshes into smaller to reduce spatial overlap between BLASes.
         //  - Sort meshes into BLASes based on spatial locality.
+        //
+        // The default is to partition groups using a binned SAH hierarchy, see MeshGroupPartitioner.
+        // Meshes are kept whole, so a mesh straddling a split ends up in one group and its bounds overlap the other.
+        // The midpoint splitter splits straddling meshes instead, at the cost of more meshes. It is used if
+        // Flags::SplitMeshGroupsAtMidpoint is set.
 
         MeshGroupList optimizedGroups;
 
@@ -2325,7 +2376,9 @@ namespace Falcor
         {
             //auto groups = splitMeshGroupSimple(meshGroup);
             //auto groups = splitMeshGroupMedian(meshGroup);
-            auto groups = splitMeshGroupMidpointMeshes(meshGroup);
+            auto groups = is_set(mFlags, Flags::SplitMeshGroupsAtMidpoint)
+                ? splitMeshGroupMidpointMeshes(meshGroup)
+                : splitMeshGroupSAH(meshGroup);
 
             if (groups.size() > 1) logWarning("SceneBuilder::optimizeGeometry() performance warning - Mesh group was split into {} groups.", groups.size());
 
@@ -2810,6 +2863,148 @@ namespace Falcor
         mSceneData.meshDrawCount = (uint32_t)drawCount;
     }
 
+    void SceneBuilder::createMeshLightTriangles()
+    {
+        // Pre-integrate the emissive triangles in the order LightCollection::setupMeshLights() creates them.
+        // This uses the final vertex data and the emissive texels kept while decoding the textures,
+        // so the light collection needs neither the GPU integrator nor a readback of the triangle data.
+        FALCOR_ASSERT(mSceneData.meshLightTriangles.empty());
+
+        TextureManager& textureManager = mSceneData.pMaterials->getTextureManager();
+        CPUEmissiveIntegrator integrator;
+        bool isCPUReadable = true;
+
+        // Create one emitter per emissive material. Texels are taken from the texture manager for all emissive
+        // textures, so that none of them stay in memory even if we fall back to the GPU integrator.
+        const uint32_t materialCount = mSceneData.pMaterials->getMaterialCount();
+        std::vector<uint32_t> materialToEmitter(materialCount, CPUEmissiveIntegrator::kInvalidIndex);
+        std::map<const Texture*, uint32_t> textureToIndex;
+        for (uint32_t materialID = 0; materialID < materialCount; materialID++)
+        {
+            auto pMaterial = mSceneData.pMaterials->getMaterial(MaterialID(materialID))->toBasicMaterial();
+            if (!pMaterial || !pMaterial->isEmissive()) continue;
+
+            CPUEmissiveIntegrator::Emitter emitter;
+            emitter.emissive = pMaterial->getData().emissive;
+            emitter.emissiveFactor = pMaterial->getData().emissiveFactor;
+
+            if (const auto& pTexture = pMaterial->getEmissiveTexture())
+            {
+                if (auto it = textureToIndex.find(pTexture.get()); it != textureToIndex.end())
+                {
+                    emitter.textureIndex = it->second;
+                }
+                else
+                {
+                    auto pTexels = textureManager.takeTextureTexels(pTexture.get());
+                    if (!pTexels || pTexels->width != pTexture->getWidth() || pTexels->height != pTexture->getHeight())
+                    {
+                        logInfo("SceneBuilder: Emissive texture '{}' of material '{}' can't be read on the CPU.", pTexture->getSourcePath(), pMaterial->getName());
+                        isCPUReadable = false;
+                        continue;
+                    }
+
+                    // Texels are fetched with the addressing modes of the material sampler, as on the GPU.
+                    const auto& pSampler = pMaterial->getDefaultTextureSampler();
+                    FALCOR_ASSERT(pSampler);
+                    CPUEmissiveIntegrator::Texture texture;
+                    texture.width = pTexels->width;
+                    texture.height = pTexels->height;
+                    texture.texels = std::move(pTexels->data);
+                    texture.addressModeU = pSampler->getAddressModeU();
+                    texture.addressModeV = pSampler->getAddressModeV();
+                    texture.borderColor = pSampler->getBorderColor();
+                    emitter.textureIndex = integrator.addTexture(std::move(texture));
+                    textureToIndex[pTexture.get()] = emitter.textureIndex;
+                }
+            }
+
+            materialToEmitter[materialID] = integrator.addEmitter(emitter);
+        }
+
+        // Compute the global matrices. Parent nodes are stored before their children.
+        std::vector<float4x4> globalMatrices(mSceneData.sceneGraph.size());
+        for (size_t i = 0; i < globalMatrices.size(); i++)
+        {
+            const auto& node = mSceneData.sceneGraph[i];
+            globalMatrices[i] = node.parent != NodeID::Invalid() ? mul(globalMatrices[node.parent.get()], node.transform) : node.transform;
+        }
+
+        // Create the triangles of all emissive mesh instances in world space.
+        std::vector<LightCollection::MeshLightTriangle> triangles;
+        std::vector<CPUEmissiveIntegrator::Triangle> integratorTriangles;
+        uint32_t lightIdx = 0;
+        for (const auto& instance : mSceneData.meshInstanceData)
+        {
+            if (instance.getType() != GeometryType::TriangleMesh) continue;
+            const uint32_t emitterIndex = materialToEmitter[instance.materialID];
+            if (emitterIndex == CPUEmissiveIntegrator::kInvalidIndex)
+            {
+                // Skip non-emissive instances. Emissive materials without an emitter have unreadable textures.
+                auto pMaterial = mSceneData.pMaterials->getMaterial(MaterialID::fromSlang(instance.materialID))->toBasicMaterial();
+                if (pMaterial && pMaterial->isEmissive()) isCPUReadable = false;
+                continue;
+            }
+
+            // The vertices of moving and deforming instances are only known at runtime.
+            const NodeID nodeID = NodeID::fromSlang(instance.globalMatrixID);
+            if (instance.isDynamic() || isNodeAnimated(nodeID))
+            {
+                logInfo("SceneBuilder: Emissive mesh '{}' is animated.", mMeshes[instance.geometryID].name);
+                isCPUReadable = false;
+                continue;
+            }
+
+            const MeshDesc& mesh = mSceneData.meshDesc[instance.geometryID];
+            const float4x4& transform = globalMatrices[nodeID.get()];
+            const bool isWorldFrontFaceCW = mesh.isFrontFaceCW() ^ (determinant(float3x3(transform)) < 0.f);
+            const uint16_t* pIndices16 = reinterpret_cast<const uint16_t*>(mSceneData.meshIndexData.data() + instance.ibOffset);
+            const uint32_t* pIndices32 = mSceneData.meshIndexData.data() + instance.ibOffset;
+            const bool use16BitIndices = (instance.flags & (uint32_t)GeometryInstanceFlags::Use16BitIndices) != 0;
+
+            for (uint32_t triangleIndex = 0; triangleIndex < mesh.getTriangleCount(); triangleIndex++)
+            {
+                LightCollection::MeshLightTriangle tri;
+                CPUEmissiveIntegrator::Triangle integratorTri;
+                for (uint32_t j = 0; j < 3; j++)
+                {
+                    uint32_t index = triangleIndex * 3 + j;
+                    if (mesh.useVertexIndices()) index = use16BitIndices ? pIndices16[index] : pIndices32[index];
+                    const auto& vertex = mSceneData.meshStaticData[instance.vbOffset + index];
+                    tri.vtx[j].pos = transformPoint(transform, vertex.position);
+                    tri.vtx[j].uv = vertex.texCrd;
+                    integratorTri.texCoords[j] = vertex.texCrd;
+                }
+
+                // Same as Scene::computeFaceNormalAndAreaW() on the GPU.
+                float3 N = cross(tri.vtx[1].pos - tri.vtx[0].pos, tri.vtx[2].pos - tri.vtx[0].pos);
+                tri.area = 0.5f * length(N);
+                tri.normal = normalize(isWorldFrontFaceCW ? -N : N);
+                tri.lightIdx = lightIdx;
+
+                integratorTri.area = tri.area;
+                integratorTri.emitterIndex = emitterIndex;
+                triangles.push_back(tri);
+                integratorTriangles.push_back(integratorTri);
+            }
+            lightIdx++;
+        }
+
+        if (!isCPUReadable)
+        {
+            logInfo("SceneBuilder: Emissive triangles will be integrated on the GPU.");
+            return;
+        }
+
+        std::vector<CPUEmissiveIntegrator::Result> results = integrator.integrate(integratorTriangles);
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            triangles[i].flux = results[i].flux;
+            triangles[i].averageRadiance = results[i].averageRadiance;
+        }
+        mSceneData.meshLightTriangles = std::move(triangles);
+    }
+
     void SceneBuilder::createCurveData()
     {
         auto& curveData = mSceneData.curveDesc;
@@ -2939,6 +3134,9 @@ namespace Falcor
         flags.value("DontUseDisplacement", SceneBuilder::Flags::DontUseDisplacement);
         flags.value("UseCompressedHitInfo", SceneBuilder::Flags::UseCompressedHitInfo);
         flags.value("TessellateCurvesIntoPolyTubes", SceneBuilder::Flags::TessellateCurvesIntoPolyTubes);
+        flags.value("UseCPUEmissiveIntegration", SceneBuilder::Flags::UseCPUEmissiveIntegration);
+        flags.value("CompressMeshAnimationCache", SceneBuilder::Flags::CompressMeshAnimationCache);
+        flags.value("SplitMeshGroupsAtMidpoint", SceneBuilder::Flags::SplitMeshGroupsAtMidpoint);
         flags.value("UseCache", SceneBuilder::Flags::UseCache);
         flags.value("RebuildCache", SceneBuilder::Flags::RebuildCache);
         ScriptBindings::addEnumBinaryOperators(flags);
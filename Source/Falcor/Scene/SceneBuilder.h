@@ -77,6 +77,9 @@ namespace Falcor
             DontUseDisplacement             = 0x4000,   ///< Don't use displacement mapping.
             UseCompressedHitInfo            = 0x8000,   ///< Use compressed hit info (on scenes with triangle meshes only).
             TessellateCurvesIntoPolyTubes   = 0x10000,  ///< Tessellate curves into poly-tubes (the default is linear swept spheres).
+            UseCPUEmissiveIntegration       = 0x20000,  ///< Pre-integrate emissive triangles on the CPU when building the scene, from the mesh data and the emissive textures decoded while loading. Falls back to the GPU integrator if an emissive instance is animated or an emissive texture can't be read on the CPU.
+            CompressMeshAnimationCache      = 0x40000,  ///< Store the keyframes of cached mesh animations with 16-bit quantized, delta-encoded positions. This is lossy but reduces host memory use and upload bandwidth.
+            SplitMeshGroupsAtMidpoint       = 0x80000,  ///< Split large mesh groups recursively at the spatial midpoint, splitting meshes that straddle the plane. By default, groups are partitioned with a binned SAH hierarchy that keeps meshes whole.
 
             UseCache                        = 0x10000000, ///< Enable scene caching. This caches the runtime scene representation on disk to reduce load time.
             RebuildCache                    = 0x20000000, ///< Rebuild scene cache.
@@ -806,6 +809,7 @@ namespace Falcor
         MeshGroupList splitMeshGroupSimple(MeshGroup& meshGroup) const;
         MeshGroupList splitMeshGroupMedian(MeshGroup& meshGroup) const;
         MeshGroupList splitMeshGroupMidpointMeshes(MeshGroup& meshGroup);
+        MeshGroupList splitMeshGroupSAH(MeshGroup& meshGroup) const;
 
         // Post processing
         void prepareDisplacementMaps();
@@ -831,6 +835,7 @@ namespace Falcor
         // Scene setup
         void createMeshData();
         void createMeshInstanceData(uint32_t& tlasInstanceIndex);
+        void createMeshLightTriangles();
         void createCurveData();
         void createCurveInstanceData(uint32_t& tlasInstanceIndex);
         void createSceneGraph();
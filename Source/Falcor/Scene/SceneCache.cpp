@@ -43,7 +43,7 @@ namespace Falcor
         /** Specfies the current cache file version.
             This needs to be incremented every time the file format changes!
         */
-        const uint32_t kVersion = 25;
+        const uint32_t kVersion = 28;
 
         /** Scene cache directory (subdirectory in the application data directory).
         */
@@ -342,8 +342,10 @@ namespace Falcor
             stream.write(cachedMesh.timeSamples);
             stream.write((uint32_t)cachedMesh.vertexData.size());
             for (const auto& data : cachedMesh.vertexData) stream.write(data);
+            stream.write(cachedMesh.keyframeEncoding);
         }
         stream.write(sceneData.useCompressedHitInfo);
+        stream.write(sceneData.meshLightTriangles);
         stream.write(sceneData.has16BitIndices);
         stream.write(sceneData.has32BitIndices);
         stream.write(sceneData.meshDrawCount);
@@ -463,8 +465,10 @@ namespace Falcor
             stream.read(cachedMesh.timeSamples);
             cachedMesh.vertexData.resize(stream.read<uint32_t>());
             for (auto& data : cachedMesh.vertexData) stream.read(data);
+            stream.read(cachedMesh.keyframeEncoding);
         }
         stream.read(sceneData.useCompressedHitInfo);
+        stream.read(sceneData.meshLightTriangles);
         stream.read(sceneData.has16BitIndices);
         stream.read(sceneData.has32BitIndices);
         stream.read(sceneData.meshDrawCount);
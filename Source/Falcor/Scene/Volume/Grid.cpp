@@ -35,8 +35,13 @@
 #include "Utils/Math/Common.h"
 #include "Utils/Math/Vector.h"
 #include "Utils/Math/Matrix.h"
+#include "Utils/CryptoUtils.h"
 #include "GlobalState.h"
 #include "Utils/PathResolving.h"
+#include "Core/Platform/MemoryMappedFile.h"
+#include "Core/Platform/OS.h"
+#include <cstring>
+#include <thread>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -75,6 +80,108 @@ namespace Falcor
         {
             return int3(c[0], c[1], c[2]);
         }
+
+        const std::string kConvertedGridCacheDirectory = "NVIDIA/Falcor/GridCache";
+
+        /** Read a grid from a memory-mapped NanoVDB file.
+            A NanoVDB file consists of segments, each holding a header, the meta data of all its grids followed by the grid data.
+            Only the requested grid is copied out of the mapping into a host buffer (NanoVDB requires aligned grid data).
+            \return Grid handle, or an empty handle if the grid was not found or the file can't be read this way
+            (e.g. compressed grids), in which case the caller falls back to the NanoVDB stream reader.
+        */
+        nanovdb::GridHandle<nanovdb::HostBuffer> readMappedGrid(const std::filesystem::path& path, const std::string& gridname)
+        {
+            MemoryMappedFile file(path, MemoryMappedFile::kWholeFile, MemoryMappedFile::AccessHint::RandomAccess);
+            if (!file.isOpen()) return {};
+
+            const uint8_t* pData = static_cast<const uint8_t*>(file.getData());
+            const size_t size = file.getMappedSize();
+            size_t offset = 0;
+
+            while (offset + sizeof(nanovdb::io::Header) <= size)
+            {
+                nanovdb::io::Header header;
+                std::memcpy(&header, pData + offset, sizeof(header));
+                if (!header.isValid() || header.codec != nanovdb::io::Codec::NONE) return {};
+                offset += sizeof(header);
+
+                // Find the grid in the segment's meta data. Grid data follows the meta data in the same order.
+                size_t gridOffset = 0;
+                size_t gridSize = 0;
+                size_t dataOffset = 0;
+                for (uint32_t i = 0; i < header.gridCount; ++i)
+                {
+                    nanovdb::io::MetaData meta;
+                    if (offset + sizeof(meta) > size) return {};
+                    std::memcpy(&meta, pData + offset, sizeof(meta));
+                    offset += sizeof(meta);
+                    if (offset + meta.nameSize > size) return {};
+                    const char* pName = reinterpret_cast<const char*>(pData + offset);
+                    offset += meta.nameSize;
+
+                    if (gridSize == 0 && std::string(pName, strnlen(pName, meta.nameSize)) == gridname)
+                    {
+                        gridOffset = dataOffset;
+                        gridSize = meta.gridSize;
+                        if (meta.fileSize != meta.gridSize) return {};
+                    }
+                    dataOffset += meta.fileSize;
+                }
+
+                if (gridSize > 0)
+                {
+                    if (offset + gridOffset + gridSize > size) return {};
+                    auto buffer = nanovdb::HostBuffer::create(gridSize);
+                    std::memcpy(buffer.data(), pData + offset + gridOffset, gridSize);
+                    return nanovdb::GridHandle<nanovdb::HostBuffer>(std::move(buffer));
+                }
+
+                // Skip grids of this segment.
+                offset += dataOffset;
+            }
+
+            return {};
+        }
+
+        /** Get the path of the cached NanoVDB file for a grid converted from an OpenVDB file.
+            The cache key includes the file size and modification time, so modified files are converted again.
+        */
+        std::filesystem::path getConvertedGridCachePath(const std::filesystem::path& path, const std::string& gridname)
+        {
+            std::error_code ec;
+            auto absolutePath = std::filesystem::absolute(path, ec);
+            auto fileSize = std::filesystem::file_size(path, ec);
+            auto writeTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+            SHA1 sha1;
+            sha1.update(absolutePath.string());
+            sha1.update(gridname);
+            sha1.update(uint64_t(fileSize));
+            sha1.update(int64_t(writeTime));
+            return getAppDataDirectory() / kConvertedGridCacheDirectory / (SHA1::toString(sha1.finalize()) + ".nvdb");
+        }
+
+        bool validateFloatGrid(
+            const nanovdb::GridHandle<nanovdb::HostBuffer>& handle,
+            const std::filesystem::path& path,
+            const std::string& gridname
+        )
+        {
+            auto floatGrid = handle.grid<float>();
+            if (!floatGrid || floatGrid->gridType() != nanovdb::GridType::Float)
+            {
+                logWarning("Error when loading grid. Grid '{}' in '{}' is not of type float.", gridname, path);
+                return false;
+            }
+
+            if (floatGrid->isEmpty())
+            {
+                logWarning("Grid '{}' in '{}' is empty.", gridname, path);
+                return false;
+            }
+
+            return true;
+        }
     }
 
     ref<Grid> Grid::createSphere(ref<Device> pDevice, float radius, float voxelSize, float blendRange)
@@ -90,25 +197,32 @@ namespace Falcor
     }
 
     ref<Grid> Grid::createFromFile(ref<Device> pDevice, const std::filesystem::path& path, const std::string& gridname)
+    {
+        auto handle = loadGridHandle(path, gridname);
+        if (!handle) return nullptr;
+        return ref<Grid>(new Grid(pDevice, std::move(handle)));
+    }
+
+    nanovdb::GridHandle<nanovdb::HostBuffer> Grid::loadGridHandle(const std::filesystem::path& path, const std::string& gridname)
     {
         if (!std::filesystem::exists(path))
         {
             logWarning("Error when loading grid. Can't open grid file '{}'.", path);
-            return nullptr;
+            return {};
         }
 
         if (hasExtension(path, "nvdb"))
         {
-            return createFromNanoVDBFile(pDevice, path, gridname);
+            return loadNanoVDBFile(path, gridname);
         }
         else if (hasExtension(path, "vdb"))
         {
-            return createFromOpenVDBFile(pDevice, path, gridname);
+            return loadOpenVDBFile(path, gridname);
         }
         else
         {
             logWarning("Error when loading grid. Unsupported grid file '{}'.", path);
-            return nullptr;
+            return {};
         }
     }
 
@@ -207,6 +321,20 @@ namespace Falcor
         , mGridHandle(std::move(gridHandle))
         , mpFloatGrid(mGridHandle.grid<float>())
         , mAccessor(mpFloatGrid->getAccessor())
+    {
+        createDeviceData();
+    }
+
+    void Grid::setGridHandle(nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle)
+    {
+        FALCOR_ASSERT(gridHandle.grid<float>());
+        mGridHandle = std::move(gridHandle);
+        mpFloatGrid = mGridHandle.grid<float>();
+        mAccessor = mpFloatGrid->getAccessor();
+        createDeviceData();
+    }
+
+    void Grid::createDeviceData()
     {
         if (!mpFloatGrid->hasMinMax())
         {
@@ -225,39 +353,45 @@ namespace Falcor
         mBrickedGrid = NanoVDBGridConverter(mpFloatGrid).convert(mpDevice);
     }
 
-    ref<Grid> Grid::createFromNanoVDBFile(ref<Device> pDevice, const std::filesystem::path& path, const std::string& gridname)
+    nanovdb::GridHandle<nanovdb::HostBuffer> Grid::loadNanoVDBFile(const std::filesystem::path& path, const std::string& gridname)
     {
-        if (!nanovdb::io::hasGrid(path.string(), gridname))
-        {
-            logWarning("Error when loading grid. Can't find grid '{}' in '{}'.", gridname, path);
-            return nullptr;
-        }
+        // Try to read the grid directly from a memory mapping of the file first.
+        auto handle = readMappedGrid(path, gridname);
 
-        auto handle = nanovdb::io::readGrid(path.string(), gridname);
         if (!handle)
         {
-            logWarning("Error when loading grid.");
-            return nullptr;
-        }
+            if (!nanovdb::io::hasGrid(path.string(), gridname))
+            {
+                logWarning("Error when loading grid. Can't find grid '{}' in '{}'.", gridname, path);
+                return {};
+            }
 
-        auto floatGrid = handle.grid<float>();
-        if (!floatGrid || floatGrid->gridType() != nanovdb::GridType::Float)
-        {
-            logWarning("Error when loading grid. Grid '{}' in '{}' is not of type float.", gridname, path);
-            return nullptr;
+            handle = nanovdb::io::readGrid(path.string(), gridname);
+            if (!handle)
+            {
+                logWarning("Error when loading grid.");
+                return {};
+            }
         }
 
-        if (floatGrid->isEmpty())
-        {
-            logWarning("Grid '{}' in '{}' is empty.", gridname, path);
-            return nullptr;
-        }
+        if (!validateFloatGrid(handle, path, gridname)) return {};
 
-        return ref<Grid>(new Grid(pDevice, std::move(handle)));
+        return handle;
     }
 
-    ref<Grid> Grid::createFromOpenVDBFile(ref<Device> pDevice, const std::filesystem::path& path, const std::string& gridname)
+    nanovdb::GridHandle<nanovdb::HostBuffer> Grid::loadOpenVDBFile(const std::filesystem::path& path, const std::string& gridname)
     {
+        // Use the cached NanoVDB conversion if available.
+        const auto cachePath = getConvertedGridCachePath(path, gridname);
+        if (std::filesystem::exists(cachePath))
+        {
+            if (auto handle = readMappedGrid(cachePath, gridname); handle && handle.grid<float>())
+            {
+                logDebug("Loaded grid '{}' in '{}' from cache '{}'.", gridname, path, cachePath);
+                return handle;
+            }
+        }
+
         openvdb::initialize();
 
         openvdb::io::File file(path.string());
@@ -278,27 +412,41 @@ namespace Falcor
         if (!baseGrid)
         {
             logWarning("Error when loading grid. Can't find grid '{}' in '{}'.", gridname, path);
-            return nullptr;
+            return {};
         }
 
         if (!baseGrid->isType<openvdb::FloatGrid>())
         {
             logWarning("Error when loading grid. Grid '{}' in '{}' is not of type float.", gridname, path);
-            return nullptr;
+            return {};
         }
 
         if (baseGrid->empty())
         {
             logWarning("Grid '{}' in '{}' is empty.", gridname, path);
-            return nullptr;
+            return {};
         }
 
         openvdb::FloatGrid::Ptr floatGrid = openvdb::gridPtrCast<openvdb::FloatGrid>(baseGrid);
         auto handle = nanovdb::openToNanoVDB(floatGrid);
 
-        return ref<Grid>(new Grid(pDevice, std::move(handle)));
-    }
+        // Write the converted grid to the cache. Write to a temporary file first, as other threads or processes
+        // may read the cache concurrently. Failing to write the cache is not an error.
+        try
+        {
+            std::filesystem::create_directories(cachePath.parent_path());
+            auto tempPath = cachePath;
+            tempPath += fmt::format(".{}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+            nanovdb::io::writeGrid(tempPath.string(), handle);
+            std::filesystem::rename(tempPath, cachePath);
+        }
+        catch (const std::exception& e)
+        {
+            logWarning("Failed to write grid cache '{}': {}", cachePath, e.what());
+        }
 
+        return handle;
+    }
 
     FALCOR_SCRIPT_BINDING(Grid)
     {
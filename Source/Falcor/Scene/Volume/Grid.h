@@ -89,6 +89,16 @@ namespace Falcor
         */
         static ref<Grid> createFromFile(ref<Device> pDevice, const std::filesystem::path& path, const std::string& gridname);
 
+        /** Load a grid from a file into host memory, without creating any GPU resources.
+            NanoVDB files are memory-mapped. OpenVDB grids are converted to NanoVDB and the result is cached to disk,
+            so subsequent loads of the same grid read the cached NanoVDB file instead.
+            This function is thread-safe.
+            \param[in] path File path of the grid (absolute or relative to working directory).
+            \param[in] gridname Name of the grid to load.
+            \return NanoVDB grid handle holding a float grid, or an empty handle if the grid failed to load.
+        */
+        static nanovdb::GridHandle<nanovdb::HostBuffer> loadGridHandle(const std::filesystem::path& path, const std::string& gridname);
+
         /** Render the UI.
         */
         void renderUI(Gui::Widgets& widget);
@@ -147,8 +157,15 @@ namespace Falcor
     private:
         Grid(ref<Device> pDevice, nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle);
 
-        static ref<Grid> createFromNanoVDBFile(ref<Device>, const std::filesystem::path& path, const std::string& gridname);
-        static ref<Grid> createFromOpenVDBFile(ref<Device>, const std::filesystem::path& path, const std::string& gridname);
+        /** Replace the grid data and recreate the GPU resources.
+            This is used by streamed grid sequences, which reuse a single grid object for all frames.
+            \param[in] gridHandle NanoVDB grid handle holding a float grid.
+        */
+        void setGridHandle(nanovdb::GridHandle<nanovdb::HostBuffer> gridHandle);
+        void createDeviceData();
+
+        static nanovdb::GridHandle<nanovdb::HostBuffer> loadNanoVDBFile(const std::filesystem::path& path, const std::string& gridname);
+        static nanovdb::GridHandle<nanovdb::HostBuffer> loadOpenVDBFile(const std::filesystem::path& path, const std::string& gridname);
 
         ref<Device> mpDevice;
 
@@ -161,5 +178,6 @@ namespace Falcor
         BrickedGrid mBrickedGrid;
 
         friend class SceneCache;
+        friend class GridSequenceStream;
     };
 }
@@ -0,0 +1,342 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Error.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+    /** Residency cache for frames of a grid sequence.
+
+        Keeps a bounded window of resident frames in host memory. Frames are loaded on demand by get().
+        Upcoming frames in the current playback direction are prefetched on a background thread.
+        When the number of resident frames exceeds the capacity, the least recently used frame is evicted.
+        The current frame and the frames being prefetched are never evicted.
+
+        Playback wraps around at the end of the sequence, so prefetching does as well.
+        The cache is independent of the frame data type to allow testing the residency logic in isolation.
+        All functions are thread-safe.
+    */
+    template<typename T>
+    class GridFrameCache
+    {
+    public:
+        using Value = std::shared_ptr<const T>;
+
+        /** Function loading a frame. Called from the thread calling get() or from the prefetch thread.
+            Returns nullptr if the frame can't be loaded. Empty frames are cached like any other frame.
+        */
+        using LoadFunc = std::function<std::shared_ptr<const T>(uint32_t frame)>;
+
+        struct Stats
+        {
+            uint64_t hits = 0;          ///< Number of get() calls returning a resident frame.
+            uint64_t misses = 0;        ///< Number of get() calls that had to load or wait for the frame.
+            uint64_t prefetches = 0;    ///< Number of frames loaded by the prefetch thread.
+            uint64_t evictions = 0;     ///< Number of evicted frames.
+        };
+
+        /** Constructor.
+            \param[in] frameCount Number of frames in the sequence.
+            \param[in] capacity Maximum number of resident frames (at least 1).
+            \param[in] prefetchCount Number of frames to prefetch ahead of the current frame. Clamped to capacity - 1.
+            \param[in] loadFunc Function loading a frame.
+        */
+        GridFrameCache(uint32_t frameCount, uint32_t capacity, uint32_t prefetchCount, LoadFunc loadFunc)
+            : mLoadFunc(std::move(loadFunc))
+            , mEntries(frameCount)
+            , mCapacity(std::max(capacity, 1u))
+            , mPrefetchCount(std::min(prefetchCount, mCapacity - 1))
+        {
+            FALCOR_CHECK(frameCount > 0, "Grid sequence must have at least one frame.");
+            FALCOR_CHECK(mLoadFunc, "Missing load function.");
+            if (mPrefetchCount > 0) mThread = std::thread(&GridFrameCache::prefetchThread, this);
+        }
+
+        ~GridFrameCache()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mTerminate = true;
+                mPrefetchQueue.clear();
+            }
+            mCondition.notify_all();
+            if (mThread.joinable()) mThread.join();
+        }
+
+        GridFrameCache(const GridFrameCache&) = delete;
+        GridFrameCache& operator=(const GridFrameCache&) = delete;
+
+        /** Get a frame and make it the current frame.
+            Blocks until the frame is loaded. Prefetching of the following frames is started before returning.
+            \param[in] frame Frame index.
+            \return The frame data, or nullptr if the frame can't be loaded.
+        */
+        Value get(uint32_t frame)
+        {
+            FALCOR_CHECK(frame < getFrameCount(), "Frame index {} is out of range.", frame);
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            updateDirection(frame);
+            mCurrentFrame = frame;
+
+            auto& entry = mEntries[frame];
+            if (entry.resident)
+            {
+                mStats.hits++;
+            }
+            else
+            {
+                mStats.misses++;
+                if (entry.loading)
+                {
+                    // Frame is being prefetched. Wait for it.
+                    mCondition.wait(lock, [&]() { return !entry.loading; });
+                }
+                else
+                {
+                    entry.loading = true;
+                    lock.unlock();
+                    auto value = load(frame);
+                    lock.lock();
+                    entry.loading = false;
+                    entry.value = std::move(value);
+                    entry.resident = true;
+                    mCondition.notify_all();
+                }
+            }
+
+            entry.lastUse = ++mUseCounter;
+            Value value = entry.value;
+            schedulePrefetch();
+            evict();
+            return value;
+        }
+
+        /** Get a frame if it is resident, without changing the current frame.
+            \param[in] frame Frame index.
+            \return The frame data, or nullptr if the frame is not resident.
+        */
+        Value tryGet(uint32_t frame) const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return frame < mEntries.size() && mEntries[frame].resident ? mEntries[frame].value : nullptr;
+        }
+
+        /** Check if a frame is resident.
+        */
+        bool isResident(uint32_t frame) const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return frame < mEntries.size() && mEntries[frame].resident;
+        }
+
+        /** Get a sorted list of the resident frames.
+        */
+        std::vector<uint32_t> getResidentFrames() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::vector<uint32_t> frames;
+            for (uint32_t i = 0; i < (uint32_t)mEntries.size(); ++i)
+            {
+                if (mEntries[i].resident) frames.push_back(i);
+            }
+            return frames;
+        }
+
+        /** Block until all scheduled prefetches have finished.
+        */
+        void waitForPrefetch()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&]() { return mPrefetchQueue.empty() && !mPrefetching; });
+        }
+
+        /** Get the playback direction (+1 forward, -1 backward) as detected from the sequence of requested frames.
+        */
+        int getDirection() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mDirection;
+        }
+
+        Stats getStats() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mStats;
+        }
+
+        uint32_t getFrameCount() const { return (uint32_t)mEntries.size(); }
+        uint32_t getCapacity() const { return mCapacity; }
+        uint32_t getPrefetchCount() const { return mPrefetchCount; }
+
+    private:
+        struct Entry
+        {
+            Value value;
+            bool resident = false;
+            bool loading = false;
+            uint64_t lastUse = 0;
+        };
+
+        static constexpr uint32_t kInvalidFrame = uint32_t(-1);
+
+        Value load(uint32_t frame)
+        {
+            try
+            {
+                return mLoadFunc(frame);
+            }
+            catch (const std::exception& e)
+            {
+                logWarning("Failed to load grid sequence frame {}: {}", frame, e.what());
+                return nullptr;
+            }
+        }
+
+        uint32_t step(uint32_t frame, int direction, uint32_t count) const
+        {
+            const uint32_t frameCount = getFrameCount();
+            count %= frameCount;
+            return direction > 0 ? (frame + count) % frameCount : (frame + frameCount - count) % frameCount;
+        }
+
+        void updateDirection(uint32_t frame)
+        {
+            if (mCurrentFrame == kInvalidFrame || frame == mCurrentFrame) return;
+
+            // Detect single steps including wrap-around first, otherwise use the sign of the jump.
+            if (frame == step(mCurrentFrame, 1, 1)) mDirection = 1;
+            else if (frame == step(mCurrentFrame, -1, 1)) mDirection = -1;
+            else mDirection = frame > mCurrentFrame ? 1 : -1;
+        }
+
+        bool isProtected(uint32_t frame) const
+        {
+            if (frame == mCurrentFrame) return true;
+            for (uint32_t i = 1; i <= mPrefetchCount; ++i)
+            {
+                if (frame == step(mCurrentFrame, mDirection, i)) return true;
+            }
+            return false;
+        }
+
+        void schedulePrefetch()
+        {
+            // Replace any stale requests with the frames following the current one.
+            mPrefetchQueue.clear();
+            for (uint32_t i = 1; i <= mPrefetchCount; ++i)
+            {
+                uint32_t frame = step(mCurrentFrame, mDirection, i);
+                if (frame == mCurrentFrame) break;
+                if (!mEntries[frame].resident && !mEntries[frame].loading) mPrefetchQueue.push_back(frame);
+            }
+            if (!mPrefetchQueue.empty()) mCondition.notify_all();
+        }
+
+        void evict()
+        {
+            uint32_t residentCount = 0;
+            for (const auto& entry : mEntries) residentCount += entry.resident ? 1 : 0;
+
+            while (residentCount > mCapacity)
+            {
+                uint32_t lruFrame = kInvalidFrame;
+                for (uint32_t i = 0; i < (uint32_t)mEntries.size(); ++i)
+                {
+                    const auto& entry = mEntries[i];
+                    if (!entry.resident || isProtected(i)) continue;
+                    if (lruFrame == kInvalidFrame || entry.lastUse < mEntries[lruFrame].lastUse) lruFrame = i;
+                }
+                if (lruFrame == kInvalidFrame) break;
+
+                mEntries[lruFrame].value.reset();
+                mEntries[lruFrame].resident = false;
+                mStats.evictions++;
+                residentCount--;
+            }
+        }
+
+        void prefetchThread()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (true)
+            {
+                mCondition.wait(lock, [&]() { return mTerminate || !mPrefetchQueue.empty(); });
+                if (mTerminate) break;
+
+                uint32_t frame = mPrefetchQueue.front();
+                mPrefetchQueue.pop_front();
+                auto& entry = mEntries[frame];
+                if (entry.resident || entry.loading) continue;
+
+                entry.loading = true;
+                mPrefetching = true;
+                lock.unlock();
+                auto value = load(frame);
+                lock.lock();
+                entry.loading = false;
+                entry.value = std::move(value);
+                entry.resident = true;
+                // Prefetched frames count as used now, so they are not the first to be evicted.
+                entry.lastUse = ++mUseCounter;
+                mPrefetching = false;
+                mStats.prefetches++;
+                evict();
+                mCondition.notify_all();
+            }
+        }
+
+        LoadFunc mLoadFunc;
+
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::thread mThread;
+
+        // Internal state. Do not access outside of critical section.
+        std::vector<Entry> mEntries;
+        std::deque<uint32_t> mPrefetchQueue;
+        const uint32_t mCapacity;
+        const uint32_t mPrefetchCount;
+        uint32_t mCurrentFrame = kInvalidFrame;
+        int mDirection = 1;
+        uint64_t mUseCounter = 0;
+        bool mPrefetching = false;
+        bool mTerminate = false;
+        Stats mStats;
+    };
+}
@@ -0,0 +1,100 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "GridSequenceStream.h"
+#include "Utils/Logger.h"
+#include <cstring>
+
+namespace Falcor
+{
+    std::unique_ptr<GridSequenceStream> GridSequenceStream::create(ref<Device> pDevice, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const Options& options)
+    {
+        if (paths.empty()) return nullptr;
+
+        std::unique_ptr<GridSequenceStream> pStream(new GridSequenceStream(pDevice, paths, gridname, options));
+
+        // Create the grid object from the first frame that holds a valid grid.
+        for (uint32_t frame = 0; frame < pStream->getFrameCount(); ++frame)
+        {
+            if (auto pHandle = pStream->mCache.get(frame))
+            {
+                pStream->mpGrid = ref<Grid>(new Grid(pDevice, copyGridHandle(*pHandle)));
+                pStream->mGridFrame = frame;
+                break;
+            }
+        }
+
+        if (!pStream->mpGrid)
+        {
+            logWarning("Error when streaming grid sequence. None of the {} files contain a valid grid '{}'.", paths.size(), gridname);
+            return nullptr;
+        }
+
+        pStream->setFrame(0);
+        return pStream;
+    }
+
+    bool GridSequenceStream::setFrame(uint32_t frame)
+    {
+        FALCOR_CHECK(frame < getFrameCount(), "Frame index {} is out of range.", frame);
+
+        mFrame = frame;
+        auto pHandle = mCache.get(frame);
+        mFrameValid = pHandle != nullptr;
+
+        // Upload the frame to the grid object. Empty frames leave the last valid frame in place.
+        if (mFrameValid && mGridFrame != frame)
+        {
+            mpGrid->setGridHandle(copyGridHandle(*pHandle));
+            mGridFrame = frame;
+        }
+
+        return mFrameValid;
+    }
+
+    GridSequenceStream::GridSequenceStream(ref<Device> pDevice, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const Options& options)
+        : mpDevice(pDevice)
+        , mPaths(paths)
+        , mGridname(gridname)
+        , mCache((uint32_t)paths.size(), options.residentFrameCount, options.prefetchFrameCount,
+            [this](uint32_t frame) -> std::shared_ptr<const GridHandle>
+            {
+                // Called from the prefetch thread. Only loads host data.
+                auto handle = Grid::loadGridHandle(mPaths[frame], mGridname);
+                if (!handle) return nullptr;
+                return std::make_shared<const GridHandle>(std::move(handle));
+            })
+    {}
+
+    GridSequenceStream::GridHandle GridSequenceStream::copyGridHandle(const GridHandle& handle)
+    {
+        // The cached frame stays resident for reuse, so the grid object gets its own copy.
+        auto buffer = nanovdb::HostBuffer::create(handle.size());
+        std::memcpy(buffer.data(), handle.data(), handle.size());
+        return GridHandle(std::move(buffer));
+    }
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Grid.h"
+#include "GridFrameCache.h"
+#include "Core/Macros.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Falcor
+{
+    /** Options for streaming a grid sequence.
+        Declared outside of GridSequenceStream so that it can be used as a default argument within the class.
+    */
+    struct GridSequenceStreamOptions
+    {
+        uint32_t residentFrameCount = 8;    ///< Maximum number of frames resident in host memory.
+        uint32_t prefetchFrameCount = 4;    ///< Number of frames to prefetch ahead of the current frame.
+    };
+
+    /** Streamed sequence of grids.
+
+        Instead of loading all frames of a grid sequence up front, frames are loaded into host memory on demand.
+        A bounded window of frames is kept resident, upcoming frames are prefetched in the background based on
+        the playback direction, and the least recently used frames are evicted (see GridFrameCache).
+
+        A single grid object is used for the whole sequence. Changing the frame replaces its data,
+        so the grid can be bound to the scene once like a static grid.
+    */
+    class FALCOR_API GridSequenceStream
+    {
+    public:
+        using GridHandle = nanovdb::GridHandle<nanovdb::HostBuffer>;
+
+        using Options = GridSequenceStreamOptions;
+
+        /** Create a streamed grid sequence.
+            \param[in] pDevice GPU device.
+            \param[in] paths File paths of the grids, one per frame.
+            \param[in] gridname Name of the grid to load.
+            \param[in] options Streaming options.
+            \return A new grid sequence, or nullptr if none of the frames could be loaded.
+        */
+        static std::unique_ptr<GridSequenceStream> create(ref<Device> pDevice, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const Options& options = {});
+
+        /** Get the number of frames in the sequence.
+        */
+        uint32_t getFrameCount() const { return mCache.getFrameCount(); }
+
+        /** Set the current frame. Blocks until the frame is loaded.
+            \param[in] frame Frame index.
+            \return True if the frame holds a valid grid.
+        */
+        bool setFrame(uint32_t frame);
+
+        /** Get the current frame.
+        */
+        uint32_t getFrame() const { return mFrame; }
+
+        /** Check if the current frame holds a valid grid.
+            If not, the grid object still holds the data of the last valid frame.
+        */
+        bool isFrameValid() const { return mFrameValid; }
+
+        /** Get the grid object used for all frames of the sequence.
+        */
+        const ref<Grid>& getGrid() const { return mpGrid; }
+
+        /** Get the frame cache.
+        */
+        const GridFrameCache<GridHandle>& getCache() const { return mCache; }
+
+    private:
+        GridSequenceStream(ref<Device> pDevice, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const Options& options);
+
+        static GridHandle copyGridHandle(const GridHandle& handle);
+
+        ref<Device> mpDevice;
+        std::vector<std::filesystem::path> mPaths;
+        std::string mGridname;
+        GridFrameCache<GridHandle> mCache;
+
+        ref<Grid> mpGrid;
+        uint32_t mFrame = 0;
+        uint32_t mGridFrame = uint32_t(-1);    ///< Frame currently held by the grid object.
+        bool mFrameValid = false;
+    };
+}
@@ -49,6 +49,37 @@ namespace Falcor
         const float kMaxAnisotropy = 0.99f;
         const double kMinFrameRate = 1.0;
         const double kMaxFrameRate = 1000.0;
+
+        std::vector<std::filesystem::path> enumerateGridFiles(const std::filesystem::path& path)
+        {
+            if (!std::filesystem::exists(path))
+            {
+                logWarning("'{}' does not exist.", path);
+                return {};
+            }
+            if (!std::filesystem::is_directory(path))
+            {
+                logWarning("'{}' is not a directory.", path);
+                return {};
+            }
+
+            // Enumerate grid files.
+            std::vector<std::filesystem::path> paths;
+            for (auto it : std::filesystem::directory_iterator(path))
+            {
+                if (hasExtension(it.path(), "nvdb") || hasExtension(it.path(), "vdb")) paths.push_back(it.path());
+            }
+
+            // Sort by length first, then alpha-numerically.
+            auto cmp = [](const std::filesystem::path& a, const std::filesystem::path& b) {
+                auto sa = a.string();
+                auto sb = b.string();
+                return sa.length() != sb.length() ? sa.length() < sb.length() : sa < sb;
+            };
+            std::sort(paths.begin(), paths.end(), cmp);
+
+            return paths;
+        }
     }
 
     static_assert(sizeof(GridVolumeData) % 16 == 0, "GridVolumeData size should be a multiple of 16");
@@ -146,33 +177,42 @@ namespace Falcor
 
     uint32_t GridVolume::loadGridSequence(GridSlot slot, const std::filesystem::path& path, const std::string& gridname, bool keepEmpty)
     {
-        if (!std::filesystem::exists(path))
-        {
-            logWarning("'{}' does not exist.", path);
-            return 0;
-        }
-        if (!std::filesystem::is_directory(path))
-        {
-            logWarning("'{}' is not a directory.", path);
-            return 0;
-        }
+        auto paths = enumerateGridFiles(path);
+        if (paths.empty()) return 0;
+        return loadGridSequence(slot, paths, gridname, keepEmpty);
+    }
 
-        // Enumerate grid files.
-        std::vector<std::filesystem::path> paths;
-        for (auto it : std::filesystem::directory_iterator(path))
-        {
-            if (hasExtension(it.path(), "nvdb") || hasExtension(it.path(), "vdb")) paths.push_back(it.path());
-        }
+    uint32_t GridVolume::streamGridSequence(GridSlot slot, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const GridSequenceStream::Options& options)
+    {
+        auto pStream = GridSequenceStream::create(mpDevice, paths, gridname, options);
+        if (!pStream) return 0;
 
-        // Sort by length first, then alpha-numerically.
-        auto cmp = [](const std::filesystem::path& a, const std::filesystem::path& b) {
-            auto sa = a.string();
-            auto sb = b.string();
-            return sa.length() != sb.length() ? sa.length() < sb.length() : sa < sb;
-        };
-        std::sort(paths.begin(), paths.end(), cmp);
+        uint32_t slotIndex = (uint32_t)slot;
+        FALCOR_ASSERT(slotIndex >= 0 && slotIndex < (uint32_t)GridSlot::Count);
 
-        return loadGridSequence(slot, paths, gridname, keepEmpty);
+        uint32_t frameCount = pStream->getFrameCount();
+        pStream->setFrame(std::min(mGridFrame, frameCount - 1));
+        mGrids[slotIndex] = GridSequence{pStream->getGrid()};
+        mGridStreams[slotIndex] = std::move(pStream);
+        updateSequence();
+        updateBounds();
+        markUpdates(UpdateFlags::GridsChanged);
+        return frameCount;
+    }
+
+    uint32_t GridVolume::streamGridSequence(GridSlot slot, const std::filesystem::path& path, const std::string& gridname, const GridSequenceStream::Options& options)
+    {
+        auto paths = enumerateGridFiles(path);
+        if (paths.empty()) return 0;
+        return streamGridSequence(slot, paths, gridname, options);
+    }
+
+    const GridSequenceStream* GridVolume::getGridSequenceStream(GridSlot slot) const
+    {
+        uint32_t slotIndex = (uint32_t)slot;
+        FALCOR_ASSERT(slotIndex >= 0 && slotIndex < (uint32_t)GridSlot::Count);
+
+        return mGridStreams[slotIndex].get();
     }
 
     void GridVolume::setGridSequence(GridSlot slot, const GridSequence& grids)
@@ -180,9 +220,10 @@ namespace Falcor
         uint32_t slotIndex = (uint32_t)slot;
         FALCOR_ASSERT(slotIndex >= 0 && slotIndex < (uint32_t)GridSlot::Count);
 
-        if (mGrids[slotIndex] != grids)
+        if (mGrids[slotIndex] != grids || mGridStreams[slotIndex])
         {
             mGrids[slotIndex] = grids;
+            mGridStreams[slotIndex].reset();
             updateSequence();
             updateBounds();
             markUpdates(UpdateFlags::GridsChanged);
@@ -209,6 +250,9 @@ namespace Falcor
         uint32_t slotIndex = (uint32_t)slot;
         FALCOR_ASSERT(slotIndex >= 0 && slotIndex < (uint32_t)GridSlot::Count);
 
+        // Streamed sequences hold a single grid, which is empty if the current frame failed to load.
+        if (const auto& pStream = mGridStreams[slotIndex]; pStream && !pStream->isFrameValid()) return kNullGrid;
+
         const auto& gridSequence = mGrids[slotIndex];
         uint32_t gridIndex = std::min(mGridFrame, (uint32_t)gridSequence.size() - 1);
         return gridSequence.empty() ? kNullGrid : gridSequence[gridIndex];
@@ -229,6 +273,10 @@ namespace Falcor
         if (mGridFrame != gridFrame)
         {
             mGridFrame = gridFrame;
+            for (const auto& pStream : mGridStreams)
+            {
+                if (pStream) pStream->setFrame(std::min(mGridFrame, pStream->getFrameCount() - 1));
+            }
             markUpdates(UpdateFlags::GridsChanged);
             updateBounds();
         }
@@ -329,6 +377,10 @@ namespace Falcor
     {
         mGridFrameCount = 1;
         for (const auto& grids : mGrids) mGridFrameCount = std::max(mGridFrameCount, (uint32_t)grids.size());
+        for (const auto& pStream : mGridStreams)
+        {
+            if (pStream) mGridFrameCount = std::max(mGridFrameCount, pStream->getFrameCount());
+        }
         setGridFrame(std::min(mGridFrame, mGridFrameCount - 1));
     }
 
@@ -421,6 +473,21 @@ namespace Falcor
             { return self.loadGridSequence(slot, getActiveAssetResolver().resolvePath(path), gridname, keepEmpty); },
             "slot"_a, "path"_a, "gridnames"_a, "keepEmpty"_a = true
         ); // PYTHONDEPRECATED
+        volume.def("streamGridSequence",
+            [](GridVolume& self, GridVolume::GridSlot slot, const std::vector<std::filesystem::path>& paths, const std::string& gridname, uint32_t residentFrameCount, uint32_t prefetchFrameCount)
+            {
+                std::vector<std::filesystem::path> resolvedPaths;
+                for (const auto& path : paths)
+                    resolvedPaths.push_back(getActiveAssetResolver().resolvePath(path));
+                return self.streamGridSequence(slot, resolvedPaths, gridname, {residentFrameCount, prefetchFrameCount});
+            },
+            "slot"_a, "paths"_a, "gridname"_a, "residentFrameCount"_a = GridSequenceStream::Options().residentFrameCount, "prefetchFrameCount"_a = GridSequenceStream::Options().prefetchFrameCount
+        );
+        volume.def("streamGridSequence",
+            [](GridVolume& self, GridVolume::GridSlot slot, const std::filesystem::path& path, const std::string& gridname, uint32_t residentFrameCount, uint32_t prefetchFrameCount)
+            { return self.streamGridSequence(slot, getActiveAssetResolver().resolvePath(path), gridname, {residentFrameCount, prefetchFrameCount}); },
+            "slot"_a, "path"_a, "gridname"_a, "residentFrameCount"_a = GridSequenceStream::Options().residentFrameCount, "prefetchFrameCount"_a = GridSequenceStream::Options().prefetchFrameCount
+        );
 
         m.attr("Volume") = m.attr("GridVolume"); // PYTHONDEPRECATED
     }
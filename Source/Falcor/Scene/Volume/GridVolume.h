@@ -27,6 +27,7 @@
  **************************************************************************/
 #pragma once
 #include "Grid.h"
+#include "GridSequenceStream.h"
 #include "GridVolumeData.slang"
 #include "Core/Macros.h"
 #include "Utils/Math/AABB.h"
@@ -146,6 +147,34 @@ namespace Falcor
         */
         uint32_t loadGridSequence(GridSlot slot, const std::filesystem::path& path, const std::string& gridname, bool keepEmpty = true);
 
+        /** Stream a sequence of grids from files to a grid slot.
+            Only a bounded window of frames is kept in host memory. Frames are loaded when the grid frame changes,
+            and upcoming frames are prefetched in the background. A single grid is used for the slot,
+            which is updated when the grid frame changes. Frames that can't be loaded are empty.
+            Note: This will replace any existing grid sequence for that slot.
+            \param[in] slot Grid slot.
+            \param[in] paths File paths of the grids. Can also include a full path or relative path from a data directory.
+            \param[in] gridname Name of the grid to load.
+            \param[in] options Streaming options.
+            \return Returns the length of the streamed sequence, or 0 if no grid could be loaded.
+        */
+        uint32_t streamGridSequence(GridSlot slot, const std::vector<std::filesystem::path>& paths, const std::string& gridname, const GridSequenceStream::Options& options = {});
+
+        /** Stream a sequence of grids from a directory to a grid slot.
+            See streamGridSequence() above for details.
+            \param[in] slot Grid slot.
+            \param[in] path Directory containing grid files. Can also include a full path or relative path from a data directory.
+            \param[in] gridname Name of the grid to load.
+            \param[in] options Streaming options.
+            \return Returns the length of the streamed sequence, or 0 if no grid could be loaded.
+        */
+        uint32_t streamGridSequence(GridSlot slot, const std::filesystem::path& path, const std::string& gridname, const GridSequenceStream::Options& options = {});
+
+        /** Get the streamed grid sequence for the specified slot.
+            \return The streamed sequence, or nullptr if the slot does not hold a streamed sequence.
+        */
+        const GridSequenceStream* getGridSequenceStream(GridSlot slot) const;
+
         /** Set the grid sequence for the specified slot.
         */
         void setGridSequence(GridSlot slot, const GridSequence& grids);
@@ -292,6 +321,7 @@ namespace Falcor
         ref<Device> mpDevice;
         std::string mName;
         std::array<GridSequence, (size_t)GridSlot::Count> mGrids;
+        std::array<std::unique_ptr<GridSequenceStream>, (size_t)GridSlot::Count> mGridStreams;
         uint32_t mGridFrame = 0;
         uint32_t mGridFrameCount = 1;
         double mFrameRate = 30.f;
@@ -52,8 +52,57 @@ BufferAllocator::BufferAllocator(size_t alignment, size_t elementSize, size_t ca
 
 size_t BufferAllocator::allocate(size_t byteSize)
 {
-    computeAndAllocatePadding(byteSize);
-    return allocInternal(byteSize);
+    size_t byteOffset = computePaddedOffset(byteSize);
+    if (byteSize > 0)
+        mRanges.append(byteOffset, byteSize, getAllocationAlignment(byteSize));
+    else
+        mRanges.grow(byteOffset);
+    mBuffer.resize(byteOffset + byteSize);
+    return byteOffset;
+}
+
+RangeAllocator::Allocation BufferAllocator::allocateRange(size_t byteSize)
+{
+    FALCOR_CHECK(byteSize > 0, "Allocation size must be larger than zero.");
+
+    // Reuse a free region if possible.
+    size_t alignment = getAllocationAlignment(byteSize);
+    RangeAllocator::Allocation allocation = mRanges.allocate(byteSize, alignment);
+    if (allocation.isValid())
+    {
+        std::memset(mBuffer.data() + allocation.offset, 0, byteSize);
+        markAsDirty(allocation.offset, byteSize);
+        return allocation;
+    }
+
+    // Otherwise grow the buffer.
+    size_t byteOffset = computePaddedOffset(byteSize);
+    allocation = mRanges.append(byteOffset, byteSize, alignment);
+    mBuffer.resize(byteOffset + byteSize);
+    return allocation;
+}
+
+void BufferAllocator::release(const RangeAllocator::Allocation& allocation)
+{
+    mRanges.release(allocation);
+}
+
+void BufferAllocator::defragment(const std::function<void(const RangeAllocator::Move&)>& onMove)
+{
+    std::vector<RangeAllocator::Move> moves = mRanges.defragment();
+
+    // Moves are sorted by offset and only move data towards the front.
+    for (const auto& move : moves)
+    {
+        std::memmove(mBuffer.data() + move.dstOffset, mBuffer.data() + move.srcOffset, move.size);
+        if (onMove)
+            onMove(move);
+    }
+
+    mBuffer.resize(mRanges.trim());
+    if (!moves.empty())
+        markAsDirty(moves.front().dstOffset, mBuffer.size() - moves.front().dstOffset);
+    mDirty.end = std::min(mDirty.end, mBuffer.size());
 }
 
 void BufferAllocator::setBlob(const void* pData, size_t byteOffset, size_t byteSize)
@@ -72,6 +121,7 @@ void BufferAllocator::modified(size_t byteOffset, size_t byteSize)
 
 void BufferAllocator::clear()
 {
+    mRanges = RangeAllocator();
     mBuffer.clear();
     mDirty = {};
 }
@@ -124,7 +174,7 @@ ref<Buffer> BufferAllocator::getGPUBuffer(ref<Device> pDevice)
 
 // Private
 
-void BufferAllocator::computeAndAllocatePadding(size_t byteSize)
+size_t BufferAllocator::computePaddedOffset(size_t byteSize) const
 {
     size_t currentOffset = mBuffer.size();
 
@@ -145,19 +195,25 @@ void BufferAllocator::computeAndAllocatePadding(size_t byteSize)
         }
     }
 
-    size_t pad = currentOffset - mBuffer.size();
-    if (pad > 0)
-    {
-        allocInternal(pad);
-    }
-    FALCOR_ASSERT(mAlignment == 0 || mBuffer.size() % mAlignment == 0);
+    FALCOR_ASSERT(mAlignment == 0 || currentOffset % mAlignment == 0);
+    return currentOffset;
 }
 
-size_t BufferAllocator::allocInternal(size_t byteSize)
+size_t BufferAllocator::getAllocationAlignment(size_t byteSize) const
 {
-    size_t byteOffset = mBuffer.size();
-    mBuffer.insert(mBuffer.end(), byteSize, {});
-    return byteOffset;
+    size_t alignment = std::max<size_t>(mAlignment, 1);
+
+    // Regions that are reused or moved are placed at an offset aligned to the next power of two of their size (up to the
+    // cache line size). This guarantees that allocations smaller than a cache line don't span two cache lines.
+    if (mCacheLineSize > 0 && byteSize <= mCacheLineSize)
+    {
+        size_t sizeAlignment = 1;
+        while (sizeAlignment < byteSize)
+            sizeAlignment <<= 1;
+        alignment = std::max(alignment, sizeAlignment);
+    }
+
+    return alignment;
 }
 
 void BufferAllocator::markAsDirty(const Range& range)
@@ -29,7 +29,9 @@
 
 #include "Core/Macros.h"
 #include "Core/API/Buffer.h"
+#include "Utils/RangeAllocator.h"
 
+#include <functional>
 #include <vector>
 
 namespace Falcor
@@ -49,6 +51,11 @@ namespace Falcor
  * It is assumed that the base pointer of the GPU buffer starts at a
  * cache line. The implementation doesn't provide any alignment
  * guarantees for the CPU side buffer (where it doesn't matter anyway).
+ *
+ * Memory allocated with allocate(), pushBack() and emplaceBack() is packed
+ * linearly and never released. Memory allocated with allocateRange() can be
+ * released again, and the freed regions are reused by later allocations.
+ * The buffer can be compacted with defragment().
  */
 class FALCOR_API BufferAllocator
 {
@@ -94,8 +101,7 @@ public:
     size_t pushBack(const T& obj)
     {
         const size_t byteSize = sizeof(T);
-        computeAndAllocatePadding(byteSize);
-        size_t byteOffset = allocInternal(byteSize);
+        size_t byteOffset = allocate(byteSize);
         T* ptr = reinterpret_cast<T*>(mBuffer.data() + byteOffset);
         *ptr = obj;
         markAsDirty(byteOffset, byteSize);
@@ -111,14 +117,39 @@ public:
     size_t emplaceBack(Args&&... args)
     {
         const size_t byteSize = sizeof(T);
-        computeAndAllocatePadding(byteSize);
-        size_t byteOffset = allocInternal(byteSize);
+        size_t byteOffset = allocate(byteSize);
         void* ptr = mBuffer.data() + byteOffset;
         new (ptr) T(std::forward<Args>(args)...);
         markAsDirty(byteOffset, byteSize);
         return byteOffset;
     }
 
+    /**
+     * Allocates a memory region that can be released with release().
+     * Free regions are reused if possible, otherwise the buffer grows.
+     * @param[in] byteSize Amount of memory in bytes to allocate. Must be larger than zero.
+     * @return The allocated range. The offset is in bytes.
+     */
+    RangeAllocator::Allocation allocateRange(size_t byteSize);
+
+    /**
+     * Releases a memory region allocated with allocateRange().
+     * @param[in] allocation The allocated range.
+     */
+    void release(const RangeAllocator::Allocation& allocation);
+
+    /**
+     * Moves all allocations to the front of the buffer, keeping their order and alignment, and shrinks the buffer.
+     * @param[in] onMove Called for each moved allocation so that references to it can be updated.
+     * Allocations returned by allocateRange() can be updated using `RangeAllocator::Move::dstOffset`.
+     */
+    void defragment(const std::function<void(const RangeAllocator::Move&)>& onMove = {});
+
+    /**
+     * Get allocation statistics.
+     */
+    RangeAllocator::Stats getStats() const { return mRanges.getStats(); }
+
     /**
      * Set data into a memory region.
      * @param[in] pData Pointer to the source data.
@@ -198,8 +229,8 @@ public:
     ref<Buffer> getGPUBuffer(ref<Device> pDevice);
 
 private:
-    void computeAndAllocatePadding(size_t byteSize);
-    size_t allocInternal(size_t byteSize);
+    size_t computePaddedOffset(size_t byteSize) const;
+    size_t getAllocationAlignment(size_t byteSize) const;
 
     struct Range
     {
@@ -228,6 +259,7 @@ private:
     /// uploads, but this could be changed.
     Range mDirty;
 
+    RangeAllocator mRanges;       ///< Allocated ranges in the buffer.
     std::vector<uint8_t> mBuffer; ///< CPU buffer holding a copy of the data.
     ref<Buffer> mpGpuBuffer;      ///< GPU buffer holding the data.
 };
@@ -0,0 +1,112 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Dictionary.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Falcor
+{
+namespace
+{
+/**
+ * Process-wide table of interned key names.
+ * Names are stored in fixed-size chunks that are never moved or freed while the process runs, so getName() can index
+ * them without locking. Lookups by name take a shared lock and only interning a new name takes the exclusive lock.
+ */
+struct KeyRegistry
+{
+    static constexpr uint32_t kChunkSizeLog2 = 10;
+    static constexpr uint32_t kChunkSize = 1u << kChunkSizeLog2;
+    static constexpr uint32_t kMaxChunkCount = 4096;
+
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> ids; ///< Maps names (viewing the chunk storage) to ids.
+    std::array<std::atomic<std::string*>, kMaxChunkCount> chunks{};
+    uint32_t count = 0;
+
+    ~KeyRegistry()
+    {
+        for (auto& chunk : chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    const std::string& getName(uint32_t id) const
+    {
+        const std::string* chunk = chunks[id >> kChunkSizeLog2].load(std::memory_order_acquire);
+        FALCOR_ASSERT(chunk);
+        return chunk[id & (kChunkSize - 1)];
+    }
+};
+
+KeyRegistry& getKeyRegistry()
+{
+    static KeyRegistry registry;
+    return registry;
+}
+} // namespace
+
+uint32_t Dictionary::Key::intern(std::string_view name)
+{
+    auto& registry = getKeyRegistry();
+    {
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto it = registry.ids.find(name);
+        if (it != registry.ids.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end())
+        return it->second;
+
+    uint32_t id = registry.count;
+    uint32_t chunkIndex = id >> KeyRegistry::kChunkSizeLog2;
+    FALCOR_CHECK(chunkIndex < KeyRegistry::kMaxChunkCount, "Too many dictionary keys");
+    std::string* chunk = registry.chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk)
+    {
+        chunk = new std::string[KeyRegistry::kChunkSize];
+        registry.chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    std::string& storedName = chunk[id & (KeyRegistry::kChunkSize - 1)];
+    storedName = name;
+    registry.ids.emplace(storedName, id);
+    registry.count++;
+    return id;
+}
+
+const std::string& Dictionary::Key::getName() const
+{
+    return getKeyRegistry().getName(mId);
+}
+} // namespace Falcor
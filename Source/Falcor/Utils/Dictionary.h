@@ -27,16 +27,46 @@
  **************************************************************************/
 #pragma once
 #include "Core/Error.h"
-#include <unordered_map>
+#include "Core/Macros.h"
 #include <any>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Falcor
 {
 class Dictionary
 {
 public:
+    /**
+     * Dictionary key.
+     * Key names are interned into a process-wide table on construction, so comparing keys is an integer comparison.
+     * Constructing a key from a name takes a shared lock on the table and hashes the name; getName() does not lock.
+     * Keys that are used every frame should be constructed once and stored (see RenderPassStandardFlags.h).
+     */
+    class FALCOR_API Key
+    {
+    public:
+        Key(const char* name) : Key(std::string_view(name)) {}
+        Key(const std::string& name) : Key(std::string_view(name)) {}
+        Key(std::string_view name) : mId(intern(name)) {}
+
+        /// Get the unique id of the key.
+        uint32_t getId() const { return mId; }
+
+        /// Get the name of the key.
+        const std::string& getName() const;
+
+        bool operator==(const Key& other) const { return mId == other.mId; }
+        bool operator!=(const Key& other) const { return mId != other.mId; }
+
+    private:
+        static uint32_t intern(std::string_view name);
+
+        uint32_t mId;
+    };
+
     class Value
     {
     public:
@@ -59,13 +89,32 @@ public:
         std::any mValue;
     };
 
-    using Container = std::unordered_map<std::string, Value>;
+    struct Entry
+    {
+        Key key;
+        Value value;
+    };
+
+    /// Entries are kept in a flat array. Dictionaries hold few entries, so a linear scan over key ids beats hashing the name.
+    using Container = std::vector<Entry>;
 
     Dictionary() = default;
     Dictionary(const Dictionary& d) : mContainer(d.mContainer) {}
 
-    Value& operator[](const std::string& key) { return mContainer[key]; }
-    const Value& operator[](const std::string& key) const { return mContainer.at(key); }
+    Value& operator[](const Key& key)
+    {
+        auto it = find(key);
+        if (it != mContainer.end())
+            return it->value;
+        mContainer.push_back({key, Value()});
+        return mContainer.back().value;
+    }
+    const Value& operator[](const Key& key) const
+    {
+        auto it = find(key);
+        FALCOR_CHECK(it != mContainer.end(), "Key '{}' does not exist", key.getName());
+        return it->value;
+    }
 
     Container::const_iterator begin() const { return mContainer.begin(); }
     Container::const_iterator end() const { return mContainer.end(); }
@@ -76,26 +125,41 @@ public:
     size_t size() const { return mContainer.size(); }
 
     /// Check if a key exists.
-    bool keyExists(const std::string& key) const { return mContainer.find(key) != mContainer.end(); }
+    bool keyExists(const Key& key) const { return find(key) != mContainer.end(); }
 
     /// Get value by key. Throws an exception if key does not exist.
     template<typename T>
-    T getValue(const std::string& key)
+    T getValue(const Key& key)
     {
-        auto it = mContainer.find(key);
-        FALCOR_CHECK(it != mContainer.end(), "Key '{}' does not exist", key);
-        return it->second;
+        auto it = find(key);
+        FALCOR_CHECK(it != mContainer.end(), "Key '{}' does not exist", key.getName());
+        return it->value;
     }
 
     /// Get value by key. Returns the specified default value if key does not exist.
     template<typename T>
-    T getValue(const std::string& key, const T& defaultValue)
+    T getValue(const Key& key, const T& defaultValue)
     {
-        auto it = mContainer.find(key);
-        return it != mContainer.end() ? it->second : defaultValue;
+        auto it = find(key);
+        return it != mContainer.end() ? it->value : defaultValue;
     }
 
 private:
+    Container::const_iterator find(const Key& key) const
+    {
+        for (auto it = mContainer.begin(); it != mContainer.end(); ++it)
+            if (it->key == key)
+                return it;
+        return mContainer.end();
+    }
+    Container::iterator find(const Key& key)
+    {
+        for (auto it = mContainer.begin(); it != mContainer.end(); ++it)
+            if (it->key == key)
+                return it;
+        return mContainer.end();
+    }
+
     Container mContainer;
 };
 } // namespace Falcor
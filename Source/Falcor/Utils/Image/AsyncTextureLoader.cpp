@@ -28,13 +28,25 @@
 #include "AsyncTextureLoader.h"
 #include "Core/API/Device.h"
 #include "Utils/Threading.h"
+#include "Utils/Timing/TraceRecorder.h"
 
 namespace Falcor
 {
 namespace
 {
 constexpr size_t kUploadsPerFlush = 16; ///< Number of texture uploads before issuing a flush (to keep upload heap from growing).
+
+/// Start an async trace event spanning from the request until the texture is loaded.
+uint64_t traceLoadRequest()
+{
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    if (!recorder.isRecording())
+        return 0;
+    uint64_t id = recorder.newId();
+    recorder.asyncBegin("LoadTexture", id, "texture");
+    return id;
 }
+} // namespace
 
 AsyncTextureLoader::AsyncTextureLoader(ref<Device> pDevice, size_t threadCount) : mpDevice(pDevice)
 {
@@ -56,7 +68,7 @@ std::future<ref<Texture>> AsyncTextureLoader::loadMippedFromFiles(
 )
 {
     std::lock_guard<std::mutex> lock(mMutex);
-    mLoadRequestQueue.push(LoadRequest{{paths.begin(), paths.end()}, false, loadAsSrgb, bindFlags, callback});
+    mLoadRequestQueue.push(LoadRequest{{paths.begin(), paths.end()}, false, loadAsSrgb, bindFlags, callback, {}, traceLoadRequest()});
     mCondition.notify_one();
     return mLoadRequestQueue.back().promise.get_future();
 }
@@ -70,7 +82,7 @@ std::future<ref<Texture>> AsyncTextureLoader::loadFromFile(
 )
 {
     std::lock_guard<std::mutex> lock(mMutex);
-    mLoadRequestQueue.push(LoadRequest{{path}, generateMipLevels, loadAsSrgb, bindFlags, callback});
+    mLoadRequestQueue.push(LoadRequest{{path}, generateMipLevels, loadAsSrgb, bindFlags, callback, {}, traceLoadRequest()});
     mCondition.notify_one();
     return mLoadRequestQueue.back().promise.get_future();
 }
@@ -101,6 +113,8 @@ void AsyncTextureLoader::runWorker()
     // To avoid the upload heap growing too large, we synchronize the threads and
     // issue a global GPU flush at regular intervals.
 
+    TraceRecorder::getGlobal().setThreadName("AsyncTextureLoader");
+
     while (true)
     {
         // Wait on condition until more work is ready.
@@ -132,16 +146,22 @@ void AsyncTextureLoader::runWorker()
 
         // Load the textures (this part is running in parallel).
         ref<Texture> pTexture;
-        if (request.paths.size() == 1)
         {
-            pTexture =
-                Texture::createFromFile(mpDevice, request.paths[0], request.generateMipLevels, request.loadAsSRGB, request.bindFlags);
-        }
-        else
-        {
-            pTexture = Texture::createMippedFromFiles(mpDevice, request.paths, request.loadAsSRGB, request.bindFlags);
+            FALCOR_TRACE_SCOPE_CATEGORY("LoadTexture", "texture");
+            if (request.paths.size() == 1)
+            {
+                pTexture =
+                    Texture::createFromFile(mpDevice, request.paths[0], request.generateMipLevels, request.loadAsSRGB, request.bindFlags);
+            }
+            else
+            {
+                pTexture = Texture::createMippedFromFiles(mpDevice, request.paths, request.loadAsSRGB, request.bindFlags);
+            }
         }
 
+        if (request.traceId != 0)
+            TraceRecorder::getGlobal().asyncEnd("LoadTexture", request.traceId, "texture");
+
         request.promise.set_value(pTexture);
 
         if (request.callback)
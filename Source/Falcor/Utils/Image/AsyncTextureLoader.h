@@ -109,6 +109,7 @@ private:
         ResourceBindFlags bindFlags;
         LoadCallback callback;
         std::promise<ref<Texture>> promise;
+        uint64_t traceId = 0; ///< Trace ID of the async load event (0 if not traced).
     };
 
     ref<Device> mpDevice;
@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "Bitmap.h"
+#include "PixelConversion.h"
 #include "Core/Macros.h"
 #include "Core/API/Texture.h"
 #include "Core/Platform/MemoryMappedFile.h"
@@ -61,98 +62,6 @@ static bool isConvertibleToRGBA32Float(ResourceFormat format)
     return isHalfFormat || isLargeIntFormat;
 }
 
-/**
- * Converts half float image to RGBA float image.
- */
-static std::vector<float> convertHalfToRGBA32Float(uint32_t width, uint32_t height, uint32_t channelCount, const void* pData)
-{
-    std::vector<float> newData(width * height * 4u, 0.f);
-    const float16_t* pSrc = reinterpret_cast<const float16_t*>(pData);
-    float* pDst = newData.data();
-
-    for (uint32_t i = 0; i < width * height; ++i)
-    {
-        for (uint32_t c = 0; c < channelCount; ++c)
-        {
-            *pDst++ = float(*pSrc++);
-        }
-        pDst += (4 - channelCount);
-    }
-
-    return newData;
-}
-
-/**
- * Converts integer image to RGBA float image.
- * Unsigned integers are normalized to [0,1], signed integers to [-1,1].
- */
-template<typename SrcT>
-static std::vector<float> convertIntToRGBA32Float(uint32_t width, uint32_t height, uint32_t channelCount, const void* pData)
-{
-    std::vector<float> newData(width * height * 4u, 0.f);
-    const SrcT* pSrc = reinterpret_cast<const SrcT*>(pData);
-    float* pDst = newData.data();
-
-    for (uint32_t i = 0; i < width * height; ++i)
-    {
-        for (uint32_t c = 0; c < channelCount; ++c)
-        {
-            *pDst++ = float(*pSrc++) / float(std::numeric_limits<SrcT>::max());
-        }
-        pDst += (4 - channelCount);
-    }
-
-    return newData;
-}
-
-/**
- * Converts an image of the given format to an RGBA float image.
- */
-static std::vector<float> convertToRGBA32Float(ResourceFormat format, uint32_t width, uint32_t height, const void* pData)
-{
-    FALCOR_ASSERT(isConvertibleToRGBA32Float(format));
-
-    FormatType type = getFormatType(format);
-    uint32_t channelCount = getFormatChannelCount(format);
-    uint32_t channelBits = getNumChannelBits(format, 0);
-
-    std::vector<float> floatData;
-
-    if (type == FormatType::Float && channelBits == 16)
-    {
-        floatData = convertHalfToRGBA32Float(width, height, channelCount, pData);
-    }
-    else if (type == FormatType::Uint && channelBits == 16)
-    {
-        floatData = convertIntToRGBA32Float<uint16_t>(width, height, channelCount, pData);
-    }
-    else if (type == FormatType::Uint && channelBits == 32)
-    {
-        floatData = convertIntToRGBA32Float<uint32_t>(width, height, channelCount, pData);
-    }
-    else if (type == FormatType::Sint && channelBits == 16)
-    {
-        floatData = convertIntToRGBA32Float<int16_t>(width, height, channelCount, pData);
-    }
-    else if (type == FormatType::Sint && channelBits == 32)
-    {
-        floatData = convertIntToRGBA32Float<int32_t>(width, height, channelCount, pData);
-    }
-    else
-    {
-        FALCOR_UNREACHABLE();
-    }
-
-    // Default alpha channel to 1.
-    if (channelCount < 4)
-    {
-        for (uint32_t i = 0; i < width * height; ++i)
-            floatData[i * 4 + 3] = 1.f;
-    }
-
-    return floatData;
-}
-
 /**
  * Converts 96bpp to 128bpp RGBA without clamping.
  * Note that we can't use FreeImage_ConvertToRGBAF() as it clamps to [0,1].
@@ -486,21 +395,11 @@ void Bitmap::saveImage(
     uint32_t bytesPerPixel = getFormatBytesPerBlock(resourceFormat);
 
     // Convert 8-bit RGBA to BGRA byte order.
-    // TODO: Replace this code for swapping channels. Can't use FreeImage masks b/c they only care about 16 bpp images.
     if (resourceFormat == ResourceFormat::RGBA8Unorm || resourceFormat == ResourceFormat::RGBA8Snorm ||
         resourceFormat == ResourceFormat::RGBA8UnormSrgb)
     {
-        for (uint32_t a = 0; a < width * height; a++)
-        {
-            uint32_t* pPixel = (uint32_t*)pData;
-            pPixel += a;
-            uint8_t* ch = (uint8_t*)pPixel;
-            std::swap(ch[0], ch[2]);
-            if (is_set(exportFlags, ExportFlags::ExportAlpha) == false)
-            {
-                ch[3] = 0xff;
-            }
-        }
+        uint8_t* pPixels = reinterpret_cast<uint8_t*>(pData);
+        PixelConversion::swapRedBlue8(pPixels, pPixels, size_t(width) * height, !is_set(exportFlags, ExportFlags::ExportAlpha));
     }
 
     if (fileFormat == Bitmap::FileFormat::PfmFile || fileFormat == Bitmap::FileFormat::ExrFile)
@@ -508,7 +407,7 @@ void Bitmap::saveImage(
         std::vector<float> floatData;
         if (isConvertibleToRGBA32Float(resourceFormat))
         {
-            floatData = convertToRGBA32Float(resourceFormat, width, height, pData);
+            floatData = PixelConversion::convertToRGBA32Float(resourceFormat, width, height, pData);
             pData = floatData.data();
             resourceFormat = ResourceFormat::RGBA32Float;
             bytesPerPixel = 16;
@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "ImageIO.h"
+#include "PixelConversion.h"
 #include "Core/Error.h"
 #include "Core/API/Device.h"
 #include "Core/API/CopyContext.h"
@@ -33,10 +34,13 @@
 #include "Core/Platform/MemoryMappedFile.h"
 #include "Utils/Math/ScalarMath.h"
 #include "Utils/Logger.h"
+#include "Utils/NumericRange.h"
 
 #include <dds_header/DDSHeader.h>
 #include <nvtt/nvtt.h>
 
+#include <algorithm>
+#include <execution>
 #include <filesystem>
 
 namespace Falcor
@@ -273,41 +277,41 @@ void setImage(
 
     modified.resize(4 * pixelCount);
 
-    T* src = (T*)subresourceData;
+    const T* src = (const T*)subresourceData;
     T* dst = (T*)modified.data();
-    for (uint32_t h = 0; h < image.height; ++h)
-    {
-        for (uint32_t w = 0; w < image.width; ++w)
+    auto rows = NumericRange<uint32_t>(0, image.height);
+    std::for_each(
+        std::execution::par,
+        rows.begin(),
+        rows.end(),
+        [&](uint32_t h)
         {
-            uint32_t i = h * srcWidth + w;    // Source data index
-            uint32_t j = h * image.width + w; // Destination data index - Same as source index if no clamping is involved
+            // Source rows may be wider than the destination if clamping is involved.
+            const T* srcRow = src + size_t(h) * srcWidth * channelCount;
             if (channelCount == 1)
             {
-                dst[j] = T(src[i]);
-            }
-            else if (channelCount == 2)
-            {
-                dst[4 * j] = reverseRB ? T(0) : T(src[2 * i]);
-                dst[4 * j + 1] = T(src[2 * i + 1]);
-                dst[4 * j + 2] = reverseRB ? T(src[2 * i]) : T(0);
-                dst[4 * j + 3] = T(0);
+                std::copy_n(srcRow, image.width, dst + size_t(h) * image.width);
+                return;
             }
-            else if (channelCount == 3)
+
+            T* dstRow = dst + size_t(h) * image.width * 4;
+            if constexpr (sizeof(T) == 1)
             {
-                dst[4 * j] = reverseRB ? T(src[3 * i + 2]) : T(src[3 * i]);
-                dst[4 * j + 1] = T(src[3 * i + 1]);
-                dst[4 * j + 2] = reverseRB ? T(src[3 * i]) : T(src[3 * i + 2]);
-                dst[4 * j + 3] = T(0);
+                if (channelCount == 4 && reverseRB)
+                {
+                    PixelConversion::swapRedBlue8((const uint8_t*)srcRow, (uint8_t*)dstRow, image.width);
+                    return;
+                }
             }
-            else if (channelCount == 4)
+
+            PixelConversion::expandToRGBA(srcRow, channelCount, dstRow, image.width, alpha);
+            if (reverseRB)
             {
-                dst[4 * j] = reverseRB ? T(src[4 * i + 2]) : T(src[4 * i]);
-                dst[4 * j + 1] = T(src[4 * i + 1]);
-                dst[4 * j + 2] = reverseRB ? T(src[4 * i]) : T(src[4 * i + 2]);
-                dst[4 * j + 3] = T(src[4 * i + 3]);
+                for (uint32_t w = 0; w < image.width; ++w)
+                    std::swap(dstRow[4 * w], dstRow[4 * w + 2]);
             }
         }
-    }
+    );
 
     if (isCompressedFormat(image.format))
     {
@@ -554,6 +558,23 @@ void loadDDS(const std::filesystem::path& path, bool loadAsSrgb, ImportData& dat
 }
 } // namespace
 
+ImageIO::DDSData ImageIO::loadDDSData(const std::filesystem::path& path, bool loadAsSrgb)
+{
+    ImportData importData;
+    loadDDS(path, loadAsSrgb, importData);
+
+    DDSData data;
+    data.type = importData.type;
+    data.format = importData.format;
+    data.width = importData.width;
+    data.height = importData.height;
+    data.depth = importData.depth;
+    data.arraySize = importData.arraySize;
+    data.mipLevels = importData.mipLevels;
+    data.data = std::move(importData.imageData);
+    return data;
+}
+
 Bitmap::UniqueConstPtr ImageIO::loadBitmapFromDDS(const std::filesystem::path& path)
 {
     ImportData data;
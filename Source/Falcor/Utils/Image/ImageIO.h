@@ -72,6 +72,29 @@ public:
         None
     };
 
+    /// Image data of a DDS file.
+    struct DDSData
+    {
+        Resource::Type type = Resource::Type::Texture2D; ///< Resource type.
+        ResourceFormat format = ResourceFormat::Unknown; ///< Texel format.
+        uint32_t width = 0;                              ///< Width of mip 0.
+        uint32_t height = 0;                             ///< Height of mip 0.
+        uint32_t depth = 0;                              ///< Depth of mip 0.
+        uint32_t arraySize = 0;                          ///< Number of array slices. Cube maps have 6 slices per cube.
+        uint32_t mipLevels = 0;                          ///< Number of mip levels.
+        std::vector<uint8_t> data;                       ///< Data of all subresources, ordered by array slice and then mip level.
+    };
+
+    /**
+     * Load all array slices and mip levels of a DDS file into CPU memory. This does not require a device.
+     * Throws an exception if the DDS file is malformed.
+     * @param[in] path Path of file to load.
+     * @param[in] loadAsSrgb If true, convert the image format property to a corresponding sRGB format if available. Image data is not
+     * changed.
+     * @return Image data.
+     */
+    static DDSData loadDDSData(const std::filesystem::path& path, bool loadAsSrgb);
+
     /**
      * Load a DDS file to a Bitmap. If the file contains an image array and/or mips, only the first image will be loaded.
      * Throws an exception if the DDS file is malformed.
@@ -0,0 +1,619 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "PixelConversion.h"
+#include "Core/Error.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FALCOR_PIXEL_CONVERSION_SIMD 1
+#include <immintrin.h>
+#if FALCOR_MSVC
+#include <intrin.h>
+#define FALCOR_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define FALCOR_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#endif
+#else
+#define FALCOR_PIXEL_CONVERSION_SIMD 0
+#endif
+
+namespace Falcor
+{
+namespace PixelConversion
+{
+namespace
+{
+uint32_t floatBits(float f)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(float));
+    return bits;
+}
+
+float bitsToFloat(uint32_t bits)
+{
+    float f;
+    std::memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+/// Exact half to float conversion, NaNs are quieted like F16C does.
+float halfToFloatScalar(uint16_t h)
+{
+    uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+
+    if (exponent == 0x1f)
+        return bitsToFloat(sign | 0x7f800000 | (mantissa ? (0x400000 | (mantissa << 13)) : 0));
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+            return bitsToFloat(sign);
+        // Normalize the denormal.
+        exponent = 113;
+        while ((mantissa & 0x400) == 0)
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        return bitsToFloat(sign | (exponent << 23) | ((mantissa & 0x3ff) << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+/// Float to half conversion with round to nearest even, NaNs are quieted like F16C does.
+uint16_t floatToHalfScalar(float f)
+{
+    uint32_t bits = floatBits(f);
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t absBits = bits & 0x7fffffff;
+
+    if (absBits >= 0x7f800000)
+        return uint16_t(sign | 0x7c00 | (absBits > 0x7f800000 ? (0x200 | ((absBits >> 13) & 0x3ff)) : 0));
+    // Values from halfway between the largest half and the next power of two round to infinity.
+    if (absBits >= 0x477ff000)
+        return uint16_t(sign | 0x7c00);
+    if (absBits < 0x38800000)
+    {
+        // Denormal result, values up to 2^-25 round to zero.
+        if (absBits < 0x33000000)
+            return uint16_t(sign);
+        uint32_t shift = 126 - (absBits >> 23);
+        uint32_t mantissa = (absBits & 0x7fffff) | 0x800000;
+        uint32_t result = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1)))
+            result++;
+        return uint16_t(sign | result);
+    }
+
+    uint32_t result = (absBits >> 13) - (112 << 10);
+    uint32_t remainder = absBits & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+        result++;
+    return uint16_t(sign | result);
+}
+
+template<typename T>
+float normToFloatScalar(T value)
+{
+    float f = float(value) / float(std::numeric_limits<T>::max());
+    return std::is_signed_v<T> ? std::max(f, -1.f) : f;
+}
+
+template<typename T>
+T floatToNormScalar(float value)
+{
+    // NaN maps to zero.
+    if (!(value == value))
+        value = 0.f;
+    float minValue = std::is_signed_v<T> ? -1.f : 0.f;
+    value = std::min(std::max(value, minValue), 1.f);
+    return T(std::nearbyint(value * float(std::numeric_limits<T>::max())));
+}
+
+float srgbToLinearScalar(float value)
+{
+    return value <= 0.04045f ? value * (1.f / 12.92f) : std::pow((value + 0.055f) * (1.f / 1.055f), 2.4f);
+}
+
+float linearToSrgbScalar(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+}
+
+#if FALCOR_PIXEL_CONVERSION_SIMD
+
+bool detectSimdSupport()
+{
+    // Require AVX2 and F16C, as well as OS support for saving the AVX registers.
+#if FALCOR_MSVC
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+    bool hasAVX = (info[2] & (1 << 28)) != 0;
+    bool hasF16C = (info[2] & (1 << 29)) != 0;
+    if (!hasOSXSave || !hasAVX || !hasF16C || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    bool hasOSXSave = (ecx & (1u << 27)) != 0;
+    bool hasAVX = (ecx & (1u << 28)) != 0;
+    bool hasF16C = (ecx & (1u << 29)) != 0;
+    if (!hasOSXSave || !hasAVX || !hasF16C)
+        return false;
+    uint32_t xcr0, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+    if ((xcr0 & 0x6) != 0x6)
+        return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0;
+#endif
+}
+
+// AVX2/F16C kernels. Each processes multiples of 8 elements and returns the number of processed elements,
+// the remainder is handled by the scalar implementation.
+
+FALCOR_TARGET_AVX2 size_t halfToFloatAVX2(const uint16_t* pSrc, float* pDst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(pDst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i))));
+    return i;
+}
+
+FALCOR_TARGET_AVX2 size_t floatToHalfAVX2(const float* pSrc, uint16_t* pDst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm256_cvtps_ph(_mm256_loadu_ps(pSrc + i), _MM_FROUND_TO_NEAREST_INT));
+    return i;
+}
+
+template<typename T>
+FALCOR_TARGET_AVX2 __m256i load8AsInt32(const T* pSrc)
+{
+    if constexpr (std::is_same_v<T, uint8_t>)
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc)));
+    else if constexpr (std::is_same_v<T, int8_t>)
+        return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc)));
+    else if constexpr (std::is_same_v<T, uint16_t>)
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+    else
+        return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+}
+
+template<typename T>
+FALCOR_TARGET_AVX2 size_t normToFloatAVX2(const T* pSrc, float* pDst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(float(std::numeric_limits<T>::max()));
+    const __m256 minValue = _mm256_set1_ps(-1.f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 v = _mm256_div_ps(_mm256_cvtepi32_ps(load8AsInt32(pSrc + i)), scale);
+        if constexpr (std::is_signed_v<T>)
+            v = _mm256_max_ps(v, minValue);
+        _mm256_storeu_ps(pDst + i, v);
+    }
+    return i;
+}
+
+template<typename T>
+FALCOR_TARGET_AVX2 size_t floatToNormAVX2(const float* pSrc, T* pDst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(float(std::numeric_limits<T>::max()));
+    const __m256 minValue = _mm256_set1_ps(std::is_signed_v<T> ? -1.f : 0.f);
+    const __m256 maxValue = _mm256_set1_ps(1.f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(pSrc + i);
+        // Zero NaNs, then clamp and round to nearest even (the default rounding mode).
+        v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+        v = _mm256_min_ps(_mm256_max_ps(v, minValue), maxValue);
+        __m256i n = _mm256_cvtps_epi32(_mm256_mul_ps(v, scale));
+        __m128i lo = _mm256_castsi256_si128(n);
+        __m128i hi = _mm256_extracti128_si256(n, 1);
+        if constexpr (std::is_same_v<T, uint8_t>)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi16(_mm_packus_epi32(lo, hi), _mm_setzero_si128()));
+        else if constexpr (std::is_same_v<T, int8_t>)
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128()));
+        else if constexpr (std::is_same_v<T, uint16_t>)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi32(lo, hi));
+        else
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+FALCOR_TARGET_AVX2 size_t swapRedBlue8AVX2(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount, bool opaque)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    const __m256i alpha = _mm256_set1_epi32(opaque ? int(0xff000000) : 0);
+    size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i * 4));
+        v = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + i * 4), v);
+    }
+    return i;
+}
+
+const bool kSimdEnabled = detectSimdSupport();
+
+#else
+
+const bool kSimdEnabled = false;
+
+#endif // FALCOR_PIXEL_CONVERSION_SIMD
+
+/// Run the SIMD kernel if enabled and convert the remaining elements with the scalar implementation.
+#if FALCOR_PIXEL_CONVERSION_SIMD
+#define DISPATCH(simdKernel, scalarFunc, pSrc, pDst, count)                    \
+    size_t offset = kSimdEnabled ? simdKernel(pSrc, pDst, count) : 0;          \
+    scalarFunc(pSrc + offset, pDst + offset, count - offset);
+#else
+#define DISPATCH(simdKernel, scalarFunc, pSrc, pDst, count) scalarFunc(pSrc, pDst, count);
+#endif
+} // namespace
+
+namespace Scalar
+{
+void halfToFloat(const uint16_t* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = halfToFloatScalar(pSrc[i]);
+}
+
+void floatToHalf(const float* pSrc, uint16_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = floatToHalfScalar(pSrc[i]);
+}
+
+void unorm8ToFloat(const uint8_t* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = normToFloatScalar(pSrc[i]);
+}
+
+void unorm16ToFloat(const uint16_t* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = normToFloatScalar(pSrc[i]);
+}
+
+void snorm8ToFloat(const int8_t* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = normToFloatScalar(pSrc[i]);
+}
+
+void snorm16ToFloat(const int16_t* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = normToFloatScalar(pSrc[i]);
+}
+
+void floatToUnorm8(const float* pSrc, uint8_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = floatToNormScalar<uint8_t>(pSrc[i]);
+}
+
+void floatToUnorm16(const float* pSrc, uint16_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = floatToNormScalar<uint16_t>(pSrc[i]);
+}
+
+void floatToSnorm8(const float* pSrc, int8_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = floatToNormScalar<int8_t>(pSrc[i]);
+}
+
+void floatToSnorm16(const float* pSrc, int16_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = floatToNormScalar<int16_t>(pSrc[i]);
+}
+
+void swapRedBlue8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount, bool opaque)
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        uint8_t r = pSrc[i * 4], g = pSrc[i * 4 + 1], b = pSrc[i * 4 + 2], a = pSrc[i * 4 + 3];
+        pDst[i * 4] = b;
+        pDst[i * 4 + 1] = g;
+        pDst[i * 4 + 2] = r;
+        pDst[i * 4 + 3] = opaque ? 0xff : a;
+    }
+}
+} // namespace Scalar
+
+bool isSimdEnabled()
+{
+    return kSimdEnabled;
+}
+
+void halfToFloat(const uint16_t* pSrc, float* pDst, size_t count)
+{
+    DISPATCH(halfToFloatAVX2, Scalar::halfToFloat, pSrc, pDst, count);
+}
+
+void floatToHalf(const float* pSrc, uint16_t* pDst, size_t count)
+{
+    DISPATCH(floatToHalfAVX2, Scalar::floatToHalf, pSrc, pDst, count);
+}
+
+void unorm8ToFloat(const uint8_t* pSrc, float* pDst, size_t count)
+{
+    DISPATCH(normToFloatAVX2, Scalar::unorm8ToFloat, pSrc, pDst, count);
+}
+
+void unorm16ToFloat(const uint16_t* pSrc, float* pDst, size_t count)
+{
+    DISPATCH(normToFloatAVX2, Scalar::unorm16ToFloat, pSrc, pDst, count);
+}
+
+void snorm8ToFloat(const int8_t* pSrc, float* pDst, size_t count)
+{
+    DISPATCH(normToFloatAVX2, Scalar::snorm8ToFloat, pSrc, pDst, count);
+}
+
+void snorm16ToFloat(const int16_t* pSrc, float* pDst, size_t count)
+{
+    DISPATCH(normToFloatAVX2, Scalar::snorm16ToFloat, pSrc, pDst, count);
+}
+
+void floatToUnorm8(const float* pSrc, uint8_t* pDst, size_t count)
+{
+    DISPATCH(floatToNormAVX2, Scalar::floatToUnorm8, pSrc, pDst, count);
+}
+
+void floatToUnorm16(const float* pSrc, uint16_t* pDst, size_t count)
+{
+    DISPATCH(floatToNormAVX2, Scalar::floatToUnorm16, pSrc, pDst, count);
+}
+
+void floatToSnorm8(const float* pSrc, int8_t* pDst, size_t count)
+{
+    DISPATCH(floatToNormAVX2, Scalar::floatToSnorm8, pSrc, pDst, count);
+}
+
+void floatToSnorm16(const float* pSrc, int16_t* pDst, size_t count)
+{
+    DISPATCH(floatToNormAVX2, Scalar::floatToSnorm16, pSrc, pDst, count);
+}
+
+#undef DISPATCH
+
+void swapRedBlue8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount, bool opaque)
+{
+    size_t offset = 0;
+#if FALCOR_PIXEL_CONVERSION_SIMD
+    if (kSimdEnabled)
+        offset = swapRedBlue8AVX2(pSrc, pDst, pixelCount, opaque);
+#endif
+    Scalar::swapRedBlue8(pSrc + offset * 4, pDst + offset * 4, pixelCount - offset, opaque);
+}
+
+void srgbToLinear(const float* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = srgbToLinearScalar(pSrc[i]);
+}
+
+void linearToSrgb(const float* pSrc, float* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = linearToSrgbScalar(pSrc[i]);
+}
+
+void srgb8ToFloat(const uint8_t* pSrc, float* pDst, size_t count)
+{
+    static const auto kTable = []()
+    {
+        std::array<float, 256> table;
+        for (uint32_t i = 0; i < 256; ++i)
+            table[i] = srgbToLinearScalar(float(i) / 255.f);
+        return table;
+    }();
+
+    for (size_t i = 0; i < count; ++i)
+        pDst[i] = kTable[pSrc[i]];
+}
+
+void floatToSrgb8(const float* pSrc, uint8_t* pDst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        float value = pSrc[i];
+        value = value > 0.f ? std::min(value, 1.f) : 0.f;
+        pDst[i] = floatToNormScalar<uint8_t>(linearToSrgbScalar(value));
+    }
+}
+
+bool isConvertibleToRGBA32Float(ResourceFormat format)
+{
+    if (format == ResourceFormat::Unknown || isCompressedFormat(format) || isDepthStencilFormat(format))
+        return false;
+
+    uint32_t channelCount = getFormatChannelCount(format);
+    uint32_t channelBits = getNumChannelBits(format, 0);
+    for (uint32_t c = 1; c < channelCount; ++c)
+    {
+        if (getNumChannelBits(format, c) != channelBits)
+            return false;
+    }
+
+    switch (getFormatType(format))
+    {
+    case FormatType::Float:
+        return channelBits == 16 || channelBits == 32;
+    case FormatType::Unorm:
+    case FormatType::Snorm:
+        return channelBits == 8 || channelBits == 16;
+    case FormatType::UnormSrgb:
+        return channelBits == 8;
+    case FormatType::Uint:
+    case FormatType::Sint:
+        return channelBits == 16 || channelBits == 32;
+    default:
+        return false;
+    }
+}
+
+void convertRowToRGBA32Float(ResourceFormat format, uint32_t width, const void* pSrcRow, float* pDst)
+{
+    FALCOR_ASSERT(isConvertibleToRGBA32Float(format));
+
+    const FormatType type = getFormatType(format);
+    const uint32_t channelCount = getFormatChannelCount(format);
+    const uint32_t channelBits = getNumChannelBits(format, 0);
+    const size_t rowValueCount = size_t(width) * channelCount;
+    const bool isBGR = format == ResourceFormat::BGRA8Unorm || format == ResourceFormat::BGRA8UnormSrgb ||
+                       format == ResourceFormat::BGRX8Unorm || format == ResourceFormat::BGRX8UnormSrgb;
+    const bool hasAlpha = doesFormatHaveAlpha(format);
+    const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(pSrcRow);
+
+    // Convert the channels to the start of the destination row, then expand to RGBA in place.
+    switch (type)
+    {
+    case FormatType::Float:
+        if (channelBits == 16)
+            halfToFloat(reinterpret_cast<const uint16_t*>(pSrc), pDst, rowValueCount);
+        else
+            std::memcpy(pDst, pSrc, rowValueCount * sizeof(float));
+        break;
+    case FormatType::Unorm:
+        if (channelBits == 8)
+            unorm8ToFloat(pSrc, pDst, rowValueCount);
+        else
+            unorm16ToFloat(reinterpret_cast<const uint16_t*>(pSrc), pDst, rowValueCount);
+        break;
+    case FormatType::UnormSrgb:
+        // The alpha channel is stored linearly.
+        srgb8ToFloat(pSrc, pDst, rowValueCount);
+        if (channelCount == 4)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+                unorm8ToFloat(pSrc + x * 4 + 3, pDst + x * 4 + 3, 1);
+        }
+        break;
+    case FormatType::Snorm:
+        if (channelBits == 8)
+            snorm8ToFloat(reinterpret_cast<const int8_t*>(pSrc), pDst, rowValueCount);
+        else
+            snorm16ToFloat(reinterpret_cast<const int16_t*>(pSrc), pDst, rowValueCount);
+        break;
+    case FormatType::Uint:
+        if (channelBits == 16)
+            unorm16ToFloat(reinterpret_cast<const uint16_t*>(pSrc), pDst, rowValueCount);
+        else
+            std::transform(
+                reinterpret_cast<const uint32_t*>(pSrc),
+                reinterpret_cast<const uint32_t*>(pSrc) + rowValueCount,
+                pDst,
+                normToFloatScalar<uint32_t>
+            );
+        break;
+    case FormatType::Sint:
+        if (channelBits == 16)
+            snorm16ToFloat(reinterpret_cast<const int16_t*>(pSrc), pDst, rowValueCount);
+        else
+            std::transform(
+                reinterpret_cast<const int32_t*>(pSrc),
+                reinterpret_cast<const int32_t*>(pSrc) + rowValueCount,
+                pDst,
+                normToFloatScalar<int32_t>
+            );
+        break;
+    default:
+        FALCOR_UNREACHABLE();
+    }
+
+    if (channelCount < 4)
+        expandToRGBA(pDst, channelCount, pDst, width, 1.f);
+
+    for (uint32_t x = 0; x < width; ++x)
+    {
+        float* pPixel = pDst + x * 4;
+        if (isBGR)
+            std::swap(pPixel[0], pPixel[2]);
+        if (!hasAlpha)
+            pPixel[3] = 1.f;
+    }
+}
+
+std::vector<float> convertToRGBA32Float(ResourceFormat format, uint32_t width, uint32_t height, const void* pData)
+{
+    FALCOR_CHECK(isConvertibleToRGBA32Float(format), "Format {} cannot be converted to RGBA32Float.", to_string(format));
+
+    const size_t srcRowPitch = size_t(width) * getFormatChannelCount(format) * getNumChannelBits(format, 0) / 8;
+
+    std::vector<float> floatData(size_t(width) * height * 4);
+
+    auto range = NumericRange<uint32_t>(0, height);
+    std::for_each(
+        std::execution::par,
+        range.begin(),
+        range.end(),
+        [&](uint32_t y)
+        {
+            const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(pData) + y * srcRowPitch;
+            convertRowToRGBA32Float(format, width, pSrc, floatData.data() + size_t(y) * width * 4);
+        }
+    );
+
+    return floatData;
+}
+
+} // namespace PixelConversion
+} // namespace Falcor
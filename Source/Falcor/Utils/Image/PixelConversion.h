@@ -0,0 +1,168 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Pixel format conversion routines.
+ *
+ * The element-wise conversions process `count` consecutive values. They use AVX2/F16C kernels when supported
+ * by the CPU and otherwise fall back to the scalar implementations in PixelConversion::Scalar, which define the
+ * reference results. Both paths produce bit-identical results:
+ * - Normalized integers are converted to float by division, snorm values are clamped to -1.
+ * - Floats are converted to normalized integers by clamping and rounding to nearest even, NaN maps to 0.
+ * - Half conversions round to nearest even.
+ *
+ * The image-level conversions process rows in parallel.
+ */
+namespace PixelConversion
+{
+/// Returns true if the AVX2/F16C kernels are used on this CPU.
+FALCOR_API bool isSimdEnabled();
+
+FALCOR_API void halfToFloat(const uint16_t* pSrc, float* pDst, size_t count);
+FALCOR_API void floatToHalf(const float* pSrc, uint16_t* pDst, size_t count);
+
+FALCOR_API void unorm8ToFloat(const uint8_t* pSrc, float* pDst, size_t count);
+FALCOR_API void unorm16ToFloat(const uint16_t* pSrc, float* pDst, size_t count);
+FALCOR_API void snorm8ToFloat(const int8_t* pSrc, float* pDst, size_t count);
+FALCOR_API void snorm16ToFloat(const int16_t* pSrc, float* pDst, size_t count);
+
+FALCOR_API void floatToUnorm8(const float* pSrc, uint8_t* pDst, size_t count);
+FALCOR_API void floatToUnorm16(const float* pSrc, uint16_t* pDst, size_t count);
+FALCOR_API void floatToSnorm8(const float* pSrc, int8_t* pDst, size_t count);
+FALCOR_API void floatToSnorm16(const float* pSrc, int16_t* pDst, size_t count);
+
+/**
+ * Swap the red and blue channels of 8-bit 4-channel pixels, i.e., convert between RGBA and BGRA.
+ * @param[in] pSrc Source pixels.
+ * @param[out] pDst Destination pixels, may be equal to pSrc.
+ * @param[in] pixelCount Number of pixels.
+ * @param[in] opaque Set the alpha channel to 255.
+ */
+FALCOR_API void swapRedBlue8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount, bool opaque = false);
+
+/// Convert sRGB encoded values to linear (scalar, uses the exact transfer function).
+FALCOR_API void srgbToLinear(const float* pSrc, float* pDst, size_t count);
+/// Convert linear values to sRGB encoding (scalar, uses the exact transfer function).
+FALCOR_API void linearToSrgb(const float* pSrc, float* pDst, size_t count);
+/// Convert sRGB encoded 8-bit values to linear floats using a lookup table.
+FALCOR_API void srgb8ToFloat(const uint8_t* pSrc, float* pDst, size_t count);
+/// Convert linear floats to sRGB encoded 8-bit values.
+FALCOR_API void floatToSrgb8(const float* pSrc, uint8_t* pDst, size_t count);
+
+/**
+ * Expand pixels to 4 channels, e.g., RGB to RGBA. Missing color channels are set to zero.
+ * Pixels are processed back to front, so the conversion can be done in place (pSrc == pDst).
+ * @param[in] pSrc Source pixels with srcChannelCount channels each.
+ * @param[in] srcChannelCount Number of source channels (1-4).
+ * @param[out] pDst Destination pixels with 4 channels each.
+ * @param[in] pixelCount Number of pixels.
+ * @param[in] alpha Alpha value for sources with less than 4 channels.
+ */
+template<typename T>
+void expandToRGBA(const T* pSrc, uint32_t srcChannelCount, T* pDst, size_t pixelCount, T alpha)
+{
+    for (size_t i = pixelCount; i-- > 0;)
+    {
+        T pixel[4] = {T(0), T(0), T(0), alpha};
+        for (uint32_t c = 0; c < srcChannelCount; ++c)
+            pixel[c] = pSrc[i * srcChannelCount + c];
+        for (uint32_t c = 0; c < 4; ++c)
+            pDst[i * 4 + c] = pixel[c];
+    }
+}
+
+/**
+ * Drop the alpha channel of 4-channel pixels, i.e., RGBA to RGB. Can be done in place (pSrc == pDst).
+ */
+template<typename T>
+void dropAlpha(const T* pSrc, T* pDst, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        T r = pSrc[i * 4], g = pSrc[i * 4 + 1], b = pSrc[i * 4 + 2];
+        pDst[i * 3] = r;
+        pDst[i * 3 + 1] = g;
+        pDst[i * 3 + 2] = b;
+    }
+}
+
+/**
+ * Check if images of a format can be converted with convertToRGBA32Float().
+ * Supported are uncompressed color formats with equally sized 8, 16 or 32-bit channels of type float (16/32-bit),
+ * unorm/snorm (8/16-bit), unorm sRGB (8-bit) and uint/sint (16/32-bit).
+ */
+FALCOR_API bool isConvertibleToRGBA32Float(ResourceFormat format);
+
+/**
+ * Convert an image to RGBA float. Rows are converted in parallel.
+ * Normalized formats are converted to float, sRGB formats are converted to linear and BGR formats are reordered.
+ * Integer formats are normalized to [0,1] (uint) or [-1,1] (sint). Missing alpha channels are set to 1.
+ * @param[in] format Format of the source image, see isConvertibleToRGBA32Float().
+ * @param[in] width Image width in pixels.
+ * @param[in] height Image height in pixels.
+ * @param[in] pData Source pixels, rows are tightly packed.
+ * @return The RGBA float pixels.
+ */
+FALCOR_API std::vector<float> convertToRGBA32Float(ResourceFormat format, uint32_t width, uint32_t height, const void* pData);
+
+/**
+ * Convert a row of pixels to RGBA float, using the same conversion as convertToRGBA32Float().
+ * @param[in] format Format of the source pixels, see isConvertibleToRGBA32Float().
+ * @param[in] width Number of pixels.
+ * @param[in] pSrc Source pixels.
+ * @param[out] pDst Destination RGBA float pixels (4 * width values).
+ */
+FALCOR_API void convertRowToRGBA32Float(ResourceFormat format, uint32_t width, const void* pSrc, float* pDst);
+
+/**
+ * Scalar reference implementations, used as fallback when AVX2/F16C is not available.
+ */
+namespace Scalar
+{
+FALCOR_API void halfToFloat(const uint16_t* pSrc, float* pDst, size_t count);
+FALCOR_API void floatToHalf(const float* pSrc, uint16_t* pDst, size_t count);
+FALCOR_API void unorm8ToFloat(const uint8_t* pSrc, float* pDst, size_t count);
+FALCOR_API void unorm16ToFloat(const uint16_t* pSrc, float* pDst, size_t count);
+FALCOR_API void snorm8ToFloat(const int8_t* pSrc, float* pDst, size_t count);
+FALCOR_API void snorm16ToFloat(const int16_t* pSrc, float* pDst, size_t count);
+FALCOR_API void floatToUnorm8(const float* pSrc, uint8_t* pDst, size_t count);
+FALCOR_API void floatToUnorm16(const float* pSrc, uint16_t* pDst, size_t count);
+FALCOR_API void floatToSnorm8(const float* pSrc, int8_t* pDst, size_t count);
+FALCOR_API void floatToSnorm16(const float* pSrc, int16_t* pDst, size_t count);
+FALCOR_API void swapRedBlue8(const uint8_t* pSrc, uint8_t* pDst, size_t pixelCount, bool opaque = false);
+} // namespace Scalar
+} // namespace PixelConversion
+} // namespace Falcor
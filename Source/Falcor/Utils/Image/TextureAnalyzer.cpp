@@ -26,7 +26,21 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "TextureAnalyzer.h"
+#include "Bitmap.h"
+#include "PixelConversion.h"
 #include "Core/API/RenderContext.h"
+#include "Utils/NumericRange.h"
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FALCOR_TEXTURE_ANALYZER_SIMD 1
+#include <emmintrin.h>
+#else
+#define FALCOR_TEXTURE_ANALYZER_SIMD 0
+#endif
 
 namespace Falcor
 {
@@ -39,6 +53,95 @@ static_assert((uint32_t)TextureChannelFlags::Blue == 0x4);
 static_assert((uint32_t)TextureChannelFlags::Alpha == 0x8);
 
 const char kShaderFilename[] = "Utils/Image/TextureAnalyzer.cs.slang";
+
+/// Number of pixels per tile in the CPU analysis. Tiles consist of whole rows.
+const size_t kCpuTilePixelCount = 1 << 16;
+
+/// Partial CPU analysis result for a range of pixels.
+struct CpuPartialResult
+{
+    uint32_t varying = 0; ///< Bit i set if channel i differs from the reference value.
+    uint32_t pos = 0;     ///< Bit i set if channel i has values > 0.
+    uint32_t neg = 0;     ///< Bit i set if channel i has values < 0.
+    uint32_t inf = 0;     ///< Bit i set if channel i has +/-inf values.
+    uint32_t nan = 0;     ///< Bit i set if channel i has NaN values.
+    float4 minValue = float4(std::numeric_limits<float>::max());
+    float4 maxValue = float4(0.f);
+
+    void merge(const CpuPartialResult& other)
+    {
+        varying |= other.varying;
+        pos |= other.pos;
+        neg |= other.neg;
+        inf |= other.inf;
+        nan |= other.nan;
+        minValue = min(minValue, other.minValue);
+        maxValue = max(maxValue, other.maxValue);
+    }
+};
+
+/**
+ * Analyze a span of RGBA float pixels. Semantics match the GPU analysis:
+ * channels are compared using '!=' (so NaN counts as varying), and min/max are computed on values clamped to zero (NaN as zero).
+ */
+void analyzePixels(const float* pPixels, size_t pixelCount, const float4& ref, CpuPartialResult& result)
+{
+    size_t i = 0;
+#if FALCOR_TEXTURE_ANALYZER_SIMD
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 refValue = _mm_setr_ps(ref.x, ref.y, ref.z, ref.w);
+
+    __m128 varyingMask = zero, posMask = zero, negMask = zero, infMask = zero, nanMask = zero;
+    __m128 minValue = _mm_setr_ps(result.minValue.x, result.minValue.y, result.minValue.z, result.minValue.w);
+    __m128 maxValue = _mm_setr_ps(result.maxValue.x, result.maxValue.y, result.maxValue.z, result.maxValue.w);
+
+    for (; i < pixelCount; ++i)
+    {
+        __m128 v = _mm_loadu_ps(pPixels + i * 4);
+        varyingMask = _mm_or_ps(varyingMask, _mm_cmpneq_ps(v, refValue));
+        posMask = _mm_or_ps(posMask, _mm_cmpgt_ps(v, zero));
+        negMask = _mm_or_ps(negMask, _mm_cmplt_ps(v, zero));
+        infMask = _mm_or_ps(infMask, _mm_cmpeq_ps(_mm_and_ps(v, absMask), inf));
+        nanMask = _mm_or_ps(nanMask, _mm_cmpunord_ps(v, v));
+        // _mm_max_ps returns the second operand if either is NaN, which clamps NaN to zero.
+        __m128 clamped = _mm_max_ps(v, zero);
+        minValue = _mm_min_ps(minValue, clamped);
+        maxValue = _mm_max_ps(maxValue, clamped);
+    }
+
+    result.varying |= _mm_movemask_ps(varyingMask);
+    result.pos |= _mm_movemask_ps(posMask);
+    result.neg |= _mm_movemask_ps(negMask);
+    result.inf |= _mm_movemask_ps(infMask);
+    result.nan |= _mm_movemask_ps(nanMask);
+    _mm_storeu_ps(&result.minValue.x, minValue);
+    _mm_storeu_ps(&result.maxValue.x, maxValue);
+#else
+    for (; i < pixelCount; ++i)
+    {
+        const float* v = pPixels + i * 4;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const uint32_t bit = 1u << c;
+            if (v[c] != ref[c])
+                result.varying |= bit;
+            if (v[c] > 0.f)
+                result.pos |= bit;
+            if (v[c] < 0.f)
+                result.neg |= bit;
+            if (std::isinf(v[c]))
+                result.inf |= bit;
+            if (std::isnan(v[c]))
+                result.nan |= bit;
+            const float clamped = v[c] > 0.f ? v[c] : 0.f;
+            result.minValue[c] = std::min(result.minValue[c], clamped);
+            result.maxValue[c] = std::max(result.maxValue[c], clamped);
+        }
+    }
+#endif
+}
 } // namespace
 
 // Verify that the result struct matches the size expected by the shader.
@@ -126,6 +229,108 @@ void TextureAnalyzer::clear(RenderContext* pRenderContext, ref<Buffer> pResult,
     mpClearPass->execute(pRenderContext, uint3(resultCount, 1, 1));
 }
 
+bool TextureAnalyzer::isCpuFormatSupported(ResourceFormat format)
+{
+    FormatType type = getFormatType(format);
+    return PixelConversion::isConvertibleToRGBA32Float(format) && type != FormatType::Uint && type != FormatType::Sint;
+}
+
+TextureAnalyzer::Result TextureAnalyzer::analyzeCpu(ResourceFormat format, uint32_t width, uint32_t height, size_t rowPitch, const void* pData)
+{
+    FALCOR_CHECK(isCpuFormatSupported(format), "Format {} is not supported", to_string(format));
+    FALCOR_CHECK(width > 0 && height > 0, "Image dimensions must be non-zero");
+    FALCOR_ASSERT(pData && rowPitch >= width * getFormatBytesPerBlock(format));
+
+    const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pData);
+    const bool isFloat4 = format == ResourceFormat::RGBA32Float;
+
+    // Read reference value from top-left texel.
+    float4 ref;
+    PixelConversion::convertRowToRGBA32Float(format, 1, pBytes, &ref.x);
+
+    // Split the image into tiles of whole rows and analyze them in parallel.
+    const uint32_t rowsPerTile = (uint32_t)std::clamp<size_t>(kCpuTilePixelCount / width, 1, height);
+    const uint32_t tileCount = (height + rowsPerTile - 1) / rowsPerTile;
+    std::vector<CpuPartialResult> tileResults(tileCount);
+
+    auto range = NumericRange<uint32_t>(0, tileCount);
+    std::for_each(
+        std::execution::par,
+        range.begin(),
+        range.end(),
+        [&](uint32_t tile)
+        {
+            CpuPartialResult& result = tileResults[tile];
+            const uint32_t yEnd = std::min(height, (tile + 1) * rowsPerTile);
+
+            std::vector<float> row;
+            if (!isFloat4)
+                row.resize(size_t(width) * 4);
+
+            for (uint32_t y = tile * rowsPerTile; y < yEnd; ++y)
+            {
+                const uint8_t* pRow = pBytes + y * rowPitch;
+                if (isFloat4)
+                {
+                    analyzePixels(reinterpret_cast<const float*>(pRow), width, ref, result);
+                }
+                else
+                {
+                    PixelConversion::convertRowToRGBA32Float(format, width, pRow, row.data());
+                    analyzePixels(row.data(), width, ref, result);
+                }
+            }
+        }
+    );
+
+    CpuPartialResult total;
+    for (const auto& result : tileResults)
+        total.merge(result);
+
+    // Pack the result in the same layout as the GPU analysis.
+    Result result = {};
+    result.mask = total.varying;
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        uint32_t range = 0;
+        if (total.pos & (1u << c))
+            range |= (uint32_t)Result::RangeFlags::Pos;
+        if (total.neg & (1u << c))
+            range |= (uint32_t)Result::RangeFlags::Neg;
+        if (total.inf & (1u << c))
+            range |= (uint32_t)Result::RangeFlags::Inf;
+        if (total.nan & (1u << c))
+            range |= (uint32_t)Result::RangeFlags::NaN;
+        result.mask |= range << (4 + 4 * c);
+    }
+    result.value = ref;
+    result.minValue = total.minValue;
+    result.maxValue = total.maxValue;
+
+    return result;
+}
+
+TextureAnalyzer::Result TextureAnalyzer::analyzeCpu(const Bitmap& bitmap)
+{
+    return analyzeCpu(bitmap.getFormat(), bitmap.getWidth(), bitmap.getHeight(), bitmap.getRowPitch(), bitmap.getData());
+}
+
+std::vector<TextureAnalyzer::Result> TextureAnalyzer::analyzeCpu(const std::vector<const Bitmap*>& bitmaps)
+{
+    for (const Bitmap* pBitmap : bitmaps)
+    {
+        FALCOR_CHECK(pBitmap, "Bitmap is missing");
+        FALCOR_CHECK(isCpuFormatSupported(pBitmap->getFormat()), "Format {} is not supported", to_string(pBitmap->getFormat()));
+    }
+
+    std::vector<Result> results(bitmaps.size());
+
+    auto range = NumericRange<size_t>(0, bitmaps.size());
+    std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i) { results[i] = analyzeCpu(*bitmaps[i]); });
+
+    return results;
+}
+
 void TextureAnalyzer::checkFormatSupport(const ref<Texture> pInput, uint32_t mipLevel, uint32_t arraySlice) const
 {
     // Validate that input is supported.
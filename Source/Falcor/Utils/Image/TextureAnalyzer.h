@@ -38,6 +38,7 @@
 namespace Falcor
 {
 class RenderContext;
+class Bitmap;
 
 /**
  * A class for analyzing texture contents.
@@ -145,6 +146,41 @@ public:
      */
     static size_t getResultSize();
 
+    /**
+     * Check if a format can be analyzed on the CPU.
+     * The supported formats are the ones handled by PixelConversion::convertToRGBA32Float(), excluding integer formats.
+     */
+    static bool isCpuFormatSupported(ResourceFormat format);
+
+    /**
+     * Analyze 2D image data on the CPU.
+     * This produces the same result as the GPU analysis of the equivalent texture, and can be used on image data before it
+     * is uploaded. The image is split into tiles of rows that are analyzed in parallel.
+     * Throws an exception if the format is not supported, see isCpuFormatSupported().
+     * @param[in] format Format of the image data.
+     * @param[in] width Width in pixels.
+     * @param[in] height Height in pixels.
+     * @param[in] rowPitch Size of a row in bytes.
+     * @param[in] pData Image data.
+     * @return The analysis result.
+     */
+    static Result analyzeCpu(ResourceFormat format, uint32_t width, uint32_t height, size_t rowPitch, const void* pData);
+
+    /**
+     * Analyze a bitmap on the CPU. See analyzeCpu() above.
+     * @param[in] bitmap The bitmap.
+     * @return The analysis result.
+     */
+    static Result analyzeCpu(const Bitmap& bitmap);
+
+    /**
+     * Batch analysis of a set of bitmaps on the CPU. The bitmaps are analyzed in parallel.
+     * Throws an exception if any bitmap is of unsupported format.
+     * @param[in] bitmaps Array of bitmaps.
+     * @return Array of analysis results, one per bitmap.
+     */
+    static std::vector<Result> analyzeCpu(const std::vector<const Bitmap*>& bitmaps);
+
 private:
     void checkFormatSupport(const ref<Texture> pInput, uint32_t mipLevel, uint32_t arraySlice) const;
 
@@ -0,0 +1,394 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "TextureDecoder.h"
+#include "Bitmap.h"
+#include "ImageIO.h"
+#include "PixelConversion.h"
+#include "Core/Error.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Logger.h"
+#include "Utils/NumericRange.h"
+
+#include <algorithm>
+#include <cstring>
+#include <execution>
+#include <map>
+#include <mutex>
+#include <numeric>
+
+namespace Falcor
+{
+namespace
+{
+const bool kTopDown = true; // Memory layout when loading from file
+
+std::shared_ptr<TextureDecoder::Texels> convertTexels(ResourceFormat format, uint32_t width, uint32_t height, const void* pData)
+{
+    if (!PixelConversion::isConvertibleToRGBA32Float(format))
+        return nullptr;
+
+    auto pTexels = std::make_shared<TextureDecoder::Texels>();
+    pTexels->width = width;
+    pTexels->height = height;
+    pTexels->data = PixelConversion::convertToRGBA32Float(format, width, height, pData);
+    return pTexels;
+}
+
+/// File identity used to validate cached analysis results.
+struct FileStamp
+{
+    uintmax_t size = 0;
+    time_t modifiedTime = 0;
+
+    bool operator==(const FileStamp& other) const { return size == other.size && modifiedTime == other.modifiedTime; }
+};
+
+FileStamp getFileStamp(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    FileStamp stamp;
+    stamp.size = std::filesystem::file_size(path, ec);
+    stamp.modifiedTime = getFileModifiedTime(path);
+    return stamp;
+}
+
+/**
+ * Process-wide cache of texture analysis results.
+ * Entries are validated against the file size and modification time, so edited files are analyzed again.
+ */
+class AnalysisCache
+{
+public:
+    static AnalysisCache& get()
+    {
+        static AnalysisCache cache;
+        return cache;
+    }
+
+    std::optional<TextureAnalyzer::Result> find(const std::filesystem::path& path, ResourceFormat format, const FileStamp& stamp) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mEntries.find({path, format});
+        if (it != mEntries.end() && it->second.stamp == stamp)
+            return it->second.result;
+        return {};
+    }
+
+    void insert(const std::filesystem::path& path, ResourceFormat format, const FileStamp& stamp, const TextureAnalyzer::Result& result)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mEntries[{path, format}] = Entry{stamp, result};
+    }
+
+private:
+    struct Entry
+    {
+        FileStamp stamp;
+        TextureAnalyzer::Result result;
+    };
+
+    mutable std::mutex mMutex;
+    std::map<std::pair<std::filesystem::path, ResourceFormat>, Entry> mEntries;
+};
+} // namespace
+
+struct TextureDecoder::Job
+{
+    DecodedTexture result;
+    std::vector<Bitmap::UniqueConstPtr> mips; ///< Decoded mip levels waiting to be copied into the staging buffer.
+    std::vector<uint8_t> data;                ///< Decoded data of a single DDS file waiting to be copied into the staging buffer.
+    bool decoded = false;                     ///< True if the texture has been decoded.
+    bool done = false;                        ///< True if the result is final.
+
+    size_t getSize() const
+    {
+        size_t size = data.size();
+        for (const auto& mip : mips)
+            size += mip->getSize();
+        return size;
+    }
+
+    void copyTo(uint8_t* pDst)
+    {
+        if (!data.empty())
+            std::memcpy(pDst, data.data(), data.size());
+        pDst += data.size();
+        for (const auto& mip : mips)
+        {
+            std::memcpy(pDst, mip->getData(), mip->getSize());
+            pDst += mip->getSize();
+        }
+        mips.clear();
+        data.clear();
+        data.shrink_to_fit();
+    }
+};
+
+TextureDecoder::TextureDecoder(size_t stagingSize) : mStagingSize(stagingSize) {}
+
+TextureDecoder::~TextureDecoder() {}
+
+size_t TextureDecoder::decode(fstd::span<const Request> requests, const BatchCallback& callback)
+{
+    FALCOR_ASSERT(callback);
+
+    std::vector<Job> jobs(requests.size());
+    for (size_t i = 0; i < jobs.size(); i++)
+        jobs[i].result.requestIndex = i;
+
+    std::vector<size_t> pending(requests.size());
+    std::iota(pending.begin(), pending.end(), size_t(0));
+    std::vector<size_t> remaining;
+    std::vector<DecodedTexture> batch;
+    size_t batchCount = 0;
+
+    while (!pending.empty())
+    {
+        if (!mpStaging && mStagingSize > 0)
+            mpStaging.reset(new uint8_t[mStagingSize]);
+        mStagingOffset.store(0);
+
+        // Decode and stage textures in parallel until the staging buffer is full.
+        // Textures that were decoded but didn't fit are kept and staged first in the next batch.
+        std::atomic<bool> stagingFull{false};
+        NumericRange<size_t> range(0, pending.size());
+        std::for_each(
+            std::execution::par,
+            range.begin(),
+            range.end(),
+            [&](size_t i)
+            {
+                Job& job = jobs[pending[i]];
+                if (!job.decoded)
+                {
+                    // Don't start decoding more textures if there is no space left to hold them.
+                    if (stagingFull.load(std::memory_order_relaxed))
+                        return;
+                    if (!decodeJob(job, requests[job.result.requestIndex]))
+                    {
+                        job.done = true;
+                        return;
+                    }
+                }
+                if (!stageJob(job))
+                    stagingFull.store(true, std::memory_order_relaxed);
+            }
+        );
+
+        // Collect finished jobs in request order.
+        batch.clear();
+        remaining.clear();
+        for (size_t index : pending)
+        {
+            if (jobs[index].done)
+                batch.push_back(jobs[index].result);
+            else
+                remaining.push_back(index);
+        }
+
+        if (batch.empty())
+        {
+            // None of the decoded textures fit. The first texture to be staged in a batch always fits
+            // unless it is larger than the staging buffer, so grow the buffer to fit the largest one.
+            size_t requiredSize = 0;
+            for (size_t index : remaining)
+                requiredSize = std::max(requiredSize, jobs[index].getSize());
+            FALCOR_ASSERT(requiredSize > mStagingSize);
+            logDebug("TextureDecoder: Growing staging buffer from {} to {} bytes.", mStagingSize, requiredSize);
+            mStagingSize = requiredSize;
+            mpStaging.reset();
+            continue;
+        }
+
+        callback(batch);
+        batchCount++;
+        std::swap(pending, remaining);
+    }
+
+    return batchCount;
+}
+
+TextureDecoder::DecodedTexture TextureDecoder::decode(const Request& request, std::vector<uint8_t>& data)
+{
+    Job job;
+    if (!decodeJob(job, request))
+        return job.result;
+
+    if (!job.data.empty())
+    {
+        // Single DDS files are already decoded into one contiguous buffer.
+        data = std::move(job.data);
+    }
+    else
+    {
+        data.resize(job.getSize());
+        job.copyTo(data.data());
+    }
+
+    job.result.status = Status::Decoded;
+    job.result.pData = data.data();
+    job.result.size = data.size();
+    return job.result;
+}
+
+bool TextureDecoder::decodeJob(Job& job, const Request& request)
+{
+    const auto& paths = request.paths;
+    DecodedTexture& result = job.result;
+    FALCOR_ASSERT(!paths.empty());
+
+    // Single DDS files can hold arrays, cube maps, volumes and mip chains. Decode all subresources.
+    // Their data is used as is, so analysis is not supported.
+    if (paths.size() == 1 && hasExtension(paths[0], "dds"))
+    {
+        try
+        {
+            ImageIO::DDSData dds = ImageIO::loadDDSData(paths[0], request.loadAsSRGB);
+            result.type = dds.type;
+            result.format = dds.format;
+            result.width = dds.width;
+            result.height = dds.height;
+            result.depth = dds.depth;
+            result.arraySize = dds.arraySize;
+            result.mipCount = dds.mipLevels;
+            job.data = std::move(dds.data);
+
+            // The data starts with mip 0 of the first array slice.
+            if (request.keepTexels && result.type == Resource::Type::Texture2D && result.arraySize == 1)
+                result.pTexels = convertTexels(result.format, result.width, result.height, job.data.data());
+        }
+        catch (const std::exception& e)
+        {
+            logWarning("Error loading '{}': {}", paths[0], e.what());
+            result.status = Status::Failed;
+            return false;
+        }
+        job.decoded = true;
+        return true;
+    }
+
+    try
+    {
+        for (const auto& path : paths)
+        {
+            Bitmap::UniqueConstPtr pBitmap =
+                hasExtension(path, "dds") ? ImageIO::loadBitmapFromDDS(path) : Bitmap::createFromFile(path, kTopDown);
+            if (!pBitmap)
+            {
+                logWarning("Error loading mip {}. Loading failed for image file '{}'.", job.mips.size(), path);
+                break;
+            }
+
+            if (!job.mips.empty())
+            {
+                const auto& pPrev = job.mips.back();
+                if (pPrev->getFormat() != pBitmap->getFormat())
+                {
+                    logWarning("Error loading mip {} from file {}. Texture format of all mip levels must match.", job.mips.size(), path);
+                    break;
+                }
+                if (std::max(pPrev->getWidth() / 2, 1u) != pBitmap->getWidth() ||
+                    std::max(pPrev->getHeight() / 2, 1u) != pBitmap->getHeight())
+                {
+                    logWarning(
+                        "Error loading mip {} from file {}. Image resolution must decrease by half. ({}, {}) != ({}, {})/2",
+                        job.mips.size(),
+                        path,
+                        pBitmap->getWidth(),
+                        pBitmap->getHeight(),
+                        pPrev->getWidth(),
+                        pPrev->getHeight()
+                    );
+                    break;
+                }
+            }
+            job.mips.emplace_back(std::move(pBitmap));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        logWarning("Error loading '{}': {}", paths[0], e.what());
+        job.mips.clear();
+    }
+
+    if (job.mips.empty())
+    {
+        result.status = Status::Failed;
+        return false;
+    }
+
+    const auto& pMip0 = job.mips[0];
+    result.format = request.loadAsSRGB ? linearToSrgbFormat(pMip0->getFormat()) : pMip0->getFormat();
+    result.width = pMip0->getWidth();
+    result.height = pMip0->getHeight();
+    result.mipCount = (uint32_t)job.mips.size();
+
+    // Analyze mip 0 while it is in CPU memory. This runs on the decoding thread.
+    if (request.analyze && TextureAnalyzer::isCpuFormatSupported(result.format))
+    {
+        const auto& path = paths[0];
+        const FileStamp stamp = getFileStamp(path);
+        result.analysis = AnalysisCache::get().find(path, result.format, stamp);
+        if (!result.analysis)
+        {
+            result.analysis =
+                TextureAnalyzer::analyzeCpu(result.format, result.width, result.height, pMip0->getRowPitch(), pMip0->getData());
+            AnalysisCache::get().insert(path, result.format, stamp, *result.analysis);
+        }
+    }
+
+    if (request.keepTexels)
+        result.pTexels = convertTexels(result.format, result.width, result.height, pMip0->getData());
+
+    job.decoded = true;
+    return true;
+}
+
+bool TextureDecoder::stageJob(Job& job)
+{
+    FALCOR_ASSERT(job.decoded && !job.done);
+
+    // Reserve space in the staging buffer.
+    const size_t size = job.getSize();
+    size_t offset = mStagingOffset.load(std::memory_order_relaxed);
+    do
+    {
+        if (offset + size > mStagingSize)
+            return false;
+    } while (!mStagingOffset.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+
+    // Copy all subresources into the staging buffer and release the decoded images.
+    job.copyTo(mpStaging.get() + offset);
+
+    job.result.status = Status::Decoded;
+    job.result.pData = mpStaging.get() + offset;
+    job.result.size = size;
+    job.done = true;
+    return true;
+}
+} // namespace Falcor
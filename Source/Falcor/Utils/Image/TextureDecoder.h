@@ -0,0 +1,148 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include "Core/API/Formats.h"
+#include "Core/API/Resource.h"
+#include "TextureAnalyzer.h"
+#include <fstd/span.h>
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * CPU texture decoder.
+ *
+ * Decodes image files into a pooled staging buffer in parallel, without requiring a GPU device.
+ * Single DDS files are decoded with all their array slices and mip levels, including cube maps and volumes.
+ * Decoding is done in batches: each batch decodes as many textures as fit into the staging buffer,
+ * then hands the decoded data to a callback on the calling thread, which typically uploads it to the GPU.
+ * The staging buffer is reused for the next batch once the callback returns.
+ *
+ * This keeps the expensive image decoding off the upload path and bounds the amount of CPU memory
+ * held by decoded textures that are waiting for upload.
+ *
+ * The decoder can optionally analyze the contents of mip 0 while the data is still in CPU memory (see TextureAnalyzer).
+ * Analysis results are cached for the lifetime of the process, keyed by file path, file size, modification time and format,
+ * so that repeat loads of the same file skip the analysis.
+ * It can also keep a copy of mip 0 converted to linear RGBA float for CPU processing that needs the texels after upload.
+ */
+class FALCOR_API TextureDecoder
+{
+public:
+    /// Default size of the staging buffer in bytes.
+    static constexpr size_t kDefaultStagingSize = size_t(256) << 20;
+
+    /// Request to decode a texture.
+    struct Request
+    {
+        std::vector<std::filesystem::path> paths; ///< Path to the image file, or one path per mip level starting at mip 0.
+        bool loadAsSRGB = false;                  ///< Use sRGB format if supported.
+        bool analyze = false;                     ///< Analyze the contents of mip 0 on the CPU.
+        bool keepTexels = false;                  ///< Keep mip 0 converted to linear RGBA float (see DecodedTexture::pTexels).
+    };
+
+    /// Texels of mip 0 converted to linear RGBA float.
+    struct Texels
+    {
+        uint32_t width = 0;      ///< Width in texels.
+        uint32_t height = 0;     ///< Height in texels.
+        std::vector<float> data; ///< RGBA texels (width * height * 4 floats), rows tightly packed.
+    };
+
+    /// Status of a decoded texture.
+    enum class Status
+    {
+        Decoded, ///< Texture data was decoded into the staging buffer.
+        Failed,  ///< Decoding failed.
+    };
+
+    /// Decoded texture.
+    struct DecodedTexture
+    {
+        size_t requestIndex = 0;                         ///< Index of the request.
+        Status status = Status::Failed;                  ///< Decoding status.
+        Resource::Type type = Resource::Type::Texture2D; ///< Texture type.
+        ResourceFormat format = ResourceFormat::Unknown; ///< Texture format.
+        uint32_t width = 0;                              ///< Width of mip 0.
+        uint32_t height = 0;                             ///< Height of mip 0.
+        uint32_t depth = 1;                              ///< Depth of mip 0.
+        uint32_t arraySize = 1;                          ///< Number of array slices. Cube maps have 6 slices per cube.
+        uint32_t mipCount = 0;                           ///< Number of mip levels in the data.
+        const uint8_t* pData = nullptr;                  ///< Data of all subresources by array slice, then mip. Only valid during the callback.
+        size_t size = 0;                                 ///< Size of the data in bytes.
+        std::optional<TextureAnalyzer::Result> analysis; ///< Analysis of mip 0, if requested and the format is supported.
+        std::shared_ptr<Texels> pTexels;                 ///< Texels of mip 0, if requested and the format is convertible.
+    };
+
+    /// Callback receiving a batch of decoded textures, ordered by request index.
+    using BatchCallback = std::function<void(fstd::span<const DecodedTexture>)>;
+
+    /**
+     * Constructor.
+     * @param[in] stagingSize Size of the staging buffer in bytes. The buffer grows if a single texture does not fit.
+     */
+    explicit TextureDecoder(size_t stagingSize = kDefaultStagingSize);
+    ~TextureDecoder();
+
+    /**
+     * Decode textures in parallel.
+     * Each request is reported exactly once to the callback. The callback is called on the calling thread.
+     * @param[in] requests Decode requests.
+     * @param[in] callback Callback called once per batch.
+     * @return Number of batches.
+     */
+    size_t decode(fstd::span<const Request> requests, const BatchCallback& callback);
+
+    /**
+     * Decode a single texture on the calling thread, bypassing the staging buffer.
+     * @param[in] request Decode request.
+     * @param[out] data Storage for the decoded data. The returned pData points into it.
+     * @return Decoded texture.
+     */
+    static DecodedTexture decode(const Request& request, std::vector<uint8_t>& data);
+
+    /// Get the current size of the staging buffer in bytes.
+    size_t getStagingSize() const { return mStagingSize; }
+
+private:
+    struct Job;
+
+    static bool decodeJob(Job& job, const Request& request);
+    bool stageJob(Job& job);
+
+    size_t mStagingSize = 0;
+    std::unique_ptr<uint8_t[]> mpStaging;
+    std::atomic<size_t> mStagingOffset{0};
+};
+} // namespace Falcor
@@ -0,0 +1,208 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Error.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace Falcor
+{
+/**
+ * Lock-free table of slots addressed by a 32-bit ID.
+ *
+ * This is used by the texture manager to hand out texture handles and store per-texture data,
+ * such that handles can be allocated, released and looked up concurrently from multiple threads
+ * without taking a lock.
+ *
+ * Slots are stored in fixed-size pages which are allocated on demand and never move,
+ * so references to slots stay valid for the lifetime of the table. Released IDs are
+ * recycled through a lock-free free list. The table does not synchronize access to the
+ * slot contents; the caller is responsible for that (e.g. by using atomics in T).
+ *
+ * @tparam T Slot type. Must be default constructible.
+ */
+template<typename T>
+class TextureHandleTable
+{
+public:
+    static constexpr uint32_t kInvalidID = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kPageBits = 12;
+    static constexpr uint32_t kPageSize = 1u << kPageBits;
+
+    /**
+     * Constructor.
+     * @param[in] maxCount Maximum number of slots.
+     */
+    explicit TextureHandleTable(size_t maxCount)
+        : mMaxCount((uint32_t)std::min<size_t>(maxCount, kInvalidID)), mPageCount((mMaxCount + kPageSize - 1) >> kPageBits)
+    {
+        mPages = std::make_unique<std::atomic<Page*>[]>(mPageCount);
+        for (uint32_t i = 0; i < mPageCount; i++)
+            mPages[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~TextureHandleTable()
+    {
+        for (uint32_t i = 0; i < mPageCount; i++)
+            delete mPages[i].load(std::memory_order_relaxed);
+    }
+
+    TextureHandleTable(const TextureHandleTable&) = delete;
+    TextureHandleTable& operator=(const TextureHandleTable&) = delete;
+
+    /**
+     * Allocate a slot. Previously released slots are reused first.
+     * The slot contents are left as they were when the slot was released.
+     * @return ID of the allocated slot, or kInvalidID if the table is full.
+     */
+    uint32_t allocate()
+    {
+        // Try to pop an ID from the free list.
+        uint64_t head = mFreeHead.load(std::memory_order_acquire);
+        while (getHeadID(head) != kInvalidID)
+        {
+            uint32_t id = getHeadID(head);
+            uint32_t next = getSlot(id).nextFree.load(std::memory_order_relaxed);
+            // The tag is incremented on every update to avoid the ABA problem.
+            uint64_t newHead = makeHead(next, getHeadTag(head) + 1);
+            if (mFreeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+                return id;
+        }
+
+        // Allocate a new ID.
+        uint32_t id = mAllocatedCount.load(std::memory_order_relaxed);
+        do
+        {
+            if (id >= mMaxCount)
+                return kInvalidID;
+        } while (!mAllocatedCount.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+
+        ensurePage(id >> kPageBits);
+        return id;
+    }
+
+    /**
+     * Release a slot. The ID is returned to the free list and may be reused by a subsequent allocate().
+     * @param[in] id Slot ID. Must be a currently allocated ID.
+     */
+    void release(uint32_t id)
+    {
+        FALCOR_ASSERT(id < mAllocatedCount.load(std::memory_order_relaxed));
+        Slot& slot = getSlot(id);
+        uint64_t head = mFreeHead.load(std::memory_order_relaxed);
+        do
+        {
+            slot.nextFree.store(getHeadID(head), std::memory_order_relaxed);
+        } while (!mFreeHead.compare_exchange_weak(
+            head, makeHead(id, getHeadTag(head) + 1), std::memory_order_release, std::memory_order_relaxed
+        ));
+    }
+
+    /**
+     * Get the slot for an ID.
+     * Slots for IDs that are being allocated concurrently may be returned before allocate() returns.
+     * @param[in] id Slot ID.
+     * @return Pointer to the slot, or nullptr if the slot's page has not been allocated yet.
+     */
+    T* tryGet(uint32_t id)
+    {
+        if (id >= mMaxCount)
+            return nullptr;
+        Page* pPage = mPages[id >> kPageBits].load(std::memory_order_acquire);
+        return pPage ? &pPage->slots[id & (kPageSize - 1)].value : nullptr;
+    }
+
+    const T* tryGet(uint32_t id) const { return const_cast<TextureHandleTable*>(this)->tryGet(id); }
+
+    /**
+     * Get the slot for an ID. Throws if the ID was never allocated.
+     * @param[in] id Slot ID.
+     */
+    T& operator[](uint32_t id)
+    {
+        T* pValue = tryGet(id);
+        FALCOR_CHECK(pValue != nullptr, "Invalid texture handle ID ({}).", id);
+        return *pValue;
+    }
+
+    const T& operator[](uint32_t id) const { return const_cast<TextureHandleTable&>(*this)[id]; }
+
+    /**
+     * Get the number of IDs handed out so far, including released ones.
+     * This is an upper bound on the allocated IDs, i.e. the number of entries to bind on the GPU.
+     */
+    uint32_t size() const { return std::min(mAllocatedCount.load(std::memory_order_acquire), mMaxCount); }
+
+    /// Get the maximum number of slots.
+    uint32_t getMaxCount() const { return mMaxCount; }
+
+private:
+    struct Slot
+    {
+        T value;
+        std::atomic<uint32_t> nextFree{kInvalidID};
+    };
+
+    struct Page
+    {
+        Slot slots[kPageSize];
+    };
+
+    static uint32_t getHeadID(uint64_t head) { return uint32_t(head); }
+    static uint32_t getHeadTag(uint64_t head) { return uint32_t(head >> 32); }
+    static uint64_t makeHead(uint32_t id, uint32_t tag) { return (uint64_t(tag) << 32) | id; }
+
+    Slot& getSlot(uint32_t id)
+    {
+        Page* pPage = mPages[id >> kPageBits].load(std::memory_order_acquire);
+        FALCOR_ASSERT(pPage);
+        return pPage->slots[id & (kPageSize - 1)];
+    }
+
+    void ensurePage(uint32_t pageIndex)
+    {
+        if (mPages[pageIndex].load(std::memory_order_acquire))
+            return;
+        // Multiple threads may race to allocate the same page. Only one of them wins.
+        auto pPage = std::make_unique<Page>();
+        Page* pExpected = nullptr;
+        if (mPages[pageIndex].compare_exchange_strong(pExpected, pPage.get(), std::memory_order_acq_rel))
+            pPage.release();
+    }
+
+    const uint32_t mMaxCount;
+    const uint32_t mPageCount;
+    std::unique_ptr<std::atomic<Page*>[]> mPages;
+
+    std::atomic<uint32_t> mAllocatedCount{0};                  ///< Number of IDs taken from the bump allocator.
+    std::atomic<uint64_t> mFreeHead{makeHead(kInvalidID, 0)}; ///< Head of the free list, tagged with an update counter.
+};
+} // namespace Falcor
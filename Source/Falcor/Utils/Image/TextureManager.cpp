@@ -29,9 +29,6 @@
 #include "Core/AssetResolver.h"
 #include "Core/API/Device.h"
 #include "Utils/Logger.h"
-#include "Utils/NumericRange.h"
-
-#include <execution>
 
 // Temporarily disable asynchronous texture loader until Falcor supports parallel GPU work submission.
 // Until then `TextureManager` should only called from the main thread.
@@ -46,7 +43,10 @@ static_assert(TextureManager::CpuTextureHandle::kInvalidID >= kMaxTextureHandleC
 } // namespace
 
 TextureManager::TextureManager(ref<Device> pDevice, size_t maxTextureCount, size_t threadCount)
-    : mpDevice(pDevice), mAsyncTextureLoader(pDevice, threadCount), mMaxTextureCount(std::min(maxTextureCount, kMaxTextureHandleCount))
+    : mpDevice(pDevice)
+    , mTextures(std::min(maxTextureCount, kMaxTextureHandleCount))
+    , mAsyncTextureLoader(pDevice, threadCount)
+    , mMaxTextureCount(std::min(maxTextureCount, kMaxTextureHandleCount))
 {}
 
 TextureManager::~TextureManager() {}
@@ -70,8 +70,7 @@ TextureManager::CpuTextureHandle TextureManager::addTexture(const ref<Texture>&
     else
     {
         // Texture is not already managed. Add new texture desc.
-        TextureDesc desc = {TextureState::Loaded, pTexture};
-        handle = addDesc(desc);
+        handle = addDesc(TextureState::Loaded, pTexture);
 
         // Add to texture-to-handle map.
         mTextureToHandle[pTexture.get()] = handle;
@@ -130,7 +129,7 @@ TextureManager::CpuTextureHandle TextureManager::loadUdimTexture(
     std::vector<std::filesystem::path> texturePaths;
     // Find the first directory containing the pattern, in case the UDIM set lives in multiple available directories
     if (assetResolver)
-        texturePaths = assetResolver->resolvePathPattern(dirpath, filename, true /* firstMatchOnly */);
+        texturePaths = assetResolver->resolvePathPattern(dirpath, udimRegex, true /* firstMatchOnly */);
     else
         texturePaths = globFilesInDirectory(dirpath, udimRegex, true /* firstMatchOnly */);
 
@@ -143,7 +142,10 @@ TextureManager::CpuTextureHandle TextureManager::loadUdimTexture(
 
     // Now load all the files from that directory
     std::filesystem::path loadedDir = texturePaths[0].parent_path();
-    texturePaths = globFilesInDirectory(loadedDir, udimRegex);
+    if (assetResolver)
+        texturePaths = assetResolver->resolvePathPattern(loadedDir, udimRegex);
+    else
+        texturePaths = globFilesInDirectory(loadedDir, udimRegex);
 
     if (loadedTextureCount)
         *loadedTextureCount = texturePaths.size();
@@ -168,6 +170,7 @@ TextureManager::CpuTextureHandle TextureManager::loadUdimTexture(
     }
 
     // UDIM range needs to cover all numbers from 1001 to maxIndex inclusive, so 1001, 1002, 1003 needs 3 indices
+    std::lock_guard<std::mutex> lock(mMutex);
     size_t rangeStart = getUdimRange(maxIndex - 1001 + 1);
 
     for (size_t i = 0; i < texturePaths.size(); ++i)
@@ -186,7 +189,8 @@ TextureManager::CpuTextureHandle TextureManager::loadTexture(
     ResourceBindFlags bindFlags,
     bool async,
     const AssetResolver* assetResolver,
-    size_t* loadedTextureCount
+    size_t* loadedTextureCount,
+    bool keepTexels
 )
 {
     if (path.string().find("<UDIM>") != std::string::npos)
@@ -248,48 +252,34 @@ TextureManager::CpuTextureHandle TextureManager::loadTexture(
     if (auto it = mKeyToHandle.find(textureKey); it != mKeyToHandle.end())
     {
         // Texture is already managed. Return its handle.
+        // If loading is still deferred, the texels can still be kept.
         handle = it->second;
+        if (keepTexels)
+            getDesc(handle).keepTexels = true;
     }
     else
     {
-        if (mUseDeferredLoading)
-        {
-            // Add new texture desc.
-            TextureDesc desc = {TextureState::Referenced, nullptr};
-            handle = addDesc(desc);
+        // Texture is not already managed. Add new texture desc.
+        handle = addDesc(TextureState::Referenced, nullptr);
+        getDesc(handle).keepTexels = keepTexels;
 
-            // Add to key-to-handle map.
-            mKeyToHandle[textureKey] = handle;
+        // Add to key-to-handle map.
+        mKeyToHandle[textureKey] = handle;
 
-            // Return early.
+        // Return early if loading is deferred.
+        if (mUseDeferredLoading)
             return handle;
-        }
 
 #ifndef DISABLE_ASYNC_TEXTURE_LOADER
         mLoadRequestsInProgress++;
 
-        // Texture is not already managed. Add new texture desc.
-        TextureDesc desc = {TextureState::Referenced, nullptr};
-        handle = addDesc(desc);
-
-        // Add to key-to-handle map.
-        mKeyToHandle[textureKey] = handle;
-
         // Function called by the async texture loader when loading finishes.
         // It's called by a worker thread so needs to acquire the mutex before changing any state.
         auto callback = [=](ref<Texture> pTexture)
         {
-            std::unique_lock<std::mutex> lock(mMutex);
-
-            // Mark texture as loaded.
-            auto& desc = getDesc(handle);
-            desc.state = TextureState::Loaded;
-            desc.pTexture = pTexture;
-
-            // Add to texture-to-handle map.
-            if (pTexture)
-                mTextureToHandle[pTexture.get()] = handle;
+            publishTexture(handle, pTexture);
 
+            std::unique_lock<std::mutex> lock(mMutex);
             mLoadRequestsInProgress--;
             mCondition.notify_all();
         };
@@ -304,33 +294,26 @@ TextureManager::CpuTextureHandle TextureManager::loadTexture(
             mAsyncTextureLoader.loadFromFile(paths[0], generateMipLevels, loadAsSRGB, bindFlags, callback);
         }
 #else
-        // Load texture from main thread.
+        // Load texture from the calling thread. The handle is already visible to other threads,
+        // which wait for it to be published if they need the texture.
+        lock.unlock();
+
+        std::vector<uint8_t> data;
+        TextureDecoder::DecodedTexture decoded =
+            TextureDecoder::decode(TextureDecoder::Request{paths, loadAsSRGB, true, keepTexels}, data);
+
         ref<Texture> pTexture;
-        if (paths.size() > 1)
         {
-            pTexture = Texture::createMippedFromFiles(mpDevice, paths, loadAsSRGB, bindFlags);
+            std::lock_guard<std::mutex> uploadLock(mUploadMutex);
+            pTexture = uploadTexture(textureKey, decoded);
         }
-        else
-        {
-            pTexture = Texture::createFromFile(mpDevice, paths[0], generateMipLevels, loadAsSRGB, bindFlags);
-        }
-
-        // Add new texture desc.
-        TextureDesc desc = {TextureState::Loaded, pTexture};
-        handle = addDesc(desc);
-
-        // Add to key-to-handle map.
-        mKeyToHandle[textureKey] = handle;
 
-        // Add to texture-to-handle map.
-        if (pTexture)
-            mTextureToHandle[pTexture.get()] = handle;
-
-        mCondition.notify_all();
+        publishTexture(handle, pTexture, decoded.analysis, decoded.pTexels);
 #endif
     }
 
-    lock.unlock();
+    if (lock.owns_lock())
+        lock.unlock();
 
     if (!mUseDeferredLoading && !async)
     {
@@ -345,9 +328,17 @@ void TextureManager::waitForTextureLoading(const CpuTextureHandle& handle)
     if (!handle)
         return;
 
-    // Acquire mutex and wait for texture state to change.
+    // Acquire mutex and wait for texture state to change. Failed loads are marked invalid.
     std::unique_lock<std::mutex> lock(mMutex);
-    mCondition.wait(lock, [&]() { return getDesc(handle).state == TextureState::Loaded; });
+    const auto& entry = getDesc(handle);
+    mCondition.wait(
+        lock,
+        [&]()
+        {
+            TextureState state = entry.state.load(std::memory_order_acquire);
+            return state == TextureState::Loaded || state == TextureState::Invalid;
+        }
+    );
 
     mpDevice->wait();
 }
@@ -372,62 +363,52 @@ void TextureManager::endDeferredLoading()
     {
         TextureKey key;
         CpuTextureHandle handle;
+        bool keepTexels;
     };
 
     // Get a list of textures to load.
     std::vector<Job> jobs;
-    for (auto& [key, handle] : mKeyToHandle)
     {
-        auto& desc = getDesc(handle);
-        if (desc.state == TextureState::Referenced)
-            jobs.push_back(Job{key, handle});
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& [key, handle] : mKeyToHandle)
+        {
+            const auto& entry = getDesc(handle);
+            if (entry.state.load(std::memory_order_acquire) == TextureState::Referenced)
+                jobs.push_back(Job{key, handle, entry.keepTexels});
+        }
+        mUseDeferredLoading = false;
     }
 
     // Early out if there are no textures to load.
-    mUseDeferredLoading = false;
     if (jobs.empty())
         return;
 
-    // Load textures in parallel.
-    std::atomic<size_t> texturesLoaded;
-    NumericRange<size_t> jobRange(0, jobs.size());
-    std::for_each(
-        std::execution::par_unseq,
-        jobRange.begin(),
-        jobRange.end(),
-        [&](size_t i)
+    std::vector<TextureDecoder::Request> requests;
+    requests.reserve(jobs.size());
+    for (const auto& job : jobs)
+        requests.push_back(TextureDecoder::Request{job.key.fullPaths, job.key.loadAsSRGB, true, job.keepTexels});
+
+    // Decode textures in parallel on the CPU, then upload each batch from this thread.
+    // The device is flushed once per batch to bound the amount of memory held by pending uploads.
+    TextureDecoder decoder;
+    size_t batchCount = decoder.decode(
+        requests,
+        [&](fstd::span<const TextureDecoder::DecodedTexture> batch)
         {
-            const auto& job = jobs[i];
-            auto& desc = getDesc(job.handle);
-            if (job.key.fullPaths.size() == 1)
-            {
-                desc.pTexture = Texture::createFromFile(
-                    mpDevice, job.key.fullPaths[0], job.key.generateMipLevels, job.key.loadAsSRGB, job.key.bindFlags
-                );
-                logDebug("Loading texture from '{}'", job.key.fullPaths[0]);
-            }
-            else
+            std::vector<ref<Texture>> textures(batch.size());
             {
-                desc.pTexture = Texture::createMippedFromFiles(mpDevice, job.key.fullPaths, job.key.loadAsSRGB, job.key.bindFlags);
-                logDebug("Loading mipped texture from '{}'", job.key.fullPaths[0]);
-            }
-            if (texturesLoaded.fetch_add(1) % 10 == 9)
-            {
-                logDebug("Flush");
-                std::lock_guard<std::mutex> lock(mpDevice->getGlobalGfxMutex());
+                std::lock_guard<std::mutex> uploadLock(mUploadMutex);
+                for (size_t i = 0; i < batch.size(); i++)
+                    textures[i] = uploadTexture(jobs[batch[i].requestIndex].key, batch[i]);
                 mpDevice->wait();
             }
+
+            for (size_t i = 0; i < batch.size(); i++)
+                publishTexture(jobs[batch[i].requestIndex].handle, textures[i], batch[i].analysis, batch[i].pTexels);
         }
     );
-    mpDevice->wait();
 
-    // Mark loaded textures and add them to lookup table.
-    for (const auto& job : jobs)
-    {
-        auto& desc = getDesc(job.handle);
-        desc.state = desc.pTexture ? TextureState::Loaded : TextureState::Invalid;
-        mTextureToHandle[desc.pTexture.get()] = job.handle;
-    }
+    logDebug("Loaded {} deferred textures in {} batches.", jobs.size(), batchCount);
 }
 
 void TextureManager::removeTexture(const CpuTextureHandle& handle)
@@ -444,8 +425,8 @@ void TextureManager::removeTexture(const CpuTextureHandle& handle)
     std::lock_guard<std::mutex> lock(mMutex);
 
     // Get texture desc. If it's already cleared, we're done.
-    auto& desc = getDesc(handle);
-    if (!desc.isValid())
+    auto& entry = getDesc(handle);
+    if (entry.state.load(std::memory_order_acquire) == TextureState::Invalid)
         return;
 
     // Remove handle from maps.
@@ -454,17 +435,24 @@ void TextureManager::removeTexture(const CpuTextureHandle& handle)
     if (it != mKeyToHandle.end())
         mKeyToHandle.erase(it);
 
-    if (desc.pTexture)
+    if (entry.pTexture)
     {
-        FALCOR_ASSERT(mTextureToHandle.find(desc.pTexture.get()) != mTextureToHandle.end());
-        mTextureToHandle.erase(desc.pTexture.get());
+        FALCOR_ASSERT(mTextureToHandle.find(entry.pTexture.get()) != mTextureToHandle.end());
+        mTextureToHandle.erase(entry.pTexture.get());
     }
 
     // Clear texture desc.
-    desc = {};
+    {
+        std::lock_guard<std::mutex> entryLock(entry.mutex);
+        entry.state.store(TextureState::Invalid, std::memory_order_release);
+        entry.pTexture = nullptr;
+        entry.analysis.reset();
+    }
+    entry.pTexels = nullptr;
+    entry.keepTexels = false;
 
     // Return handle to the free list.
-    mFreeList.push_back(handle);
+    mTextures.release(handle.getID());
 }
 
 TextureManager::TextureDesc TextureManager::getTextureDesc(const CpuTextureHandle& handle) const
@@ -472,33 +460,56 @@ TextureManager::TextureDesc TextureManager::getTextureDesc(const CpuTextureHandl
     if (!handle)
         return {};
 
+    const auto& entry = getDesc(handle);
+    std::lock_guard<std::mutex> entryLock(entry.mutex);
+    TextureDesc desc;
+    desc.state = entry.state.load(std::memory_order_acquire);
+    if (desc.state == TextureState::Loaded)
+        desc.pTexture = entry.pTexture;
+    return desc;
+}
+
+std::optional<TextureAnalyzer::Result> TextureManager::getTextureAnalysis(const Texture* pTexture) const
+{
     std::lock_guard<std::mutex> lock(mMutex);
-    FALCOR_CHECK(!handle.isUdim(), "Can't lookup texture desc from handle to UDIM texture. Resolve UDIM first.");
-    FALCOR_CHECK(handle && handle.getID() < mTextureDescs.size(), "Invalid texture handle.");
-    return mTextureDescs[handle.getID()];
+    auto it = mTextureToHandle.find(pTexture);
+    if (it == mTextureToHandle.end())
+        return {};
+    return getDesc(it->second).analysis;
 }
 
-size_t TextureManager::getTextureDescCount() const
+std::shared_ptr<TextureDecoder::Texels> TextureManager::takeTextureTexels(const Texture* pTexture)
 {
     std::lock_guard<std::mutex> lock(mMutex);
-    return mTextureDescs.size();
+    auto it = mTextureToHandle.find(pTexture);
+    if (it == mTextureToHandle.end())
+        return nullptr;
+    return std::move(getDesc(it->second).pTexels);
+}
+
+size_t TextureManager::getTextureDescCount() const
+{
+    return mTextures.size();
 }
 
 void TextureManager::bindShaderData(const ShaderVar& texturesVar, const size_t descCount, const ShaderVar& udimsVar) const
 {
     std::lock_guard<std::mutex> lock(mMutex);
 
-    if (mTextureDescs.size() > descCount)
+    const size_t textureCount = mTextures.size();
+    if (textureCount > descCount)
     {
-        FALCOR_THROW("Descriptor array size ({}) is too small for the required number of textures ({})", descCount, mTextureDescs.size());
+        FALCOR_THROW("Descriptor array size ({}) is too small for the required number of textures ({})", descCount, textureCount);
     }
 
     ref<Texture> nullTexture;
-    for (size_t i = 0; i < mTextureDescs.size(); i++)
+    for (size_t i = 0; i < textureCount; i++)
     {
-        texturesVar[i] = mTextureDescs[i].pTexture;
+        const TextureEntry* pEntry = mTextures.tryGet((uint32_t)i);
+        bool isLoaded = pEntry && pEntry->state.load(std::memory_order_acquire) == TextureState::Loaded;
+        texturesVar[i] = isLoaded ? pEntry->pTexture : nullTexture;
     }
-    for (size_t i = mTextureDescs.size(); i < descCount; i++)
+    for (size_t i = textureCount; i < descCount; i++)
     {
         texturesVar[i] = nullTexture;
     }
@@ -535,51 +546,133 @@ TextureManager::Stats TextureManager::getStats() const
 {
     std::lock_guard<std::mutex> lock(mMutex);
     TextureManager::Stats s;
-    for (const auto& t : mTextureDescs)
+    for (uint32_t i = 0; i < mTextures.size(); i++)
     {
-        if (!t.pTexture)
+        const TextureEntry* pEntry = mTextures.tryGet(i);
+        if (!pEntry || pEntry->state.load(std::memory_order_acquire) != TextureState::Loaded || !pEntry->pTexture)
             continue;
-        uint64_t texelCount = t.pTexture->getTexelCount();
-        uint32_t channelCount = getFormatChannelCount(t.pTexture->getFormat());
+        const auto& pTexture = pEntry->pTexture;
+        uint64_t texelCount = pTexture->getTexelCount();
+        uint32_t channelCount = getFormatChannelCount(pTexture->getFormat());
         s.textureCount++;
         s.textureTexelCount += texelCount;
         s.textureTexelChannelCount += texelCount * channelCount;
-        s.textureMemoryInBytes += t.pTexture->getTextureSizeInBytes();
-        if (isCompressedFormat(t.pTexture->getFormat()))
+        s.textureMemoryInBytes += pTexture->getTextureSizeInBytes();
+        if (isCompressedFormat(pTexture->getFormat()))
             s.textureCompressedCount++;
     }
     return s;
 }
 
-TextureManager::CpuTextureHandle TextureManager::addDesc(const TextureDesc& desc)
+TextureManager::CpuTextureHandle TextureManager::addDesc(TextureState state, const ref<Texture>& pTexture)
 {
-    CpuTextureHandle handle;
+    // Allocate new texture handle. This is lock-free.
+    uint32_t id = mTextures.allocate();
+    if (id == TextureHandleTable<TextureEntry>::kInvalidID)
+    {
+        FALCOR_THROW("Out of texture handles");
+    }
+
+    // Write the texture before publishing the state.
+    auto& entry = mTextures[id];
+    std::lock_guard<std::mutex> entryLock(entry.mutex);
+    entry.pTexture = pTexture;
+    entry.state.store(state, std::memory_order_release);
+
+    return CpuTextureHandle{id};
+}
+
+TextureManager::TextureEntry& TextureManager::getDesc(const CpuTextureHandle& handle)
+{
+    FALCOR_CHECK(!handle.isUdim(), "Can't lookup texture desc from handle to UDIM texture. Resolve UDIM first.");
+    TextureEntry* pEntry = handle ? mTextures.tryGet(handle.getID()) : nullptr;
+    FALCOR_CHECK(pEntry && handle.getID() < mTextures.size(), "Invalid texture handle.");
+    return *pEntry;
+}
+
+const TextureManager::TextureEntry& TextureManager::getDesc(const CpuTextureHandle& handle) const
+{
+    return const_cast<TextureManager*>(this)->getDesc(handle);
+}
+
+ref<Texture> TextureManager::uploadTexture(const TextureKey& key, const TextureDecoder::DecodedTexture& decoded)
+{
+    const auto& path = key.fullPaths[0];
+
+    if (decoded.status != TextureDecoder::Status::Decoded)
+        return nullptr;
+
+    // Mip levels are only generated for single image files. Mip chains loaded from files and DDS files
+    // get exactly the mip levels that were loaded, so the texture always matches the decoded data.
+    const bool isImageFile = key.fullPaths.size() == 1 && !hasExtension(path, "dds");
+    const uint32_t mipLevels = isImageFile && key.generateMipLevels ? Texture::kMaxPossible : decoded.mipCount;
 
-    // Allocate new texture handle and insert desc.
-    if (!mFreeList.empty())
+    ref<Texture> pTexture;
+    switch (decoded.type)
     {
-        handle = mFreeList.back();
-        mFreeList.pop_back();
-        getDesc(handle) = desc;
+    case Resource::Type::Texture1D:
+        pTexture = mpDevice->createTexture1D(decoded.width, decoded.format, decoded.arraySize, mipLevels, decoded.pData, key.bindFlags);
+        break;
+    case Resource::Type::Texture2D:
+        pTexture = mpDevice->createTexture2D(
+            decoded.width, decoded.height, decoded.format, decoded.arraySize, mipLevels, decoded.pData, key.bindFlags
+        );
+        break;
+    case Resource::Type::TextureCube:
+        pTexture = mpDevice->createTextureCube(
+            decoded.width, decoded.height, decoded.format, decoded.arraySize / 6, mipLevels, decoded.pData, key.bindFlags
+        );
+        break;
+    case Resource::Type::Texture3D:
+        pTexture = mpDevice->createTexture3D(
+            decoded.width, decoded.height, decoded.depth, decoded.format, mipLevels, decoded.pData, key.bindFlags
+        );
+        break;
+    default:
+        logWarning("Failed to load texture from '{}': Unrecognized texture type.", path);
+        return nullptr;
     }
-    else
+
+    if (pTexture)
     {
-        if (mTextureDescs.size() >= mMaxTextureCount)
-        {
-            FALCOR_THROW("Out of texture handles");
-        }
-        handle = CpuTextureHandle{static_cast<uint32_t>(mTextureDescs.size())};
-        mTextureDescs.emplace_back(desc);
+        pTexture->setSourcePath(path);
+        logDebug(
+            "Loaded texture: size={}x{} mips={} format={} path={}",
+            pTexture->getWidth(),
+            pTexture->getHeight(),
+            pTexture->getMipCount(),
+            to_string(pTexture->getFormat()),
+            path
+        );
     }
 
-    return handle;
+    return pTexture;
 }
 
-TextureManager::TextureDesc& TextureManager::getDesc(const CpuTextureHandle& handle)
+void TextureManager::publishTexture(
+    const CpuTextureHandle& handle,
+    const ref<Texture>& pTexture,
+    const std::optional<TextureAnalyzer::Result>& analysis,
+    const std::shared_ptr<TextureDecoder::Texels>& pTexels
+)
 {
-    FALCOR_CHECK(!handle.isUdim(), "Can't lookup texture desc from handle to UDIM texture. Resolve UDIM first.");
-    FALCOR_CHECK(handle && handle.getID() < mTextureDescs.size(), "Invalid texture handle.");
-    return mTextureDescs[handle.getID()];
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Mark texture as loaded, or as invalid if loading failed.
+    auto& entry = getDesc(handle);
+    {
+        std::lock_guard<std::mutex> entryLock(entry.mutex);
+        entry.pTexture = pTexture;
+        entry.analysis = pTexture ? analysis : std::nullopt;
+        entry.state.store(pTexture ? TextureState::Loaded : TextureState::Invalid, std::memory_order_release);
+    }
+    entry.pTexels = pTexture ? pTexels : nullptr;
+
+    // Add to texture-to-handle map.
+    if (pTexture)
+        mTextureToHandle[pTexture.get()] = handle;
+
+    mCondition.notify_all();
 }
 
 size_t TextureManager::getUdimRange(size_t requiredSize)
@@ -27,17 +27,22 @@
  **************************************************************************/
 #pragma once
 #include "AsyncTextureLoader.h"
+#include "TextureAnalyzer.h"
+#include "TextureDecoder.h"
+#include "TextureHandleTable.h"
 #include "Core/Macros.h"
 #include "Core/API/fwd.h"
 #include "Core/API/Resource.h"
 #include "Core/API/Texture.h"
 #include "Core/Program/ShaderVar.h"
 #include "Scene/Material/TextureHandle.slang"
+#include <atomic>
 #include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 namespace Falcor
@@ -50,6 +55,10 @@ class AssetResolver;
  * This class manages a collection of textures and implements
  * asynchronous texture loading. All operations are thread-safe.
  *
+ * Texture handles are stored in a lock-free table, so looking up textures
+ * does not block while other threads are loading textures. Reading a texture
+ * only takes a lock on its own entry, not the lock of the manager.
+ *
  * Each managed texture is assigned a unique handle upon loading.
  * This handle is used in shader code to reference the given texture
  * in the array of GPU texture descriptors.
@@ -166,6 +175,8 @@ public:
      * @param[in] async Load asynchronously, otherwise the function blocks until the texture data is loaded.
      * @param[in] assetResolver Optional asset resolver for resolving file paths.
      * @param[out] loadedTextureCount Optionally can provided the number of actually loaded textures (2+ can happen with UDIMs)
+     * @param[in] keepTexels Keep the texels of mip 0 on the CPU, see takeTextureTexels(). Ignored for UDIM textures and for
+     * textures that are already loaded.
      * @return Unique handle to the texture, or an invalid handle if the texture can't be found.
      */
     CpuTextureHandle loadTexture(
@@ -175,7 +186,8 @@ public:
         ResourceBindFlags bindFlags = ResourceBindFlags::ShaderResource,
         bool async = true,
         const AssetResolver* assetResolver = nullptr,
-        size_t* loadedTextureCount = nullptr
+        size_t* loadedTextureCount = nullptr,
+        bool keepTexels = false
     );
 
     /**
@@ -207,9 +219,11 @@ public:
     /**
      * Marks the beginning of a section where texture loading is deferred.
      * All loadTexture() and loadUdimTexture() calls after calling this will be put on a deferred list.
-     * A later call to endDeferredLoading() will load all queued up textures in parallel.
-     * WARNING: This is a dangerous operation because Falcor is generally not thread-safe. Only use this
-     * from the main thread when it is guaranteed to not be interleaved with any other thread.
+     * While loading is deferred, loadTexture() can be called concurrently from multiple threads.
+     * A later call to endDeferredLoading() decodes all queued up textures in parallel on the CPU
+     * and uploads them to the GPU in batches from the calling thread.
+     * WARNING: beginDeferredLoading() and endDeferredLoading() must be called from the main thread,
+     * and endDeferredLoading() must not be interleaved with other calls to the texture manager.
      */
     void beginDeferredLoading();
     void endDeferredLoading();
@@ -246,6 +260,23 @@ public:
         return getTextureDesc(resolveUdimTexture(handle, udimID));
     }
 
+    /**
+     * Get the CPU analysis of a texture's contents.
+     * Textures loaded from file are analyzed on the CPU while decoding if their format is supported (see TextureAnalyzer).
+     * @param[in] pTexture Texture.
+     * @return Analysis of mip 0, or nullopt if the texture is not managed or was not analyzed.
+     */
+    std::optional<TextureAnalyzer::Result> getTextureAnalysis(const Texture* pTexture) const;
+
+    /**
+     * Take the texels of mip 0 that were kept when loading a texture (see loadTexture()).
+     * The texels are released by the texture manager, so they can only be taken once.
+     * @param[in] pTexture Texture.
+     * @return Texels converted to linear RGBA float, or nullptr if the texture is not managed, was not loaded with
+     * keepTexels set, or its format can't be converted (e.g. block-compressed formats).
+     */
+    std::shared_ptr<TextureDecoder::Texels> takeTextureTexels(const Texture* pTexture);
+
     /**
      * Get texture desc count.
      * @return Number of texture descs.
@@ -310,17 +341,57 @@ private:
         }
     };
 
-    CpuTextureHandle addDesc(const TextureDesc& desc);
-    TextureDesc& getDesc(const CpuTextureHandle& handle);
+    /**
+     * Entry in the texture table.
+     * The state can be polled without locking. The texture pointer and analysis are written with both mMutex and
+     * the entry mutex held, so readers only need to hold one of them. getTextureDesc() takes the entry mutex only,
+     * which keeps texture lookups from contending with loads of other textures.
+     */
+    struct TextureEntry
+    {
+        mutable std::mutex mutex; ///< Guards pTexture and analysis against readers that don't hold mMutex.
+        std::atomic<TextureState> state{TextureState::Invalid};
+        ref<Texture> pTexture;
+        std::optional<TextureAnalyzer::Result> analysis; ///< CPU analysis of the texture contents, if available.
+        std::shared_ptr<TextureDecoder::Texels> pTexels; ///< Texels of mip 0 kept on request. Guarded by mMutex only.
+        bool keepTexels = false;                         ///< Keep the texels of mip 0 when loading. Guarded by mMutex only.
+    };
+
+    CpuTextureHandle addDesc(TextureState state, const ref<Texture>& pTexture);
+    TextureEntry& getDesc(const CpuTextureHandle& handle);
+    const TextureEntry& getDesc(const CpuTextureHandle& handle) const;
+
+    /**
+     * Create a texture from data decoded on the CPU.
+     * @param[in] key Texture key.
+     * @param[in] decoded Decoded texture data.
+     * @return Texture, or nullptr if loading failed.
+     */
+    ref<Texture> uploadTexture(const TextureKey& key, const TextureDecoder::DecodedTexture& decoded);
+
+    /**
+     * Mark a texture as loaded and wake up waiting threads.
+     * @param[in] handle Texture handle.
+     * @param[in] pTexture Loaded texture, or nullptr if loading failed.
+     * @param[in] analysis Optional CPU analysis of the texture contents.
+     * @param[in] pTexels Optional texels of mip 0 to keep on the CPU.
+     */
+    void publishTexture(
+        const CpuTextureHandle& handle,
+        const ref<Texture>& pTexture,
+        const std::optional<TextureAnalyzer::Result>& analysis = {},
+        const std::shared_ptr<TextureDecoder::Texels>& pTexels = nullptr
+    );
 
     ref<Device> mpDevice;
 
     mutable std::mutex mMutex;          ///< Mutex for synchronizing access to shared resources.
     std::condition_variable mCondition; ///< Condition variable to wait on for loading to finish.
+    std::mutex mUploadMutex;            ///< Mutex serializing texture creation on the device.
+
+    TextureHandleTable<TextureEntry> mTextures; ///< Table of all textures, indexed by handle ID. Lock-free.
 
     // Internal state. Do not access outside of critical section.
-    std::vector<TextureDesc> mTextureDescs;                      ///< Array of all texture descs, indexed by handle ID.
-    std::vector<CpuTextureHandle> mFreeList;                     ///< List of unused handles.
     std::map<TextureKey, CpuTextureHandle> mKeyToHandle;         ///< Map from texture key to handle.
     std::map<const Texture*, CpuTextureHandle> mTextureToHandle; ///< Map from texture ptr to handle.
     /// Map from UDIM-1001 to an actual textureID, -1 if the texture does not exist (e.g., there is 1001 and 1003, so 1002 [1] == -1)
@@ -333,7 +404,7 @@ private:
     mutable bool mUdimIndirectionDirty = true;
     mutable ref<Buffer> mpUdimIndirection;
 
-    bool mUseDeferredLoading = false;
+    std::atomic<bool> mUseDeferredLoading{false};
 
     AsyncTextureLoader mAsyncTextureLoader; ///< Utility for asynchronous texture loading.
     size_t mLoadRequestsInProgress = 0;     ///< Number of load requests currently in progress.
@@ -75,6 +75,24 @@ inline float3 oct_to_ndir_snorm(float2 p)
     return normalize(n);
 }
 
+/**
+ * Encode a normal packed as 2x 8-bit snorms in the octahedral mapping. The high 16 bits are unused.
+ */
+inline uint32_t encodeNormal2x8(float3 normal)
+{
+    float2 octNormal = ndir_to_oct_snorm(normal);
+    return packSnorm2x8(octNormal);
+}
+
+/**
+ * Decode a normal packed as 2x 8-bit snorms in the octahedral mapping.
+ */
+inline float3 decodeNormal2x8(uint32_t packedNormal)
+{
+    float2 octNormal = unpackSnorm2x8(packedNormal);
+    return oct_to_ndir_snorm(octNormal);
+}
+
 /**
  * Encode a normal packed as 2x 16-bit snorms in the octahedral mapping.
  */
@@ -26,11 +26,17 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "Properties.h"
+#include "Utils/NumericRange.h"
 
 #include <nlohmann/json.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl/filesystem.h>
 
+#include <algorithm>
+#include <cstring>
+#include <execution>
+#include <limits>
+
 namespace Falcor
 {
 using json = Properties::json;
@@ -282,6 +288,494 @@ pybind11::object jsonToPython(const json& j)
         return std::move(obj);
     }
 }
+
+// ------------------------------------------------------------------
+// Binary format
+// ------------------------------------------------------------------
+//
+// The data starts with a header (magic, version) followed by the encoded root object.
+// Each value is encoded as a one byte tag followed by a payload:
+// - Null, False, True: No payload.
+// - Int, UInt, Float: 8 byte int64_t, uint64_t or double.
+// - String: uint32_t length followed by the characters (not null-terminated).
+// - Array: uint32_t element count, uint32_t payload size in bytes, followed by the encoded elements.
+// - Object: uint32_t member count, uint32_t payload size in bytes, followed by the members.
+//   Each member is a key (encoded like a string payload) followed by the encoded value.
+// - IntArray, UIntArray, FloatArray: uint32_t element count followed by the packed 8 byte elements.
+//   Used for non-empty arrays where all elements have the same numeric type.
+// The payload size of arrays and objects allows skipping over them without decoding.
+
+namespace binary
+{
+enum class Tag : uint8_t
+{
+    Null,
+    False,
+    True,
+    Int,
+    UInt,
+    Float,
+    String,
+    Array,
+    Object,
+    IntArray,
+    UIntArray,
+    FloatArray,
+};
+
+constexpr uint32_t kMagic = 0x50525046; // "FPRP"
+constexpr uint32_t kVersion = 1;
+
+/// Maximum nesting depth of arrays and objects accepted when reading.
+constexpr uint32_t kMaxDepth = 512;
+/// Minimum number of nested elements in a container to encode its children in parallel.
+constexpr size_t kParallelMinElements = 1 << 12;
+/// Minimum payload size of a container to decode its children in parallel.
+constexpr size_t kParallelMinBytes = 1 << 16;
+
+template<typename T>
+void write(std::vector<uint8_t>& out, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+uint32_t checkSize(size_t size)
+{
+    FALCOR_CHECK(size <= std::numeric_limits<uint32_t>::max(), "Cannot encode properties with more than 4G elements or bytes in a value.");
+    return uint32_t(size);
+}
+
+void writeSize(std::vector<uint8_t>& out, size_t size)
+{
+    write(out, checkSize(size));
+}
+
+void writeString(std::vector<uint8_t>& out, std::string_view str)
+{
+    writeSize(out, str.size());
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+/// Writes a placeholder for the payload size and returns its offset.
+size_t beginPayload(std::vector<uint8_t>& out)
+{
+    size_t offset = out.size();
+    write(out, uint32_t(0));
+    return offset;
+}
+
+/// Patches the payload size written by beginPayload().
+void endPayload(std::vector<uint8_t>& out, size_t offset)
+{
+    uint32_t size = checkSize(out.size() - offset - sizeof(uint32_t));
+    std::memcpy(out.data() + offset, &size, sizeof(uint32_t));
+}
+
+/// Calls encodeChild(out, i) for all children, in parallel if there is enough work.
+/// The children are always concatenated in order.
+template<typename EncodeChild>
+void encodeChildren(std::vector<uint8_t>& out, size_t count, bool parallel, const EncodeChild& encodeChild)
+{
+    if (!parallel || count < 2)
+    {
+        for (size_t i = 0; i < count; ++i)
+            encodeChild(out, i);
+        return;
+    }
+
+    std::vector<std::vector<uint8_t>> buffers(count);
+    auto range = NumericRange<size_t>(0, count);
+    std::for_each(std::execution::par, range.begin(), range.end(), [&](size_t i) { encodeChild(buffers[i], i); });
+
+    size_t size = out.size();
+    for (const auto& buffer : buffers)
+        size += buffer.size();
+    out.reserve(size);
+    for (const auto& buffer : buffers)
+        out.insert(out.end(), buffer.begin(), buffer.end());
+}
+
+/// Returns a rough estimate of the encoding work of a value.
+size_t estimateWork(const json& j)
+{
+    return j.is_structured() ? j.size() : 1;
+}
+
+/// Returns the packed array tag if all elements of the array have the same numeric type, Tag::Array otherwise.
+Tag getArrayTag(const json::array_t& array)
+{
+    if (array.empty())
+        return Tag::Array;
+    json::value_t type = array.front().type();
+    if (std::any_of(array.begin(), array.end(), [type](const json& e) { return e.type() != type; }))
+        return Tag::Array;
+    switch (type)
+    {
+    case json::value_t::number_integer:
+        return Tag::IntArray;
+    case json::value_t::number_unsigned:
+        return Tag::UIntArray;
+    case json::value_t::number_float:
+        return Tag::FloatArray;
+    default:
+        return Tag::Array;
+    }
+}
+
+template<typename T>
+void encodePackedArray(std::vector<uint8_t>& out, const json::array_t& array)
+{
+    size_t offset = out.size();
+    out.resize(offset + array.size() * sizeof(T));
+    uint8_t* pDst = out.data() + offset;
+    for (const json& e : array)
+    {
+        T value = e.get<T>();
+        std::memcpy(pDst, &value, sizeof(T));
+        pDst += sizeof(T);
+    }
+}
+
+void encodeValue(std::vector<uint8_t>& out, const json& j);
+
+void encodeArray(std::vector<uint8_t>& out, const json::array_t& array)
+{
+    Tag tag = getArrayTag(array);
+    write(out, tag);
+    writeSize(out, array.size());
+
+    switch (tag)
+    {
+    case Tag::IntArray:
+        encodePackedArray<json::number_integer_t>(out, array);
+        return;
+    case Tag::UIntArray:
+        encodePackedArray<json::number_unsigned_t>(out, array);
+        return;
+    case Tag::FloatArray:
+        encodePackedArray<json::number_float_t>(out, array);
+        return;
+    default:
+        break;
+    }
+
+    size_t work = 0;
+    for (const json& e : array)
+        work += estimateWork(e);
+
+    size_t payloadOffset = beginPayload(out);
+    encodeChildren(
+        out, array.size(), work >= kParallelMinElements, [&](std::vector<uint8_t>& o, size_t i) { encodeValue(o, array[i]); }
+    );
+    endPayload(out, payloadOffset);
+}
+
+void encodeObject(std::vector<uint8_t>& out, const json::object_t& object)
+{
+    write(out, Tag::Object);
+    writeSize(out, object.size());
+
+    size_t work = 0;
+    for (const auto& [key, value] : object)
+        work += estimateWork(value);
+
+    size_t payloadOffset = beginPayload(out);
+    encodeChildren(
+        out,
+        object.size(),
+        work >= kParallelMinElements,
+        [&](std::vector<uint8_t>& o, size_t i)
+        {
+            const auto& member = *(object.begin() + i);
+            writeString(o, member.first);
+            encodeValue(o, member.second);
+        }
+    );
+    endPayload(out, payloadOffset);
+}
+
+void encodeValue(std::vector<uint8_t>& out, const json& j)
+{
+    switch (j.type())
+    {
+    case json::value_t::null:
+        write(out, Tag::Null);
+        break;
+    case json::value_t::boolean:
+        write(out, j.get<bool>() ? Tag::True : Tag::False);
+        break;
+    case json::value_t::number_integer:
+        write(out, Tag::Int);
+        write(out, j.get<json::number_integer_t>());
+        break;
+    case json::value_t::number_unsigned:
+        write(out, Tag::UInt);
+        write(out, j.get<json::number_unsigned_t>());
+        break;
+    case json::value_t::number_float:
+        write(out, Tag::Float);
+        write(out, j.get<json::number_float_t>());
+        break;
+    case json::value_t::string:
+        write(out, Tag::String);
+        writeString(out, j.get_ref<const json::string_t&>());
+        break;
+    case json::value_t::array:
+        encodeArray(out, j.get_ref<const json::array_t&>());
+        break;
+    case json::value_t::object:
+        encodeObject(out, j.get_ref<const json::object_t&>());
+        break;
+    default:
+        FALCOR_THROW("Cannot encode JSON value of type '{}' to binary properties.", j.type_name());
+    }
+}
+
+/// Bounds checked reader for binary data.
+class Reader
+{
+public:
+    Reader(const std::vector<uint8_t>& data, size_t pos) : mpData(data.data()), mSize(data.size()), mPos(pos) {}
+
+    size_t getPos() const { return mPos; }
+    void setPos(size_t pos) { mPos = pos; }
+
+    const uint8_t* readBytes(size_t count)
+    {
+        if (mPos > mSize || count > mSize - mPos)
+            FALCOR_THROW("Invalid binary properties: Unexpected end of data at offset {}.", mPos);
+        const uint8_t* pBytes = mpData + mPos;
+        mPos += count;
+        return pBytes;
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    Tag readTag()
+    {
+        size_t pos = mPos;
+        Tag tag = read<Tag>();
+        if (tag > Tag::FloatArray)
+            FALCOR_THROW("Invalid binary properties: Unknown tag {} at offset {}.", uint32_t(tag), pos);
+        return tag;
+    }
+
+    std::string_view readString()
+    {
+        uint32_t length = read<uint32_t>();
+        return std::string_view(reinterpret_cast<const char*>(readBytes(length)), length);
+    }
+
+private:
+    const uint8_t* mpData;
+    size_t mSize;
+    size_t mPos;
+};
+
+Tag peekTag(const std::vector<uint8_t>& data, size_t offset)
+{
+    return Reader(data, offset).readTag();
+}
+
+/// Skips a value using the stored sizes, without visiting nested values.
+void skipValue(Reader& reader)
+{
+    switch (reader.readTag())
+    {
+    case Tag::Null:
+    case Tag::False:
+    case Tag::True:
+        break;
+    case Tag::Int:
+    case Tag::UInt:
+    case Tag::Float:
+        reader.readBytes(8);
+        break;
+    case Tag::String:
+        reader.readString();
+        break;
+    case Tag::Array:
+    case Tag::Object:
+        reader.read<uint32_t>();
+        reader.readBytes(reader.read<uint32_t>());
+        break;
+    case Tag::IntArray:
+    case Tag::UIntArray:
+    case Tag::FloatArray:
+        reader.readBytes(size_t(reader.read<uint32_t>()) * 8);
+        break;
+    }
+}
+
+/// Validates a value including all nested values. Throws if the data is not valid.
+void validateValue(Reader& reader, uint32_t depth)
+{
+    if (depth > kMaxDepth)
+        FALCOR_THROW("Invalid binary properties: Nesting depth exceeds {}.", kMaxDepth);
+
+    size_t pos = reader.getPos();
+    Tag tag = reader.readTag();
+    if (tag != Tag::Array && tag != Tag::Object)
+    {
+        reader.setPos(pos);
+        skipValue(reader);
+        return;
+    }
+
+    uint32_t count = reader.read<uint32_t>();
+    uint32_t payloadSize = reader.read<uint32_t>();
+    size_t payloadStart = reader.getPos();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (tag == Tag::Object)
+            reader.readString();
+        validateValue(reader, depth + 1);
+    }
+    if (reader.getPos() - payloadStart != payloadSize)
+        FALCOR_THROW("Invalid binary properties: Payload size mismatch at offset {}.", pos);
+}
+
+/// Returns the offsets of all members of an object or elements of an array (reader is positioned after the header).
+/// For objects, the keys are returned as well.
+void collectChildren(Reader& reader, Tag tag, uint32_t count, std::vector<std::string_view>* pKeys, std::vector<size_t>& offsets)
+{
+    offsets.resize(count);
+    if (pKeys)
+        pKeys->resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (tag == Tag::Object)
+            (*pKeys)[i] = reader.readString();
+        offsets[i] = reader.getPos();
+        skipValue(reader);
+    }
+}
+
+template<typename T>
+json decodePackedArray(Reader& reader)
+{
+    uint32_t count = reader.read<uint32_t>();
+    const uint8_t* pElements = reader.readBytes(size_t(count) * sizeof(T));
+    json j = json::array();
+    auto& array = j.get_ref<json::array_t&>();
+    array.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        T value;
+        std::memcpy(&value, pElements + size_t(i) * sizeof(T), sizeof(T));
+        array.emplace_back(value);
+    }
+    return j;
+}
+
+json decodeValue(const std::vector<uint8_t>& data, size_t offset);
+
+/// Decodes the children at the given offsets, in parallel if requested.
+std::vector<json> decodeChildren(const std::vector<uint8_t>& data, const std::vector<size_t>& offsets, bool parallel)
+{
+    std::vector<json> values(offsets.size());
+    auto decodeChild = [&](size_t i) { values[i] = decodeValue(data, offsets[i]); };
+    if (parallel && offsets.size() >= 2)
+    {
+        auto range = NumericRange<size_t>(0, offsets.size());
+        std::for_each(std::execution::par, range.begin(), range.end(), decodeChild);
+    }
+    else
+    {
+        for (size_t i = 0; i < offsets.size(); ++i)
+            decodeChild(i);
+    }
+    return values;
+}
+
+json decodeValue(const std::vector<uint8_t>& data, size_t offset)
+{
+    Reader reader(data, offset);
+    Tag tag = reader.readTag();
+    switch (tag)
+    {
+    case Tag::Null:
+        return nullptr;
+    case Tag::False:
+        return false;
+    case Tag::True:
+        return true;
+    case Tag::Int:
+        return reader.read<json::number_integer_t>();
+    case Tag::UInt:
+        return reader.read<json::number_unsigned_t>();
+    case Tag::Float:
+        return reader.read<json::number_float_t>();
+    case Tag::String:
+        return std::string(reader.readString());
+    case Tag::IntArray:
+        return decodePackedArray<json::number_integer_t>(reader);
+    case Tag::UIntArray:
+        return decodePackedArray<json::number_unsigned_t>(reader);
+    case Tag::FloatArray:
+        return decodePackedArray<json::number_float_t>(reader);
+    case Tag::Array:
+    case Tag::Object:
+        break;
+    }
+
+    uint32_t count = reader.read<uint32_t>();
+    uint32_t payloadSize = reader.read<uint32_t>();
+    std::vector<std::string_view> keys;
+    std::vector<size_t> offsets;
+    collectChildren(reader, tag, count, tag == Tag::Object ? &keys : nullptr, offsets);
+    std::vector<json> values = decodeChildren(data, offsets, payloadSize >= kParallelMinBytes);
+
+    if (tag == Tag::Array)
+    {
+        json j = json::array();
+        j.get_ref<json::array_t&>().assign(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        return j;
+    }
+
+    json j = json::object();
+    auto& object = j.get_ref<json::object_t&>();
+    object.reserve(count);
+    // Keys are unique in data written by toBinary(), so members are appended directly instead of
+    // using the linear search in ordered_map::emplace().
+    for (uint32_t i = 0; i < count; ++i)
+        object.emplace_back(std::string(keys[i]), std::move(values[i]));
+    return j;
+}
+
+/// Finds a member of an encoded object and returns the offset of its value.
+std::optional<size_t> findMember(const std::vector<uint8_t>& data, size_t offset, std::string_view name)
+{
+    FALCOR_ASSERT(peekTag(data, offset) == Tag::Object);
+    Reader reader(data, offset + sizeof(Tag));
+    uint32_t count = reader.read<uint32_t>();
+    reader.read<uint32_t>(); // Payload size.
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (reader.readString() == name)
+            return reader.getPos();
+        skipValue(reader);
+    }
+    return {};
+}
+
+uint32_t getMemberCount(const std::vector<uint8_t>& data, size_t offset)
+{
+    FALCOR_ASSERT(peekTag(data, offset) == Tag::Object);
+    Reader reader(data, offset + sizeof(Tag));
+    return reader.read<uint32_t>();
+}
+} // namespace binary
+
 } // namespace
 
 Properties::Properties()
@@ -306,62 +800,165 @@ Properties::Properties(const pybind11::dict& d)
 
 Properties::Properties(const Properties& other)
 {
-    mJson = std::make_unique<json>(*other.mJson);
+    *this = other;
 }
 
 Properties::Properties(Properties&& other)
 {
-    mJson = std::move(other.mJson);
+    *this = std::move(other);
 }
 
+Properties::Properties(Arena pArena, size_t offset) : mpArena(std::move(pArena)), mOffset(offset) {}
+
 Properties::~Properties() {}
 
 Properties& Properties::operator=(const Properties& other)
 {
-    mJson = std::make_unique<json>(*other.mJson);
+    // Lazy properties share the read-only arena and are decoded again on demand.
+    mJson = other.mpArena ? nullptr : std::make_unique<json>(*other.mJson);
+    mDecoded.store(false, std::memory_order_relaxed);
+    mpArena = other.mpArena;
+    mOffset = other.mOffset;
     return *this;
 }
 
 Properties& Properties::operator=(Properties&& other)
 {
     mJson = std::move(other.mJson);
+    mDecoded.store(other.mDecoded.load(std::memory_order_acquire), std::memory_order_relaxed);
+    mpArena = std::move(other.mpArena);
+    mOffset = other.mOffset;
     return *this;
 }
 
 json Properties::toJson() const
 {
-    return *mJson;
+    return getJson();
 }
 
 pybind11::dict Properties::toPython() const
 {
-    return jsonToPython(*mJson);
+    return jsonToPython(getJson());
 }
 
 std::string Properties::dump(int indent) const
 {
-    return mJson->dump(indent);
+    return getJson().dump(indent);
+}
+
+std::vector<uint8_t> Properties::toBinary() const
+{
+    std::vector<uint8_t> data;
+    binary::write(data, binary::kMagic);
+    binary::write(data, binary::kVersion);
+
+    if (mpArena)
+    {
+        // Copy the encoded object without decoding it.
+        binary::Reader reader(*mpArena, mOffset);
+        binary::skipValue(reader);
+        data.insert(data.end(), mpArena->begin() + mOffset, mpArena->begin() + reader.getPos());
+    }
+    else
+    {
+        FALCOR_CHECK(mJson->is_object(), "Properties must be a JSON object to be encoded to binary.");
+        binary::encodeValue(data, *mJson);
+    }
+
+    return data;
+}
+
+Properties Properties::fromBinary(const void* pData, size_t size)
+{
+    FALCOR_CHECK(pData != nullptr || size == 0, "Binary properties data is null.");
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    return fromBinary(std::vector<uint8_t>(pBytes, pBytes + size));
+}
+
+Properties Properties::fromBinary(std::vector<uint8_t>&& data)
+{
+    binary::Reader reader(data, 0);
+    FALCOR_CHECK(reader.read<uint32_t>() == binary::kMagic, "Invalid binary properties: Wrong magic.");
+    uint32_t version = reader.read<uint32_t>();
+    FALCOR_CHECK(version == binary::kVersion, "Unsupported binary properties version {} (expected {}).", version, binary::kVersion);
+
+    size_t offset = reader.getPos();
+    FALCOR_CHECK(binary::peekTag(data, offset) == binary::Tag::Object, "Invalid binary properties: Root value is not an object.");
+    binary::validateValue(reader, 0);
+    FALCOR_CHECK(reader.getPos() == data.size(), "Invalid binary properties: Unexpected data after the root object.");
+
+    return Properties(std::make_shared<const std::vector<uint8_t>>(std::move(data)), offset);
+}
+
+const json& Properties::getJson() const
+{
+    if (!mpArena || mDecoded.load(std::memory_order_acquire))
+        return *mJson;
+
+    // The arena is immutable, so decoding it only has to be serialized with other const accesses decoding it.
+    std::lock_guard<std::mutex> lock(mDecodeMutex);
+    if (!mDecoded.load(std::memory_order_relaxed))
+    {
+        mJson = std::make_unique<json>(binary::decodeValue(*mpArena, mOffset));
+        mDecoded.store(true, std::memory_order_release);
+    }
+    return *mJson;
+}
+
+void Properties::materialize()
+{
+    if (!mpArena)
+        return;
+    if (!mDecoded.load(std::memory_order_acquire))
+        mJson = std::make_unique<json>(binary::decodeValue(*mpArena, mOffset));
+    mDecoded.store(false, std::memory_order_relaxed);
+    mpArena.reset();
+    mOffset = 0;
 }
 
 bool Properties::empty() const
 {
+    if (mpArena)
+        return binary::getMemberCount(*mpArena, mOffset) == 0;
     return mJson->empty();
 }
 
 bool Properties::has(std::string_view name) const
 {
+    if (mpArena)
+        return binary::findMember(*mpArena, mOffset, name).has_value();
     return mJson->find(name) != mJson->end();
 }
 
 template<typename T>
 void Properties::setInternal(std::string_view name, const T& value)
 {
+    materialize();
     (*mJson)[name] = valueToJson<T>(value);
 }
 
 template<typename T>
 bool Properties::getInternal(std::string_view name, T& value) const
 {
+    if (mpArena)
+    {
+        auto valueOffset = binary::findMember(*mpArena, mOffset, name);
+        if (!valueOffset)
+            return false;
+        if constexpr (std::is_same_v<T, Properties>)
+        {
+            // Nested objects are returned as lazy properties sharing the arena.
+            if (binary::peekTag(*mpArena, *valueOffset) != binary::Tag::Object)
+                FALCOR_THROW("Property '{}' is not an object.", name);
+            value = Properties(mpArena, *valueOffset);
+        }
+        else
+        {
+            value = valueFromJson<T>(binary::decodeValue(*mpArena, *valueOffset), name);
+        }
+        return true;
+    }
+
     if (auto it = mJson->find(name); it != mJson->end())
     {
         value = valueFromJson<T>(*it, name);
@@ -373,7 +970,9 @@ bool Properties::getInternal(std::string_view name, T& value) const
 
 bool Properties::operator==(const Properties& rhs) const
 {
-    return *mJson == *rhs.mJson;
+    if (mpArena && mpArena == rhs.mpArena && mOffset == rhs.mOffset)
+        return true;
+    return getJson() == rhs.getJson();
 }
 
 bool Properties::operator!=(const Properties& rhs) const
@@ -447,22 +1046,26 @@ std::pair<std::string, Properties::ConstValue> Properties::ConstIterator::operat
 
 Properties::Iterator Properties::begin()
 {
+    materialize();
     return Iterator(std::make_unique<Iterator::Impl>(Iterator::Impl{*this, mJson->begin()}));
 }
 
 Properties::Iterator Properties::end()
 {
+    materialize();
     return Iterator(std::make_unique<Iterator::Impl>(Iterator::Impl{*this, mJson->end()}));
 }
 
 Properties::ConstIterator Properties::begin() const
 {
-    return ConstIterator(std::make_unique<ConstIterator::Impl>(ConstIterator::Impl{*this, mJson->begin()}));
+    const json& j = getJson();
+    return ConstIterator(std::make_unique<ConstIterator::Impl>(ConstIterator::Impl{*this, j.begin()}));
 }
 
 Properties::ConstIterator Properties::end() const
 {
-    return ConstIterator(std::make_unique<ConstIterator::Impl>(ConstIterator::Impl{*this, mJson->end()}));
+    const json& j = getJson();
+    return ConstIterator(std::make_unique<ConstIterator::Impl>(ConstIterator::Impl{*this, j.end()}));
 }
 
 #define EXPORT_PROPERTY_ACCESSOR(T)                                                  \
@@ -36,12 +36,15 @@
 #include <pybind11/pytypes.h>
 #include <fmt/core.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
 #include <string>
 #include <type_traits>
 #include <filesystem>
+#include <vector>
 #include <cstdint>
 
 namespace Falcor
@@ -87,6 +90,12 @@ T deserializeFromProperties(const Properties& props);
  * Using JSON as a backing storage, properties can easily be serialized to/from files.
  * This class also supports conversion to/from python dictionaries, making it easy to specify properties from python.
  *
+ * For large configurations, properties can also be stored in a compact binary format (see toBinary() and fromBinary()).
+ * Properties created from binary data are backed by a shared read-only arena and are decoded lazily on first access.
+ * Const member functions never modify the arena; decoding for const access happens once, guarded by a mutex.
+ * So like other standard types, a Properties instance can be read from multiple threads concurrently,
+ * but must not be modified while being accessed from other threads.
+ *
  * For usage patterns, look at the unit tests.
  */
 class FALCOR_API Properties
@@ -116,6 +125,24 @@ public:
     /// Dumps the properties to a string.
     std::string dump(int indent = -1) const;
 
+    /// Encodes the properties in the binary format.
+    /// The format stores all JSON value types losslessly and keeps the order of properties.
+    /// Large arrays of numbers are stored packed. Byte order is native (little-endian on all supported platforms).
+    std::vector<uint8_t> toBinary() const;
+
+    /// Creates properties from data in the binary format.
+    /// The data is validated and copied into an arena, but not decoded. has() and get() only decode the requested
+    /// value, and nested properties are returned as views into the same arena. The whole object is decoded on the
+    /// first access that needs it, i.e. modification, iteration, comparison or conversion to JSON/python.
+    /// Throws if the data is not valid.
+    static Properties fromBinary(const void* pData, size_t size);
+
+    /// Creates properties from data in the binary format, taking ownership of the data. See above.
+    static Properties fromBinary(std::vector<uint8_t>&& data);
+
+    /// Check if the properties are backed by binary data that has not been decoded yet.
+    bool isLazy() const { return mpArena != nullptr && !mDecoded.load(std::memory_order_acquire); }
+
     /// Check if the properties are empty.
     bool empty() const;
 
@@ -358,7 +385,23 @@ private:
     template<typename T>
     bool getInternal(std::string_view name, T& value) const;
 
-    std::unique_ptr<json> mJson;
+    using Arena = std::shared_ptr<const std::vector<uint8_t>>;
+
+    Properties(Arena pArena, size_t offset);
+
+    /// Returns the JSON object, decoding the binary data once if the properties are lazy. Thread-safe.
+    const json& getJson() const;
+
+    /// Decodes the binary data if the properties are lazy and releases the arena, so the JSON object can be modified.
+    void materialize();
+
+    // Either mpArena is valid, or mJson holds the properties. For lazy properties, mJson holds the decoded arena once
+    // mDecoded is set. It is only written once, under mDecodeMutex, so concurrent const access is safe.
+    mutable std::unique_ptr<json> mJson;
+    mutable std::atomic<bool> mDecoded{false}; ///< True if mJson holds the decoded arena.
+    mutable std::mutex mDecodeMutex;           ///< Guards decoding the arena in const member functions.
+    Arena mpArena;                             ///< Binary data, if the properties have not been materialized yet.
+    size_t mOffset = 0;                        ///< Offset of the encoded object in the arena.
 };
 
 #define EXTERN_PROPERTY_ACCESSOR(T)                                                         \
@@ -0,0 +1,513 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "RangeAllocator.h"
+#include "Core/Error.h"
+#include "Utils/Math/Common.h"
+#include <algorithm>
+#include <limits>
+#if FALCOR_MSVC
+#include <intrin.h>
+#endif
+
+namespace Falcor
+{
+namespace
+{
+/// Returns the index of the most significant set bit. The value must be non-zero.
+inline uint32_t msb64(uint64_t value)
+{
+#if FALCOR_MSVC
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return uint32_t(index);
+#else
+    return 63 - uint32_t(__builtin_clzll(value));
+#endif
+}
+
+/// Returns the index of the least significant set bit. The value must be non-zero.
+inline uint32_t lsb64(uint64_t value)
+{
+#if FALCOR_MSVC
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return uint32_t(index);
+#else
+    return uint32_t(__builtin_ctzll(value));
+#endif
+}
+} // namespace
+
+RangeAllocator::RangeAllocator(uint64_t capacity)
+{
+    for (auto& heads : mFreeHeads)
+        heads.fill(kInvalidBlock);
+    grow(capacity);
+}
+
+RangeAllocator::Allocation RangeAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+    FALCOR_CHECK(size > 0, "Allocation size must be larger than zero.");
+    if (alignment == 0)
+        alignment = 1;
+    FALCOR_CHECK(isPowerOf2(alignment), "Alignment must be a power of two.");
+    if (size > mCapacity || alignment - 1 > mCapacity - size)
+        return {};
+
+    // Find a free block that can hold the range in the worst case of alignment padding.
+    uint32_t index = findFree(size + alignment - 1);
+    if (index == kInvalidBlock)
+        return {};
+    removeFree(index);
+
+    // Split off the alignment padding at the front as a new free block.
+    Block* pBlock = &mBlocks[index];
+    uint64_t padding = align_to(alignment, pBlock->offset) - pBlock->offset;
+    if (padding > 0)
+    {
+        uint64_t offset = pBlock->offset;
+        pBlock->offset += padding;
+        pBlock->size -= padding;
+        uint32_t front = createBlock(offset, padding);
+        linkAfter(mBlocks[index].prevPhys, front);
+        insertFree(front);
+        pBlock = &mBlocks[index];
+    }
+
+    // Split off the remaining space at the back as a new free block.
+    // The neighbors of a free block are never free, so no coalescing is needed.
+    if (pBlock->size > size)
+    {
+        uint32_t back = createBlock(pBlock->offset + size, pBlock->size - size);
+        mBlocks[index].size = size;
+        linkAfter(index, back);
+        insertFree(back);
+        pBlock = &mBlocks[index];
+    }
+
+    pBlock->state = State::Used;
+    pBlock->alignment = alignment;
+    mUsedBytes += size;
+    mAllocationCount++;
+    return Allocation{pBlock->offset, size, index};
+}
+
+RangeAllocator::Allocation RangeAllocator::append(uint64_t offset, uint64_t size, uint64_t alignment)
+{
+    FALCOR_CHECK(size > 0, "Allocation size must be larger than zero.");
+    FALCOR_CHECK(offset >= mCapacity, "Appended range must start at or beyond the end of the address space.");
+    if (alignment == 0)
+        alignment = 1;
+    FALCOR_CHECK(isPowerOf2(alignment), "Alignment must be a power of two.");
+
+    grow(offset);
+    uint32_t index = createBlock(offset, size);
+    linkAfter(mLastBlock, index);
+    mCapacity = offset + size;
+
+    Block& block = mBlocks[index];
+    block.state = State::Used;
+    block.alignment = alignment;
+    mUsedBytes += size;
+    mAllocationCount++;
+    return Allocation{offset, size, index};
+}
+
+void RangeAllocator::release(const Allocation& allocation)
+{
+    uint32_t index = checkAllocation(allocation);
+    mUsedBytes -= mBlocks[index].size;
+    mAllocationCount--;
+    freeBlock(index);
+}
+
+void RangeAllocator::releaseDeferred(const Allocation& allocation, uint64_t fenceValue)
+{
+    uint32_t index = checkAllocation(allocation);
+    Block& block = mBlocks[index];
+    block.state = State::Pending;
+    mUsedBytes -= block.size;
+    mAllocationCount--;
+    mPendingBytes += block.size;
+    mPendingCount++;
+    mDeferredReleases.push({fenceValue, index});
+}
+
+uint32_t RangeAllocator::executeDeferredReleases(uint64_t fenceValue)
+{
+    uint32_t count = 0;
+    while (!mDeferredReleases.empty() && mDeferredReleases.top().fenceValue < fenceValue)
+    {
+        uint32_t index = mDeferredReleases.top().block;
+        mDeferredReleases.pop();
+        FALCOR_ASSERT(mBlocks[index].state == State::Pending);
+        mPendingBytes -= mBlocks[index].size;
+        mPendingCount--;
+        freeBlock(index);
+        count++;
+    }
+    return count;
+}
+
+void RangeAllocator::grow(uint64_t capacity)
+{
+    FALCOR_CHECK(capacity >= mCapacity, "Capacity can only grow.");
+    if (capacity == mCapacity)
+        return;
+
+    uint64_t size = capacity - mCapacity;
+    if (mLastBlock != kInvalidBlock && mBlocks[mLastBlock].state == State::Free)
+    {
+        // Extend the free block at the end.
+        removeFree(mLastBlock);
+        mBlocks[mLastBlock].size += size;
+        insertFree(mLastBlock);
+    }
+    else
+    {
+        uint32_t index = createBlock(mCapacity, size);
+        linkAfter(mLastBlock, index);
+        insertFree(index);
+    }
+    mCapacity = capacity;
+}
+
+uint64_t RangeAllocator::trim()
+{
+    if (mLastBlock != kInvalidBlock && mBlocks[mLastBlock].state == State::Free)
+    {
+        uint32_t index = mLastBlock;
+        mCapacity -= mBlocks[index].size;
+        removeFree(index);
+        unlink(index);
+        destroyBlock(index);
+    }
+    return mCapacity;
+}
+
+std::vector<RangeAllocator::Move> RangeAllocator::defragment()
+{
+    // Collect the blocks in address order and drop all free blocks.
+    std::vector<uint32_t> blocks;
+    blocks.reserve(mAllocationCount + mPendingCount);
+    for (uint32_t index = mFirstBlock; index != kInvalidBlock;)
+    {
+        uint32_t next = mBlocks[index].nextPhys;
+        if (mBlocks[index].state == State::Free)
+        {
+            removeFree(index);
+            destroyBlock(index);
+        }
+        else
+        {
+            blocks.push_back(index);
+        }
+        index = next;
+    }
+
+    // Place the blocks tightly, inserting free blocks for alignment padding and in front of pinned deferred releases.
+    std::vector<Move> moves;
+    mFirstBlock = kInvalidBlock;
+    mLastBlock = kInvalidBlock;
+    uint64_t cursor = 0;
+    auto addFreeBlock = [&](uint64_t end)
+    {
+        if (end > cursor)
+        {
+            uint32_t index = createBlock(cursor, end - cursor);
+            linkAfter(mLastBlock, index);
+            insertFree(index);
+        }
+    };
+    for (uint32_t index : blocks)
+    {
+        mBlocks[index].prevPhys = kInvalidBlock;
+        mBlocks[index].nextPhys = kInvalidBlock;
+        uint64_t offset = mBlocks[index].offset;
+        if (mBlocks[index].state == State::Used)
+            offset = align_to(mBlocks[index].alignment, cursor);
+        FALCOR_ASSERT(offset <= mBlocks[index].offset);
+        addFreeBlock(offset);
+        if (offset != mBlocks[index].offset)
+        {
+            moves.push_back({index, mBlocks[index].offset, offset, mBlocks[index].size});
+            mBlocks[index].offset = offset;
+        }
+        linkAfter(mLastBlock, index);
+        cursor = offset + mBlocks[index].size;
+    }
+    addFreeBlock(mCapacity);
+
+    return moves;
+}
+
+void RangeAllocator::clear()
+{
+    uint64_t capacity = mCapacity;
+    mCapacity = 0;
+    mBlocks.clear();
+    mUnusedBlocks.clear();
+    mFirstBlock = kInvalidBlock;
+    mLastBlock = kInvalidBlock;
+    mFLBitmap = 0;
+    mSLBitmaps.fill(0);
+    for (auto& heads : mFreeHeads)
+        heads.fill(kInvalidBlock);
+    mDeferredReleases = {};
+    mUsedBytes = 0;
+    mPendingBytes = 0;
+    mAllocationCount = 0;
+    mPendingCount = 0;
+    mFreeBlockCount = 0;
+    grow(capacity);
+}
+
+uint64_t RangeAllocator::getOffset(const Allocation& allocation) const
+{
+    FALCOR_CHECK(allocation.block < mBlocks.size() && mBlocks[allocation.block].state == State::Used, "Invalid allocation.");
+    return mBlocks[allocation.block].offset;
+}
+
+bool RangeAllocator::hasHoles() const
+{
+    if (mFreeBlockCount == 0)
+        return false;
+    return mFreeBlockCount > 1 || mBlocks[mLastBlock].state != State::Free;
+}
+
+RangeAllocator::Stats RangeAllocator::getStats() const
+{
+    Stats stats;
+    stats.capacity = mCapacity;
+    stats.usedBytes = mUsedBytes;
+    stats.pendingBytes = mPendingBytes;
+    stats.freeBytes = mCapacity - mUsedBytes - mPendingBytes;
+    stats.allocationCount = mAllocationCount;
+    stats.pendingCount = mPendingCount;
+    stats.freeBlockCount = mFreeBlockCount;
+
+    // The largest free block is in the highest non-empty size class.
+    if (mFLBitmap != 0)
+    {
+        uint32_t fl = msb64(mFLBitmap);
+        uint32_t sl = msb64(mSLBitmaps[fl]);
+        for (uint32_t index = mFreeHeads[fl][sl]; index != kInvalidBlock; index = mBlocks[index].nextFree)
+            stats.largestFreeBlock = std::max(stats.largestFreeBlock, mBlocks[index].size);
+    }
+
+    return stats;
+}
+
+// Private
+
+void RangeAllocator::mapSize(uint64_t size, uint32_t& fl, uint32_t& sl)
+{
+    if (size < kSLCount)
+    {
+        fl = 0;
+        sl = uint32_t(size);
+    }
+    else
+    {
+        uint32_t bit = msb64(size);
+        fl = bit - kSLLog2 + 1;
+        sl = uint32_t(size >> (bit - kSLLog2)) - kSLCount;
+    }
+}
+
+uint32_t RangeAllocator::createBlock(uint64_t offset, uint64_t size)
+{
+    uint32_t index;
+    if (!mUnusedBlocks.empty())
+    {
+        index = mUnusedBlocks.back();
+        mUnusedBlocks.pop_back();
+    }
+    else
+    {
+        FALCOR_CHECK(mBlocks.size() < kInvalidBlock, "Too many blocks.");
+        index = uint32_t(mBlocks.size());
+        mBlocks.emplace_back();
+    }
+    Block& block = mBlocks[index];
+    block = Block();
+    block.offset = offset;
+    block.size = size;
+    return index;
+}
+
+void RangeAllocator::destroyBlock(uint32_t index)
+{
+    mBlocks[index].state = State::Unused;
+    mUnusedBlocks.push_back(index);
+}
+
+void RangeAllocator::linkAfter(uint32_t prev, uint32_t index)
+{
+    Block& block = mBlocks[index];
+    block.prevPhys = prev;
+    if (prev != kInvalidBlock)
+    {
+        block.nextPhys = mBlocks[prev].nextPhys;
+        mBlocks[prev].nextPhys = index;
+    }
+    else
+    {
+        block.nextPhys = mFirstBlock;
+        mFirstBlock = index;
+    }
+
+    if (block.nextPhys != kInvalidBlock)
+        mBlocks[block.nextPhys].prevPhys = index;
+    else
+        mLastBlock = index;
+}
+
+void RangeAllocator::unlink(uint32_t index)
+{
+    Block& block = mBlocks[index];
+    if (block.prevPhys != kInvalidBlock)
+        mBlocks[block.prevPhys].nextPhys = block.nextPhys;
+    else
+        mFirstBlock = block.nextPhys;
+    if (block.nextPhys != kInvalidBlock)
+        mBlocks[block.nextPhys].prevPhys = block.prevPhys;
+    else
+        mLastBlock = block.prevPhys;
+    block.prevPhys = kInvalidBlock;
+    block.nextPhys = kInvalidBlock;
+}
+
+void RangeAllocator::insertFree(uint32_t index)
+{
+    Block& block = mBlocks[index];
+    uint32_t fl, sl;
+    mapSize(block.size, fl, sl);
+
+    uint32_t& head = mFreeHeads[fl][sl];
+    block.state = State::Free;
+    block.prevFree = kInvalidBlock;
+    block.nextFree = head;
+    if (head != kInvalidBlock)
+        mBlocks[head].prevFree = index;
+    head = index;
+
+    mFLBitmap |= 1ull << fl;
+    mSLBitmaps[fl] |= 1u << sl;
+    mFreeBlockCount++;
+}
+
+void RangeAllocator::removeFree(uint32_t index)
+{
+    Block& block = mBlocks[index];
+    FALCOR_ASSERT(block.state == State::Free);
+    uint32_t fl, sl;
+    mapSize(block.size, fl, sl);
+
+    if (block.prevFree != kInvalidBlock)
+        mBlocks[block.prevFree].nextFree = block.nextFree;
+    else
+        mFreeHeads[fl][sl] = block.nextFree;
+    if (block.nextFree != kInvalidBlock)
+        mBlocks[block.nextFree].prevFree = block.prevFree;
+
+    if (mFreeHeads[fl][sl] == kInvalidBlock)
+    {
+        mSLBitmaps[fl] &= ~(1u << sl);
+        if (mSLBitmaps[fl] == 0)
+            mFLBitmap &= ~(1ull << fl);
+    }
+
+    block.prevFree = kInvalidBlock;
+    block.nextFree = kInvalidBlock;
+    block.state = State::Unused;
+    mFreeBlockCount--;
+}
+
+uint32_t RangeAllocator::findFree(uint64_t size) const
+{
+    // Round up to the next size class so that any block in the found class is large enough.
+    if (size >= kSLCount)
+    {
+        uint64_t round = (1ull << (msb64(size) - kSLLog2)) - 1;
+        if (size > std::numeric_limits<uint64_t>::max() - round)
+            return kInvalidBlock;
+        size += round;
+    }
+
+    uint32_t fl, sl;
+    mapSize(size, fl, sl);
+
+    uint32_t slBitmap = mSLBitmaps[fl] & (~0u << sl);
+    if (slBitmap == 0)
+    {
+        uint64_t flBitmap = fl + 1 < 64 ? mFLBitmap & (~0ull << (fl + 1)) : 0;
+        if (flBitmap == 0)
+            return kInvalidBlock;
+        fl = lsb64(flBitmap);
+        slBitmap = mSLBitmaps[fl];
+    }
+    sl = lsb64(slBitmap);
+    return mFreeHeads[fl][sl];
+}
+
+void RangeAllocator::freeBlock(uint32_t index)
+{
+    // Coalesce with the free neighbors.
+    uint32_t prev = mBlocks[index].prevPhys;
+    if (prev != kInvalidBlock && mBlocks[prev].state == State::Free)
+    {
+        removeFree(prev);
+        mBlocks[prev].size += mBlocks[index].size;
+        unlink(index);
+        destroyBlock(index);
+        index = prev;
+    }
+
+    uint32_t next = mBlocks[index].nextPhys;
+    if (next != kInvalidBlock && mBlocks[next].state == State::Free)
+    {
+        removeFree(next);
+        mBlocks[index].size += mBlocks[next].size;
+        unlink(next);
+        destroyBlock(next);
+    }
+
+    insertFree(index);
+}
+
+uint32_t RangeAllocator::checkAllocation(const Allocation& allocation) const
+{
+    FALCOR_CHECK(
+        allocation.block < mBlocks.size() && mBlocks[allocation.block].state == State::Used &&
+            mBlocks[allocation.block].offset == allocation.offset && mBlocks[allocation.block].size == allocation.size,
+        "Invalid allocation."
+    );
+    return allocation.block;
+}
+} // namespace Falcor
@@ -0,0 +1,237 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <array>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Hardware-agnostic allocator for ranges in a linear address space.
+ *
+ * The allocator only manages offsets, the memory itself is owned by the caller
+ * (e.g. a CPU buffer or a GPU buffer). It implements the TLSF (two-level segregated fit)
+ * algorithm, allocation and release are O(1). Free ranges are coalesced immediately.
+ *
+ * Releases can be deferred until a fence value is reached, which allows freeing
+ * memory that may still be in use by the GPU. The address space can be grown,
+ * trimmed and defragmented. Defragmentation returns the list of moved ranges
+ * so the owner can move the data and update references.
+ *
+ * The allocator is not thread-safe.
+ */
+class FALCOR_API RangeAllocator
+{
+public:
+    static constexpr uint32_t kInvalidBlock = uint32_t(-1);
+
+    /// Allocated range.
+    struct Allocation
+    {
+        uint64_t offset = 0;            ///< Offset of the range in bytes.
+        uint64_t size = 0;              ///< Size of the range in bytes.
+        uint32_t block = kInvalidBlock; ///< Internal block index.
+
+        bool isValid() const { return block != kInvalidBlock; }
+    };
+
+    /// Range moved by defragment().
+    struct Move
+    {
+        uint32_t block = kInvalidBlock; ///< Internal block index of the moved allocation.
+        uint64_t srcOffset = 0;         ///< Offset before defragmentation.
+        uint64_t dstOffset = 0;         ///< Offset after defragmentation.
+        uint64_t size = 0;              ///< Size of the range in bytes.
+    };
+
+    struct Stats
+    {
+        uint64_t capacity = 0;         ///< Size of the address space in bytes.
+        uint64_t usedBytes = 0;        ///< Number of bytes in live allocations.
+        uint64_t pendingBytes = 0;     ///< Number of bytes in deferred releases.
+        uint64_t freeBytes = 0;        ///< Number of free bytes.
+        uint64_t largestFreeBlock = 0; ///< Size of the largest free range in bytes.
+        uint32_t allocationCount = 0;  ///< Number of live allocations.
+        uint32_t pendingCount = 0;     ///< Number of deferred releases.
+        uint32_t freeBlockCount = 0;   ///< Number of free ranges.
+
+        /// Fragmentation of the free space in [0,1]. Zero if all free space is in a single range.
+        double getFragmentation() const { return freeBytes > 0 ? 1.0 - double(largestFreeBlock) / double(freeBytes) : 0.0; }
+    };
+
+    /**
+     * Create an allocator.
+     * @param[in] capacity Initial size of the address space in bytes.
+     */
+    explicit RangeAllocator(uint64_t capacity = 0);
+
+    /**
+     * Allocate a range.
+     * @param[in] size Size in bytes. Must be larger than zero.
+     * @param[in] alignment Alignment of the offset in bytes. Must be a power of two.
+     * @return The allocated range, or an invalid allocation if there is no free range large enough.
+     */
+    Allocation allocate(uint64_t size, uint64_t alignment = 1);
+
+    /**
+     * Allocate a range at or beyond the end of the address space, growing the address space to `offset + size`.
+     * The space between the previous end and `offset` becomes free.
+     * @param[in] offset Offset in bytes. Must be at least the current capacity.
+     * @param[in] size Size in bytes. Must be larger than zero.
+     * @param[in] alignment Alignment the range needs to keep when defragmenting. Must be a power of two.
+     * @return The allocated range.
+     */
+    Allocation append(uint64_t offset, uint64_t size, uint64_t alignment = 1);
+
+    /**
+     * Release an allocation immediately.
+     * @param[in] allocation Allocation to release.
+     */
+    void release(const Allocation& allocation);
+
+    /**
+     * Release an allocation once the given fence value is reached, see executeDeferredReleases().
+     * The range stays reserved until then.
+     * @param[in] allocation Allocation to release.
+     * @param[in] fenceValue Fence value the allocation is tagged with.
+     */
+    void releaseDeferred(const Allocation& allocation, uint64_t fenceValue);
+
+    /**
+     * Execute deferred releases.
+     * @param[in] fenceValue Current fence value. All deferred releases tagged with a smaller value are released.
+     * @return Number of released allocations.
+     */
+    uint32_t executeDeferredReleases(uint64_t fenceValue);
+
+    /**
+     * Grow the address space. The new space is free.
+     * @param[in] capacity New size of the address space in bytes. Must be at least the current capacity.
+     */
+    void grow(uint64_t capacity);
+
+    /**
+     * Shrink the address space by removing free space at its end.
+     * @return The new capacity.
+     */
+    uint64_t trim();
+
+    /**
+     * Defragment the address space by moving all live allocations towards offset zero, keeping their order and alignment.
+     * Deferred releases are not moved. Afterwards all free space is at the end of the address space (unless there are
+     * deferred releases). The caller is responsible for moving the data. The moves are sorted by offset and never move
+     * data to a higher offset, so they can be executed in order using `memmove`.
+     * @return List of moved allocations.
+     */
+    std::vector<Move> defragment();
+
+    /**
+     * Release all allocations, including deferred releases.
+     */
+    void clear();
+
+    /**
+     * Get the current offset of an allocation. Use this to update allocations after defragmentation.
+     */
+    uint64_t getOffset(const Allocation& allocation) const;
+
+    uint64_t getCapacity() const { return mCapacity; }
+
+    /// Returns true if there are no live allocations and no deferred releases.
+    bool isEmpty() const { return mAllocationCount == 0 && mPendingCount == 0; }
+
+    /// Returns true if there is at least one free range that is not at the end of the address space.
+    bool hasHoles() const;
+
+    Stats getStats() const;
+
+private:
+    static constexpr uint32_t kSLLog2 = 4;
+    static constexpr uint32_t kSLCount = 1 << kSLLog2;
+    static constexpr uint32_t kFLCount = 64 - kSLLog2 + 1;
+
+    enum class State : uint8_t
+    {
+        Unused,
+        Free,
+        Used,
+        Pending,
+    };
+
+    struct Block
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        uint32_t prevPhys = kInvalidBlock;
+        uint32_t nextPhys = kInvalidBlock;
+        uint32_t prevFree = kInvalidBlock;
+        uint32_t nextFree = kInvalidBlock;
+        State state = State::Unused;
+    };
+
+    struct DeferredRelease
+    {
+        uint64_t fenceValue;
+        uint32_t block;
+        bool operator<(const DeferredRelease& other) const { return fenceValue > other.fenceValue; }
+    };
+
+    static void mapSize(uint64_t size, uint32_t& fl, uint32_t& sl);
+    uint32_t createBlock(uint64_t offset, uint64_t size);
+    void destroyBlock(uint32_t index);
+    void linkAfter(uint32_t prev, uint32_t index);
+    void unlink(uint32_t index);
+    void insertFree(uint32_t index);
+    void removeFree(uint32_t index);
+    uint32_t findFree(uint64_t size) const;
+    void freeBlock(uint32_t index);
+    uint32_t checkAllocation(const Allocation& allocation) const;
+
+    uint64_t mCapacity = 0;
+    std::vector<Block> mBlocks;
+    std::vector<uint32_t> mUnusedBlocks;
+    uint32_t mFirstBlock = kInvalidBlock; ///< First block in address order.
+    uint32_t mLastBlock = kInvalidBlock;  ///< Last block in address order.
+
+    uint64_t mFLBitmap = 0;
+    std::array<uint32_t, kFLCount> mSLBitmaps = {};
+    std::array<std::array<uint32_t, kSLCount>, kFLCount> mFreeHeads;
+
+    std::priority_queue<DeferredRelease> mDeferredReleases;
+
+    uint64_t mUsedBytes = 0;
+    uint64_t mPendingBytes = 0;
+    uint32_t mAllocationCount = 0;
+    uint32_t mPendingCount = 0;
+    uint32_t mFreeBlockCount = 0;
+};
+} // namespace Falcor
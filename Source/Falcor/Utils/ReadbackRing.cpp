@@ -0,0 +1,163 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "ReadbackRing.h"
+#include "Core/Error.h"
+#include "Utils/Math/Common.h"
+
+namespace Falcor
+{
+ReadbackRing::ReadbackRing(uint64_t capacity) : mCapacity(capacity) {}
+
+ReadbackRing::Request ReadbackRing::push(uint64_t size, uint64_t alignment, uint64_t fenceValue, Callback callback, const void* pOwner)
+{
+    FALCOR_CHECK(size > 0, "'size' must be larger than zero.");
+    FALCOR_CHECK(isPowerOf2(alignment), "'alignment' must be a power of two.");
+    FALCOR_CHECK(fenceValue >= mLastFenceValue, "'fenceValue' must not be smaller than the fence value of the last request.");
+
+    uint64_t offset = 0;
+    if (mPending.empty())
+    {
+        // Restart at the beginning to keep the largest possible contiguous range free.
+        if (size > mCapacity)
+            return {};
+    }
+    else
+    {
+        const uint64_t tail = mPending.front().offset;
+        offset = align_to(alignment, mHead);
+        if (mHead > tail)
+        {
+            // Free space is after the head and before the tail. Wrap around if it doesn't fit at the end.
+            if (offset + size > mCapacity)
+            {
+                offset = 0;
+                if (size > tail)
+                    return {};
+            }
+        }
+        else if (offset + size > tail)
+        {
+            // Free space is between the head and the tail (wrapped or full).
+            return {};
+        }
+    }
+
+    Ticket ticket = mNextTicket++;
+    mPending.push_back({ticket, fenceValue, offset, size, std::move(callback), pOwner});
+    mHead = offset + size;
+    mLastFenceValue = fenceValue;
+    return {ticket, offset};
+}
+
+uint32_t ReadbackRing::retire(uint64_t completedValue, const void* pData)
+{
+    uint32_t count = 0;
+    while (!mPending.empty() && mPending.front().fenceValue <= completedValue)
+    {
+        // Pop the entry before invoking the callback, so the callback is free to issue new requests.
+        // The range can be reused right away since data for new requests is written later.
+        Entry entry = std::move(mPending.front());
+        mPending.pop_front();
+        mLastRetiredTicket = entry.ticket;
+        mRetiredCount++;
+        count++;
+
+        if (entry.callback)
+            entry.callback(static_cast<const uint8_t*>(pData) + entry.offset, entry.size);
+    }
+    return count;
+}
+
+void ReadbackRing::cancel(Ticket ticket)
+{
+    if (auto pEntry = findPending(ticket); pEntry && pEntry->callback)
+    {
+        pEntry->callback = nullptr;
+        mCancelCount++;
+    }
+}
+
+void ReadbackRing::cancel(const void* pOwner)
+{
+    if (!pOwner)
+        return;
+
+    for (auto& entry : mPending)
+    {
+        if (entry.pOwner == pOwner && entry.callback)
+        {
+            entry.callback = nullptr;
+            mCancelCount++;
+        }
+    }
+}
+
+uint64_t ReadbackRing::getFenceValue(Ticket ticket) const
+{
+    auto pEntry = findPending(ticket);
+    FALCOR_CHECK(pEntry, "Ticket {} is not pending.", ticket);
+    return pEntry->fenceValue;
+}
+
+uint64_t ReadbackRing::getOldestFenceValue() const
+{
+    FALCOR_CHECK(!mPending.empty(), "There are no pending requests.");
+    return mPending.front().fenceValue;
+}
+
+void ReadbackRing::resize(uint64_t capacity)
+{
+    FALCOR_CHECK(mPending.empty(), "Cannot resize a ring with pending requests.");
+    mCapacity = capacity;
+    mHead = 0;
+}
+
+ReadbackRing::Stats ReadbackRing::getStats() const
+{
+    Stats stats;
+    stats.capacity = mCapacity;
+    if (!mPending.empty())
+    {
+        const uint64_t tail = mPending.front().offset;
+        stats.usedBytes = mHead > tail ? mHead - tail : mCapacity - tail + mHead;
+    }
+    stats.pendingCount = (uint32_t)mPending.size();
+    stats.requestCount = mNextTicket - 1;
+    stats.retiredCount = mRetiredCount;
+    stats.cancelCount = mCancelCount;
+    return stats;
+}
+
+ReadbackRing::Entry* ReadbackRing::findPending(Ticket ticket)
+{
+    // Pending tickets are consecutive, so the entry can be looked up directly.
+    if (mPending.empty() || ticket < mPending.front().ticket || ticket >= mNextTicket)
+        return nullptr;
+    return &mPending[ticket - mPending.front().ticket];
+}
+} // namespace Falcor
@@ -0,0 +1,163 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace Falcor
+{
+/**
+ * Hardware-agnostic bookkeeping for asynchronous readback through a ring buffer.
+ *
+ * The ring only manages offsets, the staging memory itself is owned by the caller.
+ * Each readback request reserves a range in the ring and is tagged with the fence value
+ * that signals completion of the copy into that range. Requests are retired in submission
+ * order once the fence has reached their value. Retiring a request invokes its callback
+ * with a pointer to the data and frees the range. As fence values are non-decreasing,
+ * the ranges in flight always form a single contiguous region of the ring.
+ *
+ * The class knows nothing about fences or GPU resources, the fence value is passed in
+ * by the caller. See ReadbackService for the GPU side.
+ *
+ * The class is not thread-safe.
+ */
+class FALCOR_API ReadbackRing
+{
+public:
+    /// Identifies a readback request. Tickets are issued in increasing order and never reused.
+    using Ticket = uint64_t;
+    static constexpr Ticket kInvalidTicket = 0;
+
+    /// Callback invoked when the data is available. The data pointer is only valid for the duration of the call.
+    using Callback = std::function<void(const void* pData, size_t size)>;
+
+    /// Request that was added to the ring.
+    struct Request
+    {
+        Ticket ticket = kInvalidTicket; ///< Ticket of the request.
+        uint64_t offset = 0;            ///< Offset of the reserved range in bytes.
+
+        bool isValid() const { return ticket != kInvalidTicket; }
+    };
+
+    struct Stats
+    {
+        uint64_t capacity = 0;      ///< Size of the ring in bytes.
+        uint64_t usedBytes = 0;     ///< Number of bytes reserved by pending requests, including padding.
+        uint32_t pendingCount = 0;  ///< Number of pending requests.
+        uint64_t requestCount = 0;  ///< Total number of requests.
+        uint64_t retiredCount = 0;  ///< Total number of retired requests.
+        uint64_t cancelCount = 0;   ///< Total number of cancelled requests.
+    };
+
+    /**
+     * Create a ring.
+     * @param[in] capacity Size of the ring in bytes.
+     */
+    explicit ReadbackRing(uint64_t capacity);
+
+    /**
+     * Add a readback request.
+     * @param[in] size Size in bytes. Must be larger than zero.
+     * @param[in] alignment Alignment of the offset in bytes. Must be a power of two.
+     * @param[in] fenceValue Fence value signaling that the data has been written. Must not be smaller than the value of the last request.
+     * @param[in] callback Callback invoked when the request is retired (optional).
+     * @param[in] pOwner Owner of the request, used for cancelling all requests of an owner (optional).
+     * @return The request, or an invalid request if the ring is full. Retire pending requests and try again.
+     */
+    Request push(uint64_t size, uint64_t alignment, uint64_t fenceValue, Callback callback, const void* pOwner = nullptr);
+
+    /**
+     * Retire all requests whose fence value has been reached, in submission order.
+     * @param[in] completedValue Fence value completed by the producer.
+     * @param[in] pData Pointer to the staging memory the offsets refer to.
+     * @return Number of retired requests.
+     */
+    uint32_t retire(uint64_t completedValue, const void* pData);
+
+    /**
+     * Cancel a request. The callback will not be invoked, but the range stays reserved until the request is retired.
+     * @param[in] ticket Ticket of the request. Tickets of already retired requests are ignored.
+     */
+    void cancel(Ticket ticket);
+
+    /**
+     * Cancel all pending requests of an owner, see cancel().
+     * @param[in] pOwner Owner passed to push().
+     */
+    void cancel(const void* pOwner);
+
+    /// Returns true if the request has been retired (or cancelled and retired).
+    bool isRetired(Ticket ticket) const { return ticket != kInvalidTicket && ticket <= mLastRetiredTicket; }
+
+    /// Returns the fence value of a pending request.
+    uint64_t getFenceValue(Ticket ticket) const;
+
+    /// Returns the fence value of the oldest pending request. The ring must not be empty.
+    uint64_t getOldestFenceValue() const;
+
+    /**
+     * Change the size of the ring. The ring must be empty.
+     * @param[in] capacity New size of the ring in bytes.
+     */
+    void resize(uint64_t capacity);
+
+    uint64_t getCapacity() const { return mCapacity; }
+
+    /// Returns true if there are no pending requests.
+    bool isEmpty() const { return mPending.empty(); }
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        Ticket ticket;
+        uint64_t fenceValue;
+        uint64_t offset;
+        uint64_t size;
+        Callback callback;
+        const void* pOwner;
+    };
+
+    Entry* findPending(Ticket ticket);
+    const Entry* findPending(Ticket ticket) const { return const_cast<ReadbackRing*>(this)->findPending(ticket); }
+
+    uint64_t mCapacity = 0;
+    uint64_t mHead = 0; ///< Offset where the newest pending range ends. The reserved region starts at the oldest pending range.
+    std::deque<Entry> mPending;
+
+    Ticket mNextTicket = 1;
+    Ticket mLastRetiredTicket = kInvalidTicket;
+    uint64_t mLastFenceValue = 0;
+    uint64_t mRetiredCount = 0;
+    uint64_t mCancelCount = 0;
+};
+} // namespace Falcor
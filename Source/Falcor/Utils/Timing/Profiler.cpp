@@ -31,7 +31,10 @@
 #include "Utils/Logger.h"
 #include "Utils/Scripting/ScriptBindings.h"
 
+#include <array>
+#include <atomic>
 #include <fstream>
+#include <mutex>
 
 namespace Falcor
 {
@@ -46,6 +49,134 @@ const float kSigma = 0.98f;
 // for computing statistics (min, max, mean, stddev) over the recent history.
 const size_t kMaxHistorySize = 512;
 
+/**
+ * Process-wide table of interned event names.
+ * Lookups are lock-free, only interning a new name takes the mutex. Names are found in an open-addressing hash table
+ * that is published to readers with release/acquire semantics. Growing the table publishes a new one, the replaced
+ * tables are kept alive for readers still using them (at most as much memory as the current table).
+ * Entries are stored in chunks of doubling size that are never moved, so names can be returned by reference.
+ */
+class NameRegistry
+{
+public:
+    NameRegistry() { mpTable.store(createTable(kInitialCapacity), std::memory_order_relaxed); }
+
+    Profiler::NameId intern(std::string_view name)
+    {
+        const size_t hash = std::hash<std::string_view>()(name);
+        if (const Entry* pEntry = find(*mpTable.load(std::memory_order_acquire), name, hash))
+            return pEntry->id;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        Table* pTable = mpTable.load(std::memory_order_relaxed);
+        if (const Entry* pEntry = find(*pTable, name, hash))
+            return pEntry->id;
+
+        // Construct the entry before it is published in the table.
+        const Profiler::NameId id = mCount.load(std::memory_order_relaxed);
+        auto [chunk, offset] = getChunk(id);
+        if (offset == 0)
+        {
+            mChunkStorage[chunk] = std::make_unique<Entry[]>(size_t(1) << chunk);
+            mChunks[chunk].store(mChunkStorage[chunk].get(), std::memory_order_release);
+        }
+        Entry& entry = mChunkStorage[chunk][offset];
+        entry.name = name;
+        entry.hash = hash;
+        entry.id = id;
+        mCount.store(id + 1, std::memory_order_release);
+
+        // Keep the load factor at or below 1/2, so probing always finds an empty slot.
+        if (2 * (size_t(id) + 1) > pTable->size())
+        {
+            Table* pNewTable = createTable(2 * pTable->size());
+            for (Profiler::NameId i = 0; i <= id; i++)
+                insert(*pNewTable, &getEntry(i));
+            mpTable.store(pNewTable, std::memory_order_release);
+        }
+        else
+        {
+            insert(*pTable, &entry);
+        }
+        return id;
+    }
+
+    const std::string& getName(Profiler::NameId id) const
+    {
+        FALCOR_ASSERT(id < mCount.load(std::memory_order_acquire));
+        return getEntry(id).name;
+    }
+
+private:
+    struct Entry
+    {
+        std::string name;
+        size_t hash = 0;
+        Profiler::NameId id = 0;
+    };
+    using Table = std::vector<std::atomic<const Entry*>>;
+
+    static constexpr size_t kInitialCapacity = 256;
+    static constexpr size_t kMaxChunks = 32;
+
+    /// Chunk c holds the IDs [2^c - 1, 2^(c+1) - 1).
+    static std::pair<uint32_t, size_t> getChunk(Profiler::NameId id)
+    {
+        const uint64_t index = uint64_t(id) + 1;
+        uint32_t chunk = 0;
+        while ((index >> (chunk + 1)) != 0)
+            chunk++;
+        return {chunk, size_t(index - (uint64_t(1) << chunk))};
+    }
+
+    const Entry& getEntry(Profiler::NameId id) const
+    {
+        auto [chunk, offset] = getChunk(id);
+        return mChunks[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    Table* createTable(size_t capacity)
+    {
+        mTables.push_back(std::make_unique<Table>(capacity));
+        return mTables.back().get();
+    }
+
+    static const Entry* find(const Table& table, std::string_view name, size_t hash)
+    {
+        const size_t mask = table.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask)
+        {
+            const Entry* pEntry = table[i].load(std::memory_order_acquire);
+            if (!pEntry)
+                return nullptr;
+            if (pEntry->hash == hash && pEntry->name == name)
+                return pEntry;
+        }
+    }
+
+    static void insert(Table& table, const Entry* pEntry)
+    {
+        const size_t mask = table.size() - 1;
+        size_t i = pEntry->hash & mask;
+        while (table[i].load(std::memory_order_relaxed))
+            i = (i + 1) & mask;
+        table[i].store(pEntry, std::memory_order_release);
+    }
+
+    std::mutex mMutex;                                              ///< Guards interning new names.
+    std::atomic<Table*> mpTable;                                    ///< Current hash table.
+    std::vector<std::unique_ptr<Table>> mTables;                    ///< All tables created so far.
+    std::atomic<Profiler::NameId> mCount{0};                        ///< Number of interned names.
+    std::array<std::atomic<Entry*>, kMaxChunks> mChunks{};          ///< Entry chunks for lock-free access.
+    std::array<std::unique_ptr<Entry[]>, kMaxChunks> mChunkStorage; ///< Entry chunks owned by the registry.
+};
+
+NameRegistry& getNameRegistry()
+{
+    static NameRegistry registry;
+    return registry;
+}
+
 pybind11::dict toPython(const Profiler::Stats& stats)
 {
     pybind11::dict d;
@@ -109,39 +240,117 @@ Profiler::Stats Profiler::Stats::compute(const float* data, size_t len)
 
     float min = std::numeric_limits<float>::max();
     float max = std::numeric_limits<float>::lowest();
-    double sum = 0.0;
-    double sum2 = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
 
+    // Single pass using Welford's algorithm, which avoids the cancellation of the sum of squares approach.
     for (size_t i = 0; i < len; ++i)
     {
         float value = data[i];
         min = std::min(min, value);
         max = std::max(max, value);
-        sum += value;
-        sum2 += value * value;
+        double delta = value - mean;
+        mean += delta / (i + 1);
+        m2 += delta * (value - mean);
     }
 
-    double mean = sum / len;
-    double mean2 = sum2 / len;
-    double variance = mean2 - mean * mean;
-    double stdDev = std::sqrt(variance);
+    double stdDev = std::sqrt(m2 / len);
 
     return {min, max, (float)mean, (float)stdDev};
 }
 
+// Profiler::RollingStats
+
+Profiler::RollingStats::RollingStats(size_t windowSize) : mValues(windowSize, 0.f)
+{
+    FALCOR_ASSERT(windowSize > 0);
+}
+
+void Profiler::RollingStats::add(float value)
+{
+    const size_t windowSize = mValues.size();
+
+    if (mCount < windowSize)
+    {
+        // Grow the window.
+        ++mCount;
+        double delta = value - mMean;
+        mMean += delta / mCount;
+        mM2 += delta * (value - mMean);
+        mMin = mCount == 1 ? value : std::min(mMin, value);
+        mMax = mCount == 1 ? value : std::max(mMax, value);
+        mValues[mWriteIndex] = value;
+    }
+    else
+    {
+        // Replace the oldest value.
+        float oldValue = mValues[mWriteIndex];
+        mValues[mWriteIndex] = value;
+        double oldMean = mMean;
+        mMean += (double(value) - oldValue) / windowSize;
+        mM2 = std::max(0.0, mM2 + (double(value) - oldValue) * (value - mMean + oldValue - oldMean));
+
+        if ((oldValue == mMin && value > mMin) || (oldValue == mMax && value < mMax))
+        {
+            recomputeMinMax();
+        }
+        else
+        {
+            mMin = std::min(mMin, value);
+            mMax = std::max(mMax, value);
+        }
+    }
+
+    mWriteIndex = (mWriteIndex + 1) % windowSize;
+
+    // Recompute from scratch once per window to avoid accumulating rounding errors.
+    if (mWriteIndex == 0)
+        recompute();
+}
+
+Profiler::Stats Profiler::RollingStats::getStats() const
+{
+    if (mCount == 0)
+        return {};
+    return {mMin, mMax, (float)mMean, (float)std::sqrt(mM2 / mCount)};
+}
+
+void Profiler::RollingStats::recompute()
+{
+    Stats stats = Stats::compute(mValues.data(), mCount);
+    mMin = stats.min;
+    mMax = stats.max;
+    mMean = 0.0;
+    mM2 = 0.0;
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        double delta = mValues[i] - mMean;
+        mMean += delta / (i + 1);
+        mM2 += delta * (mValues[i] - mMean);
+    }
+}
+
+void Profiler::RollingStats::recomputeMinMax()
+{
+    auto [pMin, pMax] = std::minmax_element(mValues.begin(), mValues.begin() + mCount);
+    mMin = *pMin;
+    mMax = *pMax;
+}
+
 // Profiler::Event
 
-Profiler::Event::Event(const std::string& name) : mName(name), mCpuTimeHistory(kMaxHistorySize, 0.f), mGpuTimeHistory(kMaxHistorySize, 0.f)
+Profiler::Event::Event(const std::string& name, Event* pParent, NameId nameId)
+    : mName(name), mpParent(pParent), mNameId(nameId), mCpuTimeStats(kMaxHistorySize), mGpuTimeStats(kMaxHistorySize)
 {}
 
 Profiler::Stats Profiler::Event::computeCpuTimeStats() const
 {
-    return Stats::compute(mCpuTimeHistory.data(), mHistorySize);
+    return mCpuTimeStats.getStats();
 }
 
 Profiler::Stats Profiler::Event::computeGpuTimeStats() const
 {
-    return Stats::compute(mGpuTimeHistory.data(), mHistorySize);
+    return mGpuTimeStats.getStats();
 }
 
 void Profiler::Event::start(Profiler& profiler, uint32_t frameIndex)
@@ -160,6 +369,8 @@ void Profiler::Event::start(Profiler& profiler, uint32_t frameIndex)
 
     // Update CPU time.
     frameData.cpuStartTime = CpuTimer::getCurrentTimePoint();
+    if (frameData.currentTimer == 0)
+        frameData.traceTimestamp = TraceRecorder::getGlobal().getTimestamp();
 
     // Update GPU time.
     FALCOR_ASSERT(frameData.pActiveTimer == nullptr);
@@ -192,7 +403,7 @@ void Profiler::Event::end(uint32_t frameIndex)
     frameData.valid = true;
 }
 
-void Profiler::Event::endFrame(uint32_t frameIndex)
+void Profiler::Event::endFrame(Profiler& profiler, uint32_t frameIndex)
 {
     // Resolve GPU timers for the current frame measurements.
     // This is necessary before we readback of results next frame.
@@ -215,6 +426,16 @@ void Profiler::Event::endFrame(uint32_t frameIndex)
     mGpuTime = 0.f;
     for (size_t i = 0; i < frameData.currentTimer; ++i)
         mGpuTime += (float)frameData.pTimers[i]->getElapsedTime();
+
+    // Record the GPU time on the GPU trace track.
+    // GPU timestamps are not calibrated against the CPU clock, so the event is placed at the time the CPU issued it.
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    if (recorder.isRecording())
+    {
+        if (profiler.mGpuTrack.id == 0)
+            profiler.mGpuTrack = recorder.createTrack("GPU");
+        recorder.complete(profiler.mGpuTrack, std::string_view(mName).substr(1), frameData.traceTimestamp, uint64_t(mGpuTime * 1e6), "gpu");
+    }
     frameData.cpuTotalTime = 0.f;
     frameData.currentTimer = 0;
 
@@ -222,11 +443,9 @@ void Profiler::Event::endFrame(uint32_t frameIndex)
     mCpuTimeAverage = mCpuTimeAverage < 0.f ? mCpuTime : (kSigma * mCpuTimeAverage + (1.f - kSigma) * mCpuTime);
     mGpuTimeAverage = mGpuTimeAverage < 0.f ? mGpuTime : (kSigma * mGpuTimeAverage + (1.f - kSigma) * mGpuTime);
 
-    // Update history.
-    mCpuTimeHistory[mHistoryWriteIndex] = mCpuTime;
-    mGpuTimeHistory[mHistoryWriteIndex] = mGpuTime;
-    mHistoryWriteIndex = (mHistoryWriteIndex + 1) % kMaxHistorySize;
-    mHistorySize = std::min(mHistorySize + 1, kMaxHistorySize);
+    // Update statistics.
+    mCpuTimeStats.add(mCpuTime);
+    mGpuTimeStats.add(mGpuTime);
 
     mTriggered = 0;
 }
@@ -310,50 +529,104 @@ Profiler::Profiler(ref<Device> pDevice) : mpDevice(pDevice)
     mpFence->breakStrongReferenceToDevice();
 }
 
-void Profiler::startEvent(RenderContext* pRenderContext, const std::string& name, Flags flags)
+Profiler::NameId Profiler::internName(std::string_view name)
 {
-    if (mEnabled && is_set(flags, Flags::Internal))
+    return getNameRegistry().intern(name);
+}
+
+const std::string& Profiler::getName(NameId nameId)
+{
+    return getNameRegistry().getName(nameId);
+}
+
+Profiler::NameInfo Profiler::getNameInfo(NameId nameId)
+{
+    if (nameId >= mNameInfos.size())
+        mNameInfos.resize(nameId + 1);
+
+    NameInfo& info = mNameInfos[nameId];
+    if (!info.pName)
     {
+        info.pName = &getName(nameId);
         // '/' is used as a "path delimiter", so it cannot be used in the event name.
-        if (name.find('/') != std::string::npos)
-        {
-            logWarning("Profiler event names must not contain '/'. Ignoring this profiler event.");
-            return;
-        }
+        info.valid = info.pName->find('/') == std::string::npos;
+    }
+    return info;
+}
 
-        mCurrentEventName = mCurrentEventName + "/" + name;
+void Profiler::startEvent(RenderContext* pRenderContext, std::string_view name, Flags flags)
+{
+    startEvent(pRenderContext, internName(name), flags);
+}
 
-        Event* pEvent = getEvent(mCurrentEventName);
-        FALCOR_ASSERT(pEvent != nullptr);
-        if (!mPaused)
-            pEvent->start(*this, mFrameIndex);
+void Profiler::startEvent(RenderContext* pRenderContext, NameId nameId, Flags flags)
+{
+    const NameInfo nameInfo = getNameInfo(nameId);
 
-        if (std::find(mCurrentFrameEvents.begin(), mCurrentFrameEvents.end(), pEvent) == mCurrentFrameEvents.end())
+    if (mEnabled && is_set(flags, Flags::Internal))
+    {
+        auto startTime = CpuTimer::getCurrentTimePoint();
+
+        if (!nameInfo.valid)
         {
-            mCurrentFrameEvents.push_back(pEvent);
+            logWarning("Profiler event names must not contain '/'. Ignoring this profiler event.");
         }
+        else
+        {
+            Event* pEvent = getChildEvent(mEventStack.empty() ? nullptr : mEventStack.back(), nameId);
+            mEventStack.push_back(pEvent);
+            if (!mPaused)
+                pEvent->start(*this, mFrameIndex);
+
+            if (pEvent->mFrameRegistered != mFrameIndex)
+            {
+                pEvent->mFrameRegistered = mFrameIndex;
+                mCurrentFrameEvents.push_back(pEvent);
+            }
+
+            TraceRecorder& recorder = TraceRecorder::getGlobal();
+            if (recorder.isRecording())
+                recorder.begin(*nameInfo.pName, "cpu");
+
+            ++mOverheadEventCount;
+        }
+
+        mOverheadAccum += CpuTimer::getCurrentTimePoint() - startTime;
     }
     if (is_set(flags, Flags::Pix))
     {
         FALCOR_ASSERT(pRenderContext);
-        pRenderContext->getLowLevelData()->beginDebugEvent(name.c_str());
+        pRenderContext->getLowLevelData()->beginDebugEvent(nameInfo.pName->c_str());
     }
 }
 
-void Profiler::endEvent(RenderContext* pRenderContext, const std::string& name, Flags flags)
+void Profiler::endEvent(RenderContext* pRenderContext, std::string_view name, Flags flags)
 {
-    if (mEnabled && is_set(flags, Flags::Internal))
+    endEvent(pRenderContext, internName(name), flags);
+}
+
+void Profiler::endEvent(RenderContext* pRenderContext, NameId nameId, Flags flags)
+{
+    const NameInfo nameInfo = getNameInfo(nameId);
+
+    if (mEnabled && is_set(flags, Flags::Internal) && nameInfo.valid)
     {
-        // '/' is used as a "path delimiter", so it cannot be used in the event name.
-        if (name.find('/') != std::string::npos)
-            return;
+        auto startTime = CpuTimer::getCurrentTimePoint();
 
-        Event* pEvent = getEvent(mCurrentEventName);
-        FALCOR_ASSERT(pEvent != nullptr);
-        if (!mPaused)
-            pEvent->end(mFrameIndex);
+        // Ignore unbalanced calls, e.g. when the profiler was enabled while the event was running.
+        if (!mEventStack.empty() && mEventStack.back()->mNameId == nameId)
+        {
+            Event* pEvent = mEventStack.back();
+            mEventStack.pop_back();
+            if (!mPaused)
+                pEvent->end(mFrameIndex);
+
+            TraceRecorder& recorder = TraceRecorder::getGlobal();
+            if (recorder.isRecording())
+                recorder.end();
+        }
 
-        mCurrentEventName.erase(mCurrentEventName.find_last_of("/"));
+        mOverheadAccum += CpuTimer::getCurrentTimePoint() - startTime;
     }
 
     if (is_set(flags, Flags::Pix))
@@ -371,18 +644,38 @@ Profiler::Event* Profiler::getEvent(const std::string& name)
 
 void Profiler::endFrame(RenderContext* pRenderContext)
 {
+    // Events do not span frames. Drop events left running after toggling the profiler mid-frame.
+    mEventStack.clear();
+
     if (mPaused)
         return;
 
+    auto startTime = CpuTimer::getCurrentTimePoint();
+
     // Wait for GPU timings to be available from last frame.
     // We use a single fence here instead of one per event, which gets too inefficient.
     // TODO: This code should refactored to batch the resolve and readback of timestamps.
+    CpuTimer::TimePoint::duration waitTime{};
     if (mFenceValue != uint64_t(-1))
+    {
+        auto waitStart = CpuTimer::getCurrentTimePoint();
         mpFence->wait();
+        waitTime = CpuTimer::getCurrentTimePoint() - waitStart;
+    }
 
     for (Event* pEvent : mCurrentFrameEvents)
     {
-        pEvent->endFrame(mFrameIndex);
+        pEvent->endFrame(*this, mFrameIndex);
+    }
+
+    // Record the frame on the trace timeline.
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    if (recorder.isRecording())
+    {
+        uint64_t timestamp = recorder.getTimestamp();
+        if (mTraceFrameStart != 0)
+            recorder.complete("Frame", mTraceFrameStart, timestamp - mTraceFrameStart, "frame");
+        mTraceFrameStart = timestamp;
     }
 
     // Flush and insert signal for synchronization of GPU timings.
@@ -393,7 +686,18 @@ void Profiler::endFrame(RenderContext* pRenderContext)
         mpCapture->captureEvents(mCurrentFrameEvents);
 
     mLastFrameEvents = std::move(mCurrentFrameEvents);
+    mCurrentFrameEvents.clear();
+    mCurrentFrameEvents.reserve(mLastFrameEvents.size());
     ++mFrameIndex;
+
+    // Update profiler overhead. This excludes waiting for the GPU, which is not caused by profiling.
+    mOverheadAccum += CpuTimer::getCurrentTimePoint() - startTime - waitTime;
+    mOverhead.cpuTime = (float)std::chrono::duration<double, std::milli>(mOverheadAccum).count();
+    mOverhead.cpuTimeAverage =
+        mOverhead.cpuTimeAverage < 0.f ? mOverhead.cpuTime : (kSigma * mOverhead.cpuTimeAverage + (1.f - kSigma) * mOverhead.cpuTime);
+    mOverhead.eventCount = mOverheadEventCount;
+    mOverheadAccum = {};
+    mOverheadEventCount = 0;
 }
 
 void Profiler::startCapture(size_t reservedFrames)
@@ -411,6 +715,32 @@ std::shared_ptr<Profiler::Capture> Profiler::endCapture()
     return pCapture;
 }
 
+void Profiler::startTrace()
+{
+    setEnabled(true);
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    recorder.clear();
+    recorder.setThreadName("Main");
+    recorder.setRecording(true);
+    mTraceFrameStart = 0;
+}
+
+void Profiler::endTrace(const std::filesystem::path& path)
+{
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    recorder.setRecording(false);
+
+    TraceRecorder::Stats stats = recorder.getStats();
+    if (stats.droppedEvents > 0)
+        logWarning("Trace recorder dropped {} events. Consider recording a shorter trace.", stats.droppedEvents);
+
+    if (!path.empty())
+    {
+        recorder.writeChromeTrace(path);
+        logInfo("Wrote trace with {} events to '{}'.", stats.eventCount, path);
+    }
+}
+
 bool Profiler::isCapturing() const
 {
     return mpCapture != nullptr;
@@ -418,11 +748,28 @@ bool Profiler::isCapturing() const
 
 Profiler::Event* Profiler::createEvent(const std::string& name)
 {
-    auto pEvent = std::shared_ptr<Event>(new Event(name));
+    auto pEvent = std::shared_ptr<Event>(new Event(name, nullptr, 0));
     mEvents.emplace(name, pEvent);
     return pEvent.get();
 }
 
+Profiler::Event* Profiler::getChildEvent(Event* pParent, NameId nameId)
+{
+    // Nested events are found through the parent without building the nested event name.
+    std::vector<Event*>& children = pParent ? pParent->mChildren : mRootEvents;
+    for (Event* pChild : children)
+        if (pChild->mNameId == nameId)
+            return pChild;
+
+    // Adopt an event previously created by name through getEvent(), or create a new one.
+    std::string name = (pParent ? pParent->mName : std::string()) + "/" + *getNameInfo(nameId).pName;
+    Event* pEvent = getEvent(name);
+    pEvent->mpParent = pParent;
+    pEvent->mNameId = nameId;
+    children.push_back(pEvent);
+    return pEvent;
+}
+
 Profiler::Event* Profiler::findEvent(const std::string& name)
 {
     auto event = mEvents.find(name);
@@ -434,16 +781,24 @@ void Profiler::breakStrongReferenceToDevice()
     mpDevice.breakStrongReference();
 }
 
-ScopedProfilerEvent::ScopedProfilerEvent(RenderContext* pRenderContext, const std::string& name, Profiler::Flags flags)
-    : mpRenderContext(pRenderContext), mName(name), mFlags(flags)
+ScopedProfilerEvent::ScopedProfilerEvent(RenderContext* pRenderContext, std::string_view name, Profiler::Flags flags)
+    : mpRenderContext(pRenderContext), mFlags(flags)
 {
     FALCOR_ASSERT(mpRenderContext);
-    mpRenderContext->getProfiler()->startEvent(mpRenderContext, mName, mFlags);
+    mNameId = Profiler::internName(name);
+    mpRenderContext->getProfiler()->startEvent(mpRenderContext, mNameId, mFlags);
+}
+
+ScopedProfilerEvent::ScopedProfilerEvent(RenderContext* pRenderContext, Profiler::NameId nameId, Profiler::Flags flags)
+    : mpRenderContext(pRenderContext), mNameId(nameId), mFlags(flags)
+{
+    FALCOR_ASSERT(mpRenderContext);
+    mpRenderContext->getProfiler()->startEvent(mpRenderContext, mNameId, mFlags);
 }
 
 ScopedProfilerEvent::~ScopedProfilerEvent()
 {
-    mpRenderContext->getProfiler()->endEvent(mpRenderContext, mName, mFlags);
+    mpRenderContext->getProfiler()->endEvent(mpRenderContext, mNameId, mFlags);
 }
 
 /// Implements a Python context manager for profiling events.
@@ -451,8 +806,11 @@ class PythonProfilerEvent
 {
 public:
     PythonProfilerEvent(RenderContext* pRenderContext, std::string_view name) : mpRenderContext(pRenderContext), mName(name) {}
-    void enter() { mpRenderContext->getProfiler()->startEvent(mpRenderContext, mName); }
-    void exit(pybind11::object, pybind11::object, pybind11::object) { mpRenderContext->getProfiler()->endEvent(mpRenderContext, mName); }
+    void enter() { mpRenderContext->getProfiler()->startEvent(mpRenderContext, std::string_view(mName)); }
+    void exit(pybind11::object, pybind11::object, pybind11::object)
+    {
+        mpRenderContext->getProfiler()->endEvent(mpRenderContext, std::string_view(mName));
+    }
 
 private:
     RenderContext* mpRenderContext;
@@ -479,8 +837,22 @@ FALCOR_SCRIPT_BINDING(Profiler)
     profiler.def_property("paused", &Profiler::isPaused, &Profiler::setPaused);
     profiler.def_property_readonly("is_capturing", &Profiler::isCapturing);
     profiler.def_property_readonly("events", [](const Profiler& profiler) { return toPython(profiler.getEvents()); });
+    profiler.def_property_readonly(
+        "overhead",
+        [](const Profiler& profiler)
+        {
+            pybind11::dict d;
+            d["cpu_time"] = profiler.getOverhead().cpuTime;
+            d["cpu_time_average"] = profiler.getOverhead().cpuTimeAverage;
+            d["event_count"] = profiler.getOverhead().eventCount;
+            return d;
+        }
+    );
     profiler.def("start_capture", &Profiler::startCapture, "reserved_frames"_a = 1000);
     profiler.def("end_capture", endCapture);
+    profiler.def_property_readonly("is_tracing", &Profiler::isTracing);
+    profiler.def("start_trace", &Profiler::startTrace);
+    profiler.def("end_trace", &Profiler::endTrace, "path"_a = std::filesystem::path());
 
     pybind11::class_<PythonProfilerEvent>(m, "ProfilerEvent")
         .def(pybind11::init<RenderContext*, std::string_view>())
@@ -27,12 +27,15 @@
  **************************************************************************/
 #pragma once
 #include "CpuTimer.h"
+#include "TraceRecorder.h"
 #include "Core/Macros.h"
 #include "Core/API/GpuTimer.h"
 #include "Core/API/Fence.h"
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -59,6 +62,9 @@ public:
         Default = Internal | Pix
     };
 
+    /// Interned event name.
+    using NameId = uint32_t;
+
     struct Stats
     {
         float min;
@@ -69,6 +75,41 @@ public:
         static Stats compute(const float* data, size_t len);
     };
 
+    /**
+     * Statistics over a sliding window of the most recent values.
+     * Mean and variance are updated incrementally using Welford's algorithm.
+     * Min/max are only recomputed when the current extreme leaves the window.
+     */
+    class FALCOR_API RollingStats
+    {
+    public:
+        RollingStats(size_t windowSize);
+
+        void add(float value);
+        Stats getStats() const;
+        size_t getCount() const { return mCount; }
+
+    private:
+        void recompute();
+        void recomputeMinMax();
+
+        std::vector<float> mValues; ///< Window of values (round-robin).
+        size_t mWriteIndex = 0;     ///< Next write index.
+        size_t mCount = 0;          ///< Number of values in the window.
+        double mMean = 0.0;         ///< Running mean.
+        double mM2 = 0.0;           ///< Running sum of squared differences from the mean.
+        float mMin = 0.f;           ///< Window minimum.
+        float mMax = 0.f;           ///< Window maximum.
+    };
+
+    /// Profiler self-measurement.
+    struct Overhead
+    {
+        float cpuTime = 0.f;         ///< CPU time spent in the profiler during the last frame in ms.
+        float cpuTimeAverage = -1.f; ///< Average CPU time spent in the profiler (negative value to signify invalid).
+        uint32_t eventCount = 0;     ///< Number of events started during the last frame.
+    };
+
     class Event
     {
     public:
@@ -84,13 +125,17 @@ public:
         Stats computeGpuTimeStats() const;
 
     private:
-        Event(const std::string& name);
+        Event(const std::string& name, Event* pParent, NameId nameId);
 
         void start(Profiler& profiler, uint32_t frameIndex);
         void end(uint32_t frameIndex);
-        void endFrame(uint32_t frameIndex);
+        void endFrame(Profiler& profiler, uint32_t frameIndex);
 
-        std::string mName; ///< Nested event name.
+        std::string mName;                        ///< Nested event name.
+        Event* mpParent = nullptr;                ///< Parent event (nullptr for top-level events).
+        NameId mNameId = 0;                       ///< Interned (non-nested) event name.
+        std::vector<Event*> mChildren;            ///< Nested events.
+        uint32_t mFrameRegistered = uint32_t(-1); ///< Frame index the event was last registered for.
 
         float mCpuTime = 0.0; ///< CPU time (previous frame).
         float mGpuTime = 0.0; ///< GPU time (previous frame).
@@ -98,10 +143,8 @@ public:
         float mCpuTimeAverage = -1.f; ///< Average CPU time (negative value to signify invalid).
         float mGpuTimeAverage = -1.f; ///< Average GPU time (negative value to signify invalid).
 
-        std::vector<float> mCpuTimeHistory; ///< CPU time history (round-robin, used for computing stats).
-        std::vector<float> mGpuTimeHistory; ///< GPU time history (round-robin, used for computing stats).
-        size_t mHistoryWriteIndex = 0;      ///< History write index.
-        size_t mHistorySize = 0;            ///< History size.
+        RollingStats mCpuTimeStats; ///< CPU time statistics over the recent history.
+        RollingStats mGpuTimeStats; ///< GPU time statistics over the recent history.
 
         uint32_t mTriggered = 0; ///< Keeping track of nested calls to start().
 
@@ -109,6 +152,7 @@ public:
         {
             CpuTimer::TimePoint cpuStartTime; ///< Last event CPU start time.
             float cpuTotalTime = 0.0;         ///< Total accumulated CPU time.
+            uint64_t traceTimestamp = 0;      ///< Trace timestamp of the first event start in the frame.
 
             std::vector<ref<GpuTimer>> pTimers; ///< Pool of GPU timers.
             size_t currentTimer = 0;            ///< Next GPU timer to use from the pool.
@@ -201,19 +245,54 @@ public:
      */
     bool isCapturing() const;
 
+    /**
+     * Start recording a timeline trace to the global trace recorder.
+     * This enables the profiler. Profiler events, FALCOR_TRACE_SCOPE events on all threads and GPU times are recorded.
+     * Should be called outside of profiler events, e.g. between frames.
+     */
+    void startTrace();
+
+    /**
+     * End recording a timeline trace.
+     * @param[in] path Optional file path to write the trace to in Chrome Trace Event format.
+     */
+    void endTrace(const std::filesystem::path& path = {});
+
+    /**
+     * Check if the profiler is recording a timeline trace.
+     */
+    bool isTracing() const { return TraceRecorder::getGlobal().isRecording(); }
+
     /**
      * Finish profiling for the entire frame.
      * Note: Must be called once at the end of each frame.
      */
     void endFrame(RenderContext* pRenderContext);
 
+    /**
+     * Intern an event name.
+     * Interned names can be used to start and end events without any string processing.
+     * Names are interned into a process-wide table, so IDs are valid for all profilers. This function is thread-safe.
+     * Looking up a name that is already interned doesn't lock, but still hashes the name. Owners of dynamic names
+     * that are profiled every frame (e.g. render passes) should intern them once and pass the ID to FALCOR_PROFILE.
+     * @param[in] name The event name.
+     * @return Returns the interned name ID.
+     */
+    static NameId internName(std::string_view name);
+
+    /**
+     * Get the event name for an interned name ID. This function is thread-safe.
+     */
+    static const std::string& getName(NameId nameId);
+
     /**
      * Start profiling a new event and update the events hierarchies.
      * @param[in] pRenderContext Render context for measuring GPU time.
      * @param[in] name The event name.
      * @param[in] flags The event flags.
      */
-    void startEvent(RenderContext* pRenderContext, const std::string& name, Flags flags = Flags::Default);
+    void startEvent(RenderContext* pRenderContext, std::string_view name, Flags flags = Flags::Default);
+    void startEvent(RenderContext* pRenderContext, NameId nameId, Flags flags = Flags::Default);
 
     /**
      * Finish profiling a new event and update the events hierarchies.
@@ -221,7 +300,8 @@ public:
      * @param[in] name The event name.
      * @param[in] flags The event flags.
      */
-    void endEvent(RenderContext* pRenderContext, const std::string& name, Flags flags = Flags::Default);
+    void endEvent(RenderContext* pRenderContext, std::string_view name, Flags flags = Flags::Default);
+    void endEvent(RenderContext* pRenderContext, NameId nameId, Flags flags = Flags::Default);
 
     /**
      * Get the event, or create a new one if the event does not yet exist.
@@ -237,6 +317,11 @@ public:
      */
     const std::vector<Event*>& getEvents() const { return mLastFrameEvents; }
 
+    /**
+     * Get the time spent in the profiler itself (previous frame).
+     */
+    const Overhead& getOverhead() const { return mOverhead; }
+
     void breakStrongReferenceToDevice();
 
 private:
@@ -254,20 +339,48 @@ private:
      */
     Event* findEvent(const std::string& name);
 
+    /**
+     * Get a nested event, or create a new one if the event does not yet exist.
+     * @param[in] pParent The parent event or nullptr for top-level events.
+     * @param[in] nameId The interned event name.
+     * @return Returns the event.
+     */
+    Event* getChildEvent(Event* pParent, NameId nameId);
+
+    struct NameInfo
+    {
+        const std::string* pName = nullptr; ///< Name in the process-wide table.
+        bool valid = false;                 ///< True if the name is a valid event name.
+    };
+
+    /**
+     * Get the name info for an interned name ID, caching it on first use.
+     */
+    NameInfo getNameInfo(NameId nameId);
+
     BreakableReference<Device> mpDevice;
 
     bool mEnabled = false;
     bool mPaused = false;
 
     std::unordered_map<std::string, std::shared_ptr<Event>> mEvents; ///< Events by name.
+    std::vector<Event*> mRootEvents;                                 ///< Top-level events.
     std::vector<Event*> mCurrentFrameEvents;                         ///< Events registered for current frame.
     std::vector<Event*> mLastFrameEvents;                            ///< Events from last frame.
-    std::string mCurrentEventName;                                   ///< Current nested event name.
-    uint32_t mCurrentLevel = 0;                                      ///< Current nesting level.
+    std::vector<Event*> mEventStack;                                 ///< Stack of currently running events.
     uint32_t mFrameIndex = 0;                                        ///< Current frame index.
 
+    std::vector<NameInfo> mNameInfos; ///< Cached name info by interned name ID.
+
+    Overhead mOverhead;                             ///< Profiler overhead of the previous frame.
+    CpuTimer::TimePoint::duration mOverheadAccum{}; ///< Accumulated profiler overhead in the current frame.
+    uint32_t mOverheadEventCount = 0;               ///< Number of events started in the current frame.
+
     std::shared_ptr<Capture> mpCapture; ///< Currently active capture.
 
+    TraceRecorder::Track mGpuTrack;  ///< Trace track for GPU times (created on first use).
+    uint64_t mTraceFrameStart = 0;   ///< Trace timestamp of the start of the current frame.
+
     ref<Fence> mpFence;
     uint64_t mFenceValue = uint64_t(-1);
 };
@@ -283,21 +396,60 @@ FALCOR_ENUM_CLASS_OPERATORS(Profiler::Flags);
 class FALCOR_API ScopedProfilerEvent
 {
 public:
-    ScopedProfilerEvent(RenderContext* pRenderContext, const std::string& name, Profiler::Flags flags = Profiler::Flags::Default);
+    ScopedProfilerEvent(RenderContext* pRenderContext, std::string_view name, Profiler::Flags flags = Profiler::Flags::Default);
+    ScopedProfilerEvent(RenderContext* pRenderContext, Profiler::NameId nameId, Profiler::Flags flags = Profiler::Flags::Default);
     ~ScopedProfilerEvent();
 
 private:
     RenderContext* mpRenderContext;
-    const std::string mName;
+    Profiler::NameId mNameId;
     Profiler::Flags mFlags;
 };
 } // namespace Falcor
 
+namespace Falcor::detail
+{
+/// True if a profiler event name has constant contents (string literals and const char arrays).
+template<typename T>
+inline constexpr bool kIsConstantProfilerName =
+    std::is_array_v<std::remove_reference_t<T>> && std::is_const_v<std::remove_extent_t<std::remove_reference_t<T>>>;
+
+/**
+ * Intern the name returned by getName.
+ * Every call site passes a lambda of a unique type, so constant names are interned once per call site.
+ * Name IDs that were interned before are passed through.
+ */
+template<typename GetName>
+Profiler::NameId internProfilerName(const GetName& getName)
+{
+    if constexpr (std::is_same_v<std::decay_t<decltype(getName())>, Profiler::NameId>)
+    {
+        return getName();
+    }
+    else if constexpr (kIsConstantProfilerName<decltype(getName())>)
+    {
+        static const Profiler::NameId nameId = Profiler::internName(getName());
+        return nameId;
+    }
+    else
+    {
+        return Profiler::internName(getName());
+    }
+}
+} // namespace Falcor::detail
+
+/**
+ * Intern a profiler event name.
+ * Constant names are interned once per call site. Other names (e.g. std::string) are interned on every call.
+ * A Profiler::NameId is used as is.
+ */
+#define FALCOR_PROFILER_NAME_ID(_name) Falcor::detail::internProfilerName([&]() -> decltype(auto) { return (_name); })
+
 #if FALCOR_ENABLE_PROFILER
 #define FALCOR_PROFILE(_pRenderContext, _name) \
-    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, _name)
+    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, FALCOR_PROFILER_NAME_ID(_name))
 #define FALCOR_PROFILE_CUSTOM(_pRenderContext, _name, _flags) \
-    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, _name, _flags)
+    Falcor::ScopedProfilerEvent FALCOR_CONCAT_STRINGS(_profileEvent, __LINE__)(_pRenderContext, FALCOR_PROFILER_NAME_ID(_name), _flags)
 #else
 #define FALCOR_PROFILE(_pRenderContext, _name)
 #define FALCOR_PROFILE_CUSTOM(_pRenderContext, _name, _flags)
@@ -287,6 +287,10 @@ void ProfilerUI::renderOptions()
             mpProfiler->startCapture();
     }
 
+    const Profiler::Overhead& overhead = mpProfiler->getOverhead();
+    ImGui::SameLine();
+    ImGui::Text("Overhead: %.3f ms (%u events)", mEnableAverage ? overhead.cpuTimeAverage : overhead.cpuTime, overhead.eventCount);
+
     ImGui::Separator();
 }
 
@@ -26,6 +26,7 @@
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
 #include "TimeReport.h"
+#include "TraceRecorder.h"
 #include "Utils/Logger.h"
 #include "Utils/StringUtils.h"
 #include <numeric>
@@ -40,6 +41,7 @@ TimeReport::TimeReport()
 void TimeReport::reset()
 {
     mLastMeasureTime = CpuTimer::getCurrentTimePoint();
+    mLastTraceTimestamp = TraceRecorder::getGlobal().getTimestamp();
     mMeasurements.clear();
     mTotal = 0.0;
 }
@@ -47,6 +49,7 @@ void TimeReport::reset()
 void TimeReport::resetTimer()
 {
     mLastMeasureTime = CpuTimer::getCurrentTimePoint();
+    mLastTraceTimestamp = TraceRecorder::getGlobal().getTimestamp();
     mTotal = 0.0;
 }
 
@@ -67,6 +70,11 @@ void TimeReport::measure(const std::string& name)
     std::chrono::duration<double> duration = currentTime - mLastMeasureTime;
     mLastMeasureTime = currentTime;
     mMeasurements.push_back({name, duration.count()});
+
+    TraceRecorder& recorder = TraceRecorder::getGlobal();
+    uint64_t traceTimestamp = recorder.getTimestamp();
+    recorder.complete(name, mLastTraceTimestamp, traceTimestamp - mLastTraceTimestamp, "time_report");
+    mLastTraceTimestamp = traceTimestamp;
 }
 
 void TimeReport::addTotal(const std::string name)
@@ -28,6 +28,7 @@
 #pragma once
 #include "CpuTimer.h"
 #include "Core/Macros.h"
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -61,6 +62,7 @@ public:
     /**
      * Records a time measurement.
      * Measures time since last call to reset() or measure(), whichever happened more recently.
+     * The measurement is also recorded as an event on the global trace recorder if it is recording.
      * @param[in] name Name of the record.
      */
     void measure(const std::string& name);
@@ -73,6 +75,7 @@ public:
 
 private:
     CpuTimer::TimePoint mLastMeasureTime;
+    uint64_t mLastTraceTimestamp = 0;
     std::vector<std::pair<std::string, double>> mMeasurements;
     double mTotal = 0.0;
 };
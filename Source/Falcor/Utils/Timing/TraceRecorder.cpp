@@ -0,0 +1,508 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "TraceRecorder.h"
+#include "Core/Error.h"
+#include "Utils/StringFormatters.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace Falcor
+{
+namespace
+{
+std::atomic<uint64_t> sNextInstanceId{1};
+
+uint64_t getSteadyClockNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void appendEscaped(std::string& out, std::string_view str)
+{
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (uint8_t(c) < 0x20)
+                out += fmt::format("\\u{:04x}", uint8_t(c));
+            else
+                out += c;
+        }
+    }
+}
+
+void appendTimestamp(std::string& out, uint64_t ns)
+{
+    // Chrome trace timestamps are in microseconds.
+    fmt::format_to(std::back_inserter(out), "{}.{:03}", ns / 1000, ns % 1000);
+}
+
+const char* getPhase(TraceRecorder::EventType type)
+{
+    switch (type)
+    {
+    case TraceRecorder::EventType::Begin:
+        return "B";
+    case TraceRecorder::EventType::End:
+        return "E";
+    case TraceRecorder::EventType::Complete:
+        return "X";
+    case TraceRecorder::EventType::Instant:
+        return "i";
+    case TraceRecorder::EventType::AsyncBegin:
+        return "b";
+    case TraceRecorder::EventType::AsyncEnd:
+        return "e";
+    case TraceRecorder::EventType::FlowBegin:
+        return "s";
+    case TraceRecorder::EventType::FlowStep:
+        return "t";
+    case TraceRecorder::EventType::FlowEnd:
+        return "f";
+    case TraceRecorder::EventType::Counter:
+        return "C";
+    }
+    FALCOR_UNREACHABLE();
+}
+
+/// Per-thread state of all recorders the thread has written to.
+struct ThreadBufferSlot
+{
+    uint64_t instanceId;
+    void* pBuffer;
+};
+thread_local std::vector<ThreadBufferSlot> tThreadBuffers;
+} // namespace
+
+/**
+ * Event buffer of a single thread or virtual track.
+ * Events are stored in a linked list of fixed-size chunks. Only the owning thread appends,
+ * and publishes events with a release store of the chunk count, so readers never block writers.
+ * Virtual tracks may be written from any thread and serialize writers with a mutex.
+ */
+struct TraceRecorder::ThreadBuffer
+{
+    static constexpr uint32_t kChunkSize = 4096;
+
+    struct Chunk
+    {
+        Event events[kChunkSize];
+        std::atomic<uint32_t> count{0};
+        std::atomic<Chunk*> next{nullptr};
+    };
+
+    ThreadBuffer(uint32_t threadId, std::string_view name, bool isTrack) : threadId(threadId), name(name), isTrack(isTrack) {}
+
+    ~ThreadBuffer() { deleteChunks(pHead.load(std::memory_order_relaxed)); }
+
+    static void deleteChunks(Chunk* pChunk)
+    {
+        while (pChunk)
+        {
+            Chunk* pNext = pChunk->next.load(std::memory_order_relaxed);
+            delete pChunk;
+            pChunk = pNext;
+        }
+    }
+
+    const uint32_t threadId;
+    std::string name; ///< Display name, protected by the recorder mutex.
+    const bool isTrack;
+
+    std::atomic<Chunk*> pHead{nullptr};   ///< First chunk, allocated on the first event.
+    Chunk* pTail = nullptr;               ///< Current chunk, only accessed by the writer.
+    std::atomic<size_t> eventCount{0};    ///< Number of recorded events.
+    std::atomic<size_t> chunkCount{0};    ///< Number of allocated chunks.
+    std::atomic<size_t> droppedEvents{0}; ///< Number of events dropped due to the limit.
+    std::mutex trackMutex;                ///< Serializes writers of virtual tracks.
+
+    /// Writer-local cache of interned strings. Keys reference the recorder's string storage.
+    std::unordered_map<std::string_view, uint32_t> stringCache;
+};
+
+template<typename Func>
+void TraceRecorder::forEachEvent(const ThreadBuffer& buffer, Func func) const
+{
+    for (const ThreadBuffer::Chunk* pChunk = buffer.pHead.load(std::memory_order_acquire); pChunk; pChunk = pChunk->next.load(std::memory_order_acquire))
+    {
+        uint32_t count = pChunk->count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+            func(pChunk->events[i]);
+    }
+}
+
+TraceRecorder::TraceRecorder(size_t maxEventsPerThread)
+    : mInstanceId(sNextInstanceId.fetch_add(1)), mMaxEventsPerThread(maxEventsPerThread), mEpoch(getSteadyClockNanoseconds())
+{
+    // String ID 0 is the empty string.
+    mStrings.emplace_back();
+    mStringIds.emplace(mStrings.back(), 0);
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder& TraceRecorder::getGlobal()
+{
+    static TraceRecorder sRecorder;
+    return sRecorder;
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& pBuffer : mBuffers)
+    {
+        // Keep the first chunk to avoid reallocating it.
+        ThreadBuffer::Chunk* pHead = pBuffer->pHead.load();
+        if (pHead)
+        {
+            ThreadBuffer::deleteChunks(pHead->next.exchange(nullptr));
+            pHead->count = 0;
+        }
+        pBuffer->pTail = pHead;
+        pBuffer->eventCount = 0;
+        pBuffer->chunkCount = pHead ? 1 : 0;
+        pBuffer->droppedEvents = 0;
+    }
+}
+
+uint64_t TraceRecorder::getTimestamp() const
+{
+    return getSteadyClockNanoseconds() - mEpoch;
+}
+
+void TraceRecorder::setThreadName(std::string_view name)
+{
+    ThreadBuffer* pBuffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(mMutex);
+    pBuffer->name = name;
+}
+
+TraceRecorder::Track TraceRecorder::createTrack(std::string_view name)
+{
+    return Track{registerBuffer(name, true)->threadId};
+}
+
+void TraceRecorder::begin(std::string_view name, std::string_view category)
+{
+    record(EventType::Begin, name, category, 0);
+}
+
+void TraceRecorder::end()
+{
+    record(EventType::End, {}, {}, 0);
+}
+
+void TraceRecorder::instant(std::string_view name, std::string_view category)
+{
+    record(EventType::Instant, name, category, 0);
+}
+
+void TraceRecorder::complete(std::string_view name, uint64_t startTimestamp, uint64_t duration, std::string_view category)
+{
+    if (!isRecording())
+        return;
+    ThreadBuffer& buffer = *getThreadBuffer();
+    write(buffer, Event{startTimestamp, duration, intern(buffer, name), intern(buffer, category), EventType::Complete});
+}
+
+void TraceRecorder::asyncBegin(std::string_view name, uint64_t id, std::string_view category)
+{
+    record(EventType::AsyncBegin, name, category, id);
+}
+
+void TraceRecorder::asyncEnd(std::string_view name, uint64_t id, std::string_view category)
+{
+    record(EventType::AsyncEnd, name, category, id);
+}
+
+void TraceRecorder::flowBegin(std::string_view name, uint64_t id, std::string_view category)
+{
+    record(EventType::FlowBegin, name, category, id);
+}
+
+void TraceRecorder::flowStep(std::string_view name, uint64_t id, std::string_view category)
+{
+    record(EventType::FlowStep, name, category, id);
+}
+
+void TraceRecorder::flowEnd(std::string_view name, uint64_t id, std::string_view category)
+{
+    record(EventType::FlowEnd, name, category, id);
+}
+
+void TraceRecorder::counter(std::string_view name, double value, std::string_view category)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    record(EventType::Counter, name, category, bits);
+}
+
+void TraceRecorder::complete(Track track, std::string_view name, uint64_t startTimestamp, uint64_t duration, std::string_view category)
+{
+    if (!isRecording())
+        return;
+
+    ThreadBuffer* pBuffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        FALCOR_CHECK(track.id > 0 && track.id <= mBuffers.size() && mBuffers[track.id - 1]->isTrack, "Invalid trace track.");
+        pBuffer = mBuffers[track.id - 1].get();
+    }
+
+    std::lock_guard<std::mutex> lock(pBuffer->trackMutex);
+    write(*pBuffer, Event{startTimestamp, duration, intern(*pBuffer, name), intern(*pBuffer, category), EventType::Complete});
+}
+
+TraceRecorder::Stats TraceRecorder::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats stats;
+    stats.threadCount = mBuffers.size();
+    for (const auto& pBuffer : mBuffers)
+    {
+        stats.eventCount += pBuffer->eventCount.load(std::memory_order_relaxed);
+        stats.droppedEvents += pBuffer->droppedEvents.load(std::memory_order_relaxed);
+        stats.memoryUsage += pBuffer->chunkCount.load(std::memory_order_relaxed) * sizeof(ThreadBuffer::Chunk);
+    }
+    return stats;
+}
+
+std::vector<std::pair<uint32_t, TraceRecorder::Event>> TraceRecorder::getEvents() const
+{
+    std::vector<std::pair<uint32_t, Event>> events;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& pBuffer : mBuffers)
+            forEachEvent(*pBuffer, [&](const Event& event) { events.emplace_back(pBuffer->threadId, event); });
+    }
+
+    // Stable sort to keep the order of events with equal timestamps on the same thread.
+    std::stable_sort(events.begin(), events.end(), [](const auto& a, const auto& b) { return a.second.timestamp < b.second.timestamp; });
+    return events;
+}
+
+std::string TraceRecorder::getString(uint32_t id) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    FALCOR_CHECK(id < mStrings.size(), "Invalid string ID {}.", id);
+    return mStrings[id];
+}
+
+std::string TraceRecorder::toChromeTraceJson() const
+{
+    std::vector<std::pair<uint32_t, Event>> events = getEvents();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::string json;
+    json.reserve(128 + events.size() * 96);
+    json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separator = [&]()
+    {
+        if (!first)
+            json += ",";
+        json += "\n";
+        first = false;
+    };
+
+    // Thread names are recorded as metadata events.
+    for (const auto& pBuffer : mBuffers)
+    {
+        separator();
+        fmt::format_to(std::back_inserter(json), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", pBuffer->threadId);
+        appendEscaped(json, pBuffer->name);
+        json += "\"}}";
+    }
+
+    for (const auto& [threadId, event] : events)
+    {
+        separator();
+        json += "{\"ph\":\"";
+        json += getPhase(event.type);
+        json += "\"";
+        if (event.type != EventType::End)
+        {
+            json += ",\"name\":\"";
+            appendEscaped(json, mStrings[event.nameId]);
+            json += "\",\"cat\":\"";
+            appendEscaped(json, mStrings[event.categoryId]);
+            json += "\"";
+        }
+        fmt::format_to(std::back_inserter(json), ",\"pid\":1,\"tid\":{},\"ts\":", threadId);
+        appendTimestamp(json, event.timestamp);
+
+        switch (event.type)
+        {
+        case EventType::Complete:
+            json += ",\"dur\":";
+            appendTimestamp(json, event.value);
+            break;
+        case EventType::Instant:
+            json += ",\"s\":\"t\"";
+            break;
+        case EventType::AsyncBegin:
+        case EventType::AsyncEnd:
+            fmt::format_to(std::back_inserter(json), ",\"id\":\"0x{:x}\"", event.value);
+            break;
+        case EventType::FlowBegin:
+        case EventType::FlowStep:
+            fmt::format_to(std::back_inserter(json), ",\"id\":{}", event.value);
+            break;
+        case EventType::FlowEnd:
+            // Bind the flow end to the enclosing slice.
+            fmt::format_to(std::back_inserter(json), ",\"id\":{},\"bp\":\"e\"", event.value);
+            break;
+        case EventType::Counter:
+        {
+            double value;
+            std::memcpy(&value, &event.value, sizeof(value));
+            fmt::format_to(std::back_inserter(json), ",\"args\":{{\"value\":{}}}", value);
+            break;
+        }
+        default:
+            break;
+        }
+        json += "}";
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+
+void TraceRecorder::writeChromeTrace(const std::filesystem::path& path) const
+{
+    std::string json = toChromeTraceJson();
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs)
+        FALCOR_THROW("Failed to open '{}' for writing.", path);
+    ofs.write(json.data(), json.size());
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+{
+    for (const auto& slot : tThreadBuffers)
+        if (slot.instanceId == mInstanceId)
+            return static_cast<ThreadBuffer*>(slot.pBuffer);
+
+    ThreadBuffer* pBuffer = registerBuffer({}, false);
+    tThreadBuffers.push_back({mInstanceId, pBuffer});
+    return pBuffer;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::registerBuffer(std::string_view name, bool isTrack)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    uint32_t threadId = uint32_t(mBuffers.size() + 1);
+    std::string displayName = name.empty() ? fmt::format("Thread {}", threadId) : std::string(name);
+    mBuffers.push_back(std::make_unique<ThreadBuffer>(threadId, displayName, isTrack));
+    return mBuffers.back().get();
+}
+
+uint32_t TraceRecorder::intern(ThreadBuffer& buffer, std::string_view str)
+{
+    if (str.empty())
+        return 0;
+
+    // Fast path without locking.
+    if (auto it = buffer.stringCache.find(str); it != buffer.stringCache.end())
+        return it->second;
+
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mStringIds.find(str);
+        if (it == mStringIds.end())
+        {
+            id = uint32_t(mStrings.size());
+            mStrings.emplace_back(str);
+            it = mStringIds.emplace(mStrings.back(), id).first;
+        }
+        id = it->second;
+        buffer.stringCache.emplace(it->first, id);
+    }
+    return id;
+}
+
+void TraceRecorder::write(ThreadBuffer& buffer, const Event& event)
+{
+    if (buffer.eventCount.load(std::memory_order_relaxed) >= mMaxEventsPerThread)
+    {
+        buffer.droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ThreadBuffer::Chunk* pChunk = buffer.pTail;
+    uint32_t count = pChunk ? pChunk->count.load(std::memory_order_relaxed) : ThreadBuffer::kChunkSize;
+    if (count == ThreadBuffer::kChunkSize)
+    {
+        auto pNext = new ThreadBuffer::Chunk();
+        if (pChunk)
+            pChunk->next.store(pNext, std::memory_order_release);
+        else
+            buffer.pHead.store(pNext, std::memory_order_release);
+        buffer.pTail = pNext;
+        buffer.chunkCount.store(buffer.chunkCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        pChunk = pNext;
+        count = 0;
+    }
+
+    pChunk->events[count] = event;
+    pChunk->count.store(count + 1, std::memory_order_release);
+    // Counters only have a single writer, so no atomic read-modify-write is needed.
+    buffer.eventCount.store(buffer.eventCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(EventType type, std::string_view name, std::string_view category, uint64_t value)
+{
+    if (!isRecording())
+        return;
+
+    ThreadBuffer& buffer = *getThreadBuffer();
+    write(buffer, Event{getTimestamp(), value, intern(buffer, name), intern(buffer, category), type});
+}
+
+} // namespace Falcor
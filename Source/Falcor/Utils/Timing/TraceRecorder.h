@@ -0,0 +1,252 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#pragma once
+#include "Core/Macros.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Falcor
+{
+/**
+ * Low-overhead recorder for timeline traces.
+ *
+ * Events are written to per-thread buffers without locking and carry nanosecond timestamps.
+ * The recorded trace is exported in the Chrome Trace Event format, which can be loaded in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Supported events:
+ * - Scoped begin/end events (see FALCOR_TRACE_SCOPE), nested per thread.
+ * - Complete events with explicit start time and duration.
+ * - Instant events.
+ * - Async events, which may begin and end on different threads (e.g. background tasks).
+ * - Flow events, which connect events across threads.
+ * - Counter events.
+ *
+ * Recording from any number of threads is thread-safe. Buffers are owned by the recorder and
+ * outlive the threads that wrote them. clear() must not be called while other threads are recording.
+ */
+class FALCOR_API TraceRecorder
+{
+public:
+    enum class EventType : uint8_t
+    {
+        Begin,
+        End,
+        Complete,
+        Instant,
+        AsyncBegin,
+        AsyncEnd,
+        FlowBegin,
+        FlowStep,
+        FlowEnd,
+        Counter,
+    };
+
+    /// Recorded event. Names and categories are interned and referenced by ID.
+    struct Event
+    {
+        uint64_t timestamp = 0; ///< Timestamp in nanoseconds since the recorder was created.
+        uint64_t value = 0;     ///< Duration in nanoseconds (complete), ID (async/flow) or bit-cast double (counter).
+        uint32_t nameId = 0;
+        uint32_t categoryId = 0;
+        EventType type = EventType::Instant;
+    };
+
+    /// Virtual track used for events that do not originate from a CPU thread (e.g. GPU timings).
+    struct Track
+    {
+        uint32_t id = 0;
+    };
+
+    struct Stats
+    {
+        size_t threadCount = 0;   ///< Number of threads (and virtual tracks) that recorded events.
+        size_t eventCount = 0;    ///< Number of recorded events.
+        size_t droppedEvents = 0; ///< Number of events dropped due to the per-thread limit.
+        size_t memoryUsage = 0;   ///< Memory used by event buffers in bytes.
+    };
+
+    /**
+     * Constructor.
+     * @param[in] maxEventsPerThread Maximum number of events recorded per thread. Further events are dropped.
+     */
+    TraceRecorder(size_t maxEventsPerThread = 1 << 22);
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * Get the global trace recorder used by FALCOR_TRACE_* macros and the profiler.
+     */
+    static TraceRecorder& getGlobal();
+
+    /**
+     * Start/stop recording. Events are ignored while not recording.
+     */
+    void setRecording(bool recording) { mRecording.store(recording, std::memory_order_relaxed); }
+    bool isRecording() const { return mRecording.load(std::memory_order_relaxed); }
+
+    /**
+     * Remove all recorded events. Must not be called while other threads are recording.
+     */
+    void clear();
+
+    /**
+     * Get the current timestamp in nanoseconds since the recorder was created.
+     */
+    uint64_t getTimestamp() const;
+
+    /**
+     * Get a new unique ID for async and flow events.
+     */
+    uint64_t newId() { return mNextId.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Set the display name of the calling thread.
+     */
+    void setThreadName(std::string_view name);
+
+    /**
+     * Create a virtual track for events not tied to a CPU thread.
+     * @param[in] name Track name.
+     * @return Returns the track.
+     */
+    Track createTrack(std::string_view name);
+
+    void begin(std::string_view name, std::string_view category = {});
+    void end();
+    void instant(std::string_view name, std::string_view category = {});
+    void complete(std::string_view name, uint64_t startTimestamp, uint64_t duration, std::string_view category = {});
+    void asyncBegin(std::string_view name, uint64_t id, std::string_view category = {});
+    void asyncEnd(std::string_view name, uint64_t id, std::string_view category = {});
+    void flowBegin(std::string_view name, uint64_t id, std::string_view category = {});
+    void flowStep(std::string_view name, uint64_t id, std::string_view category = {});
+    void flowEnd(std::string_view name, uint64_t id, std::string_view category = {});
+    void counter(std::string_view name, double value, std::string_view category = {});
+
+    /**
+     * Record a complete event on a virtual track.
+     */
+    void complete(Track track, std::string_view name, uint64_t startTimestamp, uint64_t duration, std::string_view category = {});
+
+    /**
+     * Get recording statistics.
+     */
+    Stats getStats() const;
+
+    /**
+     * Get the recorded events of all threads sorted by timestamp.
+     * Each entry holds the thread ID and the event.
+     */
+    std::vector<std::pair<uint32_t, Event>> getEvents() const;
+
+    /**
+     * Get the interned string for a name or category ID.
+     */
+    std::string getString(uint32_t id) const;
+
+    /**
+     * Export the trace in Chrome Trace Event JSON format.
+     */
+    std::string toChromeTraceJson() const;
+
+    /**
+     * Write the trace in Chrome Trace Event JSON format to a file.
+     * @param[in] path File path.
+     */
+    void writeChromeTrace(const std::filesystem::path& path) const;
+
+private:
+    struct ThreadBuffer;
+
+    ThreadBuffer* getThreadBuffer();
+    ThreadBuffer* registerBuffer(std::string_view name, bool isTrack);
+    uint32_t intern(ThreadBuffer& buffer, std::string_view str);
+    void write(ThreadBuffer& buffer, const Event& event);
+    void record(EventType type, std::string_view name, std::string_view category, uint64_t value);
+    template<typename Func>
+    void forEachEvent(const ThreadBuffer& buffer, Func func) const;
+
+    const uint64_t mInstanceId;
+    const size_t mMaxEventsPerThread;
+    const uint64_t mEpoch;
+
+    std::atomic<bool> mRecording{false};
+    std::atomic<uint64_t> mNextId{1};
+
+    mutable std::mutex mMutex;                           ///< Protects the members below.
+    std::vector<std::unique_ptr<ThreadBuffer>> mBuffers; ///< Per-thread and virtual track buffers.
+    std::deque<std::string> mStrings;                    ///< Interned strings by ID (deque keeps references stable).
+    std::unordered_map<std::string_view, uint32_t> mStringIds;
+};
+
+/**
+ * Helper class for recording begin/end trace events on the global recorder using RAII.
+ * The end event is recorded only if the begin event was, so scopes stay balanced when recording is toggled.
+ */
+class FALCOR_API ScopedTraceEvent
+{
+public:
+    ScopedTraceEvent(std::string_view name, std::string_view category = {})
+    {
+        TraceRecorder& recorder = TraceRecorder::getGlobal();
+        if (recorder.isRecording())
+        {
+            mActive = true;
+            recorder.begin(name, category);
+        }
+    }
+
+    ~ScopedTraceEvent()
+    {
+        if (mActive)
+            TraceRecorder::getGlobal().end();
+    }
+
+private:
+    bool mActive = false;
+};
+} // namespace Falcor
+
+#if FALCOR_ENABLE_PROFILER
+#define FALCOR_TRACE_SCOPE(_name) Falcor::ScopedTraceEvent FALCOR_CONCAT_STRINGS(_traceEvent, __LINE__)(_name)
+#define FALCOR_TRACE_SCOPE_CATEGORY(_name, _category) \
+    Falcor::ScopedTraceEvent FALCOR_CONCAT_STRINGS(_traceEvent, __LINE__)(_name, _category)
+#else
+#define FALCOR_TRACE_SCOPE(_name)
+#define FALCOR_TRACE_SCOPE_CATEGORY(_name, _category)
+#endif
@@ -79,6 +79,20 @@ public:
         mIndices.push_back(iter->second);
         return insertedNew;
     }
+
+    /**
+     * @brief Reserve storage.
+     *
+     * @param[in] indexCount Expected number of appended items.
+     * @param[in] valueCount Expected number of unique items.
+     */
+    void reserve(size_t indexCount, size_t valueCount)
+    {
+        mIndexMap.reserve(valueCount);
+        mValues.reserve(valueCount);
+        mIndices.reserve(indexCount);
+    }
+
     /**
      * @brief Get the set of unique data items.
      */
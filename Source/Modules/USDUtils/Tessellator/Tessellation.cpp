@@ -28,9 +28,16 @@
 #include "Tessellation.h"
 #include "Core/Error.h"
 #include "Utils/Logger.h"
+#include "Utils/Math/Common.h"
 #include "Utils/Math/FNVHash.h"
 #include "IndexedVector.h"
 
+#include <fstd/span.h>
+#include <algorithm>
+#include <limits>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
 #include <opensubdiv/far/topologyDescriptor.h>
 #include <opensubdiv/far/stencilTableFactory.h>
 #include <opensubdiv/sdc/options.h>
@@ -49,6 +56,10 @@ namespace Falcor
 namespace
 {
 
+// Number of coarse faces tessellated per parallel task.
+const uint32_t kFacesPerChunk = 1024;
+const uint32_t kInvalidFace = std::numeric_limits<uint32_t>::max();
+
 struct GfVec2fHash
 {
     size_t operator()(const GfVec2f& v) const
@@ -80,13 +91,16 @@ class MeshIndexer
 public:
     MeshIndexer(const TfToken& uvInterp) : mUVInterp(uvInterp) {}
 
+    // Reserve storage for the given number of output indices and unique vertices.
+    void reserve(size_t indexCount, size_t vertexCount)
+    {
+        mPositionSet.reserve(0, vertexCount);
+        mIndices.reserve(indexCount);
+        mNormals.reserve(vertexCount);
+    }
+
     // Add a face's worth of facets to the mesh. Assumes that the facets are triangles.
-    void addFacets(
-        const std::vector<int>& indices,
-        const std::vector<float>& positions,
-        const std::vector<float>& normals,
-        const std::vector<float>& uvs
-    )
+    void addFacets(fstd::span<const int> indices, fstd::span<const float> positions, fstd::span<const float> normals, fstd::span<const float> uvs)
     {
         FALCOR_ASSERT((indices.size() % 3) == 0);
 
@@ -222,89 +236,131 @@ UsdMeshData triangulate(const pxr::UsdGeomMesh& geomMesh, const UsdMeshData& bas
     std::sort(sortedHoleIndices.begin(), sortedHoleIndices.end());
     const uint32_t holeFaceCount = sortedHoleIndices.size();
 
-    VtIntArray outFaceIndices;
-
     int next[2] = {1, 2};
     if (leftHanded)
         std::swap(next[0], next[1]);
 
-    // Triangulate each face, f
-    // vertIdx is the offset into faceIndices to the first vertex index for the current face
+    // Count the triangles generated by each face and compute the output offsets with an exclusive prefix sum.
+    // This allows the output to be preallocated and the faces to be triangulated in parallel, with the output
+    // ordered exactly as if the faces were processed sequentially.
+    std::vector<uint32_t> vertexOffsets(faceCount);
+    std::vector<uint32_t> triangleOffsets(faceCount + 1);
+    triangleOffsets[0] = 0;
     for (uint32_t f = 0, vertIdx = 0, holeIdx = 0; f < faceCount; vertIdx += faceCounts[f], ++f)
     {
         uint32_t vertexCount = faceCounts[f];
+        uint32_t triangleCount = vertexCount >= 3 ? vertexCount - 2 : 0; // Skip degenerate faces
 
         if (holeIdx < holeFaceCount && sortedHoleIndices[holeIdx] == f)
         {
             // This face is a hole face; skip it.
             ++holeIdx;
-            continue;
-        }
-        else if (vertexCount < 3)
-        {
-            // Skip degenerate faces
-            continue;
+            triangleCount = 0;
         }
 
-        GfVec3f flatNormal = {};
-        if (generateNormals)
+        vertexOffsets[f] = vertIdx;
+        triangleOffsets[f + 1] = triangleOffsets[f] + triangleCount;
+    }
+    const uint32_t totalTriangleCount = triangleOffsets[faceCount];
+
+    // Number of per-triangle normals and uvs in the output. Vertex and varying attributes are indexed along with
+    // the corresponding vertex, so we can simply re-use the base mesh values.
+    // Uniform and face-varying attributes are not indexed, so we output a copy for each triangle.
+    uint32_t normalsPerTriangle = 0;
+    if (generateNormals || baseMesh.normalInterp == UsdGeomTokens->uniform)
+        normalsPerTriangle = 1;
+    else if (baseMesh.normalInterp == UsdGeomTokens->faceVarying)
+        normalsPerTriangle = 3;
+
+    uint32_t uvsPerTriangle = 0;
+    if (baseMesh.uvInterp == UsdGeomTokens->uniform)
+        uvsPerTriangle = 1;
+    else if (baseMesh.uvInterp == UsdGeomTokens->faceVarying)
+        uvsPerTriangle = 3;
+
+    VtIntArray outFaceIndices(3 * size_t(totalTriangleCount));
+    if (normalsPerTriangle > 0)
+        outNormals.resize(normalsPerTriangle * size_t(totalTriangleCount));
+    if (uvsPerTriangle > 0)
+        outUVs.resize(uvsPerTriangle * size_t(totalTriangleCount));
+    const size_t coarseFaceOffset = coarseFaceIndices.size();
+    coarseFaceIndices.resize(coarseFaceOffset + totalTriangleCount);
+
+    // Get raw pointers up front, as the non-const VtArray accessors are not thread-safe.
+    int* pOutFaceIndices = outFaceIndices.data();
+    GfVec3f* pOutNormals = outNormals.data();
+    GfVec2f* pOutUVs = outUVs.data();
+    int* pCoarseFaceIndices = coarseFaceIndices.data() + coarseFaceOffset;
+
+    // Triangulate each face, f, in parallel.
+    // vertIdx is the offset into faceIndices to the first vertex index for the current face
+    tbb::parallel_for<uint32_t>(
+        0,
+        faceCount,
+        [&](uint32_t f)
         {
-            // Generate a uniform (per-original-face) normal to use for each triangle we generate.
-            const GfVec3f& v0 = baseMesh.points[faceIndices[vertIdx]];
-            for (uint32_t j = 0; j < vertexCount - 2; ++j)
-            {
-                const GfVec3f& v1 = baseMesh.points[faceIndices[vertIdx + j + next[0]]];
-                const GfVec3f& v2 = baseMesh.points[faceIndices[vertIdx + j + next[1]]];
-                flatNormal += GfCross(v1 - v0, v2 - v0);
-            }
-            GfNormalize(&flatNormal);
-        }
+            const uint32_t vertIdx = vertexOffsets[f];
+            const uint32_t triangleOffset = triangleOffsets[f];
+            const uint32_t triangleCount = triangleOffsets[f + 1] - triangleOffset;
+            if (triangleCount == 0)
+                return;
 
-        for (uint32_t v = 0; v < vertexCount - 2; ++v)
-        {
-            // Append a triplet of face indices, thereby adding a new triangle to the output.
-            // As we do so, append copies of any uniform or face-varying attributes to their respective
-            // outputs, since they are not indexed.
-            // In the case of vertex and varying attributes, we can simply re-use the base mesh values, since
-            // they are indexed along with the corresponding vertex.
-            outFaceIndices.push_back(faceIndices[vertIdx]);
-            outFaceIndices.push_back(faceIndices[vertIdx + v + next[0]]);
-            outFaceIndices.push_back(faceIndices[vertIdx + v + next[1]]);
-
-            if (baseMesh.normalInterp == UsdGeomTokens->faceVarying)
+            GfVec3f flatNormal = {};
+            if (generateNormals)
             {
-                outNormals.push_back(baseMesh.normals[vertIdx]);
-                outNormals.push_back(baseMesh.normals[vertIdx + v + next[0]]);
-                outNormals.push_back(baseMesh.normals[vertIdx + v + next[1]]);
+                // Generate a uniform (per-original-face) normal to use for each triangle we generate.
+                const GfVec3f& v0 = baseMesh.points[faceIndices[vertIdx]];
+                for (uint32_t j = 0; j < triangleCount; ++j)
+                {
+                    const GfVec3f& v1 = baseMesh.points[faceIndices[vertIdx + j + next[0]]];
+                    const GfVec3f& v2 = baseMesh.points[faceIndices[vertIdx + j + next[1]]];
+                    flatNormal += GfCross(v1 - v0, v2 - v0);
+                }
+                GfNormalize(&flatNormal);
             }
 
-            if (baseMesh.uvInterp == UsdGeomTokens->faceVarying)
+            for (uint32_t v = 0; v < triangleCount; ++v)
             {
-                outUVs.push_back(baseMesh.uvs[vertIdx]);
-                outUVs.push_back(baseMesh.uvs[vertIdx + v + next[0]]);
-                outUVs.push_back(baseMesh.uvs[vertIdx + v + next[1]]);
-            }
+                // Write a triplet of face indices, thereby adding a new triangle to the output.
+                // As we do so, write copies of any uniform or face-varying attributes to their respective
+                // outputs, since they are not indexed.
+                const uint32_t t = triangleOffset + v;
+                const uint32_t corners[3] = {vertIdx, vertIdx + v + next[0], vertIdx + v + next[1]};
 
-            if (generateNormals)
-            {
-                // Append the generated flat normal to the output
-                outNormals.push_back(flatNormal);
-            }
-            else if (baseMesh.normalInterp == UsdGeomTokens->uniform)
-            {
-                // Copy the appropriate input uniform normal to the output
-                outNormals.push_back(baseMesh.normals[f]);
-            }
+                for (uint32_t i = 0; i < 3; ++i)
+                    pOutFaceIndices[3 * t + i] = faceIndices[corners[i]];
 
-            if (baseMesh.uvInterp == UsdGeomTokens->uniform)
-            {
-                // Copy the appropriate input uniform uv to the output
-                outUVs.push_back(baseMesh.uvs[f]);
-            }
+                if (generateNormals)
+                {
+                    // Write the generated flat normal to the output
+                    pOutNormals[t] = flatNormal;
+                }
+                else if (baseMesh.normalInterp == UsdGeomTokens->faceVarying)
+                {
+                    for (uint32_t i = 0; i < 3; ++i)
+                        pOutNormals[3 * t + i] = baseMesh.normals[corners[i]];
+                }
+                else if (baseMesh.normalInterp == UsdGeomTokens->uniform)
+                {
+                    // Copy the appropriate input uniform normal to the output
+                    pOutNormals[t] = baseMesh.normals[f];
+                }
+
+                if (baseMesh.uvInterp == UsdGeomTokens->faceVarying)
+                {
+                    for (uint32_t i = 0; i < 3; ++i)
+                        pOutUVs[3 * t + i] = baseMesh.uvs[corners[i]];
+                }
+                else if (baseMesh.uvInterp == UsdGeomTokens->uniform)
+                {
+                    // Copy the appropriate input uniform uv to the output
+                    pOutUVs[t] = baseMesh.uvs[f];
+                }
 
-            coarseFaceIndices.push_back(f);
+                pCoarseFaceIndices[t] = f;
+            }
         }
-    }
+    );
 
     UsdMeshData tessellatedMesh;
     tessellatedMesh.topology.scheme = UsdGeomTokens->none;
@@ -325,6 +381,8 @@ UsdMeshData triangulate(const pxr::UsdGeomMesh& geomMesh, const UsdMeshData& bas
  *
  * If refinement (subdivision) is to be applied, OpenSubdiv is used to evalute the surface and related attributes.
  * If no refinement is to be applied, we use a simple vertex-order-perserving triangulation scheme instead.
+ *
+ * In both cases the faces are processed in parallel, and the output is identical to processing them sequentially.
  */
 UsdMeshData tessellate(
     const pxr::UsdGeomMesh& geomMesh,
@@ -430,19 +488,6 @@ UsdMeshData tessellate(
     std::unique_ptr<Far::TopologyRefiner> refiner(Far::TopologyRefinerFactory<Far::TopologyDescriptor>::Create(desc, refinerOptions));
 
     SurfaceFactory::Options surfaceOptions;
-    SurfaceFactory surfaceFactory(*refiner, surfaceOptions);
-
-    Surface vertexSurface;
-    Surface varyingSurface;
-    Surface fvarSurface;
-
-    std::vector<float> facePatchPoints;
-    std::vector<float> outCoords;
-    std::vector<float> outPos;
-    std::vector<float> outDu, outDv;
-    std::vector<float> outNormals;
-    std::vector<float> outUV;
-    std::vector<int> outFacets;
 
     Bfr::Tessellation::Options tessOptions;
     // Facet size 3 => triangulate
@@ -454,107 +499,228 @@ UsdMeshData tessellate(
     // the subdivision process, as per the USD spec. As such, any authored normals are ignored.
     // Further, we do not need to handle e.g., face-varying or uniform normals here.
 
-    MeshIndexer meshIndexer(uvInterp);
-
-    const uint32_t faceCount = surfaceFactory.GetNumFaces();
+    const uint32_t faceCount = refiner->GetLevel(0).GetNumFaces();
 
     coarseFaceIndices.clear();
 
-    bool createVaryingSurf = false;
-
-    Surface* uvSurface = nullptr;
-    if (uvInterp == UsdGeomTokens->faceVarying)
-        uvSurface = &fvarSurface;
-    else if (uvInterp == UsdGeomTokens->vertex)
-        uvSurface = &vertexSurface;
-    else if (uvInterp == UsdGeomTokens->varying)
-    {
-        uvSurface = &varyingSurface;
-        createVaryingSurf = true;
-    }
+    bool createVaryingSurf = uvInterp == UsdGeomTokens->varying;
 
     // Face-varying UVs always have ID of 0. It's safe to set this, and to create the face-varying surface,
     // even if UVs aren't provided.
     FVarID fvarID = 0;
 
-    for (uint32_t f = 0; f < faceCount; ++f)
+    // Tessellation results for a contiguous range of coarse faces.
+    struct FaceChunk
     {
-        surfaceFactory.InitSurfaces(
-            f, &vertexSurface, &fvarSurface, &fvarID, desc.numFVarChannels, createVaryingSurf ? &varyingSurface : nullptr
-        );
-        if (!vertexSurface.IsValid())
-            continue;
-        // Fall back to using vertex surface if the uv surface is invalid for whatever reason.
-        if (uvSurface && !uvSurface->IsValid())
-            uvSurface = &vertexSurface;
-
-        Bfr::Tessellation tessPattern(vertexSurface.GetParameterization(), tessellationRate, tessOptions);
+        struct Face
+        {
+            uint32_t coarseFace; ///< Index of the coarse face.
+            uint32_t coordCount; ///< Number of tessellated vertices.
+            uint32_t facetCount; ///< Number of triangles.
+            uint32_t uvSize;     ///< Number of uv floats.
+        };
+        std::vector<Face> faces;
+        std::vector<int> facets;
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> uvs;
+        uint32_t uvFallbackFace = kInvalidFace; ///< First face in the chunk at which uvs fell back to the vertex surface.
+    };
+
+    // The surface factory caches patch topology and is not thread-safe, so we create one per thread.
+    // The topology refiner itself is only read and is shared between threads.
+    tbb::enumerable_thread_specific<std::unique_ptr<SurfaceFactory>> threadSurfaceFactories;
+
+    // Evaluate the surfaces of all faces in parallel, in chunks of consecutive faces.
+    // Each chunk writes to its own storage such that the results can be merged in face order below,
+    // which makes the output identical to a sequential evaluation.
+    const uint32_t chunkCount = div_round_up(faceCount, kFacesPerChunk);
+    std::vector<FaceChunk> chunks(chunkCount);
+
+    // Evaluate a chunk. Uvs of faces starting at uvFallbackFace are evaluated on the vertex surface.
+    auto evaluateChunk = [&](uint32_t chunkIndex, uint32_t uvFallbackFace)
+    {
+        auto& pSurfaceFactory = threadSurfaceFactories.local();
+        if (!pSurfaceFactory)
+            pSurfaceFactory = std::make_unique<SurfaceFactory>(*refiner, surfaceOptions);
 
-        const int outCoordCount = tessPattern.GetNumCoords();
+        FaceChunk& chunk = chunks[chunkIndex];
+        chunk = FaceChunk();
 
-        outCoords.resize(outCoordCount * 2);
-        tessPattern.GetCoords(outCoords.data());
+        Surface vertexSurface;
+        Surface varyingSurface;
+        Surface fvarSurface;
 
-        outNormals.resize(outCoordCount * 3);
-        outPos.resize(outCoordCount * 3);
-        outDu.resize(outCoordCount * 3);
-        outDv.resize(outCoordCount * 3);
+        std::vector<float> facePatchPoints;
+        std::vector<float> outCoords;
 
-        if (uvSurface)
+        const uint32_t faceEnd = std::min(faceCount, (chunkIndex + 1) * kFacesPerChunk);
+        for (uint32_t f = chunkIndex * kFacesPerChunk; f < faceEnd; ++f)
         {
-            const int pointSize = 2;
-            facePatchPoints.resize(uvSurface->GetNumPatchPoints() * pointSize);
-            outUV.resize(outCoordCount * pointSize);
-            uvSurface->PreparePatchPoints(uvData, pointSize, facePatchPoints.data(), pointSize);
-            for (int i = 0, j = 0; i < outCoordCount; ++i, j += pointSize)
+            pSurfaceFactory->InitSurfaces(
+                f, &vertexSurface, &fvarSurface, &fvarID, desc.numFVarChannels, createVaryingSurf ? &varyingSurface : nullptr
+            );
+            if (!vertexSurface.IsValid())
+                continue;
+
+            Surface* uvSurface = nullptr;
+            if (uvInterp == UsdGeomTokens->faceVarying)
+                uvSurface = &fvarSurface;
+            else if (uvInterp == UsdGeomTokens->vertex)
+                uvSurface = &vertexSurface;
+            else if (uvInterp == UsdGeomTokens->varying)
+                uvSurface = &varyingSurface;
+
+            // Fall back to using vertex surface if the uv surface is invalid for whatever reason.
+            // As in a sequential evaluation, the fallback is kept for all subsequent faces.
+            if (uvSurface && f < uvFallbackFace && !uvSurface->IsValid())
             {
-                uvSurface->Evaluate(&outCoords[i * 2], facePatchPoints.data(), pointSize, &outUV[j]);
+                uvFallbackFace = f;
+                chunk.uvFallbackFace = f;
             }
+            if (uvSurface && f >= uvFallbackFace)
+                uvSurface = &vertexSurface;
+
+            Bfr::Tessellation tessPattern(vertexSurface.GetParameterization(), tessellationRate, tessOptions);
+
+            const int outCoordCount = tessPattern.GetNumCoords();
+            const int facetCount = tessPattern.GetNumFacets();
+
+            outCoords.resize(outCoordCount * 2);
+            tessPattern.GetCoords(outCoords.data());
+
+            FaceChunk::Face face = {f, uint32_t(outCoordCount), uint32_t(facetCount), 0};
+
+            if (uvSurface)
+            {
+                const int pointSize = 2;
+                const size_t uvOffset = chunk.uvs.size();
+                face.uvSize = outCoordCount * pointSize;
+                chunk.uvs.resize(uvOffset + face.uvSize);
+                facePatchPoints.resize(uvSurface->GetNumPatchPoints() * pointSize);
+                uvSurface->PreparePatchPoints(uvData, pointSize, facePatchPoints.data(), pointSize);
+                for (int i = 0, j = 0; i < outCoordCount; ++i, j += pointSize)
+                {
+                    uvSurface->Evaluate(&outCoords[i * 2], facePatchPoints.data(), pointSize, &chunk.uvs[uvOffset + j]);
+                }
+            }
+            else if (uvInterp == UsdGeomTokens->uniform)
+            {
+                face.uvSize = 2;
+                chunk.uvs.push_back(baseMesh.uvs[f][0]);
+                chunk.uvs.push_back(baseMesh.uvs[f][1]);
+            }
+
+            const int pointSize = 3;
+            const size_t vertexOffset = chunk.positions.size();
+            chunk.positions.resize(vertexOffset + outCoordCount * pointSize);
+            chunk.normals.resize(vertexOffset + outCoordCount * pointSize);
+
+            facePatchPoints.resize(vertexSurface.GetNumPatchPoints() * pointSize);
+            vertexSurface.PreparePatchPoints((float*)baseMesh.points.data(), pointSize, facePatchPoints.data(), pointSize);
+            {
+                float3 du;
+                float3 dv;
+
+                // Compute positions and normals
+                size_t j = vertexOffset;
+                for (int i = 0; i < outCoordCount; ++i, j += pointSize)
+                {
+                    vertexSurface.Evaluate(
+                        &outCoords[i * 2],
+                        facePatchPoints.data(),
+                        pointSize,
+                        &chunk.positions[j],
+                        reinterpret_cast<float*>(&du),
+                        reinterpret_cast<float*>(&dv)
+                    );
+                    // Use the partials to construct a normal vector.
+                    float3 normal = normalize(cross(du, dv));
+                    if (leftHanded)
+                        normal = -normal;
+                    chunk.normals[j + 0] = normal.x;
+                    chunk.normals[j + 1] = normal.y;
+                    chunk.normals[j + 2] = normal.z;
+                }
+            }
+
+            const size_t facetOffset = chunk.facets.size();
+            chunk.facets.resize(facetOffset + facetCount * 3);
+            tessPattern.GetFacets(chunk.facets.data() + facetOffset);
+
+            chunk.faces.push_back(face);
         }
-        else if (uvInterp == UsdGeomTokens->uniform)
-        {
-            outUV.resize(2);
-            outUV[0] = baseMesh.uvs[f][0];
-            outUV[1] = baseMesh.uvs[f][1];
-        }
+    };
 
-        const int pointSize = 3;
-        facePatchPoints.resize(vertexSurface.GetNumPatchPoints() * pointSize);
-        vertexSurface.PreparePatchPoints((float*)baseMesh.points.data(), pointSize, facePatchPoints.data(), pointSize);
-        {
-            float3 du;
-            float3 dv;
+    tbb::parallel_for<uint32_t>(0, chunkCount, [&](uint32_t chunkIndex) { evaluateChunk(chunkIndex, kInvalidFace); });
+
+    // If the uvs of a face fell back to the vertex surface, all later faces use the fallback too.
+    // Chunks after the first fallback were evaluated without it and are evaluated again. This only happens for invalid uv data.
+    auto firstFallbackChunk =
+        std::find_if(chunks.begin(), chunks.end(), [](const FaceChunk& chunk) { return chunk.uvFallbackFace != kInvalidFace; });
+    if (firstFallbackChunk != chunks.end())
+    {
+        const uint32_t uvFallbackFace = firstFallbackChunk->uvFallbackFace;
+        tbb::parallel_for<uint32_t>(
+            uint32_t(firstFallbackChunk - chunks.begin()) + 1,
+            chunkCount,
+            [&](uint32_t chunkIndex) { evaluateChunk(chunkIndex, uvFallbackFace); }
+        );
+    }
 
-            // Compute positions and normals
-            for (int i = 0, j = 0; i < outCoordCount; ++i, j += pointSize)
+    // Compute the output offset of each chunk with an exclusive prefix sum, and preallocate the output.
+    std::vector<size_t> chunkFacetOffsets(chunkCount + 1, 0);
+    size_t totalVertexCount = 0;
+    for (uint32_t c = 0; c < chunkCount; ++c)
+    {
+        chunkFacetOffsets[c + 1] = chunkFacetOffsets[c] + chunks[c].facets.size() / 3;
+        totalVertexCount += chunks[c].positions.size() / 3;
+    }
+
+    coarseFaceIndices.resize(chunkFacetOffsets[chunkCount]);
+    int* pCoarseFaceIndices = coarseFaceIndices.data();
+
+    tbb::parallel_for<uint32_t>(
+        0,
+        chunkCount,
+        [&](uint32_t c)
+        {
+            // Write the index of each facet's originating coarse face.
+            size_t offset = chunkFacetOffsets[c];
+            for (const auto& face : chunks[c].faces)
             {
-                vertexSurface.Evaluate(
-                    &outCoords[i * 2],
-                    facePatchPoints.data(),
-                    pointSize,
-                    &outPos[j],
-                    reinterpret_cast<float*>(&du),
-                    reinterpret_cast<float*>(&dv)
-                );
-                // Use the partials to construct a normal vector.
-                float3 normal = normalize(cross(du, dv));
-                if (leftHanded)
-                    normal = -normal;
-                outNormals[j + 0] = normal.x;
-                outNormals[j + 1] = normal.y;
-                outNormals[j + 2] = normal.z;
+                for (uint32_t i = 0; i < face.facetCount; ++i)
+                    pCoarseFaceIndices[offset++] = face.coarseFace;
             }
         }
+    );
 
-        const int facetCount = tessPattern.GetNumFacets();
-        outFacets.resize(facetCount * 3);
-        tessPattern.GetFacets(outFacets.data());
+    // Merge the per-face results into the indexed output mesh.
+    // Vertices shared between faces are deduplicated, which requires processing the faces in order.
+    MeshIndexer meshIndexer(uvInterp);
+    meshIndexer.reserve(3 * chunkFacetOffsets[chunkCount], totalVertexCount);
 
-        meshIndexer.addFacets(outFacets, outPos, outNormals, outUV);
+    for (auto& chunk : chunks)
+    {
+        size_t facetOffset = 0;
+        size_t vertexOffset = 0;
+        size_t uvOffset = 0;
+
+        for (const auto& face : chunk.faces)
+        {
+            meshIndexer.addFacets(
+                fstd::span<const int>(chunk.facets.data() + facetOffset, face.facetCount * 3),
+                fstd::span<const float>(chunk.positions.data() + vertexOffset, face.coordCount * 3),
+                fstd::span<const float>(chunk.normals.data() + vertexOffset, face.coordCount * 3),
+                fstd::span<const float>(chunk.uvs.data() + uvOffset, face.uvSize)
+            );
+            facetOffset += face.facetCount * 3;
+            vertexOffset += face.coordCount * 3;
+            uvOffset += face.uvSize;
+        }
 
-        // Append the index of each facet's originating coarse face, f.
-        for (int i = 0; i < facetCount; ++i)
-            coarseFaceIndices.push_back(f);
+        // Release the chunk storage as we go to reduce peak memory usage.
+        chunk = FaceChunk();
     }
 
     UsdMeshData tessellatedMesh;
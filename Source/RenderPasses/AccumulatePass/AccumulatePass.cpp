@@ -92,6 +92,17 @@ AccumulatePass::AccumulatePass(ref<Device> pDevice, const Properties& props) : R
     }
 
     mpState = ComputeState::create(mpDevice);
+
+    mBindings.resolution = mBindingLayout.add("PerFrameCB.gResolution");
+    mBindings.accumCount = mBindingLayout.add("PerFrameCB.gAccumCount");
+    mBindings.accumulate = mBindingLayout.add("PerFrameCB.gAccumulate");
+    mBindings.movingAverageMode = mBindingLayout.add("PerFrameCB.gMovingAverageMode");
+    mBindings.curFrame = mBindingLayout.add("gCurFrame");
+    mBindings.outputFrame = mBindingLayout.add("gOutputFrame");
+    mBindings.lastFrameSum = mBindingLayout.add("gLastFrameSum");
+    mBindings.lastFrameCorr = mBindingLayout.add("gLastFrameCorr");
+    mBindings.lastFrameSumLo = mBindingLayout.add("gLastFrameSumLo");
+    mBindings.lastFrameSumHi = mBindingLayout.add("gLastFrameSumHi");
 }
 
 Properties AccumulatePass::getProperties() const
@@ -263,18 +274,18 @@ void AccumulatePass::accumulate(RenderContext* pRenderContext, const ref<Texture
 
     // Set shader parameters.
     auto var = mpVars->getRootVar();
-    var["PerFrameCB"]["gResolution"] = mFrameDim;
-    var["PerFrameCB"]["gAccumCount"] = mFrameCount;
-    var["PerFrameCB"]["gAccumulate"] = mEnabled;
-    var["PerFrameCB"]["gMovingAverageMode"] = (mMaxFrameCount > 0);
-    var["gCurFrame"] = pSrc;
-    var["gOutputFrame"] = pDst;
+    mBindingLayout.get(var, mBindings.resolution) = mFrameDim;
+    mBindingLayout.get(var, mBindings.accumCount) = mFrameCount;
+    mBindingLayout.get(var, mBindings.accumulate) = mEnabled;
+    mBindingLayout.get(var, mBindings.movingAverageMode) = (mMaxFrameCount > 0);
+    mBindingLayout.get(var, mBindings.curFrame) = pSrc;
+    mBindingLayout.get(var, mBindings.outputFrame) = pDst;
 
     // Bind accumulation buffers. Some of these may be nullptr's.
-    var["gLastFrameSum"] = mpLastFrameSum;
-    var["gLastFrameCorr"] = mpLastFrameCorr;
-    var["gLastFrameSumLo"] = mpLastFrameSumLo;
-    var["gLastFrameSumHi"] = mpLastFrameSumHi;
+    mBindingLayout.get(var, mBindings.lastFrameSum) = mpLastFrameSum;
+    mBindingLayout.get(var, mBindings.lastFrameCorr) = mpLastFrameCorr;
+    mBindingLayout.get(var, mBindings.lastFrameSumLo) = mpLastFrameSumLo;
+    mBindingLayout.get(var, mBindings.lastFrameSumHi) = mpLastFrameSumHi;
 
     // Update the frame count.
     // The accumulation limit (mMaxFrameCount) has a special value of 0 (no limit) and is not supported in the SingleCompensated mode.
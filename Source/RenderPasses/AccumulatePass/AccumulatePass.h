@@ -113,6 +113,22 @@ protected:
     ref<ProgramVars> mpVars;
     ref<ComputeState> mpState;
 
+    /// Precompiled paths to the shader variables that are set every frame.
+    ShaderBindingLayout mBindingLayout;
+    struct
+    {
+        ShaderBindingLayout::Handle resolution;
+        ShaderBindingLayout::Handle accumCount;
+        ShaderBindingLayout::Handle accumulate;
+        ShaderBindingLayout::Handle movingAverageMode;
+        ShaderBindingLayout::Handle curFrame;
+        ShaderBindingLayout::Handle outputFrame;
+        ShaderBindingLayout::Handle lastFrameSum;
+        ShaderBindingLayout::Handle lastFrameCorr;
+        ShaderBindingLayout::Handle lastFrameSumLo;
+        ShaderBindingLayout::Handle lastFrameSumHi;
+    } mBindings;
+
     /// Format type of the source that gets accumulated.
     FormatType mSrcType;
 
@@ -56,7 +56,11 @@ BSDFViewer::BSDFViewer(ref<Device> pDevice, const Properties& props) : RenderPas
     mpSampleGenerator = SampleGenerator::create(mpDevice, SAMPLE_GENERATOR_UNIFORM);
 
     mpPixelDebug = std::make_unique<PixelDebug>(mpDevice);
-    mpFence = mpDevice->createFence();
+}
+
+BSDFViewer::~BSDFViewer()
+{
+    mpDevice->getReadbackService()->cancel(this);
 }
 
 void BSDFViewer::parseProperties(const Properties& props)
@@ -120,7 +124,8 @@ void BSDFViewer::setScene(RenderContext* pRenderContext, const ref<Scene>& pScen
     mpEnvMap = nullptr;
     mpViewerPass = nullptr;
     mMaterialList.clear();
-    mPixelDataValid = mPixelDataAvailable = false;
+    mpDevice->getReadbackService()->cancel(this);
+    mPixelDataValid = false;
 
     if (mpScene != nullptr)
     {
@@ -181,10 +186,6 @@ void BSDFViewer::execute(RenderContext* pRenderContext, const RenderData& render
         FALCOR_THROW("This render pass does not support scene changes that require shader recompilation.");
     }
 
-    // Read back pixel data from the previous frame if available.
-    // This ensures parameters get updated even if the UI wasn't rendered.
-    readPixelData();
-
     // Set compile-time constants.
     if (mParams.useDisneyDiffuse)
         mpViewerPass->addDefine("DiffuseBrdf", "DiffuseBrdfDisney");
@@ -207,8 +208,6 @@ void BSDFViewer::execute(RenderContext* pRenderContext, const RenderData& render
         mpPixelDataBuffer = mpDevice->createStructuredBuffer(
             var["pixelData"], 1, ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal, nullptr, false
         );
-        mpPixelStagingBuffer =
-            mpDevice->createStructuredBuffer(var["pixelData"], 1, ResourceBindFlags::None, MemoryType::ReadBack, nullptr, false);
     }
 
     var["params"].setBlob(mParams);
@@ -226,35 +225,25 @@ void BSDFViewer::execute(RenderContext* pRenderContext, const RenderData& render
     // Execute pass.
     mpViewerPass->execute(pRenderContext, uint3(mParams.frameDim, 1));
 
-    // Copy pixel data to staging buffer for readback.
-    // This is to avoid a full flush and the associated perf warning.
-    pRenderContext->copyResource(mpPixelStagingBuffer.get(), mpPixelDataBuffer.get());
-    pRenderContext->submit(false);
-    pRenderContext->signal(mpFence.get());
-    mPixelDataAvailable = true;
-    mPixelDataValid = false;
+    // Read back pixel data asynchronously.
+    // The parameters are updated from the selected pixel when the data arrives, even if the UI isn't rendered.
+    mpDevice->getReadbackService()->readValue<PixelData>(
+        pRenderContext,
+        mpPixelDataBuffer.get(),
+        0,
+        [this](const PixelData& data)
+        {
+            mPixelData = data;
+            mPixelDataValid = true;
+            mParams.texCoords = mPixelData.texC;
+        },
+        this
+    );
 
     mpPixelDebug->endFrame(pRenderContext);
     mParams.frameCount++;
 }
 
-void BSDFViewer::readPixelData()
-{
-    if (mPixelDataAvailable)
-    {
-        mpFence->wait();
-        FALCOR_ASSERT(mpPixelStagingBuffer);
-        mPixelData = *static_cast<const PixelData*>(mpPixelStagingBuffer->map());
-        mpPixelStagingBuffer->unmap();
-
-        mPixelDataAvailable = false;
-        mPixelDataValid = true;
-
-        // Update parameters from values at selected pixel.
-        mParams.texCoords = mPixelData.texC;
-    }
-}
-
 void BSDFViewer::renderUI(Gui::Widgets& widget)
 {
     if (!mpScene || mpScene->getMaterialCount() == 0)
@@ -482,9 +471,6 @@ void BSDFViewer::renderUI(Gui::Widgets& widget)
 
     if (auto pixelGroup = widget.group("Pixel data", true))
     {
-        // Read back data from the current frame when UI is shown.
-        readPixelData();
-
         pixelGroup.var("Pixel", mParams.selectedPixel);
 
         if (mPixelDataValid)
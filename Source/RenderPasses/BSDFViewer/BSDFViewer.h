@@ -43,6 +43,7 @@ public:
     static ref<BSDFViewer> create(ref<Device> pDevice, const Properties& props) { return make_ref<BSDFViewer>(pDevice, props); }
 
     BSDFViewer(ref<Device> pDevice, const Properties& props);
+    ~BSDFViewer();
 
     virtual Properties getProperties() const override;
     virtual RenderPassReflection reflect(const CompileData& compileData) override;
@@ -56,7 +57,6 @@ public:
 private:
     void parseProperties(const Properties& props);
     bool loadEnvMap(const std::filesystem::path& path);
-    void readPixelData();
 
     // Internal state
 
@@ -73,16 +73,11 @@ private:
     ref<SampleGenerator> mpSampleGenerator;
     bool mOptionsChanged = false;
 
-    /// GPU fence for synchronizing readback.
-    ref<Fence> mpFence;
     /// Buffer for data for the selected pixel.
     ref<Buffer> mpPixelDataBuffer;
-    /// Staging buffer for readback of pixel data.
-    ref<Buffer> mpPixelStagingBuffer;
-    /// Pixel data for the selected pixel (if valid).
+    /// Pixel data for the selected pixel (if valid). This is the latest data read back from the GPU.
     PixelData mPixelData;
     bool mPixelDataValid = false;
-    bool mPixelDataAvailable = false;
 
     /// Utility class for pixel debugging (print in shaders).
     std::unique_ptr<PixelDebug> mpPixelDebug;
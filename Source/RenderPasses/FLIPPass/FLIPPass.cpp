@@ -96,6 +96,11 @@ FLIPPass::FLIPPass(ref<Device> pDevice, const Properties& props) : RenderPass(pD
     }
 }
 
+FLIPPass::~FLIPPass()
+{
+    mpDevice->getReadbackService()->cancel(this);
+}
+
 Properties FLIPPass::getProperties() const
 {
     Properties props;
@@ -365,15 +370,31 @@ void FLIPPass::execute(RenderContext* pRenderContext, const RenderData& renderDa
     // Compute mean, min, and max using parallel reduction.
     if (mComputePooledFLIPValues)
     {
-        float4 FLIPSum, FLIPMinMax[2];
-        mpParallelReduction->execute<float4>(pRenderContext, pErrorMapOutput, ParallelReduction::Type::Sum, &FLIPSum);
-        mpParallelReduction->execute<float4>(pRenderContext, pErrorMapOutput, ParallelReduction::Type::MinMax, &FLIPMinMax[0]);
-        pRenderContext->submit(true);
+        if (!mpPooledFLIPValues)
+            mpPooledFLIPValues = mpDevice->createBuffer(3 * sizeof(float4), ResourceBindFlags::None, MemoryType::DeviceLocal);
 
-        // Extract metrics from readback values. RGB channels contain magma mapping, and the alpa channel contains FLIP value.
-        mAverageFLIP = FLIPSum.a / (outputResolution.x * outputResolution.y);
-        mMinFLIP = FLIPMinMax[0].a;
-        mMaxFLIP = FLIPMinMax[1].a;
+        mpParallelReduction->execute<float4>(pRenderContext, pErrorMapOutput, ParallelReduction::Type::Sum, nullptr, mpPooledFLIPValues, 0);
+        mpParallelReduction->execute<float4>(
+            pRenderContext, pErrorMapOutput, ParallelReduction::Type::MinMax, nullptr, mpPooledFLIPValues, sizeof(float4)
+        );
+
+        // Read back the values asynchronously to avoid a GPU flush.
+        const uint32_t pixelCount = outputResolution.x * outputResolution.y;
+        mpDevice->getReadbackService()->readBuffer(
+            pRenderContext,
+            mpPooledFLIPValues.get(),
+            0,
+            0,
+            [this, pixelCount](const void* pData, size_t size)
+            {
+                // Extract metrics from readback values. RGB channels contain magma mapping, and the alpa channel contains FLIP value.
+                const float4* pValues = static_cast<const float4*>(pData);
+                mAverageFLIP = pValues[0].a / pixelCount;
+                mMinFLIP = pValues[1].a;
+                mMaxFLIP = pValues[2].a;
+            },
+            this
+        );
     }
 }
 
@@ -54,6 +54,7 @@ public:
     static ref<FLIPPass> create(ref<Device> pDevice, const Properties& props) { return make_ref<FLIPPass>(pDevice, props); }
 
     FLIPPass(ref<Device> pDevice, const Properties& props);
+    virtual ~FLIPPass();
 
     virtual Properties getProperties() const override;
     virtual RenderPassReflection reflect(const CompileData& compileData) override;
@@ -107,15 +108,17 @@ private:
     ref<ComputePass> mpComputeLuminancePass;
     /// Helper for parallel reduction on the GPU.
     std::unique_ptr<ParallelReduction> mpParallelReduction;
+    /// Buffer for the results of the parallel reduction (sum, min, max).
+    ref<Buffer> mpPooledFLIPValues;
 
     /// Enable to use parallel reduction to compute FLIP mean/min/max across whole frame.
     bool mComputePooledFLIPValues = false;
-    /// Average FLIP value across whole frame.
-    float mAverageFLIP;
+    /// Average FLIP value across whole frame. Read back asynchronously, so this may lag a few frames behind.
+    float mAverageFLIP = 0.f;
     /// Minimum FLIP value across whole frame.
-    float mMinFLIP;
+    float mMinFLIP = 0.f;
     /// Maximum FLIP value across whole frame.
-    float mMaxFLIP;
+    float mMaxFLIP = 0.f;
     /// When enabled, user-proided monitor data will be overriden by real monitor data from the OS.
     bool mUseRealMonitorInfo = false;
     /// Recompilation flag.
@@ -113,8 +113,6 @@ SDFEditor::SDFEditor(ref<Device> pDevice, const Properties& props) : RenderPass(
     mpPickingInfo = mpDevice->createStructuredBuffer(
         sizeof(SDFPickingInfo), 1, ResourceBindFlags::ShaderResource | ResourceBindFlags::UnorderedAccess, MemoryType::DeviceLocal
     );
-    mpPickingInfoReadBack = mpDevice->createStructuredBuffer(sizeof(SDFPickingInfo), 1, ResourceBindFlags::None, MemoryType::ReadBack);
-    mpReadbackFence = mpDevice->createFence();
 
     mUI2D.pMarker2DSet = std::make_unique<Marker2DSet>(mpDevice, 100);
     mUI2D.pSelectionWheel = std::make_unique<SelectionWheel>(*mUI2D.pMarker2DSet);
@@ -126,6 +124,11 @@ SDFEditor::SDFEditor(ref<Device> pDevice, const Properties& props) : RenderPass(
     mUI2D.symmetryPlane.color = float4(1.0f, 0.75f, 0.8f, 0.5f);
 }
 
+SDFEditor::~SDFEditor()
+{
+    mpDevice->getReadbackService()->cancel(this);
+}
+
 void SDFEditor::bindShaderData(const ShaderVar& var, const ref<Texture>& pInputColor, const ref<Texture>& pVBuffer)
 {
     mGPUEditingData.editing = mEditingKeyDown;
@@ -1231,11 +1234,6 @@ void SDFEditor::execute(RenderContext* pRenderContext, const RenderData& renderD
         pVBuffer = mpEditingVBuffer;
     }
 
-    // Wait for the picking info from the previous frame.
-    mpReadbackFence->wait();
-    mPickingInfo = *reinterpret_cast<const SDFPickingInfo*>(mpPickingInfoReadBack->map());
-    mpPickingInfoReadBack->unmap();
-
     setup2DGUI();
     handleActions();
 
@@ -1245,10 +1243,10 @@ void SDFEditor::execute(RenderContext* pRenderContext, const RenderData& renderD
 
     mpGUIPass->execute(pRenderContext, mpFbo);
 
-    // Copy picking info into a staging buffer.
-    pRenderContext->copyResource(mpPickingInfoReadBack.get(), mpPickingInfo.get());
-    pRenderContext->submit(false);
-    pRenderContext->signal(mpReadbackFence.get());
+    // Read back the picking info asynchronously. Picking uses the latest available info.
+    mpDevice->getReadbackService()->readValue<SDFPickingInfo>(
+        pRenderContext, mpPickingInfo.get(), 0, [this](const SDFPickingInfo& info) { mPickingInfo = info; }, this
+    );
 
     // Prepare next frame.
     {
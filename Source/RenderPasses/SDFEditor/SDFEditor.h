@@ -43,6 +43,7 @@ public:
     static ref<SDFEditor> create(ref<Device> pDevice, const Properties& props) { return make_ref<SDFEditor>(pDevice, props); }
 
     SDFEditor(ref<Device> pDevice, const Properties& props);
+    ~SDFEditor();
 
     virtual Properties getProperties() const override;
     virtual RenderPassReflection reflect(const CompileData& compileData) override;
@@ -234,9 +235,7 @@ private:
     UI2D mUI2D;
 
     ref<Buffer> mpPickingInfo;         ///< Buffer for reading back picking info from the GPU.
-    ref<Buffer> mpPickingInfoReadBack; ///< Staging buffer for reading back picking info from the GPU.
-    ref<Fence> mpReadbackFence;        ///< GPU fence for synchronizing picking info readback.
-    SDFPickingInfo mPickingInfo;
+    SDFPickingInfo mPickingInfo;       ///< Latest picking info read back from the GPU.
 
     SDFEditingData mGPUEditingData;
 
@@ -120,8 +120,11 @@ SceneDebugger::SceneDebugger(ref<Device> pDevice, const Properties& props) : Ren
         else
             logWarning("Unknown property '{}' in a SceneDebugger properties.", key);
     }
+}
 
-    mpFence = mpDevice->createFence();
+SceneDebugger::~SceneDebugger()
+{
+    mpDevice->getReadbackService()->cancel(this);
 }
 
 Properties SceneDebugger::getProperties() const
@@ -151,6 +154,10 @@ void SceneDebugger::setScene(RenderContext* pRenderContext, const ref<Scene>& pS
     mpMeshToBlasID = nullptr;
     mpDebugPass = nullptr;
 
+    // Drop pixel data of the previous scene.
+    mpDevice->getReadbackService()->cancel(this);
+    mPixelDataAvailable = false;
+
     if (mpScene)
     {
         // Prepare our programs for the scene.
@@ -189,8 +196,6 @@ void SceneDebugger::setScene(RenderContext* pRenderContext, const ref<Scene>& pS
                 nullptr,
                 false
             );
-            mpPixelDataStaging =
-                mpDevice->createStructuredBuffer(var["pixelData"], 1, ResourceBindFlags::None, MemoryType::ReadBack, nullptr, false);
         }
         var["pixelData"] = mpPixelData;
         var["meshToBlasID"] = mpMeshToBlasID;
@@ -200,11 +205,11 @@ void SceneDebugger::setScene(RenderContext* pRenderContext, const ref<Scene>& pS
 
 void SceneDebugger::execute(RenderContext* pRenderContext, const RenderData& renderData)
 {
-    mPixelDataAvailable = false;
     const auto& pOutput = renderData.getTexture(kOutput);
 
     if (mpScene == nullptr)
     {
+        mPixelDataAvailable = false;
         pRenderContext->clearUAV(pOutput->getUAV().get(), float4(0.f));
         return;
     }
@@ -225,11 +230,19 @@ void SceneDebugger::execute(RenderContext* pRenderContext, const RenderData& ren
 
     mpDebugPass->execute(pRenderContext, uint3(mParams.frameDim, 1));
 
-    pRenderContext->copyResource(mpPixelDataStaging.get(), mpPixelData.get());
-    pRenderContext->submit(false);
-    pRenderContext->signal(mpFence.get());
+    // Read back the pixel data asynchronously. The UI shows the latest available data.
+    mpDevice->getReadbackService()->readValue<PixelData>(
+        pRenderContext,
+        mpPixelData.get(),
+        0,
+        [this](const PixelData& data)
+        {
+            mPixelData = data;
+            mPixelDataAvailable = true;
+        },
+        this
+    );
 
-    mPixelDataAvailable = true;
     mParams.frameCount++;
 }
 
@@ -276,9 +289,7 @@ void SceneDebugger::renderPixelDataUI(Gui::Widgets& widget)
     if (!mPixelDataAvailable)
         return;
 
-    FALCOR_ASSERT(mpPixelDataStaging);
-    mpFence->wait();
-    const PixelData data = mpPixelDataStaging->getElement<PixelData>(0);
+    const PixelData& data = mPixelData;
 
     switch ((HitType)data.hitType)
     {
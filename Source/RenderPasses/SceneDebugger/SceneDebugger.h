@@ -46,6 +46,7 @@ public:
     static ref<SceneDebugger> create(ref<Device> pDevice, const Properties& props) { return make_ref<SceneDebugger>(pDevice, props); }
 
     SceneDebugger(ref<Device> pDevice, const Properties& props);
+    ~SceneDebugger();
 
     Properties getProperties() const override;
     RenderPassReflection reflect(const CompileData& compileData) override;
@@ -69,12 +70,11 @@ private:
     ref<Scene> mpScene;
     SceneDebuggerParams mParams;
     ref<ComputePass> mpDebugPass;
-    ref<Fence> mpFence;
     /// Buffer for recording pixel data at the selected pixel.
     ref<Buffer> mpPixelData;
-    /// Readback buffer.
-    ref<Buffer> mpPixelDataStaging;
     ref<Buffer> mpMeshToBlasID;
     ref<Buffer> mpInstanceInfo;
+    /// Latest pixel data read back from the GPU (if available).
+    PixelData mPixelData;
     bool mPixelDataAvailable = false;
 };
@@ -71,6 +71,7 @@ public:
     virtual void compile(RenderContext* pRenderContext, const CompileData& compileData) override;
     virtual void execute(RenderContext* pRenderContext, const RenderData& renderData) override;
     virtual void renderUI(Gui::Widgets& widget) override;
+    virtual bool isAsyncComputeCapable() const override { return true; }
 
 private:
     DefineList getDefines() const;
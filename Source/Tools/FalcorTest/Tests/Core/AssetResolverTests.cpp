@@ -191,4 +191,65 @@ CPU_TEST(AssetResolver)
     removeTestFiles(ctx);
 }
 
+CPU_TEST(AssetResolver_Index)
+{
+    createTestFiles(ctx);
+
+    const std::filesystem::path unresolved;
+
+    AssetResolver resolver;
+    resolver.addSearchPath(kTestRoot / "media1");
+    resolver.addSearchPath(kTestRoot / "media2");
+    resolver.addSearchPath(kTestRoot / "media4", SearchPathPriority::Last, AssetCategory::Texture);
+
+    EXPECT(!resolver.hasIndex());
+    resolver.buildIndex();
+    EXPECT(resolver.hasIndex());
+
+    AssetIndexStats stats = resolver.getIndexStats();
+    EXPECT_EQ(stats.fileCount, 7);
+    EXPECT_EQ(stats.directoryCount, 4);
+    EXPECT_EQ(stats.hitCount, 0);
+
+    // Test resolving with search paths.
+    EXPECT_EQ(resolver.resolvePath("asset1"), kTestRoot / "media1/asset1");
+    EXPECT_EQ(resolver.resolvePath("asset2"), kTestRoot / "media2/asset2");
+    EXPECT_EQ(resolver.resolvePath("asset3"), unresolved);
+    EXPECT_EQ(resolver.resolvePath("textures/mip0.png", AssetCategory::Texture), kTestRoot / "media4/textures/mip0.png");
+    EXPECT_EQ(resolver.resolvePath("textures/mip0.png", AssetCategory::Scene), unresolved);
+
+    // Test resolving patterns with search paths.
+    auto resolved = resolver.resolvePathPattern("textures", R"(mip[0-9]\.png)", false, AssetCategory::Texture);
+    EXPECT_EQ(resolved.size(), 4);
+    std::sort(resolved.begin(), resolved.end());
+    EXPECT_EQ(resolved[0], kTestRoot / "media4/textures/mip0.png");
+    EXPECT_EQ(resolved[3], kTestRoot / "media4/textures/mip3.png");
+    EXPECT_EQ(resolver.resolvePathPattern("textures", std::regex(R"(mip[0-9]\.png)"), true, AssetCategory::Texture).size(), 1);
+
+    // Test resolving absolute paths inside and outside of the search paths.
+    EXPECT_EQ(resolver.resolvePath(kTestRoot / "media2/asset1"), kTestRoot / "media2/asset1");
+    EXPECT_EQ(resolver.resolvePath(kTestRoot / "media3/asset3"), kTestRoot / "media3/asset3");
+
+    stats = resolver.getIndexStats();
+    EXPECT_GT(stats.hitCount, 0);
+    EXPECT_GT(stats.missCount, 0);
+    EXPECT_GT(stats.fallbackCount, 0);
+
+    // The index is a snapshot, new files are only found after rebuilding or invalidating it.
+    std::ofstream(kTestRoot / "media1/asset3").close();
+    EXPECT_EQ(resolver.resolvePath("asset3"), unresolved);
+    resolver.buildIndex();
+    EXPECT_EQ(resolver.resolvePath("asset3"), kTestRoot / "media1/asset3");
+    EXPECT_EQ(resolver.getIndexStats().fileCount, 8);
+
+    std::filesystem::remove(kTestRoot / "media1/asset3");
+    EXPECT_EQ(resolver.resolvePath("asset3"), kTestRoot / "media1/asset3");
+    resolver.invalidateIndex();
+    EXPECT(!resolver.hasIndex());
+    EXPECT_EQ(resolver.resolvePath("asset3"), unresolved);
+    EXPECT_EQ(resolver.getIndexStats().hitCount, 0);
+
+    removeTestFiles(ctx);
+}
+
 } // namespace Falcor
@@ -0,0 +1,107 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Core/Program/ShaderBindingLayout.h"
+
+namespace Falcor
+{
+namespace
+{
+const char kShaderFile[] = "Tests/Core/ShaderBindingLayoutTests.cs.slang";
+
+/// Host side mirror of the `Params` struct in the shader.
+struct Params
+{
+    int32_t a;
+    uint32_t b;
+    float c;
+    float d;
+};
+} // namespace
+
+GPU_TEST(ShaderBindingLayout)
+{
+    ShaderBindingLayout layout;
+    auto dim = layout.add("CB.dim");
+    auto paramsA = layout.add("CB.params[1].a");
+    auto paramsB = layout.add("CB.params[1].b");
+    auto paramsC = layout.add("CB.params[1].c");
+    auto params2 = layout.addStruct<Params>("params2");
+    auto missing = layout.add("CB.missing");
+
+    ctx.createProgram(kShaderFile);
+    ctx.allocateStructuredBuffer("result", 10);
+    auto var = ctx.vars().getRootVar();
+
+    layout.get(var, dim) = uint2(3, 4);
+    layout.get(var, paramsA) = 5;
+    layout.get(var, paramsB) = 6u;
+    layout.get(var, paramsC) = 7.5f;
+    layout.setStruct(var, params2, Params{8, 9u, 10.5f, 11.5f});
+    EXPECT(!layout.find(var, missing).isValid());
+    EXPECT_THROW(layout.get(var, missing));
+    EXPECT_EQ(layout.getResolveCount(), 1);
+
+    // The handles must point at the same variables as string lookups.
+    EXPECT_EQ(layout.get(var, paramsA).getByteOffset(), var["CB"]["params"][1]["a"].getByteOffset());
+    EXPECT_EQ(layout.get(var, paramsC).getByteOffset(), var["CB"]["params"][1]["c"].getByteOffset());
+
+    ctx.runProgram(1, 1, 1);
+
+    std::vector<float> result = ctx.readBuffer<float>("result");
+    const float expected[] = {3.f, 4.f, 5.f, 6.f, 7.5f, 8.f, 9.f, 10.5f, 11.5f};
+    for (size_t i = 0; i < std::size(expected); ++i)
+        EXPECT_EQ(result[i], expected[i]) << "i = " << i;
+
+    // Paths are resolved again for a different program version.
+    ctx.createProgram(kShaderFile, "main", DefineList{{"EXTRA_MEMBER", "42.f"}});
+    ctx.allocateStructuredBuffer("result", 10);
+    var = ctx.vars().getRootVar();
+    layout.get(var, paramsA) = 1;
+    EXPECT_EQ(layout.getResolveCount(), 2);
+    layout.get(var, paramsB) = 2u;
+    EXPECT_EQ(layout.getResolveCount(), 2);
+}
+
+GPU_TEST(ShaderBindingLayout_InvalidStruct)
+{
+    struct WrongSize
+    {
+        float a[5];
+    };
+
+    ShaderBindingLayout layout;
+    auto params2 = layout.addStruct<WrongSize>("params2");
+    EXPECT_THROW(layout.add("CB.params[").isValid());
+
+    ctx.createProgram(kShaderFile);
+    auto var = ctx.vars().getRootVar();
+    EXPECT_THROW(layout.setStruct(var, params2, WrongSize{}));
+    EXPECT_THROW(layout.setStruct(var, params2, Params{}));
+}
+} // namespace Falcor
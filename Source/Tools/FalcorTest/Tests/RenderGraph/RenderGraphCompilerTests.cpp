@@ -0,0 +1,213 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraph.h"
+#include <map>
+#include <set>
+
+namespace Falcor
+{
+namespace
+{
+/// Pass with configurable I/O that counts the calls to compile().
+class MockPass : public RenderPass
+{
+public:
+    FALCOR_PLUGIN_CLASS(MockPass, "MockPass", "Render pass for testing the render graph compiler.");
+
+    MockPass(ref<Device> pDevice, std::vector<std::string> inputs, std::vector<std::string> outputs, uint2 outputSize = {})
+        : RenderPass(pDevice), mInputs(std::move(inputs)), mOutputs(std::move(outputs)), mOutputSize(outputSize)
+    {}
+
+    RenderPassReflection reflect(const CompileData& compileData) override
+    {
+        RenderPassReflection r;
+        for (const auto& name : mInputs)
+            r.addInput(name, "Input");
+        for (const auto& name : mOutputs)
+            r.addOutput(name, "Output").format(ResourceFormat::RGBA32Float).texture2D(mOutputSize.x, mOutputSize.y);
+        return r;
+    }
+
+    void compile(RenderContext* pRenderContext, const CompileData& compileData) override { compileCount++; }
+    void execute(RenderContext* pRenderContext, const RenderData& renderData) override {}
+
+    void setOutputSize(uint2 size)
+    {
+        mOutputSize = size;
+        requestRecompile();
+    }
+
+    uint32_t compileCount = 0;
+
+private:
+    std::vector<std::string> mInputs;
+    std::vector<std::string> mOutputs;
+    uint2 mOutputSize;
+};
+
+struct TestGraph
+{
+    ref<RenderGraph> pGraph;
+    ref<MockPass> pA, pB, pC, pD;
+};
+
+/// Graph A -> B -> C with an independent pass D that has a fixed output size.
+TestGraph createTestGraph(ref<Device> pDevice, uint2 dSize)
+{
+    TestGraph g;
+    g.pGraph = RenderGraph::create(pDevice, "TestGraph");
+    g.pA = make_ref<MockPass>(pDevice, std::vector<std::string>{}, std::vector<std::string>{"color"});
+    g.pB = make_ref<MockPass>(pDevice, std::vector<std::string>{"src"}, std::vector<std::string>{"dst"});
+    g.pC = make_ref<MockPass>(pDevice, std::vector<std::string>{"src"}, std::vector<std::string>{"dst"});
+    g.pD = make_ref<MockPass>(pDevice, std::vector<std::string>{}, std::vector<std::string>{"color"}, dSize);
+    g.pGraph->addPass(g.pA, "A");
+    g.pGraph->addPass(g.pB, "B");
+    g.pGraph->addPass(g.pC, "C");
+    g.pGraph->addPass(g.pD, "D");
+    g.pGraph->addEdge("A.color", "B.src");
+    g.pGraph->addEdge("B.dst", "C.src");
+    g.pGraph->markOutput("B.dst");
+    g.pGraph->markOutput("C.dst");
+    g.pGraph->markOutput("D.color");
+    return g;
+}
+
+const std::vector<std::string> kOutputs = {"B.dst", "C.dst", "D.color"};
+
+/// Compile the graph and check by name which passes were compiled. All other passes must have been reused as is.
+void compileAndCheckPasses(GPUUnitTestContext& ctx, TestGraph& g, const std::set<std::string>& expectedCompiled)
+{
+    const std::map<std::string, MockPass*> passes = {{"A", g.pA.get()}, {"B", g.pB.get()}, {"C", g.pC.get()}, {"D", g.pD.get()}};
+    std::map<std::string, uint32_t> compileCounts;
+    for (const auto& [name, pPass] : passes)
+        compileCounts[name] = pPass->compileCount;
+
+    ASSERT(g.pGraph->compile(ctx.getDevice()->getRenderContext()));
+
+    for (const auto& [name, pPass] : passes)
+    {
+        uint32_t expectedCount = compileCounts[name] + (expectedCompiled.count(name) ? 1 : 0);
+        EXPECT_EQ(pPass->compileCount, expectedCount) << "Pass " << name;
+    }
+    auto stats = g.pGraph->getCompileStats();
+    EXPECT_EQ(stats.compiledPassCount, expectedCompiled.size());
+    EXPECT_EQ(stats.skippedPassCount, passes.size() - expectedCompiled.size());
+}
+
+/// Get the graph outputs, to check which resources were reused by a recompilation.
+std::map<std::string, ref<Resource>> getOutputs(const TestGraph& g)
+{
+    std::map<std::string, ref<Resource>> outputs;
+    for (const auto& name : kOutputs)
+        outputs[name] = g.pGraph->getOutput(name);
+    return outputs;
+}
+
+/// Check that the incrementally compiled graph has the same outputs as a graph compiled from scratch.
+void checkEquivalence(GPUUnitTestContext& ctx, TestGraph& incremental, uint2 dSize, const ref<Fbo>& pFbo)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    auto full = createTestGraph(pDevice, dSize);
+    full.pGraph->onResize(pFbo.get());
+    ASSERT(full.pGraph->compile(pDevice->getRenderContext()));
+    EXPECT_EQ(full.pGraph->getCompileStats().reusedResourceCount, 0);
+
+    for (const auto& name : kOutputs)
+    {
+        auto pExpected = full.pGraph->getOutput(name)->asTexture();
+        auto pActual = incremental.pGraph->getOutput(name)->asTexture();
+        ASSERT(pExpected && pActual);
+        EXPECT_EQ(pActual->getWidth(), pExpected->getWidth());
+        EXPECT_EQ(pActual->getHeight(), pExpected->getHeight());
+        EXPECT_EQ(pActual->getFormat(), pExpected->getFormat());
+        EXPECT(pActual->getBindFlags() == pExpected->getBindFlags());
+    }
+}
+} // namespace
+
+GPU_TEST(RenderGraphCompiler_Incremental)
+{
+    ref<Device> pDevice = ctx.getDevice();
+    RenderContext* pRenderContext = pDevice->getRenderContext();
+
+    uint2 dSize = {64, 64};
+    auto g = createTestGraph(pDevice, dSize);
+    auto pFbo = Fbo::create2D(pDevice, 256, 128, ResourceFormat::RGBA8Unorm);
+    g.pGraph->onResize(pFbo.get());
+
+    // The first compilation compiles everything.
+    compileAndCheckPasses(ctx, g, {"A", "B", "C", "D"});
+    EXPECT_EQ(g.pGraph->getCompileStats().reusedResourceCount, 0);
+    checkEquivalence(ctx, g, dSize, pFbo);
+    auto outputs = getOutputs(g);
+
+    // Resizing to the same size doesn't trigger a recompilation.
+    g.pGraph->onResize(pFbo.get());
+    ASSERT(g.pGraph->compile(pRenderContext));
+    EXPECT_EQ(g.pA->compileCount, 1);
+    EXPECT(getOutputs(g) == outputs);
+
+    // Changing the I/O of D only recompiles D and its resources.
+    // The resources of the other passes are taken over as is. Note that they are not cleared, they keep their previous contents.
+    dSize = {32, 32};
+    g.pD->setOutputSize(dSize);
+    compileAndCheckPasses(ctx, g, {"D"});
+    auto stats = g.pGraph->getCompileStats();
+    EXPECT_EQ(stats.allocatedResourceCount, 1);
+    EXPECT_EQ(stats.reusedResourceCount, 3);
+    EXPECT(g.pGraph->getOutput("B.dst") == outputs["B.dst"]);
+    EXPECT(g.pGraph->getOutput("C.dst") == outputs["C.dst"]);
+    EXPECT(g.pGraph->getOutput("D.color") != outputs["D.color"]);
+    checkEquivalence(ctx, g, dSize, pFbo);
+    outputs = getOutputs(g);
+
+    // Changing an edge recompiles the passes whose connected resources changed.
+    // B loses its connection to C. C is connected to an output with the same properties as before, so it is not recompiled.
+    g.pGraph->removeEdge("B.dst", "C.src");
+    g.pGraph->addEdge("A.color", "C.src");
+    compileAndCheckPasses(ctx, g, {"B"});
+    EXPECT(g.pGraph->getOutput("D.color") == outputs["D.color"]);
+
+    g.pGraph->removeEdge("A.color", "C.src");
+    g.pGraph->addEdge("B.dst", "C.src");
+    compileAndCheckPasses(ctx, g, {"B"});
+    EXPECT(g.pGraph->getOutput("D.color") == outputs["D.color"]);
+    checkEquivalence(ctx, g, dSize, pFbo);
+
+    // A resize recompiles all passes, resources with a fixed size are kept.
+    pFbo = Fbo::create2D(pDevice, 128, 64, ResourceFormat::RGBA8Unorm);
+    outputs = getOutputs(g);
+    g.pGraph->onResize(pFbo.get());
+    compileAndCheckPasses(ctx, g, {"A", "B", "C", "D"});
+    EXPECT(g.pGraph->getOutput("D.color") == outputs["D.color"]);
+    EXPECT(g.pGraph->getOutput("B.dst") != outputs["B.dst"]);
+    EXPECT(g.pGraph->getOutput("C.dst") != outputs["C.dst"]);
+    checkEquivalence(ctx, g, dSize, pFbo);
+}
+} // namespace Falcor
@@ -0,0 +1,78 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Core/Plugin.h"
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraph.h"
+#include "RenderGraph/RenderGraphImportExport.h"
+
+namespace Falcor
+{
+GPU_TEST(RenderGraphImportExport_Binary)
+{
+    PluginManager::instance().loadPluginByName("ToneMapper");
+    PluginManager::instance().loadPluginByName("BlitPass");
+
+    ref<Device> pDevice = ctx.getDevice();
+    ref<RenderGraph> pGraph = RenderGraph::create(pDevice, "BinaryGraph");
+    Properties toneMapperProps;
+    toneMapperProps.set("exposureCompensation", 2.f);
+    ref<RenderPass> pToneMapper = pGraph->createPass("ToneMapper", "ToneMapper", toneMapperProps);
+    ASSERT(pToneMapper);
+    ASSERT(pGraph->createPass("Blit", "BlitPass", Properties()));
+    pGraph->addEdge("ToneMapper.dst", "Blit.src");
+    pGraph->markOutput("ToneMapper.dst", TextureChannelFlags::Red);
+    pGraph->markOutput("Blit.dst");
+
+    std::vector<uint8_t> data = RenderGraphExporter::getBinary(pGraph);
+
+    // The pass properties stay encoded until they are accessed.
+    Properties desc = Properties::fromBinary(data.data(), data.size());
+    Properties passDesc = desc.get<Properties>("passes").get<Properties>("0");
+    EXPECT_EQ(passDesc.get<std::string>("name"), "ToneMapper");
+    EXPECT_EQ(passDesc.get<std::string>("type"), "ToneMapper");
+    EXPECT(passDesc.get<Properties>("properties").isLazy());
+
+    // Importing gives the same graph, which encodes to the same data.
+    ref<RenderGraph> pImported = RenderGraphImporter::importBinary(pDevice, data);
+    ASSERT(pImported);
+    EXPECT_EQ(pImported->getName(), "BinaryGraph");
+    EXPECT(pImported->doesPassExist("Blit"));
+    EXPECT_EQ(pImported->getPass("ToneMapper")->getProperties(), pToneMapper->getProperties());
+    EXPECT(pImported->isGraphOutput("ToneMapper.dst"));
+    EXPECT(pImported->isGraphOutput("Blit.dst"));
+    EXPECT(RenderGraphExporter::getBinary(pImported) == data);
+
+    // Invalid data and unknown pass types throw.
+    EXPECT_THROW(RenderGraphImporter::importBinary(pDevice, std::vector<uint8_t>{1, 2, 3}));
+    Properties passes = desc.get<Properties>("passes");
+    passDesc.set("type", "DoesNotExist");
+    passes.set("0", passDesc);
+    desc.set("passes", passes);
+    EXPECT_THROW(RenderGraphImporter::importBinary(pDevice, desc.toBinary()));
+}
+} // namespace Falcor
@@ -0,0 +1,349 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraphPlanner.h"
+
+namespace Falcor
+{
+namespace
+{
+using Planner = RenderGraphPlanner;
+using Field = RenderPassReflection::Field;
+
+const uint2 kResolution = {64, 32};
+const ResourceFormat kFormat = ResourceFormat::RGBA8Unorm;
+
+/// G-buffer -> lighting -> tonemap, with a debug pass that is not connected to the output.
+Planner::GraphDesc createGraph()
+{
+    Planner::GraphDesc desc;
+    desc.name = "TestGraph";
+
+    Planner::PassDesc gbuffer{"GBuffer", {}};
+    gbuffer.reflection.addOutput("posW", "").format(ResourceFormat::RGBA32Float);
+    gbuffer.reflection.addOutput("normW", "").format(ResourceFormat::RGBA32Float);
+    gbuffer.reflection.addOutput("depth", "").format(ResourceFormat::D32Float);
+    desc.passes.push_back(gbuffer);
+
+    Planner::PassDesc lighting{"Lighting", {}};
+    lighting.reflection.addInput("posW", "");
+    lighting.reflection.addInput("normW", "");
+    lighting.reflection.addInput("ao", "").flags(Field::Flags::Optional);
+    lighting.reflection.addOutput("color", "").format(ResourceFormat::RGBA16Float);
+    lighting.reflection.addInternal("scratch", "").rawBuffer(1024);
+    desc.passes.push_back(lighting);
+
+    Planner::PassDesc tonemap{"ToneMap", {}};
+    tonemap.reflection.addInput("src", "");
+    tonemap.reflection.addOutput("dst", "").texture2D(0, 0, 1, Field::kMaxMipLevels);
+    desc.passes.push_back(tonemap);
+
+    Planner::PassDesc debug{"Debug", {}};
+    debug.reflection.addInput("src", "");
+    debug.reflection.addOutput("dst", "");
+    desc.passes.push_back(debug);
+
+    desc.edges = {
+        {"GBuffer.posW", "Lighting.posW"},
+        {"GBuffer.normW", "Lighting.normW"},
+        {"Lighting.color", "ToneMap.src"},
+        {"GBuffer.depth", "Debug.src"},
+    };
+    desc.outputs = {"ToneMap.dst"};
+    return desc;
+}
+
+const Planner::ResourceInfo* findResource(const Planner::Plan& plan, const std::string& name)
+{
+    for (const auto& r : plan.resources)
+    {
+        if (r.name == name)
+            return &r;
+    }
+    return nullptr;
+}
+
+bool hasError(const std::vector<std::string>& errors, const std::string& text)
+{
+    for (const auto& e : errors)
+    {
+        if (e.find(text) != std::string::npos)
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+CPU_TEST(RenderGraphPlanner_Validate)
+{
+    EXPECT(Planner::validate(createGraph()).empty());
+
+    {
+        auto desc = createGraph();
+        desc.outputs.clear();
+        EXPECT(hasError(Planner::validate(desc), "at least one output"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.push_back({"Missing.color", "ToneMap.src"});
+        EXPECT(hasError(Planner::validate(desc), "doesn't exist"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.push_back({"Lighting.color", "Lighting.ao"});
+        EXPECT(hasError(Planner::validate(desc), "connects a pass to itself"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.push_back({"GBuffer.posW", "ToneMap.src"});
+        EXPECT(hasError(Planner::validate(desc), "more than one incoming edge"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.push_back({"Lighting.posW", "ToneMap.src"});
+        EXPECT(hasError(Planner::validate(desc), "is not an output field"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.erase(desc.edges.begin());
+        EXPECT(hasError(Planner::validate(desc), "'Lighting.posW' is required"));
+    }
+    {
+        auto desc = createGraph();
+        desc.edges.push_back({"ToneMap", "GBuffer"});
+        EXPECT(hasError(Planner::validate(desc), "cycle"));
+    }
+    {
+        // Required inputs of passes that don't contribute to the outputs are not checked.
+        auto desc = createGraph();
+        desc.edges.pop_back();
+        EXPECT(Planner::validate(desc).empty());
+    }
+
+    auto desc = createGraph();
+    desc.outputs.push_back("Lighting.posW");
+    EXPECT_THROW(Planner::plan(desc, kResolution, kFormat));
+}
+
+CPU_TEST(RenderGraphPlanner_Plan)
+{
+    auto plan = Planner::plan(createGraph(), kResolution, kFormat);
+
+    // The debug pass doesn't contribute to the output and is culled.
+    EXPECT(plan.executionOrder == std::vector<std::string>({"GBuffer", "Lighting", "ToneMap"}));
+    EXPECT_EQ(plan.resources.size(), 6);
+
+    const auto* pPos = findResource(plan, "GBuffer.posW");
+    EXPECT(pPos != nullptr);
+    EXPECT_EQ(pPos->firstUse, 0);
+    EXPECT_EQ(pPos->lastUse, 1);
+    EXPECT(pPos->aliases == std::vector<std::string>({"Lighting.posW"}));
+    EXPECT_EQ(pPos->width, kResolution.x);
+    EXPECT_EQ(pPos->height, kResolution.y);
+    EXPECT_EQ(pPos->sizeInBytes, 64 * 32 * 16);
+    EXPECT(!pPos->persistent);
+
+    // Depth is created by the G-buffer pass but only used by the culled debug pass.
+    const auto* pDepth = findResource(plan, "GBuffer.depth");
+    EXPECT(pDepth != nullptr);
+    EXPECT_EQ(pDepth->firstUse, 0);
+    EXPECT_EQ(pDepth->lastUse, 0);
+
+    const auto* pScratch = findResource(plan, "Lighting.scratch");
+    EXPECT(pScratch != nullptr);
+    EXPECT(pScratch->type == Field::Type::RawBuffer);
+    EXPECT_EQ(pScratch->sizeInBytes, 1024);
+
+    // The graph output uses the default format, the full mip chain and lives until the end of the graph.
+    const auto* pOut = findResource(plan, "ToneMap.dst");
+    EXPECT(pOut != nullptr);
+    EXPECT(pOut->format == kFormat);
+    EXPECT_EQ(pOut->mipCount, 7);
+    EXPECT_EQ(pOut->lastUse, 2);
+    EXPECT(pOut->persistent);
+    uint64_t mipChainSize = 0;
+    for (uint32_t w = 64, h = 32; w > 0; w >>= 1, h >>= 1)
+        mipChainSize += w * std::max(h, 1u) * 4;
+    EXPECT_EQ(pOut->sizeInBytes, mipChainSize);
+
+    uint64_t totalBytes = 0;
+    for (const auto& r : plan.resources)
+        totalBytes += r.sizeInBytes;
+    EXPECT_EQ(plan.totalBytes, totalBytes);
+}
+
+CPU_TEST(RenderGraphPlanner_Aliasing)
+{
+    auto plan = Planner::plan(createGraph(), kResolution, kFormat);
+
+    // Resources sharing a memory slot must have disjoint lifetimes, and persistent resources must not share.
+    for (size_t i = 0; i < plan.resources.size(); i++)
+    {
+        const auto& a = plan.resources[i];
+        EXPECT_LT(a.memorySlot, plan.memorySlotCount);
+        for (size_t j = i + 1; j < plan.resources.size(); j++)
+        {
+            const auto& b = plan.resources[j];
+            if (a.memorySlot != b.memorySlot)
+                continue;
+            EXPECT(!a.persistent && !b.persistent);
+            EXPECT(a.lastUse < b.firstUse || b.lastUse < a.firstUse);
+        }
+    }
+
+    // Depth and scratch can reuse memory of resources that are no longer used.
+    EXPECT_LT(plan.memorySlotCount, plan.resources.size());
+    EXPECT_LT(plan.aliasedBytes, plan.totalBytes);
+
+    // Doubling the resolution scales the texture sizes.
+    auto plan2 = Planner::plan(createGraph(), kResolution * 2u, kFormat);
+    EXPECT_EQ(findResource(plan2, "GBuffer.posW")->sizeInBytes, 4 * findResource(plan, "GBuffer.posW")->sizeInBytes);
+    EXPECT_EQ(findResource(plan2, "Lighting.scratch")->sizeInBytes, 1024);
+}
+
+CPU_TEST(RenderGraphPlanner_ResolutionReflection)
+{
+    // The lighting pass uses a quarter-resolution buffer at 4K.
+    const uint2 k4K = {3840, 2160};
+    auto desc = createGraph();
+    Planner::ReflectionDesc reflection4K{k4K, kFormat, desc.passes[1].reflection};
+    reflection4K.reflection.getField("color")->texture2D(k4K.x / 4, k4K.y / 4);
+    desc.passes[1].reflections.push_back(reflection4K);
+
+    auto plan = Planner::plan(desc, kResolution, kFormat);
+    EXPECT_EQ(findResource(plan, "Lighting.color")->width, kResolution.x);
+    ASSERT_EQ(plan.warnings.size(), 1);
+    EXPECT(plan.warnings[0].find("'Lighting'") != std::string::npos);
+
+    auto plan4K = Planner::plan(desc, k4K, kFormat);
+    EXPECT_EQ(findResource(plan4K, "Lighting.color")->width, k4K.x / 4);
+    EXPECT_EQ(findResource(plan4K, "Lighting.color")->height, k4K.y / 4);
+    EXPECT_EQ(findResource(plan4K, "GBuffer.posW")->width, k4K.x);
+    EXPECT(plan4K.warnings.empty());
+
+    // A reflection that only breaks the graph at some resolutions is reported for these resolutions.
+    desc.passes[1].reflections[0].reflection.getField("normW")->visibility(Field::Visibility::Output);
+    EXPECT(Planner::validate(desc).empty());
+    EXPECT_THROW(Planner::plan(desc, k4K, kFormat));
+    std::string report = Planner::createReport(desc, {kResolution, k4K}, kFormat);
+    EXPECT(report.find("\"valid\": false") != std::string::npos);
+    EXPECT(report.find("3840x2160: Edge destination 'Lighting.normW' is not an input field.") != std::string::npos);
+
+    // The reflections are stored with the description.
+    auto desc2 = Planner::deserialize(Planner::serialize(desc));
+    ASSERT_EQ(desc2.passes[1].reflections.size(), 1);
+    EXPECT(all(desc2.passes[1].reflections[0].resolution == k4K));
+    EXPECT(desc2.passes[1].reflections[0].defaultFormat == kFormat);
+    EXPECT_EQ(desc2.passes[1].reflections[0].reflection.getField("color")->getWidth(), k4K.x / 4);
+    EXPECT(desc2.passes[0].reflections.empty());
+}
+
+CPU_TEST(RenderGraphPlanner_ResolvePasses)
+{
+    // A multi-sampled output is resolved before it is read by a single-sampled input, but not before a multi-sampled input.
+    Planner::GraphDesc desc;
+    desc.name = "MSAA";
+
+    Planner::PassDesc raster{"Raster", {}};
+    raster.reflection.addOutput("color", "").format(ResourceFormat::RGBA16Float).texture2D(0, 0, 4);
+    desc.passes.push_back(raster);
+
+    Planner::PassDesc msaaDebug{"MSAADebug", {}};
+    msaaDebug.reflection.addInput("src", "").texture2D(0, 0, 4);
+    msaaDebug.reflection.addOutput("dst", "");
+    desc.passes.push_back(msaaDebug);
+
+    Planner::PassDesc tonemap{"ToneMap", {}};
+    tonemap.reflection.addInput("src", "").texture2D(0, 0, 1);
+    tonemap.reflection.addOutput("dst", "");
+    desc.passes.push_back(tonemap);
+
+    desc.edges = {{"Raster.color", "ToneMap.src"}, {"Raster.color", "MSAADebug.src"}};
+    desc.outputs = {"ToneMap.dst", "MSAADebug.dst"};
+
+    auto plan = Planner::plan(desc, kResolution, kFormat);
+    EXPECT(plan.generatedPasses == std::vector<std::string>({"Raster.color-ResolvePass"}));
+    EXPECT(plan.executionOrder == std::vector<std::string>({"Raster", "MSAADebug", "Raster.color-ResolvePass", "ToneMap"}));
+
+    const auto* pColor = findResource(plan, "Raster.color");
+    ASSERT(pColor != nullptr);
+    EXPECT_EQ(pColor->sampleCount, 4);
+    EXPECT(pColor->aliases == std::vector<std::string>({"MSAADebug.src", "Raster.color-ResolvePass.src"}));
+    EXPECT_EQ(pColor->sizeInBytes, 64 * 32 * 8 * 4);
+
+    const auto* pResolved = findResource(plan, "Raster.color-ResolvePass.dst");
+    ASSERT(pResolved != nullptr);
+    EXPECT_EQ(pResolved->sampleCount, 1);
+    EXPECT(pResolved->format == ResourceFormat::RGBA16Float);
+    EXPECT(pResolved->aliases == std::vector<std::string>({"ToneMap.src"}));
+
+    // The user's description is not modified.
+    EXPECT_EQ(desc.passes.size(), 3);
+}
+
+CPU_TEST(RenderGraphPlanner_Serialize)
+{
+    auto desc = createGraph();
+    auto desc2 = Planner::deserialize(Planner::serialize(desc));
+
+    EXPECT_EQ(desc2.name, desc.name);
+    EXPECT(desc2.outputs == desc.outputs);
+    EXPECT_EQ(desc2.edges.size(), desc.edges.size());
+    EXPECT_EQ(desc2.passes.size(), desc.passes.size());
+    for (size_t i = 0; i < desc.passes.size(); i++)
+    {
+        const auto& reflection = desc.passes[i].reflection;
+        const auto& reflection2 = desc2.passes[i].reflection;
+        EXPECT_EQ(desc2.passes[i].name, desc.passes[i].name);
+        EXPECT_EQ(reflection2.getFieldCount(), reflection.getFieldCount());
+        for (size_t f = 0; f < reflection.getFieldCount(); f++)
+        {
+            // Dimensions that don't apply to the resource type are normalized by the field builders, so compare the others.
+            const Field& field = *reflection.getField(f);
+            const Field& field2 = *reflection2.getField(f);
+            EXPECT_EQ(field2.getName(), field.getName());
+            EXPECT(field2.getType() == field.getType());
+            EXPECT(field2.getVisibility() == field.getVisibility());
+            EXPECT(field2.getFlags() == field.getFlags());
+            EXPECT(field2.getFormat() == field.getFormat());
+            EXPECT_EQ(field2.getWidth(), field.getWidth());
+            EXPECT_EQ(field2.getMipCount(), field.getMipCount());
+        }
+    }
+
+    // Round-tripping a deserialized description is lossless.
+    EXPECT_EQ(Planner::serialize(Planner::deserialize(Planner::serialize(desc2))), Planner::serialize(desc2));
+    EXPECT_EQ(
+        Planner::createReport(desc2, {kResolution}, kFormat),
+        Planner::createReport(desc, {kResolution}, kFormat)
+    );
+
+    EXPECT_THROW(Planner::deserialize("{"));
+    EXPECT_THROW(Planner::deserialize(R"({"passes": [{"name": "A", "fields": [{"name": "a", "visibility": 2, "type": "Foo"}]}]})"));
+}
+} // namespace Falcor
@@ -0,0 +1,225 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "RenderGraph/RenderGraphScheduler.h"
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+using Scheduler = RenderGraphScheduler;
+using Queue = RenderGraphScheduler::Queue;
+
+std::vector<Scheduler::PassDesc> makePasses(uint32_t count, std::vector<uint32_t> asyncCapable = {})
+{
+    std::vector<Scheduler::PassDesc> passes(count);
+    for (uint32_t i : asyncCapable)
+        passes[i].asyncComputeCapable = true;
+    return passes;
+}
+
+/// Check the invariants of a schedule against the dependencies it was built from.
+void checkSchedule(CPUUnitTestContext& ctx, const Scheduler::Schedule& s, const std::vector<Scheduler::Dependency>& deps, uint32_t passCount)
+{
+    ASSERT_EQ(s.order.size(), passCount);
+    ASSERT_EQ(s.queues.size(), passCount);
+    ASSERT_EQ(s.levels.size(), passCount);
+
+    std::vector<uint32_t> position(passCount, uint32_t(-1));
+    for (uint32_t i = 0; i < passCount; i++)
+    {
+        ASSERT_LT(s.order[i], passCount);
+        EXPECT_EQ(position[s.order[i]], uint32_t(-1));
+        position[s.order[i]] = i;
+    }
+
+    for (const auto& d : deps)
+    {
+        EXPECT_LT(position[d.src], position[d.dst]);
+        EXPECT_LT(s.levels[d.src], s.levels[d.dst]);
+
+        // Cross-queue dependencies must be covered by a wait of the consumer queue on the producer or a later pass on its queue.
+        if (s.queues[d.src] != s.queues[d.dst])
+        {
+            bool covered = false;
+            for (const auto& sync : s.syncs)
+            {
+                if (sync.waitQueue != s.queues[d.dst] || sync.signalQueue != s.queues[d.src] || sync.waitPass == Scheduler::kEndOfGraph)
+                    continue;
+                covered = covered || (position[sync.signalPass] >= position[d.src] && position[sync.waitPass] <= position[d.dst]);
+            }
+            EXPECT(covered);
+        }
+    }
+
+    // Every pass is in exactly one group. Groups hold passes of one queue, and follow the submission order on their queue.
+    std::vector<uint32_t> groupCount(passCount, 0);
+    int64_t lastPosition[Scheduler::kQueueCount] = {-1, -1};
+    for (const auto& group : s.recordingGroups)
+    {
+        ASSERT(!group.empty());
+        uint32_t q = (uint32_t)s.queues[group[0]];
+        for (uint32_t pass : group)
+        {
+            groupCount[pass]++;
+            EXPECT_EQ(s.queues[pass], s.queues[group[0]]);
+            EXPECT_GT((int64_t)position[pass], lastPosition[q]);
+            lastPosition[q] = position[pass];
+        }
+    }
+    for (uint32_t i = 0; i < passCount; i++)
+        EXPECT_EQ(groupCount[i], 1);
+}
+} // namespace
+
+CPU_TEST(RenderGraphScheduler_Chain)
+{
+    std::vector<Scheduler::Dependency> deps = {{0, 1}, {1, 2}, {2, 3}};
+    auto s = Scheduler::build(makePasses(4, {2}), deps);
+    checkSchedule(ctx, s, deps, 4);
+
+    EXPECT(s.order == std::vector<uint32_t>({0, 1, 2, 3}));
+    EXPECT_EQ(s.levelCount, 4);
+    // Nothing to overlap with, so the compute pass stays on the graphics queue.
+    EXPECT_EQ(s.getPassCount(Queue::AsyncCompute), 0);
+    EXPECT(s.syncs.empty());
+    EXPECT_EQ(s.recordingGroups.size(), 4);
+}
+
+CPU_TEST(RenderGraphScheduler_Order)
+{
+    // The input order is kept where possible, and fixed where the dependencies require it.
+    std::vector<Scheduler::Dependency> deps = {{2, 0}};
+    auto s = Scheduler::build(makePasses(3), deps);
+    checkSchedule(ctx, s, deps, 3);
+    EXPECT(s.order == std::vector<uint32_t>({1, 2, 0}));
+}
+
+CPU_TEST(RenderGraphScheduler_AsyncCompute)
+{
+    // 0 -> 1 (compute) -> 3
+    // 0 -> 2 (graphics) -> 3
+    std::vector<Scheduler::Dependency> deps = {{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    auto s = Scheduler::build(makePasses(4, {1}), deps);
+    checkSchedule(ctx, s, deps, 4);
+
+    EXPECT_EQ(s.queues[1], Queue::AsyncCompute);
+    EXPECT_EQ(s.getPassCount(Queue::Graphics), 3);
+    EXPECT_EQ(s.levels[1], s.levels[2]);
+    ASSERT_EQ(s.syncs.size(), 2);
+    EXPECT_EQ(s.syncs[0].signalPass, 0);
+    EXPECT_EQ(s.syncs[0].waitPass, 1);
+    EXPECT_EQ(s.syncs[0].waitQueue, Queue::AsyncCompute);
+    EXPECT_EQ(s.syncs[1].signalPass, 1);
+    EXPECT_EQ(s.syncs[1].waitPass, 3);
+    EXPECT_EQ(s.syncs[1].waitQueue, Queue::Graphics);
+
+    // Disabling async compute keeps everything on the graphics queue.
+    Scheduler::Options options;
+    options.enableAsyncCompute = false;
+    s = Scheduler::build(makePasses(4, {1}), deps, options);
+    checkSchedule(ctx, s, deps, 4);
+    EXPECT_EQ(s.getPassCount(Queue::AsyncCompute), 0);
+    EXPECT(s.syncs.empty());
+}
+
+CPU_TEST(RenderGraphScheduler_RedundantSyncs)
+{
+    // Graphics passes 0 -> 1, compute passes 2 and 3 both read 0 and 1, graphics pass 4 is independent.
+    std::vector<Scheduler::Dependency> deps = {{0, 1}, {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 3}};
+    auto s = Scheduler::build(makePasses(5, {2, 3}), deps);
+    checkSchedule(ctx, s, deps, 5);
+
+    EXPECT_EQ(s.queues[2], Queue::AsyncCompute);
+    EXPECT_EQ(s.queues[3], Queue::AsyncCompute);
+    // A single wait on pass 1 covers all dependencies of the compute queue. The graphics queue waits for pass 3 at the end.
+    ASSERT_EQ(s.syncs.size(), 2);
+    EXPECT_EQ(s.syncs[0].signalPass, 1);
+    EXPECT_EQ(s.syncs[0].waitPass, 2);
+    EXPECT_EQ(s.syncs[1].signalPass, 3);
+    EXPECT_EQ(s.syncs[1].waitPass, Scheduler::kEndOfGraph);
+}
+
+CPU_TEST(RenderGraphScheduler_RecordingGroups)
+{
+    std::vector<Scheduler::Dependency> deps = {{0, 3}, {1, 3}, {2, 3}};
+    auto s = Scheduler::build(makePasses(4), deps);
+    checkSchedule(ctx, s, deps, 4);
+    ASSERT_EQ(s.recordingGroups.size(), 2);
+    EXPECT(s.recordingGroups[0] == std::vector<uint32_t>({0, 1, 2}));
+    EXPECT(s.recordingGroups[1] == std::vector<uint32_t>({3}));
+
+    Scheduler::Options options;
+    options.enableParallelRecording = false;
+    s = Scheduler::build(makePasses(4), deps, options);
+    checkSchedule(ctx, s, deps, 4);
+    EXPECT_EQ(s.recordingGroups.size(), 4);
+}
+
+CPU_TEST(RenderGraphScheduler_Errors)
+{
+    EXPECT_THROW(Scheduler::build(makePasses(3), {{0, 1}, {1, 2}, {2, 0}}));
+    EXPECT_THROW(Scheduler::build(makePasses(2), {{0, 2}}));
+    EXPECT_THROW(Scheduler::build(makePasses(2), {{1, 1}}));
+
+    auto s = Scheduler::build({}, {});
+    EXPECT(s.order.empty());
+    EXPECT_EQ(s.levelCount, 0);
+}
+
+CPU_TEST(RenderGraphScheduler_Random)
+{
+    std::mt19937 rng(1234);
+    for (uint32_t iter = 0; iter < 100; iter++)
+    {
+        uint32_t passCount = 1 + rng() % 40;
+
+        // Random DAG over a random permutation of the passes.
+        std::vector<uint32_t> perm(passCount);
+        for (uint32_t i = 0; i < passCount; i++)
+            perm[i] = i;
+        std::shuffle(perm.begin(), perm.end(), rng);
+
+        std::vector<Scheduler::Dependency> deps;
+        for (uint32_t i = 0; i < passCount; i++)
+            for (uint32_t j = i + 1; j < passCount; j++)
+                if (rng() % 8 == 0)
+                    deps.push_back({perm[i], perm[j]});
+
+        auto passes = makePasses(passCount);
+        for (auto& p : passes)
+            p.asyncComputeCapable = rng() % 3 == 0;
+
+        auto s = Scheduler::build(passes, deps);
+        checkSchedule(ctx, s, deps, passCount);
+        for (uint32_t i = 0; i < passCount; i++)
+            EXPECT(s.queues[i] == Queue::Graphics || passes[i].asyncComputeCapable);
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,509 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Rendering/Lights/LightBVHBuilder.h"
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+using MeshLightTriangle = LightCollection::MeshLightTriangle;
+
+const uint32_t kClusterCount = 16;
+const uint32_t kTrianglesPerCluster = 256;
+
+/// Create small emissive triangles in clusters placed along the x axis.
+std::vector<MeshLightTriangle> createTriangles(std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+    std::vector<MeshLightTriangle> triangles;
+    for (uint32_t c = 0; c < kClusterCount; c++)
+    {
+        for (uint32_t i = 0; i < kTrianglesPerCluster; i++)
+        {
+            float3 p = float3(10.f * c, 0.f, 0.f) + float3(u(rng), u(rng), u(rng));
+            MeshLightTriangle tri;
+            tri.vtx[0].pos = p;
+            tri.vtx[1].pos = p + float3(0.01f, 0.f, 0.f);
+            tri.vtx[2].pos = p + float3(0.f, 0.01f, 0.f);
+            tri.normal = float3(0.f, 0.f, 1.f);
+            tri.flux = 1.f + u(rng);
+            triangles.push_back(tri);
+        }
+    }
+    return triangles;
+}
+
+/// Move the triangles of a cluster to random positions in a region scaled from the cluster bounds.
+void scatterCluster(std::vector<MeshLightTriangle>& triangles, uint32_t cluster, float scale, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> u(0.f, scale);
+    for (uint32_t i = cluster * kTrianglesPerCluster; i < (cluster + 1) * kTrianglesPerCluster; i++)
+    {
+        float3 offset = float3(10.f * cluster, 0.f, 0.f) + float3(u(rng), u(rng), u(rng)) - triangles[i].vtx[0].pos;
+        for (auto& v : triangles[i].vtx)
+            v.pos += offset;
+    }
+}
+
+bool contains(float3 aabbMin, float3 aabbMax, const AABB& bounds)
+{
+    // The node extents are stored in half precision.
+    const float3 eps = max(abs(aabbMin), abs(aabbMax)) * 1e-3f + 1e-3f;
+    return all(aabbMin - eps <= bounds.minPoint) && all(bounds.maxPoint <= aabbMax + eps);
+}
+
+/// Check the structure of the BVH and that the nodes bound the triangles.
+void validateBVH(CPUUnitTestContext& ctx, const LightBVHBuilder::BVHData& data, const std::vector<MeshLightTriangle>& triangles)
+{
+    ASSERT(!data.nodes.empty());
+    ASSERT_EQ(data.referenceCosts.size(), data.nodes.size());
+    ASSERT_EQ(data.triangleIndices.size(), triangles.size());
+    ASSERT_EQ(data.triangleBitmasks.size(), triangles.size());
+
+    std::vector<uint32_t> visitCount(triangles.size(), 0);
+    uint32_t visitedNodeCount = 0;
+    uint32_t nextTriangleOffset = 0;
+
+    struct Location
+    {
+        uint32_t nodeIndex;
+        uint32_t depth;
+        uint64_t bitmask;
+    };
+    std::vector<Location> stack = {{0, 0, 0ull}};
+    while (!stack.empty())
+    {
+        Location location = stack.back();
+        stack.pop_back();
+        visitedNodeCount++;
+
+        const PackedNode& node = data.nodes[location.nodeIndex];
+        SharedNodeAttributes attribs = node.getNodeAttributes();
+        float3 aabbMin, aabbMax;
+        attribs.getAABB(aabbMin, aabbMax);
+
+        if (node.isLeaf())
+        {
+            LeafNode leaf = node.getLeafNode();
+            EXPECT_EQ(leaf.triangleOffset, nextTriangleOffset);
+            nextTriangleOffset += leaf.triangleCount;
+            for (uint32_t i = leaf.triangleOffset; i < leaf.triangleOffset + leaf.triangleCount; i++)
+            {
+                uint32_t triangleIndex = data.triangleIndices[i];
+                visitCount[triangleIndex]++;
+                EXPECT_EQ(data.triangleBitmasks[triangleIndex], location.bitmask);
+                AABB bounds;
+                for (const auto& v : triangles[triangleIndex].vtx)
+                    bounds |= v.pos;
+                EXPECT(contains(aabbMin, aabbMax, bounds));
+            }
+        }
+        else
+        {
+            uint32_t rightIndex = node.getInternalNode().rightChildIdx;
+            EXPECT_GT(rightIndex, location.nodeIndex + 1);
+            for (uint32_t childIndex : {location.nodeIndex + 1, rightIndex})
+            {
+                SharedNodeAttributes childAttribs = data.nodes[childIndex].getNodeAttributes();
+                float3 childMin, childMax;
+                childAttribs.getAABB(childMin, childMax);
+                EXPECT(contains(aabbMin, aabbMax, AABB(childMin, childMax)));
+            }
+            stack.push_back({rightIndex, location.depth + 1, location.bitmask | (1ull << location.depth)});
+            stack.push_back({location.nodeIndex + 1, location.depth + 1, location.bitmask});
+        }
+    }
+
+    EXPECT_EQ(visitedNodeCount, data.nodes.size());
+    for (uint32_t count : visitCount)
+        EXPECT_EQ(count, 1);
+}
+
+/// Tilt the triangle normals randomly. Half of the clusters face the negative z axis.
+void tiltNormals(std::vector<MeshLightTriangle>& triangles, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> u(-0.5f, 0.5f);
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        float z = (i / kTrianglesPerCluster) % 2 == 0 ? 1.f : -1.f;
+        triangles[i].normal = normalize(float3(u(rng), u(rng), z));
+    }
+}
+
+float angleBetween(float3 a, float3 b)
+{
+    return std::acos(std::clamp(dot(a, b), -1.f, 1.f));
+}
+
+/// Node importance as computed by LightBVHSampler with the lighting cone, the bounding cone and a bounding sphere.
+float computeImportance(const SharedNodeAttributes& attribs, float3 posW, float3 normalW)
+{
+    float3 toNode = attribs.origin - posW;
+    float distance = length(toNode);
+
+    float sinThetaBoundingCone = 0.f;
+    float cosThetaBoundingCone = -1.f;
+    float sqrRadius = dot(attribs.extent, attribs.extent);
+    if (dot(toNode, toNode) >= sqrRadius)
+    {
+        float sin2Theta = sqrRadius / dot(toNode, toNode);
+        cosThetaBoundingCone = std::sqrt(1.f - sin2Theta);
+        sinThetaBoundingCone = std::sqrt(sin2Theta);
+    }
+
+    auto cosSubClamped = [](float sinA, float cosA, float sinB, float cosB) { return cosA > cosB ? 1.f : cosA * cosB + sinA * sinB; };
+    auto sinSubClamped = [](float sinA, float cosA, float sinB, float cosB) { return cosA > cosB ? 0.f : sinA * cosB - cosA * sinB; };
+
+    float cosThetaL = std::clamp(dot(normalW, normalize(toNode)), -1.f, 1.f);
+    float sinThetaL = std::sqrt(1.f - cosThetaL * cosThetaL);
+    float NdotL = std::clamp(cosSubClamped(sinThetaL, cosThetaL, sinThetaBoundingCone, cosThetaBoundingCone), 0.f, 1.f);
+
+    float orientationWeight = 1.f;
+    float cosConeAngle = attribs.cosConeAngle;
+    if (cosConeAngle != kInvalidCosConeAngle && cosConeAngle > 0.f)
+    {
+        float sinConeAngle = std::sqrt(std::max(0.f, 1.f - cosConeAngle * cosConeAngle));
+        float cosTheta = dot(attribs.coneDirection, -toNode / distance);
+        float sinTheta = std::sqrt(std::max(0.f, 1.f - cosTheta * cosTheta));
+        float cosTheta0 = cosSubClamped(sinTheta, cosTheta, sinConeAngle, cosConeAngle);
+        float sinTheta0 = sinSubClamped(sinTheta, cosTheta, sinConeAngle, cosConeAngle);
+        orientationWeight = std::max(0.f, cosSubClamped(sinTheta0, cosTheta0, sinThetaBoundingCone, cosThetaBoundingCone));
+    }
+
+    float halfRadius = std::max(attribs.extent.x, std::max(attribs.extent.y, attribs.extent.z));
+    distance = std::max(halfRadius, distance);
+    return attribs.flux * NdotL * orientationWeight / (distance * distance);
+}
+
+/// Compute the probability of the traversal reaching each node from a shading point.
+std::vector<float> computeNodePdfs(const std::vector<PackedNode>& nodes, const std::vector<SharedNodeAttributes>& attribs, float3 posW, float3 normalW)
+{
+    std::vector<float> pdfs(nodes.size(), 0.f);
+    pdfs[0] = 1.f;
+    for (uint32_t nodeIndex = 0; nodeIndex < nodes.size(); nodeIndex++)
+    {
+        if (nodes[nodeIndex].isLeaf() || pdfs[nodeIndex] == 0.f)
+            continue;
+        uint32_t leftIndex = nodeIndex + 1;
+        uint32_t rightIndex = nodes[nodeIndex].getInternalNode().rightChildIdx;
+        float leftImportance = computeImportance(attribs[leftIndex], posW, normalW);
+        float rightImportance = computeImportance(attribs[rightIndex], posW, normalW);
+        float totalImportance = leftImportance + rightImportance;
+        if (totalImportance == 0.f)
+            continue;
+        pdfs[leftIndex] = pdfs[nodeIndex] * leftImportance / totalImportance;
+        pdfs[rightIndex] = pdfs[nodeIndex] * rightImportance / totalImportance;
+    }
+    return pdfs;
+}
+
+const LightBVHBuilder::SplitHeuristic kHeuristics[] = {
+    LightBVHBuilder::SplitHeuristic::Equal,
+    LightBVHBuilder::SplitHeuristic::BinnedSAH,
+    LightBVHBuilder::SplitHeuristic::BinnedSAOH,
+};
+} // namespace
+
+CPU_TEST(LightBVHBuilder_Refit)
+{
+    for (auto heuristic : kHeuristics)
+    {
+        LightBVHBuilder::Options options;
+        options.splitHeuristicSelection = heuristic;
+        LightBVHBuilder builder(options);
+
+        std::mt19937 rng(1);
+        auto triangles = createTriangles(rng);
+        LightBVHBuilder::BVHData data;
+        builder.buildData(triangles, data);
+        validateBVH(ctx, data, triangles);
+
+        auto stats = builder.evalQuality(data);
+        EXPECT_EQ(stats.getCostRatio(), 1.f);
+        EXPECT_EQ(stats.degradedSubtreeCount, 0);
+
+        // Refitting static geometry doesn't change the BVH quality.
+        auto nodes = data.nodes;
+        builder.refitData(triangles, data);
+        validateBVH(ctx, data, triangles);
+        EXPECT_LT(std::abs(builder.evalQuality(data).getCostRatio() - 1.f), 1e-3f);
+        EXPECT_EQ(builder.rebuildDegradedSubtrees(triangles, data).degradedSubtreeCount, 0);
+        EXPECT_EQ(data.nodes.size(), nodes.size());
+
+        // Refitting moved geometry keeps the hierarchy but bounds the new positions.
+        for (auto& tri : triangles)
+            for (auto& v : tri.vtx)
+                v.pos = v.pos * 2.f + float3(1.f, 2.f, 3.f);
+        builder.refitData(triangles, data);
+        validateBVH(ctx, data, triangles);
+        ASSERT_EQ(data.nodes.size(), nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            EXPECT_EQ(data.nodes[i].isLeaf(), nodes[i].isLeaf());
+            EXPECT_EQ(data.nodes[i].data[0].x, nodes[i].data[0].x);
+        }
+    }
+}
+
+CPU_TEST(LightBVHBuilder_PartialRebuild)
+{
+    for (auto heuristic : kHeuristics)
+    {
+        LightBVHBuilder::Options options;
+        options.splitHeuristicSelection = heuristic;
+        LightBVHBuilder builder(options);
+
+        std::mt19937 rng(2);
+        auto triangles = createTriangles(rng);
+        LightBVHBuilder::BVHData data;
+        builder.buildData(triangles, data);
+
+        // Shuffle the triangles of one cluster so that its subtree degrades after refitting.
+        scatterCluster(triangles, 5, 1.f, rng);
+        builder.refitData(triangles, data);
+        auto degraded = builder.evalQuality(data);
+        EXPECT_GT(degraded.getCostRatio(), 1.f);
+        EXPECT_EQ(degraded.degradedSubtreeCount, 1);
+        EXPECT_EQ(degraded.degradedTriangleCount, kTrianglesPerCluster);
+
+        // Only the degraded subtree is rebuilt.
+        auto stats = builder.rebuildDegradedSubtrees(triangles, data);
+        EXPECT_EQ(stats.degradedSubtreeCount, degraded.degradedSubtreeCount);
+        EXPECT_EQ(stats.degradedTriangleCount, degraded.degradedTriangleCount);
+        validateBVH(ctx, data, triangles);
+
+        auto rebuilt = builder.evalQuality(data);
+        EXPECT_LT(rebuilt.cost, degraded.cost);
+        EXPECT_LT(rebuilt.getCostRatio(), degraded.getCostRatio());
+        EXPECT_EQ(rebuilt.degradedSubtreeCount, 0);
+
+        // The result is close to a BVH built from scratch.
+        LightBVHBuilder::BVHData reference;
+        builder.buildData(triangles, reference);
+        EXPECT_LE(rebuilt.cost, 1.1f * builder.evalQuality(reference).cost);
+    }
+}
+
+CPU_TEST(LightBVHBuilder_PartialRebuildExpanding)
+{
+    for (auto heuristic : kHeuristics)
+    {
+        LightBVHBuilder::Options options;
+        options.splitHeuristicSelection = heuristic;
+        LightBVHBuilder builder(options);
+
+        std::mt19937 rng(3);
+        auto triangles = createTriangles(rng);
+        LightBVHBuilder::BVHData data;
+        builder.buildData(triangles, data);
+
+        // Expand one cluster. This also degrades the ancestors of its subtree, which are rebuilt by later updates.
+        scatterCluster(triangles, 5, 8.f, rng);
+        builder.refitData(triangles, data);
+        auto stats = builder.rebuildDegradedSubtrees(triangles, data);
+        EXPECT_EQ(stats.degradedSubtreeCount, 1);
+        EXPECT_EQ(stats.degradedTriangleCount, kTrianglesPerCluster);
+        validateBVH(ctx, data, triangles);
+
+        uint32_t updateCount = 1;
+        while (stats.degradedSubtreeCount > 0 && updateCount < 64)
+        {
+            builder.refitData(triangles, data);
+            stats = builder.rebuildDegradedSubtrees(triangles, data);
+            validateBVH(ctx, data, triangles);
+            updateCount++;
+        }
+        EXPECT_EQ(stats.degradedSubtreeCount, 0);
+
+        LightBVHBuilder::BVHData reference;
+        builder.buildData(triangles, reference);
+        EXPECT_LE(builder.evalQuality(data).cost, 1.1f * builder.evalQuality(reference).cost);
+    }
+}
+
+CPU_TEST(LightBVHBuilder_CompactNodes)
+{
+    EXPECT_EQ(2 * sizeof(CompactNode), sizeof(PackedNode));
+
+    for (auto heuristic : kHeuristics)
+    {
+        LightBVHBuilder::Options options;
+        options.splitHeuristicSelection = heuristic;
+        LightBVHBuilder builder(options);
+
+        std::mt19937 rng(4);
+        auto triangles = createTriangles(rng);
+        tiltNormals(triangles, rng);
+        LightBVHBuilder::BVHData data;
+        builder.buildData(triangles, data);
+
+        auto compactData = LightBVHBuilder::encodeCompactNodes(data.nodes);
+        ASSERT_EQ(compactData.nodes.size(), data.nodes.size());
+        auto decoded = LightBVHBuilder::decodeCompactNodes(compactData);
+        ASSERT_EQ(decoded.size(), data.nodes.size());
+
+        // Compute the bounds of the triangles in each subtree. The children are stored after their parent.
+        std::vector<AABB> triangleBounds(data.nodes.size());
+        for (uint32_t nodeIndex = (uint32_t)data.nodes.size(); nodeIndex-- > 0;)
+        {
+            const PackedNode& node = data.nodes[nodeIndex];
+            if (node.isLeaf())
+            {
+                LeafNode leaf = node.getLeafNode();
+                for (uint32_t i = leaf.triangleOffset; i < leaf.triangleOffset + leaf.triangleCount; i++)
+                    for (const auto& v : triangles[data.triangleIndices[i]].vtx)
+                        triangleBounds[nodeIndex] |= v.pos;
+            }
+            else
+            {
+                triangleBounds[nodeIndex] = triangleBounds[nodeIndex + 1] | triangleBounds[node.getInternalNode().rightChildIdx];
+            }
+        }
+
+        std::vector<uint32_t> parentIndices(data.nodes.size(), 0);
+        for (uint32_t nodeIndex = 0; nodeIndex < data.nodes.size(); nodeIndex++)
+        {
+            const PackedNode& node = data.nodes[nodeIndex];
+            const CompactNode& compactNode = compactData.nodes[nodeIndex];
+            const SharedNodeAttributes& parent = nodeIndex == 0 ? compactData.rootAttribs : decoded[parentIndices[nodeIndex]];
+            ASSERT_EQ(compactNode.isLeaf(), node.isLeaf());
+            if (node.isLeaf())
+            {
+                EXPECT_EQ(compactNode.getLeafNode(parent).triangleCount, node.getLeafNode().triangleCount);
+                EXPECT_EQ(compactNode.getLeafNode(parent).triangleOffset, node.getLeafNode().triangleOffset);
+            }
+            else
+            {
+                uint32_t rightIndex = node.getInternalNode().rightChildIdx;
+                EXPECT_EQ(compactNode.getInternalNode(parent).rightChildIdx, rightIndex);
+                parentIndices[nodeIndex + 1] = nodeIndex;
+                parentIndices[rightIndex] = nodeIndex;
+            }
+
+            // The decoded bounds contain the triangles and are at most one grid cell of the parent larger than the exact bounds.
+            SharedNodeAttributes exact = node.getNodeAttributes();
+            float3 exactMin, exactMax, decodedMin, decodedMax;
+            exact.getAABB(exactMin, exactMax);
+            decoded[nodeIndex].getAABB(decodedMin, decodedMax);
+            const AABB& bounds = triangleBounds[nodeIndex];
+            float3 eps = (abs(bounds.minPoint) + abs(bounds.maxPoint)) * 1e-6f;
+            EXPECT(all(decodedMin <= bounds.minPoint + eps) && all(bounds.maxPoint - eps <= decodedMax));
+            float3 cell = parent.extent * (2.f / CompactNode::kMaxQuantizedBounds) + eps;
+            EXPECT(all(exactMin - cell <= decodedMin) && all(decodedMax <= exactMax + cell));
+
+            // The decoded flux is rounded up to a fraction of the parent flux.
+            EXPECT_GE(decoded[nodeIndex].flux, exact.flux);
+            EXPECT_LE(decoded[nodeIndex].flux, exact.flux + 1.01f * parent.flux / CompactNode::kMaxQuantizedFlux);
+
+            // The decoded cone contains the exact cone and is only slightly wider.
+            if (exact.cosConeAngle != kInvalidCosConeAngle && decoded[nodeIndex].cosConeAngle != kInvalidCosConeAngle)
+            {
+                float exactAngle = std::acos(exact.cosConeAngle);
+                float decodedAngle = std::acos(decoded[nodeIndex].cosConeAngle);
+                EXPECT_LE(exactAngle + angleBetween(exact.coneDirection, decoded[nodeIndex].coneDirection), decodedAngle + 1e-4f);
+                EXPECT_LE(decodedAngle, exactAngle + 0.05f);
+            }
+            else
+            {
+                EXPECT_EQ(decoded[nodeIndex].cosConeAngle, kInvalidCosConeAngle);
+            }
+        }
+    }
+}
+
+CPU_TEST(LightBVHBuilder_CompactNodesConservativePdf)
+{
+    for (auto heuristic : kHeuristics)
+    {
+        LightBVHBuilder::Options options;
+        options.splitHeuristicSelection = heuristic;
+        LightBVHBuilder builder(options);
+
+        std::mt19937 rng(5);
+        auto triangles = createTriangles(rng);
+        tiltNormals(triangles, rng);
+        LightBVHBuilder::BVHData data;
+        builder.buildData(triangles, data);
+
+        std::vector<SharedNodeAttributes> exact;
+        for (const auto& node : data.nodes)
+            exact.push_back(node.getNodeAttributes());
+        auto decoded = LightBVHBuilder::decodeCompactNodes(LightBVHBuilder::encodeCompactNodes(data.nodes));
+
+        std::vector<uint32_t> leafIndices(triangles.size());
+        for (uint32_t nodeIndex = 0; nodeIndex < data.nodes.size(); nodeIndex++)
+        {
+            if (!data.nodes[nodeIndex].isLeaf())
+                continue;
+            LeafNode leaf = data.nodes[nodeIndex].getLeafNode();
+            for (uint32_t i = leaf.triangleOffset; i < leaf.triangleOffset + leaf.triangleCount; i++)
+                leafIndices[data.triangleIndices[i]] = nodeIndex;
+        }
+
+        const uint32_t kShadingPointCount = 32;
+        float totalPdfDifference = 0.f;
+        std::uniform_real_distribution<float> u(0.f, 1.f);
+        for (uint32_t i = 0; i < kShadingPointCount; i++)
+        {
+            float3 posW = float3(160.f * u(rng) - 5.f, 8.f * u(rng) - 4.f, 8.f * u(rng) - 4.f);
+            float3 normalW = normalize(float3(u(rng) - 0.5f, u(rng) - 0.5f, u(rng) - 0.5f));
+            auto exactPdfs = computeNodePdfs(data.nodes, exact, posW, normalW);
+            auto decodedPdfs = computeNodePdfs(data.nodes, decoded, posW, normalW);
+
+            // Every triangle that contributes to the shading point can still be sampled.
+            for (size_t j = 0; j < triangles.size(); j++)
+            {
+                const auto& tri = triangles[j];
+                bool frontFacing = dot(posW - tri.vtx[0].pos, tri.normal) > 0.f;
+                bool aboveHorizon = false;
+                for (const auto& v : tri.vtx)
+                    aboveHorizon |= dot(v.pos - posW, normalW) > 0.f;
+                if (frontFacing && aboveHorizon)
+                    EXPECT_GT(decodedPdfs[leafIndices[j]], 0.f);
+            }
+
+            // The leaf selection probabilities are close to the ones with the exact nodes.
+            float pdfSum = 0.f;
+            float pdfDifference = 0.f;
+            for (uint32_t nodeIndex = 0; nodeIndex < data.nodes.size(); nodeIndex++)
+            {
+                if (!data.nodes[nodeIndex].isLeaf())
+                    continue;
+                pdfSum += decodedPdfs[nodeIndex];
+                pdfDifference += std::abs(decodedPdfs[nodeIndex] - exactPdfs[nodeIndex]);
+            }
+            EXPECT_LT(pdfDifference, 0.25f);
+            totalPdfDifference += pdfDifference;
+            EXPECT_LE(pdfSum, 1.f + 1e-3f);
+        }
+        EXPECT_LT(totalPdfDifference / kShadingPointCount, 0.03f);
+    }
+}
+} // namespace Falcor
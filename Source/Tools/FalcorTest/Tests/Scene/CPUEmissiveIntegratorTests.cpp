@@ -0,0 +1,361 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AS IS AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Lights/CPUEmissiveIntegrator.h"
+#include "Scene/Lights/LightCollection.h"
+#include "Scene/SceneBuilder.h"
+#include "Scene/Material/StandardMaterial.h"
+#include "Utils/Color/ColorHelpers.slang"
+#include "Utils/Image/Bitmap.h"
+#include "Utils/Math/MathConstants.slangh"
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+using Triangle = CPUEmissiveIntegrator::Triangle;
+
+CPUEmissiveIntegrator::Texture createRandomTexture(uint32_t width, uint32_t height, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(0.f, 4.f);
+
+    CPUEmissiveIntegrator::Texture texture;
+    texture.width = width;
+    texture.height = height;
+    texture.texels.resize(width * height * 4);
+    for (auto& texel : texture.texels)
+        texel = u(rng);
+    return texture;
+}
+
+float3 getTexel(const CPUEmissiveIntegrator::Texture& texture, uint32_t x, uint32_t y)
+{
+    const float* p = texture.texels.data() + 4 * (y * texture.width + x);
+    return float3(p[0], p[1], p[2]);
+}
+
+/// Reference lookup of the texel at a texture coordinate, with the addressing modes defined on normalized coordinates.
+float3 lookupReference(const CPUEmissiveIntegrator::Texture& texture, double u, double v)
+{
+    auto address = [](double t, TextureAddressingMode mode, uint32_t size) -> int
+    {
+        switch (mode)
+        {
+        case TextureAddressingMode::Wrap:
+            t = t - std::floor(t);
+            break;
+        case TextureAddressingMode::Mirror:
+        {
+            double f = t - 2.0 * std::floor(t / 2.0);
+            t = f < 1.0 ? f : 2.0 - f;
+            break;
+        }
+        case TextureAddressingMode::Clamp:
+            t = std::clamp(t, 0.0, 1.0);
+            break;
+        case TextureAddressingMode::Border:
+            if (t < 0.0 || t >= 1.0)
+                return -1;
+            break;
+        case TextureAddressingMode::MirrorOnce:
+            t = std::clamp(std::abs(t), 0.0, 1.0);
+            break;
+        }
+        return std::min((int)std::floor(t * size), (int)size - 1);
+    };
+
+    int x = address(u, texture.addressModeU, texture.width);
+    int y = address(v, texture.addressModeV, texture.height);
+    if (x < 0 || y < 0)
+        return texture.borderColor.xyz();
+    return getTexel(texture, x, y);
+}
+
+/// Reference average over a triangle by dense point sampling of its bounding box in texture space.
+float3 computeReferenceAverage(const CPUEmissiveIntegrator::Texture& texture, const Triangle& tri)
+{
+    const uint32_t kSamples = 512;
+
+    const float2* p = tri.texCoords;
+    const float2 pMin = min(min(p[0], p[1]), p[2]);
+    const float2 pMax = max(max(p[0], p[1]), p[2]);
+
+    auto edge = [](float2 a, float2 b, double x, double y) { return double(b.x - a.x) * (y - a.y) - double(b.y - a.y) * (x - a.x); };
+    const double area = edge(p[0], p[1], p[2].x, p[2].y);
+
+    double sum[3] = {};
+    uint32_t count = 0;
+    for (uint32_t j = 0; j < kSamples; j++)
+    {
+        for (uint32_t i = 0; i < kSamples; i++)
+        {
+            double x = pMin.x + (pMax.x - pMin.x) * ((i + 0.5) / kSamples);
+            double y = pMin.y + (pMax.y - pMin.y) * ((j + 0.5) / kSamples);
+            if (edge(p[1], p[2], x, y) * area < 0.0 || edge(p[2], p[0], x, y) * area < 0.0 || edge(p[0], p[1], x, y) * area < 0.0)
+                continue;
+            float3 texel = lookupReference(texture, x, y);
+            for (uint32_t c = 0; c < 3; c++)
+                sum[c] += texel[c];
+            count++;
+        }
+    }
+    return count > 0 ? float3(float(sum[0] / count), float(sum[1] / count), float(sum[2] / count)) : float3(0.f);
+}
+
+float maxRelativeError(float3 a, float3 b)
+{
+    float3 d = abs(a - b) / max(abs(b), float3(1e-6f));
+    return std::max(std::max(d.x, d.y), d.z);
+}
+} // namespace
+
+CPU_TEST(CPUEmissiveIntegrator_Constant)
+{
+    CPUEmissiveIntegrator integrator;
+    CPUEmissiveIntegrator::Emitter emitter;
+    emitter.emissive = float3(1.f, 2.f, 3.f);
+    emitter.emissiveFactor = 2.f;
+    uint32_t emitterIndex = integrator.addEmitter(emitter);
+
+    Triangle tri;
+    tri.texCoords[0] = float2(0.f);
+    tri.texCoords[1] = float2(1.f, 0.f);
+    tri.texCoords[2] = float2(0.f, 1.f);
+    tri.area = 0.5f;
+    tri.emitterIndex = emitterIndex;
+
+    auto results = integrator.integrate(fstd::span<const Triangle>(&tri, 1));
+    EXPECT_EQ(results.size(), 1);
+    EXPECT(all(results[0].averageRadiance == float3(2.f, 4.f, 6.f)));
+    EXPECT_EQ(results[0].flux, luminance(float3(2.f, 4.f, 6.f)) * 0.5f * (float)M_PI);
+}
+
+CPU_TEST(CPUEmissiveIntegrator_Textured)
+{
+    CPUEmissiveIntegrator integrator;
+    CPUEmissiveIntegrator::Texture texture = createRandomTexture(2, 2, 1);
+    const CPUEmissiveIntegrator::Texture reference = texture;
+
+    CPUEmissiveIntegrator::Emitter emitter;
+    emitter.emissive = float3(100.f); // Ignored for textured emitters.
+    emitter.emissiveFactor = 3.f;
+    emitter.textureIndex = integrator.addTexture(std::move(texture));
+    uint32_t emitterIndex = integrator.addEmitter(emitter);
+
+    // The triangle covers texel (0,0) fully and half of texels (1,0) and (0,1).
+    // Copies offset by whole texture periods must give the same result with wrap addressing.
+    std::vector<Triangle> triangles;
+    for (float2 offset : {float2(0.f), float2(3.f, -2.f), float2(-7.f, 11.f)})
+    {
+        Triangle tri;
+        tri.texCoords[0] = float2(0.f, 0.f) + offset;
+        tri.texCoords[1] = float2(1.f, 0.f) + offset;
+        tri.texCoords[2] = float2(0.f, 1.f) + offset;
+        tri.area = 2.f;
+        tri.emitterIndex = emitterIndex;
+        triangles.push_back(tri);
+    }
+
+    const float3 expected = (getTexel(reference, 0, 0) + 0.5f * getTexel(reference, 1, 0) + 0.5f * getTexel(reference, 0, 1)) / 2.f * 3.f;
+
+    auto results = integrator.integrate(triangles);
+    EXPECT_EQ(results.size(), triangles.size());
+    for (const auto& result : results)
+    {
+        EXPECT_LE(maxRelativeError(result.averageRadiance, expected), 1e-5f);
+        EXPECT_LE(std::abs(result.flux - luminance(expected) * 2.f * (float)M_PI), 1e-4f * result.flux);
+    }
+}
+
+CPU_TEST(CPUEmissiveIntegrator_Degenerate)
+{
+    CPUEmissiveIntegrator integrator;
+    CPUEmissiveIntegrator::Texture texture = createRandomTexture(4, 4, 2);
+    const CPUEmissiveIntegrator::Texture reference = texture;
+
+    CPUEmissiveIntegrator::Emitter emitter;
+    emitter.textureIndex = integrator.addTexture(std::move(texture));
+    uint32_t emitterIndex = integrator.addEmitter(emitter);
+
+    // Triangles that are a line and a point in texture space use the average of the texels at the vertices.
+    Triangle line;
+    line.texCoords[0] = float2(0.1f, 0.1f);
+    line.texCoords[1] = float2(0.6f, 0.6f);
+    line.texCoords[2] = float2(0.9f, 0.9f);
+    line.area = 1.f;
+    line.emitterIndex = emitterIndex;
+
+    Triangle point = line;
+    point.texCoords[0] = point.texCoords[1] = point.texCoords[2] = float2(0.3f, 0.8f);
+
+    std::vector<Triangle> triangles = {line, point};
+    auto results = integrator.integrate(triangles);
+
+    float3 expectedLine = (getTexel(reference, 0, 0) + getTexel(reference, 2, 2) + getTexel(reference, 3, 3)) / 3.f;
+    float3 expectedPoint = getTexel(reference, 1, 3);
+    EXPECT_LE(maxRelativeError(results[0].averageRadiance, expectedLine), 1e-6f);
+    EXPECT_LE(maxRelativeError(results[1].averageRadiance, expectedPoint), 1e-6f);
+}
+
+CPU_TEST(CPUEmissiveIntegrator_Reference)
+{
+    // Compare random triangles against a brute-force reference for all addressing modes.
+    const TextureAddressingMode kModes[] = {
+        TextureAddressingMode::Wrap,
+        TextureAddressingMode::Mirror,
+        TextureAddressingMode::Clamp,
+        TextureAddressingMode::Border,
+        TextureAddressingMode::MirrorOnce,
+    };
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-1.5f, 2.5f);
+
+    for (TextureAddressingMode mode : kModes)
+    {
+        CPUEmissiveIntegrator integrator;
+        CPUEmissiveIntegrator::Texture texture = createRandomTexture(8, 6, 4);
+        texture.addressModeU = texture.addressModeV = mode;
+        texture.borderColor = float4(0.5f, 1.f, 2.f, 1.f);
+        const CPUEmissiveIntegrator::Texture reference = texture;
+
+        CPUEmissiveIntegrator::Emitter emitter;
+        emitter.textureIndex = integrator.addTexture(std::move(texture));
+        uint32_t emitterIndex = integrator.addEmitter(emitter);
+
+        std::vector<Triangle> triangles(16);
+        for (auto& tri : triangles)
+        {
+            float2 center = float2(u(rng), u(rng));
+            for (uint32_t i = 0; i < 3; i++)
+                tri.texCoords[i] = center + float2(u(rng), u(rng)) * 0.25f;
+            tri.area = 1.f;
+            tri.emitterIndex = emitterIndex;
+        }
+
+        auto results = integrator.integrate(triangles);
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            float3 expected = computeReferenceAverage(reference, triangles[i]);
+            EXPECT_LE(maxRelativeError(results[i].averageRadiance, expected), 2e-2f) << "mode " << (int)mode << " triangle " << i;
+        }
+    }
+}
+
+GPU_TEST(CPUEmissiveIntegrator_MatchesGPU)
+{
+    ref<Device> pDevice = ctx.getDevice();
+
+    // Write a random emissive texture to disk, so that the scene builder can decode it on the CPU.
+    const uint32_t kWidth = 37, kHeight = 23;
+    const auto path = getRuntimeDirectory() / "test_cpu_emissive_integrator.exr";
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> u(0.f, 10.f);
+        std::vector<float> texels(kWidth * kHeight * 3);
+        for (auto& texel : texels)
+            texel = u(rng);
+        Bitmap::saveImage(
+            path, kWidth, kHeight, Bitmap::FileFormat::ExrFile, Bitmap::ExportFlags::None, ResourceFormat::RGB32Float, true, texels.data()
+        );
+    }
+
+    // A sphere covers the texture once and has triangles that are degenerate in texture space at the poles.
+    // A quad with tiled texture coordinates exercises the wrap addressing.
+    TriangleMesh::VertexList vertices = {
+        {float3(0.f, 0.f, 0.f), float3(0.f, 0.f, 1.f), float2(-1.3f, -0.7f)},
+        {float3(1.f, 0.f, 0.f), float3(0.f, 0.f, 1.f), float2(2.9f, -0.7f)},
+        {float3(1.f, 1.f, 0.f), float3(0.f, 0.f, 1.f), float2(2.9f, 1.6f)},
+        {float3(0.f, 1.f, 0.f), float3(0.f, 0.f, 1.f), float2(-1.3f, 1.6f)},
+    };
+    TriangleMesh::IndexList indices = {0, 1, 2, 0, 2, 3};
+
+    // Builds the same scene with or without CPU emissive integration.
+    auto createScene = [&](SceneBuilder::Flags flags)
+    {
+        SceneBuilder builder(pDevice, Settings(), SceneBuilder::Flags::DontOptimizeMaterials | flags);
+
+        auto pConstant = StandardMaterial::create(pDevice, "Constant");
+        pConstant->setEmissiveColor(float3(1.f, 2.f, 3.f));
+        pConstant->setEmissiveFactor(2.f);
+
+        // The texture is loaded through the builder, which keeps the decoded texels for the integrator.
+        auto pTextured = StandardMaterial::create(pDevice, "Textured");
+        builder.loadMaterialTexture(pTextured, Material::TextureSlot::Emissive, path);
+        pTextured->setEmissiveFactor(0.5f);
+
+        auto addInstance = [&](const ref<TriangleMesh>& pMesh, const ref<Material>& pMaterial, float3 translation)
+        {
+            SceneBuilder::Node node;
+            node.name = pMesh->getName();
+            node.transform = math::matrixFromTranslation(translation);
+            builder.addMeshInstance(builder.addNode(node), builder.addTriangleMesh(pMesh, pMaterial));
+        };
+        addInstance(TriangleMesh::createSphere(1.f, 24, 12), pTextured, float3(0.f));
+        addInstance(TriangleMesh::create(vertices, indices), pTextured, float3(3.f, 0.f, 0.f));
+        addInstance(TriangleMesh::createCube(float3(0.5f)), pConstant, float3(-3.f, 0.f, 0.f));
+
+        return builder.getScene();
+    };
+
+    ref<Scene> pGPUScene = createScene(SceneBuilder::Flags::None);
+    ref<Scene> pCPUScene = createScene(SceneBuilder::Flags::UseCPUEmissiveIntegration);
+
+    RenderContext* pRenderContext = pDevice->getRenderContext();
+    auto pGPU = pGPUScene->getLightCollection(pRenderContext);
+    auto pCPU = pCPUScene->getLightCollection(pRenderContext);
+
+    EXPECT(!pGPU->isIntegratedOnCPU());
+    ASSERT(pCPU->isIntegratedOnCPU());
+
+    const auto& gpuTriangles = pGPU->getMeshLightTriangles(pRenderContext);
+    const auto& cpuTriangles = pCPU->getMeshLightTriangles(pRenderContext);
+    ASSERT_EQ(gpuTriangles.size(), cpuTriangles.size());
+
+    // The triangle geometry is computed in the builder instead of on the GPU, so it should match closely.
+    // The GPU accumulates the flux in fixed point, so allow for small differences.
+    for (size_t i = 0; i < gpuTriangles.size(); i++)
+    {
+        EXPECT_EQ(cpuTriangles[i].lightIdx, gpuTriangles[i].lightIdx) << "triangle " << i;
+        EXPECT_LE(std::abs(cpuTriangles[i].area - gpuTriangles[i].area), 1e-5f * gpuTriangles[i].area + 1e-7f) << "triangle " << i;
+        EXPECT_LE(math::length(cpuTriangles[i].normal - gpuTriangles[i].normal), 1e-3f) << "triangle " << i;
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            EXPECT_LE(math::length(cpuTriangles[i].vtx[j].pos - gpuTriangles[i].vtx[j].pos), 1e-5f) << "triangle " << i;
+            EXPECT(all(cpuTriangles[i].vtx[j].uv == gpuTriangles[i].vtx[j].uv)) << "triangle " << i;
+        }
+        EXPECT_LE(std::abs(cpuTriangles[i].flux - gpuTriangles[i].flux), 1e-4f * gpuTriangles[i].flux + 1e-7f) << "triangle " << i;
+        EXPECT_LE(maxRelativeError(cpuTriangles[i].averageRadiance, gpuTriangles[i].averageRadiance), 1e-4f) << "triangle " << i;
+    }
+    EXPECT_EQ(pCPU->getActiveLightCount(pRenderContext), pGPU->getActiveLightCount(pRenderContext));
+
+    std::filesystem::remove(path);
+}
+} // namespace Falcor
@@ -0,0 +1,224 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Animation/Animation.h"
+#include "Scene/Camera/Camera.h"
+#include "Scene/Camera/CameraPath.h"
+#include "Utils/SampleGenerators/HaltonSamplePattern.h"
+#include <cmath>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+ref<Camera> createTestCamera()
+{
+    ref<Camera> pCamera = Camera::create("test");
+    pCamera->setFocalLength(35.f);
+    pCamera->setAspectRatio(1.5f);
+    pCamera->setDepthRange(0.05f, 500.f);
+    pCamera->setFocalDistance(4.f);
+    pCamera->setPatternGenerator(HaltonSamplePattern::create(16), float2(1.f / 1920.f, 1.f / 1080.f));
+    return pCamera;
+}
+
+std::vector<CameraPath::Viewpoint> createViewpoints(uint32_t count)
+{
+    std::vector<CameraPath::Viewpoint> viewpoints(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float angle = 0.1f * i;
+        viewpoints[i].position = float3(std::cos(angle) * 5.f, 1.f + 0.01f * i, std::sin(angle) * 5.f);
+        viewpoints[i].target = float3(0.f, 0.5f, 0.f);
+        viewpoints[i].up = float3(0.f, 1.f, 0.f);
+    }
+    return viewpoints;
+}
+
+bool isEqual(const float4x4& a, const float4x4& b)
+{
+    for (int r = 0; r < 4; r++)
+    {
+        if (any(a.getRow(r) != b.getRow(r))) return false;
+    }
+    return true;
+}
+
+void expectEqual(CPUUnitTestContext& ctx, const CameraData& data, const CameraData& ref, uint32_t frame)
+{
+    EXPECT(isEqual(data.viewMat, ref.viewMat)) << "frame " << frame;
+    EXPECT(isEqual(data.prevViewMat, ref.prevViewMat)) << "frame " << frame;
+    EXPECT(isEqual(data.projMat, ref.projMat)) << "frame " << frame;
+    EXPECT(isEqual(data.viewProjMat, ref.viewProjMat)) << "frame " << frame;
+    EXPECT(isEqual(data.invViewProj, ref.invViewProj)) << "frame " << frame;
+    EXPECT(isEqual(data.viewProjMatNoJitter, ref.viewProjMatNoJitter)) << "frame " << frame;
+    EXPECT(isEqual(data.prevViewProjMatNoJitter, ref.prevViewProjMatNoJitter)) << "frame " << frame;
+    EXPECT(isEqual(data.projMatNoJitter, ref.projMatNoJitter)) << "frame " << frame;
+    EXPECT(all(data.posW == ref.posW)) << "frame " << frame;
+    EXPECT(all(data.prevPosW == ref.prevPosW)) << "frame " << frame;
+    EXPECT(all(data.cameraU == ref.cameraU)) << "frame " << frame;
+    EXPECT(all(data.cameraV == ref.cameraV)) << "frame " << frame;
+    EXPECT(all(data.cameraW == ref.cameraW)) << "frame " << frame;
+    EXPECT_EQ(data.jitterX, ref.jitterX) << "frame " << frame;
+    EXPECT_EQ(data.jitterY, ref.jitterY) << "frame " << frame;
+    EXPECT_EQ(data.frameWidth, ref.frameWidth) << "frame " << frame;
+}
+} // namespace
+
+CPU_TEST(CameraPath_MatchesCamera)
+{
+    const uint32_t kFrameCount = 200;
+    auto viewpoints = createViewpoints(kFrameCount);
+
+    // The path draws the jitter from the camera's pattern generator.
+    ref<Camera> pPathCamera = createTestCamera();
+    ref<CameraPath> pPath = CameraPath::create(*pPathCamera, viewpoints);
+    ASSERT_EQ(pPath->getFrameCount(), kFrameCount);
+    EXPECT(!pPath->isTimed());
+
+    // Compare against a camera that is moved and rebuilt every frame.
+    ref<Camera> pRefCamera = createTestCamera();
+    pPathCamera->setPath(pPath);
+    for (uint32_t i = 0; i < kFrameCount; i++)
+    {
+        pRefCamera->setPosition(viewpoints[i].position);
+        pRefCamera->setTarget(viewpoints[i].target);
+        pRefCamera->setUpVector(viewpoints[i].up);
+        Camera::Changes refChanges = pRefCamera->beginFrame(i == 0);
+
+        pPathCamera->setPathFrame(i);
+        Camera::Changes changes = pPathCamera->beginFrame(i == 0);
+
+        EXPECT_EQ(pPathCamera->getPathFrame(), i);
+        EXPECT(changes == refChanges) << "frame " << i;
+        expectEqual(ctx, pPathCamera->getData(), pRefCamera->getData(), i);
+        EXPECT(all(pPathCamera->getPosition() == viewpoints[i].position)) << "frame " << i;
+    }
+
+    // Frames can be selected in any order.
+    pPathCamera->setPathFrame(17);
+    EXPECT(isEqual(pPathCamera->getViewMatrix(), pPath->getFrame(17).viewMat));
+    EXPECT_THROW(pPathCamera->setPathFrame(kFrameCount));
+
+    // Removing the path keeps the last frame.
+    pPathCamera->setPath(nullptr);
+    EXPECT(all(pPathCamera->getPosition() == viewpoints[17].position));
+    EXPECT(isEqual(pPathCamera->getViewMatrix(), pPath->getFrame(17).viewMat));
+    EXPECT_THROW(pPathCamera->setPathFrame(0));
+}
+
+CPU_TEST(CameraPath_FromTransforms)
+{
+    std::vector<float4x4> transforms;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        float4x4 T = math::matrixFromTranslation(float3(i * 0.5f, 1.f, -2.f));
+        float4x4 R = math::matrixFromRotationY(0.2f * i);
+        transforms.push_back(mul(T, R));
+    }
+
+    ref<Camera> pCamera = Camera::create();
+    ref<CameraPath> pPath = CameraPath::createFromTransforms(*pCamera, transforms);
+    ASSERT_EQ(pPath->getFrameCount(), (uint32_t)transforms.size());
+
+    ref<Camera> pRefCamera = Camera::create();
+    for (uint32_t i = 0; i < transforms.size(); i++)
+    {
+        pRefCamera->updateFromAnimation(transforms[i]);
+        pRefCamera->beginFrame(true);
+        CameraData data = pPath->getFrame(i);
+        EXPECT(isEqual(data.viewMat, pRefCamera->getViewMatrix())) << "frame " << i;
+        EXPECT(isEqual(data.viewProjMat, pRefCamera->getViewProjMatrix())) << "frame " << i;
+    }
+}
+
+CPU_TEST(CameraPath_Timing)
+{
+    ref<Camera> pCamera = Camera::create();
+    ref<CameraPath> pPath = CameraPath::create(*pCamera, createViewpoints(10));
+    EXPECT_THROW(pPath->getFrameIndex(0.0));
+    EXPECT_THROW(pPath->setTiming(0.0, 0.0));
+
+    pPath->setTiming(2.0, 30.0);
+    EXPECT(pPath->isTimed());
+    EXPECT_EQ(pPath->getFrameIndex(2.0), 0u);
+    for (uint32_t i = 0; i < 10; i++) EXPECT_EQ(pPath->getFrameIndex(2.0 + i / 30.0), i);
+    EXPECT_EQ(pPath->getFrameIndex(2.0 + 4.4 / 30.0), 4u);
+    EXPECT_EQ(pPath->getFrameIndex(0.0), 0u);
+    EXPECT_EQ(pPath->getFrameIndex(100.0), 9u);
+
+    // Looped paths wrap with a duration of 10 / 30 seconds.
+    for (uint32_t i = 0; i < 10; i++) EXPECT_EQ(pPath->getFrameIndex(2.0 + (i + 10) / 30.0, true), i);
+    EXPECT_EQ(pPath->getFrameIndex(2.0 + 9.6 / 30.0, true), 0u);
+    EXPECT_EQ(pPath->getFrameIndex(2.0 - 1.0 / 30.0, true), 9u);
+    EXPECT_EQ(pPath->getFrameIndex(2.0 + 104.0 / 30.0, true), 4u);
+
+    EXPECT_THROW(CameraPath::create(*pCamera, {}));
+}
+
+CPU_TEST(Animation_EvaluateMatchesAnimate)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> u(-2.0, 12.0);
+
+    for (auto mode : { Animation::InterpolationMode::Linear, Animation::InterpolationMode::Hermite })
+    {
+        for (auto behavior : { Animation::Behavior::Constant, Animation::Behavior::Linear, Animation::Behavior::Cycle, Animation::Behavior::Oscillate })
+        {
+            auto createAnimation = [&]()
+            {
+                ref<Animation> pAnimation = Animation::create("test", NodeID{ 0 }, 10.0);
+                for (uint32_t i = 0; i <= 10; i++)
+                {
+                    Animation::Keyframe keyframe;
+                    keyframe.time = i;
+                    keyframe.translation = float3(i, std::sin((float)i), 0.f);
+                    keyframe.rotation = math::quatFromAngleAxis(0.3f * i, float3(0.f, 1.f, 0.f));
+                    pAnimation->addKeyframe(keyframe);
+                }
+                pAnimation->setInterpolationMode(mode);
+                pAnimation->setPreInfinityBehavior(behavior);
+                pAnimation->setPostInfinityBehavior(behavior);
+                return pAnimation;
+            };
+
+            ref<Animation> pAnimation = createAnimation();
+            ref<Animation> pRefAnimation = createAnimation();
+
+            // Evaluate random times with a shared hint, compare against animate() which caches the keyframe internally.
+            size_t hint = 0;
+            for (uint32_t i = 0; i < 1000; i++)
+            {
+                double time = u(rng);
+                EXPECT(isEqual(pAnimation->evaluate(time, hint), pRefAnimation->animate(time))) << "time " << time;
+            }
+        }
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,333 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Curves/CurveTessellation.h"
+#include "Utils/Math/Common.h"
+#include "Utils/Timing/CpuTimer.h"
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+/// Synthetic groom with randomly curled strands.
+struct Groom
+{
+    std::vector<uint32_t> vertexCounts;
+    std::vector<float3> points;
+    std::vector<float> widths;
+    std::vector<float2> UVs;
+};
+
+Groom createGroom(uint32_t strandCount, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    Groom groom;
+    groom.vertexCounts.resize(strandCount);
+    for (uint32_t i = 0; i < strandCount; i++)
+    {
+        uint32_t vertexCount = 4 + rng() % 13;
+        groom.vertexCounts[i] = vertexCount;
+        float3 p(u(rng) * 10.f, 0.f, u(rng) * 10.f);
+        for (uint32_t j = 0; j < vertexCount; j++)
+        {
+            // Repeat some control points, as found in production assets. Each strand keeps at least two distinct points.
+            if (j <= 1 || rng() % 8 != 0)
+                p += float3(u(rng) * 0.1f, 0.2f + 0.1f * u(rng), u(rng) * 0.1f);
+            groom.points.push_back(p);
+            groom.widths.push_back(0.01f * (1.f - (float)j / vertexCount) + 0.001f);
+            groom.UVs.push_back(float2((float)i / strandCount, (float)j / (vertexCount - 1)));
+        }
+    }
+    return groom;
+}
+
+struct Settings
+{
+    uint32_t subdivPerSegment;
+    uint32_t keepOneEveryXStrands;
+    uint32_t keepOneEveryXVerticesPerStrand;
+    bool useUVs;
+};
+
+const float4x4 kTransform = mul(math::matrixFromTranslation(float3(1.f, 2.f, 3.f)), math::matrixFromScaling(float3(2.f)));
+const uint32_t kPointCountPerCrossSection = 4;
+
+CurveTessellation::SweptSphereResult sweptSphere(const Groom& groom, uint32_t firstStrand, uint32_t strandCount, uint32_t pointOffset, const Settings& s)
+{
+    return CurveTessellation::convertToLinearSweptSphere(
+        strandCount,
+        groom.vertexCounts.data() + firstStrand,
+        groom.points.data() + pointOffset,
+        groom.widths.data() + pointOffset,
+        s.useUVs ? groom.UVs.data() + pointOffset : nullptr,
+        1,
+        s.subdivPerSegment,
+        s.keepOneEveryXStrands,
+        s.keepOneEveryXVerticesPerStrand,
+        1.5f,
+        kTransform
+    );
+}
+
+CurveTessellation::MeshResult polytube(const Groom& groom, uint32_t firstStrand, uint32_t strandCount, uint32_t pointOffset, const Settings& s)
+{
+    return CurveTessellation::convertToPolytube(
+        strandCount,
+        groom.vertexCounts.data() + firstStrand,
+        groom.points.data() + pointOffset,
+        groom.widths.data() + pointOffset,
+        s.useUVs ? groom.UVs.data() + pointOffset : nullptr,
+        s.subdivPerSegment,
+        s.keepOneEveryXStrands,
+        s.keepOneEveryXVerticesPerStrand,
+        1.5f,
+        kPointCountPerCrossSection
+    );
+}
+
+/// Append b to a, offsetting b's indices by the element count of a.
+void append(CurveTessellation::SweptSphereResult& a, const CurveTessellation::SweptSphereResult& b)
+{
+    a.degree = b.degree;
+    uint32_t indexOffset = (uint32_t)a.points.size();
+    for (uint32_t index : b.indices)
+        a.indices.push_back(index + indexOffset);
+    for (const auto& v : b.points)
+        a.points.push_back(v);
+    for (float v : b.radius)
+        a.radius.push_back(v);
+    for (const auto& v : b.texCrds)
+        a.texCrds.push_back(v);
+}
+
+void append(CurveTessellation::MeshResult& a, const CurveTessellation::MeshResult& b)
+{
+    uint32_t indexOffset = (uint32_t)a.vertices.size();
+    for (uint32_t index : b.faceVertexIndices)
+        a.faceVertexIndices.push_back(index + indexOffset);
+    for (uint32_t count : b.faceVertexCounts)
+        a.faceVertexCounts.push_back(count);
+    for (const auto& v : b.vertices)
+        a.vertices.push_back(v);
+    for (const auto& v : b.normals)
+        a.normals.push_back(v);
+    for (const auto& v : b.tangents)
+        a.tangents.push_back(v);
+    for (const auto& v : b.texCrds)
+        a.texCrds.push_back(v);
+    for (float v : b.radii)
+        a.radii.push_back(v);
+}
+
+/// Tessellate the kept strands one at a time, which runs the serial path for each strand.
+template<typename Result, typename Func>
+Result tessellatePerStrand(const Groom& groom, const Settings& s, Func func)
+{
+    Result result;
+    Settings single = s;
+    single.keepOneEveryXStrands = 1;
+    uint32_t pointOffset = 0;
+    for (uint32_t i = 0; i < groom.vertexCounts.size(); i++)
+    {
+        if (i % s.keepOneEveryXStrands == 0)
+            append(result, func(groom, i, 1, pointOffset, single));
+        pointOffset += groom.vertexCounts[i];
+    }
+    return result;
+}
+
+template<typename T>
+bool isEqual(const fast_vector<T>& a, const fast_vector<T>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const T& x, const T& y) { return all(x == y); });
+}
+
+template<>
+bool isEqual(const fast_vector<uint32_t>& a, const fast_vector<uint32_t>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template<>
+bool isEqual(const fast_vector<float>& a, const fast_vector<float>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+void expectEqual(CPUUnitTestContext& ctx, const CurveTessellation::SweptSphereResult& a, const CurveTessellation::SweptSphereResult& b)
+{
+    EXPECT_EQ(a.degree, b.degree);
+    EXPECT(isEqual(a.indices, b.indices));
+    EXPECT(isEqual(a.points, b.points));
+    EXPECT(isEqual(a.radius, b.radius));
+    EXPECT(isEqual(a.texCrds, b.texCrds));
+}
+
+void expectEqual(CPUUnitTestContext& ctx, const CurveTessellation::MeshResult& a, const CurveTessellation::MeshResult& b)
+{
+    EXPECT(isEqual(a.vertices, b.vertices));
+    EXPECT(isEqual(a.normals, b.normals));
+    EXPECT(isEqual(a.tangents, b.tangents));
+    EXPECT(isEqual(a.texCrds, b.texCrds));
+    EXPECT(isEqual(a.radii, b.radii));
+    EXPECT(isEqual(a.faceVertexCounts, b.faceVertexCounts));
+    EXPECT(isEqual(a.faceVertexIndices, b.faceVertexIndices));
+}
+
+const Settings kSettings[] = {
+    {4, 1, 1, true},
+    {2, 3, 1, false},
+    {5, 2, 3, true},
+};
+} // namespace
+
+CPU_TEST(CurveTessellation_SweptSphere)
+{
+    Groom groom = createGroom(1000, 1);
+    for (const auto& s : kSettings)
+    {
+        auto result = sweptSphere(groom, 0, (uint32_t)groom.vertexCounts.size(), 0, s);
+        EXPECT_EQ(result.indices.size(), result.points.size() - div_round_up(1000u, s.keepOneEveryXStrands));
+        EXPECT_EQ(result.texCrds.size(), s.useUVs ? result.points.size() : 0);
+
+        auto reference = tessellatePerStrand<CurveTessellation::SweptSphereResult>(groom, s, sweptSphere);
+        expectEqual(ctx, result, reference);
+
+        // Streaming in chunks produces the same output.
+        CurveTessellation::SweptSphereResult streamed;
+        uint32_t chunkCount = 0;
+        CurveTessellation::convertToLinearSweptSphere(
+            (uint32_t)groom.vertexCounts.size(),
+            groom.vertexCounts.data(),
+            groom.points.data(),
+            groom.widths.data(),
+            s.useUVs ? groom.UVs.data() : nullptr,
+            1,
+            s.subdivPerSegment,
+            s.keepOneEveryXStrands,
+            s.keepOneEveryXVerticesPerStrand,
+            1.5f,
+            kTransform,
+            37,
+            [&](const CurveTessellation::SweptSphereResult& chunk)
+            {
+                append(streamed, chunk);
+                chunkCount++;
+            }
+        );
+        EXPECT_EQ(chunkCount, div_round_up(div_round_up(1000u, s.keepOneEveryXStrands), 37u));
+        expectEqual(ctx, streamed, result);
+    }
+}
+
+CPU_TEST(CurveTessellation_Polytube)
+{
+    Groom groom = createGroom(1000, 2);
+    for (const auto& s : kSettings)
+    {
+        auto result = polytube(groom, 0, (uint32_t)groom.vertexCounts.size(), 0, s);
+        EXPECT_EQ(result.faceVertexIndices.size(), 3 * result.faceVertexCounts.size());
+
+        auto reference = tessellatePerStrand<CurveTessellation::MeshResult>(groom, s, polytube);
+        expectEqual(ctx, result, reference);
+
+        // Streaming in chunks produces the same output.
+        CurveTessellation::MeshResult streamed;
+        CurveTessellation::convertToPolytube(
+            (uint32_t)groom.vertexCounts.size(),
+            groom.vertexCounts.data(),
+            groom.points.data(),
+            groom.widths.data(),
+            s.useUVs ? groom.UVs.data() : nullptr,
+            s.subdivPerSegment,
+            s.keepOneEveryXStrands,
+            s.keepOneEveryXVerticesPerStrand,
+            1.5f,
+            kPointCountPerCrossSection,
+            37,
+            [&](const CurveTessellation::MeshResult& chunk) { append(streamed, chunk); }
+        );
+        expectEqual(ctx, streamed, result);
+    }
+}
+
+CPU_TEST(CurveTessellation_Benchmark, TAGS("benchmark"))
+{
+    const uint32_t kStrandCount = 100000;
+    Groom groom = createGroom(kStrandCount, 3);
+    const Settings s = {4, 1, 1, true};
+
+    auto start = CpuTimer::getCurrentTimePoint();
+    auto reference = tessellatePerStrand<CurveTessellation::SweptSphereResult>(groom, s, sweptSphere);
+    double serialMs = CpuTimer::calcDuration(start, CpuTimer::getCurrentTimePoint());
+
+    start = CpuTimer::getCurrentTimePoint();
+    auto result = sweptSphere(groom, 0, kStrandCount, 0, s);
+    double parallelMs = CpuTimer::calcDuration(start, CpuTimer::getCurrentTimePoint());
+
+    start = CpuTimer::getCurrentTimePoint();
+    size_t streamedPoints = 0;
+    CurveTessellation::convertToLinearSweptSphere(
+        kStrandCount,
+        groom.vertexCounts.data(),
+        groom.points.data(),
+        groom.widths.data(),
+        groom.UVs.data(),
+        1,
+        s.subdivPerSegment,
+        s.keepOneEveryXStrands,
+        s.keepOneEveryXVerticesPerStrand,
+        1.5f,
+        kTransform,
+        16384,
+        [&](const CurveTessellation::SweptSphereResult& chunk) { streamedPoints += chunk.points.size(); }
+    );
+    double streamedMs = CpuTimer::calcDuration(start, CpuTimer::getCurrentTimePoint());
+
+    expectEqual(ctx, result, reference);
+    EXPECT_EQ(streamedPoints, result.points.size());
+
+    start = CpuTimer::getCurrentTimePoint();
+    auto mesh = polytube(groom, 0, kStrandCount, 0, s);
+    double polytubeMs = CpuTimer::calcDuration(start, CpuTimer::getCurrentTimePoint());
+
+    logInfo(
+        "CurveTessellation: {} strands, {} points. Swept spheres: per-strand {:.1f} ms, parallel {:.1f} ms, streamed {:.1f} ms. "
+        "Polytube: {} vertices in {:.1f} ms.",
+        kStrandCount,
+        result.points.size(),
+        serialMs,
+        parallelMs,
+        streamedMs,
+        mesh.vertices.size(),
+        polytubeMs
+    );
+}
+} // namespace Falcor
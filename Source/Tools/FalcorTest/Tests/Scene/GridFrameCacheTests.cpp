@@ -0,0 +1,171 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Volume/GridFrameCache.h"
+#include <atomic>
+
+namespace Falcor
+{
+namespace
+{
+/// Small synthetic grid standing in for a NanoVDB grid.
+struct SyntheticGrid
+{
+    uint32_t frame;
+    std::vector<float> voxels;
+};
+
+using Cache = GridFrameCache<SyntheticGrid>;
+
+/// Load function creating synthetic grids and counting the loads per frame.
+struct Loader
+{
+    std::vector<std::atomic<uint32_t>> loadCounts;
+    uint32_t emptyFrame = uint32_t(-1);
+
+    explicit Loader(uint32_t frameCount) : loadCounts(frameCount) {}
+
+    Cache::LoadFunc func()
+    {
+        return [this](uint32_t frame) -> std::shared_ptr<const SyntheticGrid>
+        {
+            loadCounts[frame]++;
+            if (frame == emptyFrame)
+                return nullptr;
+            return std::make_shared<SyntheticGrid>(SyntheticGrid{frame, std::vector<float>(8 * 8 * 8, float(frame))});
+        };
+    }
+};
+} // namespace
+
+CPU_TEST(GridFrameCache_ForwardPlayback)
+{
+    const uint32_t kFrameCount = 20;
+    Loader loader(kFrameCount);
+    Cache cache(kFrameCount, 4, 2, loader.func());
+
+    auto grid = cache.get(0);
+    ASSERT(grid != nullptr);
+    EXPECT_EQ(grid->frame, 0);
+    cache.waitForPrefetch();
+    EXPECT(cache.getResidentFrames() == std::vector<uint32_t>({0, 1, 2}));
+
+    for (uint32_t frame = 1; frame < kFrameCount; ++frame)
+    {
+        grid = cache.get(frame);
+        ASSERT(grid != nullptr);
+        EXPECT_EQ(grid->frame, frame);
+        EXPECT_EQ(grid->voxels[0], float(frame));
+        cache.waitForPrefetch();
+        EXPECT_LE(cache.getResidentFrames().size(), 4);
+    }
+
+    // Every frame after the first was prefetched. Only the first frames were loaded twice,
+    // as playback loops and they are prefetched again at the end of the sequence.
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits, kFrameCount - 1);
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+        EXPECT_EQ(loader.loadCounts[frame].load(), frame < 2 ? 2 : 1) << "frame " << frame;
+    EXPECT_GT(stats.evictions, 0);
+}
+
+CPU_TEST(GridFrameCache_Direction)
+{
+    const uint32_t kFrameCount = 10;
+    Loader loader(kFrameCount);
+    Cache cache(kFrameCount, 5, 2, loader.func());
+
+    cache.get(5);
+    cache.get(4);
+    cache.waitForPrefetch();
+    EXPECT_EQ(cache.getDirection(), -1);
+    EXPECT(cache.isResident(3));
+    EXPECT(cache.isResident(2));
+
+    // Stepping backwards from the first frame wraps around.
+    cache.get(1);
+    cache.get(0);
+    cache.waitForPrefetch();
+    EXPECT_EQ(cache.getDirection(), -1);
+    EXPECT(cache.isResident(9));
+    EXPECT(cache.isResident(8));
+
+    // Stepping forwards from the last frame wraps around as well.
+    cache.get(8);
+    cache.get(9);
+    cache.get(0);
+    EXPECT_EQ(cache.getDirection(), 1);
+    cache.waitForPrefetch();
+    EXPECT(cache.isResident(1));
+    EXPECT(cache.isResident(2));
+}
+
+CPU_TEST(GridFrameCache_LRU)
+{
+    const uint32_t kFrameCount = 10;
+    Loader loader(kFrameCount);
+    Cache cache(kFrameCount, 3, 0, loader.func());
+    EXPECT_EQ(cache.getPrefetchCount(), 0);
+
+    cache.get(0);
+    cache.get(1);
+    cache.get(2);
+    cache.get(0);
+    cache.get(3);
+    EXPECT(cache.getResidentFrames() == std::vector<uint32_t>({0, 2, 3}));
+    EXPECT_EQ(cache.getStats().evictions, 1);
+
+    // Values stay valid after eviction while referenced.
+    auto grid = cache.get(4);
+    cache.get(5);
+    cache.get(6);
+    cache.get(7);
+    EXPECT(!cache.isResident(4));
+    EXPECT_EQ(grid->frame, 4);
+
+    // Evicted frames are reloaded on demand.
+    EXPECT_EQ(cache.get(4)->frame, 4);
+    EXPECT_EQ(loader.loadCounts[4].load(), 2);
+}
+
+CPU_TEST(GridFrameCache_EmptyFrames)
+{
+    const uint32_t kFrameCount = 4;
+    Loader loader(kFrameCount);
+    loader.emptyFrame = 2;
+    Cache cache(kFrameCount, 4, 0, loader.func());
+
+    EXPECT(cache.get(2) == nullptr);
+    EXPECT(cache.isResident(2));
+    EXPECT(cache.get(2) == nullptr);
+    EXPECT_EQ(loader.loadCounts[2].load(), 1);
+
+    EXPECT_THROW(cache.get(kFrameCount));
+}
+} // namespace Falcor
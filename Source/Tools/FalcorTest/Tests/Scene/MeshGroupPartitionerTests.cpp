@@ -0,0 +1,158 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/MeshGroupPartitioner.h"
+#include <random>
+#include <set>
+
+namespace Falcor
+{
+namespace
+{
+using Item = MeshGroupPartitioner::Item;
+using Group = MeshGroupPartitioner::Group;
+
+Item makeItem(float3 center, float size, uint64_t triangleCount)
+{
+    Item item;
+    item.bounds.set(center - float3(size), center + float3(size));
+    item.triangleCount = triangleCount;
+    return item;
+}
+
+/// Generate items in a number of well separated clusters.
+std::vector<Item> generateClusters(uint32_t clusterCount, uint32_t itemsPerCluster, uint64_t trianglesPerItem, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+    std::vector<Item> items;
+    for (uint32_t c = 0; c < clusterCount; c++)
+    {
+        float3 clusterCenter(100.f * c, 0.f, 0.f);
+        for (uint32_t i = 0; i < itemsPerCluster; i++)
+            items.push_back(makeItem(clusterCenter + float3(u(rng), u(rng), u(rng)) * 5.f, 0.5f, trianglesPerItem));
+    }
+    // Shuffle so that input order carries no spatial information.
+    std::shuffle(items.begin(), items.end(), rng);
+    return items;
+}
+
+void validateGroups(CPUUnitTestContext& ctx, const std::vector<Item>& items, const std::vector<Group>& groups, uint64_t maxTriangles)
+{
+    std::set<uint32_t> seen;
+    for (const auto& group : groups)
+    {
+        EXPECT(!group.empty());
+        uint64_t triangleCount = 0;
+        for (uint32_t i : group)
+        {
+            EXPECT_LT(i, items.size());
+            EXPECT(seen.insert(i).second) << "Item " << i << " is in multiple groups";
+            triangleCount += items[i].triangleCount;
+        }
+        if (group.size() > 1)
+            EXPECT_LE(triangleCount, maxTriangles);
+    }
+    EXPECT_EQ(seen.size(), items.size());
+}
+} // namespace
+
+CPU_TEST(MeshGroupPartitioner_Basic)
+{
+    // Nothing to do.
+    EXPECT(MeshGroupPartitioner::partition({}, 100).empty());
+
+    // Everything fits within the budget.
+    std::vector<Item> items = generateClusters(4, 10, 10, 0);
+    auto groups = MeshGroupPartitioner::partition(items, 1000);
+    EXPECT_EQ(groups.size(), 1);
+    validateGroups(ctx, items, groups, 1000);
+
+    // A single item exceeding the budget stays in a group of its own.
+    items = {makeItem(float3(0.f), 1.f, 1000), makeItem(float3(0.f), 1.f, 10), makeItem(float3(1.f), 1.f, 10)};
+    groups = MeshGroupPartitioner::partition(items, 100);
+    validateGroups(ctx, items, groups, 100);
+    for (const auto& group : groups)
+        if (std::find(group.begin(), group.end(), 0u) != group.end())
+            EXPECT_EQ(group.size(), 1);
+}
+
+CPU_TEST(MeshGroupPartitioner_Clusters)
+{
+    // Four clusters that each fit within the budget should end up in separate, non-overlapping groups.
+    const uint64_t maxTriangles = 1000;
+    std::vector<Item> items = generateClusters(4, 50, 20, 1);
+    auto groups = MeshGroupPartitioner::partition(items, maxTriangles);
+    validateGroups(ctx, items, groups, maxTriangles);
+    EXPECT_EQ(groups.size(), 4);
+
+    std::vector<AABB> groupBounds(groups.size());
+    for (size_t g = 0; g < groups.size(); g++)
+        for (uint32_t i : groups[g])
+            groupBounds[g].include(items[i].bounds);
+    for (size_t i = 0; i < groups.size(); i++)
+        for (size_t j = i + 1; j < groups.size(); j++)
+            EXPECT(!groupBounds[i].overlaps(groupBounds[j])) << "Groups " << i << " and " << j << " overlap";
+}
+
+CPU_TEST(MeshGroupPartitioner_Randomized)
+{
+    for (uint32_t run = 0; run < 10; run++)
+    {
+        std::mt19937 rng(run);
+        std::uniform_real_distribution<float> u(0.f, 100.f);
+        std::uniform_int_distribution<uint64_t> tris(1, 500);
+
+        std::vector<Item> items;
+        for (uint32_t i = 0; i < 2000; i++)
+            items.push_back(makeItem(float3(u(rng), u(rng), u(rng)), u(rng) * 0.05f, tris(rng)));
+
+        const uint64_t maxTriangles = 20000;
+        auto groups = MeshGroupPartitioner::partition(items, maxTriangles);
+        validateGroups(ctx, items, groups, maxTriangles);
+
+        // The result must be deterministic.
+        EXPECT(groups == MeshGroupPartitioner::partition(items, maxTriangles));
+
+        // Compare against splitting in input order, which ignores spatial locality.
+        std::vector<Group> naive(1);
+        uint64_t triangleCount = 0;
+        for (uint32_t i = 0; i < items.size(); i++)
+        {
+            if (triangleCount + items[i].triangleCount > maxTriangles)
+            {
+                naive.emplace_back();
+                triangleCount = 0;
+            }
+            naive.back().push_back(i);
+            triangleCount += items[i].triangleCount;
+        }
+        EXPECT_LT(MeshGroupPartitioner::computeCost(items, groups), MeshGroupPartitioner::computeCost(items, naive));
+    }
+}
+} // namespace Falcor
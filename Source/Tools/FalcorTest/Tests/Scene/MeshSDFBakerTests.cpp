@@ -0,0 +1,139 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SDFs/MeshSDFBaker.h"
+#include "Utils/Math/Vector.h"
+#include <algorithm>
+#include <sstream>
+
+namespace Falcor
+{
+namespace
+{
+const float3 kCubePositions[] = {
+    {-1.f, -1.f, -1.f}, {1.f, -1.f, -1.f}, {1.f, 1.f, -1.f}, {-1.f, 1.f, -1.f},
+    {-1.f, -1.f, 1.f},  {1.f, -1.f, 1.f},  {1.f, 1.f, 1.f},  {-1.f, 1.f, 1.f},
+};
+
+const uint32_t kCubeIndices[] = {
+    0, 2, 1, 0, 3, 2, // -z
+    4, 5, 6, 4, 6, 7, // +z
+    0, 1, 5, 0, 5, 4, // -y
+    3, 6, 2, 3, 7, 6, // +y
+    0, 4, 7, 0, 7, 3, // -x
+    1, 2, 6, 1, 6, 5, // +x
+};
+
+float evalBox(const float3& p, float halfExtent)
+{
+    float3 d = abs(p) - float3(halfExtent);
+    return length(max(d, float3(0.f))) + std::min(std::max(std::max(d.x, d.y), d.z), 0.f);
+}
+
+std::vector<std::pair<uint32_t, std::vector<int8_t>>> readAllBricks(SparseSDFGridFile& file)
+{
+    std::vector<std::pair<uint32_t, std::vector<int8_t>>> bricks;
+    uint32_t valuesPerBrick = file.getValuesPerBrick();
+    file.readBricks(
+        [&](fstd::span<const uint32_t> brickIDs, fstd::span<const int8_t> values)
+        {
+            for (size_t i = 0; i < brickIDs.size(); i++)
+                bricks.emplace_back(brickIDs[i], std::vector<int8_t>(values.begin() + i * valuesPerBrick, values.begin() + (i + 1) * valuesPerBrick));
+        }
+    );
+    return bricks;
+}
+} // namespace
+
+CPU_TEST(MeshSDFBaker_Dense)
+{
+    MeshSDFBaker baker(kCubePositions, kCubeIndices);
+    EXPECT_EQ(baker.getTriangleCount(), 12);
+
+    // The cube is scaled to fill the grid minus the padding.
+    const float halfExtent = 0.5f - MeshSDFBakerOptions().padding;
+    float4x4 gridToMesh = baker.getGridToMeshTransform();
+    float3 corner = transformPoint(gridToMesh, float3(halfExtent));
+    EXPECT_LE(length(corner - float3(1.f)), 1e-5f);
+
+    const uint32_t gridWidth = 16;
+    const uint32_t w = gridWidth + 1;
+    std::vector<float> values = baker.bakeDense(gridWidth);
+    ASSERT_EQ(values.size(), w * w * w);
+
+    for (uint32_t z = 0; z < w; z++)
+    {
+        for (uint32_t y = 0; y < w; y++)
+        {
+            for (uint32_t x = 0; x < w; x++)
+            {
+                float3 p = float3(x, y, z) / float(gridWidth) - 0.5f;
+                float expected = evalBox(p, halfExtent);
+                float value = values[x + w * (y + w * z)];
+                EXPECT_LE(std::abs(value - expected), 1e-5f) << "x=" << x << " y=" << y << " z=" << z;
+                EXPECT_LE(std::abs(baker.evalDistance(p) - expected), 1e-5f);
+            }
+        }
+    }
+}
+
+CPU_TEST(MeshSDFBaker_SparseMatchesDense)
+{
+    MeshSDFBaker baker(kCubePositions, kCubeIndices);
+
+    const uint32_t gridWidth = 40;
+    SparseSDFGridFileOptions options;
+    options.brickWidth = 6;
+    options.bricksPerChunk = 5;
+
+    // Narrow band baking must produce the same bricks as converting the dense bake.
+    std::unique_ptr<SparseSDFGridFile> pSparse = baker.bakeSparse(gridWidth, options);
+    std::vector<float> dense = baker.bakeDense(gridWidth);
+    auto pDenseStream = std::make_unique<std::stringstream>(std::ios::in | std::ios::out | std::ios::binary);
+    size_t sliceSize = size_t(gridWidth + 1) * (gridWidth + 1);
+    SparseSDFGridFile::write(
+        *pDenseStream,
+        gridWidth,
+        [&](uint32_t z, uint32_t count, float* pDst) { std::copy_n(dense.data() + z * sliceSize, count * sliceSize, pDst); },
+        options
+    );
+    SparseSDFGridFile fromDense(std::move(pDenseStream));
+
+    EXPECT_EQ(pSparse->getGridWidth(), gridWidth);
+    EXPECT_EQ(pSparse->getBrickWidth(), options.brickWidth);
+    EXPECT_GT(pSparse->getBrickCount(), 0);
+    EXPECT_EQ(pSparse->getBrickCount(), fromDense.getBrickCount());
+    EXPECT(pSparse->getInsideMask() == fromDense.getInsideMask());
+    EXPECT(readAllBricks(*pSparse) == readAllBricks(fromDense));
+
+    // The brick containing the grid center lies inside the cube.
+    uint32_t n = pSparse->getBricksPerAxis();
+    uint32_t c = n / 2;
+    EXPECT(pSparse->isBrickInside(c + n * (c + n * c)));
+}
+} // namespace Falcor
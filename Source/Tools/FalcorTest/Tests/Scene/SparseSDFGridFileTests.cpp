@@ -0,0 +1,170 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/SDFs/SparseSDFGridFile.h"
+#include "Core/Platform/OS.h"
+#include "Utils/Math/Vector.h"
+#include <fstream>
+
+namespace Falcor
+{
+namespace
+{
+/// Dense corner values of a sphere with a hole through it, in the SDF grid local space [-0.5, 0.5]^3.
+std::vector<float> createValues(uint32_t gridWidth)
+{
+    uint32_t w = gridWidth + 1;
+    std::vector<float> values(w * w * w);
+    for (uint32_t z = 0; z < w; z++)
+    {
+        for (uint32_t y = 0; y < w; y++)
+        {
+            for (uint32_t x = 0; x < w; x++)
+            {
+                float3 p = float3(x, y, z) / float(gridWidth) - 0.5f;
+                float sphere = length(p) - 0.35f;
+                float hole = length(float2(p.x, p.y)) - 0.1f;
+                values[x + w * (y + w * z)] = std::max(sphere, -hole);
+            }
+        }
+    }
+    return values;
+}
+
+/// Reconstruct the dense quantized grid from a sparse file.
+std::vector<int8_t> reconstruct(SparseSDFGridFile& file, uint32_t maxBricksPerBatch, uint32_t& batchCount)
+{
+    uint32_t gridWidth = file.getGridWidth();
+    uint32_t w = gridWidth + 1;
+    uint32_t n = file.getBricksPerAxis();
+    uint32_t b = file.getBrickWidth();
+    uint32_t bw = b + 1;
+
+    std::vector<int8_t> values(w * w * w);
+    for (uint32_t z = 0; z < w; z++)
+    {
+        for (uint32_t y = 0; y < w; y++)
+        {
+            for (uint32_t x = 0; x < w; x++)
+            {
+                uint3 brick = min(uint3(x, y, z) / b, uint3(n - 1));
+                values[x + w * (y + w * z)] = file.isBrickInside(brick.x + n * (brick.y + n * brick.z)) ? -INT8_MAX : INT8_MAX;
+            }
+        }
+    }
+
+    batchCount = 0;
+    file.readBricks(
+        [&](fstd::span<const uint32_t> brickIDs, fstd::span<const int8_t> brickValues)
+        {
+            batchCount++;
+            for (size_t i = 0; i < brickIDs.size(); i++)
+            {
+                uint32_t id = brickIDs[i];
+                uint3 origin = uint3(id % n, (id / n) % n, id / (n * n)) * b;
+                for (uint32_t j = 0; j < file.getValuesPerBrick(); j++)
+                {
+                    uint3 p = origin + uint3(j % bw, (j / bw) % bw, j / (bw * bw));
+                    if (any(p > uint3(gridWidth))) continue;
+                    values[p.x + w * (p.y + w * p.z)] = brickValues[i * file.getValuesPerBrick() + j];
+                }
+            }
+        },
+        maxBricksPerBatch
+    );
+    return values;
+}
+} // namespace
+
+CPU_TEST(SparseSDFGridFile_RoundTrip)
+{
+    const uint32_t kGridWidth = 61; // Not a multiple of the brick width.
+    std::vector<float> values = createValues(kGridWidth);
+
+    std::filesystem::path path = getTempFilePath();
+    SparseSDFGridFile::Options options;
+    options.brickWidth = 7;
+    options.bricksPerChunk = 16;
+    SparseSDFGridFile::write(path, values, kGridWidth, options);
+
+    {
+        SparseSDFGridFile file(path);
+        EXPECT_EQ(file.getGridWidth(), kGridWidth);
+        EXPECT_EQ(file.getBricksPerAxis(), 9u);
+        EXPECT_GT(file.getBrickCount(), 0u);
+        EXPECT_LT(file.getBrickCount(), 9u * 9u * 9u);
+
+        uint32_t batchCount = 0;
+        std::vector<int8_t> reconstructed = reconstruct(file, 40, batchCount);
+        EXPECT_GT(batchCount, 1u);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            if (reconstructed[i] != SparseSDFGridFile::quantize(values[i], kGridWidth)) mismatches++;
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+CPU_TEST(SparseSDFGridFile_ConvertDense)
+{
+    const uint32_t kGridWidth = 32;
+    std::vector<float> values = createValues(kGridWidth);
+
+    std::filesystem::path densePath = getTempFilePath();
+    std::filesystem::path sparsePath = getTempFilePath();
+    std::filesystem::path referencePath = getTempFilePath();
+    {
+        std::ofstream file(densePath, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&kGridWidth), sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+
+    SparseSDFGridFile::convertDenseFile(densePath, sparsePath);
+    SparseSDFGridFile::write(referencePath, values, kGridWidth);
+
+    {
+        SparseSDFGridFile converted(sparsePath);
+        SparseSDFGridFile reference(referencePath);
+        EXPECT_EQ(converted.getBrickCount(), reference.getBrickCount());
+
+        uint32_t batchCount = 0;
+        EXPECT(reconstruct(converted, 1 << 20, batchCount) == reconstruct(reference, 1 << 20, batchCount));
+        EXPECT_EQ(batchCount, 1u);
+    }
+
+    std::filesystem::remove(densePath);
+    std::filesystem::remove(sparsePath);
+    std::filesystem::remove(referencePath);
+
+    EXPECT_THROW(SparseSDFGridFile file(densePath));
+}
+} // namespace Falcor
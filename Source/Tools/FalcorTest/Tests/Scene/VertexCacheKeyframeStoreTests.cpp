@@ -0,0 +1,162 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Scene/Animation/VertexCacheKeyframeStore.h"
+#include <cstring>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+using Encoding = VertexCacheKeyframeStore::Encoding;
+
+/// Create a synthetic animation of a deforming point cloud. Every fourth keyframe jumps to exercise absolute keyframes.
+std::vector<std::vector<PackedStaticVertexData>> createKeyframes(uint32_t keyframeCount, uint32_t vertexCount)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+
+    std::vector<StaticVertexData> base(vertexCount);
+    for (auto& v : base)
+    {
+        v.position = float3(u(rng), u(rng), u(rng)) * 10.f;
+        v.normal = normalize(float3(u(rng), u(rng), u(rng)));
+        v.tangent = float4(normalize(float3(u(rng), u(rng), u(rng))), u(rng) < 0.f ? -1.f : 1.f);
+        v.texCrd = float2(u(rng), u(rng));
+        v.curveRadius = 0.f;
+    }
+
+    std::vector<std::vector<PackedStaticVertexData>> keyframes(keyframeCount, std::vector<PackedStaticVertexData>(vertexCount));
+    for (uint32_t k = 0; k < keyframeCount; k++)
+    {
+        float offset = (k % 4 == 3) ? 5.f : 0.01f * k;
+        for (uint32_t i = 0; i < vertexCount; i++)
+        {
+            StaticVertexData v = base[i];
+            v.position += float3(offset, std::sin(0.01f * k + i), 0.f);
+            v.normal = normalize(v.normal + float3(0.05f * k, 0.f, 0.f));
+            keyframes[k][i].pack(v);
+        }
+    }
+    return keyframes;
+}
+
+void testRoundTrip(CPUUnitTestContext& ctx, Encoding encoding)
+{
+    const uint32_t kKeyframeCount = 12;
+    const uint32_t kVertexCount = 10000;
+    auto keyframes = createKeyframes(kKeyframeCount, kVertexCount);
+
+    VertexCacheKeyframeStore store(keyframes, encoding);
+    EXPECT_EQ(store.getKeyframeCount(), kKeyframeCount);
+    EXPECT_EQ(store.getVertexCount(), kVertexCount);
+
+    float3 tolerance = store.getQuantizationStep() * 0.5f + float3(1e-5f);
+    std::vector<PackedStaticVertexData> decoded(kVertexCount);
+    for (uint32_t k = 0; k < kKeyframeCount; k++)
+    {
+        store.decodeKeyframe(k, decoded);
+        for (uint32_t i = 0; i < kVertexCount; i++)
+        {
+            const auto& a = keyframes[k][i];
+            const auto& b = decoded[i];
+            float3 err = abs(a.position - b.position);
+            if (any(err > tolerance))
+            {
+                EXPECT(false) << "keyframe " << k << " vertex " << i;
+                return;
+            }
+            EXPECT_EQ(std::memcmp(&a.packedNormalTangentCurveRadius, &b.packedNormalTangentCurveRadius, sizeof(float3)), 0);
+            EXPECT(all(a.texCrd == b.texCrd));
+        }
+    }
+}
+} // namespace
+
+CPU_TEST(VertexCacheKeyframeStore_Raw)
+{
+    testRoundTrip(ctx, Encoding::Raw);
+}
+
+CPU_TEST(VertexCacheKeyframeStore_Quantized)
+{
+    testRoundTrip(ctx, Encoding::Quantized);
+}
+
+CPU_TEST(VertexCacheKeyframeStore_Delta)
+{
+    testRoundTrip(ctx, Encoding::Delta);
+
+    auto keyframes = createKeyframes(40, 100);
+    VertexCacheKeyframeStore delta(keyframes, Encoding::Delta);
+    VertexCacheKeyframeStore quantized(keyframes, Encoding::Quantized);
+
+    // Small motion is delta-encoded, large jumps and long chains are not.
+    EXPECT(!delta.isDeltaKeyframe(0));
+    EXPECT(delta.isDeltaKeyframe(1));
+    EXPECT(!delta.isDeltaKeyframe(3));
+    EXPECT_LT(delta.getMemoryUsageInBytes(), quantized.getMemoryUsageInBytes());
+
+    // Decoding pairs matches decoding single keyframes, both within and across delta chains.
+    std::vector<PackedStaticVertexData> a(100), b(100), ref(100);
+    for (uint2 pair : {uint2(0, 1), uint2(1, 2), uint2(4, 6), uint2(2, 5), uint2(39, 0)})
+    {
+        delta.decodeKeyframes(pair, a, b);
+        delta.decodeKeyframe(pair.y, ref);
+        for (uint32_t i = 0; i < 100; i++) EXPECT(all(b[i].position == ref[i].position)) << pair.x << " " << pair.y;
+        quantized.decodeKeyframe(pair.x, ref);
+        for (uint32_t i = 0; i < 100; i++) EXPECT(all(a[i].position == ref[i].position)) << pair.x << " " << pair.y;
+    }
+}
+
+CPU_TEST(VertexCacheKeyframeStore_Interpolate)
+{
+    const uint32_t kVertexCount = 5000;
+    auto keyframes = createKeyframes(2, kVertexCount);
+    std::vector<PackedStaticVertexData> result(kVertexCount);
+
+    for (float t : {0.f, 0.25f, 1.f})
+    {
+        VertexCacheKeyframeStore::interpolate(keyframes[0], keyframes[1], t, result);
+        for (uint32_t i = 0; i < kVertexCount; i += 97)
+        {
+            StaticVertexData v0 = keyframes[0][i].unpack();
+            StaticVertexData v1 = keyframes[1][i].unpack();
+            StaticVertexData v = result[i].unpack();
+
+            float3 expectedPos = v0.position + (v1.position - v0.position) * t;
+            EXPECT_LE(length(v.position - expectedPos), 1e-4f);
+            EXPECT_LE(length(v.normal - normalize(lerp(v0.normal, v1.normal, t))), 1e-2f);
+            EXPECT_LE(std::abs(length(v.tangent.xyz()) - 1.f), 1e-2f);
+            EXPECT_EQ(v.tangent.w, v0.tangent.w);
+            EXPECT(all(v.texCrd == v0.texCrd));
+        }
+    }
+}
+} // namespace Falcor
@@ -313,4 +313,41 @@ GPU_TEST(BufferAllocatorStructAlign)
     }
 }
 
+
+CPU_TEST(BufferAllocatorRanges)
+{
+    BufferAllocator buf(16, 0, 128);
+
+    RangeAllocator::Allocation a = buf.allocateRange(64);
+    RangeAllocator::Allocation b = buf.allocateRange(64);
+    RangeAllocator::Allocation c = buf.allocateRange(64);
+    EXPECT_EQ(buf.getSize(), 192);
+    buf.set<uint32_t>(c.offset, 77);
+
+    // Released ranges are reused before the buffer grows.
+    buf.release(a);
+    buf.release(b);
+    RangeAllocator::Allocation d = buf.allocateRange(64);
+    EXPECT_EQ(d.offset, 0);
+    EXPECT_EQ(buf.getSize(), 192);
+
+    // Defragmentation compacts the live data and shrinks the buffer.
+    buf.release(d);
+    size_t offsetC = c.offset;
+    buf.defragment(
+        [&](const RangeAllocator::Move& move)
+        {
+            if (move.block == c.block)
+                offsetC = move.dstOffset;
+        }
+    );
+    EXPECT_EQ(offsetC, 0);
+    EXPECT_EQ(buf.getSize(), 64);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t*>(buf.getStartPointer()), 77);
+
+    RangeAllocator::Stats stats = buf.getStats();
+    EXPECT_EQ(stats.allocationCount, 1);
+    EXPECT_EQ(stats.freeBytes, 0);
+}
+
 } // namespace Falcor
@@ -0,0 +1,114 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Dictionary.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+CPU_TEST(Dictionary_Keys)
+{
+    Dictionary::Key a("dictionaryTestKeyA");
+    Dictionary::Key b(std::string("dictionaryTestKeyB"));
+    Dictionary::Key a2(std::string_view("dictionaryTestKeyA"));
+
+    EXPECT(a == a2);
+    EXPECT(a != b);
+    EXPECT_EQ(a.getId(), a2.getId());
+    EXPECT_EQ(a.getName(), "dictionaryTestKeyA");
+    EXPECT_EQ(b.getName(), "dictionaryTestKeyB");
+}
+
+CPU_TEST(Dictionary_Values)
+{
+    Dictionary dict;
+    const Dictionary::Key kInt("dictionaryTestInt");
+    const Dictionary::Key kFloat("dictionaryTestFloat");
+
+    EXPECT_EQ(dict.size(), 0);
+    EXPECT(!dict.keyExists(kInt));
+    EXPECT_EQ(dict.getValue(kInt, 5u), 5u);
+    EXPECT_THROW(dict.getValue<uint32_t>(kInt));
+
+    dict[kInt] = 1u;
+    dict[kFloat] = 2.f;
+    EXPECT_EQ(dict.size(), 2);
+    EXPECT(dict.keyExists(kInt));
+    EXPECT(dict.keyExists("dictionaryTestInt"));
+    EXPECT_EQ(dict.getValue<uint32_t>(kInt), 1u);
+    EXPECT_EQ(dict.getValue(kFloat, 0.f), 2.f);
+
+    // Overwrite by name.
+    dict["dictionaryTestInt"] = 3u;
+    EXPECT_EQ(dict.size(), 2);
+    EXPECT_EQ((uint32_t)dict[kInt], 3u);
+
+    // Copies are independent.
+    Dictionary copy(dict);
+    copy[kInt] = 4u;
+    EXPECT_EQ((uint32_t)dict[kInt], 3u);
+    EXPECT_EQ((uint32_t)copy[kInt], 4u);
+
+    const Dictionary& constDict = dict;
+    EXPECT_EQ((float)constDict[kFloat], 2.f);
+    EXPECT_THROW(constDict["dictionaryTestMissing"]);
+}
+
+CPU_TEST(Dictionary_ConcurrentKeys)
+{
+    // Interning the same names from multiple threads must yield the same ids.
+    // The key count spans multiple chunks of the name table.
+    const size_t kThreadCount = 4;
+    const size_t kKeyCount = 2500;
+    std::vector<std::vector<uint32_t>> ids(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back(
+            [&ids, t]()
+            {
+                for (size_t i = 0; i < kKeyCount; i++)
+                    ids[t].push_back(Dictionary::Key("dictionaryTestConcurrent" + std::to_string(i)).getId());
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t t = 1; t < kThreadCount; t++)
+        EXPECT(ids[t] == ids[0]);
+    for (size_t i = 0; i < kKeyCount; i++)
+    {
+        Dictionary::Key key("dictionaryTestConcurrent" + std::to_string(i));
+        EXPECT_EQ(key.getId(), ids[0][i]);
+        EXPECT_EQ(key.getName(), "dictionaryTestConcurrent" + std::to_string(i));
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,288 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/PixelConversion.h"
+#include "Utils/Math/Float16.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+// Odd element count to exercise the scalar tails of the SIMD kernels.
+const size_t kRandomCount = 100003;
+
+std::vector<float> createTestFloats()
+{
+    std::vector<float> values = {
+        0.f,
+        -0.f,
+        1.f,
+        -1.f,
+        0.5f,
+        1.5f,
+        -2.f,
+        65504.f,
+        65519.f,
+        65520.f,
+        1e-8f,
+        5.9604645e-8f,
+        2.9802322e-8f,
+        6.1035156e-5f,
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::denorm_min(),
+    };
+
+    // Random bit patterns cover all exponents, values in [-2,2] cover the normalized ranges densely.
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-2.f, 2.f);
+    for (size_t i = 0; i < kRandomCount; ++i)
+    {
+        uint32_t bits = rng();
+        float f;
+        std::memcpy(&f, &bits, sizeof(float));
+        values.push_back(i % 2 ? f : dist(rng));
+    }
+    return values;
+}
+
+template<typename T>
+std::vector<T> createAllValues()
+{
+    std::vector<T> values;
+    for (int64_t i = std::numeric_limits<T>::min(); i <= std::numeric_limits<T>::max(); ++i)
+        values.push_back(T(i));
+    return values;
+}
+
+template<typename Src, typename Dst>
+void testConformance(
+    CPUUnitTestContext& ctx,
+    const std::vector<Src>& src,
+    void (*func)(const Src*, Dst*, size_t),
+    void (*scalarFunc)(const Src*, Dst*, size_t)
+)
+{
+    std::vector<Dst> result(src.size());
+    std::vector<Dst> expected(src.size());
+    func(src.data(), result.data(), src.size());
+    scalarFunc(src.data(), expected.data(), src.size());
+    EXPECT(std::memcmp(result.data(), expected.data(), src.size() * sizeof(Dst)) == 0);
+}
+} // namespace
+
+CPU_TEST(PixelConversion_Half)
+{
+    std::vector<uint16_t> halfs = createAllValues<uint16_t>();
+    testConformance(ctx, halfs, PixelConversion::halfToFloat, PixelConversion::Scalar::halfToFloat);
+
+    // The scalar path is exact.
+    std::vector<float> floats(halfs.size());
+    PixelConversion::Scalar::halfToFloat(halfs.data(), floats.data(), halfs.size());
+    for (size_t i = 0; i < halfs.size(); ++i)
+    {
+        float expected = math::float16ToFloat32(halfs[i]);
+        if (std::isnan(expected))
+            EXPECT(std::isnan(floats[i]));
+        else
+            EXPECT_EQ(floats[i], expected) << "half=" << halfs[i];
+    }
+
+    // Converting back is lossless, except for NaN payloads.
+    std::vector<uint16_t> roundTrip(halfs.size());
+    PixelConversion::floatToHalf(floats.data(), roundTrip.data(), floats.size());
+    for (size_t i = 0; i < halfs.size(); ++i)
+    {
+        if (!std::isnan(floats[i]))
+            EXPECT_EQ(roundTrip[i], halfs[i]);
+    }
+
+    std::vector<float> testFloats = createTestFloats();
+    testConformance(ctx, testFloats, PixelConversion::floatToHalf, PixelConversion::Scalar::floatToHalf);
+
+    std::vector<uint16_t> result(testFloats.size());
+    PixelConversion::Scalar::floatToHalf(testFloats.data(), result.data(), testFloats.size());
+    EXPECT_EQ(result[7], 0x7bff);  // 65504
+    EXPECT_EQ(result[8], 0x7bff);  // 65519 rounds down
+    EXPECT_EQ(result[9], 0x7c00);  // 65520 rounds to infinity
+    EXPECT_EQ(result[11], 0x0001); // Smallest denormal
+    EXPECT_EQ(result[12], 0x0000); // Halfway to the smallest denormal rounds to even
+    EXPECT_EQ(result[13], 0x0400); // Smallest normal
+}
+
+CPU_TEST(PixelConversion_Norm)
+{
+    testConformance(ctx, createAllValues<uint8_t>(), PixelConversion::unorm8ToFloat, PixelConversion::Scalar::unorm8ToFloat);
+    testConformance(ctx, createAllValues<uint16_t>(), PixelConversion::unorm16ToFloat, PixelConversion::Scalar::unorm16ToFloat);
+    testConformance(ctx, createAllValues<int8_t>(), PixelConversion::snorm8ToFloat, PixelConversion::Scalar::snorm8ToFloat);
+    testConformance(ctx, createAllValues<int16_t>(), PixelConversion::snorm16ToFloat, PixelConversion::Scalar::snorm16ToFloat);
+
+    std::vector<float> testFloats = createTestFloats();
+    testConformance(ctx, testFloats, PixelConversion::floatToUnorm8, PixelConversion::Scalar::floatToUnorm8);
+    testConformance(ctx, testFloats, PixelConversion::floatToUnorm16, PixelConversion::Scalar::floatToUnorm16);
+    testConformance(ctx, testFloats, PixelConversion::floatToSnorm8, PixelConversion::Scalar::floatToSnorm8);
+    testConformance(ctx, testFloats, PixelConversion::floatToSnorm16, PixelConversion::Scalar::floatToSnorm16);
+
+    // Unorm and snorm values round trip, snorm -128 maps to -127.
+    std::vector<uint8_t> unorm = createAllValues<uint8_t>();
+    std::vector<float> floats(unorm.size());
+    std::vector<uint8_t> unormRoundTrip(unorm.size());
+    PixelConversion::unorm8ToFloat(unorm.data(), floats.data(), unorm.size());
+    PixelConversion::floatToUnorm8(floats.data(), unormRoundTrip.data(), floats.size());
+    EXPECT(unorm == unormRoundTrip);
+    EXPECT_EQ(floats[255], 1.f);
+
+    std::vector<int8_t> snorm = createAllValues<int8_t>();
+    std::vector<int8_t> snormRoundTrip(snorm.size());
+    PixelConversion::snorm8ToFloat(snorm.data(), floats.data(), snorm.size());
+    PixelConversion::floatToSnorm8(floats.data(), snormRoundTrip.data(), floats.size());
+    EXPECT_EQ(floats[0], -1.f);
+    EXPECT_EQ(snormRoundTrip[0], -127);
+    for (size_t i = 1; i < snorm.size(); ++i)
+        EXPECT_EQ(snormRoundTrip[i], snorm[i]);
+
+    // NaN maps to zero.
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    uint8_t u8;
+    int16_t s16;
+    PixelConversion::floatToUnorm8(&nan, &u8, 1);
+    PixelConversion::floatToSnorm16(&nan, &s16, 1);
+    EXPECT_EQ(u8, 0);
+    EXPECT_EQ(s16, 0);
+}
+
+CPU_TEST(PixelConversion_SwapRedBlue)
+{
+    const size_t pixelCount = 1001;
+    std::vector<uint8_t> src(pixelCount * 4);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = uint8_t(i * 7 + 3);
+
+    for (bool opaque : {false, true})
+    {
+        std::vector<uint8_t> result(src.size());
+        std::vector<uint8_t> expected(src.size());
+        PixelConversion::swapRedBlue8(src.data(), result.data(), pixelCount, opaque);
+        PixelConversion::Scalar::swapRedBlue8(src.data(), expected.data(), pixelCount, opaque);
+        EXPECT(result == expected);
+        EXPECT_EQ(result[0], src[2]);
+        EXPECT_EQ(result[2], src[0]);
+        EXPECT_EQ(result[3], opaque ? 0xff : src[3]);
+
+        // In place.
+        std::vector<uint8_t> inPlace = src;
+        PixelConversion::swapRedBlue8(inPlace.data(), inPlace.data(), pixelCount, opaque);
+        EXPECT(inPlace == expected);
+    }
+}
+
+CPU_TEST(PixelConversion_Srgb)
+{
+    std::vector<uint8_t> srgb = createAllValues<uint8_t>();
+    std::vector<float> linear(srgb.size());
+    PixelConversion::srgb8ToFloat(srgb.data(), linear.data(), srgb.size());
+
+    std::vector<float> encoded(srgb.size());
+    PixelConversion::unorm8ToFloat(srgb.data(), encoded.data(), srgb.size());
+    std::vector<float> expected(srgb.size());
+    PixelConversion::srgbToLinear(encoded.data(), expected.data(), encoded.size());
+    EXPECT(linear == expected);
+    EXPECT_EQ(linear[0], 0.f);
+    EXPECT_EQ(linear[255], 1.f);
+
+    std::vector<uint8_t> roundTrip(srgb.size());
+    PixelConversion::floatToSrgb8(linear.data(), roundTrip.data(), linear.size());
+    EXPECT(roundTrip == srgb);
+
+    std::vector<float> reencoded(srgb.size());
+    PixelConversion::linearToSrgb(linear.data(), reencoded.data(), linear.size());
+    for (size_t i = 0; i < srgb.size(); ++i)
+        EXPECT_LE(std::abs(reencoded[i] - encoded[i]), 1e-6f);
+}
+
+CPU_TEST(PixelConversion_ConvertToRGBA32Float)
+{
+    EXPECT(PixelConversion::isConvertibleToRGBA32Float(ResourceFormat::RGBA16Float));
+    EXPECT(PixelConversion::isConvertibleToRGBA32Float(ResourceFormat::BGRA8UnormSrgb));
+    EXPECT(!PixelConversion::isConvertibleToRGBA32Float(ResourceFormat::R11G11B10Float));
+    EXPECT(!PixelConversion::isConvertibleToRGBA32Float(ResourceFormat::BC1Unorm));
+    EXPECT(!PixelConversion::isConvertibleToRGBA32Float(ResourceFormat::D32Float));
+
+    const uint32_t width = 13;
+    const uint32_t height = 5;
+    const size_t pixelCount = width * height;
+
+    // Two channel half.
+    {
+        std::vector<uint16_t> data(pixelCount * 2);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = math::float32ToFloat16(float(i) * 0.25f);
+        std::vector<float> result = PixelConversion::convertToRGBA32Float(ResourceFormat::RG16Float, width, height, data.data());
+        ASSERT_EQ(result.size(), pixelCount * 4);
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            EXPECT_EQ(result[i * 4], float(i * 2) * 0.25f);
+            EXPECT_EQ(result[i * 4 + 1], float(i * 2 + 1) * 0.25f);
+            EXPECT_EQ(result[i * 4 + 2], 0.f);
+            EXPECT_EQ(result[i * 4 + 3], 1.f);
+        }
+    }
+
+    // BGRA sRGB, the alpha channel is linear.
+    {
+        std::vector<uint8_t> data(pixelCount * 4);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = uint8_t(i);
+        std::vector<float> result = PixelConversion::convertToRGBA32Float(ResourceFormat::BGRA8UnormSrgb, width, height, data.data());
+        ASSERT_EQ(result.size(), pixelCount * 4);
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            float expected[4];
+            PixelConversion::srgb8ToFloat(&data[i * 4], expected, 3);
+            PixelConversion::unorm8ToFloat(&data[i * 4 + 3], &expected[3], 1);
+            EXPECT_EQ(result[i * 4], expected[2]);
+            EXPECT_EQ(result[i * 4 + 1], expected[1]);
+            EXPECT_EQ(result[i * 4 + 2], expected[0]);
+            EXPECT_EQ(result[i * 4 + 3], expected[3]);
+        }
+    }
+
+    // Signed integers are normalized.
+    {
+        std::vector<int16_t> data(pixelCount, -32767);
+        std::vector<float> result = PixelConversion::convertToRGBA32Float(ResourceFormat::R16Int, width, height, data.data());
+        EXPECT_EQ(result[0], -1.f);
+        EXPECT_EQ(result[3], 1.f);
+    }
+}
+} // namespace Falcor
@@ -0,0 +1,187 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/TextureDecoder.h"
+#include "Utils/Image/Bitmap.h"
+
+namespace Falcor
+{
+namespace
+{
+std::vector<std::filesystem::path> getTinyMipPaths()
+{
+    std::vector<std::filesystem::path> paths;
+    for (uint32_t i = 0; i < 3; i++)
+        paths.push_back(getRuntimeDirectory() / fmt::format("data/tests/tiny_mip{}.png", i));
+    return paths;
+}
+} // namespace
+
+CPU_TEST(TextureDecoder_Decode)
+{
+    std::vector<TextureDecoder::Request> requests = {
+        {getTinyMipPaths(), false},
+        {{getTinyMipPaths()[0]}, true},
+        {{getRuntimeDirectory() / "data/tests/BC1Unorm.dds"}, false},
+        {{getRuntimeDirectory() / "data/tests/does_not_exist.png"}, false},
+    };
+
+    std::vector<TextureDecoder::DecodedTexture> decoded;
+    TextureDecoder decoder;
+    size_t batchCount = decoder.decode(
+        requests,
+        [&](fstd::span<const TextureDecoder::DecodedTexture> batch)
+        {
+            for (const auto& texture : batch)
+            {
+                // Staging memory is only valid during the callback.
+                if (texture.status == TextureDecoder::Status::Decoded)
+                    EXPECT(texture.pData != nullptr);
+                decoded.push_back(texture);
+            }
+        }
+    );
+    EXPECT_EQ(batchCount, 1);
+    ASSERT_EQ(decoded.size(), requests.size());
+
+    // Mip chain loaded from files.
+    EXPECT_EQ(decoded[0].requestIndex, 0);
+    EXPECT(decoded[0].status == TextureDecoder::Status::Decoded);
+    EXPECT_EQ(decoded[0].width, 4);
+    EXPECT_EQ(decoded[0].height, 4);
+    EXPECT_EQ(decoded[0].mipCount, 3);
+    EXPECT_EQ(decoded[0].size, (4 * 4 + 2 * 2 + 1 * 1) * getFormatBytesPerBlock(decoded[0].format));
+
+    // Single image loaded as sRGB.
+    EXPECT_EQ(decoded[1].requestIndex, 1);
+    EXPECT(decoded[1].status == TextureDecoder::Status::Decoded);
+    EXPECT_EQ(decoded[1].mipCount, 1);
+    EXPECT(isSrgbFormat(decoded[1].format));
+    EXPECT_EQ(decoded[1].size, 4 * 4 * getFormatBytesPerBlock(decoded[1].format));
+
+    // Single DDS files are decoded with all their subresources.
+    EXPECT_EQ(decoded[2].requestIndex, 2);
+    EXPECT(decoded[2].status == TextureDecoder::Status::Decoded);
+    EXPECT(decoded[2].type == Resource::Type::Texture2D);
+    EXPECT(decoded[2].format == ResourceFormat::BC1Unorm);
+    EXPECT_EQ(decoded[2].arraySize, 1);
+    EXPECT_GE(decoded[2].mipCount, 1);
+    EXPECT_GT(decoded[2].size, 0);
+
+    EXPECT_EQ(decoded[3].requestIndex, 3);
+    EXPECT(decoded[3].status == TextureDecoder::Status::Failed);
+
+    // Decoding a single texture on the calling thread gives the same result.
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        std::vector<uint8_t> data;
+        auto single = TextureDecoder::decode(requests[i], data);
+        EXPECT(single.status == decoded[i].status);
+        EXPECT_EQ(single.mipCount, decoded[i].mipCount);
+        EXPECT_EQ(single.size, decoded[i].size);
+        if (single.status == TextureDecoder::Status::Decoded)
+            EXPECT(single.pData == data.data());
+    }
+}
+
+CPU_TEST(TextureDecoder_Batches)
+{
+    const size_t kRequestCount = 5;
+    std::vector<TextureDecoder::Request> requests(kRequestCount, {getTinyMipPaths(), false});
+
+    // Staging buffer that is too small for a single texture grows to fit one texture.
+    TextureDecoder decoder(1);
+    std::vector<uint32_t> seen(kRequestCount, 0);
+    size_t batchCount = decoder.decode(
+        requests,
+        [&](fstd::span<const TextureDecoder::DecodedTexture> batch)
+        {
+            // Each texture needs the whole staging buffer, so each batch holds exactly one texture.
+            EXPECT_EQ(batch.size(), 1);
+            for (const auto& texture : batch)
+            {
+                EXPECT(texture.status == TextureDecoder::Status::Decoded);
+                EXPECT_EQ(texture.size, decoder.getStagingSize());
+                seen[texture.requestIndex]++;
+            }
+        }
+    );
+    EXPECT_EQ(batchCount, kRequestCount);
+    for (size_t i = 0; i < kRequestCount; i++)
+        EXPECT_EQ(seen[i], 1);
+
+    // Staging buffer large enough to hold all textures decodes everything in a single batch.
+    TextureDecoder largeDecoder(decoder.getStagingSize() * kRequestCount);
+    batchCount = largeDecoder.decode(
+        requests, [&](fstd::span<const TextureDecoder::DecodedTexture> batch) { EXPECT_EQ(batch.size(), kRequestCount); }
+    );
+    EXPECT_EQ(batchCount, 1);
+}
+
+CPU_TEST(TextureDecoder_Analyze)
+{
+    const auto path = getRuntimeDirectory() / "data/tests/texture2.png";
+    std::vector<TextureDecoder::Request> requests = {
+        {{path}, false, true},
+        {{path}, false, false},
+        {{getRuntimeDirectory() / "data/tests/BC1Unorm.dds"}, false, true},
+    };
+
+    auto decode = [&]()
+    {
+        std::vector<TextureDecoder::DecodedTexture> decoded;
+        TextureDecoder decoder;
+        decoder.decode(
+            requests,
+            [&](fstd::span<const TextureDecoder::DecodedTexture> batch) { decoded.insert(decoded.end(), batch.begin(), batch.end()); }
+        );
+        return decoded;
+    };
+
+    auto pBitmap = Bitmap::createFromFile(path, true);
+    ASSERT(pBitmap != nullptr);
+    auto expected = TextureAnalyzer::analyzeCpu(*pBitmap);
+
+    // The second decode is served from the analysis cache and must give the same result.
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        auto decoded = decode();
+        ASSERT_EQ(decoded.size(), requests.size());
+
+        ASSERT(decoded[0].analysis.has_value());
+        EXPECT_EQ(decoded[0].analysis->mask, expected.mask);
+        EXPECT(all(decoded[0].analysis->value == expected.value));
+        EXPECT(all(decoded[0].analysis->minValue == expected.minValue));
+        EXPECT(all(decoded[0].analysis->maxValue == expected.maxValue));
+
+        // Analysis is only done on request, and not for DDS files.
+        EXPECT(!decoded[1].analysis.has_value());
+        EXPECT(!decoded[2].analysis.has_value());
+    }
+}
+} // namespace Falcor
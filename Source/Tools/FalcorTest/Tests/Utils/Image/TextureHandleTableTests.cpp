@@ -0,0 +1,145 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Image/TextureHandleTable.h"
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Falcor
+{
+CPU_TEST(TextureHandleTable_Basic)
+{
+    TextureHandleTable<int> table(10);
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.getMaxCount(), 10);
+    EXPECT(table.tryGet(0) == nullptr);
+
+    // IDs are allocated sequentially until the table is full.
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        uint32_t id = table.allocate();
+        EXPECT_EQ(id, i);
+        table[id] = (int)i * 10;
+    }
+    EXPECT_EQ(table.size(), 10);
+    EXPECT_EQ(table.allocate(), TextureHandleTable<int>::kInvalidID);
+
+    for (uint32_t i = 0; i < 10; i++)
+        EXPECT_EQ(table[i], (int)i * 10);
+
+    // Released IDs are reused in LIFO order.
+    table.release(3);
+    table.release(7);
+    EXPECT_EQ(table.allocate(), 7);
+    EXPECT_EQ(table.allocate(), 3);
+    EXPECT_EQ(table.allocate(), TextureHandleTable<int>::kInvalidID);
+    EXPECT_EQ(table.size(), 10);
+}
+
+CPU_TEST(TextureHandleTable_Pages)
+{
+    const uint32_t kCount = TextureHandleTable<uint32_t>::kPageSize * 3 + 5;
+    TextureHandleTable<uint32_t> table(kCount);
+
+    for (uint32_t i = 0; i < kCount; i++)
+    {
+        uint32_t id = table.allocate();
+        ASSERT_EQ(id, i);
+        table[id] = i;
+    }
+    EXPECT_EQ(table.allocate(), TextureHandleTable<uint32_t>::kInvalidID);
+
+    // Slots don't move when new pages are allocated.
+    for (uint32_t i = 0; i < kCount; i++)
+        EXPECT_EQ(table[i], i);
+}
+
+CPU_TEST(TextureHandleTable_Concurrent)
+{
+    const uint32_t kThreadCount = 8;
+    const uint32_t kIterations = 20000;
+    const uint32_t kMaxCount = 1000;
+    TextureHandleTable<std::atomic<uint32_t>> table(kMaxCount);
+
+    // Each thread repeatedly allocates and releases IDs. An ID must never be owned by two threads at the same time.
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                std::vector<uint32_t> owned;
+                for (uint32_t i = 0; i < kIterations; i++)
+                {
+                    if (owned.size() < 32 && (i % 3) != 2)
+                    {
+                        uint32_t id = table.allocate();
+                        if (id == TextureHandleTable<std::atomic<uint32_t>>::kInvalidID)
+                            continue;
+                        uint32_t prev = table[id].exchange(t + 1);
+                        if (prev != 0)
+                            failed = true;
+                        owned.push_back(id);
+                    }
+                    else if (!owned.empty())
+                    {
+                        uint32_t id = owned.back();
+                        owned.pop_back();
+                        if (table[id].exchange(0) != t + 1)
+                            failed = true;
+                        table.release(id);
+                    }
+                }
+                for (uint32_t id : owned)
+                {
+                    table[id] = 0;
+                    table.release(id);
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT(!failed);
+    EXPECT_LE(table.size(), kThreadCount * 32);
+
+    // All IDs are back on the free list and can be allocated again exactly once.
+    std::set<uint32_t> ids;
+    for (uint32_t i = 0; i < kMaxCount; i++)
+    {
+        uint32_t id = table.allocate();
+        ASSERT_NE(id, TextureHandleTable<std::atomic<uint32_t>>::kInvalidID);
+        EXPECT(ids.insert(id).second);
+    }
+    EXPECT_EQ(table.allocate(), TextureHandleTable<std::atomic<uint32_t>>::kInvalidID);
+}
+} // namespace Falcor
@@ -0,0 +1,154 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Timing/Profiler.h"
+#include <random>
+#include <string>
+#include <thread>
+
+namespace Falcor
+{
+CPU_TEST(Profiler_RollingStats)
+{
+    const size_t kWindowSize = 64;
+    Profiler::RollingStats rollingStats(kWindowSize);
+
+    Profiler::Stats empty = rollingStats.getStats();
+    EXPECT_EQ(empty.mean, 0.f);
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> dist(0.f, 10.f);
+    std::vector<float> values;
+
+    // Compare against the reference over several window wraps, including a trend that keeps evicting the extremes.
+    for (size_t i = 0; i < 5 * kWindowSize + 17; ++i)
+    {
+        float value = i < 2 * kWindowSize ? dist(rng) : float(i);
+        values.push_back(value);
+        rollingStats.add(value);
+
+        size_t count = std::min(values.size(), kWindowSize);
+        Profiler::Stats ref = Profiler::Stats::compute(values.data() + values.size() - count, count);
+        Profiler::Stats stats = rollingStats.getStats();
+        EXPECT_EQ(rollingStats.getCount(), count);
+        EXPECT_EQ(stats.min, ref.min);
+        EXPECT_EQ(stats.max, ref.max);
+        EXPECT_LE(std::abs(stats.mean - ref.mean), 1e-4f * std::max(1.f, std::abs(ref.mean)));
+        EXPECT_LE(std::abs(stats.stdDev - ref.stdDev), 1e-3f * std::max(1.f, ref.stdDev));
+    }
+}
+
+CPU_TEST(Profiler_NameIds)
+{
+    // Constant names are interned once per call site, other names on every call.
+    auto getConstantId = []() { return FALCOR_PROFILER_NAME_ID("ProfilerTestConstant"); };
+    EXPECT_EQ(getConstantId(), Profiler::internName("ProfilerTestConstant"));
+    EXPECT_EQ(getConstantId(), getConstantId());
+    EXPECT_EQ(Profiler::getName(getConstantId()), "ProfilerTestConstant");
+
+    std::string name = "ProfilerTestA";
+    auto getId = [&]() { return FALCOR_PROFILER_NAME_ID(name); };
+    Profiler::NameId idA = getId();
+    name = "ProfilerTestB";
+    Profiler::NameId idB = getId();
+    EXPECT_NE(idA, idB);
+    EXPECT_EQ(Profiler::getName(idA), "ProfilerTestA");
+    EXPECT_EQ(Profiler::getName(idB), "ProfilerTestB");
+
+    // Interned names are passed through.
+    EXPECT_EQ(FALCOR_PROFILER_NAME_ID(idA), idA);
+}
+
+CPU_TEST(Profiler_NameIdsConcurrent)
+{
+    // Intern the same names from several threads in different orders, enough to grow the name table.
+    const uint32_t kThreadCount = 8;
+    const uint32_t kNameCount = 1000;
+    std::vector<std::vector<Profiler::NameId>> ids(kThreadCount, std::vector<Profiler::NameId>(kNameCount));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back(
+            [&ids, t]()
+            {
+                for (uint32_t i = 0; i < kNameCount; i++)
+                {
+                    uint32_t n = (i * 7919 + t * 31) % kNameCount;
+                    ids[t][n] = Profiler::internName(fmt::format("ProfilerTestConcurrent{}", n));
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (uint32_t t = 1; t < kThreadCount; t++)
+        EXPECT(ids[t] == ids[0]);
+    for (uint32_t n = 0; n < kNameCount; n++)
+        EXPECT_EQ(Profiler::getName(ids[0][n]), fmt::format("ProfilerTestConcurrent{}", n));
+}
+
+GPU_TEST(Profiler_Events)
+{
+    RenderContext* pRenderContext = ctx.getRenderContext();
+    Profiler* pProfiler = ctx.getDevice()->getProfiler();
+    bool wasEnabled = pProfiler->isEnabled();
+    pProfiler->setEnabled(true);
+
+    Profiler::NameId innerId = pProfiler->internName("Inner");
+    EXPECT_EQ(pProfiler->internName("Inner"), innerId);
+    EXPECT_EQ(pProfiler->getName(innerId), "Inner");
+
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        {
+            ScopedProfilerEvent outer(pRenderContext, "ProfilerTest", Profiler::Flags::Internal);
+            for (uint32_t i = 0; i < 4; ++i)
+                ScopedProfilerEvent inner(pRenderContext, innerId, Profiler::Flags::Internal);
+        }
+        pProfiler->endFrame(pRenderContext);
+    }
+
+    // Repeated events are registered once per frame.
+    std::vector<std::string> names;
+    for (const Profiler::Event* pEvent : pProfiler->getEvents())
+        names.push_back(pEvent->getName());
+    EXPECT_EQ(std::count(names.begin(), names.end(), "/ProfilerTest"), 1);
+    EXPECT_EQ(std::count(names.begin(), names.end(), "/ProfilerTest/Inner"), 1);
+
+    // Events created through the tree are found by their nested name.
+    Profiler::Event* pInner = pProfiler->getEvent("/ProfilerTest/Inner");
+    EXPECT(std::find(pProfiler->getEvents().begin(), pProfiler->getEvents().end(), pInner) != pProfiler->getEvents().end());
+    EXPECT_GE(pInner->getCpuTime(), 0.f);
+
+    EXPECT_GE(pProfiler->getOverhead().eventCount, 5u);
+    EXPECT_GE(pProfiler->getOverhead().cpuTime, 0.f);
+
+    pProfiler->setEnabled(wasEnabled);
+}
+} // namespace Falcor
@@ -34,6 +34,7 @@
 #include <nlohmann/json.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <thread>
 
 namespace Falcor
 {
@@ -126,6 +127,18 @@ void testPropertyType(CPUUnitTestContext& ctx, const T& checkValue, const T& dif
         EXPECT(!props.getTo<T>("value2", holderValue));
         EXPECT_EQ(holderValue, differentValue);
     }
+
+    // Test lazy access to binary encoded properties.
+    {
+        Properties binaryProps = Properties::fromBinary(props.toBinary());
+        EXPECT(binaryProps.has("value"));
+        EXPECT(!binaryProps.has("value2"));
+        EXPECT_EQ(binaryProps.get<T>("value"), checkValue);
+        EXPECT_THROW(binaryProps.get<T>("value2"));
+        EXPECT_EQ(binaryProps.get<T>("value2", differentValue), differentValue);
+        EXPECT(binaryProps.isLazy());
+        EXPECT_EQ(binaryProps.toJson(), props.toJson());
+    }
 }
 
 CPU_TEST(PropertiesBasicValues)
@@ -467,4 +480,213 @@ CPU_TEST(PropertiesSerialization)
     EXPECT_EQ(ts.nested.c, "66");
 }
 
+CPU_TEST(PropertiesBinaryRoundTrip)
+{
+    Properties::json jnested = {
+        {"str", "string"},
+        {"empty_object", Properties::json::object()},
+        {"empty_array", Properties::json::array()},
+    };
+    Properties::json j = {
+        {"null", nullptr},
+        {"b", true},
+        {"u32", std::numeric_limits<uint32_t>::max()},
+        {"u64", std::numeric_limits<uint64_t>::max()},
+        {"i32", std::numeric_limits<int32_t>::lowest()},
+        {"i64", std::numeric_limits<int64_t>::lowest()},
+        {"f32", std::numeric_limits<float>::max()},
+        {"f64", std::numeric_limits<double>::max()},
+        {"uint3", {1u, 2u, 3u}},
+        {"int3", {-1, 2, -3}},
+        {"float3", {0.25f, 0.5f, 0.75f}},
+        {"mixed", {1, -2, 3.5, "four", false, nullptr, {{"five", 5}}}},
+        {"str", "string with unicode \u00e4"},
+        {"nested", jnested},
+        {"nested_array", {jnested, jnested, {1, 2}}},
+    };
+
+    // Large arrays are stored packed, large objects are encoded and decoded in parallel.
+    Properties::json floats = Properties::json::array();
+    Properties::json ints = Properties::json::array();
+    Properties::json objects = Properties::json::object();
+    for (int i = 0; i < 100000; ++i)
+    {
+        floats.push_back(i * 0.125);
+        ints.push_back(-i);
+    }
+    for (int i = 0; i < 5000; ++i)
+        objects[fmt::format("edit{}", i)] = {{"index", i}, {"position", {i * 1.0, i * 2.0, i * 3.0}}, {"name", fmt::format("sdf{}", i)}};
+    j["floats"] = floats;
+    j["ints"] = ints;
+    j["objects"] = objects;
+
+    Properties props(j);
+    std::vector<uint8_t> data = props.toBinary();
+    Properties binaryProps = Properties::fromBinary(data.data(), data.size());
+    EXPECT(binaryProps.isLazy());
+
+    // Test equivalence with the JSON form, including value types and order.
+    Properties::json decoded = binaryProps.toJson();
+    EXPECT_EQ(decoded, j);
+    EXPECT_EQ(decoded.dump(), j.dump());
+    EXPECT(decoded["u64"].is_number_unsigned());
+    EXPECT(decoded["i32"].is_number_integer() && !decoded["i32"].is_number_unsigned());
+    EXPECT(decoded["uint3"][0].is_number_unsigned());
+    EXPECT(decoded["int3"][1].is_number_integer() && !decoded["int3"][1].is_number_unsigned());
+    EXPECT(decoded["floats"][1].is_number_float());
+    EXPECT(!binaryProps.isLazy());
+    EXPECT_EQ(binaryProps, props);
+
+    // Re-encoding gives the same data, both from the decoded and from the lazy properties.
+    EXPECT(binaryProps.toBinary() == data);
+    EXPECT(Properties::fromBinary(std::vector<uint8_t>(data)).toBinary() == data);
+
+    // Nested properties can be encoded on their own.
+    Properties nested = Properties::fromBinary(data.data(), data.size()).get<Properties>("nested");
+    EXPECT(nested.isLazy());
+    EXPECT_EQ(Properties::fromBinary(nested.toBinary()).toJson(), jnested);
+
+    // Empty properties.
+    EXPECT(Properties::fromBinary(Properties().toBinary()).empty());
+}
+
+CPU_TEST(PropertiesBinaryLazy)
+{
+    Properties nested;
+    nested.set("a", 11);
+    nested.set("b", float3(1.f, 2.f, 3.f));
+
+    Properties props;
+    props.set("a", 1);
+    props.set("b", 2.f);
+    props.set("c", "3");
+    props.set("nested", nested);
+
+    Properties binaryProps = Properties::fromBinary(props.toBinary());
+    EXPECT(binaryProps.isLazy());
+    EXPECT(!binaryProps.empty());
+
+    // Accessing values and nested properties does not decode the whole object.
+    EXPECT_EQ(binaryProps.get<int>("a"), 1);
+    EXPECT_EQ(binaryProps.get<std::string>("c"), "3");
+    EXPECT_THROW(binaryProps.get<Properties>("a"));
+    Properties binaryNested = binaryProps.get<Properties>("nested");
+    EXPECT(binaryNested.isLazy());
+    EXPECT_EQ(binaryNested.get<float3>("b"), float3(1.f, 2.f, 3.f));
+    EXPECT(binaryProps.isLazy());
+
+    // Copies share the binary data.
+    Properties copy = binaryProps;
+    EXPECT(copy.isLazy());
+    EXPECT_EQ(copy, binaryProps);
+
+    // Modifying decodes the object, leaving copies and nested properties untouched.
+    binaryNested.set("a", 22);
+    EXPECT(!binaryNested.isLazy());
+    EXPECT_EQ(binaryNested.get<int>("a"), 22);
+    EXPECT_EQ(binaryProps.get<Properties>("nested").get<int>("a"), 11);
+
+    binaryProps.set("d", 4);
+    EXPECT(!binaryProps.isLazy());
+    EXPECT_EQ(binaryProps.get<int>("a"), 1);
+    EXPECT_EQ(binaryProps.get<int>("d"), 4);
+    EXPECT(copy.isLazy());
+    EXPECT(!copy.has("d"));
+    EXPECT_NE(copy, binaryProps);
+
+    // Iterating decodes the object.
+    const Properties constCopy = copy;
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : constCopy)
+        keys.push_back(key);
+    EXPECT(keys == std::vector<std::string>({"a", "b", "c", "nested"}));
+    EXPECT(!constCopy.isLazy());
+
+    // Deserializing from lazy properties.
+    auto ts = PropertiesReader::read<TestStruct>(Properties::fromBinary(PropertiesWriter::write(TestStruct{}).toBinary()));
+    EXPECT_EQ(ts.a, 1);
+    EXPECT_EQ(ts.nested.c, "33");
+}
+
+CPU_TEST(PropertiesBinaryConcurrentAccess)
+{
+    Properties props;
+    for (int i = 0; i < 100; ++i)
+        props.set(fmt::format("value{}", i), i);
+    const Properties::json expected = props.toJson();
+
+    // Const access to lazy properties from multiple threads decodes the binary data only once.
+    const Properties binaryProps = Properties::fromBinary(props.toBinary());
+    EXPECT(binaryProps.isLazy());
+
+    const size_t kThreadCount = 8;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> failures(kThreadCount, 0);
+    for (size_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    const std::string name = fmt::format("value{}", i);
+                    if (!binaryProps.has(name) || binaryProps.get<int>(name) != i)
+                        failures[t]++;
+                    if ((i + t) % 10 == 0 && binaryProps.toJson() != expected)
+                        failures[t]++;
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < kThreadCount; ++t)
+        EXPECT_EQ(failures[t], 0);
+    EXPECT(!binaryProps.isLazy());
+    EXPECT_EQ(binaryProps.get<int>("value42"), 42);
+}
+
+CPU_TEST(PropertiesBinaryInvalid)
+{
+    Properties props(Properties::json{{"a", 1}, {"b", "string"}, {"c", {1, 2, 3}}, {"d", {{"e", nullptr}}}});
+    std::vector<uint8_t> data = props.toBinary();
+
+    // Truncated data.
+    for (size_t size = 0; size < data.size(); ++size)
+        EXPECT_THROW(Properties::fromBinary(data.data(), size));
+
+    // Trailing data.
+    {
+        std::vector<uint8_t> invalid = data;
+        invalid.push_back(0);
+        EXPECT_THROW(Properties::fromBinary(std::move(invalid)));
+    }
+
+    // Wrong magic or version.
+    for (size_t i = 0; i < 8; ++i)
+    {
+        std::vector<uint8_t> invalid = data;
+        invalid[i] ^= 0xff;
+        EXPECT_THROW(Properties::fromBinary(std::move(invalid)));
+    }
+
+    // Root is not an object.
+    {
+        std::vector<uint8_t> invalid(data.begin(), data.begin() + 8);
+        invalid.push_back(0); // Null
+        EXPECT_THROW(Properties::fromBinary(std::move(invalid)));
+    }
+
+    // Unknown tag.
+    {
+        std::vector<uint8_t> invalid = data;
+        invalid[8] = 0xff;
+        EXPECT_THROW(Properties::fromBinary(std::move(invalid)));
+    }
+
+    // JSON values that are not objects cannot be encoded.
+    EXPECT_THROW(Properties(Properties::json::array()).toBinary());
+}
+
 } // namespace Falcor
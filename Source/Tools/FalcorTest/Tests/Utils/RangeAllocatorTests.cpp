@@ -0,0 +1,338 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/RangeAllocator.h"
+#include "Utils/Timing/CpuTimer.h"
+#include <map>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+/// Check that the live allocations are disjoint, inside the address space and aligned.
+void checkAllocations(
+    CPUUnitTestContext& ctx,
+    const RangeAllocator& allocator,
+    const std::vector<RangeAllocator::Allocation>& allocations,
+    uint64_t alignment
+)
+{
+    std::map<uint64_t, uint64_t> ranges;
+    uint64_t usedBytes = 0;
+    for (const auto& a : allocations)
+    {
+        EXPECT(a.isValid());
+        EXPECT_EQ(a.offset % alignment, 0);
+        EXPECT_LE(a.offset + a.size, allocator.getCapacity());
+        ranges[a.offset] = a.size;
+        usedBytes += a.size;
+    }
+    EXPECT_EQ(ranges.size(), allocations.size());
+
+    uint64_t end = 0;
+    for (const auto& [offset, size] : ranges)
+    {
+        EXPECT_GE(offset, end);
+        end = offset + size;
+    }
+
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.usedBytes, usedBytes);
+    EXPECT_EQ(stats.allocationCount, allocations.size());
+    EXPECT_EQ(stats.usedBytes + stats.pendingBytes + stats.freeBytes, stats.capacity);
+}
+} // namespace
+
+CPU_TEST(RangeAllocator_Basic)
+{
+    RangeAllocator allocator(1024);
+    EXPECT(allocator.isEmpty());
+
+    auto a = allocator.allocate(100);
+    auto b = allocator.allocate(200);
+    auto c = allocator.allocate(300);
+    EXPECT(a.isValid() && b.isValid() && c.isValid());
+    checkAllocations(ctx, allocator, {a, b, c}, 1);
+
+    // Too large.
+    EXPECT(!allocator.allocate(1024).isValid());
+    EXPECT(!allocator.allocate(500).isValid());
+
+    // Release the middle allocation, the hole can be reused.
+    allocator.release(b);
+    EXPECT(allocator.hasHoles());
+    auto d = allocator.allocate(150);
+    EXPECT(d.isValid());
+    EXPECT_EQ(d.offset, b.offset);
+    checkAllocations(ctx, allocator, {a, c, d}, 1);
+
+    // Releasing everything coalesces all free space into a single range.
+    allocator.release(a);
+    allocator.release(c);
+    allocator.release(d);
+    auto stats = allocator.getStats();
+    EXPECT(allocator.isEmpty());
+    EXPECT_EQ(stats.freeBlockCount, 1);
+    EXPECT_EQ(stats.largestFreeBlock, 1024);
+    EXPECT_EQ(stats.getFragmentation(), 0.0);
+    EXPECT(allocator.allocate(1024).isValid());
+
+    // Releasing twice is an error.
+    EXPECT_THROW(allocator.release(a));
+}
+
+CPU_TEST(RangeAllocator_Alignment)
+{
+    RangeAllocator allocator(4096);
+    std::vector<RangeAllocator::Allocation> allocations;
+    allocations.push_back(allocator.allocate(3));
+    for (uint64_t alignment : {1, 4, 16, 64, 256})
+    {
+        auto a = allocator.allocate(alignment + 5, alignment);
+        EXPECT_EQ(a.offset % alignment, 0);
+        allocations.push_back(a);
+    }
+    checkAllocations(ctx, allocator, allocations, 1);
+
+    EXPECT_THROW(allocator.allocate(16, 3));
+    EXPECT_THROW(allocator.allocate(0));
+
+    // The alignment padding is free and can be reused.
+    auto stats = allocator.getStats();
+    EXPECT_GT(stats.freeBlockCount, 1);
+    for (const auto& a : allocations)
+        allocator.release(a);
+    EXPECT_EQ(allocator.getStats().freeBlockCount, 1);
+}
+
+CPU_TEST(RangeAllocator_DeferredRelease)
+{
+    RangeAllocator allocator(256);
+    auto a = allocator.allocate(128);
+    auto b = allocator.allocate(128);
+
+    allocator.releaseDeferred(a, 5);
+    allocator.releaseDeferred(b, 3);
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.allocationCount, 0);
+    EXPECT_EQ(stats.pendingCount, 2);
+    EXPECT_EQ(stats.pendingBytes, 256);
+    EXPECT(!allocator.isEmpty());
+    EXPECT(!allocator.allocate(1).isValid());
+
+    // Releases happen once the fence value is passed.
+    EXPECT_EQ(allocator.executeDeferredReleases(3), 0);
+    EXPECT_EQ(allocator.executeDeferredReleases(4), 1);
+    auto c = allocator.allocate(128);
+    EXPECT(c.isValid());
+    EXPECT_EQ(c.offset, b.offset);
+    EXPECT_EQ(allocator.executeDeferredReleases(100), 1);
+    allocator.release(c);
+    EXPECT(allocator.isEmpty());
+    EXPECT_EQ(allocator.getStats().freeBlockCount, 1);
+}
+
+CPU_TEST(RangeAllocator_GrowAppendTrim)
+{
+    RangeAllocator allocator;
+    EXPECT_EQ(allocator.getCapacity(), 0);
+    EXPECT(!allocator.allocate(1).isValid());
+
+    auto a = allocator.append(0, 20);
+    auto b = allocator.append(32, 4, 16);
+    EXPECT_EQ(a.offset, 0);
+    EXPECT_EQ(b.offset, 32);
+    EXPECT_EQ(allocator.getCapacity(), 36);
+    EXPECT_THROW(allocator.append(8, 4));
+
+    // The gap is free.
+    auto c = allocator.allocate(12);
+    EXPECT_EQ(c.offset, 20);
+    EXPECT(!allocator.hasHoles());
+
+    allocator.grow(100);
+    EXPECT_EQ(allocator.getCapacity(), 100);
+    EXPECT(!allocator.hasHoles());
+    auto d = allocator.allocate(64);
+    EXPECT_EQ(d.offset, 36);
+
+    allocator.release(d);
+    EXPECT_EQ(allocator.trim(), 36);
+    allocator.release(b);
+    EXPECT_EQ(allocator.trim(), 32);
+    allocator.release(a);
+    EXPECT(allocator.hasHoles());
+    allocator.release(c);
+    EXPECT_EQ(allocator.trim(), 0);
+    EXPECT(allocator.isEmpty());
+}
+
+CPU_TEST(RangeAllocator_Defragment)
+{
+    RangeAllocator allocator(1024);
+    std::vector<RangeAllocator::Allocation> allocations;
+    for (uint32_t i = 0; i < 16; ++i)
+        allocations.push_back(allocator.allocate(16 * (1 + i % 3), 16));
+    auto pinned = allocations[9];
+
+    // Release every other allocation and defer one release.
+    std::vector<RangeAllocator::Allocation> live;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        if (i == 9)
+            allocator.releaseDeferred(allocations[i], 1);
+        else if (i % 2 == 0)
+            allocator.release(allocations[i]);
+        else
+            live.push_back(allocations[i]);
+    }
+    EXPECT_GT(allocator.getStats().getFragmentation(), 0.0);
+
+    auto moves = allocator.defragment();
+    EXPECT(!moves.empty());
+    uint64_t prevOffset = 0;
+    for (const auto& move : moves)
+    {
+        EXPECT_NE(move.block, pinned.block);
+        EXPECT_LE(move.dstOffset, move.srcOffset);
+        EXPECT_GE(move.dstOffset, prevOffset);
+        prevOffset = move.dstOffset;
+    }
+
+    // Update the allocations.
+    for (auto& a : live)
+        a.offset = allocator.getOffset(a);
+    checkAllocations(ctx, allocator, live, 16);
+
+    // Only the space in front of the pinned deferred release and the tail remain free.
+    auto stats = allocator.getStats();
+    EXPECT_LE(stats.freeBlockCount, 2);
+
+    allocator.executeDeferredReleases(2);
+    allocator.defragment();
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.freeBlockCount, 1);
+    EXPECT_EQ(stats.getFragmentation(), 0.0);
+
+    for (auto& a : live)
+    {
+        a.offset = allocator.getOffset(a);
+        allocator.release(a);
+    }
+    EXPECT(allocator.isEmpty());
+}
+
+CPU_TEST(RangeAllocator_Stress)
+{
+    const uint64_t kCapacity = 1 << 20;
+    const uint64_t kAlignment = 8;
+    RangeAllocator allocator(kCapacity);
+    std::vector<RangeAllocator::Allocation> allocations;
+    std::mt19937 rng(1234);
+    uint64_t fenceValue = 0;
+
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint32_t op = rng() % 8;
+        if (op < 4 || allocations.empty())
+        {
+            // Mix of small and large allocations.
+            uint64_t size = (rng() % 4 == 0) ? 1 + rng() % 16384 : 1 + rng() % 256;
+            auto a = allocator.allocate(size, kAlignment << (rng() % 4));
+            if (a.isValid())
+                allocations.push_back(a);
+        }
+        else
+        {
+            size_t index = rng() % allocations.size();
+            if (op == 7)
+                allocator.releaseDeferred(allocations[index], fenceValue);
+            else
+                allocator.release(allocations[index]);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+
+        if (i % 100 == 0)
+            allocator.executeDeferredReleases(fenceValue++);
+        if (i % 1000 == 0)
+            checkAllocations(ctx, allocator, allocations, kAlignment);
+    }
+    checkAllocations(ctx, allocator, allocations, kAlignment);
+
+    for (const auto& a : allocations)
+        allocator.release(a);
+    allocator.executeDeferredReleases(fenceValue + 1);
+
+    auto stats = allocator.getStats();
+    EXPECT(allocator.isEmpty());
+    EXPECT_EQ(stats.freeBlockCount, 1);
+    EXPECT_EQ(stats.freeBytes, kCapacity);
+}
+
+CPU_TEST(RangeAllocator_Benchmark, TAGS("benchmark"))
+{
+    const uint32_t kOpCount = 1000000;
+    RangeAllocator allocator(1ull << 40);
+    std::vector<RangeAllocator::Allocation> allocations;
+    allocations.reserve(kOpCount);
+    std::mt19937 rng(42);
+
+    auto start = CpuTimer::getCurrentTimePoint();
+    for (uint32_t i = 0; i < kOpCount; ++i)
+    {
+        if (rng() % 3 != 0 || allocations.empty())
+        {
+            auto a = allocator.allocate(1 + rng() % 65536, 16);
+            if (a.isValid())
+                allocations.push_back(a);
+        }
+        else
+        {
+            size_t index = rng() % allocations.size();
+            allocator.release(allocations[index]);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+    }
+    double ms = CpuTimer::calcDuration(start, CpuTimer::getCurrentTimePoint());
+
+    auto stats = allocator.getStats();
+    logInfo(
+        "RangeAllocator: {} operations in {:.2f} ms ({:.1f} ns/op), {} live allocations, {} free ranges, fragmentation {:.3f}.",
+        kOpCount,
+        ms,
+        ms * 1e6 / kOpCount,
+        stats.allocationCount,
+        stats.freeBlockCount,
+        stats.getFragmentation()
+    );
+    EXPECT_EQ(stats.allocationCount, allocations.size());
+}
+} // namespace Falcor
@@ -0,0 +1,330 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/ReadbackRing.h"
+#include <map>
+#include <random>
+
+namespace Falcor
+{
+namespace
+{
+/// Mock of a GPU fence. Requests are tagged with the next value to be signaled, and the test decides when values complete.
+struct MockFence
+{
+    uint64_t signaledValue = 0;
+    uint64_t completedValue = 0;
+
+    uint64_t getNextValue() const { return signaledValue + 1; }
+    void signal() { signaledValue++; }
+    void complete() { completedValue = signaledValue; }
+};
+
+/// Fill a range of staging memory with a pattern derived from the ticket, standing in for the GPU copy.
+void writePattern(std::vector<uint8_t>& memory, uint64_t offset, uint64_t size, ReadbackRing::Ticket ticket)
+{
+    for (uint64_t i = 0; i < size; i++)
+        memory[offset + i] = uint8_t(ticket * 31 + i);
+}
+
+bool checkPattern(const void* pData, size_t size, ReadbackRing::Ticket ticket)
+{
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    for (size_t i = 0; i < size; i++)
+        if (pBytes[i] != uint8_t(ticket * 31 + i))
+            return false;
+    return true;
+}
+} // namespace
+
+CPU_TEST(ReadbackRing_Basic)
+{
+    ReadbackRing ring(1024);
+    std::vector<uint8_t> memory(1024);
+    MockFence fence;
+
+    auto push = [&](uint64_t size)
+    {
+        auto request = ring.push(
+            size, 16, fence.getNextValue(), [&, size](const void* pData, size_t dataSize) { EXPECT_EQ(dataSize, size); }, nullptr
+        );
+        EXPECT(request.isValid());
+        EXPECT_EQ(request.offset % 16, 0);
+        return request.ticket;
+    };
+
+    // Two requests in the first frame, one in the second.
+    ReadbackRing::Ticket t0 = push(100);
+    ReadbackRing::Ticket t1 = push(10);
+    fence.signal();
+    ReadbackRing::Ticket t2 = push(50);
+    fence.signal();
+
+    EXPECT(t0 != ReadbackRing::kInvalidTicket);
+    EXPECT(t0 < t1 && t1 < t2);
+    EXPECT_EQ(ring.getFenceValue(t0), 1);
+    EXPECT_EQ(ring.getFenceValue(t1), 1);
+    EXPECT_EQ(ring.getFenceValue(t2), 2);
+    EXPECT_EQ(ring.getOldestFenceValue(), 1);
+    EXPECT_EQ(ring.getStats().pendingCount, 3);
+
+    // Nothing completed yet.
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 0);
+    EXPECT(!ring.isRetired(t0));
+
+    // First frame completes.
+    fence.completedValue = 1;
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 2);
+    EXPECT(ring.isRetired(t0));
+    EXPECT(ring.isRetired(t1));
+    EXPECT(!ring.isRetired(t2));
+    EXPECT_EQ(ring.getOldestFenceValue(), 2);
+
+    // Second frame completes.
+    fence.complete();
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 1);
+    EXPECT(ring.isRetired(t2));
+    EXPECT(ring.isEmpty());
+    EXPECT(!ring.isRetired(ReadbackRing::kInvalidTicket));
+
+    auto stats = ring.getStats();
+    EXPECT_EQ(stats.usedBytes, 0);
+    EXPECT_EQ(stats.requestCount, 3);
+    EXPECT_EQ(stats.retiredCount, 3);
+}
+
+CPU_TEST(ReadbackRing_Order)
+{
+    ReadbackRing ring(256);
+    std::vector<uint8_t> memory(256);
+    std::vector<uint32_t> order;
+
+    // Eight requests, three per frame.
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        ring.push(16, 16, 1 + i / 3, [&order, i](const void*, size_t) { order.push_back(i); });
+    }
+
+    // Callbacks are invoked in submission order.
+    ring.retire(2, memory.data());
+    EXPECT_EQ(order.size(), 6);
+    ring.retire(3, memory.data());
+    EXPECT_EQ(order.size(), 8);
+    for (uint32_t i = 0; i < order.size(); i++)
+        EXPECT_EQ(order[i], i);
+
+    // Fence values must not decrease.
+    ring.push(16, 16, 3, nullptr);
+    EXPECT_THROW(ring.push(16, 16, 2, nullptr));
+}
+
+CPU_TEST(ReadbackRing_WrapAround)
+{
+    const uint64_t kCapacity = 256;
+    ReadbackRing ring(kCapacity);
+    std::vector<uint8_t> memory(kCapacity);
+    MockFence fence;
+
+    // Fill the ring with four 64B requests in separate frames.
+    std::vector<ReadbackRing::Request> requests;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        auto request = ring.push(64, 16, fence.getNextValue(), nullptr);
+        EXPECT(request.isValid());
+        EXPECT_EQ(request.offset, i * 64);
+        requests.push_back(request);
+        fence.signal();
+    }
+    EXPECT_EQ(ring.getStats().usedBytes, kCapacity);
+
+    // The ring is full.
+    EXPECT(!ring.push(1, 1, fence.getNextValue(), nullptr).isValid());
+
+    // Retire the first two requests and wrap around.
+    fence.completedValue = 2;
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 2);
+    auto request = ring.push(100, 16, fence.getNextValue(), nullptr);
+    EXPECT(request.isValid());
+    EXPECT_EQ(request.offset, 0);
+
+    // Only 28B are left before the oldest pending range (at offset 128).
+    EXPECT(!ring.push(32, 16, fence.getNextValue(), nullptr).isValid());
+    request = ring.push(16, 16, fence.getNextValue(), nullptr);
+    EXPECT(request.isValid());
+    EXPECT_EQ(request.offset, 112);
+    fence.signal();
+
+    // Retiring everything resets the ring, so a request of the full capacity fits.
+    fence.complete();
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 4);
+    EXPECT(ring.isEmpty());
+    request = ring.push(kCapacity, 16, fence.getNextValue(), nullptr);
+    EXPECT(request.isValid());
+    EXPECT_EQ(request.offset, 0);
+
+    // Requests larger than the ring never fit.
+    EXPECT(!ring.push(kCapacity + 1, 16, fence.getNextValue(), nullptr).isValid());
+
+    // Resizing requires an empty ring.
+    EXPECT_THROW(ring.resize(2 * kCapacity));
+    fence.signal();
+    fence.complete();
+    ring.retire(fence.completedValue, memory.data());
+    ring.resize(2 * kCapacity);
+    EXPECT_EQ(ring.getCapacity(), 2 * kCapacity);
+    EXPECT(ring.push(kCapacity + 1, 16, fence.getNextValue(), nullptr).isValid());
+}
+
+CPU_TEST(ReadbackRing_Cancel)
+{
+    ReadbackRing ring(1024);
+    std::vector<uint8_t> memory(1024);
+    MockFence fence;
+    uint32_t ownerA = 0, ownerB = 0, calls[3] = {};
+
+    auto t0 = ring.push(16, 16, fence.getNextValue(), [&](const void*, size_t) { calls[0]++; }, &ownerA).ticket;
+    auto t1 = ring.push(16, 16, fence.getNextValue(), [&](const void*, size_t) { calls[1]++; }, &ownerB).ticket;
+    ring.push(16, 16, fence.getNextValue(), [&](const void*, size_t) { calls[2]++; }, &ownerA);
+    fence.signal();
+
+    ring.cancel(t1);
+    ring.cancel(&ownerA);
+    EXPECT_EQ(ring.getStats().cancelCount, 3);
+
+    // Cancelled requests keep their range until retired.
+    EXPECT_EQ(ring.getStats().pendingCount, 3);
+    EXPECT(!ring.isRetired(t0));
+
+    fence.complete();
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 3);
+    EXPECT(ring.isRetired(t0));
+    EXPECT(ring.isRetired(t1));
+    EXPECT_EQ(calls[0] + calls[1] + calls[2], 0);
+
+    // Cancelling retired requests is a no-op.
+    ring.cancel(t0);
+    EXPECT_EQ(ring.getStats().cancelCount, 3);
+}
+
+CPU_TEST(ReadbackRing_PushFromCallback)
+{
+    ReadbackRing ring(64);
+    std::vector<uint8_t> memory(64);
+    MockFence fence;
+
+    // A callback issuing a new request, e.g. to read back the next frame's data.
+    ReadbackRing::Ticket nextTicket = ReadbackRing::kInvalidTicket;
+    auto t0 = ring.push(
+        64,
+        16,
+        fence.getNextValue(),
+        [&](const void*, size_t)
+        {
+            auto request = ring.push(64, 16, fence.getNextValue(), nullptr);
+            EXPECT(request.isValid());
+            nextTicket = request.ticket;
+        }
+    ).ticket;
+    fence.signal();
+
+    fence.complete();
+    EXPECT_EQ(ring.retire(fence.completedValue, memory.data()), 1);
+    EXPECT(ring.isRetired(t0));
+    EXPECT(nextTicket != ReadbackRing::kInvalidTicket);
+    EXPECT(!ring.isRetired(nextTicket));
+    EXPECT_EQ(ring.getStats().pendingCount, 1);
+}
+
+CPU_TEST(ReadbackRing_Random)
+{
+    // Simulate frames with a random number of requests of random sizes, with the GPU lagging a few frames behind.
+    // The data is written when the request is made, so any overlap of pending ranges corrupts the data of an earlier request.
+    const uint64_t kCapacity = 4096;
+    const uint32_t kFrameCount = 2000;
+    const uint32_t kFramesInFlight = 3;
+
+    ReadbackRing ring(kCapacity);
+    std::vector<uint8_t> memory(kCapacity);
+    MockFence fence;
+    std::mt19937 rng(42);
+
+    std::map<ReadbackRing::Ticket, uint64_t> pending; // Ticket -> size.
+    uint64_t retiredCount = 0;
+    uint64_t failedCount = 0;
+    bool dataValid = true;
+
+    for (uint32_t frame = 0; frame < kFrameCount; frame++)
+    {
+        uint32_t requestCount = rng() % 8;
+        for (uint32_t i = 0; i < requestCount; i++)
+        {
+            uint64_t size = 1 + rng() % 512;
+            uint64_t alignment = 1ull << (rng() % 6);
+            ReadbackRing::Ticket expectedTicket = ring.getStats().requestCount + 1;
+            auto request = ring.push(
+                size,
+                alignment,
+                fence.getNextValue(),
+                [&, expectedTicket](const void* pData, size_t dataSize)
+                {
+                    dataValid &= checkPattern(pData, dataSize, expectedTicket);
+                    pending.erase(expectedTicket);
+                    retiredCount++;
+                }
+            );
+            if (!request.isValid())
+            {
+                failedCount++;
+                continue;
+            }
+            EXPECT_EQ(request.ticket, expectedTicket);
+            EXPECT_EQ(request.offset % alignment, 0);
+            EXPECT_LE(request.offset + size, kCapacity);
+            writePattern(memory, request.offset, size, request.ticket);
+            pending[request.ticket] = size;
+        }
+        fence.signal();
+
+        if (fence.signaledValue > kFramesInFlight)
+            fence.completedValue = fence.signaledValue - kFramesInFlight;
+        ring.retire(fence.completedValue, memory.data());
+
+        EXPECT_LE(ring.getStats().usedBytes, kCapacity);
+        EXPECT_EQ(ring.getStats().pendingCount, pending.size());
+    }
+
+    fence.complete();
+    ring.retire(fence.completedValue, memory.data());
+
+    EXPECT(dataValid);
+    EXPECT(pending.empty());
+    EXPECT(ring.isEmpty());
+    EXPECT_EQ(retiredCount, ring.getStats().requestCount);
+    EXPECT_GT(failedCount, 0);
+}
+} // namespace Falcor
@@ -27,6 +27,9 @@
  **************************************************************************/
 #include "Testing/UnitTest.h"
 #include "Utils/Image/TextureAnalyzer.h"
+#include "Utils/Image/Bitmap.h"
+#include <cmath>
+#include <limits>
 
 namespace Falcor
 {
@@ -118,6 +121,47 @@ const TextureAnalyzer::Result kExpectedResult[] = {
         float4(0.f, 0.f, 0.f, 1 / 256.f),
     },
 };
+
+std::filesystem::path getTestTexturePath(size_t i)
+{
+    return getRuntimeDirectory() / fmt::format("data/tests/texture{}.{}", i + 1, i < kNumPNGs ? "png" : "exr");
+}
+
+template<typename Context>
+void verifyResults(Context& ctx, const std::vector<TextureAnalyzer::Result>& result)
+{
+    // Verify results.
+    EXPECT_EQ(result.size(), kNumTests);
+    for (size_t i = 0; i < kNumTests; i++)
+    {
+        EXPECT_EQ(result[i].mask, kExpectedResult[i].mask) << "i = " << i;
+
+        uint32_t rangeFlags = 0;
+        for (int c = 0; c < 4; c++)
+        {
+            bool isConstant = (kExpectedResult[i].mask & (1u << c)) == 0;
+            rangeFlags |= kExpectedResult[i].mask >> (4 + 4 * c);
+
+            EXPECT_EQ(result[i].isConstant(1u << c), isConstant) << " c = " << c;
+            EXPECT_EQ(result[i].minValue[c], kExpectedResult[i].minValue[c]) << "i = " << i << " c = " << c;
+            EXPECT_EQ(result[i].maxValue[c], kExpectedResult[i].maxValue[c]) << "i = " << i << " c = " << c;
+
+            if (isConstant)
+            {
+                EXPECT_EQ(result[i].value[c], kExpectedResult[i].value[c]) << "i = " << i << " c = " << c;
+            }
+        }
+
+        EXPECT_EQ(result[i].isPos(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Pos) != 0)
+            << "i = " << i;
+        EXPECT_EQ(result[i].isNeg(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Neg) != 0)
+            << "i = " << i;
+        EXPECT_EQ(result[i].isInf(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Inf) != 0)
+            << "i = " << i;
+        EXPECT_EQ(result[i].isNaN(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::NaN) != 0)
+            << "i = " << i;
+    }
+}
 } // namespace
 
 GPU_TEST(TextureAnalyzer)
@@ -130,7 +174,7 @@ GPU_TEST(TextureAnalyzer)
     std::vector<ref<Texture>> textures(kNumTests);
     for (size_t i = 0; i < kNumTests; i++)
     {
-        std::filesystem::path path = getRuntimeDirectory() / fmt::format("data/tests/texture{}.{}", i + 1, i < kNumPNGs ? "png" : "exr");
+        std::filesystem::path path = getTestTexturePath(i);
         textures[i] = Texture::createFromFile(pDevice, path, false, false);
         if (!textures[i])
             FALCOR_THROW("Failed to load {}", path);
@@ -146,47 +190,94 @@ GPU_TEST(TextureAnalyzer)
         textureAnalyzer.analyze(ctx.getRenderContext(), textures[i], 0, 0, pResult, i * kResultSize);
     }
 
-    auto verify = [&ctx](ref<Buffer> pResult)
+    auto verify = [&ctx](ref<Buffer> pResult) { verifyResults(ctx, pResult->getElements<TextureAnalyzer::Result>()); };
+
+    verify(pResult);
+
+    // Test the array version of the interface.
+    ctx.getRenderContext()->clearUAV(pResult->getUAV().get(), uint4(0xbabababa));
+    textureAnalyzer.analyze(ctx.getRenderContext(), textures, pResult);
+
+    verify(pResult);
+}
+
+CPU_TEST(TextureAnalyzerCpu)
+{
+    // Load test images.
+    std::vector<Bitmap::UniqueConstPtr> bitmaps(kNumTests);
+    for (size_t i = 0; i < kNumTests; i++)
     {
-        // Verify results.
-        std::vector<TextureAnalyzer::Result> result = pResult->getElements<TextureAnalyzer::Result>();
-        for (size_t i = 0; i < kNumTests; i++)
-        {
-            EXPECT_EQ(result[i].mask, kExpectedResult[i].mask) << "i = " << i;
+        std::filesystem::path path = getTestTexturePath(i);
+        bitmaps[i] = Bitmap::createFromFile(path, true);
+        if (!bitmaps[i])
+            FALCOR_THROW("Failed to load {}", path);
+    }
 
-            uint32_t rangeFlags = 0;
-            for (int c = 0; c < 4; c++)
-            {
-                bool isConstant = (kExpectedResult[i].mask & (1u << c)) == 0;
-                rangeFlags |= kExpectedResult[i].mask >> (4 + 4 * c);
+    // Analyze images one by one.
+    std::vector<TextureAnalyzer::Result> results;
+    for (const auto& pBitmap : bitmaps)
+        results.push_back(TextureAnalyzer::analyzeCpu(*pBitmap));
+    verifyResults(ctx, results);
 
-                EXPECT_EQ(result[i].isConstant(1u << c), isConstant) << " c = " << c;
-                EXPECT_EQ(result[i].minValue[c], kExpectedResult[i].minValue[c]) << "i = " << i << " c = " << c;
-                EXPECT_EQ(result[i].maxValue[c], kExpectedResult[i].maxValue[c]) << "i = " << i << " c = " << c;
+    // Test the array version of the interface.
+    std::vector<const Bitmap*> pBitmaps;
+    for (const auto& pBitmap : bitmaps)
+        pBitmaps.push_back(pBitmap.get());
+    verifyResults(ctx, TextureAnalyzer::analyzeCpu(pBitmaps));
+}
 
-                if (isConstant)
-                {
-                    EXPECT_EQ(result[i].value[c], kExpectedResult[i].value[c]) << "i = " << i << " c = " << c;
-                }
-            }
+CPU_TEST(TextureAnalyzerCpuTiled)
+{
+    // Use an image that spans several tiles with a padded row pitch, and place the varying texels in different tiles.
+    const uint32_t width = 301;
+    const uint32_t height = 700;
+    const size_t rowPitch = (width + 3) * 4 * sizeof(float);
+    std::vector<uint8_t> data(rowPitch * height);
 
-            EXPECT_EQ(result[i].isPos(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Pos) != 0)
-                << "i = " << i;
-            EXPECT_EQ(result[i].isNeg(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Neg) != 0)
-                << "i = " << i;
-            EXPECT_EQ(result[i].isInf(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::Inf) != 0)
-                << "i = " << i;
-            EXPECT_EQ(result[i].isNaN(TextureChannelFlags::RGBA), (rangeFlags & (uint32_t)TextureAnalyzer::Result::RangeFlags::NaN) != 0)
-                << "i = " << i;
+    auto texel = [&](uint32_t x, uint32_t y) { return reinterpret_cast<float*>(data.data() + y * rowPitch) + x * 4; };
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            float* p = texel(x, y);
+            p[0] = 0.5f;
+            p[1] = -1.f;
+            p[2] = 0.f;
+            p[3] = 1.f;
         }
-    };
+    }
 
-    verify(pResult);
+    // Padding that must be ignored.
+    texel(width, 0)[0] = std::numeric_limits<float>::quiet_NaN();
 
-    // Test the array version of the interface.
-    ctx.getRenderContext()->clearUAV(pResult->getUAV().get(), uint4(0xbabababa));
-    textureAnalyzer.analyze(ctx.getRenderContext(), textures, pResult);
+    auto result = TextureAnalyzer::analyzeCpu(ResourceFormat::RGBA32Float, width, height, rowPitch, data.data());
+    EXPECT_EQ(result.mask, 0x00010210u);
+    EXPECT(result.isConstant(TextureChannelFlags::RGBA));
+    EXPECT(all(result.value == float4(0.5f, -1.f, 0.f, 1.f)));
+    EXPECT(all(result.minValue == float4(0.5f, 0.f, 0.f, 1.f)));
+    EXPECT(all(result.maxValue == float4(0.5f, 0.f, 0.f, 1.f)));
 
-    verify(pResult);
+    texel(7, 350)[0] = 2.f;
+    texel(width - 1, height - 1)[2] = std::numeric_limits<float>::quiet_NaN();
+    texel(0, 600)[3] = -std::numeric_limits<float>::infinity();
+
+    result = TextureAnalyzer::analyzeCpu(ResourceFormat::RGBA32Float, width, height, rowPitch, data.data());
+    EXPECT_EQ(result.mask, 0x0007821du);
+    EXPECT(result.isConstant(TextureChannelFlags::Green));
+    EXPECT(result.isNaN(TextureChannelFlags::Blue));
+    EXPECT(result.isInf(TextureChannelFlags::Alpha));
+    EXPECT(result.isNeg(TextureChannelFlags::Alpha));
+    EXPECT(all(result.minValue == float4(0.5f, 0.f, 0.f, 0.f)));
+    EXPECT(all(result.maxValue == float4(2.f, 0.f, 0.f, 1.f)));
+
+    // Lower precision formats are converted per row.
+    std::vector<uint8_t> rgba8(width * 4 * height, 255);
+    rgba8[(height - 1) * width * 4 + 1] = 0;
+    result = TextureAnalyzer::analyzeCpu(ResourceFormat::RGBA8Unorm, width, height, width * 4, rgba8.data());
+    EXPECT_EQ(result.mask, 0x00011112u);
+    EXPECT(all(result.minValue == float4(1.f, 0.f, 1.f, 1.f)));
+
+    EXPECT(!TextureAnalyzer::isCpuFormatSupported(ResourceFormat::RGBA32Uint));
+    EXPECT(TextureAnalyzer::isCpuFormatSupported(ResourceFormat::RGBA16Float));
 }
 } // namespace Falcor
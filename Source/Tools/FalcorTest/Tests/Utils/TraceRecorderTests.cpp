@@ -0,0 +1,185 @@
+/***************************************************************************
+ # Copyright (c) 2015-23, NVIDIA CORPORATION. All rights reserved.
+ #
+ # Redistribution and use in source and binary forms, with or without
+ # modification, are permitted provided that the following conditions
+ # are met:
+ #  * Redistributions of source code must retain the above copyright
+ #    notice, this list of conditions and the following disclaimer.
+ #  * Redistributions in binary form must reproduce the above copyright
+ #    notice, this list of conditions and the following disclaimer in the
+ #    documentation and/or other materials provided with the distribution.
+ #  * Neither the name of NVIDIA CORPORATION nor the names of its
+ #    contributors may be used to endorse or promote products derived
+ #    from this software without specific prior written permission.
+ #
+ # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS "AS IS" AND ANY
+ # EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ # IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ # PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ # CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ # PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ # PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ # OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ **************************************************************************/
+#include "Testing/UnitTest.h"
+#include "Utils/Timing/TraceRecorder.h"
+#include <nlohmann/json.hpp>
+#include <map>
+#include <thread>
+
+namespace Falcor
+{
+CPU_TEST(TraceRecorder_ScopesAndThreads)
+{
+    TraceRecorder recorder;
+
+    // Events are ignored while not recording.
+    recorder.begin("Ignored");
+    recorder.end();
+    EXPECT_EQ(recorder.getStats().eventCount, 0);
+
+    recorder.setRecording(true);
+    recorder.setThreadName("Main");
+    recorder.begin("Outer", "cpu");
+    recorder.begin("Inner", "cpu");
+    recorder.end();
+    recorder.end();
+
+    std::thread worker(
+        [&]()
+        {
+            recorder.setThreadName("Worker");
+            recorder.begin("Work");
+            recorder.counter("Progress", 0.5);
+            recorder.end();
+        }
+    );
+    worker.join();
+
+    TraceRecorder::Stats stats = recorder.getStats();
+    EXPECT_EQ(stats.threadCount, 2);
+    EXPECT_EQ(stats.eventCount, 7);
+    EXPECT_EQ(stats.droppedEvents, 0);
+
+    auto events = recorder.getEvents();
+    ASSERT_EQ(events.size(), 7);
+    for (size_t i = 1; i < events.size(); ++i)
+        EXPECT_LE(events[i - 1].second.timestamp, events[i].second.timestamp);
+
+    // Events on the main thread are kept in recording order.
+    std::vector<std::pair<TraceRecorder::EventType, std::string>> mainEvents;
+    for (const auto& [threadId, event] : events)
+        if (threadId == 1)
+            mainEvents.emplace_back(event.type, recorder.getString(event.nameId));
+    ASSERT_EQ(mainEvents.size(), 4);
+    EXPECT(mainEvents[0] == std::make_pair(TraceRecorder::EventType::Begin, std::string("Outer")));
+    EXPECT(mainEvents[1] == std::make_pair(TraceRecorder::EventType::Begin, std::string("Inner")));
+    EXPECT(mainEvents[2].first == TraceRecorder::EventType::End);
+    EXPECT(mainEvents[3].first == TraceRecorder::EventType::End);
+
+    recorder.clear();
+    EXPECT_EQ(recorder.getStats().eventCount, 0);
+    EXPECT_EQ(recorder.getEvents().size(), 0);
+}
+
+CPU_TEST(TraceRecorder_ChromeTrace)
+{
+    TraceRecorder recorder;
+    recorder.setRecording(true);
+
+    // Async and flow events spanning two threads.
+    uint64_t id = recorder.newId();
+    recorder.setThreadName("Main \"quoted\"");
+    recorder.asyncBegin("Task", id, "async");
+    recorder.begin("Submit");
+    recorder.flowBegin("Task", id);
+    recorder.end();
+    std::thread worker(
+        [&]()
+        {
+            recorder.begin("Execute");
+            recorder.flowEnd("Task", id);
+            recorder.instant("Checkpoint");
+            recorder.end();
+            recorder.asyncEnd("Task", id, "async");
+        }
+    );
+    worker.join();
+
+    TraceRecorder::Track track = recorder.createTrack("GPU");
+    recorder.complete(track, "Pass", 1000, 2500, "gpu");
+
+    nlohmann::json trace = nlohmann::json::parse(recorder.toChromeTraceJson());
+    const auto& traceEvents = trace["traceEvents"];
+    ASSERT(traceEvents.is_array());
+
+    std::map<std::string, size_t> phaseCounts;
+    std::map<uint32_t, std::string> threadNames;
+    for (const auto& e : traceEvents)
+    {
+        std::string ph = e["ph"];
+        phaseCounts[ph]++;
+        if (ph == "M")
+            threadNames[e["tid"].get<uint32_t>()] = e["args"]["name"];
+        if (ph == "X")
+        {
+            EXPECT_EQ(e["name"].get<std::string>(), "Pass");
+            EXPECT_EQ(e["ts"].get<double>(), 1.0);
+            EXPECT_EQ(e["dur"].get<double>(), 2.5);
+        }
+        if (ph == "b" || ph == "e")
+            EXPECT_EQ(e["id"].get<std::string>(), fmt::format("0x{:x}", id));
+        if (ph == "f")
+            EXPECT_EQ(e["bp"].get<std::string>(), "e");
+    }
+
+    EXPECT_EQ(phaseCounts["M"], 3);
+    EXPECT_EQ(phaseCounts["B"], 2);
+    EXPECT_EQ(phaseCounts["E"], 2);
+    EXPECT_EQ(phaseCounts["b"], 1);
+    EXPECT_EQ(phaseCounts["e"], 1);
+    EXPECT_EQ(phaseCounts["s"], 1);
+    EXPECT_EQ(phaseCounts["f"], 1);
+    EXPECT_EQ(phaseCounts["i"], 1);
+    EXPECT_EQ(phaseCounts["X"], 1);
+    EXPECT_EQ(threadNames[1], "Main \"quoted\"");
+    EXPECT_EQ(threadNames[2], "Thread 2");
+    EXPECT_EQ(threadNames[3], "GPU");
+}
+
+CPU_TEST(TraceRecorder_EventLimit)
+{
+    // Use more events than fit in a single buffer chunk.
+    const size_t kMaxEvents = 10000;
+    TraceRecorder recorder(kMaxEvents);
+    recorder.setRecording(true);
+
+    const size_t kThreadCount = 4;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (size_t i = 0; i < kMaxEvents / 2 + 1; ++i)
+                {
+                    recorder.begin("Event");
+                    recorder.end();
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    TraceRecorder::Stats stats = recorder.getStats();
+    EXPECT_EQ(stats.threadCount, kThreadCount);
+    EXPECT_EQ(stats.eventCount, kThreadCount * kMaxEvents);
+    EXPECT_EQ(stats.droppedEvents, kThreadCount * 2);
+    EXPECT_EQ(recorder.getEvents().size(), kThreadCount * kMaxEvents);
+}
+} // namespace Falcor
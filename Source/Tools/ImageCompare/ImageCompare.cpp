@@ -25,6 +25,7 @@
  # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  **************************************************************************/
+#include "Utils/Image/PixelConversion.h"
 #include <FreeImage.h>
 #include <args.hxx>
 
@@ -147,33 +148,25 @@ public:
                 }
                 else
                 {
-                    for (uint32_t x = 0; x < mWidth; ++x)
-                    {
-                        dst[0] = src[0];
-                        dst[1] = src[1];
-                        dst[2] = src[2];
-                        dst += 3;
-                        src += 4;
-                    }
+                    Falcor::PixelConversion::dropAlpha(src, dst, mWidth);
+                    src += mWidth * 4;
                 }
             }
         }
         else
         {
             bitmap = FreeImage_Allocate(mWidth, mHeight, writeAlpha ? 32 : 24);
+            std::vector<uint8_t> row(mWidth * 4);
             for (uint32_t y = 0; y < mHeight; y++)
             {
                 uint8_t* dst = reinterpret_cast<uint8_t*>(FreeImage_GetScanLine(bitmap, mHeight - y - 1));
-                for (uint32_t x = 0; x < mWidth; ++x)
-                {
-                    dst[2] = clamp(int(src[0] * 255.f), 0, 255);
-                    dst[1] = clamp(int(src[1] * 255.f), 0, 255);
-                    dst[0] = clamp(int(src[2] * 255.f), 0, 255);
-                    if (writeAlpha)
-                        dst[3] = clamp(int(src[3] * 255.f), 0, 255);
-                    dst += writeAlpha ? 4 : 3;
-                    src += 4;
-                }
+                // Truncate rather than round to keep the output identical to earlier versions.
+                for (size_t i = 0; i < row.size(); i++)
+                    row[i] = (uint8_t)clamp(int(src[i] * 255.f), 0, 255);
+                Falcor::PixelConversion::swapRedBlue8(row.data(), writeAlpha ? dst : row.data(), mWidth);
+                if (!writeAlpha)
+                    Falcor::PixelConversion::dropAlpha(row.data(), dst, mWidth);
+                src += mWidth * 4;
             }
         }
 
@@ -0,0 +1,84 @@
+"""
+CPU benchmark for the USD importer mesh tessellation.
+
+This script generates a large Catmull-Clark subdivision mesh as a USDA file and
+measures the time it takes to load it as a scene at different refinement levels.
+The mesh is a single prim, so all parallelism comes from tessellating the faces
+of a single mesh in parallel.
+
+Usage: python usd_tessellation.py [--resolution N] [--levels 0 1 2] [--runs R]
+"""
+
+import argparse
+import math
+import tempfile
+import time
+from pathlib import Path
+
+import falcor
+
+
+def write_grid_mesh(path: Path, resolution: int, refinement_level: int):
+    """Write a displaced grid of resolution x resolution quads with UVs."""
+    n = resolution + 1
+    points = []
+    uvs = []
+    for j in range(n):
+        for i in range(n):
+            u, v = i / resolution, j / resolution
+            h = 0.05 * math.sin(12.0 * u) * math.cos(9.0 * v)
+            points.append(f"({u - 0.5:.6f}, {h:.6f}, {v - 0.5:.6f})")
+            uvs.append(f"({u:.6f}, {v:.6f})")
+
+    indices = []
+    for j in range(resolution):
+        for i in range(resolution):
+            k = j * n + i
+            indices.append(f"{k}, {k + n}, {k + n + 1}, {k + 1}")
+
+    face_count = resolution * resolution
+    with open(path, "w") as f:
+        f.write('#usda 1.0\n(\n    upAxis = "Y"\n    metersPerUnit = 1\n)\n\n')
+        f.write('def Mesh "HeroMesh"\n{\n')
+        f.write('    uniform token subdivisionScheme = "catmullClark"\n')
+        f.write(f"    int refinementLevel = {refinement_level}\n")
+        f.write(f"    int[] faceVertexCounts = [{', '.join(['4'] * face_count)}]\n")
+        f.write(f"    int[] faceVertexIndices = [{', '.join(indices)}]\n")
+        f.write(f"    point3f[] points = [{', '.join(points)}]\n")
+        f.write(
+            f"    texCoord2f[] primvars:st = [{', '.join(uvs)}] (\n"
+            '        interpolation = "vertex"\n    )\n'
+        )
+        f.write("}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--resolution", type=int, default=1024, help="Number of quads along each side of the grid")
+    parser.add_argument("--levels", type=int, nargs="+", default=[0, 1, 2], help="Refinement levels to benchmark")
+    parser.add_argument("--runs", type=int, default=3, help="Number of runs per refinement level")
+    args = parser.parse_args()
+
+    testbed = falcor.Testbed(create_window=False)
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        for level in args.levels:
+            path = Path(tmp_dir) / f"grid_{args.resolution}_{level}.usda"
+            write_grid_mesh(path, args.resolution, level)
+
+            timings = []
+            for _ in range(args.runs):
+                start = time.perf_counter()
+                testbed.load_scene(path)
+                timings.append(time.perf_counter() - start)
+
+            stats = testbed.scene.stats
+            print(
+                f"resolution={args.resolution} level={level} "
+                f"triangles={stats['uniqueTriangleCount']} vertices={stats['uniqueVertexCount']} "
+                f"load_time_min={min(timings):.3f}s load_time_avg={sum(timings) / len(timings):.3f}s"
+            )
+
+
+if __name__ == "__main__":
+    main()